@@ -26,6 +26,7 @@
 #include "Poco/ActiveResult.h"
 #include "Poco/ActiveMethod.h"
 #include "Poco/Mutex.h"
+#include "Poco/EventSnapshot.h"
 
 
 namespace Poco {
@@ -149,6 +150,11 @@ class AbstractEvent
 	/// Working with PriorityDelegate's as similar to working with BasicEvent.
 	/// Instead of delegate(), the priorityDelegate() function must be used
 	/// to create the PriorityDelegate.
+	///
+	/// notify() dispatches to an immutable copy of the strategy without
+	/// locking and without allocating memory. Adding or removing delegates,
+	/// and enabling or disabling the event, discards the copy, and the next
+	/// notification makes a new one. See EventSnapshot for details.
 {
 public:
 	typedef TDelegate* DelegateHandle;
@@ -178,6 +184,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.add(aDelegate);
+		_snapshot.invalidate();
 	}
 	
 	void operator -= (const TDelegate& aDelegate)
@@ -187,6 +194,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(aDelegate);
+		_snapshot.invalidate();
 	}
 	
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -198,7 +206,9 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		DelegateHandle handle = _strategy.add(aDelegate);
+		_snapshot.invalidate();
+		return handle;
 	}
 	
 	void remove(DelegateHandle delegateHandle)
@@ -209,6 +219,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(delegateHandle);
+		_snapshot.invalidate();
 	}
 		
 	void operator () (const void* pSender, TArgs& args)
@@ -225,7 +236,8 @@ public:
 
 	void notify(const void* pSender, TArgs& args)
 		/// Sends a notification to all registered delegates. The order is 
-		/// determined by the TStrategy. This method is blocking. While executing,
+		/// determined by the TStrategy. This method is blocking, but does
+		/// not lock the event. While executing,
 		/// the list of delegates may be modified. These changes don't
 		/// influence the current active notifications but are activated with
 		/// the next notify. If a delegate is removed during a notify(), the
@@ -234,16 +246,16 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
-		if (!_enabled) return;
-		
-		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender, args);
+		if (_snapshot.empty()) return;
+
+		typename EventSnapshot<TStrategy>::ScopedNotify notifying(_snapshot);
+		TStrategy* pStrategy = notifying.strategy();
+		if (!pStrategy)
+		{
+			typename TMutex::ScopedLock lock(_mutex);
+			pStrategy = notifying.update(_strategy, _enabled);
+		}
+		if (pStrategy) pStrategy->notify(pSender, args);
 	}
 
 	bool hasDelegates() const {
@@ -284,6 +296,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
+		_snapshot.invalidate();
 	}
 
 	void disable()
@@ -292,6 +305,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
+		_snapshot.invalidate();
 	}
 
 	bool isEnabled() const
@@ -305,6 +319,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.clear();
+		_snapshot.invalidate();
 	}
 	
 	bool empty() const
@@ -351,6 +366,8 @@ protected:
 private:
 	AbstractEvent(const AbstractEvent& other);
 	AbstractEvent& operator = (const AbstractEvent& other);
+
+	EventSnapshot<TStrategy> _snapshot;
 };
 
 
@@ -384,6 +401,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.add(aDelegate);
+		_snapshot.invalidate();
 	}
 	
 	void operator -= (const TDelegate& aDelegate)
@@ -393,6 +411,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(aDelegate);
+		_snapshot.invalidate();
 	}
 
 	DelegateHandle add(const TDelegate& aDelegate)
@@ -404,7 +423,9 @@ public:
 		/// remove() to remove the delegate.
 	{
 		typename TMutex::ScopedLock lock(_mutex);
-		return _strategy.add(aDelegate);
+		DelegateHandle handle = _strategy.add(aDelegate);
+		_snapshot.invalidate();
+		return handle;
 	}
 	
 	void remove(DelegateHandle delegateHandle)
@@ -415,6 +436,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.remove(delegateHandle);
+		_snapshot.invalidate();
 	}
 	
 	void operator () (const void* pSender)
@@ -431,7 +453,8 @@ public:
 
 	void notify(const void* pSender)
 		/// Sends a notification to all registered delegates. The order is 
-		/// determined by the TStrategy. This method is blocking. While executing,
+		/// determined by the TStrategy. This method is blocking, but does
+		/// not lock the event. While executing,
 		/// the list of delegates may be modified. These changes don't
 		/// influence the current active notifications but are activated with
 		/// the next notify. If a delegate is removed during a notify(), the
@@ -440,16 +463,16 @@ public:
 		/// the notify method is immediately aborted and the exception is propagated
 		/// to the caller.
 	{
-		Poco::ScopedLockWithUnlock<TMutex> lock(_mutex);
-		
-		if (!_enabled) return;
-		
-		// thread-safeness: 
-		// copy should be faster and safer than blocking until
-		// execution ends
-		TStrategy strategy(_strategy);
-		lock.unlock();
-		strategy.notify(pSender);
+		if (_snapshot.empty()) return;
+
+		typename EventSnapshot<TStrategy>::ScopedNotify notifying(_snapshot);
+		TStrategy* pStrategy = notifying.strategy();
+		if (!pStrategy)
+		{
+			typename TMutex::ScopedLock lock(_mutex);
+			pStrategy = notifying.update(_strategy, _enabled);
+		}
+		if (pStrategy) pStrategy->notify(pSender);
 	}
 
 	ActiveResult<void> notifyAsync(const void* pSender)
@@ -486,6 +509,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = true;
+		_snapshot.invalidate();
 	}
 
 	void disable()
@@ -494,6 +518,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_enabled = false;
+		_snapshot.invalidate();
 	}
 
 	bool isEnabled() const
@@ -507,6 +532,7 @@ public:
 	{
 		typename TMutex::ScopedLock lock(_mutex);
 		_strategy.clear();
+		_snapshot.invalidate();
 	}
 	
 	bool empty() const
@@ -551,6 +577,8 @@ protected:
 private:
 	AbstractEvent(const AbstractEvent& other);
 	AbstractEvent& operator = (const AbstractEvent& other);
+
+	EventSnapshot<TStrategy> _snapshot;
 };
 
 
@@ -25,12 +25,78 @@
 #include "Poco/Event.h"
 #include "Poco/RefCountedObject.h"
 #include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/SharedPtr.h"
 #include <algorithm>
+#include <vector>
 
 
 namespace Poco {
 
 
+template <class ResultType>
+class ActiveResultHolder;
+
+
+template <class ResultType>
+class ActiveResultContinuation: public RefCountedObject
+	/// The base class for continuations registered with an
+	/// ActiveResultHolder. A continuation is notified by the
+	/// thread that makes the result available, so it must
+	/// not block.
+	///
+	/// The result is only passed to the continuation when it
+	/// has become available, so a continuation never keeps
+	/// the result it waits for alive.
+	///
+	/// Do not use this class directly, use ActiveResult::then(),
+	/// whenAll() or whenAny() instead.
+{
+public:
+	typedef std::vector<ActiveResultContinuation*> ContinuationVec;
+
+	virtual void complete(ActiveResultHolder<ResultType>& source) = 0;
+		/// Called as soon as the given result has become available.
+
+	static void completeAll(ContinuationVec& continuations, ActiveResultHolder<ResultType>& source)
+		/// Calls complete() for all given continuations and
+		/// releases them.
+	{
+		for (typename ContinuationVec::iterator it = continuations.begin(); it != continuations.end(); ++it)
+		{
+			try
+			{
+				(*it)->complete(source);
+			}
+			catch (...)
+			{
+				ErrorHandler::handle();
+			}
+			(*it)->release();
+		}
+		continuations.clear();
+	}
+
+	static void releaseAll(ContinuationVec& continuations)
+		/// Releases all given continuations without completing them.
+	{
+		for (typename ContinuationVec::iterator it = continuations.begin(); it != continuations.end(); ++it)
+		{
+			(*it)->release();
+		}
+		continuations.clear();
+	}
+
+protected:
+	~ActiveResultContinuation()
+	{
+	}
+};
+
+
 template <class ResultType>
 class ActiveResultHolder: public RefCountedObject
 	/// This class holds the result of an asynchronous method
@@ -40,10 +106,13 @@ class ActiveResultHolder: public RefCountedObject
 	/// Do not use this class directly, use ActiveResult instead.
 {
 public:
+	typedef ActiveResultContinuation<ResultType> ContinuationType;
+
 	ActiveResultHolder():
 		_pData(0),
 		_pExc(0),
-		_event(Event::EVENT_MANUALRESET)
+		_event(Event::EVENT_MANUALRESET),
+		_notified(false)
 		/// Creates an ActiveResultHolder.
 	{
 	}
@@ -84,9 +153,39 @@ public:
 	}
 	
 	void notify()
-		/// Notifies the invoking thread that the result became available.
+		/// Notifies the invoking thread that the result became available,
+		/// and completes all registered continuations.
 	{
-		_event.set();
+		typename ContinuationType::ContinuationVec continuations;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_event.set();
+			_notified = true;
+			continuations.swap(_continuations);
+		}
+		ContinuationType::completeAll(continuations, *this);
+	}
+
+	void addContinuation(ContinuationType* pContinuation)
+		/// Registers a continuation that is completed as soon as
+		/// the result becomes available. If the result is already
+		/// available, the continuation is completed immediately,
+		/// in the context of the calling thread.
+		///
+		/// Takes ownership of the given continuation.
+	{
+		poco_check_ptr (pContinuation);
+
+		typename ContinuationType::ContinuationVec continuations(1, pContinuation);
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (!_notified)
+			{
+				_continuations.push_back(pContinuation);
+				return;
+			}
+		}
+		ContinuationType::completeAll(continuations, *this);
 	}
 	
 	bool failed() const
@@ -131,6 +230,7 @@ public:
 protected:
 	~ActiveResultHolder()
 	{
+		ContinuationType::releaseAll(_continuations);
 		delete _pData;
 		delete _pExc;
 	}
@@ -139,6 +239,9 @@ private:
 	ResultType* _pData;
 	Exception*  _pExc;
 	Event       _event;
+	FastMutex   _mutex;
+	bool        _notified;
+	typename ContinuationType::ContinuationVec _continuations;
 };
 
 
@@ -147,9 +250,12 @@ template <>
 class ActiveResultHolder<void>: public RefCountedObject
 {
 public:
+	typedef ActiveResultContinuation<void> ContinuationType;
+
 	ActiveResultHolder():
 		_pExc(0),
-		_event(Event::EVENT_MANUALRESET)
+		_event(Event::EVENT_MANUALRESET),
+		_notified(false)
 		/// Creates an ActiveResultHolder.
 	{
 	}
@@ -177,9 +283,39 @@ public:
 	}
 	
 	void notify()
-		/// Notifies the invoking thread that the result became available.
+		/// Notifies the invoking thread that the result became available,
+		/// and completes all registered continuations.
 	{
-		_event.set();
+		ContinuationType::ContinuationVec continuations;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			_event.set();
+			_notified = true;
+			continuations.swap(_continuations);
+		}
+		ContinuationType::completeAll(continuations, *this);
+	}
+
+	void addContinuation(ContinuationType* pContinuation)
+		/// Registers a continuation that is completed as soon as
+		/// the result becomes available. If the result is already
+		/// available, the continuation is completed immediately,
+		/// in the context of the calling thread.
+		///
+		/// Takes ownership of the given continuation.
+	{
+		poco_check_ptr (pContinuation);
+
+		ContinuationType::ContinuationVec continuations(1, pContinuation);
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			if (!_notified)
+			{
+				_continuations.push_back(pContinuation);
+				return;
+			}
+		}
+		ContinuationType::completeAll(continuations, *this);
 	}
 	
 	bool failed() const
@@ -224,20 +360,39 @@ public:
 protected:
 	~ActiveResultHolder()
 	{
+		ContinuationType::releaseAll(_continuations);
 		delete _pExc;
 	}
 
 private:
 	Exception*  _pExc;
 	Event       _event;
+	FastMutex   _mutex;
+	bool        _notified;
+	ContinuationType::ContinuationVec _continuations;
 };
 
 
+template <class R, class RT, class Function>
+class ActiveContinuation;
+
+
+template <class R, class RT, class OwnerType>
+class ActiveContinuationMethod;
+
+
 template <class RT>
 class ActiveResult
 	/// This class holds the result of an asynchronous method
 	/// invocation (see class ActiveMethod). It is used to pass the 
 	/// result from the execution thread back to the invocation thread. 
+	///
+	/// Instead of waiting for the result, a continuation can be
+	/// attached with then(). The continuation is started in a
+	/// ThreadPool as soon as the result becomes available, and
+	/// its own result is again available as an ActiveResult.
+	/// Multiple results can be combined with whenAll() and whenAny().
+	/// No thread is blocked while waiting for a pending result.
 {
 public:
 	typedef RT ResultType;
@@ -338,6 +493,54 @@ public:
 		return _pHolder->exception();
 	}
 
+	template <class R, class Function>
+	ActiveResult<R> then(const Function& function, ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// function object, which is started in the given thread
+		/// pool as soon as this result becomes available. The function
+		/// object is passed this result as argument (of type const ActiveResult&),
+		/// and must return a value convertible to R.
+		///
+		/// The function is called regardless of whether this
+		/// result has failed; use failed() or exception() to check.
+		/// An exception thrown by the function is stored in the
+		/// returned ActiveResult.
+		///
+		/// If the function cannot be started in the pool, e.g.
+		/// because no thread is available, it is called in the
+		/// context of the thread making this result available.
+	{
+		ActiveResult<R> result(new ActiveResultHolder<R>());
+		_pHolder->addContinuation(new ActiveContinuation<R, RT, Function>(result, function, pool));
+		return result;
+	}
+
+	template <class R>
+	ActiveResult<R> then(R (*function)(const ActiveResult&), ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// function, which is started in the given thread pool as soon
+		/// as this result becomes available.
+	{
+		return then<R, R (*)(const ActiveResult&)>(function, pool);
+	}
+
+	template <class R, class OwnerType>
+	ActiveResult<R> then(OwnerType* pOwner, R (OwnerType::*method)(const ActiveResult&), ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// member function, which is started in the given thread pool
+		/// as soon as this result becomes available.
+	{
+		return then<R>(ActiveContinuationMethod<R, RT, OwnerType>(pOwner, method), pool);
+	}
+
+	void addContinuation(typename ActiveResultHolderType::ContinuationType* pContinuation) const
+		/// Registers a continuation with the result holder.
+		/// Takes ownership of the continuation.
+		/// For internal use only.
+	{
+		_pHolder->addContinuation(pContinuation);
+	}
+
 	void notify()
 		/// Notifies the invoking thread that the result became available.
 		/// For internal use only.
@@ -377,6 +580,9 @@ class ActiveResult<void>
 	/// This class holds the result of an asynchronous method
 	/// invocation (see class ActiveMethod). It is used to pass the 
 	/// result from the execution thread back to the invocation thread. 
+	///
+	/// See the generic ActiveResult template for a description
+	/// of continuations.
 {
 public:
 	typedef ActiveResultHolder<void> ActiveResultHolderType;
@@ -465,6 +671,54 @@ public:
 		return _pHolder->exception();
 	}
 
+	template <class R, class Function>
+	ActiveResult<R> then(const Function& function, ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// function object, which is started in the given thread
+		/// pool as soon as this result becomes available. The function
+		/// object is passed this result as argument (of type const ActiveResult&),
+		/// and must return a value convertible to R.
+		///
+		/// The function is called regardless of whether this
+		/// result has failed; use failed() or exception() to check.
+		/// An exception thrown by the function is stored in the
+		/// returned ActiveResult.
+		///
+		/// If the function cannot be started in the pool, e.g.
+		/// because no thread is available, it is called in the
+		/// context of the thread making this result available.
+	{
+		ActiveResult<R> result(new ActiveResultHolder<R>());
+		_pHolder->addContinuation(new ActiveContinuation<R, void, Function>(result, function, pool));
+		return result;
+	}
+
+	template <class R>
+	ActiveResult<R> then(R (*function)(const ActiveResult&), ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// function, which is started in the given thread pool as soon
+		/// as this result becomes available.
+	{
+		return then<R, R (*)(const ActiveResult&)>(function, pool);
+	}
+
+	template <class R, class OwnerType>
+	ActiveResult<R> then(OwnerType* pOwner, R (OwnerType::*method)(const ActiveResult&), ThreadPool& pool = ThreadPool::defaultPool()) const
+		/// Returns an ActiveResult for the invocation of the given
+		/// member function, which is started in the given thread pool
+		/// as soon as this result becomes available.
+	{
+		return then<R>(ActiveContinuationMethod<R, void, OwnerType>(pOwner, method), pool);
+	}
+
+	void addContinuation(ActiveResultHolderType::ContinuationType* pContinuation) const
+		/// Registers a continuation with the result holder.
+		/// Takes ownership of the continuation.
+		/// For internal use only.
+	{
+		_pHolder->addContinuation(pContinuation);
+	}
+
 	void notify()
 		/// Notifies the invoking thread that the result became available.
 		/// For internal use only.
@@ -491,6 +745,294 @@ private:
 };
 
 
+template <class R>
+struct ActiveContinuationCall
+	/// Stores the return value of a continuation function
+	/// in the target ActiveResult. For internal use only.
+{
+	template <class Function, class Arg>
+	static void call(const Function& function, const Arg& arg, ActiveResult<R>& target)
+	{
+		target.data(new R(function(arg)));
+	}
+};
+
+
+template <>
+struct ActiveContinuationCall<void>
+	/// Calls a continuation function with no return value.
+	/// For internal use only.
+{
+	template <class Function, class Arg>
+	static void call(const Function& function, const Arg& arg, ActiveResult<void>& /*target*/)
+	{
+		function(arg);
+	}
+};
+
+
+template <class R, class RT, class OwnerType>
+class ActiveContinuationMethod
+	/// A function object that calls a member function
+	/// taking an ActiveResult as argument.
+	/// Used by ActiveResult::then(). For internal use only.
+{
+public:
+	typedef R (OwnerType::*Callback)(const ActiveResult<RT>&);
+
+	ActiveContinuationMethod(OwnerType* pOwner, Callback method):
+		_pOwner(pOwner),
+		_method(method)
+	{
+		poco_check_ptr (pOwner);
+	}
+
+	R operator () (const ActiveResult<RT>& result) const
+	{
+		return (_pOwner->*_method)(result);
+	}
+
+private:
+	OwnerType* _pOwner;
+	Callback   _method;
+};
+
+
+template <class R, class RT, class Function>
+class ActiveContinuation: public ActiveResultContinuation<RT>, public Runnable
+	/// Starts a function in a ThreadPool as soon as the
+	/// source result becomes available, and passes the
+	/// function's return value (or exception) on to the
+	/// target result. Used by ActiveResult::then().
+	/// For internal use only.
+{
+public:
+	ActiveContinuation(const ActiveResult<R>& target, const Function& function, ThreadPool& pool):
+		_pSource(0),
+		_target(target),
+		_function(function),
+		_pool(pool)
+	{
+	}
+
+	void complete(ActiveResultHolder<RT>& source)
+	{
+		source.duplicate();
+		_pSource = &source;
+		this->duplicate(); // run() will release
+		try
+		{
+			_pool.start(*this);
+		}
+		catch (...)
+		{
+			// no thread available, or the thread could not be started
+			run();
+		}
+	}
+
+	void run()
+	{
+		AutoPtr<ActiveContinuation> guard(this, false); // ensure automatic release when done
+		try
+		{
+			_pSource->duplicate();
+			ActiveResult<RT> source(_pSource);
+			ActiveContinuationCall<R>::call(_function, source, _target);
+		}
+		catch (Exception& e)
+		{
+			_target.error(e);
+		}
+		catch (std::exception& e)
+		{
+			_target.error(e.what());
+		}
+		catch (...)
+		{
+			_target.error("unknown exception");
+		}
+		_target.notify();
+	}
+
+protected:
+	~ActiveContinuation()
+	{
+		if (_pSource) _pSource->release();
+	}
+
+private:
+	ActiveResultHolder<RT>* _pSource;
+	ActiveResult<R>         _target;
+	Function                _function;
+	ThreadPool&             _pool;
+};
+
+
+template <class RT>
+class ActiveWhenAllState: public RefCountedObject
+	/// The results collected by the continuations created
+	/// by whenAll(). For internal use only.
+{
+public:
+	typedef std::vector<ActiveResult<RT> > ResultVec;
+
+	ActiveWhenAllState(std::size_t count, const ActiveResult<ResultVec>& target):
+		_sources(count, static_cast<ActiveResultHolder<RT>*>(0)),
+		_target(target),
+		_pending(static_cast<AtomicCounter::ValueType>(count))
+	{
+	}
+
+	void complete(std::size_t index, ActiveResultHolder<RT>& source)
+	{
+		source.duplicate();
+		_sources[index] = &source;
+		if (--_pending == 0)
+		{
+			ResultVec* pResults = new ResultVec;
+			pResults->reserve(_sources.size());
+			for (typename HolderVec::iterator it = _sources.begin(); it != _sources.end(); ++it)
+			{
+				(*it)->duplicate();
+				pResults->push_back(ActiveResult<RT>(*it));
+			}
+			_target.data(pResults);
+			_target.notify();
+		}
+	}
+
+protected:
+	~ActiveWhenAllState()
+	{
+		for (typename HolderVec::iterator it = _sources.begin(); it != _sources.end(); ++it)
+		{
+			if (*it) (*it)->release();
+		}
+	}
+
+private:
+	typedef std::vector<ActiveResultHolder<RT>*> HolderVec;
+
+	HolderVec               _sources;
+	ActiveResult<ResultVec> _target;
+	AtomicCounter           _pending;
+};
+
+
+template <class RT>
+class ActiveWhenAll: public ActiveResultContinuation<RT>
+	/// Records the availability of one of the source results
+	/// of whenAll(). For internal use only.
+{
+public:
+	ActiveWhenAll(ActiveWhenAllState<RT>* pState, std::size_t index):
+		_pState(pState, true),
+		_index(index)
+	{
+	}
+
+	void complete(ActiveResultHolder<RT>& source)
+	{
+		_pState->complete(_index, source);
+	}
+
+protected:
+	~ActiveWhenAll()
+	{
+	}
+
+private:
+	AutoPtr<ActiveWhenAllState<RT> > _pState;
+	std::size_t                      _index;
+};
+
+
+template <class RT>
+class ActiveWhenAny: public ActiveResultContinuation<RT>
+	/// Makes the target result available as soon as the
+	/// first of a number of source results has become available.
+	/// Used by whenAny(). For internal use only.
+{
+public:
+	ActiveWhenAny(const ActiveResult<ActiveResult<RT> >& target, const SharedPtr<AtomicCounter>& pCompleted):
+		_target(target),
+		_pCompleted(pCompleted)
+	{
+	}
+
+	void complete(ActiveResultHolder<RT>& source)
+	{
+		if (++(*_pCompleted) == 1)
+		{
+			source.duplicate();
+			_target.data(new ActiveResult<RT>(&source));
+			_target.notify();
+		}
+	}
+
+protected:
+	~ActiveWhenAny()
+	{
+	}
+
+private:
+	ActiveResult<ActiveResult<RT> > _target;
+	SharedPtr<AtomicCounter>        _pCompleted;
+};
+
+
+template <class RT>
+ActiveResult<std::vector<ActiveResult<RT> > > whenAll(const std::vector<ActiveResult<RT> >& results)
+	/// Returns an ActiveResult that becomes available as soon
+	/// as all given results have become available. Its data
+	/// is a copy of the given vector.
+	///
+	/// The returned result never fails; failures of the
+	/// individual results must be checked separately.
+{
+	typedef std::vector<ActiveResult<RT> > ResultVec;
+
+	ActiveResult<ResultVec> result(new ActiveResultHolder<ResultVec>());
+	if (results.empty())
+	{
+		result.data(new ResultVec);
+		result.notify();
+	}
+	else
+	{
+		AutoPtr<ActiveWhenAllState<RT> > pState = new ActiveWhenAllState<RT>(results.size(), result);
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			results[i].addContinuation(new ActiveWhenAll<RT>(pState, i));
+		}
+	}
+	return result;
+}
+
+
+template <class RT>
+ActiveResult<ActiveResult<RT> > whenAny(const std::vector<ActiveResult<RT> >& results)
+	/// Returns an ActiveResult that becomes available as soon
+	/// as the first of the given results has become available.
+	/// Its data is the first available result.
+	///
+	/// Throws an InvalidArgumentException if the given vector is empty.
+{
+	typedef std::vector<ActiveResult<RT> > ResultVec;
+
+	if (results.empty()) throw InvalidArgumentException("whenAny() requires at least one result");
+
+	ActiveResult<ActiveResult<RT> > result(new ActiveResultHolder<ActiveResult<RT> >());
+	SharedPtr<AtomicCounter> pCompleted = new AtomicCounter;
+	for (typename ResultVec::const_iterator it = results.begin(); it != results.end(); ++it)
+	{
+		it->addContinuation(new ActiveWhenAny<RT>(result, pCompleted));
+	}
+	return result;
+}
+
+
 } // namespace Poco
 
 
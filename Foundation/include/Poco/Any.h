@@ -42,19 +42,40 @@ template <class> class VarHolderImpl;
 #ifndef POCO_NO_SOO
 
 #ifndef POCO_ENABLE_CPP11
-	// C++11 needed for std::aligned_storage
+	// Any's small object optimization requires C++11
 	#error "Any SOO can only be enabled with C++11 support"
 #endif
 
-template <typename PlaceholderT, unsigned int SizeV = POCO_SMALL_OBJECT_SIZE>
+#endif // POCO_NO_SOO
+
+
+template <typename PlaceholderT>
+struct PlaceholderSize
+	/// The default buffer size of a Placeholder for the given type.
+{
+	static const unsigned int value = POCO_SMALL_OBJECT_SIZE;
+};
+
+
+template <>
+struct PlaceholderSize<Dynamic::VarHolder>
+	/// Dynamic::Var has a larger buffer, so that strings
+	/// can be stored in place.
+{
+	static const unsigned int value = POCO_VAR_SMALL_OBJECT_SIZE;
+};
+
+
+template <typename PlaceholderT, unsigned int SizeV = PlaceholderSize<PlaceholderT>::value>
 union Placeholder
-	/// ValueHolder union (used by Poco::Any and Poco::Dynamic::Var for small
-	/// object optimization, when enabled).
+	/// ValueHolder union (used by Poco::Dynamic::Var, and by Poco::Any
+	/// if small object optimization is enabled).
 	/// 
-	/// If Holder<Type> fits into POCO_SMALL_OBJECT_SIZE bytes of storage, 
-	/// it will be placement-new-allocated into the local buffer
+	/// If Holder<Type> fits into SizeV bytes of storage (POCO_SMALL_OBJECT_SIZE,
+	/// or POCO_VAR_SMALL_OBJECT_SIZE for Dynamic::Var), it will be
+	/// placement-new-allocated into the local buffer
 	/// (i.e. there will be no heap-allocation). The local buffer size is one byte
-	/// larger - [POCO_SMALL_OBJECT_SIZE + 1], additional byte value indicating
+	/// larger - [SizeV + 1], additional byte value indicating
 	/// where the object was allocated (0 => heap, 1 => local).
 {
 public:
@@ -95,50 +116,15 @@ public:
 #if !defined(POCO_MSVC_VERSION) || (defined(POCO_MSVC_VERSION) && (POCO_MSVC_VERSION > 80))
 private:
 #endif
-	typedef typename std::aligned_storage<SizeV + 1>::type AlignerType;
-	
 	PlaceholderT* pHolder;
 	mutable char  holder [SizeV + 1];
-	AlignerType   aligner;
-
-	friend class Any;
-	friend class Dynamic::Var;
-	friend class Dynamic::VarHolder;
-	template <class> friend class Dynamic::VarHolderImpl;
-};
-
-
-#else // !POCO_NO_SOO
-
-
-template <typename PlaceholderT>
-union Placeholder
-	/// ValueHolder union (used by Poco::Any and Poco::Dynamic::Var for small
-	/// object optimization, when enabled).
-	/// 
-	/// If Holder<Type> fits into POCO_SMALL_OBJECT_SIZE bytes of storage, 
-	/// it will be placement-new-allocated into the local buffer
-	/// (i.e. there will be no heap-allocation). The local buffer size is one byte
-	/// larger - [POCO_SMALL_OBJECT_SIZE + 1], additional byte value indicating
-	/// where the object was allocated (0 => heap, 1 => local).
-{
-public:
 
-	Placeholder ()
-	{
-	}
-
-	PlaceholderT* content() const
-	{
-		return pHolder;
-	}
-
-// MSVC71,80 won't extend friendship to nested class (Any::Holder)
-#if !defined(POCO_MSVC_VERSION) || (defined(POCO_MSVC_VERSION) && (POCO_MSVC_VERSION > 80))
-private:
-#endif
-	
-	PlaceholderT*         pHolder;
+	// The following members are never used; they only
+	// align the buffer for any type that may be stored in it.
+	Int64         alignInt64;
+	double        alignDouble;
+	long double   alignLongDouble;
+	void*         alignPointer;
 
 	friend class Any;
 	friend class Dynamic::Var;
@@ -147,9 +133,6 @@ private:
 };
 
 
-#endif // POCO_NO_SOO
-
-
 class Any
 	/// An Any class represents a general type and is capable of storing any type, supporting type-safe extraction
 	/// of the internally stored data.
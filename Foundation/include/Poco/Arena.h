@@ -0,0 +1,340 @@
+//
+// Arena.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Definition of the Arena class and the ArenaAllocator and ArenaObject classes.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Arena_INCLUDED
+#define Foundation_Arena_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <vector>
+#include <new>
+#include <limits>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API Arena
+	/// A monotonic ("bump pointer") memory allocator.
+	///
+	/// Memory is handed out sequentially from large chunks
+	/// obtained from the system. Individual allocations are
+	/// never released; instead, all memory allocated from an
+	/// Arena is reclaimed at once by calling reset() (or
+	/// destroying the Arena), which takes constant time
+	/// regardless of the number of allocations.
+	///
+	/// This makes an Arena ideal for building large numbers of
+	/// small objects with a common lifetime, e.g. a document tree
+	/// that lives only for the duration of a request.
+	/// Note that destructors of objects placed in an Arena
+	/// are not called by the Arena.
+	///
+	/// An Arena is not thread-safe.
+{
+public:
+	enum
+	{
+		DEFAULT_CHUNK_SIZE = 65536,
+		DEFAULT_ALIGNMENT  = 2*sizeof(void*)
+	};
+
+	class ScopedReset
+		/// Records the current allocation position of an Arena
+		/// and, upon destruction, releases all memory allocated
+		/// from the Arena since the ScopedReset was created.
+	{
+	public:
+		explicit ScopedReset(Arena& arena);
+			/// Records the current position of the given Arena.
+
+		~ScopedReset();
+			/// Rewinds the Arena to the recorded position.
+
+	private:
+		ScopedReset();
+		ScopedReset(const ScopedReset&);
+		ScopedReset& operator = (const ScopedReset&);
+
+		Arena&      _arena;
+		std::size_t _chunk;
+		std::size_t _offset;
+		std::size_t _used;
+	};
+
+	explicit Arena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+		/// Creates the Arena. Memory is obtained from the system
+		/// in chunks of the given size; allocations larger than
+		/// the chunk size get a chunk of their own.
+
+	~Arena();
+		/// Destroys the Arena and releases all memory.
+
+	void* allocate(std::size_t size);
+		/// Allocates a block of the given size, suitably
+		/// aligned for any fundamental type.
+
+	void* allocate(std::size_t size, std::size_t alignment);
+		/// Allocates a block of the given size with the given
+		/// alignment, which must be a power of two.
+
+	char* strdup(const char* str, std::size_t length);
+		/// Copies the given characters into the Arena,
+		/// appends a terminating zero and returns the copy.
+
+	void reset();
+		/// Releases all memory allocated from the Arena.
+		/// The first chunk is retained for subsequent
+		/// allocations, all others are released to the system.
+
+	std::size_t chunkSize() const;
+		/// Returns the chunk size.
+
+	std::size_t used() const;
+		/// Returns the number of bytes allocated from the Arena
+		/// since construction or the last reset(), including
+		/// alignment padding.
+
+	std::size_t capacity() const;
+		/// Returns the total size of all chunks currently
+		/// owned by the Arena.
+
+private:
+	Arena(const Arena&);
+	Arena& operator = (const Arena&);
+
+	struct Chunk
+	{
+		char*       pMemory;
+		char*       pBegin;
+		std::size_t size;
+	};
+
+	void* allocateSlow(std::size_t size, std::size_t alignment);
+	static void releaseChunk(Chunk& chunk);
+	void rewind(std::size_t chunk, std::size_t offset, std::size_t used);
+
+	typedef std::vector<Chunk> ChunkVec;
+
+	std::size_t _chunkSize;
+	ChunkVec    _chunks;
+	std::size_t _current;
+	std::size_t _offset;
+	std::size_t _used;
+
+	friend class ScopedReset;
+};
+
+
+template <class T>
+class ArenaAllocator
+	/// A standard library compatible allocator that obtains
+	/// its memory from an Arena. Deallocation is a no-op;
+	/// memory is reclaimed when the Arena is reset.
+	///
+	/// A default-constructed ArenaAllocator (with no Arena)
+	/// uses operator new and operator delete.
+{
+public:
+	typedef T              value_type;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef std::size_t    size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator():
+		_pArena(0)
+	{
+	}
+
+	ArenaAllocator(Arena& arena):
+		_pArena(&arena)
+	{
+	}
+
+	ArenaAllocator(const ArenaAllocator& allocator):
+		_pArena(allocator._pArena)
+	{
+	}
+
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& allocator):
+		_pArena(allocator.arena())
+	{
+	}
+
+	~ArenaAllocator()
+	{
+	}
+
+	pointer address(reference value) const
+	{
+		return &value;
+	}
+
+	const_pointer address(const_reference value) const
+	{
+		return &value;
+	}
+
+	pointer allocate(size_type n, const void* = 0)
+	{
+		if (n > max_size()) throw std::bad_alloc();
+		if (_pArena)
+			return static_cast<pointer>(_pArena->allocate(n*sizeof(T)));
+		else
+			return static_cast<pointer>(::operator new(n*sizeof(T)));
+	}
+
+	void deallocate(pointer p, size_type /*n*/)
+	{
+		if (!_pArena) ::operator delete(p);
+	}
+
+	size_type max_size() const
+	{
+		return std::numeric_limits<size_type>::max()/sizeof(T);
+	}
+
+	void construct(pointer p, const T& value)
+	{
+		new (static_cast<void*>(p)) T(value);
+	}
+
+	void destroy(pointer p)
+	{
+		p->~T();
+	}
+
+	Arena* arena() const
+	{
+		return _pArena;
+	}
+
+private:
+	Arena* _pArena;
+};
+
+
+template <class T, class U>
+inline bool operator == (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() == a2.arena();
+}
+
+
+template <class T, class U>
+inline bool operator != (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() != a2.arena();
+}
+
+
+class Foundation_API ArenaObject
+	/// A base class for classes whose instances can optionally
+	/// be placed in an Arena, using new (pArena) T(...).
+	///
+	/// Instances are destroyed with delete as usual. However,
+	/// for an instance placed in an Arena, delete only runs the
+	/// destructor; the memory is reclaimed with the Arena.
+	/// If pArena is null, the instance is allocated with
+	/// operator new, as is an instance created with plain new.
+	///
+	/// ArenaObject has no data members, so deriving from it does
+	/// not change the size or layout of a class. Whether an instance
+	/// has been placed in an Arena is determined from its address:
+	/// every Arena registers the pages of its chunks in a process-wide
+	/// table, which delete looks up without locking. The Arena must
+	/// therefore outlive all instances placed in it.
+{
+public:
+	static void* operator new(std::size_t size);
+	static void* operator new(std::size_t size, Arena* pArena);
+	static void operator delete(void* ptr);
+	static void operator delete(void* ptr, Arena* pArena);
+
+	static void* operator new(std::size_t size, void* ptr);
+	static void operator delete(void* ptr, void* place);
+		/// Placement new and delete, which would otherwise
+		/// be hidden by the above.
+};
+
+
+//
+// inlines
+//
+inline void* Arena::allocate(std::size_t size)
+{
+	return allocate(size, DEFAULT_ALIGNMENT);
+}
+
+
+inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	if (_current < _chunks.size())
+	{
+		const Chunk& chunk = _chunks[_current];
+		char* p = chunk.pBegin + _offset;
+		std::size_t padding = (alignment - (reinterpret_cast<UIntPtr>(p) & (alignment - 1))) & (alignment - 1);
+		if (padding + size <= chunk.size - _offset)
+		{
+			_offset += padding + size;
+			_used   += padding + size;
+			return p + padding;
+		}
+	}
+	return allocateSlow(size, alignment);
+}
+
+
+inline void* ArenaObject::operator new(std::size_t /*size*/, void* ptr)
+{
+	return ptr;
+}
+
+
+inline void ArenaObject::operator delete(void* /*ptr*/, void* /*place*/)
+{
+}
+
+
+inline std::size_t Arena::chunkSize() const
+{
+	return _chunkSize;
+}
+
+
+inline std::size_t Arena::used() const
+{
+	return _used;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Arena_INCLUDED
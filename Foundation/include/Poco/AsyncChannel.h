@@ -22,10 +22,14 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
 #include "Poco/Thread.h"
 #include "Poco/Mutex.h"
+#include "Poco/Condition.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include <vector>
+#include <cstddef>
 
 
 namespace Poco {
@@ -40,8 +44,33 @@ class Foundation_API AsyncChannel: public Channel, public Runnable
 	///
 	/// All log messages are put into a queue and this queue is
 	/// then processed by a separate thread.
+	///
+	/// By default, the queue is unbounded, and each message is
+	/// copied into a newly allocated notification. If the "queueSize"
+	/// property is set, a bounded ring buffer of pre-allocated messages
+	/// is used instead. Messages are copied into the ring buffer
+	/// reusing the memory of earlier messages, so that no memory needs
+	/// to be allocated once the buffer has been filled. The background
+	/// thread removes up to "batchSize" messages at once from the
+	/// ring buffer and passes them on to the target channel's
+	/// logBatch() method. The "overflow" property determines what
+	/// happens if a message is logged while the ring buffer is full.
 {
 public:
+	enum OverflowPolicy
+	{
+		OVERFLOW_BLOCK,      /// log() waits until there is room in the queue.
+		OVERFLOW_DROP,       /// The new message is discarded.
+		OVERFLOW_DROP_LOWEST /// The oldest of the queued messages with the lowest priority is discarded,
+		                     /// unless the new message has the same or an even lower priority, in which
+		                     /// case the new message is discarded.
+	};
+
+	enum
+	{
+		DEFAULT_BATCH_SIZE = 64
+	};
+
 	AsyncChannel(Channel* pChannel = 0, Thread::Priority prio = Thread::PRIO_NORMAL);
 		/// Creates the AsyncChannel and connects it to
 		/// the given channel.
@@ -81,18 +110,91 @@ public:
 		///    * highest
 		///
 		/// The "priority" property is set-only.
+		///
+		/// The "queueSize" property sets the capacity of the
+		/// ring buffer. The default, 0, selects an unbounded
+		/// queue. The "queueSize" property can only be changed
+		/// while the background thread is not running, i.e.,
+		/// before the first message has been logged, or after
+		/// the channel has been closed.
+		///
+		/// The "batchSize" property specifies the maximum number
+		/// of messages passed to the target channel at once when
+		/// a ring buffer is used. The default is 64.
+		///
+		/// The "overflow" property specifies what happens if
+		/// a message is logged while the ring buffer is full:
+		///    * block (default): wait until there is room
+		///    * drop: discard the new message
+		///    * dropLowest: discard the message with the lowest
+		///      priority (see OverflowPolicy)
+		///
+		/// A message logged by the background thread itself
+		/// (e.g., by the target channel) is discarded instead
+		/// of blocking.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the "queueSize", "batchSize" or
+		/// "overflow" property.
+
+	Poco::UInt64 dropped() const;
+		/// Returns the number of messages that have been
+		/// discarded because the ring buffer was full.
 
 protected:
 	~AsyncChannel();
 	void run();
+	void runQueue();
+	void runRing();
 	void setPriority(const std::string& value);
+	void setQueueSize(const std::string& value);
+	void setBatchSize(const std::string& value);
+	void setOverflow(const std::string& value);
+	bool makeRoom(const Message& msg);
 		
 private:
+	struct Link
+		/// Links a slot of the ring buffer into the list of
+		/// all queued messages and into the list of queued
+		/// messages with the same priority, both oldest first.
+	{
+		std::size_t prev;
+		std::size_t next;
+		std::size_t nextSame;
+		int         prio;
+	};
+
+	typedef std::vector<Message> MessageVec;
+	typedef std::vector<Link> LinkVec;
+
+	void initRing(std::size_t size);
+	void push(const Message& msg);
+	void remove(std::size_t slot);
+
 	Channel*  _pChannel;
 	Thread    _thread;
 	FastMutex _threadMutex;
 	FastMutex _channelMutex;
 	NotificationQueue _queue;
+
+	MessageVec        _ring;
+	LinkVec           _links;
+	MessageVec        _batch;
+	std::size_t       _head;
+	std::size_t       _tail;
+	std::size_t       _free;
+	std::size_t       _prioHead[Message::PRIO_TRACE + 1];
+	std::size_t       _prioTail[Message::PRIO_TRACE + 1];
+	std::size_t       _count;
+	std::size_t       _batchSize;
+	OverflowPolicy    _overflow;
+	bool              _stop;
+	bool              _workerWaiting;
+	int               _blocked;
+	Poco::UInt64      _dropped;
+	mutable FastMutex _ringMutex;
+	Condition         _notEmpty;
+	Condition         _notFull;
 };
 
 
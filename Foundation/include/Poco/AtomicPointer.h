@@ -0,0 +1,133 @@
+//
+// AtomicPointer.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  AtomicPointer
+//
+// Definition of the AtomicPointer class template.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_AtomicPointer_INCLUDED
+#define Foundation_AtomicPointer_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+#if POCO_OS == POCO_OS_WINDOWS_NT
+	#include "Poco/UnWindows.h"
+#endif
+
+
+namespace Poco {
+
+
+template <class C>
+class AtomicPointer
+	/// AtomicPointer holds a plain pointer that can be read
+	/// and replaced concurrently by multiple threads.
+	///
+	/// load() has acquire semantics, so the object pointed to
+	/// is fully visible to a thread that loads a pointer stored
+	/// by another thread. exchange() acts as a full memory
+	/// barrier.
+	///
+	/// AtomicPointer does not manage the lifetime of the object
+	/// it points to; this must be done by the user, e.g., by deferring
+	/// deletion of a replaced object until no reader can use it anymore.
+	///
+	/// The same platforms as for AtomicCounter are supported;
+	/// on all other platforms, operations are guarded by a FastMutex.
+{
+public:
+	AtomicPointer():
+		_ptr(0)
+		/// Creates the AtomicPointer and initializes it to null.
+	{
+	}
+
+	explicit AtomicPointer(C* ptr):
+		_ptr(ptr)
+		/// Creates the AtomicPointer and initializes it with the given pointer.
+	{
+	}
+
+	~AtomicPointer()
+		/// Destroys the AtomicPointer. The object pointed to is not deleted.
+	{
+	}
+
+	C* load() const
+		/// Returns the pointer.
+	{
+#if defined(POCO_HAVE_STD_ATOMICS)
+		return _ptr.load(std::memory_order_acquire);
+#elif defined(__ATOMIC_ACQUIRE)
+		return __atomic_load_n(&_ptr, __ATOMIC_ACQUIRE);
+#elif POCO_OS == POCO_OS_WINDOWS_NT
+		C* ptr = _ptr;
+		MemoryBarrier();
+		return ptr;
+#elif POCO_OS == POCO_OS_MAC_OS_X || defined(POCO_HAVE_GCC_ATOMICS)
+		C* ptr = _ptr;
+		__sync_synchronize();
+		return ptr;
+#else
+		FastMutex::ScopedLock lock(_mutex);
+		return _ptr;
+#endif
+	}
+
+	C* exchange(C* ptr)
+		/// Replaces the pointer with the given one and
+		/// returns the previous pointer.
+	{
+#if defined(POCO_HAVE_STD_ATOMICS)
+		return _ptr.exchange(ptr);
+#elif defined(__ATOMIC_SEQ_CST)
+		return __atomic_exchange_n(&_ptr, ptr, __ATOMIC_SEQ_CST);
+#elif POCO_OS == POCO_OS_WINDOWS_NT
+		return static_cast<C*>(InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&_ptr), ptr));
+#elif POCO_OS == POCO_OS_MAC_OS_X || defined(POCO_HAVE_GCC_ATOMICS)
+		C* old;
+		do
+		{
+			old = _ptr;
+		}
+		while (!__sync_bool_compare_and_swap(&_ptr, old, ptr));
+		return old;
+#else
+		FastMutex::ScopedLock lock(_mutex);
+		C* old = _ptr;
+		_ptr = ptr;
+		return old;
+#endif
+	}
+
+private:
+	AtomicPointer(const AtomicPointer&);
+	AtomicPointer& operator = (const AtomicPointer&);
+
+#if defined(POCO_HAVE_STD_ATOMICS)
+	std::atomic<C*> _ptr;
+#else
+	C* volatile _ptr;
+#if !defined(__ATOMIC_ACQUIRE) && POCO_OS != POCO_OS_WINDOWS_NT && POCO_OS != POCO_OS_MAC_OS_X && !defined(POCO_HAVE_GCC_ATOMICS)
+	mutable FastMutex _mutex;
+#endif
+#endif
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_AtomicPointer_INCLUDED
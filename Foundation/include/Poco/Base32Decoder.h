@@ -32,6 +32,9 @@ class Foundation_API Base32DecoderBuf: public UnbufferedStreamBuf
 	/// This streambuf base32-decodes all data read
 	/// from the istream connected to it.
 	///
+	/// Data read with sgetn() (or istream::read())
+	/// is decoded in blocks.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -45,15 +48,43 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize count);
+
+	static int decodeGroup(const unsigned char* group, unsigned char* buffer);
+		/// Decodes a group of 8 valid characters, which may end
+		/// with padding, and returns the number of bytes
+		/// written to buffer.
+
+	static int decodeLastGroup(unsigned char* group, int length, unsigned char* buffer);
+		/// Decodes the last group of the input, which consists of
+		/// the given number of characters, and returns the number
+		/// of bytes written to buffer.
+		///
+		/// Throws a DataFormatException if group contains an invalid
+		/// character or if length is not valid for a final group.
+
+	static std::size_t decodeGroups(const unsigned char* data, std::size_t groups, unsigned char* buffer);
+		/// Decodes the given number of complete 8-character groups
+		/// and returns the number of bytes written to buffer.
+		///
+		/// Throws a DataFormatException if data contains
+		/// an invalid character.
 
 	unsigned char   _group[8];
 	int             _groupLength;
 	int             _groupIndex;
 	std::streambuf& _buf;
+	bool            _eof;
+		/// Set when the end of the connected stream has been reached.
+		/// The connected stream is not read from again, since some
+		/// streams (e.g. MultipartInputStream) do not stay at the end.
 	
-	static unsigned char IN_ENCODING[256];
-	static bool          IN_ENCODING_INIT;
-	
+	static const unsigned char IN_ENCODING[256];
+		/// Maps characters to their 5-bit value, '=' to 0x40
+		/// and invalid characters to 0xFF.
+
+	friend class Base32Decoder;
+
 private:
 	Base32DecoderBuf(const Base32DecoderBuf&);
 	Base32DecoderBuf& operator = (const Base32DecoderBuf&);
@@ -84,6 +115,9 @@ class Foundation_API Base32Decoder: public Base32DecoderIOS, public std::istream
 	/// This istream base32-decodes all data
 	/// read from the istream connected to it.
 	///
+	/// For data that is already in memory, the static
+	/// decode() function avoids the stream overhead.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -94,6 +128,21 @@ public:
 	Base32Decoder(std::istream& istr);
 	~Base32Decoder();
 
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes decode() writes
+		/// for the given number of characters.
+
+	static std::size_t decode(const char* data, std::size_t length, char* buffer);
+		/// Decodes length base32-encoded characters from data
+		/// and writes the result to buffer, which must have room
+		/// for at least decodedLength(length) bytes.
+		///
+		/// Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if data contains
+		/// an invalid character or ends with an incomplete
+		/// group of invalid length.
+
 private:
 	Base32Decoder(const Base32Decoder&);
 	Base32Decoder& operator = (const Base32Decoder&);
@@ -33,6 +33,9 @@ class Foundation_API Base32EncoderBuf: public UnbufferedStreamBuf
 	/// to it and forwards it to a connected
 	/// ostream.
 	///
+	/// Data written with sputn() (or ostream::write())
+	/// is encoded in blocks.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -47,6 +50,10 @@ public:
 
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
+	static void encodeGroups(const unsigned char* data, std::size_t groups, char* buffer);
+		/// Encodes the given number of complete 5-byte groups.
 
 	unsigned char   _group[5];
 	int             _groupLength;
@@ -56,6 +63,7 @@ private:
 	static const unsigned char OUT_ENCODING[32];
 	
 	friend class Base32DecoderBuf;
+	friend class Base32Encoder;
 
 	Base32EncoderBuf(const Base32EncoderBuf&);
 	Base32EncoderBuf& operator = (const Base32EncoderBuf&);
@@ -91,6 +99,9 @@ class Foundation_API Base32Encoder: public Base32EncoderIOS, public std::ostream
 	/// writing data, to ensure proper
 	/// completion of the encoding operation.
 	///
+	/// For data that is already in memory, the static
+	/// encode() function avoids the stream overhead.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -100,6 +111,17 @@ public:
 	Base32Encoder(std::ostream& ostr, bool padding = true);
 	~Base32Encoder();
 
+	static std::size_t encodedLength(std::size_t length, bool padding = true);
+		/// Returns the number of characters encode() writes
+		/// for the given number of bytes.
+
+	static std::size_t encode(const char* data, std::size_t length, char* buffer, bool padding = true);
+		/// Base32-encodes length bytes from data and writes
+		/// the result to buffer, which must have room for
+		/// at least encodedLength(length, padding) characters.
+		///
+		/// Returns the number of characters written.
+
 private:
 	Base32Encoder(const Base32Encoder&);
 	Base32Encoder& operator = (const Base32Encoder&);
@@ -32,6 +32,10 @@ class Foundation_API Base64DecoderBuf: public UnbufferedStreamBuf
 	/// This streambuf base64-decodes all data read
 	/// from the istream connected to it.
 	///
+	/// Data read with sgetn() (or istream::read())
+	/// is decoded in blocks, using SSSE3 instructions
+	/// if supported by the CPU.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -45,15 +49,36 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize count);
+
+	static int decodeGroup(const unsigned char* group, unsigned char* buffer);
+		/// Decodes a group of 4 valid characters and returns
+		/// the number of bytes written to buffer.
+
+	static std::size_t decodeBlock(const unsigned char* data, std::size_t length, unsigned char* buffer, unsigned char* carry, int& carryLength);
+		/// Decodes the given characters, skipping whitespace, and
+		/// writes all complete groups to buffer. The characters of
+		/// an incomplete group are kept in carry (which holds up to
+		/// 4 characters), which is also prepended to data.
+		///
+		/// Returns the number of bytes written to buffer, or throws
+		/// a DataFormatException if data contains an invalid character.
 
 	unsigned char   _group[3];
 	int             _groupLength;
 	int             _groupIndex;
 	std::streambuf& _buf;
+	bool            _eof;
+		/// Set when the end of the connected stream has been reached.
+		/// The connected stream is not read from again, since some
+		/// streams (e.g. MultipartInputStream) do not stay at the end.
 	
-	static unsigned char IN_ENCODING[256];
-	static bool          IN_ENCODING_INIT;
-	
+	static const unsigned char IN_ENCODING[256];
+		/// Maps characters to their 6-bit value, '=' to 0x40,
+		/// whitespace to 0x80 and invalid characters to 0xFF.
+
+	friend class Base64Decoder;
+
 private:
 	Base64DecoderBuf(const Base64DecoderBuf&);
 	Base64DecoderBuf& operator = (const Base64DecoderBuf&);
@@ -84,6 +109,9 @@ class Foundation_API Base64Decoder: public Base64DecoderIOS, public std::istream
 	/// This istream base64-decodes all data
 	/// read from the istream connected to it.
 	///
+	/// For data that is already in memory, the static
+	/// decode() function avoids the stream overhead.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -94,6 +122,22 @@ public:
 	Base64Decoder(std::istream& istr);
 	~Base64Decoder();
 
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes decode() writes
+		/// for the given number of characters.
+
+	static std::size_t decode(const char* data, std::size_t length, char* buffer);
+		/// Decodes length base64-encoded characters from data,
+		/// skipping whitespace, and writes the result to buffer,
+		/// which must have room for at least decodedLength(length)
+		/// bytes.
+		///
+		/// Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if data contains
+		/// an invalid character or ends in the middle of
+		/// a group.
+
 private:
 	Base64Decoder(const Base64Decoder&);
 	Base64Decoder& operator = (const Base64Decoder&);
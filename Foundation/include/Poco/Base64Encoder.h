@@ -33,6 +33,10 @@ class Foundation_API Base64EncoderBuf: public UnbufferedStreamBuf
 	/// to it and forwards it to a connected
 	/// ostream.
 	///
+	/// Data written with sputn() (or ostream::write())
+	/// is encoded in blocks, using SSSE3 instructions
+	/// if supported by the CPU.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -58,6 +62,10 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
+
+	static void encodeGroups(const unsigned char* data, std::size_t groups, char* buffer);
+		/// Encodes the given number of complete 3-byte groups.
 
 	unsigned char   _group[3];
 	int             _groupLength;
@@ -68,6 +76,7 @@ private:
 	static const unsigned char OUT_ENCODING[64];
 	
 	friend class Base64DecoderBuf;
+	friend class Base64Encoder;
 
 	Base64EncoderBuf(const Base64EncoderBuf&);
 	Base64EncoderBuf& operator = (const Base64EncoderBuf&);
@@ -103,6 +112,9 @@ class Foundation_API Base64Encoder: public Base64EncoderIOS, public std::ostream
 	/// writing data, to ensure proper
 	/// completion of the encoding operation.
 	///
+	/// For data that is already in memory, the static
+	/// encode() function avoids the stream overhead.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -112,6 +124,18 @@ public:
 	Base64Encoder(std::ostream& ostr);
 	~Base64Encoder();
 
+	static std::size_t encodedLength(std::size_t length);
+		/// Returns the number of characters encode() writes
+		/// for the given number of bytes.
+
+	static std::size_t encode(const char* data, std::size_t length, char* buffer);
+		/// Base64-encodes length bytes from data and writes
+		/// the result, including padding but without line breaks,
+		/// to buffer, which must have room for at least
+		/// encodedLength(length) characters.
+		///
+		/// Returns the number of characters written.
+
 private:
 	Base64Encoder(const Base64Encoder&);
 	Base64Encoder& operator = (const Base64Encoder&);
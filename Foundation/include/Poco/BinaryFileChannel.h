@@ -0,0 +1,140 @@
+//
+// BinaryFileChannel.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryFileChannel
+//
+// Definition of the BinaryFileChannel class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryFileChannel_INCLUDED
+#define Foundation_BinaryFileChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FileChannel.h"
+#include "Poco/Message.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicPointer.h"
+#include <vector>
+#include <map>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryFileChannel: public FileChannel
+	/// A FileChannel that writes log messages to a file in a
+	/// compact binary format, for high-rate trace logging.
+	///
+	/// LogRecords, as created by Logger::record(), are written without
+	/// formatting them. The format string and the source of a record
+	/// are written to the file only once; subsequent records refer to
+	/// them by a number and only contain the priority, time, thread
+	/// identifier and the binary encoded arguments. Messages passed
+	/// to log() are written as records with the format string "%s" and
+	/// the message text as argument.
+	///
+	/// Log files are converted to text with a BinaryLogDecoder, or with
+	/// the logdecode tool in the Foundation samples.
+	///
+	/// All properties of the FileChannel, including rotation, archiving
+	/// and purging, are supported. Every log file starts with a header,
+	/// which contains all format strings and sources known so far, so
+	/// that every file can be decoded on its own. A process appending to
+	/// an existing log file also starts with a new header.
+	///
+	/// The file format uses the native byte order, so log files must be
+	/// decoded on a system with the same byte order.
+	///
+	/// The numbers of format strings and sources that have already been
+	/// written are kept in a cache that is read without locking, so
+	/// writing a record usually only takes the lock of the log file.
+{
+public:
+	enum EntryType
+		/// Every entry in a binary log file starts with
+		/// one of the following characters.
+	{
+		ENTRY_HEADER     = 'H', /// "PLOG", version (1 byte), byte order mark (UInt16)
+		ENTRY_DEFINITION = 'D', /// id (UInt32), length (UInt32), string
+		ENTRY_RECORD     = 'R', /// format id (UInt32), source id (UInt32), priority (1 byte),
+		                        /// time (Int64), thread id (Int32), arguments length (UInt32), arguments
+		ENTRY_COMMENT    = '#'  /// text up to the next newline, as written by
+		                        /// RotateByIntervalStrategy
+	};
+
+	enum
+	{
+		VERSION         = 1,
+		BYTE_ORDER_MARK = 0x0102
+	};
+
+	BinaryFileChannel();
+		/// Creates the BinaryFileChannel.
+
+	BinaryFileChannel(const std::string& path);
+		/// Creates the BinaryFileChannel for a file with the given path.
+
+	void log(const Message& msg);
+		/// Writes the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Writes the given messages to the file.
+
+	void logRecord(const LogRecord& record);
+		/// Writes the given LogRecord to the file.
+
+protected:
+	~BinaryFileChannel();
+	void fileOpened(LogFile& file);
+
+private:
+	enum
+	{
+		CACHE_SIZE         = 256,
+		RECORD_HEADER_SIZE = 26, /// entry type, format id, source id, priority, time, thread id, arguments length
+		STACK_BUFFER_SIZE  = 512
+	};
+
+	struct CacheEntry
+	{
+		const void* key;
+		std::string str;
+		UInt32      id;
+	};
+
+	void write(const void* formatKey, const char* format, std::size_t formatLength, const void* sourceKey, const std::string& source, Message::Priority prio, const Timestamp& time, long tid, const char* prefix, std::size_t prefixLength, const char* args, std::size_t argsLength);
+	UInt32 lookup(const char* str, std::size_t length);
+	bool findCached(const void* key, const char* str, std::size_t length, UInt32& id) const;
+	void cache(const void* key, const char* str, std::size_t length, UInt32 id);
+	void appendDefinition(UInt32 id, const std::string& str);
+	template <typename T> void appendValue(T value);
+	static std::size_t slot(const void* key, const char* str, std::size_t length);
+	static void writeRecordHeader(char* pBuffer, UInt32 formatId, UInt32 sourceId, Message::Priority prio, const Timestamp& time, long tid, std::size_t argsSize);
+
+	typedef std::map<std::string, UInt32> StringMap;
+
+	std::vector<std::string>  _strings;
+	StringMap                 _idsByString;
+	std::string               _buffer;
+	std::string               _definitions;
+	AtomicPointer<CacheEntry> _cache[CACHE_SIZE];
+	FastMutex                 _mutex;
+	FastMutex                 _stringsMutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryFileChannel_INCLUDED
@@ -0,0 +1,84 @@
+//
+// BinaryLogDecoder.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogDecoder
+//
+// Definition of the BinaryLogDecoder class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogDecoder_INCLUDED
+#define Foundation_BinaryLogDecoder_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Message.h"
+#include <istream>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogDecoder
+	/// BinaryLogDecoder reads log files written by a
+	/// BinaryFileChannel and converts the records back
+	/// into formatted Messages.
+	///
+	/// Usage:
+	///     std::ifstream istr("trace.plog", std::ios::binary);
+	///     BinaryLogDecoder decoder(istr);
+	///     Message msg;
+	///     while (decoder.read(msg))
+	///     {
+	///         std::cout << msg.getText() << std::endl;
+	///     }
+{
+public:
+	BinaryLogDecoder(std::istream& istr);
+		/// Creates the BinaryLogDecoder for the given stream, which
+		/// must have been opened in binary mode.
+
+	~BinaryLogDecoder();
+		/// Destroys the BinaryLogDecoder.
+
+	bool read(Message& msg);
+		/// Reads the next record from the stream and stores it
+		/// in msg. Returns false if the end of the stream has been
+		/// reached. A truncated last record, as left behind by a
+		/// process that has been terminated while writing, is
+		/// treated like the end of the stream.
+		///
+		/// Throws a DataFormatException if the stream does
+		/// not contain a valid binary log.
+
+private:
+	BinaryLogDecoder();
+	BinaryLogDecoder(const BinaryLogDecoder&);
+	BinaryLogDecoder& operator = (const BinaryLogDecoder&);
+
+	bool readHeader();
+	bool readDefinition();
+	bool readBytes(char* buffer, std::size_t length);
+	bool readString(std::string& str, std::size_t length);
+	template <typename T> bool readValue(T& value);
+
+	std::istream&            _istr;
+	std::vector<std::string> _strings;
+	std::string              _args;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogDecoder_INCLUDED
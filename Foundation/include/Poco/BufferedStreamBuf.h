@@ -22,6 +22,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/BufferAllocator.h"
+#include "Poco/SizeClassAllocator.h"
 #include "Poco/StreamUtil.h"
 #include <streambuf>
 #include <iosfwd>
@@ -157,16 +158,17 @@ private:
 
 
 //
-// We provide an instantiation for char.
+// We provide an instantiation for char, which obtains its
+// buffer from the default SizeClassPool.
 //
 // Visual C++ needs a workaround - explicitly importing the template
 // instantiation - to avoid duplicate symbols due to multiple
 // instantiations in different libraries.
 //
 #if defined(_MSC_VER) && defined(POCO_DLL) && !defined(Foundation_EXPORTS)
-template class Foundation_API BasicBufferedStreamBuf<char, std::char_traits<char> >;
+template class Foundation_API BasicBufferedStreamBuf<char, std::char_traits<char>, SizeClassBufferAllocator<char> >;
 #endif
-typedef BasicBufferedStreamBuf<char, std::char_traits<char> > BufferedStreamBuf;
+typedef BasicBufferedStreamBuf<char, std::char_traits<char>, SizeClassBufferAllocator<char> > BufferedStreamBuf;
 
 
 } // namespace Poco
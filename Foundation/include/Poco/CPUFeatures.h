@@ -0,0 +1,80 @@
+//
+// CPUFeatures.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Definition of the CPUFeatures class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUFeatures_INCLUDED
+#define Foundation_CPUFeatures_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+//
+// POCO_HAVE_X86_INTRINSICS is defined if the compiler supports
+// x86 SIMD intrinsics for instruction sets not enabled for
+// the whole build, with functions marked POCO_TARGET_ISA("...").
+// Such functions must only be called if the corresponding
+// CPUFeatures function returns true.
+//
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(POCO_NO_SIMD)
+	#define POCO_HAVE_X86_INTRINSICS
+	#define POCO_TARGET_ISA(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)) && !defined(POCO_NO_SIMD)
+	#define POCO_HAVE_X86_INTRINSICS
+	#define POCO_TARGET_ISA(isa)
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API CPUFeatures
+	/// This class provides information about the instruction
+	/// set extensions supported by the CPU the program runs on,
+	/// for selecting optimized code paths at runtime.
+	///
+	/// All functions return false on CPUs other than x86.
+{
+public:
+	static bool hasSSE2();
+		/// Returns true if the CPU supports the SSE2 instructions,
+		/// which all x86-64 CPUs do.
+
+	static bool hasSSSE3();
+		/// Returns true if the CPU supports the SSSE3 instructions.
+
+	static bool hasSSE41();
+		/// Returns true if the CPU supports the SSE4.1 instructions.
+
+	static bool hasSSE42();
+		/// Returns true if the CPU supports the SSE4.2 instructions,
+		/// which include the CRC32C instruction.
+
+	static bool hasPCLMUL();
+		/// Returns true if the CPU supports the carry-less
+		/// multiplication (PCLMULQDQ) instruction.
+
+	static bool hasSHA();
+		/// Returns true if the CPU supports the SHA extensions
+		/// (SHA-1 and SHA-256).
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CPUFeatures_INCLUDED
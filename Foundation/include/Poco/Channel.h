@@ -24,12 +24,14 @@
 #include "Poco/Configurable.h"
 #include "Poco/Mutex.h"
 #include "Poco/RefCountedObject.h"
+#include <cstddef>
 
 
 namespace Poco {
 
 
 class Message;
+class LogRecord;
 
 
 class Foundation_API Channel: public Configurable, public RefCountedObject
@@ -58,6 +60,24 @@ public:
 		///
 		/// If the channel has not been opened yet, the log()
 		/// method will open it.
+
+	virtual void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given number of messages, in order.
+		///
+		/// Used by channels that collect messages, such as
+		/// AsyncChannel, to pass on several messages at once.
+		/// The default implementation calls log() for each
+		/// message. Subclasses can override this method to
+		/// process a batch more efficiently.
+
+	virtual void logRecord(const LogRecord& record);
+		/// Logs the given LogRecord, which holds an unformatted
+		/// message, as created by Logger::record().
+		///
+		/// The default implementation formats the record
+		/// into a Message and calls log(). Channels that can
+		/// store records without formatting them, such as
+		/// BinaryFileChannel, override this method.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Throws a PropertyNotSupportedException.
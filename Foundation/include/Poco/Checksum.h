@@ -27,7 +27,7 @@ namespace Poco {
 
 
 class Foundation_API Checksum
-	/// This class calculates CRC-32 or Adler-32 checksums
+	/// This class calculates CRC-32, CRC-32C or Adler-32 checksums
 	/// for arbitrary data.
 	///
 	/// A cyclic redundancy check (CRC) is a type of hash function, which is used to produce a 
@@ -38,13 +38,20 @@ class Foundation_API Checksum
 	/// It is almost as reliable as a 32-bit cyclic redundancy check for protecting against 
 	/// accidental modification of data, such as distortions occurring during a transmission, 
 	/// but is significantly faster to calculate in software.
-	
+	///
+	/// CRC-32C uses the Castagnoli polynomial, which has better error
+	/// detection properties than the one used for CRC-32. It is used
+	/// by iSCSI, SCTP, ext4 and many storage formats.
+	///
+	/// CRC-32 is calculated with the PCLMULQDQ instruction and CRC-32C
+	/// with the SSE4.2 CRC32 instruction, if supported by the CPU.
 {
 public:
 	enum Type
 	{
 		TYPE_ADLER32 = 0,
-		TYPE_CRC32
+		TYPE_CRC32,
+		TYPE_CRC32C
 	};
 
 	Checksum();
@@ -79,17 +79,16 @@
 // #define POCO_THREAD_PRIORITY_MAX 31
 
 
-// Define to disable small object optimization. If not
-// defined, Any and Dynamic::Var (and similar optimization
-// candidates) will be auto-allocated on the stack in
-// cases when value holder fits into POCO_SMALL_OBJECT_SIZE
-// (see below).
+// Define to disable small object optimization for Any.
+// If not defined, Any will be auto-allocated on the stack
+// in cases when value holder fits into POCO_SMALL_OBJECT_SIZE
+// (see below). Dynamic::Var always stores small values
+// in place.
 //
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-// !!! NOTE: Any/Dynamic::Var SOO will NOT work reliably   !!!
-// !!! without C++11 (std::aligned_storage in particular). !!!
+// !!! NOTE: Any SOO will NOT work reliably without C++11. !!!
 // !!! Only comment this out if your compiler has support  !!!
-// !!! for std::aligned_storage.                           !!!
+// !!! for C++11.                                          !!!
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //
 #ifndef POCO_NO_SOO
@@ -104,11 +103,20 @@
 // objects larger than this value will be alocated on the heap,
 // while those smaller will be placement new-ed into an
 // internal buffer.
-#if !defined(POCO_SMALL_OBJECT_SIZE) && !defined(POCO_NO_SOO)
+#if !defined(POCO_SMALL_OBJECT_SIZE)
 	#define POCO_SMALL_OBJECT_SIZE 32
 #endif
 
 
+// Size of the internal buffer of Dynamic::Var, which
+// stores values whose holders are not larger than this
+// value in place. Must be large enough for the holder
+// of a std::string value.
+#if !defined(POCO_VAR_SMALL_OBJECT_SIZE)
+	#define POCO_VAR_SMALL_OBJECT_SIZE 48
+#endif
+
+
 // Define to disable compilation of DirectoryWatcher
 // on platforms with no inotify.
 // #define POCO_NO_INOTIFY
@@ -53,6 +53,10 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the channel's stream.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given messages to the channel's stream,
+		/// flushing the stream only once.
 		
 protected:
 	~ConsoleChannel();
@@ -81,6 +81,11 @@ public:
 		///   * %% - percent sign
 		///
 		/// Class DateTimeFormat defines format strings for various standard date/time formats.
+		/// The ISO8601_FORMAT, ISO8601_FRAC_FORMAT, HTTP_FORMAT and RFC1123_FORMAT
+		/// formats are recognized and formatted by specialized code.
+		///
+		/// Use DateTimePattern to format many dates and times with
+		/// the same custom format.
 
 	static std::string format(const DateTime& dateTime, const std::string& fmt, int timeZoneDifferential = UTC);
 		/// Formats the given date and time according to the given format.
@@ -149,6 +154,13 @@ public:
 		/// and appends it to the given string.
 		/// If timeZoneDifferential is UTC, "GMT" is returned,
 		/// otherwise ++HHMM (or -HHMM) is returned.
+
+private:
+	static void append(std::string& str, const DateTime& dateTime, char spec, int timeZoneDifferential);
+		/// Appends the value for the given format specifier character
+		/// (the character following the '%') to str.
+
+	friend class DateTimePattern;
 };
 
 
@@ -157,8 +169,10 @@ public:
 //
 inline std::string DateTimeFormatter::format(const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
 {
-	DateTime dateTime(timestamp);
-	return format(dateTime, fmt, timeZoneDifferential);
+	std::string result;
+	result.reserve(64);
+	append(result, timestamp, fmt, timeZoneDifferential);
+	return result;
 }
 
 
@@ -186,13 +200,6 @@ inline std::string DateTimeFormatter::format(const Timespan& timespan, const std
 }
 
 
-inline void DateTimeFormatter::append(std::string& str, const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
-{
-	DateTime dateTime(timestamp);
-	append(str, dateTime, fmt, timeZoneDifferential);
-}
-
-
 inline std::string DateTimeFormatter::tzdISO(int timeZoneDifferential)
 {
 	std::string result;
@@ -55,6 +55,11 @@ class Foundation_API DateTimeParser
 	/// If more strict format validation of date/time strings is required, a regular
 	/// expression could be used for initial validation, before passing the string
 	/// to DateTimeParser.
+	///
+	/// Strings in the ISO8601_FORMAT, ISO8601_FRAC_FORMAT, HTTP_FORMAT and
+	/// RFC1123_FORMAT formats are recognized by specialized code if they
+	/// strictly follow the layout produced by DateTimeFormatter. Other
+	/// strings are parsed as described above.
 {
 public:
 	static void parse(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential);
@@ -109,6 +114,50 @@ public:
 protected:
 	static int parseTZD(std::string::const_iterator& it, const std::string::const_iterator& end);
 	static int parseAMPM(std::string::const_iterator& it, const std::string::const_iterator& end, int hour);
+
+private:
+	struct Fields
+	{
+		Fields():
+			year(0),
+			month(0),
+			day(0),
+			hour(0),
+			minute(0),
+			second(0),
+			millis(0),
+			micros(0),
+			tzd(0)
+		{
+		}
+
+		int year;
+		int month;
+		int day;
+		int hour;
+		int minute;
+		int second;
+		int millis;
+		int micros;
+		int tzd;
+	};
+
+	static void parse(char spec, std::string::const_iterator& it, const std::string::const_iterator& end, Fields& fields);
+		/// Parses the value for the given format specifier character
+		/// (the character following the '%').
+
+	static void assign(Fields& fields, DateTime& dateTime, int& timeZoneDifferential);
+		/// Assigns the parsed fields to dateTime and timeZoneDifferential.
+		/// Throws a SyntaxException if the fields do not form a valid date and time.
+
+	static bool parseStandard(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential);
+		/// Parses str if fmt is one of the standard formats with a fixed layout
+		/// and str strictly follows that layout. Returns false otherwise,
+		/// without changing dateTime and timeZoneDifferential.
+		/// Like parse(), throws a SyntaxException if the date and time
+		/// are out of range.
+
+	friend class DateTimePattern;
 };
 
 
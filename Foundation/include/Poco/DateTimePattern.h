@@ -0,0 +1,158 @@
+//
+// DateTimePattern.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  DateTimePattern
+//
+// Definition of the DateTimePattern class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_DateTimePattern_INCLUDED
+#define Foundation_DateTimePattern_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/DateTime.h"
+#include "Poco/LocalDateTime.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/Timestamp.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/AtomicPointer.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API DateTimePattern
+	/// A DateTimePattern is a date/time format string, as used by
+	/// DateTimeFormatter and DateTimeParser, that is compiled into a
+	/// list of actions once, so that it can be used for formatting
+	/// and parsing many dates and times without interpreting the
+	/// format string over and over again.
+	///
+	/// The standard formats with a fixed layout (ISO8601_FORMAT,
+	/// ISO8601_FRAC_FORMAT, HTTP_FORMAT and RFC1123_FORMAT) are
+	/// handled by the specialized code in DateTimeFormatter and
+	/// DateTimeParser.
+	///
+	/// For formats that do not contain fractional seconds, the
+	/// DateTimePattern remembers the result of the most recent
+	/// format() or append() call, so that formatting the current
+	/// time over and over again, as done by loggers and servers,
+	/// formats the date and time only once per second.
+	///
+	/// A DateTimePattern can be used by multiple threads
+	/// concurrently. Looking up the remembered result does
+	/// not lock; only replacing it does.
+	///
+	/// See DateTimeFormatter::format() for a description of the format string.
+{
+public:
+	explicit DateTimePattern(const std::string& fmt);
+		/// Creates the DateTimePattern for the given format string.
+
+	~DateTimePattern();
+		/// Destroys the DateTimePattern.
+
+	const std::string& toString() const;
+		/// Returns the format string.
+
+	std::string format(const Timestamp& timestamp, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given timestamp.
+
+	std::string format(const DateTime& dateTime, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given date and time.
+
+	std::string format(const LocalDateTime& dateTime) const;
+		/// Formats the given local date and time.
+
+	void append(std::string& str, const Timestamp& timestamp, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given timestamp and appends it to str.
+
+	void append(std::string& str, const DateTime& dateTime, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given date and time and appends it to str.
+
+	void append(std::string& str, const LocalDateTime& dateTime) const;
+		/// Formats the given local date and time and appends it to str.
+
+	void parse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Throws a SyntaxException if the string cannot be successfully parsed.
+		///
+		/// The result is the same as for DateTimeParser::parse().
+
+	DateTime parse(const std::string& str, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Throws a SyntaxException if the string cannot be successfully parsed.
+
+	bool tryParse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Returns true if the string has been successfully parsed, false otherwise.
+
+private:
+	DateTimePattern();
+	DateTimePattern(const DateTimePattern&);
+	DateTimePattern& operator = (const DateTimePattern&);
+
+	void appendUncached(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const;
+	bool appendCached(std::string& str, Timestamp::UtcTimeVal utcTime, int timeZoneDifferential) const;
+	void updateCache(const std::string& str, std::string::size_type pos, Timestamp::UtcTimeVal utcTime, int timeZoneDifferential) const;
+
+	struct CacheEntry
+		/// A remembered result. Entries are reused once no
+		/// lookup references them, and are only deleted
+		/// together with the DateTimePattern.
+	{
+		AtomicCounter         refs;
+		Timestamp::UtcTimeVal second;
+		int                   tzd;
+		std::string           text;
+	};
+
+	typedef std::vector<CacheEntry*> CacheVec;
+
+	struct Action
+		/// Literal text, followed by a format specifier
+		/// character (or 0 at the end of the format).
+	{
+		std::string text;
+		char spec;
+	};
+
+	typedef std::vector<Action> ActionVec;
+
+	std::string _fmt;
+	ActionVec   _actions;
+	bool        _standard;
+	bool        _cacheable;
+
+	mutable AtomicPointer<CacheEntry> _pCache;
+	mutable CacheVec                  _cacheEntries;
+	mutable FastMutex                 _cacheMutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& DateTimePattern::toString() const
+{
+	return _fmt;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_DateTimePattern_INCLUDED
@@ -77,6 +77,12 @@ class Foundation_API Var
 	/// 
 	/// A Var can be created from and converted to a value of any type for which a specialization of 
 	/// VarHolderImpl is available. For supported types, see VarHolder documentation.
+	///
+	/// Values whose VarHolderImpl fits into POCO_VAR_SMALL_OBJECT_SIZE bytes (numbers, booleans,
+	/// characters, date/time values, strings and shared pointers) are stored
+	/// inside the Var, without a heap allocation. Larger values are stored in a VarHolderImpl
+	/// allocated on the heap. Swapping two Vars, and moving a Var if C++11 is enabled,
+	/// never allocates memory for these types.
 {
 public:
 	typedef SharedPtr<Var>             Ptr;
@@ -89,15 +95,9 @@ public:
 	template <typename T> 
 	Var(const T& val)
 		/// Creates the Var from the given value.
-#ifdef POCO_NO_SOO
-		: _pHolder(new VarHolderImpl<T>(val))
-	{
-	}
-#else
 	{
 		construct(val);
 	}
-#endif
 
 	Var(const char* pVal);
 		// Convenience constructor for const char* which gets mapped to a std::string internally, i.e. pVal is deep-copied.
@@ -105,11 +105,19 @@ public:
 	Var(const Var& other);
 		/// Copy constructor.
 
+#ifdef POCO_ENABLE_CPP11
+	Var(Var&& other);
+		/// Move constructor. Leaves other empty.
+#endif
+
 	~Var();
 		/// Destroys the Var.
 
 	void swap(Var& other);
 		/// Swaps the content of the this Var with the other Var.
+		///
+		/// Values stored on the heap are swapped by pointer, values
+		/// stored in place are moved (see VarHolder::move()).
 
 	ConstIterator begin() const;
 		/// Returns the const Var iterator.
@@ -229,12 +237,8 @@ public:
 	Var& operator = (const T& other)
 		/// Assignment operator for assigning POD to Var
 	{
-#ifdef POCO_NO_SOO
 		Var tmp(other);
 		swap(tmp);
-#else
-		construct(other);
-#endif
 		return *this;
 	}
 
@@ -244,6 +248,11 @@ public:
 	Var& operator = (const Var& other);
 		/// Assignment operator specialization for Var
 
+#ifdef POCO_ENABLE_CPP11
+	Var& operator = (Var&& other);
+		/// Move assignment operator. Leaves other empty.
+#endif
+
 	template <typename T>
 	const Var operator + (const T& other) const
 		/// Addition operator for adding POD to Var
@@ -593,22 +602,6 @@ private:
 
 	Var& structIndexOperator(VarHolderImpl<Struct<int> >* pStr, int n) const;
 
-#ifdef POCO_NO_SOO
-
-	VarHolder* content() const
-	{
-		return _pHolder;
-	}
-
-	void destruct()
-	{
-		if (!isEmpty()) delete content();
-	}
-
-	VarHolder* _pHolder;
-
-#else
-
 	VarHolder* content() const
 	{
 		return _placeholder.content();
@@ -616,8 +609,9 @@ private:
 
 	template<typename ValueType>
 	void construct(const ValueType& value)
+		/// Creates the holder for the given value. The Var must be empty.
 	{
-		if (sizeof(VarHolderImpl<ValueType>) <= Placeholder<ValueType>::Size::value)
+		if (VarHolderInPlace<ValueType>::value && sizeof(VarHolderImpl<ValueType>) <= Placeholder<VarHolder>::Size::value)
 		{
 			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<ValueType>(value);
 			_placeholder.setLocal(true);
@@ -629,30 +623,31 @@ private:
 		}
 	}
 
-	void construct(const char* value)
+	void construct(const Var& other)
+		/// Copies the holder of other. The Var must be empty.
+	{
+		if (!other.isEmpty())
+			other.content()->clone(&_placeholder);
+	}
+
+	void moveFrom(Var& other)
+		/// Takes over the value of other, which is left empty.
+		/// The Var must be empty.
 	{
-		std::string val(value);
-		if (sizeof(VarHolderImpl<std::string>) <= Placeholder<std::string>::Size::value)
+		if (other._placeholder.isLocal())
 		{
-			new (reinterpret_cast<VarHolder*>(_placeholder.holder)) VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(true);
+			other.content()->move(&_placeholder);
+			other.destruct();
 		}
 		else
 		{
-			_placeholder.pHolder = new VarHolderImpl<std::string>(val);
-			_placeholder.setLocal(false);
+			_placeholder.pHolder = other._placeholder.pHolder;
+			other._placeholder.erase();
 		}
 	}
 
-	void construct(const Var& other)
-	{
-		if (!other.isEmpty())
-			other.content()->clone(&_placeholder);
-		else
-			_placeholder.erase();
-	}
-
 	void destruct()
+		/// Destroys the holder and leaves the Var empty.
 	{
 		if (!isEmpty())
 		{
@@ -660,12 +655,11 @@ private:
 				content()->~VarHolder();
 			else
 				delete content();
+			_placeholder.erase();
 		}
 	}
 
 	Placeholder<VarHolder> _placeholder;
-
-#endif // POCO_NO_SOO
 };
 
 
@@ -680,12 +674,6 @@ private:
 
 inline void Var::swap(Var& other)
 {
-#ifdef POCO_NO_SOO
-
-	std::swap(_pHolder, other._pHolder);
-
-#else
-
 	if (this == &other) return;
 
 	if (!_placeholder.isLocal() && !other._placeholder.isLocal())
@@ -694,21 +682,11 @@ inline void Var::swap(Var& other)
 	}
 	else
 	{
-		Var tmp(*this);
-		try
-		{
-			if (_placeholder.isLocal()) destruct();
-			construct(other);
-			other = tmp;
-		}
-		catch (...)
-		{
-			construct(tmp);
-			throw;
-		}
+		Var tmp;
+		tmp.moveFrom(other);
+		other.moveFrom(*this);
+		moveFrom(tmp);
 	}
-
-#endif
 }
 
 
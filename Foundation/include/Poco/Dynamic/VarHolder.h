@@ -34,6 +34,7 @@
 #include "Poco/UTFString.h"
 #include "Poco/UTF8String.h"
 #include "Poco/Any.h"
+#include "Poco/SharedPtr.h"
 #include "Poco/Exception.h"
 #include <vector>
 #include <list>
@@ -103,6 +104,74 @@ void containerToJSON(C& cont, std::string& val)
 } // namespace Impl
 
 
+template <typename T>
+struct VarHolderInPlace
+	/// Tells whether a VarHolderImpl<T> may be stored in the
+	/// internal buffer of a Var, if it is small enough.
+	///
+	/// Only types that can be moved without throwing an exception
+	/// are stored in place, so that swapping and assigning Vars
+	/// never loses a value. These are the built-in types, Timestamp,
+	/// DateTime, LocalDateTime, SharedPtr, and the types whose
+	/// VarHolderImpl moves the value by swapping it (std::string,
+	/// UTF16String, std::vector). Values of all other types are
+	/// allocated on the heap.
+{
+	enum
+	{
+		value = 0
+	};
+};
+
+
+#define POCO_VAR_HOLDER_IN_PLACE(T) \
+	template <> struct VarHolderInPlace<T> { enum { value = 1 }; };
+
+POCO_VAR_HOLDER_IN_PLACE(Int8)
+POCO_VAR_HOLDER_IN_PLACE(Int16)
+POCO_VAR_HOLDER_IN_PLACE(Int32)
+POCO_VAR_HOLDER_IN_PLACE(Int64)
+POCO_VAR_HOLDER_IN_PLACE(UInt8)
+POCO_VAR_HOLDER_IN_PLACE(UInt16)
+POCO_VAR_HOLDER_IN_PLACE(UInt32)
+POCO_VAR_HOLDER_IN_PLACE(UInt64)
+POCO_VAR_HOLDER_IN_PLACE(bool)
+POCO_VAR_HOLDER_IN_PLACE(float)
+POCO_VAR_HOLDER_IN_PLACE(double)
+POCO_VAR_HOLDER_IN_PLACE(char)
+#ifndef POCO_LONG_IS_64_BIT
+POCO_VAR_HOLDER_IN_PLACE(long)
+POCO_VAR_HOLDER_IN_PLACE(unsigned long)
+#endif
+POCO_VAR_HOLDER_IN_PLACE(Timestamp)
+POCO_VAR_HOLDER_IN_PLACE(DateTime)
+POCO_VAR_HOLDER_IN_PLACE(LocalDateTime)
+POCO_VAR_HOLDER_IN_PLACE(std::string)
+POCO_VAR_HOLDER_IN_PLACE(UTF16String)
+
+#undef POCO_VAR_HOLDER_IN_PLACE
+
+
+template <typename T>
+struct VarHolderInPlace<std::vector<T> >
+{
+	enum
+	{
+		value = 1
+	};
+};
+
+
+template <class C, class RC, class RP>
+struct VarHolderInPlace<SharedPtr<C, RC, RP> >
+{
+	enum
+	{
+		value = 1
+	};
+};
+
+
 class Foundation_API VarHolder
 	/// Interface for a data holder used by the Var class. 
 	/// Provides methods to convert between data types.
@@ -127,11 +196,23 @@ public:
 
 	virtual VarHolder* clone(Placeholder<VarHolder>* pHolder = 0) const = 0;
 		/// Implementation must implement this function to
-		/// deep-copy the VarHolder.
-		/// If small object optimization is enabled (i.e. if 
-		/// POCO_NO_SOO is not defined), VarHolder will be
-		/// instantiated in-place if it's size is smaller
-		/// than POCO_SMALL_OBJECT_SIZE.
+		/// deep-copy the VarHolder into the given placeholder.
+		/// The VarHolder will be instantiated in-place if its
+		/// size is not larger than POCO_VAR_SMALL_OBJECT_SIZE, and
+		/// VarHolderInPlace allows it for the type.
+
+	virtual VarHolder* move(Placeholder<VarHolder>* pHolder);
+		/// Moves the value into a new VarHolder created in the
+		/// given (empty) placeholder, and returns the new VarHolder.
+		/// The value of this VarHolder is unspecified afterwards.
+		///
+		/// Only called for VarHolders instantiated in-place,
+		/// and must not throw.
+		///
+		/// The default implementation copies the value using clone().
+		/// Specializations for types that own memory (strings,
+		/// containers) override it to swap the value instead,
+		/// so that moving never allocates memory.
 
 	virtual const std::type_info& type() const = 0;
 		/// Implementation must return the type information
@@ -276,19 +357,15 @@ protected:
 	template <typename T>
 	VarHolder* cloneHolder(Placeholder<VarHolder>* pVarHolder, const T& val) const
 		/// Instantiates value holder wrapper. If size of the wrapper is
-		/// larger than POCO_SMALL_OBJECT_SIZE, holder is instantiated on
+		/// larger than POCO_VAR_SMALL_OBJECT_SIZE, or VarHolderInPlace does
+		/// not allow it for the type, holder is instantiated on
 		/// the heap, otherwise it is instantiated in-place (in the 
 		/// pre-allocated buffer inside the holder).
 		/// 
-		/// Called from clone() member function of the implementation when
-		/// small object optimization is enabled.
+		/// Called from clone() member function of the implementation.
 	{
-#ifdef POCO_NO_SOO
-		(void)pVarHolder;
-		return new VarHolderImpl<T>(val);
-#else
 		poco_check_ptr (pVarHolder);
-		if ((sizeof(VarHolderImpl<T>) <= Placeholder<T>::Size::value))
+		if (VarHolderInPlace<T>::value && sizeof(VarHolderImpl<T>) <= Placeholder<VarHolder>::Size::value)
 		{
 			new ((VarHolder*) pVarHolder->holder) VarHolderImpl<T>(val);
 			pVarHolder->setLocal(true);
@@ -300,7 +377,6 @@ protected:
 			pVarHolder->setLocal(false);
 			return pVarHolder->pHolder;
 		}
-#endif
 	}
 
 	template <typename F, typename T>
@@ -2541,6 +2617,13 @@ public:
 		return cloneHolder(pVarHolder, _val);
 	}
 
+	VarHolder* move(Placeholder<VarHolder>* pVarHolder)
+	{
+		VarHolderImpl* pHolder = static_cast<VarHolderImpl*>(cloneHolder(pVarHolder, std::string()));
+		pHolder->_val.swap(_val);
+		return pHolder;
+	}
+
 	const std:: string& value() const
 	{
 		return _val;
@@ -2579,6 +2662,10 @@ private:
 };
 
 
+// strings must be stored in place (see POCO_VAR_SMALL_OBJECT_SIZE)
+poco_static_assert (sizeof(VarHolderImpl<std::string>) <= POCO_VAR_SMALL_OBJECT_SIZE);
+
+
 template <>
 class VarHolderImpl<UTF16String>: public VarHolder
 {
@@ -2722,6 +2809,13 @@ public:
 		return cloneHolder(pVarHolder, _val);
 	}
 
+	VarHolder* move(Placeholder<VarHolder>* pVarHolder)
+	{
+		VarHolderImpl* pHolder = static_cast<VarHolderImpl*>(cloneHolder(pVarHolder, UTF16String()));
+		pHolder->_val.swap(_val);
+		return pHolder;
+	}
+
 	const Poco::UTF16String& value() const
 	{
 		return _val;
@@ -3075,6 +3169,13 @@ public:
 	{
 		return cloneHolder(pVarHolder, _val);
 	}
+
+	VarHolder* move(Placeholder<VarHolder>* pVarHolder)
+	{
+		VarHolderImpl* pHolder = static_cast<VarHolderImpl*>(cloneHolder(pVarHolder, std::vector<T>()));
+		pHolder->_val.swap(_val);
+		return pHolder;
+	}
 	
 	const std::vector<T>& value() const
 	{
@@ -3140,7 +3241,7 @@ public:
 	{
 		return cloneHolder(pVarHolder, _val);
 	}
-	
+
 	const std::list<T>& value() const
 	{
 		return _val;
@@ -0,0 +1,220 @@
+//
+// EventSnapshot.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Events
+// Module:  AbstractEvent
+//
+// Definition of the EventSnapshot template.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_EventSnapshot_INCLUDED
+#define Foundation_EventSnapshot_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/AtomicPointer.h"
+#include "Poco/Mutex.h"
+#include <vector>
+
+
+namespace Poco {
+
+
+template <class TStrategy>
+class EventSnapshot
+	/// Holds the copy of an event's strategy that AbstractEvent::notify()
+	/// dispatches to without locking. For internal use by AbstractEvent only.
+	///
+	/// Changing the event only discards the current copy. The next
+	/// notification makes a new copy, so adding n delegates in a row
+	/// copies the strategy once, not n times.
+	///
+	/// Every copy has its own reference count, which counts the
+	/// notifications using it, plus one while it is the current copy.
+	/// The copy is deleted by whoever releases the last reference, so
+	/// notifications using different copies never wait for each other.
+	///
+	/// A notification references the copy it has found and then checks
+	/// that the copy is still current. The small holders of the copies
+	/// are only deleted together with the EventSnapshot, and are reused
+	/// once they are no longer referenced, so such a check never reads
+	/// freed memory, and the number of holders is bounded by the number
+	/// of copies in use at the same time.
+{
+	struct Copy
+	{
+		AtomicCounter            refs;
+		AtomicPointer<TStrategy> pStrategy;
+	};
+
+public:
+	class ScopedNotify
+		/// References the current copy of the strategy
+		/// while a notification is in progress.
+	{
+	public:
+		ScopedNotify(EventSnapshot& snapshot):
+			_snapshot(snapshot),
+			_pCopy(snapshot.acquire())
+		{
+		}
+
+		~ScopedNotify()
+		{
+			if (_pCopy) release(_pCopy);
+		}
+
+		TStrategy* strategy() const
+			/// Returns the copy of the strategy used by
+			/// this notification, or null if there is none.
+		{
+			return _pCopy ? _pCopy->pStrategy.load() : 0;
+		}
+
+		TStrategy* update(const TStrategy& strat, bool enabled)
+			/// Makes a copy of the given strategy, unless a copy has
+			/// already been made since the last change, and uses it
+			/// for this notification. Returns the copy, or null if the
+			/// event is disabled or has no delegates.
+			///
+			/// Must be called with the event locked.
+		{
+			if (!_pCopy) _pCopy = _snapshot.update(strat, enabled);
+			return strategy();
+		}
+
+	private:
+		ScopedNotify(const ScopedNotify&);
+		ScopedNotify& operator = (const ScopedNotify&);
+
+		EventSnapshot& _snapshot;
+		Copy*          _pCopy;
+	};
+
+	EventSnapshot():
+		_stale(1)
+	{
+	}
+
+	~EventSnapshot()
+	{
+		for (typename std::vector<Copy*>::iterator it = _copies.begin(); it != _copies.end(); ++it)
+		{
+			delete (*it)->pStrategy.exchange(0);
+			delete *it;
+		}
+	}
+
+	bool empty() const
+		/// Returns true if there is nothing to notify: the event
+		/// is disabled or has no delegates, and has not been
+		/// changed since the last copy was made.
+	{
+		return !_pCurrent.load() && _stale.value() == 0;
+	}
+
+	void invalidate()
+		/// Discards the current copy of the strategy.
+		///
+		/// Must be called with the event locked,
+		/// after the strategy has been changed.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		_stale = 1;
+		Copy* pOld = _pCurrent.exchange(0);
+		if (pOld) release(pOld);
+	}
+
+private:
+	EventSnapshot(const EventSnapshot&);
+	EventSnapshot& operator = (const EventSnapshot&);
+
+	Copy* acquire()
+		/// Returns the current copy, with a reference
+		/// added, or null if there is none.
+	{
+		for (;;)
+		{
+			Copy* pCopy = _pCurrent.load();
+			if (!pCopy) return 0;
+			++pCopy->refs;
+			if (_pCurrent.load() == pCopy) return pCopy;
+			// discarded in the meantime
+			release(pCopy);
+		}
+	}
+
+	static void release(Copy* pCopy)
+		/// Removes a reference, and deletes the copy
+		/// of the strategy if it was the last one.
+	{
+		if (--pCopy->refs == 0)
+		{
+			// a late acquire() may have added and removed a reference
+			// in the meantime; exchange() makes sure only one of
+			// them deletes the strategy
+			delete pCopy->pStrategy.exchange(0);
+		}
+	}
+
+	Copy* update(const TStrategy& strategy, bool enabled)
+		/// Makes a new current copy if the strategy has changed,
+		/// and returns the current copy, with a reference added.
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		if (_stale.value() == 0) return acquire();
+
+		Copy* pCopy = 0;
+		if (enabled && !strategy.empty())
+		{
+			pCopy = unusedCopy();
+			TStrategy* pStrategy = new TStrategy(strategy);
+			// the references are added before the strategy is set,
+			// so that a late acquire() cannot delete it
+			++pCopy->refs; // current copy
+			++pCopy->refs; // this notification
+			pCopy->pStrategy.exchange(pStrategy);
+			_pCurrent.exchange(pCopy);
+		}
+		_stale = 0;
+		return pCopy;
+	}
+
+	Copy* unusedCopy()
+		/// Returns a holder that is not referenced and holds no
+		/// strategy, creating one if necessary. Must be called
+		/// with the mutex locked.
+	{
+		for (typename std::vector<Copy*>::iterator it = _copies.begin(); it != _copies.end(); ++it)
+		{
+			if ((*it)->refs.value() == 0 && !(*it)->pStrategy.load()) return *it;
+		}
+		_copies.reserve(_copies.size() + 1);
+		Copy* pCopy = new Copy;
+		_copies.push_back(pCopy);
+		return pCopy;
+	}
+
+	AtomicPointer<Copy> _pCurrent;
+	AtomicCounter       _stale;
+	std::vector<Copy*>  _copies;
+	FastMutex           _mutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_EventSnapshot_INCLUDED
@@ -31,6 +31,7 @@ namespace Poco {
 
 
 class LogFile;
+class Timer;
 class RotateStrategy;
 class ArchiveStrategy;
 class PurgeStrategy;
@@ -156,6 +157,20 @@ class Foundation_API FileChannel: public Channel
 	///   * true:  Every message is immediately flushed to the log file (default).
 	///   * false: Messages are not immediately flushed to the log file.
 	///
+	/// Messages are collected in a buffer, which is written to the
+	/// log file with a single system call when it is full, or,
+	/// if flush is true, after every message. The bufferSize property
+	/// specifies the capacity of the buffer in bytes (default 8192).
+	/// With flush set to false, a larger buffer trades durability
+	/// for throughput: up to bufferSize bytes of messages may be lost
+	/// if the process crashes.
+	///
+	/// The flushInterval property specifies an interval in milliseconds
+	/// at which a background thread writes the buffer to the log file,
+	/// which limits the time a message stays in the buffer when
+	/// flush is false. If 0 (the default), no background thread is used.
+	/// The interval takes effect when the channel is opened.
+	///
 	/// The rotateOnOpen property specifies whether an existing log file should be 
 	/// rotated (and archived) when the channel is opened. Valid values are:
 	///
@@ -181,6 +196,12 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given messages to the file, acquiring the
+		/// channel's lock only once. If flush is true, the
+		/// messages are written with a single system call
+		/// (group commit), unless rotation intervenes.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -207,6 +228,11 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be 
 		///                   rotated and archived when the channel is opened.
+		///   * bufferSize:   The capacity in bytes of the write buffer.
+		///                   See the FileChannel class for details.
+		///   * flushInterval: The interval in milliseconds at which
+		///                   buffered messages are written to the file.
+		///                   See the FileChannel class for details.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -231,6 +257,8 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
 
 protected:
 	~FileChannel();
@@ -241,9 +269,27 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setBufferSize(const std::string& size);
+	void setFlushInterval(const std::string& interval);
 	void purge();
 
+	virtual void fileOpened(LogFile& file);
+		/// Called, with the channel's lock held, whenever the
+		/// channel has opened a log file, either in open() or
+		/// after rotating the log file. Subclasses can override
+		/// this method to write a header to the file.
+		/// The default implementation does nothing.
+
+	void logData(const char* data, std::size_t length);
+		/// Writes the given data, without a line ending, to the
+		/// log file, after rotating the log file if necessary.
+		/// For use by subclasses that write binary data.
+
 private:
+	void rotateIfRequired();
+	void onFlush(Timer& timer);
+	void stopFlushTimer();
+
 	bool setNoPurge(const std::string& value);
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
@@ -258,7 +304,10 @@ private:
 	std::string      _purgeCount;
 	bool             _flush;
 	bool             _rotateOnOpen;
+	std::size_t      _bufferSize;
+	long             _flushInterval;
 	LogFile*         _pFile;
+	Timer*           _pFlushTimer;
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
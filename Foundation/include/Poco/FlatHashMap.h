@@ -0,0 +1,209 @@
+//
+// FlatHashMap.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashMap
+//
+// Definition of the FlatHashMap class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashMap_INCLUDED
+#define Foundation_FlatHashMap_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FlatHashTable.h"
+#include "Poco/Exception.h"
+#include <utility>
+
+
+namespace Poco {
+
+
+template <class Key, class Mapped>
+struct FlatHashMapKey
+	/// This class template is used internally by FlatHashMap.
+{
+	const Key& operator () (const std::pair<const Key, Mapped>& value) const
+	{
+		return value.first;
+	}
+};
+
+
+template <class Key, class Mapped, class HashFunc = Hash<Key> >
+class FlatHashMap
+	/// This class implements a map using a FlatHashTable.
+	///
+	/// A FlatHashMap can be used just like a std::map, except that
+	/// iterators and references to values are invalidated when the map
+	/// grows. Use reserve() to prevent this, and to avoid repeated growing
+	/// if the final size of the map is known.
+	///
+	/// Maps with std::string keys can be searched with a C string, without
+	/// constructing a temporary std::string.
+{
+public:
+	typedef Key                 KeyType;
+	typedef Mapped              MappedType;
+	typedef Mapped&             Reference;
+	typedef const Mapped&       ConstReference;
+	typedef Mapped*             Pointer;
+	typedef const Mapped*       ConstPointer;
+
+	typedef std::pair<const KeyType, MappedType> ValueType;
+	typedef std::pair<KeyType, MappedType>       PairType;
+
+	typedef FlatHashTable<ValueType, KeyType, FlatHashMapKey<KeyType, MappedType>, HashFunc> HashTable;
+
+	typedef typename HashTable::Iterator      Iterator;
+	typedef typename HashTable::ConstIterator ConstIterator;
+
+	FlatHashMap()
+		/// Creates an empty FlatHashMap.
+	{
+	}
+
+	FlatHashMap(std::size_t initialReserve):
+		_table(initialReserve)
+		/// Creates the FlatHashMap with room for initialReserve entries.
+	{
+	}
+
+	FlatHashMap(const FlatHashMap& map):
+		_table(map._table)
+		/// Creates the FlatHashMap by copying the entries of another one.
+	{
+	}
+
+	FlatHashMap& operator = (const FlatHashMap& map)
+		/// Assigns another FlatHashMap.
+	{
+		FlatHashMap tmp(map);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashMap& map)
+		/// Swaps the FlatHashMap with another one.
+	{
+		_table.swap(map._table);
+	}
+
+	ConstIterator begin() const
+	{
+		return _table.begin();
+	}
+
+	ConstIterator end() const
+	{
+		return _table.end();
+	}
+
+	Iterator begin()
+	{
+		return _table.begin();
+	}
+
+	Iterator end()
+	{
+		return _table.end();
+	}
+
+	template <class K>
+	ConstIterator find(const K& key) const
+	{
+		return _table.find(key);
+	}
+
+	template <class K>
+	Iterator find(const K& key)
+	{
+		return _table.find(key);
+	}
+
+	template <class K>
+	std::size_t count(const K& key) const
+	{
+		return _table.count(key);
+	}
+
+	std::pair<Iterator, bool> insert(const PairType& pair)
+	{
+		ValueType value(pair.first, pair.second);
+		return _table.insert(value);
+	}
+
+	std::pair<Iterator, bool> insert(const ValueType& value)
+	{
+		return _table.insert(value);
+	}
+
+	void erase(Iterator it)
+	{
+		_table.erase(it);
+	}
+
+	template <class K>
+	std::size_t erase(const K& key)
+	{
+		return _table.erase(key);
+	}
+
+	void clear()
+	{
+		_table.clear();
+	}
+
+	void reserve(std::size_t n)
+		/// Makes room for n entries.
+	{
+		_table.reserve(n);
+	}
+
+	std::size_t size() const
+	{
+		return _table.size();
+	}
+
+	bool empty() const
+	{
+		return _table.empty();
+	}
+
+	ConstReference operator [] (const KeyType& key) const
+	{
+		ConstIterator it = _table.find(key);
+		if (it != _table.end())
+			return it->second;
+		else
+			throw NotFoundException();
+	}
+
+	Reference operator [] (const KeyType& key)
+	{
+		Iterator it = _table.find(key);
+		if (it != _table.end())
+			return it->second;
+		else
+			return _table.insert(ValueType(key, MappedType())).first->second;
+	}
+
+private:
+	HashTable _table;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashMap_INCLUDED
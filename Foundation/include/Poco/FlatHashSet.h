@@ -0,0 +1,164 @@
+//
+// FlatHashSet.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashSet
+//
+// Definition of the FlatHashSet class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashSet_INCLUDED
+#define Foundation_FlatHashSet_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FlatHashTable.h"
+#include <utility>
+
+
+namespace Poco {
+
+
+template <class Value>
+struct FlatHashSetKey
+	/// This class template is used internally by FlatHashSet.
+{
+	const Value& operator () (const Value& value) const
+	{
+		return value;
+	}
+};
+
+
+template <class Value, class HashFunc = Hash<Value> >
+class FlatHashSet
+	/// This class implements a set using a FlatHashTable.
+	///
+	/// A FlatHashSet can be used just like a std::set, except that
+	/// iterators are invalidated when the set grows.
+	///
+	/// Sets of std::string can be searched with a C string, without
+	/// constructing a temporary std::string.
+{
+public:
+	typedef Value        ValueType;
+	typedef Value&       Reference;
+	typedef const Value& ConstReference;
+	typedef Value*       Pointer;
+	typedef const Value* ConstPointer;
+	typedef HashFunc     Hash;
+
+	typedef FlatHashTable<ValueType, ValueType, FlatHashSetKey<ValueType>, Hash> HashTable;
+
+	typedef typename HashTable::ConstIterator Iterator;
+	typedef typename HashTable::ConstIterator ConstIterator;
+
+	FlatHashSet()
+		/// Creates an empty FlatHashSet.
+	{
+	}
+
+	FlatHashSet(std::size_t initialReserve):
+		_table(initialReserve)
+		/// Creates the FlatHashSet with room for initialReserve values.
+	{
+	}
+
+	FlatHashSet(const FlatHashSet& set):
+		_table(set._table)
+		/// Creates the FlatHashSet by copying the values of another one.
+	{
+	}
+
+	FlatHashSet& operator = (const FlatHashSet& set)
+		/// Assigns another FlatHashSet.
+	{
+		FlatHashSet tmp(set);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashSet& set)
+		/// Swaps the FlatHashSet with another one.
+	{
+		_table.swap(set._table);
+	}
+
+	ConstIterator begin() const
+	{
+		return _table.begin();
+	}
+
+	ConstIterator end() const
+	{
+		return _table.end();
+	}
+
+	template <class K>
+	ConstIterator find(const K& value) const
+	{
+		return _table.find(value);
+	}
+
+	template <class K>
+	std::size_t count(const K& value) const
+	{
+		return _table.count(value);
+	}
+
+	std::pair<Iterator, bool> insert(const ValueType& value)
+	{
+		std::pair<typename HashTable::Iterator, bool> res = _table.insert(value);
+		return std::make_pair(Iterator(res.first), res.second);
+	}
+
+	void erase(ConstIterator it)
+	{
+		_table.erase(_table.find(*it));
+	}
+
+	template <class K>
+	std::size_t erase(const K& value)
+	{
+		return _table.erase(value);
+	}
+
+	void clear()
+	{
+		_table.clear();
+	}
+
+	void reserve(std::size_t n)
+		/// Makes room for n values.
+	{
+		_table.reserve(n);
+	}
+
+	std::size_t size() const
+	{
+		return _table.size();
+	}
+
+	bool empty() const
+	{
+		return _table.empty();
+	}
+
+private:
+	HashTable _table;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashSet_INCLUDED
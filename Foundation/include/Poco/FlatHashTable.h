@@ -0,0 +1,605 @@
+//
+// FlatHashTable.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashTable class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashTable_INCLUDED
+#define Foundation_FlatHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Hash.h"
+#include <iterator>
+#include <memory>
+#include <new>
+#include <cstring>
+#include <cstddef>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define POCO_FLATHASH_SSE2
+#endif
+
+
+namespace Poco {
+
+
+template <class Value, class Key, class KeyOfValue, class HashFunc>
+class FlatHashTable
+	/// This class implements an open addressing hash table
+	/// that stores its values in a single flat array.
+	///
+	/// For every slot, the table keeps a control byte, which either
+	/// marks the slot as empty or deleted, or holds seven bits of the
+	/// hash of the value stored in the slot. Slots are probed in groups
+	/// of 16; with SSE2, the control bytes of a group are compared with
+	/// a single instruction, so that a lookup typically inspects only one
+	/// group of control bytes and one slot. The table grows by doubling
+	/// its capacity when it is 7/8 full.
+	///
+	/// Lookups accept any key type that the hash function accepts and
+	/// that can be compared with the stored keys by operator ==, e.g.
+	/// a const char* for tables with std::string keys, if the hash
+	/// function returns the same hash for both (as Poco::Hash<std::string>
+	/// does).
+	///
+	/// Iterators and references are invalidated when the table grows.
+	/// Erasing an element only invalidates iterators to that element.
+	///
+	/// FlatHashTable is used internally by FlatHashMap and FlatHashSet.
+{
+public:
+	typedef Value        ValueType;
+	typedef Key          KeyType;
+	typedef Value&       Reference;
+	typedef const Value& ConstReference;
+	typedef Value*       Pointer;
+	typedef const Value* ConstPointer;
+
+	enum
+	{
+		GROUP_SIZE = 16
+	};
+
+	class ConstIterator: public std::iterator<std::forward_iterator_tag, Value>
+	{
+	public:
+		ConstIterator():
+			_pCtrl(0),
+			_pEnd(0),
+			_pSlot(0)
+		{
+		}
+
+		ConstIterator(const UInt8* pCtrl, const UInt8* pEnd, Value* pSlot):
+			_pCtrl(pCtrl),
+			_pEnd(pEnd),
+			_pSlot(pSlot)
+		{
+		}
+
+		bool operator == (const ConstIterator& it) const
+		{
+			return _pCtrl == it._pCtrl;
+		}
+
+		bool operator != (const ConstIterator& it) const
+		{
+			return _pCtrl != it._pCtrl;
+		}
+
+		const Value& operator * () const
+		{
+			return *_pSlot;
+		}
+
+		const Value* operator -> () const
+		{
+			return _pSlot;
+		}
+
+		ConstIterator& operator ++ () // prefix
+		{
+			++_pCtrl;
+			++_pSlot;
+			skipFree();
+			return *this;
+		}
+
+		ConstIterator operator ++ (int) // postfix
+		{
+			ConstIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+	protected:
+		void skipFree()
+		{
+			while (_pCtrl != _pEnd && !isFull(*_pCtrl))
+			{
+				++_pCtrl;
+				++_pSlot;
+			}
+		}
+
+		const UInt8* _pCtrl;
+		const UInt8* _pEnd;
+		Value*       _pSlot;
+
+		friend class FlatHashTable;
+	};
+
+	class Iterator: public ConstIterator
+	{
+	public:
+		Iterator()
+		{
+		}
+
+		Iterator(const UInt8* pCtrl, const UInt8* pEnd, Value* pSlot):
+			ConstIterator(pCtrl, pEnd, pSlot)
+		{
+		}
+
+		Value& operator * () const
+		{
+			return *this->_pSlot;
+		}
+
+		Value* operator -> () const
+		{
+			return this->_pSlot;
+		}
+
+		Iterator& operator ++ () // prefix
+		{
+			ConstIterator::operator ++ ();
+			return *this;
+		}
+
+		Iterator operator ++ (int) // postfix
+		{
+			Iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+	};
+
+	FlatHashTable():
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates an empty FlatHashTable. No memory is
+		/// allocated until the first value is inserted.
+	{
+	}
+
+	explicit FlatHashTable(std::size_t initialReserve):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable, with room for
+		/// initialReserve values.
+	{
+		reserve(initialReserve);
+	}
+
+	FlatHashTable(const FlatHashTable& table):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable by copying another one.
+	{
+		reserve(table._size);
+		for (ConstIterator it = table.begin(); it != table.end(); ++it)
+		{
+			insertUnique(*it, hashOf(KeyOfValue()(*it)));
+		}
+	}
+
+	~FlatHashTable()
+		/// Destroys the FlatHashTable.
+	{
+		destroy();
+	}
+
+	FlatHashTable& operator = (const FlatHashTable& table)
+		/// Assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashTable& table)
+		/// Swaps the FlatHashTable with another one.
+	{
+		std::swap(_pCtrl, table._pCtrl);
+		std::swap(_pSlots, table._pSlots);
+		std::swap(_capacity, table._capacity);
+		std::swap(_size, table._size);
+		std::swap(_growthLeft, table._growthLeft);
+		std::swap(_hash, table._hash);
+	}
+
+	ConstIterator begin() const
+	{
+		ConstIterator it(_pCtrl, _pCtrl + _capacity, _pSlots);
+		it.skipFree();
+		return it;
+	}
+
+	ConstIterator end() const
+	{
+		return ConstIterator(_pCtrl + _capacity, _pCtrl + _capacity, _pSlots + _capacity);
+	}
+
+	Iterator begin()
+	{
+		Iterator it(_pCtrl, _pCtrl + _capacity, _pSlots);
+		it.skipFree();
+		return it;
+	}
+
+	Iterator end()
+	{
+		return Iterator(_pCtrl + _capacity, _pCtrl + _capacity, _pSlots + _capacity);
+	}
+
+	template <class K>
+	ConstIterator find(const K& key) const
+		/// Returns an iterator to the value with the given key,
+		/// or end() if the table does not contain the key.
+	{
+		std::size_t i = findIndex(key, hashOf(key));
+		return i == _capacity ? end() : ConstIterator(_pCtrl + i, _pCtrl + _capacity, _pSlots + i);
+	}
+
+	template <class K>
+	Iterator find(const K& key)
+		/// Returns an iterator to the value with the given key,
+		/// or end() if the table does not contain the key.
+	{
+		std::size_t i = findIndex(key, hashOf(key));
+		return i == _capacity ? end() : Iterator(_pCtrl + i, _pCtrl + _capacity, _pSlots + i);
+	}
+
+	template <class K>
+	std::size_t count(const K& key) const
+		/// Returns the number of values with the given key (0 or 1).
+	{
+		return findIndex(key, hashOf(key)) == _capacity ? 0 : 1;
+	}
+
+	std::pair<Iterator, bool> insert(const Value& value)
+		/// Inserts the value if the table does not contain
+		/// a value with the same key yet.
+		///
+		/// Returns an iterator to the value with the key, and
+		/// true if the value has been inserted.
+	{
+		std::size_t h = hashOf(KeyOfValue()(value));
+		std::size_t i = findIndex(KeyOfValue()(value), h);
+		if (i != _capacity) return std::make_pair(Iterator(_pCtrl + i, _pCtrl + _capacity, _pSlots + i), false);
+		i = insertUnique(value, h);
+		return std::make_pair(Iterator(_pCtrl + i, _pCtrl + _capacity, _pSlots + i), true);
+	}
+
+	void erase(Iterator it)
+		/// Erases the value the iterator points to.
+	{
+		if (it != end()) eraseIndex(it._pCtrl - _pCtrl);
+	}
+
+	template <class K>
+	std::size_t erase(const K& key)
+		/// Erases the value with the given key, if present.
+		/// Returns the number of erased values (0 or 1).
+	{
+		std::size_t i = findIndex(key, hashOf(key));
+		if (i == _capacity) return 0;
+		eraseIndex(i);
+		return 1;
+	}
+
+	void clear()
+		/// Erases all values. The capacity is retained.
+	{
+		for (std::size_t i = 0; i < _capacity; ++i)
+		{
+			if (isFull(_pCtrl[i])) _pSlots[i].~Value();
+		}
+		if (_capacity) std::memset(_pCtrl, CTRL_EMPTY, _capacity);
+		_size = 0;
+		_growthLeft = maxLoad(_capacity);
+	}
+
+	void reserve(std::size_t n)
+		/// Makes room for n values, so that inserting
+		/// up to n values does not grow the table.
+	{
+		std::size_t capacity = _capacity ? _capacity : std::size_t(GROUP_SIZE);
+		while (maxLoad(capacity) < n) capacity *= 2;
+		if (capacity > _capacity) rehash(capacity);
+	}
+
+	std::size_t size() const
+	{
+		return _size;
+	}
+
+	bool empty() const
+	{
+		return _size == 0;
+	}
+
+	std::size_t capacity() const
+		/// Returns the number of slots.
+	{
+		return _capacity;
+	}
+
+private:
+	enum
+	{
+		CTRL_EMPTY   = 0x80,
+		CTRL_DELETED = 0xFE
+	};
+
+	class Group
+		/// The control bytes of a group of GROUP_SIZE slots.
+	{
+	public:
+		explicit Group(const UInt8* pCtrl)
+		{
+#if defined(POCO_FLATHASH_SSE2)
+			_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl));
+#else
+			_pCtrl = pCtrl;
+#endif
+		}
+
+		UInt32 match(UInt8 h2) const
+			/// Returns a bit mask of the slots with the given hash bits.
+		{
+#if defined(POCO_FLATHASH_SSE2)
+			return static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_ctrl, _mm_set1_epi8(static_cast<char>(h2)))));
+#else
+			UInt32 mask = 0;
+			for (int i = 0; i < GROUP_SIZE; ++i)
+			{
+				if (_pCtrl[i] == h2) mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+		UInt32 matchEmpty() const
+			/// Returns a bit mask of the empty slots.
+		{
+			return match(CTRL_EMPTY);
+		}
+
+		UInt32 matchFree() const
+			/// Returns a bit mask of the empty or deleted slots.
+		{
+#if defined(POCO_FLATHASH_SSE2)
+			return static_cast<UInt32>(_mm_movemask_epi8(_ctrl));
+#else
+			UInt32 mask = 0;
+			for (int i = 0; i < GROUP_SIZE; ++i)
+			{
+				if (_pCtrl[i] & 0x80) mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+	private:
+#if defined(POCO_FLATHASH_SSE2)
+		__m128i _ctrl;
+#else
+		const UInt8* _pCtrl;
+#endif
+	};
+
+	static bool isFull(UInt8 ctrl)
+	{
+		return (ctrl & 0x80) == 0;
+	}
+
+	static std::size_t maxLoad(std::size_t capacity)
+	{
+		return capacity - capacity/8;
+	}
+
+	static int lowestBit(UInt32 mask)
+	{
+#if defined(__GNUC__)
+		return __builtin_ctz(mask);
+#else
+		int n = 0;
+		while ((mask & 1) == 0)
+		{
+			mask >>= 1;
+			++n;
+		}
+		return n;
+#endif
+	}
+
+	template <class K>
+	std::size_t hashOf(const K& key) const
+		/// Returns the hash of the key, mixed so that hash functions
+		/// with weak low-order or high-order bits still work well.
+		/// The low 7 bits go into the control bytes, the remaining
+		/// bits select the first group to probe.
+	{
+		std::size_t h = _hash(key);
+		UInt32 m = static_cast<UInt32>(h);
+#if defined(POCO_PTR_IS_64_BIT)
+		m ^= static_cast<UInt32>(static_cast<UInt64>(h) >> 32);
+#endif
+		m ^= m >> 16;
+		m *= 0x85ebca6bU;
+		m ^= m >> 13;
+		m *= 0xc2b2ae35U;
+		m ^= m >> 16;
+		return m;
+	}
+
+	template <class K>
+	std::size_t findIndex(const K& key, std::size_t h) const
+		/// Returns the index of the slot containing the key,
+		/// or _capacity if the key is not found.
+	{
+		if (_size == 0) return _capacity;
+
+		UInt8 h2 = static_cast<UInt8>(h & 0x7F);
+		std::size_t groupMask = _capacity/GROUP_SIZE - 1;
+		std::size_t group = (h >> 7) & groupMask;
+		for (std::size_t step = 1; ; ++step)
+		{
+			const UInt8* pCtrl = _pCtrl + group*GROUP_SIZE;
+			Group g(pCtrl);
+			for (UInt32 mask = g.match(h2); mask; mask &= mask - 1)
+			{
+				std::size_t i = group*GROUP_SIZE + lowestBit(mask);
+				if (KeyOfValue()(_pSlots[i]) == key) return i;
+			}
+			if (g.matchEmpty()) return _capacity;
+			group = (group + step) & groupMask;
+		}
+	}
+
+	std::size_t findFree(std::size_t h) const
+		/// Returns the index of the first empty or deleted
+		/// slot in the probe sequence for the given hash.
+	{
+		std::size_t groupMask = _capacity/GROUP_SIZE - 1;
+		std::size_t group = (h >> 7) & groupMask;
+		for (std::size_t step = 1; ; ++step)
+		{
+			UInt32 mask = Group(_pCtrl + group*GROUP_SIZE).matchFree();
+			if (mask) return group*GROUP_SIZE + lowestBit(mask);
+			group = (group + step) & groupMask;
+		}
+	}
+
+	std::size_t insertUnique(const Value& value, std::size_t h)
+		/// Inserts a value whose key is known not to be in the
+		/// table, and returns its index.
+	{
+		if (_capacity == 0) rehash(GROUP_SIZE);
+		std::size_t i = findFree(h);
+		if (_growthLeft == 0 && _pCtrl[i] == CTRL_EMPTY)
+		{
+			// All usable slots hold values or deleted values. If there
+			// are enough deleted values, rehashing at the same capacity
+			// reclaims them, otherwise the table must grow.
+			rehash(_size*32 > _capacity*25 ? _capacity*2 : _capacity);
+			i = findFree(h);
+		}
+		new (_pSlots + i) Value(value);
+		if (_pCtrl[i] == CTRL_EMPTY) --_growthLeft;
+		_pCtrl[i] = static_cast<UInt8>(h & 0x7F);
+		++_size;
+		return i;
+	}
+
+	void eraseIndex(std::size_t i)
+	{
+		_pSlots[i].~Value();
+		--_size;
+		// Probing stops at a group with an empty slot. If the group
+		// has an empty slot, it has never been full, so no probe has
+		// ever continued past it, and the slot can become empty again.
+		// Otherwise, it must be marked as deleted.
+		if (Group(_pCtrl + (i & ~std::size_t(GROUP_SIZE - 1))).matchEmpty())
+		{
+			_pCtrl[i] = CTRL_EMPTY;
+			++_growthLeft;
+		}
+		else
+		{
+			_pCtrl[i] = CTRL_DELETED;
+		}
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		FlatHashTable table;
+		table.allocate(capacity);
+		for (std::size_t i = 0; i < _capacity; ++i)
+		{
+			if (isFull(_pCtrl[i]))
+			{
+				table.insertUnique(_pSlots[i], hashOf(KeyOfValue()(_pSlots[i])));
+			}
+		}
+		swap(table);
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		_pSlots = std::allocator<Value>().allocate(capacity);
+		try
+		{
+			_pCtrl = new UInt8[capacity];
+		}
+		catch (...)
+		{
+			std::allocator<Value>().deallocate(_pSlots, capacity);
+			_pSlots = 0;
+			throw;
+		}
+		std::memset(_pCtrl, CTRL_EMPTY, capacity);
+		_capacity   = capacity;
+		_growthLeft = maxLoad(capacity);
+	}
+
+	void destroy()
+	{
+		if (_capacity)
+		{
+			for (std::size_t i = 0; i < _capacity; ++i)
+			{
+				if (isFull(_pCtrl[i])) _pSlots[i].~Value();
+			}
+			std::allocator<Value>().deallocate(_pSlots, _capacity);
+			delete [] _pCtrl;
+		}
+	}
+
+	UInt8*      _pCtrl;
+	Value*      _pSlots;
+	std::size_t _capacity;
+	std::size_t _size;
+	std::size_t _growthLeft;
+	HashFunc    _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashTable_INCLUDED
@@ -36,6 +36,9 @@ std::size_t Foundation_API hash(UInt32 n);
 std::size_t Foundation_API hash(Int64 n);
 std::size_t Foundation_API hash(UInt64 n);
 std::size_t Foundation_API hash(const std::string& str);
+std::size_t Foundation_API hash(const char* str);
+	/// Returns the same hash as hash(const std::string&)
+	/// for a string with the same characters.
 
 
 template <class T>
@@ -50,6 +53,28 @@ struct Hash
 };
 
 
+template <>
+struct Hash<std::string>
+	/// The hash function for strings.
+	///
+	/// C strings are hashed like std::strings with the
+	/// same characters, so tables with std::string keys
+	/// can be searched with a C string.
+{
+	std::size_t operator () (const std::string& value) const
+		/// Returns the hash for the given string.
+	{
+		return Poco::hash(value);
+	}
+
+	std::size_t operator () (const char* value) const
+		/// Returns the hash for the given C string.
+	{
+		return Poco::hash(value);
+	}
+};
+
+
 //
 // inlines
 //
@@ -36,6 +36,9 @@ class Foundation_API HexBinaryDecoderBuf: public UnbufferedStreamBuf
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// Data read with sgetn() (or istream::read())
+	/// is decoded in blocks.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -49,8 +52,13 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize count);
 
 	std::streambuf& _buf;
+	bool            _eof;
+		/// Set when the end of the connected stream has been reached.
+		/// The connected stream is not read from again, since some
+		/// streams (e.g. MultipartInputStream) do not stay at the end.
 };
 
 
@@ -78,6 +86,9 @@ class Foundation_API HexBinaryDecoder: public HexBinaryDecoderIOS, public std::i
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// For data that is already in memory, the static
+	/// decode() function avoids the stream overhead.
+	///
 	/// Note: For performance reasons, the characters 
 	/// are read directly from the given istream's 
 	/// underlying streambuf, so the state
@@ -87,6 +98,21 @@ class Foundation_API HexBinaryDecoder: public HexBinaryDecoderIOS, public std::i
 public:
 	HexBinaryDecoder(std::istream& istr);
 	~HexBinaryDecoder();
+
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum number of bytes decode() writes
+		/// for the given number of characters.
+
+	static std::size_t decode(const char* data, std::size_t length, char* buffer);
+		/// Decodes length hexBinary-encoded characters from data,
+		/// skipping whitespace, and writes the result to buffer,
+		/// which must have room for at least decodedLength(length)
+		/// bytes.
+		///
+		/// Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if data contains
+		/// an invalid character or an odd number of digits.
 };
 
 
@@ -37,6 +37,10 @@ class Foundation_API HexBinaryEncoderBuf: public UnbufferedStreamBuf
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// Data written with sputn() (or ostream::write())
+	/// is encoded in blocks, using SSSE3 instructions
+	/// if supported by the CPU.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -65,6 +69,7 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize count);
 
 	int _pos;
 	int _lineLength;
@@ -102,6 +107,9 @@ class Foundation_API HexBinaryEncoder: public HexBinaryEncoderIOS, public std::o
 	/// See also: XML Schema Part 2: Datatypes (http://www.w3.org/TR/xmlschema-2/),
 	/// section 3.2.15.
 	///
+	/// For data that is already in memory, the static
+	/// encode() function avoids the stream overhead.
+	///
 	/// Note: The characters are directly written
 	/// to the ostream's streambuf, thus bypassing
 	/// the ostream. The ostream's state is therefore
@@ -110,6 +118,18 @@ class Foundation_API HexBinaryEncoder: public HexBinaryEncoderIOS, public std::o
 public:
 	HexBinaryEncoder(std::ostream& ostr);
 	~HexBinaryEncoder();
+
+	static std::size_t encodedLength(std::size_t length);
+		/// Returns the number of characters encode() writes
+		/// for the given number of bytes.
+
+	static std::size_t encode(const char* data, std::size_t length, char* buffer, bool uppercase = false);
+		/// Encodes length bytes from data in hexBinary encoding
+		/// and writes the result, without line breaks, to buffer,
+		/// which must have room for at least encodedLength(length)
+		/// characters.
+		///
+		/// Returns the number of characters written.
 };
 
 
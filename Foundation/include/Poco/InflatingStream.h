@@ -22,6 +22,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/BufferedStreamBuf.h"
+#include "Poco/Buffer.h"
 #include <istream>
 #include <ostream>
 #if defined(POCO_UNBUNDLED)
@@ -49,22 +50,34 @@ public:
 		STREAM_ZIP   /// STREAM_ZIP is handled as STREAM_ZLIB, except that we do not check the ADLER32 value (must be checked by caller)
 	};
 
-	InflatingStreamBuf(std::istream& istr, StreamType type);
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 32768
+	};
+
+	InflatingStreamBuf(std::istream& istr, StreamType type, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data read from
 		/// the give input stream.
+		///
+		/// The compressed data is read from the input stream in blocks of
+		/// bufferSize bytes. Larger blocks reduce the number of reads
+		/// when decompressing large amounts of data.
 
-	InflatingStreamBuf(std::istream& istr, int windowBits);
+	InflatingStreamBuf(std::istream& istr, int windowBits, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data read from
 		/// the given input stream.
 		///
 		/// Please refer to the zlib documentation of inflateInit2() for a description
 		/// of the windowBits parameter.
 
-	InflatingStreamBuf(std::ostream& ostr, StreamType type);
+	InflatingStreamBuf(std::ostream& ostr, StreamType type, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
+		///
+		/// The decompressed data is written to the output stream in blocks
+		/// of up to bufferSize bytes.
 
-	InflatingStreamBuf(std::ostream& ostr, int windowBits);
+	InflatingStreamBuf(std::ostream& ostr, int windowBits, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingStreamBuf for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
@@ -81,22 +94,45 @@ public:
 		
 	void reset();
 		/// Resets the stream buffer.
-		
+
+	static std::size_t inflate(const char* data, std::size_t length, Buffer<char>& buffer, StreamType type = STREAM_ZLIB);
+		/// Decompresses the complete zlib or gzip compressed data in one go,
+		/// without a stream, and appends the decompressed data to buffer,
+		/// which grows as needed. Returns the number of bytes appended.
+		///
+		/// Throws an IOException if the data is not valid or incomplete.
+
+	static std::size_t inflate(const char* data, std::size_t length, Buffer<char>& buffer, int windowBits);
+		/// Decompresses the complete compressed data in one go,
+		/// without a stream, and appends the decompressed data to buffer,
+		/// which grows as needed. Returns the number of bytes appended.
+		///
+		/// Please refer to the zlib documentation of inflateInit2() for a description
+		/// of the windowBits parameter.
+		///
+		/// Throws an IOException if the data is not valid or incomplete.
+
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
 	int writeToDevice(const char* buffer, std::streamsize length);
 	int sync();
+	std::streamsize xsgetn(char* buffer, std::streamsize length);
+	std::streamsize xsputn(const char* buffer, std::streamsize length);
 
 private:
 	enum 
 	{
-		STREAM_BUFFER_SIZE  = 1024,
-		INFLATE_BUFFER_SIZE = 32768
+		STREAM_BUFFER_SIZE = 1024
 	};
-	
+
+	static const std::size_t MAX_CHUNK_SIZE;
+
+	static std::size_t inflateBuffer(const char* data, std::size_t length, Buffer<char>& buffer, int windowBits, bool check);
+
 	std::istream*  _pIstr;
 	std::ostream*  _pOstr;
 	char*    _buffer;
+	std::size_t _bufferSize;
 	z_stream _zstr;
 	bool     _eof;
 	bool     _check;
@@ -110,22 +146,22 @@ class Foundation_API InflatingIOS: public virtual std::ios
 	/// order of the stream buffer and base classes.
 {
 public:
-	InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		
-	InflatingIOS(std::ostream& ostr, int windowBits);
+	InflatingIOS(std::ostream& ostr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
 		/// Please refer to the zlib documentation of inflateInit2() for a description
 		/// of the windowBits parameter.
 
-	InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data read from 
 		/// the given input stream.
 
-	InflatingIOS(std::istream& istr, int windowBits);
+	InflatingIOS(std::istream& istr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingIOS for expanding the compressed data read from 
 		/// the given input stream.
 		///
@@ -151,11 +187,11 @@ class Foundation_API InflatingOutputStream: public std::ostream, public Inflatin
 	/// must be called to ensure completion of decompression.
 {
 public:
-	InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingOutputStream for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		
-	InflatingOutputStream(std::ostream& ostr, int windowBits);
+	InflatingOutputStream(std::ostream& ostr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingOutputStream for expanding the compressed data passed through
 		/// and forwarding it to the given output stream.
 		///
@@ -187,11 +223,11 @@ class Foundation_API InflatingInputStream: public std::istream, public Inflating
 	/// to inflate the next stream.
 {
 public:
-	InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB);
+	InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type = InflatingStreamBuf::STREAM_ZLIB, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingInputStream for expanding the compressed data read from 
 		/// the given input stream.
 
-	InflatingInputStream(std::istream& istr, int windowBits);
+	InflatingInputStream(std::istream& istr, int windowBits, std::size_t bufferSize = InflatingStreamBuf::DEFAULT_BUFFER_SIZE);
 		/// Creates an InflatingInputStream for expanding the compressed data read from 
 		/// the given input stream.
 		///
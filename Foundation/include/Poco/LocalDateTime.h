@@ -258,6 +258,7 @@ private:
 	
 	friend class DateTimeFormatter;
 	friend class DateTimeParser;
+	friend class DateTimePattern;
 };
 
 
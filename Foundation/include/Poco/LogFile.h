@@ -40,42 +40,77 @@ namespace Poco {
 class Foundation_API LogFile: public LogFileImpl
 	/// This class is used by FileChannel to work
 	/// with a log file.
+	///
+	/// Text written to a LogFile is collected in a buffer,
+	/// which is written to the file with a single system call
+	/// when it is full, when flush() is called, or when
+	/// text is written with flush set to true.
 {
 public:
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 8192
+	};
+
 	LogFile(const std::string& path);
 		/// Creates the LogFile.
 
 	~LogFile();
-		/// Destroys the LogFile.
+		/// Writes any buffered text to the file
+		/// and destroys the LogFile.
 
 	void write(const std::string& text, bool flush = true);
-		/// Writes the given text to the log file.
-		/// If flush is true, the text will be immediately
-		/// flushed to the file.
+		/// Appends the given text, followed by a line ending,
+		/// to the buffer. If flush is true, or if the buffer
+		/// has reached its capacity, the buffer is written
+		/// to the file.
+
+	void writeData(const char* data, std::size_t length, bool flush = true);
+		/// Appends the given data, without a line ending, to the
+		/// buffer. If flush is true, or if the buffer has reached
+		/// its capacity, the buffer is written to the file.
+
+	void flush();
+		/// Writes any buffered text to the file.
+
+	void setBufferSize(std::size_t size);
+		/// Sets the capacity of the buffer, in bytes.
+		/// If size is 0, every line is written to
+		/// the file immediately.
+
+	std::size_t getBufferSize() const;
+		/// Returns the capacity of the buffer.
 
 	UInt64 size() const;
-		/// Returns the current size in bytes of the log file.
+		/// Returns the current size in bytes of the log file,
+		/// including buffered text.
 	
 	Timestamp creationDate() const;
 		/// Returns the date and time the log file was created.
 	
 	const std::string& path() const;
 		/// Returns the path given in the constructor.
+
+private:
+	void writeBuffer(bool flush);
+
+	std::string _buffer;
+	std::size_t _bufferSize;
 };
 
 
 //
 // inlines
 //
-inline void LogFile::write(const std::string& text, bool flush)
+inline std::size_t LogFile::getBufferSize() const
 {
-	writeImpl(text, flush);
+	return _bufferSize;
 }
 
 
 inline UInt64 LogFile::size() const
 {
-	return sizeImpl();
+	return sizeImpl() + _buffer.size();
 }
 
 
@@ -22,7 +22,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
-#include "Poco/FileStream.h"
+#include <cstddef>
 
 
 namespace Poco {
@@ -30,21 +30,23 @@ namespace Poco {
 
 class Foundation_API LogFileImpl
 	/// The implementation of LogFile for non-Windows platforms.
-	/// The native filesystem APIs are used for
-	/// total control over locking behavior.
+	/// The file is opened with O_APPEND and written with
+	/// unbuffered write() calls; buffering is done by LogFile.
+	/// The file size is tracked as data is written.
 {
 public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
-	void writeImpl(const std::string& text, bool flush);
+	void writeImpl(const char* data, std::size_t length, bool flush);
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
 
 private:
 	std::string _path;
-	mutable Poco::FileOutputStream _str;
-	Timestamp _creationDate;
+	int         _fd;
+	UInt64      _size;
+	Timestamp   _creationDate;
 };
 
 
@@ -23,6 +23,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Timestamp.h"
 #include "Poco/UnWindows.h"
+#include <cstddef>
 
 
 namespace Poco {
@@ -36,7 +37,7 @@ class Foundation_API LogFileImpl
 public:
 	LogFileImpl(const std::string& path);
 	~LogFileImpl();
-	void writeImpl(const std::string& text, bool flush);
+	void writeImpl(const char* data, std::size_t length, bool flush);
 	UInt64 sizeImpl() const;
 	Timestamp creationDateImpl() const;
 	const std::string& pathImpl() const;
@@ -0,0 +1,337 @@
+//
+// LogRecord.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  LogRecord
+//
+// Definition of the LogRecord class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_LogRecord_INCLUDED
+#define Foundation_LogRecord_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Message.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Any.h"
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API LogRecord
+	/// A LogRecord holds a log message that has not been formatted yet:
+	/// a format string for Poco::format() and the arguments, which are
+	/// captured in a compact binary form.
+	///
+	/// LogRecords are created by Logger::record() and passed to
+	/// Channel::logRecord(). A BinaryFileChannel writes them to a file
+	/// as they are, deferring formatting until the file is decoded
+	/// with a BinaryLogDecoder. All other channels format the record
+	/// into a Message with toMessage().
+	///
+	/// The following argument types are supported: bool, char, short,
+	/// unsigned short, int, unsigned, long, unsigned long, long long,
+	/// unsigned long long, Int64, UInt64, float (captured as double),
+	/// double, const char* and std::string.
+	/// The arguments must match the format specifiers, as required by
+	/// Poco::format().
+	///
+	/// Arguments are stored in an internal buffer; heap memory is only
+	/// allocated if the encoded arguments exceed INLINE_SIZE bytes.
+{
+public:
+	enum
+	{
+		INLINE_SIZE = 192
+	};
+
+	enum ArgType
+		/// The type tags of the encoded arguments.
+	{
+		ARG_BOOL   = 'b',
+		ARG_CHAR   = 'c',
+		ARG_SHORT  = 'h',
+		ARG_USHORT = 'H',
+		ARG_INT    = 'i',
+		ARG_UINT   = 'u',
+		ARG_LONG   = 'l',
+		ARG_ULONG  = 'L',
+		ARG_INT64  = 'q',
+		ARG_UINT64 = 'Q',
+		ARG_DOUBLE = 'd',
+		ARG_STRING = 's'
+	};
+
+	LogRecord(const std::string& source, const char* format, Message::Priority prio);
+		/// Creates a LogRecord for the given source, format string
+		/// and priority. The current time and thread are recorded.
+		///
+		/// The format string is not copied; it must remain valid
+		/// for the lifetime of the LogRecord.
+
+	~LogRecord();
+		/// Destroys the LogRecord.
+
+	LogRecord& operator << (bool value);
+	LogRecord& operator << (char value);
+	LogRecord& operator << (short value);
+	LogRecord& operator << (unsigned short value);
+	LogRecord& operator << (int value);
+	LogRecord& operator << (unsigned value);
+	LogRecord& operator << (long value);
+	LogRecord& operator << (unsigned long value);
+#if defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+	LogRecord& operator << (Int64 value);
+	LogRecord& operator << (UInt64 value);
+#elif defined(POCO_LONG_IS_64_BIT)
+	LogRecord& operator << (long long value);
+	LogRecord& operator << (unsigned long long value);
+#endif
+	LogRecord& operator << (float value);
+	LogRecord& operator << (double value);
+	LogRecord& operator << (const char* value);
+	LogRecord& operator << (const std::string& value);
+		/// Appends an argument.
+
+	const std::string& getSource() const;
+		/// Returns the source of the record.
+
+	const char* getFormat() const;
+		/// Returns the format string.
+
+	Message::Priority getPriority() const;
+		/// Returns the priority of the record.
+
+	const Timestamp& getTime() const;
+		/// Returns the time the record has been created.
+
+	long getTid() const;
+		/// Returns the numeric identifier of the Poco::Thread
+		/// that created the record, or 0 if the record has been
+		/// created by another thread.
+
+	const char* data() const;
+		/// Returns the encoded arguments.
+
+	std::size_t size() const;
+		/// Returns the size in bytes of the encoded arguments.
+
+	void toMessage(Message& msg) const;
+		/// Formats the record and stores the result, together with
+		/// source, priority, time and thread, in the given Message.
+
+	static void decode(const char* data, std::size_t size, std::vector<Any>& args);
+		/// Decodes the arguments encoded in the given buffer
+		/// and appends them to args.
+		///
+		/// Throws a DataFormatException if the buffer is
+		/// not well-formed.
+
+private:
+	LogRecord();
+	LogRecord(const LogRecord&);
+	LogRecord& operator = (const LogRecord&);
+
+	char* reserve(std::size_t size);
+	void grow(std::size_t size);
+
+	template <typename T>
+	LogRecord& append(char type, T value)
+	{
+		char* p = reserve(1 + sizeof(T));
+		*p = type;
+		std::memcpy(p + 1, &value, sizeof(T));
+		return *this;
+	}
+
+	const std::string& _source;
+	const char*        _format;
+	Message::Priority  _prio;
+	Timestamp          _time;
+	long               _tid;
+	char*              _pData;
+	std::size_t        _size;
+	std::size_t        _capacity;
+	char               _buffer[INLINE_SIZE];
+};
+
+
+//
+// inlines
+//
+inline char* LogRecord::reserve(std::size_t size)
+{
+	if (_size + size > _capacity) grow(_size + size);
+	char* p = _pData + _size;
+	_size += size;
+	return p;
+}
+
+
+inline LogRecord& LogRecord::operator << (bool value)
+{
+	return append(ARG_BOOL, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (char value)
+{
+	return append(ARG_CHAR, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (short value)
+{
+	return append(ARG_SHORT, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (unsigned short value)
+{
+	return append(ARG_USHORT, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (int value)
+{
+	return append(ARG_INT, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (unsigned value)
+{
+	return append(ARG_UINT, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (long value)
+{
+	return append(ARG_LONG, static_cast<Int64>(value));
+}
+
+
+inline LogRecord& LogRecord::operator << (unsigned long value)
+{
+	return append(ARG_ULONG, static_cast<UInt64>(value));
+}
+
+
+#if defined(POCO_HAVE_INT64) && !defined(POCO_LONG_IS_64_BIT)
+inline LogRecord& LogRecord::operator << (Int64 value)
+{
+	return append(ARG_INT64, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (UInt64 value)
+{
+	return append(ARG_UINT64, value);
+}
+#elif defined(POCO_LONG_IS_64_BIT)
+inline LogRecord& LogRecord::operator << (long long value)
+{
+	return append(ARG_INT64, static_cast<Int64>(value));
+}
+
+
+inline LogRecord& LogRecord::operator << (unsigned long long value)
+{
+	return append(ARG_UINT64, static_cast<UInt64>(value));
+}
+#endif
+
+
+inline LogRecord& LogRecord::operator << (float value)
+{
+	return append(ARG_DOUBLE, static_cast<double>(value));
+}
+
+
+inline LogRecord& LogRecord::operator << (double value)
+{
+	return append(ARG_DOUBLE, value);
+}
+
+
+inline LogRecord& LogRecord::operator << (const std::string& value)
+{
+	UInt32 length = static_cast<UInt32>(value.size());
+	char* p = reserve(1 + sizeof(length) + length);
+	*p = ARG_STRING;
+	std::memcpy(p + 1, &length, sizeof(length));
+	std::memcpy(p + 1 + sizeof(length), value.data(), length);
+	return *this;
+}
+
+
+inline LogRecord& LogRecord::operator << (const char* value)
+{
+	UInt32 length = static_cast<UInt32>(std::strlen(value));
+	char* p = reserve(1 + sizeof(length) + length);
+	*p = ARG_STRING;
+	std::memcpy(p + 1, &length, sizeof(length));
+	std::memcpy(p + 1 + sizeof(length), value, length);
+	return *this;
+}
+
+
+inline const std::string& LogRecord::getSource() const
+{
+	return _source;
+}
+
+
+inline const char* LogRecord::getFormat() const
+{
+	return _format;
+}
+
+
+inline Message::Priority LogRecord::getPriority() const
+{
+	return _prio;
+}
+
+
+inline const Timestamp& LogRecord::getTime() const
+{
+	return _time;
+}
+
+
+inline long LogRecord::getTid() const
+{
+	return _tid;
+}
+
+
+inline const char* LogRecord::data() const
+{
+	return _pData;
+}
+
+
+inline std::size_t LogRecord::size() const
+{
+	return _size;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_LogRecord_INCLUDED
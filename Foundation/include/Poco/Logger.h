@@ -23,6 +23,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Channel.h"
 #include "Poco/Message.h"
+#include "Poco/LogRecord.h"
 #include "Poco/Format.h"
 #include <map>
 #include <vector>
@@ -76,6 +77,17 @@ class Foundation_API Logger: public Channel
 	/// Variants of these macros that allow message formatting with Poco::format()
 	/// are also available. Up to four arguments are supported.
 	///
+	/// Level checks, including those done by the logging methods,
+	/// never lock, and a message that does not pass the level check
+	/// is never formatted. Logger::get() and Logger::has() look up
+	/// existing loggers without locking, so frequent lookups from
+	/// multiple threads do not block each other. A logger that is
+	/// destroyed while a lookup is in progress is only released
+	/// after the lookup has completed. When called from a Poco::Thread,
+	/// the logging methods build the message in a buffer owned by the
+	/// thread, so that no memory needs to be allocated for the message
+	/// once the buffer has grown to a suitable size.
+	///
 	/// Examples:
 	///     poco_warning(logger, "This is a warning");
 	///     poco_information_f2(logger, "An informational message with args: %d, %d", 1, 2);
@@ -401,6 +413,36 @@ public:
 		/// followed by the same sixteen bytes as ASCII characters.
 		/// For bytes outside the range 32 .. 127, a dot is printed.
 
+	void record(Message::Priority prio, const char* fmt);
+	template <typename T1>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1);
+	template <typename T1, typename T2>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2);
+	template <typename T1, typename T2, typename T3>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3);
+	template <typename T1, typename T2, typename T3, typename T4>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4);
+	template <typename T1, typename T2, typename T3, typename T4, typename T5>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5);
+	template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+	void record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6);
+		/// If the Logger's log level is at least prio, passes a LogRecord
+		/// holding the format string and the given arguments to the
+		/// channel, without formatting the message.
+		///
+		/// A BinaryFileChannel writes the record to a file as it is,
+		/// which makes this the cheapest way to log a message with
+		/// arguments. Other channels format the record with Poco::format().
+		/// See the LogRecord class for the supported argument types.
+		///
+		/// The format string must be a static string, such as a
+		/// string literal. It is not copied.
+
+	void logRecord(const LogRecord& record);
+		/// Passes the given LogRecord to the channel if its
+		/// priority is greater than or equal to the Logger's
+		/// log level.
+
 	bool is(int level) const;
 		/// Returns true if at least the given log level is set.
 		
@@ -491,6 +533,8 @@ public:
 	static Logger* has(const std::string& name);
 		/// Returns a pointer to the Logger with the given name if it
 		/// exists, or a null pointer otherwise.
+		///
+		/// The pointer becomes invalid when the logger is destroyed.
 		
 	static void destroy(const std::string& name);
 		/// Destroys the logger with the specified name. Does nothing
@@ -541,10 +585,32 @@ protected:
 	static Logger* find(const std::string& name);
 
 private:
+	class Foundation_API FormatBuffer
+		/// Provides the string the formatting logging methods
+		/// format the message text into. Within a Poco::Thread,
+		/// this is a string owned by the thread, which is reused
+		/// for all messages.
+	{
+	public:
+		FormatBuffer();
+		~FormatBuffer();
+		std::string& text();
+
+	private:
+		FormatBuffer(const FormatBuffer&);
+		FormatBuffer& operator = (const FormatBuffer&);
+
+		std::string* _pText;
+		bool*        _pBusy;
+		std::string  _text;
+	};
+
 	Logger();
 	Logger(const Logger&);
 	Logger& operator = (const Logger&);
 	
+	void sendMessage(const std::string& text, Message::Priority prio, const char* file, int line);
+
 	std::string _name;
 	Channel*    _pChannel;
 	int         _level;
@@ -710,7 +776,7 @@ inline void Logger::log(const std::string& text, Message::Priority prio)
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio));
+		sendMessage(text, prio, 0, 0);
 	}
 }
 
@@ -719,11 +785,99 @@ inline void Logger::log(const std::string& text, Message::Priority prio, const c
 {
 	if (_level >= prio && _pChannel)
 	{
-		_pChannel->log(Message(_name, text, prio, file, line));
+		sendMessage(text, prio, file, line);
+	}
+}
+
+
+inline void Logger::record(Message::Priority prio, const char* fmt)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+template <typename T1>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1;
+		_pChannel->logRecord(rec);
 	}
 }
 
 
+template <typename T1, typename T2>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1 << arg2;
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+template <typename T1, typename T2, typename T3>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1 << arg2 << arg3;
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+template <typename T1, typename T2, typename T3, typename T4>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1 << arg2 << arg3 << arg4;
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+template <typename T1, typename T2, typename T3, typename T4, typename T5>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1 << arg2 << arg3 << arg4 << arg5;
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+inline void Logger::record(Message::Priority prio, const char* fmt, const T1& arg1, const T2& arg2, const T3& arg3, const T4& arg4, const T5& arg5, const T6& arg6)
+{
+	if (_level >= prio && _pChannel)
+	{
+		LogRecord rec(_name, fmt, prio);
+		rec << arg1 << arg2 << arg3 << arg4 << arg5 << arg6;
+		_pChannel->logRecord(rec);
+	}
+}
+
+
+inline std::string& Logger::FormatBuffer::text()
+{
+	return *_pText;
+}
+
+
 inline void Logger::fatal(const std::string& msg)
 {
 	log(msg, Message::PRIO_FATAL);
@@ -818,93 +972,74 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 }
 
 
-#define INLINE01(name, PRIORITY) \
-inline void Logger::name(const std::string& fmt, const Any& value1) \
+// the message is only formatted if it passes the level check
+#define INLINE_FORMAT(PRIORITY, FORMAT_ARGS) \
 { \
-	log(Poco::format(fmt, value1), Message::PRIORITY); \
+	if (_level >= Message::PRIORITY && _pChannel) \
+	{ \
+		FormatBuffer buffer; \
+		Poco::format FORMAT_ARGS; \
+		sendMessage(buffer.text(), Message::PRIORITY, 0, 0); \
+	} \
 }
+
+#define INLINE01(name, PRIORITY) \
+inline void Logger::name(const std::string& fmt, const Any& value1) \
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1))
 #define INLINE02(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2) \
-{ \
-	log(Poco::format(fmt, value1, value2), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2))
 #define INLINE03(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3))
 
 #define INLINE04(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4))
 
 #define INLINE05(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5))
 
 #define INLINE06(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6))
 
 #define INLINE07(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7))
 
 #define INLINE08(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8))
 
 #define INLINE09(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9))
 
 #define INLINE10(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10))
 
 #define INLINE11(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10, const Any& value11) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11))
 
 #define INLINE12(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10, const Any& value11, const Any& value12) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12))
 
 #define INLINE13(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10, const Any& value11, const Any& value12, const Any& value13) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13))
 
 #define INLINE14(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10, const Any& value11, const Any& value12, const Any& value13, const Any& value14) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13, value14), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13, value14))
 
 #define INLINE15(name, PRIORITY) \
 inline void Logger::name(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10, const Any& value11, const Any& value12, const Any& value13, const Any& value14, const Any& value15) \
-{ \
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13, value14, value15), Message::PRIORITY); \
-}
+INLINE_FORMAT(PRIORITY, (buffer.text(), fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10, value11, value12, value13, value14, value15))
 
 #define INLINES(name, PRIORITY) \
 INLINE01(name, PRIORITY) \
@@ -948,6 +1083,7 @@ INLINES(trace,		PRIO_TRACE)
 #undef INLINE14
 #undef INLINE15
 #undef INLINES
+#undef INLINE_FORMAT
 
 inline bool Logger::is(int level) const
 {
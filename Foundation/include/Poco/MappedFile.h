@@ -0,0 +1,178 @@
+//
+// MappedFile.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Definition of the MappedFile class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFile_INCLUDED
+#define Foundation_MappedFile_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/MappedFile_WIN32.h"
+#else
+#include "Poco/MappedFile_POSIX.h"
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFile: private MappedFileImpl
+	/// A MappedFile maps the entire contents of a file into memory,
+	/// so that the file can be read (and, if mapped for writing,
+	/// modified) without copying its data into a buffer.
+	///
+	/// Unlike SharedMemory, a MappedFile is not shared with other
+	/// objects and unmaps the file when it is destroyed. An empty
+	/// file is mapped as an empty range, with begin() and end()
+	/// returning a null pointer.
+	///
+	/// The mapping reflects changes to the file made by other
+	/// processes. Accessing a part of the mapping that is no longer
+	/// backed by the file, because the file has been truncated,
+	/// results in a SIGBUS signal on POSIX platforms.
+{
+public:
+	enum AccessMode
+	{
+		AM_READ = 0,
+		AM_WRITE
+	};
+
+	enum Options
+	{
+		MF_PREFETCH   = 1, /// Read the entire file into memory when it is mapped.
+		MF_HUGE_PAGES = 2  /// Back the mapping with huge pages, if possible.
+	};
+
+	enum Advice
+	{
+		ADVICE_NORMAL = 0, /// No particular access pattern.
+		ADVICE_SEQUENTIAL, /// Sequential access; read ahead aggressively.
+		ADVICE_RANDOM,     /// Random access; do not read ahead.
+		ADVICE_WILLNEED,   /// The data will be accessed soon; start reading it.
+		ADVICE_DONTNEED    /// The data will not be accessed soon; pages may be released.
+	};
+
+	MappedFile();
+		/// Creates a MappedFile with no file mapped.
+
+	MappedFile(const std::string& path, AccessMode mode = AM_READ, int options = 0);
+		/// Maps the file with the given path into memory.
+		///
+		/// The options are a combination of the values of the Options
+		/// enumeration. With MF_PREFETCH, the file is read at once
+		/// (MAP_POPULATE on Linux), instead of page by page on first
+		/// access. MF_HUGE_PAGES (MADV_HUGEPAGE on Linux) reduces the
+		/// number of TLB misses when a large file is accessed randomly,
+		/// and is ignored if not supported by the system or file system.
+		///
+		/// Throws a FileNotFoundException if the file does not exist,
+		/// a FileAccessDeniedException if the file cannot be opened
+		/// in the given mode, an OpenFileException if the file is not
+		/// a regular file, or a SystemException if mapping fails.
+
+	~MappedFile();
+		/// Unmaps the file and destroys the MappedFile.
+
+	void map(const std::string& path, AccessMode mode = AM_READ, int options = 0);
+		/// Unmaps the currently mapped file, if any, and maps the
+		/// file with the given path. See the constructor for details.
+
+	void unmap();
+		/// Unmaps the file. Does nothing if no file is mapped.
+
+	void advise(Advice advice);
+		/// Tells the system how the mapped file will be accessed,
+		/// so that it can read ahead or release pages accordingly.
+		///
+		/// Ignored if not supported by the system.
+
+	void advise(Advice advice, std::size_t offset, std::size_t length);
+		/// Tells the system how the given range of the mapped file
+		/// will be accessed. The range is extended to page
+		/// boundaries and limited to the size of the file.
+
+	void flush();
+		/// Writes modified pages of a file mapped for writing
+		/// back to the file.
+
+	bool isMapped() const;
+		/// Returns true if a file is mapped.
+
+	const std::string& path() const;
+		/// Returns the path of the mapped file.
+
+	char* begin() const;
+		/// Returns the start address of the mapped file.
+
+	char* end() const;
+		/// Returns the address one past the end of the mapped file.
+
+	std::size_t size() const;
+		/// Returns the size of the mapped file.
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator = (const MappedFile&);
+
+	std::string _path;
+	bool _mapped;
+};
+
+
+//
+// inlines
+//
+inline bool MappedFile::isMapped() const
+{
+	return _mapped;
+}
+
+
+inline const std::string& MappedFile::path() const
+{
+	return _path;
+}
+
+
+inline char* MappedFile::begin() const
+{
+	return _address;
+}
+
+
+inline char* MappedFile::end() const
+{
+	return _address + _size;
+}
+
+
+inline std::size_t MappedFile::size() const
+{
+	return _size;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFile_INCLUDED
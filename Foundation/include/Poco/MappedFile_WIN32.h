@@ -0,0 +1,49 @@
+//
+// MappedFile_WIN32.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Definition of the MappedFileImpl class for Windows.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFile_WIN32_INCLUDED
+#define Foundation_MappedFile_WIN32_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFileImpl
+{
+protected:
+	MappedFileImpl();
+	~MappedFileImpl();
+	void mapImpl(const std::string& path, bool write, bool prefetch, bool hugePages);
+	void unmapImpl();
+	void adviseImpl(int advice, std::size_t offset, std::size_t length);
+	void flushImpl();
+
+	char*       _address;
+	std::size_t _size;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFile_WIN32_INCLUDED
@@ -0,0 +1,153 @@
+//
+// MappedStream.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedStream
+//
+// Definition of the MappedStreamBuf, MappedIOS and MappedInputStream classes.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedStream_INCLUDED
+#define Foundation_MappedStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/MappedFile.h"
+#include "Poco/StreamUtil.h"
+#include <streambuf>
+#include <istream>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedStreamBuf: public std::streambuf
+	/// This stream buffer maps a file into memory and reads directly
+	/// from the mapping, so no data is copied into a buffer and
+	/// the stream never needs to be refilled.
+	///
+	/// Readers that can process a contiguous block of memory can
+	/// use current() and end() to access the remaining data, and
+	/// seek the stream past the data they have consumed.
+{
+public:
+	MappedStreamBuf(const std::string& path, int options = 0);
+		/// Creates the MappedStreamBuf and maps the file with the
+		/// given path for reading. See MappedFile for the options.
+
+	~MappedStreamBuf();
+		/// Unmaps the file and destroys the MappedStreamBuf.
+
+	const char* current() const;
+		/// Returns a pointer to the next character to be read.
+
+	const char* end() const;
+		/// Returns a pointer one past the last character of the file.
+
+	MappedFile& file();
+		/// Returns the MappedFile, e.g. to pass hints about the
+		/// access pattern with MappedFile::advise().
+
+	void close();
+		/// Unmaps the file. Subsequent reads return end of file.
+
+protected:
+	pos_type seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which = std::ios::in);
+	pos_type seekpos(pos_type pos, std::ios::openmode which = std::ios::in);
+
+private:
+	MappedStreamBuf(const MappedStreamBuf&);
+	MappedStreamBuf& operator = (const MappedStreamBuf&);
+
+	MappedFile _file;
+};
+
+
+class Foundation_API MappedIOS: public virtual std::ios
+	/// The base class for MappedInputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	MappedIOS(const std::string& path, int options);
+		/// Creates the basic stream.
+
+	~MappedIOS();
+		/// Destroys the stream.
+
+	void close();
+		/// Unmaps the file.
+
+	MappedStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying streambuf.
+
+protected:
+	MappedStreamBuf _buf;
+};
+
+
+class Foundation_API MappedInputStream: public MappedIOS, public std::istream
+	/// An input stream for reading a file that is mapped into memory.
+	///
+	/// Compared to FileInputStream, a MappedInputStream saves copying
+	/// the data from the system's page cache to the stream buffer, and
+	/// seeking is cheap, as it does not discard any buffered data.
+	/// It is best suited for reading large local files.
+	///
+	/// Like a FileInputStream, the stream always operates in
+	/// binary mode.
+{
+public:
+	MappedInputStream(const std::string& path, int options = 0);
+		/// Creates a MappedInputStream for the file with the given
+		/// path. See MappedFile for the options.
+		///
+		/// Throws a FileNotFoundException (or a similar exception) if
+		/// the file does not exist or cannot be mapped.
+
+	~MappedInputStream();
+		/// Destroys the stream.
+};
+
+
+//
+// inlines
+//
+inline const char* MappedStreamBuf::current() const
+{
+	return gptr();
+}
+
+
+inline const char* MappedStreamBuf::end() const
+{
+	return egptr();
+}
+
+
+inline MappedFile& MappedStreamBuf::file()
+{
+	return _file;
+}
+
+
+inline MappedStreamBuf* MappedIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedStream_INCLUDED
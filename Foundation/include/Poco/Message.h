@@ -88,6 +88,14 @@ public:
 	
 	Message& operator = (const Message& msg);
 		/// Assignment operator.
+
+	void assign(const Message& msg);
+		/// Assigns the contents of the given Message to this one.
+		/// Unlike the assignment operator, this reuses the existing
+		/// storage of the strings of this Message where possible.
+		///
+		/// If an exception is thrown, this Message may be left
+		/// partially assigned.
 		
 	void swap(Message& msg);
 		/// Swaps the message with another one.	
@@ -77,6 +77,41 @@ inline char thousandSeparator()
 // String to Number Conversions
 //
 
+namespace Impl {
+
+	template <typename I>
+	bool strToDecimal(const char* pStr, bool negative, I& result, char thSep)
+		/// Converts the digits of a decimal number to integer, after
+		/// strToInt() has skipped whitespace and the sign.
+		/// The magnitude is accumulated as 64-bit unsigned number,
+		/// so that an overflow is detected exactly, also in the
+		/// last digit.
+	{
+		const UInt64 limit = negative ?
+			UInt64(0) - static_cast<UInt64>(std::numeric_limits<I>::min()) :
+			static_cast<UInt64>(std::numeric_limits<I>::max());
+		const bool isThSep = (thSep == '.') || (thSep == ',') || (thSep == ' ');
+		UInt64 value = 0;
+		for (; *pStr != '\0'; ++pStr)
+		{
+			unsigned digit = static_cast<unsigned char>(*pStr) - static_cast<unsigned>('0');
+			if (digit < 10)
+			{
+				if (value > (limit - digit) / 10) return false;
+				value = value * 10 + digit;
+			}
+			else if (!isThSep || *pStr != thSep) return false;
+		}
+		if (negative && value)
+			result = static_cast<I>(I(0) - static_cast<I>(value - 1) - 1);
+		else
+			result = static_cast<I>(value);
+		return true;
+	}
+
+} // namespace Impl
+
+
 template <typename I>
 bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
 	/// Converts zero-terminated character array to integer number;
@@ -88,16 +123,18 @@ bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
 	if (!pStr) return false;
 	while (isspace(*pStr)) ++pStr;
 	if (*pStr == '\0') return false;
-	short sign = 1;
+	bool negative = false;
 	if ((base == 10) && (*pStr == '-'))
 	{
 		// Unsigned types can't be negative so abort parsing
 		if (std::numeric_limits<I>::min() >= 0) return false;
-		sign = -1;
+		negative = true;
 		++pStr;
 	}
 	else if (*pStr == '+') ++pStr;
 
+	if (base == 10) return Impl::strToDecimal(pStr, negative, result, thSep);
+
 	// parser states:
 	const char STATE_SIGNIFICANT_DIGITS = 1;
 	char state = 0;
@@ -120,7 +157,7 @@ bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
 			break;
 
 		case '8': case '9':
-			if ((base == 10) || (base == 0x10))
+			if (base == 0x10)
 			{
 				if (state < STATE_SIGNIFICANT_DIGITS) state = STATE_SIGNIFICANT_DIGITS;
 				if (result > limitCheck) return false;
@@ -146,25 +183,11 @@ bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
 
 			break;
 
-		case '.':
-			if ((base == 10) && (thSep == '.')) break;
-			else return false;
-
-		case ',':
-			if ((base == 10) && (thSep == ',')) break;
-			else return false;
-
-		case ' ':
-			if ((base == 10) && (thSep == ' ')) break;
-			// fallthrough
-
 		default:
 			return false;
 		}
 	}
 
-	if ((sign < 0) && (base == 10)) result *= sign;
-
 	return true;
 }
 
@@ -253,6 +276,12 @@ namespace Impl {
 		const char* _end;
 };	
 
+	Foundation_API void decimalToStr(UInt64 magnitude, bool negative, char* result, std::size_t& size, int width, char fill);
+		/// Formats a decimal integer for intToStr() and uIntToStr(),
+		/// two digits at a time, using a table of digit pairs.
+		/// Throws a RangeException if the result, including the
+		/// terminating zero, does not fit into size characters.
+
 } // namespace Impl
 
 
@@ -279,6 +308,13 @@ bool intToStr(T value,
 		return false;
 	}
 
+	if (base == 10 && !thSep)
+	{
+		bool negative = value < 0;
+		Impl::decimalToStr(negative ? UInt64(0) - static_cast<UInt64>(value) : static_cast<UInt64>(value), negative, result, size, width, fill);
+		return true;
+	}
+
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
 	T tmpVal;
@@ -356,6 +392,12 @@ bool uIntToStr(T value,
 		*result = '\0';
 		return false;
 	}
+
+	if (base == 10 && !thSep)
+	{
+		Impl::decimalToStr(static_cast<UInt64>(value), false, result, size, width, fill);
+		return true;
+	}
 	
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
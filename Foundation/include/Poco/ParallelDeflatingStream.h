@@ -0,0 +1,166 @@
+//
+// ParallelDeflatingStream.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Definition of the ParallelDeflatingStreamBuf and ParallelDeflatingOutputStream classes.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ParallelDeflatingStream_INCLUDED
+#define Foundation_ParallelDeflatingStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/BufferedStreamBuf.h"
+#include "Poco/DeflatingStream.h"
+#include "Poco/ThreadPool.h"
+#include <ostream>
+#include <string>
+#include <deque>
+
+
+namespace Poco {
+
+
+class Foundation_API ParallelDeflatingStreamBuf: public BufferedStreamBuf
+	/// This is the streambuf class used by ParallelDeflatingOutputStream.
+	///
+	/// The data is split into blocks, which are compressed at the same
+	/// time by the threads of a ThreadPool. Like with pigz, each block is
+	/// compressed with the last 32 Kbytes of data preceding it as the
+	/// dictionary, so the compression ratio is nearly the same as the one
+	/// of DeflatingStreamBuf. The compressed blocks are written in order
+	/// as a single standard zlib or gzip stream, with the checksums of the
+	/// blocks combined into the checksum of the whole data.
+	///
+	/// If a block cannot be started in the ThreadPool, e.g. because
+	/// no thread is available, it is compressed by the thread writing
+	/// to the stream.
+	///
+	/// close() must be called to ensure proper completion of compression.
+{
+public:
+	enum
+	{
+		DEFAULT_BLOCK_SIZE = 128*1024
+	};
+
+	ParallelDeflatingStreamBuf(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, int threads = 0, std::size_t blockSize = DEFAULT_BLOCK_SIZE, ThreadPool& pool = ThreadPool::defaultPool());
+		/// Creates a ParallelDeflatingStreamBuf for compressing data passed
+		/// through and forwarding it to the given output stream.
+		///
+		/// At most threads blocks of blockSize bytes are compressed at the same
+		/// time, using the threads of the given ThreadPool. If threads is 0,
+		/// the number of processors is used.
+
+	~ParallelDeflatingStreamBuf();
+		/// Destroys the ParallelDeflatingStreamBuf.
+
+	int close();
+		/// Compresses the remaining data and writes the end of the stream.
+		///
+		/// Must be called when all data has been written.
+
+protected:
+	int writeToDevice(const char* buffer, std::streamsize length);
+	virtual int sync();
+
+private:
+	class Block;
+
+	void writeHeader();
+	void writeTrailer();
+	void compress(const char* buffer, std::size_t length, bool last);
+	void writeBlock();
+	void writeBlocks(std::size_t maxPending);
+	void wait();
+
+	std::ostream*       _pOstr;
+	DeflatingStreamBuf::StreamType _type;
+	int                 _level;
+	std::size_t         _threads;
+	ThreadPool&         _pool;
+	std::deque<Block*>  _blocks;
+	std::string         _dictionary;
+	UInt32              _checksum;
+	UInt64              _length;
+};
+
+
+class Foundation_API ParallelDeflatingIOS: public virtual std::ios
+	/// The base class for ParallelDeflatingOutputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the stream buffer and base classes.
+{
+public:
+	ParallelDeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, int threads, std::size_t blockSize, ThreadPool& pool);
+		/// Creates a ParallelDeflatingIOS for compressing data passed
+		/// through and forwarding it to the given output stream.
+
+	~ParallelDeflatingIOS();
+		/// Destroys the ParallelDeflatingIOS.
+
+	ParallelDeflatingStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying stream buffer.
+
+protected:
+	ParallelDeflatingStreamBuf _buf;
+};
+
+
+class Foundation_API ParallelDeflatingOutputStream: public std::ostream, public ParallelDeflatingIOS
+	/// This stream compresses all data passing through it like
+	/// DeflatingOutputStream, but uses several threads to do so.
+	/// See ParallelDeflatingStreamBuf for details.
+	///
+	/// After all data has been written to the stream, close()
+	/// must be called to ensure completion of compression.
+	///
+	/// Flushing the stream compresses and writes all data written
+	/// so far, which limits parallelism, so the stream should
+	/// not be flushed more often than necessary.
+	///
+	/// Example:
+	///     std::ofstream ostr("data.gz", std::ios::binary);
+	///     ParallelDeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP);
+	///     deflater << data;
+	///     deflater.close();
+	///     ostr.close();
+{
+public:
+	ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type = DeflatingStreamBuf::STREAM_ZLIB, int level = Z_DEFAULT_COMPRESSION, int threads = 0, std::size_t blockSize = ParallelDeflatingStreamBuf::DEFAULT_BLOCK_SIZE, ThreadPool& pool = ThreadPool::defaultPool());
+		/// Creates a ParallelDeflatingOutputStream for compressing data passed
+		/// through and forwarding it to the given output stream.
+		///
+		/// At most threads blocks of blockSize bytes are compressed at the same
+		/// time, using the threads of the given ThreadPool. If threads is 0,
+		/// the number of processors is used.
+
+	~ParallelDeflatingOutputStream();
+		/// Destroys the ParallelDeflatingOutputStream.
+
+	int close();
+		/// Finishes up the stream.
+		///
+		/// Must be called when all data has been written.
+
+protected:
+	virtual int sync();
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ParallelDeflatingStream_INCLUDED
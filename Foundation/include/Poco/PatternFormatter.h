@@ -23,12 +23,17 @@
 #include "Poco/Foundation.h"
 #include "Poco/Formatter.h"
 #include "Poco/Message.h"
+#include "Poco/Timestamp.h"
 #include <vector>
+#include <cstddef>
 
 
 namespace Poco {
 
 
+class DateTime;
+
+
 class Foundation_API PatternFormatter: public Formatter
 	/// This Formatter allows for custom formatting of
 	/// log messages based on format patterns.
@@ -77,6 +82,15 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// When the pattern is set, consecutive date/time specifiers (together
+	/// with the literal text between them) are combined into segments.
+	/// A segment only changes once per second, so its rendered text is
+	/// cached per thread and reused for all messages logged by the thread
+	/// within the same second. The local time offset is cached as well,
+	/// and refreshed once per minute. The cache is only available to
+	/// threads created by Poco::Thread; other threads format every
+	/// message from scratch.
 
 {
 public:
@@ -127,7 +141,7 @@ protected:
 private:
 	struct PatternAction
 	{
-		PatternAction(): key(0), length(0) 
+		PatternAction(): key(0), length(0), segment(-1)
 		{
 		}
 
@@ -135,6 +149,13 @@ private:
 		int length;
 		std::string property;
 		std::string prepend;
+		int segment;
+	};
+
+	struct Segment
+	{
+		std::size_t begin;
+		std::size_t end;
 	};
 
 	void parsePattern();
@@ -142,9 +163,20 @@ private:
 		/// which contains the message key, any text that needs to be written first
 		/// a property in case of %[] and required length.
 
+	void compilePattern();
+		/// Combines runs of PatternActions that only depend on the
+		/// message time, truncated to seconds, into Segments.
+
 	void parsePriorityNames();
 
+	void formatSegment(const Segment& segment, const Timestamp& timestamp, bool localTime, std::string& text);
+	void formatTime(const PatternAction& action, const DateTime& dateTime, bool localTime, std::string& text);
+	void formatField(const PatternAction& action, const Message& msg, const Timestamp& timestamp, std::string& text);
+
 	std::vector<PatternAction> _patternActions;
+	std::vector<Segment> _segments;
+	std::size_t _reserve;
+	int _id;
 	bool _localTime;
 	std::string _pattern;
 	std::string _priorityNames;
@@ -0,0 +1,189 @@
+//
+// PipeMultiplexer.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Processes
+// Module:  PipeMultiplexer
+//
+// Definition of the PipeMultiplexer class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_PipeMultiplexer_INCLUDED
+#define Foundation_PipeMultiplexer_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Pipe.h"
+#include "Poco/BasicEvent.h"
+#include "Poco/Buffer.h"
+#include "Poco/Timespan.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API PipeMultiplexer
+	/// A PipeMultiplexer reads the data from the read ends of
+	/// any number of pipes, usually connected to the standard
+	/// output and standard error of child processes, using a
+	/// single thread.
+	///
+	/// Every pipe is added with an ID chosen by the caller,
+	/// which is passed to the event handlers. Data is delivered
+	/// as soon as it has been read, in chunks of at most the
+	/// buffer size, so a handler that needs lines must
+	/// collect the data itself.
+	///
+	/// When the write end of a pipe has been closed by all
+	/// processes (usually because the child process has exited),
+	/// and all data has been read, the read end of the pipe is
+	/// closed, the pipe is removed, and pipeClosed is fired.
+	///
+	/// On POSIX platforms, the read ends of the pipes are made
+	/// non-blocking and polled with poll(). A pipe that is removed
+	/// with remove(), or is still open when the PipeMultiplexer is
+	/// destroyed, is switched back to its original mode, so that it
+	/// can be read with a PipeInputStream again. On Windows, anonymous
+	/// pipes cannot be waited for, so they are checked with
+	/// PeekNamedPipe() at short intervals.
+	///
+	/// Example:
+	///     Pipe outPipe;
+	///     Pipe errPipe;
+	///     ProcessHandle ph = Process::launch(command, args, 0, &outPipe, &errPipe);
+	///     PipeMultiplexer mux;
+	///     mux.dataRead += delegate(this, &MyClass::onDataRead);
+	///     mux.add(outPipe, 1);
+	///     mux.add(errPipe, 2);
+	///     mux.run();
+	///     int rc = ph.wait();
+{
+public:
+	enum
+	{
+		DEFAULT_BUFFER_SIZE = 8192
+	};
+
+	struct PipeEvent
+	{
+		PipeEvent(int i, const char* d, std::size_t n):
+			id(i),
+			data(d),
+			length(n)
+		{
+		}
+
+		int id;             /// The ID of the pipe the data has been read from.
+		const char* data;   /// The data, which is only valid during the event.
+		std::size_t length; /// The length of the data.
+	};
+
+	BasicEvent<const PipeEvent> dataRead;
+		/// Fired when data has been read from a pipe.
+
+	BasicEvent<const int> pipeClosed;
+		/// Fired with the ID of a pipe when the end of its data
+		/// has been reached and the pipe has been removed.
+
+	explicit PipeMultiplexer(std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+		/// Creates the PipeMultiplexer, which reads at most
+		/// bufferSize bytes from a pipe at once.
+
+	~PipeMultiplexer();
+		/// Destroys the PipeMultiplexer.
+
+	void add(const Pipe& pipe, int id);
+		/// Adds the read end of the given pipe, with the given ID.
+		///
+		/// The write end of the pipe should have been closed in this
+		/// process, as Process::launch() does, or the end of the data
+		/// is never reached.
+		///
+		/// Throws an ExistsException if a pipe with the given ID
+		/// has already been added.
+
+	void remove(int id);
+		/// Removes the pipe with the given ID, without closing it,
+		/// and restores the original mode of its read end.
+		/// Does nothing if there is no pipe with the given ID.
+
+	std::size_t count() const;
+		/// Returns the number of pipes that have not been closed or removed.
+
+	bool empty() const;
+		/// Returns true if there are no pipes left.
+
+	std::size_t poll(const Timespan& timeout);
+		/// Waits up to the given timeout until data can be read from
+		/// one of the pipes, or one of the pipes has been closed, and
+		/// reads the data from every pipe that is ready, firing the
+		/// events. Event handlers may add and remove pipes.
+		///
+		/// Returns the number of pipes data has been read from or
+		/// closed, which is 0 if the timeout has expired.
+		///
+		/// Throws a ReadFileException if reading from a pipe fails.
+
+	void run();
+		/// Reads the data from all pipes until all of them
+		/// have been closed or removed.
+
+private:
+	PipeMultiplexer(const PipeMultiplexer&);
+	PipeMultiplexer& operator = (const PipeMultiplexer&);
+
+	struct Entry
+	{
+		Entry(const Pipe& p, int i, int f):
+			pipe(p),
+			id(i),
+			flags(f)
+		{
+		}
+
+		Pipe pipe;
+		int id;
+		int flags; /// The original file status flags of the read end (POSIX only).
+	};
+
+	typedef std::vector<Entry> EntryVec;
+
+	std::size_t pollImpl(long timeout);
+	bool read(int id);
+	EntryVec::iterator find(int id);
+	static void restore(const Entry& entry);
+
+	EntryVec _pipes;
+	Buffer<char> _buffer;
+};
+
+
+//
+// inlines
+//
+inline std::size_t PipeMultiplexer::count() const
+{
+	return _pipes.size();
+}
+
+
+inline bool PipeMultiplexer::empty() const
+{
+	return _pipes.empty();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_PipeMultiplexer_INCLUDED
@@ -147,6 +147,18 @@ public:
 	typedef typename Delegates::iterator Iterator;
 
 public:
+	PriorityStrategy()
+	{
+	}
+
+	PriorityStrategy(const PriorityStrategy& s):
+		_delegates(s._delegates)
+	{
+	}
+
+	~PriorityStrategy()
+	{
+	}
 
 	void notify(const void* sender)
 	{
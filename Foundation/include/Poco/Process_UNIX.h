@@ -78,6 +78,19 @@ public:
 	static void requestTerminationImpl(PIDImpl pid);
 
 private:
+	static ProcessHandleImpl* launchBySpawnImpl(
+		const std::string& command, 
+		const ArgsImpl& args, 
+		const std::string& initialDirectory,
+		Pipe* inPipe, 
+		Pipe* outPipe, 
+		Pipe* errPipe,
+		const EnvImpl& env);
+		/// Launches the process with posix_spawn(), which does not copy
+		/// the page tables of the parent process like fork() does.
+		/// Returns null if posix_spawn() is not available with the
+		/// file actions required to launch the process.
+
 	static ProcessHandleImpl* launchByForkExecImpl(
 		const std::string& command, 
 		const ArgsImpl& args, 
@@ -24,6 +24,7 @@
 
 
 #include "Poco/Foundation.h"
+#include "Poco/SharedPtr.h"
 #include <vector>
 #include <map>
 
@@ -50,6 +51,16 @@ class Foundation_API RegularExpression
 	/// Implemented using PCRE, the Perl Compatible
 	/// Regular Expressions library by Philip Hazel
 	/// (see http://www.pcre.org).
+	///
+	/// If PCRE has been built with JIT support, studied
+	/// patterns are compiled to machine code by the PCRE JIT
+	/// compiler. Each thread created by Poco::Thread then uses
+	/// its own JIT stack for matching.
+	///
+	/// Compiling a pattern is expensive compared to matching.
+	/// Patterns that are used again and again, but that are not
+	/// known in advance, can be obtained from a process-wide cache
+	/// of compiled patterns with cached().
 {
 public:
 	enum Options // These must match the corresponding options in pcre.h!
@@ -98,6 +109,7 @@ public:
 	};
 	typedef std::vector<Match> MatchVec;
 	typedef std::map<int, std::string> GroupMap;
+	typedef SharedPtr<RegularExpression> Ptr;
 	
 	RegularExpression(const std::string& pattern, int options = 0, bool study = true);
 		/// Creates a regular expression and parses the given pattern.
@@ -134,6 +146,20 @@ public:
 		/// Throws a RegularExpressionException in case of an error.
 		/// Returns the number of matches.
 
+	int matchAll(const std::string& subject, std::string::size_type offset, MatchVec& matches, int options = 0) const;
+		/// Finds all non-overlapping matches of the pattern in the given subject
+		/// string, starting at offset, and stores the position of the captured
+		/// substring of each match in matches. Subpatterns and group names are
+		/// not stored.
+		///
+		/// matches is cleared, but keeps its capacity, so that no memory is
+		/// allocated if the same MatchVec is used again for a similar subject.
+		///
+		/// As in Perl, after an empty match a non-empty match at the same
+		/// position is tried before the search continues at the next character.
+		/// Throws a RegularExpressionException in case of an error.
+		/// Returns the number of matches.
+
 	bool match(const std::string& subject, std::string::size_type offset = 0) const;
 		/// Returns true if and only if the subject matches the regular expression.
 		///
@@ -209,6 +235,21 @@ public:
 	static bool match(const std::string& subject, const std::string& pattern, int options = 0);
 		/// Matches the given subject string against the regular expression given in pattern,
 		/// using the given options.
+		///
+		/// The compiled pattern is taken from the cache of compiled patterns.
+
+	static Ptr cached(const std::string& pattern, int options = 0);
+		/// Returns the studied RegularExpression for the given pattern and
+		/// constructor options from the process-wide cache of compiled patterns.
+		/// If the pattern is not in the cache, it is compiled and added to it.
+		/// Only the most recently used patterns are kept in the cache.
+		///
+		/// The returned RegularExpression may be shared with other threads,
+		/// which is safe because all matching functions are const.
+		/// Throws a RegularExpressionException if the pattern cannot be compiled.
+
+	static void clearCache();
+		/// Removes all compiled patterns from the cache.
 
 protected:
 	std::string::size_type substOne(std::string& subject, std::string::size_type offset, const std::string& replacement, int options) const;
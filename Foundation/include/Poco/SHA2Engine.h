@@ -0,0 +1,169 @@
+//
+// SHA2Engine.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Crypt
+// Module:  SHA2Engine
+//
+// Definition of class SHA2Engine.
+//
+// Secure Hash Standard SHA-2 algorithms
+// (FIPS 180-4, see http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf)
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SHA2Engine_INCLUDED
+#define Foundation_SHA2Engine_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/DigestEngine.h"
+
+
+namespace Poco {
+
+
+class Foundation_API SHA2Engine: public DigestEngine
+	/// This class implements the SHA-2 message digest algorithms
+	/// SHA-224, SHA-256, SHA-384 and SHA-512.
+	/// (FIPS 180-4, see http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf)
+	///
+	/// On x86 CPUs supporting the SHA extensions, SHA-224 and
+	/// SHA-256 are computed with these instructions.
+	///
+	/// For use with HMACEngine, which needs the block and digest
+	/// sizes at compile time, use one of the SHA224Engine, SHA256Engine,
+	/// SHA384Engine or SHA512Engine subclasses.
+{
+public:
+	enum ALGORITHM
+	{
+		SHA_224 = 224,
+		SHA_256 = 256,
+		SHA_384 = 384,
+		SHA_512 = 512
+	};
+
+	SHA2Engine(ALGORITHM algorithm = SHA_256);
+		/// Creates the SHA2Engine for the given algorithm.
+
+	~SHA2Engine();
+		/// Destroys the SHA2Engine.
+
+	ALGORITHM algorithm() const;
+		/// Returns the algorithm.
+
+	std::size_t blockLength() const;
+		/// Returns the block length of the algorithm in bytes,
+		/// which is 64 for SHA-224 and SHA-256, and 128 for
+		/// SHA-384 and SHA-512.
+
+	std::size_t digestLength() const;
+	void reset();
+	const DigestEngine::Digest& digest();
+
+protected:
+	void updateImpl(const void* data, std::size_t length);
+
+private:
+	void transform(const UInt8* data, std::size_t blocks);
+
+	ALGORITHM _algorithm;
+	UInt32 _state32[8];
+	UInt64 _state64[8];
+	UInt64 _count;
+	UInt8  _buffer[128];
+	std::size_t _bufferLength;
+	DigestEngine::Digest _digest;
+
+	SHA2Engine(const SHA2Engine&);
+	SHA2Engine& operator = (const SHA2Engine&);
+};
+
+
+class Foundation_API SHA224Engine: public SHA2Engine
+	/// This class implements the SHA-224 message digest algorithm.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 64,
+		DIGEST_SIZE = 28
+	};
+
+	SHA224Engine();
+	~SHA224Engine();
+};
+
+
+class Foundation_API SHA256Engine: public SHA2Engine
+	/// This class implements the SHA-256 message digest algorithm.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 64,
+		DIGEST_SIZE = 32
+	};
+
+	SHA256Engine();
+	~SHA256Engine();
+};
+
+
+class Foundation_API SHA384Engine: public SHA2Engine
+	/// This class implements the SHA-384 message digest algorithm.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 128,
+		DIGEST_SIZE = 48
+	};
+
+	SHA384Engine();
+	~SHA384Engine();
+};
+
+
+class Foundation_API SHA512Engine: public SHA2Engine
+	/// This class implements the SHA-512 message digest algorithm.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 128,
+		DIGEST_SIZE = 64
+	};
+
+	SHA512Engine();
+	~SHA512Engine();
+};
+
+
+//
+// inlines
+//
+inline SHA2Engine::ALGORITHM SHA2Engine::algorithm() const
+{
+	return _algorithm;
+}
+
+
+inline std::size_t SHA2Engine::blockLength() const
+{
+	return _algorithm > SHA_256 ? 128 : 64;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SHA2Engine_INCLUDED
@@ -0,0 +1,492 @@
+//
+// ShardedLRUCache.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ShardedLRUCache
+//
+// Definition of the ShardedLRUCache class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ShardedLRUCache_INCLUDED
+#define Foundation_ShardedLRUCache_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
+#include "Poco/Hash.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+#include <map>
+#include <set>
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = Hash<TKey>,
+	class TMutex = FastMutex
+>
+class ShardedLRUCache
+	/// A ShardedLRUCache is a cache for concurrent use by many threads.
+	///
+	/// The cache is divided into a number of shards, each holding
+	/// a part of the entries and protected by its own mutex. The shard
+	/// of an entry is determined by the hash of its key, which is
+	/// computed with THash. Threads accessing different shards do not
+	/// contend for a lock.
+	///
+	/// Within a shard, the least recently used entries are approximated
+	/// with the CLOCK algorithm: a read only sets the referenced flag
+	/// of an entry, so reading does not need to reorder a list. When
+	/// a shard is full, the clock hand evicts the first entry that has
+	/// not been referenced since the hand last passed it, clearing the
+	/// referenced flags of the entries it passes.
+	///
+	/// Optionally, entries expire after a given time (in milliseconds)
+	/// after they have been added or updated. Expired entries are never
+	/// returned by get(); they are removed when found by get(), evicted
+	/// first by the clock hand, and removed in a batch from all shards
+	/// by purgeExpired().
+	///
+	/// As with the LRUCache, values are stored as SharedPtr<TValue>,
+	/// and get() returns a SharedPtr that remains valid after the entry
+	/// has been removed from the cache.
+	///
+	/// Unlike the AbstractCache family, ShardedLRUCache has no events,
+	/// and the capacity of the cache is shared equally by the shards,
+	/// so that an entry may be evicted before the whole cache is full.
+	///
+	/// TKey must be usable as a key of std::map, and hashable with THash.
+{
+public:
+	struct Statistics
+		/// Cache statistics, as returned by statistics().
+	{
+		Statistics():
+			hits(0),
+			misses(0),
+			evictions(0),
+			expirations(0)
+		{
+		}
+
+		UInt64 hits;        /// Number of get() calls that found a valid entry.
+		UInt64 misses;      /// Number of get() calls that found no valid entry.
+		UInt64 evictions;   /// Number of entries evicted to make room for new entries.
+		UInt64 expirations; /// Number of expired entries removed.
+	};
+
+	enum
+	{
+		DEFAULT_SHARDS = 16
+	};
+
+	ShardedLRUCache(std::size_t capacity = 1024, Timestamp::TimeDiff expire = 0, std::size_t shards = DEFAULT_SHARDS):
+		_expire(expire*1000),
+		_shardMask(0)
+		/// Creates the ShardedLRUCache for up to capacity entries.
+		///
+		/// If expire is greater than zero, entries expire after
+		/// the given number of milliseconds.
+		///
+		/// The number of shards is rounded up to a power of two.
+		/// It is reduced if the capacity would leave less than one
+		/// entry per shard.
+	{
+		if (capacity < 1) throw InvalidArgumentException("Cache capacity must be at least 1");
+		if (expire < 0) throw InvalidArgumentException("Expire time must not be negative");
+
+		std::size_t n = 1;
+		while (n < shards && n < capacity) n *= 2;
+		if (n > capacity) n /= 2;
+		_shardMask = n - 1;
+		std::size_t shardCapacity = (capacity + n - 1)/n;
+		_shards.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			_shards.push_back(new Shard(shardCapacity));
+		}
+	}
+
+	~ShardedLRUCache()
+		/// Destroys the ShardedLRUCache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			delete *it;
+		}
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If the key already exists, the entry is replaced.
+	{
+		add(key, SharedPtr<TValue>(new TValue(val)));
+	}
+
+	void add(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If the key already exists, the entry is replaced.
+	{
+		if (val.isNull()) throw NullPointerException("Cannot add a NULL value to the cache");
+
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		shard.put(key, val, expiration());
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If the key already exists, the value is replaced.
+		///
+		/// As the ShardedLRUCache has no events, update() and add() are equivalent.
+	{
+		add(key, val);
+	}
+
+	void update(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache.
+		/// If the key already exists, the value is replaced.
+		///
+		/// As the ShardedLRUCache has no events, update() and add() are equivalent.
+	{
+		add(key, val);
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Shard::Index::iterator it = shard.index.find(key);
+		if (it != shard.index.end()) shard.erase(it);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a valid entry for the key.
+		/// Does not count as a use of the entry.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Shard::Index::const_iterator it = shard.index.find(key);
+		return it != shard.index.end() && !isExpired(shard.entries[it->second], now());
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for a key no value exists, an empty SharedPtr is returned.
+	{
+		Shard& shard = shardFor(key);
+		typename TMutex::ScopedLock lock(shard.mutex);
+		typename Shard::Index::iterator it = shard.index.find(key);
+		if (it != shard.index.end())
+		{
+			Entry& entry = shard.entries[it->second];
+			if (!isExpired(entry, now()))
+			{
+				entry.referenced = true;
+				++shard.statistics.hits;
+				return entry.value;
+			}
+			shard.erase(it);
+			++shard.statistics.expirations;
+		}
+		++shard.statistics.misses;
+		return shard.none;
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			shard.clear();
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of valid entries in the cache.
+		/// Removes all expired entries.
+	{
+		purgeExpired();
+		std::size_t result = 0;
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			result += shard.index.size();
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Removes all expired entries.
+	{
+		purgeExpired();
+	}
+
+	std::size_t purgeExpired()
+		/// Removes all expired entries from all shards, and
+		/// returns the number of entries removed. Does
+		/// nothing if entries do not expire.
+		///
+		/// Each shard is locked once, while its entries are
+		/// checked, so calling this periodically removes expired
+		/// entries in batches.
+	{
+		if (_expire == 0) return 0;
+
+		std::size_t count = 0;
+		Timestamp::TimeVal current = now();
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			for (std::size_t i = 0; i < shard.entries.size(); ++i)
+			{
+				Entry& entry = shard.entries[i];
+				if (entry.used && isExpired(entry, current))
+				{
+					shard.erase(shard.index.find(entry.key));
+					++shard.statistics.expirations;
+					++count;
+				}
+			}
+		}
+		return count;
+	}
+
+	std::set<TKey> getAllKeys()
+		/// Returns a copy of all keys of valid entries.
+	{
+		std::set<TKey> result;
+		Timestamp::TimeVal current = now();
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			for (typename Shard::Index::const_iterator itIdx = shard.index.begin(); itIdx != shard.index.end(); ++itIdx)
+			{
+				if (!isExpired(shard.entries[itIdx->second], current)) result.insert(itIdx->first);
+			}
+		}
+		return result;
+	}
+
+	Statistics statistics() const
+		/// Returns the hit, miss, eviction and expiration counts,
+		/// summed over all shards.
+	{
+		Statistics result;
+		for (typename ShardVec::const_iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			result.hits        += shard.statistics.hits;
+			result.misses      += shard.statistics.misses;
+			result.evictions   += shard.statistics.evictions;
+			result.expirations += shard.statistics.expirations;
+		}
+		return result;
+	}
+
+	void resetStatistics()
+		/// Resets all statistics counters to zero.
+	{
+		for (typename ShardVec::iterator it = _shards.begin(); it != _shards.end(); ++it)
+		{
+			Shard& shard = **it;
+			typename TMutex::ScopedLock lock(shard.mutex);
+			shard.statistics = Statistics();
+		}
+	}
+
+	std::size_t shards() const
+		/// Returns the number of shards.
+	{
+		return _shards.size();
+	}
+
+private:
+	ShardedLRUCache(const ShardedLRUCache&);
+	ShardedLRUCache& operator = (const ShardedLRUCache&);
+
+	struct Entry
+	{
+		Entry():
+			expires(0),
+			referenced(false),
+			used(false)
+		{
+		}
+
+		TKey               key;
+		SharedPtr<TValue>  value;
+		Timestamp::TimeVal expires;
+		bool               referenced;
+		bool               used;
+	};
+
+	struct Shard
+	{
+		typedef std::map<TKey, std::size_t> Index;
+
+		Shard(std::size_t cap):
+			capacity(cap),
+			hand(0)
+		{
+			entries.reserve(capacity);
+		}
+
+		void put(const TKey& key, const SharedPtr<TValue>& value, Timestamp::TimeVal expires)
+		{
+			typename Index::iterator it = index.find(key);
+			if (it != index.end())
+			{
+				Entry& entry = entries[it->second];
+				entry.value      = value;
+				entry.expires    = expires;
+				entry.referenced = true;
+				return;
+			}
+
+			std::size_t slot;
+			if (!free.empty())
+			{
+				slot = free.back();
+				free.pop_back();
+			}
+			else if (entries.size() < capacity)
+			{
+				slot = entries.size();
+				entries.push_back(Entry());
+			}
+			else
+			{
+				slot = evict();
+			}
+			index.insert(typename Index::value_type(key, slot));
+			Entry& entry = entries[slot];
+			entry.key        = key;
+			entry.value      = value;
+			entry.expires    = expires;
+			entry.referenced = false;
+			entry.used       = true;
+		}
+
+		std::size_t evict()
+			/// Advances the clock hand to the next entry that has
+			/// either expired or not been referenced, removes it
+			/// and returns its slot.
+		{
+			Timestamp::TimeVal current = Timestamp().epochMicroseconds();
+			for (;;)
+			{
+				Entry& entry = entries[hand];
+				std::size_t slot = hand;
+				hand = (hand + 1) % entries.size();
+				if (entry.expires != 0 && entry.expires <= current)
+				{
+					++statistics.expirations;
+				}
+				else if (entry.referenced)
+				{
+					entry.referenced = false;
+					continue;
+				}
+				else
+				{
+					++statistics.evictions;
+				}
+				index.erase(entry.key);
+				entry.value = none;
+				entry.used  = false;
+				return slot;
+			}
+		}
+
+		void erase(typename Index::iterator it)
+		{
+			Entry& entry = entries[it->second];
+			entry.value      = none;
+			entry.used       = false;
+			entry.referenced = false;
+			free.push_back(it->second);
+			index.erase(it);
+		}
+
+		void clear()
+		{
+			index.clear();
+			entries.clear();
+			free.clear();
+			hand = 0;
+		}
+
+		mutable TMutex           mutex;
+		Index                    index;
+		std::vector<Entry>       entries;
+		std::vector<std::size_t> free;
+		std::size_t              capacity;
+		std::size_t              hand;
+		Statistics               statistics;
+		SharedPtr<TValue>        none; // shared by all empty entries, as a default constructed SharedPtr allocates a counter
+	};
+
+	typedef std::vector<Shard*> ShardVec;
+
+	Shard& shardFor(const TKey& key) const
+	{
+		// The hash is mixed, so that hash functions with weak
+		// low-order bits still spread the keys over all shards.
+		UInt32 h = static_cast<UInt32>(THash()(key));
+		h ^= h >> 16;
+		h *= 0x45d9f3bU;
+		h ^= h >> 16;
+		return *_shards[h & _shardMask];
+	}
+
+	Timestamp::TimeVal now() const
+	{
+		return _expire ? Timestamp().epochMicroseconds() : 0;
+	}
+
+	Timestamp::TimeVal expiration() const
+	{
+		return _expire ? Timestamp().epochMicroseconds() + _expire : 0;
+	}
+
+	static bool isExpired(const Entry& entry, Timestamp::TimeVal current)
+	{
+		return entry.expires != 0 && entry.expires <= current;
+	}
+
+	Timestamp::TimeDiff _expire;
+	std::size_t         _shardMask;
+	ShardVec            _shards;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ShardedLRUCache_INCLUDED
@@ -30,6 +30,7 @@ namespace Poco {
 
 
 class LogFile;
+class Timer;
 
 
 class Foundation_API SimpleFileChannel: public Channel
@@ -78,6 +79,16 @@ class Foundation_API SimpleFileChannel: public Channel
 	///   * true:   Every message is immediately flushed to the log file (default).
 	///   * false:  Messages are not immediately flushed to the log file.
 	///
+	/// Messages are collected in a buffer, which is written to the
+	/// log file with a single system call when it is full, or,
+	/// if flush is true, after every message. The bufferSize property
+	/// specifies the capacity of the buffer in bytes (default 8192).
+	///
+	/// The flushInterval property specifies an interval in milliseconds
+	/// at which a background thread writes the buffer to the log file.
+	/// If 0 (the default), no background thread is used. The interval
+	/// takes effect when the channel is opened.
+	///
 {
 public:
 	SimpleFileChannel();
@@ -94,6 +105,12 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Logs the given messages to the file, acquiring the
+		/// channel's lock only once. If flush is true, the
+		/// messages are written with a single system call,
+		/// unless rotation intervenes.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -106,6 +123,9 @@ public:
 		///   * flush:         Specifies whether messages are immediately
 		///                    flushed to the log file. See the SimpleFileChannel
 		///                    class for details.
+		///   * bufferSize:    The capacity in bytes of the write buffer.
+		///   * flushInterval: The interval in milliseconds at which
+		///                    buffered messages are written to the file.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -128,20 +148,30 @@ public:
 	static const std::string PROP_SECONDARYPATH;
 	static const std::string PROP_ROTATION;
 	static const std::string PROP_FLUSH;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
 
 protected:
 	~SimpleFileChannel();
 	void setRotation(const std::string& rotation);
 	void setFlush(const std::string& flush);
+	void setBufferSize(const std::string& size);
+	void setFlushInterval(const std::string& interval);
 	void rotate();
 
 private:
+	void onFlush(Timer& timer);
+	void stopFlushTimer();
+
 	std::string      _path;
 	std::string      _secondaryPath;
 	std::string      _rotation;
 	UInt64           _limit;
 	bool             _flush;
+	std::size_t      _bufferSize;
+	long             _flushInterval;
 	LogFile*         _pFile;
+	Timer*           _pFlushTimer;
 	FastMutex        _mutex;
 };
 
@@ -0,0 +1,150 @@
+//
+// SizeClassAllocator.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  SizeClassPool
+//
+// Definition of the SizeClassAllocator and SizeClassBufferAllocator class templates.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SizeClassAllocator_INCLUDED
+#define Foundation_SizeClassAllocator_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/SizeClassPool.h"
+#include <ios>
+#include <new>
+#include <limits>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class T>
+class SizeClassAllocator
+	/// A standard library compatible allocator that obtains
+	/// its memory from SizeClassPool::defaultPool().
+	///
+	/// Best suited for node-based containers (std::list, std::map, etc.)
+	/// that allocate many small objects of the same size.
+{
+public:
+	typedef T              value_type;
+	typedef T*             pointer;
+	typedef const T*       const_pointer;
+	typedef T&             reference;
+	typedef const T&       const_reference;
+	typedef std::size_t    size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef SizeClassAllocator<U> other;
+	};
+
+	SizeClassAllocator()
+	{
+	}
+
+	SizeClassAllocator(const SizeClassAllocator&)
+	{
+	}
+
+	template <class U>
+	SizeClassAllocator(const SizeClassAllocator<U>&)
+	{
+	}
+
+	~SizeClassAllocator()
+	{
+	}
+
+	pointer address(reference value) const
+	{
+		return &value;
+	}
+
+	const_pointer address(const_reference value) const
+	{
+		return &value;
+	}
+
+	pointer allocate(size_type n, const void* = 0)
+	{
+		if (n > max_size()) throw std::bad_alloc();
+		return static_cast<pointer>(SizeClassPool::defaultPool().allocate(n*sizeof(T)));
+	}
+
+	void deallocate(pointer p, size_type n)
+	{
+		SizeClassPool::defaultPool().deallocate(p, n*sizeof(T));
+	}
+
+	size_type max_size() const
+	{
+		return std::numeric_limits<size_type>::max()/sizeof(T);
+	}
+
+	void construct(pointer p, const T& value)
+	{
+		new (static_cast<void*>(p)) T(value);
+	}
+
+	void destroy(pointer p)
+	{
+		p->~T();
+	}
+};
+
+
+template <class T, class U>
+inline bool operator == (const SizeClassAllocator<T>&, const SizeClassAllocator<U>&)
+{
+	return true;
+}
+
+
+template <class T, class U>
+inline bool operator != (const SizeClassAllocator<T>&, const SizeClassAllocator<U>&)
+{
+	return false;
+}
+
+
+template <typename ch>
+class SizeClassBufferAllocator
+	/// A BufferAllocator for BasicBufferedStreamBuf and
+	/// BasicBufferedBidirectionalStreamBuf that obtains stream
+	/// buffers from SizeClassPool::defaultPool().
+{
+public:
+	typedef ch char_type;
+
+	static char_type* allocate(std::streamsize size)
+	{
+		return static_cast<char_type*>(SizeClassPool::defaultPool().allocate(static_cast<std::size_t>(size)*sizeof(char_type)));
+	}
+
+	static void deallocate(char_type* ptr, std::streamsize size) throw()
+	{
+		SizeClassPool::defaultPool().deallocate(ptr, static_cast<std::size_t>(size)*sizeof(char_type));
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SizeClassAllocator_INCLUDED
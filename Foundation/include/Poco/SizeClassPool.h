@@ -0,0 +1,202 @@
+//
+// SizeClassPool.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  SizeClassPool
+//
+// Definition of the SizeClassPool class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SizeClassPool_INCLUDED
+#define Foundation_SizeClassPool_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Mutex.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API SizeClassPool
+	/// A thread-caching memory pool for blocks of varying size.
+	///
+	/// Requested sizes are rounded up to one of a number of
+	/// size classes (powers of two from MIN_BLOCK_SIZE up to
+	/// MAX_BLOCK_SIZE). Free blocks of each size class are kept
+	/// in magazines - small fixed-capacity stacks of blocks.
+	/// Every thread using the pool, whether created with
+	/// Poco::Thread or not, keeps two magazines per size class
+	/// in thread-specific storage, so that most allocations and
+	/// deallocations are served without any locking. Only when
+	/// both magazines of a thread are empty (or full) a whole
+	/// magazine is exchanged with the global depot of the size
+	/// class, so the depot's mutex is taken once per batch of
+	/// blocks, not once per block. When a thread exits, its
+	/// magazines are returned to the depot.
+	///
+	/// Memory for blocks is obtained from the system in chunks
+	/// holding one magazine's worth of blocks. The pool does not
+	/// return memory to the system by itself; call trim() to
+	/// release chunks none of whose blocks are in use.
+	/// Requests larger than MAX_BLOCK_SIZE are passed on to
+	/// operator new.
+	///
+	/// A SizeClassPool must outlive all blocks allocated from it,
+	/// as well as all threads that have used it. The pool returned
+	/// by defaultPool() is never destroyed.
+	///
+	/// On Windows versions before Vista (_WIN32_WINNT < 0x0600),
+	/// the magazines of exiting threads are not returned to the
+	/// depot, as there is no thread-specific storage with cleanup.
+{
+public:
+	enum
+	{
+		MIN_BLOCK_SIZE = 16,
+		MAX_BLOCK_SIZE = 65536,
+		SIZE_CLASSES   = 13,
+		MAGAZINE_SIZE  = 64,
+		CHUNK_SIZE     = 65536
+	};
+
+	SizeClassPool();
+		/// Creates the SizeClassPool.
+
+	~SizeClassPool();
+		/// Destroys the SizeClassPool and releases all memory
+		/// obtained from the system.
+
+	void* allocate(std::size_t size);
+		/// Returns a block of at least the given size.
+		/// The block is suitably aligned for any fundamental type.
+
+	void deallocate(void* ptr, std::size_t size);
+		/// Returns a block to the pool. The given size must be
+		/// the size that has been passed to allocate().
+		/// Does nothing if ptr is null.
+
+	void flush();
+		/// Returns all blocks cached by the calling thread
+		/// to the depot, making them available to other threads.
+
+	void trim();
+		/// Returns all chunks to the system whose blocks are all
+		/// in the depot. Blocks cached by threads (including the
+		/// calling thread, unless flush() has been called) count
+		/// as being in use.
+
+	int allocated() const;
+		/// Returns the number of blocks (of all size classes)
+		/// that have been obtained from the system.
+
+	static std::size_t blockSize(std::size_t size);
+		/// Returns the actual size of a block returned
+		/// by allocate(size).
+
+	static SizeClassPool& defaultPool();
+		/// Returns a reference to the default SizeClassPool,
+		/// which is used by SizeClassAllocator and
+		/// SizeClassBufferAllocator.
+
+private:
+	SizeClassPool(const SizeClassPool&);
+	SizeClassPool& operator = (const SizeClassPool&);
+
+	struct Magazine
+	{
+		int   count;
+		void* rounds[MAGAZINE_SIZE];
+	};
+
+	struct Depot
+	{
+		FastMutex              mutex;
+		std::vector<Magazine*> full;
+		std::vector<Magazine*> empty;
+		std::vector<char*>     chunks;
+	};
+
+	struct ThreadCache
+	{
+		ThreadCache();
+		~ThreadCache();
+
+		SizeClassPool* pPool;
+		Magazine*      loaded[SIZE_CLASSES];
+		Magazine*      previous[SIZE_CLASSES];
+	};
+
+	static int sizeClass(std::size_t size);
+	static int capacity(int sizeClass);
+
+	void* allocate(ThreadCache& cache, int sizeClass);
+	void deallocate(ThreadCache& cache, int sizeClass, void* ptr);
+	Magazine* exchangeEmpty(int sizeClass, Magazine* pEmpty);
+	Magazine* exchangeFull(int sizeClass, Magazine* pFull);
+	void flush(ThreadCache& cache);
+	void trim(int sizeClass);
+	ThreadCache& threadCache();
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	static void __stdcall destroyThreadCache(void* pCache);
+#else
+	static void destroyThreadCache(void* pCache);
+#endif
+		/// Called when a thread that has used the pool exits.
+
+	Depot         _depots[SIZE_CLASSES];
+	UIntPtr       _cacheKey;
+	AtomicCounter _allocated;
+
+	friend struct ThreadCache;
+};
+
+
+//
+// inlines
+//
+inline int SizeClassPool::sizeClass(std::size_t size)
+{
+	int cls = 0;
+	std::size_t blockSize = MIN_BLOCK_SIZE;
+	while (blockSize < size)
+	{
+		blockSize <<= 1;
+		++cls;
+	}
+	return cls;
+}
+
+
+inline int SizeClassPool::capacity(int sizeClass)
+{
+	int n = static_cast<int>(CHUNK_SIZE/(static_cast<std::size_t>(MIN_BLOCK_SIZE) << sizeClass));
+	if (n < 4) n = 4;
+	else if (n > MAGAZINE_SIZE) n = MAGAZINE_SIZE;
+	return n;
+}
+
+
+inline int SizeClassPool::allocated() const
+{
+	return _allocated.value();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SizeClassPool_INCLUDED
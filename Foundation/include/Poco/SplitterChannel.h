@@ -47,6 +47,14 @@ public:
 		/// Sends the given Message to all
 		/// attaches channels. 
 
+	void logBatch(const Message* pMessages, std::size_t count);
+		/// Sends the given messages to all
+		/// attached channels.
+
+	void logRecord(const LogRecord& record);
+		/// Sends the given LogRecord to all
+		/// attached channels.
+
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets or changes a configuration property.
 		///
@@ -32,6 +32,11 @@ namespace Poco {
 class Foundation_API StreamCopier
 	/// This class provides static methods to copy the contents from one stream
 	/// into another.
+	///
+	/// On Linux, copyStream() and copyStream64() copy data from a
+	/// FileInputStream reading a regular file to a FileOutputStream
+	/// with copy_file_range() or sendfile(), without copying the
+	/// data through a buffer in user space.
 {
 public:
 	static std::streamsize copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize = 8192);
@@ -0,0 +1,150 @@
+//
+// StringSplitter.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringSplitter
+//
+// Definition of the StringSplitter class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringSplitter_INCLUDED
+#define Foundation_StringSplitter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/StringView.h"
+
+
+namespace Poco {
+
+
+class Foundation_API StringSplitter
+	/// StringSplitter splits a string into tokens like
+	/// StringTokenizer, but it does so lazily, one token per
+	/// call to next(), and without copying or allocating memory.
+	/// Each token is returned as a StringView into the original
+	/// string, which must remain valid and unchanged while the
+	/// StringSplitter and the tokens are in use.
+	///
+	/// Tokens can be separated by a single character, by any of
+	/// a set of characters, or by a separator string.
+	///
+	/// Example:
+	///     StringSplitter splitter(str, ',', StringSplitter::TOK_TRIM);
+	///     StringView token;
+	///     while (splitter.next(token))
+	///     {
+	///         ...
+	///     }
+	///
+	/// The resulting tokens are the same as the ones of a
+	/// StringTokenizer with the same string and options.
+{
+public:
+	enum Options
+	{
+		TOK_IGNORE_EMPTY = 1, /// ignore empty tokens
+		TOK_TRIM         = 2, /// remove leading and trailing whitespace from tokens
+		TOK_QUOTES       = 4, /// separators enclosed in double quotes or preceded by a backslash do not separate tokens
+		TOK_STRING       = 8  /// the separators form a single separator string, not a set of separator characters
+	};
+
+	StringSplitter(const StringView& str, char separator, int options = 0);
+		/// Creates a StringSplitter for tokens separated by the
+		/// given separator character.
+		///
+		/// The TOK_STRING option is ignored.
+
+	StringSplitter(const StringView& str, const StringView& separators, int options = 0);
+		/// Creates a StringSplitter for tokens separated by any of the
+		/// characters in separators or, if the TOK_STRING option is
+		/// given, by the string separators.
+		///
+		/// The separators are not copied and must remain valid while
+		/// the StringSplitter is in use.
+
+	~StringSplitter();
+		/// Destroys the StringSplitter.
+
+	bool next(StringView& token);
+		/// Stores the next token in token and returns true, or
+		/// returns false if there are no more tokens.
+
+	StringView rest() const;
+		/// Returns the part of the string that has not yet been split.
+
+private:
+	StringSplitter();
+	StringSplitter(const StringSplitter&);
+	StringSplitter& operator = (const StringSplitter&);
+
+	enum Mode
+	{
+		MODE_CHAR,
+		MODE_SET,
+		MODE_STRING
+	};
+
+	const char* findSeparator(const char* it, const char*& next) const;
+	const char* findQuoted(const char* it, const char*& next) const;
+	bool isSeparatorAt(const char* it, const char*& next) const;
+	void addSeparator(char c);
+	bool isSeparator(char c) const;
+	void initStops();
+	bool isStop(char c) const;
+
+	const char* _it;
+	const char* _end;
+	StringView  _separators;
+	char        _separator;
+	Mode        _mode;
+	int         _options;
+	bool        _done;
+	UInt32      _set[8];
+	UInt32      _stops[8];
+};
+
+
+//
+// inlines
+//
+inline StringView StringSplitter::rest() const
+{
+	return _done ? StringView(_end, 0) : StringView(_it, _end - _it);
+}
+
+
+inline void StringSplitter::addSeparator(char c)
+{
+	unsigned char uc = static_cast<unsigned char>(c);
+	_set[uc >> 5] |= 1u << (uc & 31);
+}
+
+
+inline bool StringSplitter::isSeparator(char c) const
+{
+	unsigned char uc = static_cast<unsigned char>(c);
+	return (_set[uc >> 5] & (1u << (uc & 31))) != 0;
+}
+
+
+inline bool StringSplitter::isStop(char c) const
+{
+	unsigned char uc = static_cast<unsigned char>(c);
+	return (_stops[uc >> 5] & (1u << (uc & 31))) != 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringSplitter_INCLUDED
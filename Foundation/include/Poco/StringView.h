@@ -0,0 +1,265 @@
+//
+// StringView.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringView
+//
+// Definition of the StringView class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringView_INCLUDED
+#define Foundation_StringView_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Ascii.h"
+#include <string>
+#include <cstring>
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API StringView
+	/// A StringView refers to a sequence of characters owned
+	/// by someone else, usually a part of a std::string, without
+	/// copying it.
+	///
+	/// The referenced characters must remain valid and unchanged
+	/// for as long as the StringView is used.
+{
+public:
+	typedef const char* ConstIterator;
+	typedef std::size_t SizeType;
+
+	static const SizeType NPOS = static_cast<SizeType>(-1);
+
+	StringView();
+		/// Creates an empty StringView.
+
+	StringView(const char* str);
+		/// Creates a StringView for the given zero-terminated string.
+
+	StringView(const char* data, SizeType length);
+		/// Creates a StringView for length characters starting at data.
+
+	StringView(const std::string& str);
+		/// Creates a StringView for the contents of the given string.
+
+	const char* data() const;
+		/// Returns a pointer to the first character.
+		/// The characters are not zero-terminated.
+
+	SizeType size() const;
+		/// Returns the number of characters.
+
+	SizeType length() const;
+		/// Returns the number of characters.
+
+	bool empty() const;
+		/// Returns true if the StringView is empty.
+
+	ConstIterator begin() const;
+		/// Returns an iterator to the first character.
+
+	ConstIterator end() const;
+		/// Returns an iterator past the last character.
+
+	char operator [] (SizeType index) const;
+		/// Returns the character at the given index, which
+		/// is not checked.
+
+	StringView substr(SizeType pos, SizeType length = NPOS) const;
+		/// Returns the part of the StringView starting at pos.
+		/// pos must not be greater than size().
+
+	SizeType find(char c, SizeType pos = 0) const;
+		/// Returns the position of the first occurrence of c at
+		/// or after pos, or NPOS if there is none.
+
+	SizeType find(const StringView& str, SizeType pos = 0) const;
+		/// Returns the position of the first occurrence of str at
+		/// or after pos, or NPOS if there is none.
+
+	StringView trimmed() const;
+		/// Returns the StringView without leading and trailing
+		/// whitespace.
+
+	int compare(const StringView& str) const;
+		/// Compares the characters with those of str, like
+		/// std::string::compare().
+
+	int icompare(const StringView& str) const;
+		/// Compares the characters with those of str, ignoring
+		/// the case of ASCII letters.
+
+	std::string toString() const;
+		/// Returns a copy of the characters.
+
+	void assignTo(std::string& str) const;
+		/// Assigns the characters to str, reusing its storage.
+
+	void appendTo(std::string& str) const;
+		/// Appends the characters to str.
+
+private:
+	const char* _data;
+	SizeType    _size;
+};
+
+
+//
+// inlines
+//
+inline StringView::StringView():
+	_data(""),
+	_size(0)
+{
+}
+
+
+inline StringView::StringView(const char* str):
+	_data(str),
+	_size(std::strlen(str))
+{
+}
+
+
+inline StringView::StringView(const char* data, SizeType length):
+	_data(data),
+	_size(length)
+{
+}
+
+
+inline StringView::StringView(const std::string& str):
+	_data(str.data()),
+	_size(str.size())
+{
+}
+
+
+inline const char* StringView::data() const
+{
+	return _data;
+}
+
+
+inline StringView::SizeType StringView::size() const
+{
+	return _size;
+}
+
+
+inline StringView::SizeType StringView::length() const
+{
+	return _size;
+}
+
+
+inline bool StringView::empty() const
+{
+	return _size == 0;
+}
+
+
+inline StringView::ConstIterator StringView::begin() const
+{
+	return _data;
+}
+
+
+inline StringView::ConstIterator StringView::end() const
+{
+	return _data + _size;
+}
+
+
+inline char StringView::operator [] (SizeType index) const
+{
+	return _data[index];
+}
+
+
+inline StringView StringView::substr(SizeType pos, SizeType length) const
+{
+	poco_assert_dbg (pos <= _size);
+	if (length > _size - pos) length = _size - pos;
+	return StringView(_data + pos, length);
+}
+
+
+inline StringView::SizeType StringView::find(char c, SizeType pos) const
+{
+	if (pos >= _size) return NPOS;
+	const void* p = std::memchr(_data + pos, c, _size - pos);
+	return p ? static_cast<const char*>(p) - _data : NPOS;
+}
+
+
+inline StringView StringView::trimmed() const
+{
+	const char* b = _data;
+	const char* e = _data + _size;
+	while (b != e && Ascii::isSpace(*b)) ++b;
+	while (e != b && Ascii::isSpace(e[-1])) --e;
+	return StringView(b, e - b);
+}
+
+
+inline std::string StringView::toString() const
+{
+	return std::string(_data, _size);
+}
+
+
+inline void StringView::assignTo(std::string& str) const
+{
+	str.assign(_data, _size);
+}
+
+
+inline void StringView::appendTo(std::string& str) const
+{
+	str.append(_data, _size);
+}
+
+
+inline bool operator == (const StringView& s1, const StringView& s2)
+{
+	return s1.size() == s2.size() && std::memcmp(s1.data(), s2.data(), s1.size()) == 0;
+}
+
+
+inline bool operator != (const StringView& s1, const StringView& s2)
+{
+	return !(s1 == s2);
+}
+
+
+inline bool operator < (const StringView& s1, const StringView& s2)
+{
+	return s1.compare(s2) < 0;
+}
+
+
+inline std::ostream& operator << (std::ostream& ostr, const StringView& str)
+{
+	return ostr.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringView_INCLUDED
@@ -106,6 +106,10 @@ public:
 	TextBufferIterator end() const;
 		/// Returns the end iterator for the range handled
 		/// by the iterator.
+
+	const char* position() const;
+		/// Returns a pointer to the first byte of the
+		/// current character.
 		
 private:
 	const TextEncoding* _pEncoding;
@@ -141,6 +145,12 @@ inline TextBufferIterator TextBufferIterator::end() const
 }
 
 
+inline const char* TextBufferIterator::position() const
+{
+	return _it;
+}
+
+
 } // namespace Poco
 
 
@@ -0,0 +1,281 @@
+//
+// URIView.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIView
+//
+// Definition of the URIView class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_URIView_INCLUDED
+#define Foundation_URIView_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/StringView.h"
+#include <string>
+
+
+namespace Poco {
+
+
+class Foundation_API URIView
+	/// URIView splits a URI into its parts like URI, but without
+	/// copying or decoding anything. Each part is returned as a
+	/// StringView into the original string, which must remain valid
+	/// and unchanged while the URIView and the parts are in use.
+	///
+	/// The parts are returned exactly as they appear in the URI,
+	/// still percent-encoded, and the scheme and host are not converted
+	/// to lower case. The decoding functions can be used to decode
+	/// only the parts that are actually needed, either into a
+	/// std::string or into a buffer supplied by the caller,
+	/// which may also be the part itself.
+	///
+	/// The parameters of a query string can be iterated over with
+	/// a QueryParameterIterator.
+	///
+	/// Example:
+	///     URIView uri(request.getURI());
+	///     URIView::QueryParameterIterator it(uri.getRawQuery());
+	///     std::string name;
+	///     std::string value;
+	///     while (it.next(name, value))
+	///     {
+	///         ...
+	///     }
+{
+public:
+	class Foundation_API QueryParameterIterator
+		/// Iterates over the name-value pairs of a percent-encoded
+		/// query string, like URI::getQueryParameters(), without
+		/// building a vector of pairs.
+	{
+	public:
+		QueryParameterIterator(const StringView& query);
+			/// Creates a QueryParameterIterator for the given raw query string.
+
+		bool next(StringView& name, StringView& value);
+			/// Stores the still encoded name and value of the next parameter
+			/// and returns true, or returns false if there are no more parameters.
+
+		bool next(std::string& name, std::string& value);
+			/// Stores the decoded name and value of the next parameter, with plus
+			/// signs decoded as spaces, and returns true, or returns false if there
+			/// are no more parameters. name and value keep their capacity,
+			/// so that reusing them avoids allocating memory.
+
+	private:
+		const char* _it;
+		const char* _end;
+	};
+
+	URIView();
+		/// Creates an empty URIView.
+
+	URIView(const StringView& uri);
+		/// Parses the given URI.
+		///
+		/// Throws a URISyntaxException if the URI is not valid.
+
+	~URIView();
+		/// Destroys the URIView.
+
+	void parse(const StringView& uri);
+		/// Parses the given URI, replacing the current one.
+		///
+		/// Throws a URISyntaxException if the URI is not valid.
+
+	void clear();
+		/// Clears all parts of the URIView.
+
+	const StringView& getScheme() const;
+		/// Returns the scheme part of the URI, which is not
+		/// converted to lower case.
+
+	const StringView& getRawUserInfo() const;
+		/// Returns the user-info part of the URI.
+
+	const StringView& getRawHost() const;
+		/// Returns the host part of the URI, without the
+		/// brackets around an IPv6 address.
+
+	unsigned short getPort() const;
+		/// Returns the port number part of the URI.
+		///
+		/// If no port number has been specified,
+		/// the well-known port number for the scheme
+		/// is returned, or 0 if there is none.
+
+	bool hasExplicitPort() const;
+		/// Returns true if the URI contains a port number.
+
+	StringView getAuthority() const;
+		/// Returns the authority part (userInfo, host and port)
+		/// of the URI, without the leading "//".
+
+	const StringView& getRawPath() const;
+		/// Returns the percent-encoded path part of the URI.
+
+	const StringView& getRawQuery() const;
+		/// Returns the percent-encoded query part of the URI.
+
+	const StringView& getRawFragment() const;
+		/// Returns the percent-encoded fragment part of the URI.
+
+	StringView getPathEtc() const;
+		/// Returns the percent-encoded path, query and fragment parts of the URI.
+
+	StringView getPathAndQuery() const;
+		/// Returns the percent-encoded path and query parts of the URI.
+
+	std::string getPath() const;
+		/// Returns the decoded path part of the URI.
+
+	std::string getQuery() const;
+		/// Returns the decoded query part of the URI.
+
+	std::string getFragment() const;
+		/// Returns the decoded fragment part of the URI.
+
+	bool isRelative() const;
+		/// Returns true if the URI is relative, i.e. has no scheme.
+
+	bool empty() const;
+		/// Returns true if the URI is empty.
+
+	static unsigned short getWellKnownPort(const StringView& scheme);
+		/// Returns the well-known port number for the given scheme,
+		/// which is compared case-insensitively, or 0 if the port
+		/// number is not known.
+
+	static std::size_t decode(const StringView& str, char* buffer, bool plusAsSpace = false);
+		/// Decodes the percent-encoded str into buffer, which must have
+		/// room for at least str.size() characters, and returns the length
+		/// of the decoded string. Since the decoded string is never longer
+		/// than the encoded one, buffer may be str.data(), which decodes
+		/// str in place.
+		///
+		/// If plusAsSpace is true, all non-encoded plus signs are decoded
+		/// as spaces, as is done for query parameters.
+		///
+		/// Throws a URISyntaxException if str is not properly encoded.
+
+	static void decode(const StringView& str, std::string& decodedStr, bool plusAsSpace = false);
+		/// Decodes the percent-encoded str and appends the result
+		/// to decodedStr.
+		///
+		/// If plusAsSpace is true, all non-encoded plus signs are decoded
+		/// as spaces, as is done for query parameters.
+		///
+		/// Throws a URISyntaxException if str is not properly encoded.
+
+	static void encode(const StringView& str, const StringView& reserved, std::string& encodedStr);
+		/// Percent-encodes the characters in str that are reserved, not
+		/// allowed in a URI or not ASCII, and appends the result to encodedStr.
+		/// The result is the same as the one of URI::encode().
+
+	static void appendQueryParameter(std::string& query, const StringView& name, const StringView& value);
+		/// Appends the percent-encoded name and value to the query string,
+		/// in the same way as URI::addQueryParameter().
+
+private:
+	void parseAuthority(const char* it, const char* end);
+	void parsePathEtc(const char* it, const char* end);
+
+	StringView     _uri;
+	StringView     _scheme;
+	StringView     _userInfo;
+	StringView     _host;
+	StringView     _path;
+	StringView     _query;
+	StringView     _fragment;
+	const char*    _authorityBegin;
+	const char*    _authorityEnd;
+	unsigned short _port;
+	bool           _hasPort;
+};
+
+
+//
+// inlines
+//
+inline const StringView& URIView::getScheme() const
+{
+	return _scheme;
+}
+
+
+inline const StringView& URIView::getRawUserInfo() const
+{
+	return _userInfo;
+}
+
+
+inline const StringView& URIView::getRawHost() const
+{
+	return _host;
+}
+
+
+inline unsigned short URIView::getPort() const
+{
+	return _hasPort ? _port : getWellKnownPort(_scheme);
+}
+
+
+inline bool URIView::hasExplicitPort() const
+{
+	return _hasPort;
+}
+
+
+inline StringView URIView::getAuthority() const
+{
+	return StringView(_authorityBegin, _authorityEnd - _authorityBegin);
+}
+
+
+inline const StringView& URIView::getRawPath() const
+{
+	return _path;
+}
+
+
+inline const StringView& URIView::getRawQuery() const
+{
+	return _query;
+}
+
+
+inline const StringView& URIView::getRawFragment() const
+{
+	return _fragment;
+}
+
+
+inline bool URIView::isRelative() const
+{
+	return _scheme.empty();
+}
+
+
+inline bool URIView::empty() const
+{
+	return _uri.empty();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_URIView_INCLUDED
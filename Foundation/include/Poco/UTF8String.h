@@ -38,6 +38,11 @@ struct Foundation_API UTF8
 	///
 	/// removeBOM() removes the UTF-8 Byte Order Mark sequence (0xEF, 0xBB, 0xBF)
 	/// from the beginning of the given string, if it's there.
+	///
+	/// validate(), isValid() and the conversion functions between UTF-8 and
+	/// UTF-16 or Latin-1 work on whole buffers at once, with a fast path
+	/// for runs of ASCII characters. They are used by TextConverter and
+	/// UnicodeConverter for these encodings.
 {
 	static int icompare(const std::string& str, std::string::size_type pos, std::string::size_type n, std::string::const_iterator it2, std::string::const_iterator end2);
 	static int icompare(const std::string& str1, const std::string& str2);
@@ -72,6 +77,40 @@ struct Foundation_API UTF8
 
 	static std::string unescape(const std::string::const_iterator& begin, const std::string::const_iterator& end);
 		/// Creates an UTF8 string from a string that contains escaped characters.
+
+	static std::size_t validate(const char* bytes, std::size_t length);
+		/// Returns the length of the longest prefix of bytes that consists
+		/// of complete and well-formed UTF-8 sequences. The bytes are valid
+		/// UTF-8 if the result is equal to length.
+
+	static bool isValid(const std::string& str);
+		/// Returns true if str is valid UTF-8.
+
+	static std::size_t toUTF16(const char* bytes, std::size_t length, UInt16* utf16, std::size_t& utf16Length);
+		/// Converts the longest well-formed prefix of the UTF-8 encoded bytes
+		/// to UTF-16 code units in native byte order, which are stored in utf16.
+		/// utf16 must have room for length code units.
+		/// Stores the number of code units in utf16Length and
+		/// returns the number of bytes converted.
+
+	static std::size_t fromUTF16(const UInt16* utf16, std::size_t length, char* bytes, std::size_t& bytesLength);
+		/// Converts the UTF-16 code units in native byte order to UTF-8,
+		/// stopping at the first surrogate that is not part of a
+		/// surrogate pair. bytes must have room for 3*length bytes.
+		/// Stores the number of bytes in bytesLength and returns
+		/// the number of code units converted.
+
+	static std::size_t toLatin1(const char* bytes, std::size_t length, char* latin1, std::size_t& latin1Length);
+		/// Converts the longest prefix of the UTF-8 encoded bytes that
+		/// consists of well-formed sequences of characters up to U+00FF
+		/// to ISO 8859-1, stored in latin1, which must have room for length
+		/// characters. Stores the number of characters in latin1Length and
+		/// returns the number of bytes converted.
+
+	static std::size_t fromLatin1(const char* latin1, std::size_t length, char* bytes);
+		/// Converts the ISO 8859-1 characters to UTF-8, stored in bytes,
+		/// which must have room for 2*length bytes.
+		/// Returns the number of bytes stored.
 };
 
 
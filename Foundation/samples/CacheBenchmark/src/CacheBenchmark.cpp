@@ -0,0 +1,128 @@
+//
+// CacheBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares the throughput of an LRUCache and
+// a ShardedLRUCache shared by multiple threads, for a
+// read-mostly workload with a skewed key distribution.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/LRUCache.h"
+#include "Poco/ShardedLRUCache.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+const int ITERATIONS = 200000;
+const int KEYS       = 10000;
+const int CAPACITY   = 2048;
+
+
+template <class C>
+class Worker: public Poco::Runnable
+{
+public:
+	Worker(C& cache, Poco::UInt32 seed):
+		_cache(cache),
+		_hits(0)
+	{
+		_random.seed(seed);
+	}
+
+	void run()
+	{
+		for (int i = 0; i < ITERATIONS; ++i)
+		{
+			// Squaring a uniform number skews the distribution
+			// towards small keys, which makes them "hot".
+			Poco::UInt32 r = _random.next(1000);
+			int key = static_cast<int>(r*r % KEYS);
+			if (i % 10 == 0)
+			{
+				_cache.add(key, i);
+			}
+			else if (!_cache.get(key).isNull())
+			{
+				++_hits;
+			}
+		}
+	}
+
+	int hits() const
+	{
+		return _hits;
+	}
+
+private:
+	C& _cache;
+	Poco::Random _random;
+	int _hits;
+};
+
+
+template <class C>
+void benchmark(C& cache, int threads, const std::string& label)
+{
+	std::vector<Worker<C>*> workers;
+	std::vector<Thread*> pool;
+	for (int i = 0; i < threads; ++i)
+	{
+		workers.push_back(new Worker<C>(cache, i + 1));
+		pool.push_back(new Thread);
+	}
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i) pool[i]->start(*workers[i]);
+	for (int i = 0; i < threads; ++i) pool[i]->join();
+	sw.stop();
+
+	int hits = 0;
+	for (int i = 0; i < threads; ++i)
+	{
+		hits += workers[i]->hits();
+		delete pool[i];
+		delete workers[i];
+	}
+
+	double ops = 1.0*ITERATIONS*threads;
+	std::cout << std::setw(16) << label << std::setw(4) << threads << " threads: "
+	          << std::setw(10) << sw.elapsed()/1000 << " [ms] "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*sw.elapsed()/ops << " [ns/op] "
+	          << std::setw(6) << std::setprecision(1) << 100.0*hits/(0.9*ops) << " [% hits]" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 32;
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		Poco::LRUCache<int, int> lru(CAPACITY);
+		benchmark(lru, threads, "LRUCache");
+
+		Poco::ShardedLRUCache<int, int> sharded(CAPACITY);
+		benchmark(sharded, threads, "ShardedLRUCache");
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,225 @@
+//
+// CodecBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures the throughput of the Base64, Base32
+// and hexBinary codecs, comparing the static buffer functions,
+// the streams used with write() and read(), and the streams
+// used one character at a time with put() and get().
+//
+// Usage: CodecBenchmark [<size in KB>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base64Encoder.h"
+#include "Poco/Base64Decoder.h"
+#include "Poco/Base32Encoder.h"
+#include "Poco/Base32Decoder.h"
+#include "Poco/HexBinaryEncoder.h"
+#include "Poco/HexBinaryDecoder.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+
+using Poco::Stopwatch;
+
+
+struct Base64Codec
+{
+	typedef Poco::Base64Encoder Encoder;
+	typedef Poco::Base64Decoder Decoder;
+
+	static const char* name() { return "Base64"; }
+	static void setup(Encoder& encoder) { encoder.rdbuf()->setLineLength(0); }
+	static std::size_t encodedLength(std::size_t length) { return Encoder::encodedLength(length); }
+	static std::size_t encode(const char* data, std::size_t length, char* buffer) { return Encoder::encode(data, length, buffer); }
+	static std::size_t decodedLength(std::size_t length) { return Decoder::decodedLength(length); }
+	static std::size_t decode(const char* data, std::size_t length, char* buffer) { return Decoder::decode(data, length, buffer); }
+};
+
+
+struct Base64LinesCodec: public Base64Codec
+	/// MIME style, with a line break after 72 characters.
+{
+	static const char* name() { return "Base64 (lines)"; }
+	static void setup(Encoder& encoder) { encoder.rdbuf()->setLineLength(72); }
+};
+
+
+struct Base32Codec
+{
+	typedef Poco::Base32Encoder Encoder;
+	typedef Poco::Base32Decoder Decoder;
+
+	static const char* name() { return "Base32"; }
+	static void setup(Encoder&) { }
+	static std::size_t encodedLength(std::size_t length) { return Encoder::encodedLength(length); }
+	static std::size_t encode(const char* data, std::size_t length, char* buffer) { return Encoder::encode(data, length, buffer); }
+	static std::size_t decodedLength(std::size_t length) { return Decoder::decodedLength(length); }
+	static std::size_t decode(const char* data, std::size_t length, char* buffer) { return Decoder::decode(data, length, buffer); }
+};
+
+
+struct HexBinaryCodec
+{
+	typedef Poco::HexBinaryEncoder Encoder;
+	typedef Poco::HexBinaryDecoder Decoder;
+
+	static const char* name() { return "HexBinary"; }
+	static void setup(Encoder& encoder) { encoder.rdbuf()->setLineLength(0); }
+	static std::size_t encodedLength(std::size_t length) { return Encoder::encodedLength(length); }
+	static std::size_t encode(const char* data, std::size_t length, char* buffer) { return Encoder::encode(data, length, buffer); }
+	static std::size_t decodedLength(std::size_t length) { return Decoder::decodedLength(length); }
+	static std::size_t decode(const char* data, std::size_t length, char* buffer) { return Decoder::decode(data, length, buffer); }
+};
+
+
+void print(const char* name, const char* mode, const char* op, Poco::Timestamp::TimeDiff elapsed, std::size_t bytes)
+	/// Prints the throughput in MB of binary data per second.
+{
+	std::cout << std::setw(16) << name << std::setw(10) << mode << std::setw(8) << op << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << (elapsed > 0 ? double(bytes)/elapsed : 0.0) << " [MB/s]" << std::endl;
+}
+
+
+template <class Codec>
+void benchmarkBuffer(const std::string& data)
+{
+	std::vector<char> encoded(Codec::encodedLength(data.size()));
+	Stopwatch sw;
+	sw.start();
+	std::size_t n = Codec::encode(data.data(), data.size(), &encoded[0]);
+	sw.stop();
+	print(Codec::name(), "buffer", "encode", sw.elapsed(), data.size());
+
+	std::vector<char> decoded(Codec::decodedLength(n));
+	sw.restart();
+	std::size_t m = Codec::decode(&encoded[0], n, &decoded[0]);
+	sw.stop();
+	print(Codec::name(), "buffer", "decode", sw.elapsed(), data.size());
+	if (std::string(&decoded[0], m) != data) std::cout << "round-trip failed" << std::endl;
+}
+
+
+template <class Codec>
+void benchmarkStream(const std::string& data)
+{
+	const std::streamsize blockSize = 65536;
+
+	std::ostringstream ostr;
+	Stopwatch sw;
+	sw.start();
+	{
+		typename Codec::Encoder encoder(ostr);
+		Codec::setup(encoder);
+		for (std::size_t pos = 0; pos < data.size(); pos += blockSize)
+		{
+			encoder.write(data.data() + pos, std::min<std::streamsize>(blockSize, data.size() - pos));
+		}
+		encoder.close();
+	}
+	sw.stop();
+	print(Codec::name(), "stream", "encode", sw.elapsed(), data.size());
+
+	std::istringstream istr(ostr.str());
+	std::string result;
+	result.reserve(data.size());
+	std::vector<char> buffer(blockSize);
+	sw.restart();
+	{
+		typename Codec::Decoder decoder(istr);
+		while (decoder.read(&buffer[0], blockSize) || decoder.gcount() > 0)
+		{
+			result.append(&buffer[0], static_cast<std::size_t>(decoder.gcount()));
+		}
+	}
+	sw.stop();
+	print(Codec::name(), "stream", "decode", sw.elapsed(), data.size());
+	if (result != data) std::cout << "round-trip failed" << std::endl;
+}
+
+
+template <class Codec>
+void benchmarkChars(const std::string& data)
+{
+	std::ostringstream ostr;
+	Stopwatch sw;
+	sw.start();
+	{
+		typename Codec::Encoder encoder(ostr);
+		Codec::setup(encoder);
+		for (std::size_t i = 0; i < data.size(); ++i)
+		{
+			encoder.put(data[i]);
+		}
+		encoder.close();
+	}
+	sw.stop();
+	print(Codec::name(), "char", "encode", sw.elapsed(), data.size());
+
+	std::istringstream istr(ostr.str());
+	std::string result;
+	result.reserve(data.size());
+	sw.restart();
+	{
+		typename Codec::Decoder decoder(istr);
+		int c = decoder.get();
+		while (c != -1)
+		{
+			result += static_cast<char>(c);
+			c = decoder.get();
+		}
+	}
+	sw.stop();
+	print(Codec::name(), "char", "decode", sw.elapsed(), data.size());
+	if (result != data) std::cout << "round-trip failed" << std::endl;
+}
+
+
+template <class Codec>
+void benchmark(const std::string& data)
+{
+	benchmarkBuffer<Codec>(data);
+	benchmarkStream<Codec>(data);
+	benchmarkChars<Codec>(data);
+	std::cout << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t size = 1024*(argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 16384);
+
+	std::cout << "SSSE3: " << (Poco::CPUFeatures::hasSSSE3() ? "yes" : "no") << std::endl << std::endl;
+
+	Poco::Random rnd;
+	std::string data;
+	data.reserve(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		data += static_cast<char>(rnd.next(256));
+	}
+
+	benchmark<Base64Codec>(data);
+	benchmark<Base64LinesCodec>(data);
+	benchmark<Base32Codec>(data);
+	benchmark<HexBinaryCodec>(data);
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+//
+// DateTimeBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures formatting and parsing of dates and times
+// with DateTimeFormatter, DateTimeParser and DateTimePattern, for
+// the standard formats used by HTTP servers and JSON documents, and
+// for a custom log file format.
+//
+// Usage: DateTimeBenchmark [<count>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeParser.h"
+#include "Poco/DateTimePattern.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/DateTime.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::DateTimeFormatter;
+using Poco::DateTimeParser;
+using Poco::DateTimePattern;
+using Poco::DateTimeFormat;
+using Poco::DateTime;
+using Poco::Timestamp;
+using Poco::Stopwatch;
+
+
+const std::string LOG_FORMAT("[%d/%b/%Y:%H:%M:%S %Z]");
+
+
+void print(const char* name, const char* op, Timestamp::TimeDiff elapsed, std::size_t ops)
+{
+	std::cout << std::setw(28) << name << std::setw(8) << op << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*elapsed/ops << " [ns/op]" << std::endl;
+}
+
+
+void formatTimestamps(const char* name, const std::vector<Timestamp>& timestamps, const std::string& fmt)
+{
+	std::string str;
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < timestamps.size(); ++i)
+	{
+		str.clear();
+		DateTimeFormatter::append(str, timestamps[i], fmt);
+	}
+	sw.stop();
+	print(name, "format", sw.elapsed(), timestamps.size());
+}
+
+
+void formatTimestamps(const char* name, const std::vector<Timestamp>& timestamps, const DateTimePattern& pattern)
+{
+	std::string str;
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < timestamps.size(); ++i)
+	{
+		str.clear();
+		pattern.append(str, timestamps[i]);
+	}
+	sw.stop();
+	print(name, "format", sw.elapsed(), timestamps.size());
+}
+
+
+void parseStrings(const char* name, const std::vector<std::string>& strings, const std::string& fmt)
+{
+	DateTime dt;
+	int tzd;
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < strings.size(); ++i)
+	{
+		DateTimeParser::parse(fmt, strings[i], dt, tzd);
+	}
+	sw.stop();
+	print(name, "parse", sw.elapsed(), strings.size());
+}
+
+
+void parseStrings(const char* name, const std::vector<std::string>& strings, const DateTimePattern& pattern)
+{
+	DateTime dt;
+	int tzd;
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < strings.size(); ++i)
+	{
+		pattern.parse(strings[i], dt, tzd);
+	}
+	sw.stop();
+	print(name, "parse", sw.elapsed(), strings.size());
+}
+
+
+void benchmark(const char* name, const std::vector<Timestamp>& timestamps, const std::string& fmt)
+{
+	formatTimestamps(name, timestamps, fmt);
+
+	std::vector<std::string> strings;
+	for (std::size_t i = 0; i < timestamps.size(); ++i)
+	{
+		strings.push_back(DateTimeFormatter::format(timestamps[i], fmt));
+	}
+	parseStrings(name, strings, fmt);
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t count = argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 1000000;
+
+	// Random dates between 1970 and 2038, and the current time
+	// advancing by 10 microseconds per entry, as seen by a busy
+	// HTTP server or logger.
+	Poco::Random rnd;
+	std::vector<Timestamp> randomTimestamps;
+	std::vector<Timestamp> currentTimestamps;
+	Timestamp now;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		randomTimestamps.push_back(Timestamp::fromEpochTime(rnd.next() & 0x7FFFFFFF) + rnd.next(1000000));
+		currentTimestamps.push_back(now + Timestamp::TimeDiff(10*i));
+	}
+
+	std::cout << "Random dates" << std::endl;
+	benchmark("ISO8601", randomTimestamps, DateTimeFormat::ISO8601_FORMAT);
+	benchmark("ISO8601_FRAC", randomTimestamps, DateTimeFormat::ISO8601_FRAC_FORMAT);
+	benchmark("HTTP", randomTimestamps, DateTimeFormat::HTTP_FORMAT);
+	benchmark("RFC1123", randomTimestamps, DateTimeFormat::RFC1123_FORMAT);
+	benchmark("SORTABLE", randomTimestamps, DateTimeFormat::SORTABLE_FORMAT);
+	benchmark("log format", randomTimestamps, LOG_FORMAT);
+
+	DateTimePattern logPattern(LOG_FORMAT);
+	formatTimestamps("log format pattern", randomTimestamps, logPattern);
+	std::vector<std::string> strings;
+	for (std::size_t i = 0; i < randomTimestamps.size(); ++i)
+	{
+		strings.push_back(logPattern.format(randomTimestamps[i]));
+	}
+	parseStrings("log format pattern", strings, logPattern);
+	std::cout << std::endl;
+
+	std::cout << "Current time" << std::endl;
+	formatTimestamps("HTTP", currentTimestamps, DateTimeFormat::HTTP_FORMAT);
+	formatTimestamps("log format", currentTimestamps, LOG_FORMAT);
+	formatTimestamps("log format pattern", currentTimestamps, logPattern);
+
+	return 0;
+}
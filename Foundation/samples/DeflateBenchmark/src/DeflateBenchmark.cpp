@@ -0,0 +1,134 @@
+//
+// DeflateBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures the throughput of gzip compression with
+// DeflatingOutputStream and with ParallelDeflatingOutputStream
+// using an increasing number of threads.
+//
+// Usage: DeflateBenchmark [<megabytes> [<level> [<max_threads> [<input_file>]]]]
+//
+// Without an input file, generated text is compressed. The number
+// of threads is doubled up to max_threads, which defaults to the
+// number of processors.
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DeflatingStream.h"
+#include "Poco/ParallelDeflatingStream.h"
+#include "Poco/InflatingStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Environment.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+
+using Poco::DeflatingOutputStream;
+using Poco::DeflatingStreamBuf;
+using Poco::ParallelDeflatingOutputStream;
+using Poco::InflatingInputStream;
+using Poco::InflatingStreamBuf;
+using Poco::StreamCopier;
+using Poco::ThreadPool;
+using Poco::Stopwatch;
+
+
+void print(const std::string& name, Poco::Timestamp::TimeDiff elapsed, std::size_t size, std::size_t compressedSize)
+{
+	double mbps = elapsed > 0 ? double(size)/elapsed : 0;
+	std::cout << std::setw(24) << std::left << name << std::right << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << mbps << " MB/s, "
+	          << std::setw(5) << std::setprecision(1) << 100.0*compressedSize/size << " %" << std::endl;
+}
+
+
+std::string generate(std::size_t size)
+{
+	std::string data;
+	data.reserve(size + 100);
+	unsigned n = 1;
+	while (data.size() < size)
+	{
+		n = n*1103515245 + 12345;
+		data += "2016-01-01 12:00:00.";
+		data += Poco::NumberFormatter::format0((n >> 8) % 1000, 3);
+		data += " request ";
+		data += Poco::NumberFormatter::format((n >> 4) % 100000);
+		data += (n & 0x100) ? " GET /index.html 200\n" : " POST /api/v1/orders 201\n";
+	}
+	data.resize(size);
+	return data;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t megabytes = argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 64;
+	int level = argc > 2 ? Poco::NumberParser::parse(argv[2]) : Z_DEFAULT_COMPRESSION;
+	int maxThreads = argc > 3 ? Poco::NumberParser::parse(argv[3]) : static_cast<int>(Poco::Environment::processorCount());
+
+	std::string data;
+	if (argc > 4)
+	{
+		std::ifstream istr(argv[4], std::ios::binary);
+		if (!istr)
+		{
+			std::cerr << "cannot open input file: " << argv[4] << std::endl;
+			return 1;
+		}
+		StreamCopier::copyToString(istr, data);
+	}
+	else data = generate(megabytes*1024*1024);
+
+	Stopwatch sw;
+	std::ostringstream ostr;
+
+	sw.start();
+	DeflatingOutputStream deflater(ostr, DeflatingStreamBuf::STREAM_GZIP, level);
+	deflater.write(data.data(), data.size());
+	deflater.close();
+	sw.stop();
+	print("DeflatingOutputStream", sw.elapsed(), data.size(), ostr.str().size());
+
+	ThreadPool pool(1, maxThreads);
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		std::ostringstream postr;
+		sw.restart();
+		ParallelDeflatingOutputStream parallelDeflater(postr, DeflatingStreamBuf::STREAM_GZIP, level, threads, 128*1024, pool);
+		parallelDeflater.write(data.data(), data.size());
+		parallelDeflater.close();
+		sw.stop();
+		print("Parallel, " + Poco::NumberFormatter::format(threads) + " thread(s)", sw.elapsed(), data.size(), postr.str().size());
+
+		if (threads*2 > maxThreads)
+		{
+			// check the result once
+			std::istringstream istr(postr.str());
+			InflatingInputStream inflater(istr, InflatingStreamBuf::STREAM_GZIP);
+			std::string result;
+			StreamCopier::copyToString(inflater, result);
+			if (result != data || inflater.bad())
+			{
+				std::cerr << "decompressed data does not match" << std::endl;
+				return 2;
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,181 @@
+//
+// DigestBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures the throughput of the checksum and
+// message digest algorithms for messages from 64 bytes up
+// to 1 GB. Messages larger than 1 MB are passed to update()
+// in chunks of 1 MB.
+//
+// Usage: DigestBenchmark [<max size in MB>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Checksum.h"
+#include "Poco/MD5Engine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/SHA2Engine.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Stopwatch;
+using Poco::UInt64;
+
+
+const std::size_t CHUNK_SIZE = 1024*1024;
+const UInt64 MIN_TOTAL = 64*1024*1024;
+
+
+class Algorithm
+	/// Adapts checksums and digest engines to a common interface.
+{
+public:
+	virtual ~Algorithm()
+	{
+	}
+
+	virtual const char* name() const = 0;
+	virtual void update(const char* data, std::size_t length) = 0;
+	virtual void finish() = 0;
+};
+
+
+class ChecksumAlgorithm: public Algorithm
+{
+public:
+	ChecksumAlgorithm(const char* name, Poco::Checksum::Type type):
+		_name(name),
+		_type(type),
+		_checksum(type),
+		_result(0)
+	{
+	}
+
+	const char* name() const
+	{
+		return _name;
+	}
+
+	void update(const char* data, std::size_t length)
+	{
+		_checksum.update(data, static_cast<unsigned>(length));
+	}
+
+	void finish()
+	{
+		_result += _checksum.checksum();
+		_checksum = Poco::Checksum(_type);
+	}
+
+private:
+	const char* _name;
+	Poco::Checksum::Type _type;
+	Poco::Checksum _checksum;
+	Poco::UInt32 _result;
+};
+
+
+template <class Engine>
+class DigestAlgorithm: public Algorithm
+{
+public:
+	DigestAlgorithm(const char* name):
+		_name(name)
+	{
+	}
+
+	const char* name() const
+	{
+		return _name;
+	}
+
+	void update(const char* data, std::size_t length)
+	{
+		_engine.update(data, length);
+	}
+
+	void finish()
+	{
+		_engine.digest();
+	}
+
+private:
+	const char* _name;
+	Engine _engine;
+};
+
+
+void benchmark(Algorithm& algorithm, const std::vector<char>& data, UInt64 size)
+	/// Hashes messages of the given size, repeating as often as
+	/// necessary to process at least MIN_TOTAL bytes, and prints
+	/// the throughput in MB per second.
+{
+	UInt64 total = 0;
+	Stopwatch sw;
+	sw.start();
+	do
+	{
+		for (UInt64 pos = 0; pos < size; pos += CHUNK_SIZE)
+		{
+			algorithm.update(&data[0], static_cast<std::size_t>(size - pos < CHUNK_SIZE ? size - pos : CHUNK_SIZE));
+		}
+		algorithm.finish();
+		total += size;
+	}
+	while (total < MIN_TOTAL);
+	sw.stop();
+
+	std::cout << std::setw(10) << algorithm.name() << std::setw(12) << size << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << (sw.elapsed() > 0 ? double(total)/sw.elapsed() : 0.0) << " [MB/s]" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	UInt64 maxSize = 1024*1024*(argc > 1 ? Poco::NumberParser::parseUnsigned64(argv[1]) : 1024);
+
+	std::cout << "SSE4.2: " << (Poco::CPUFeatures::hasSSE42() ? "yes" : "no")
+	          << ", PCLMUL: " << (Poco::CPUFeatures::hasPCLMUL() ? "yes" : "no")
+	          << ", SHA: " << (Poco::CPUFeatures::hasSHA() ? "yes" : "no") << std::endl << std::endl;
+
+	Poco::Random rnd;
+	std::vector<char> data(CHUNK_SIZE);
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<char>(rnd.next(256));
+	}
+
+	ChecksumAlgorithm crc32("CRC-32", Poco::Checksum::TYPE_CRC32);
+	ChecksumAlgorithm crc32c("CRC-32C", Poco::Checksum::TYPE_CRC32C);
+	ChecksumAlgorithm adler32("Adler-32", Poco::Checksum::TYPE_ADLER32);
+	DigestAlgorithm<Poco::MD5Engine> md5("MD5");
+	DigestAlgorithm<Poco::SHA1Engine> sha1("SHA-1");
+	DigestAlgorithm<Poco::SHA256Engine> sha256("SHA-256");
+	DigestAlgorithm<Poco::SHA512Engine> sha512("SHA-512");
+	Algorithm* algorithms[] = { &crc32, &crc32c, &adler32, &md5, &sha1, &sha256, &sha512 };
+
+	for (std::size_t i = 0; i < sizeof(algorithms)/sizeof(algorithms[0]); ++i)
+	{
+		for (UInt64 size = 64; size <= maxSize; size *= 16)
+		{
+			benchmark(*algorithms[i], data, size);
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
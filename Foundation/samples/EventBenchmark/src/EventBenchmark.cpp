@@ -0,0 +1,157 @@
+//
+// EventBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures the cost of BasicEvent::notify() with
+// 0, 1 and 10 delegates, from one or more threads. For
+// comparison, it also measures a notification that copies
+// the delegate strategy under a mutex, as notify() did before
+// events kept immutable copies of their strategy.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BasicEvent.h"
+#include "Poco/DefaultStrategy.h"
+#include "Poco/AbstractDelegate.h"
+#include "Poco/Delegate.h"
+#include "Poco/Mutex.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::BasicEvent;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+const int ITERATIONS = 1000000;
+
+
+class Target
+{
+public:
+	void onEvent(const void*, int&)
+	{
+	}
+};
+
+
+class CopyingEvent
+	/// Notifies like AbstractEvent::notify() did before:
+	/// the strategy is copied under the mutex.
+{
+public:
+	typedef Poco::DefaultStrategy<int, Poco::AbstractDelegate<int> > Strategy;
+
+	void add(const Poco::AbstractDelegate<int>& aDelegate)
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		_strategy.add(aDelegate);
+	}
+
+	void notify(const void* pSender, int& arg)
+	{
+		Poco::ScopedLockWithUnlock<Poco::FastMutex> lock(_mutex);
+		Strategy strategy(_strategy);
+		lock.unlock();
+		strategy.notify(pSender, arg);
+	}
+
+private:
+	Strategy _strategy;
+	Poco::FastMutex _mutex;
+};
+
+
+template <class E>
+class Worker: public Poco::Runnable
+{
+public:
+	Worker(E& ev):
+		_ev(ev)
+	{
+	}
+
+	void run()
+	{
+		for (int i = 0; i < ITERATIONS; ++i)
+		{
+			int arg = i;
+			_ev.notify(this, arg);
+		}
+	}
+
+private:
+	E& _ev;
+};
+
+
+template <class E>
+void benchmark(E& ev, int threads, const std::string& label)
+{
+	std::vector<Worker<E>*> workers;
+	std::vector<Thread*> pool;
+	for (int i = 0; i < threads; ++i)
+	{
+		workers.push_back(new Worker<E>(ev));
+		pool.push_back(new Thread);
+	}
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i) pool[i]->start(*workers[i]);
+	for (int i = 0; i < threads; ++i) pool[i]->join();
+	sw.stop();
+
+	double ops = 1.0*ITERATIONS*threads;
+	std::cout << std::setw(16) << label << std::setw(4) << threads << " threads: "
+	          << std::setw(10) << sw.elapsed()/1000 << " [ms] "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*sw.elapsed()/ops << " [ns/notify]" << std::endl;
+
+	for (int i = 0; i < threads; ++i)
+	{
+		delete pool[i];
+		delete workers[i];
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 8;
+
+	const int DELEGATES[] = {0, 1, 10};
+	std::vector<Target> targets(10);
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		for (int d = 0; d < 3; ++d)
+		{
+			int delegates = DELEGATES[d];
+			BasicEvent<int> ev;
+			CopyingEvent copying;
+			for (int i = 0; i < delegates; ++i)
+			{
+				ev += Poco::delegate(&targets[i], &Target::onEvent);
+				copying.add(Poco::delegate(&targets[i], &Target::onEvent));
+			}
+			std::string count = Poco::NumberFormatter::format(delegates);
+			benchmark(ev, threads, "notify " + count);
+			benchmark(copying, threads, "copying " + count);
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
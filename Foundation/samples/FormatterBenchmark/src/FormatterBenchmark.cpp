@@ -0,0 +1,106 @@
+//
+// FormatterBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures how many messages per second a
+// PatternFormatter can format for some common patterns,
+// both in a Poco::Thread, which uses the per-thread time
+// cache, and in the main thread, which does not.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+
+
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::Stopwatch;
+
+
+class Worker: public Poco::Runnable
+{
+public:
+	Worker(const std::string& pattern, const std::string& times, int iterations):
+		_formatter(pattern),
+		_iterations(iterations),
+		_elapsed(0),
+		_length(0)
+	{
+		_formatter.setProperty("times", times);
+	}
+
+	void run()
+	{
+		Message msg("Benchmark.Source", "A log message of moderate length, as typically produced by a server", Message::PRIO_INFORMATION);
+		Poco::Timestamp start = msg.getTime();
+		std::string text;
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < _iterations; ++i)
+		{
+			// advance the message time by 10 us per message, as if
+			// 100000 messages were logged per second
+			msg.setTime(start + Poco::Timestamp::TimeDiff(i)*10);
+			text.clear();
+			_formatter.format(msg, text);
+			_length += text.size();
+		}
+		sw.stop();
+		_elapsed = sw.elapsed();
+	}
+
+	Poco::Timestamp::TimeDiff elapsed() const
+	{
+		return _elapsed;
+	}
+
+private:
+	PatternFormatter _formatter;
+	int _iterations;
+	Poco::Timestamp::TimeDiff _elapsed;
+	std::size_t _length;
+};
+
+
+void benchmark(const std::string& pattern, const std::string& times, int iterations)
+{
+	Worker cached(pattern, times, iterations);
+	Poco::Thread thread;
+	thread.start(cached);
+	thread.join();
+
+	Worker uncached(pattern, times, iterations);
+	uncached.run();
+
+	std::cout << pattern << " (" << times << ")" << std::endl;
+	std::cout << "    cached:   " << std::setw(10) << static_cast<long>(1000000.0*iterations/cached.elapsed()) << " [messages/s]" << std::endl;
+	std::cout << "    uncached: " << std::setw(10) << static_cast<long>(1000000.0*iterations/uncached.elapsed()) << " [messages/s]" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 1000000;
+
+	benchmark("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t", "UTC", iterations);
+	benchmark("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t", "local", iterations);
+	benchmark("%Y-%m-%dT%H:%M:%S.%F%z [%P:%I] %q %s - %t", "UTC", iterations);
+	benchmark("%w, %e %b %Y %H:%M:%S %Z %s: %t", "local", iterations);
+	benchmark("%s: %t", "UTC", iterations);
+
+	return 0;
+}
@@ -0,0 +1,289 @@
+//
+// HashMapBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares insert, lookup and erase performance
+// of FlatHashMap, HashMap, LinearHashTable, SimpleHashTable
+// and, if available, std::unordered_map, for integer and
+// string keys and table sizes from 1K up to 10M entries.
+//
+// Usage: HashMapBenchmark [<max size>]
+//
+// The string hash functions are not inlined, so meaningful
+// results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/FlatHashMap.h"
+#include "Poco/HashMap.h"
+#include "Poco/LinearHashTable.h"
+#include "Poco/SimpleHashTable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Random.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#if defined(POCO_ENABLE_CPP11) || __cplusplus >= 201103L
+#include <unordered_map>
+#define HAVE_UNORDERED_MAP
+#endif
+
+
+using Poco::Stopwatch;
+
+
+template <class Key>
+struct LinearEntry
+	/// LinearHashTable is a set, so the benchmark
+	/// stores key/value pairs compared by key.
+{
+	Key key;
+	int value;
+
+	LinearEntry(): key(), value(0)
+	{
+	}
+
+	LinearEntry(const Key& k, int v = 0): key(k), value(v)
+	{
+	}
+
+	bool operator == (const LinearEntry& entry) const
+	{
+		return key == entry.key;
+	}
+};
+
+
+template <class Key>
+struct LinearEntryHash
+{
+	std::size_t operator () (const LinearEntry<Key>& entry) const
+	{
+		return _hash(entry.key);
+	}
+
+	Poco::Hash<Key> _hash;
+};
+
+
+template <class Key>
+class FlatHashMapAdapter
+{
+public:
+	static const char* name() { return "FlatHashMap"; }
+	void insert(const Key& key, int value) { _map.insert(typename Map::ValueType(key, value)); }
+	bool find(const Key& key) const { return _map.find(key) != _map.end(); }
+	bool erase(const Key& key) { return _map.erase(key) == 1; }
+
+private:
+	typedef Poco::FlatHashMap<Key, int> Map;
+	Map _map;
+};
+
+
+template <class Key>
+class HashMapAdapter
+{
+public:
+	static const char* name() { return "HashMap"; }
+	void insert(const Key& key, int value) { _map.insert(typename Map::PairType(key, value)); }
+	bool find(const Key& key) const { return _map.find(key) != _map.end(); }
+	bool erase(const Key& key)
+	{
+		typename Map::Iterator it = _map.find(key);
+		if (it == _map.end()) return false;
+		_map.erase(it);
+		return true;
+	}
+
+private:
+	typedef Poco::HashMap<Key, int> Map;
+	Map _map;
+};
+
+
+template <class Key>
+class LinearHashTableAdapter
+{
+public:
+	static const char* name() { return "LinearHashTable"; }
+	void insert(const Key& key, int value) { _table.insert(LinearEntry<Key>(key, value)); }
+	bool find(const Key& key) const { return _table.find(LinearEntry<Key>(key)) != _table.end(); }
+	bool erase(const Key& key)
+	{
+		typename Table::Iterator it = _table.find(LinearEntry<Key>(key));
+		if (it == _table.end()) return false;
+		_table.erase(it);
+		return true;
+	}
+
+private:
+	typedef Poco::LinearHashTable<LinearEntry<Key>, LinearEntryHash<Key> > Table;
+	Table _table;
+};
+
+
+template <class Key>
+class SimpleHashTableAdapter
+	/// SimpleHashTable neither grows nor supports removing
+	/// entries, so it is created with twice the required
+	/// capacity and the erase test is skipped.
+{
+public:
+	static const char* name() { return "SimpleHashTable"; }
+	explicit SimpleHashTableAdapter(std::size_t n): _table(static_cast<Poco::UInt32>(2*n + 1)) { }
+	void insert(const Key& key, int value) { _table.insert(key, value); }
+	bool find(const Key& key) const { return _table.exists(key); }
+
+private:
+	Poco::SimpleHashTable<Key, int> _table;
+};
+
+
+#if defined(HAVE_UNORDERED_MAP)
+template <class Key>
+class UnorderedMapAdapter
+{
+public:
+	static const char* name() { return "unordered_map"; }
+	void insert(const Key& key, int value) { _map.insert(std::make_pair(key, value)); }
+	bool find(const Key& key) const { return _map.find(key) != _map.end(); }
+	bool erase(const Key& key) { return _map.erase(key) == 1; }
+
+private:
+	std::unordered_map<Key, int> _map;
+};
+#endif
+
+
+void print(const char* name, const char* op, std::size_t n, Poco::Timestamp::TimeDiff elapsed, std::size_t ops)
+{
+	std::cout << std::setw(16) << name << std::setw(10) << n << std::setw(8) << op << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*elapsed/ops << " [ns/op]" << std::endl;
+}
+
+
+template <class Table, class Key>
+void insertAndFind(Table& table, const std::vector<Key>& keys, const std::vector<Key>& missing)
+{
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		table.insert(keys[i], static_cast<int>(i));
+	}
+	sw.stop();
+	print(Table::name(), "insert", keys.size(), sw.elapsed(), keys.size());
+
+	std::size_t found = 0;
+	sw.restart();
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		if (table.find(keys[i])) ++found;
+		if (table.find(missing[i])) ++found;
+	}
+	sw.stop();
+	if (found != keys.size()) std::cout << "lookup failed" << std::endl;
+	print(Table::name(), "find", keys.size(), sw.elapsed(), 2*keys.size());
+}
+
+
+template <class Table, class Key>
+void erase(Table& table, const std::vector<Key>& keys)
+{
+	std::size_t erased = 0;
+	Stopwatch sw;
+	sw.start();
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		if (table.erase(keys[i])) ++erased;
+	}
+	sw.stop();
+	if (erased != keys.size()) std::cout << "erase failed" << std::endl;
+	print(Table::name(), "erase", keys.size(), sw.elapsed(), keys.size());
+}
+
+
+template <class Table, class Key>
+void benchmark(const std::vector<Key>& keys, const std::vector<Key>& missing)
+{
+	Table table;
+	insertAndFind(table, keys, missing);
+	erase(table, keys);
+}
+
+
+template <class Key>
+void benchmarkAll(const std::vector<Key>& keys, const std::vector<Key>& missing)
+{
+	benchmark<FlatHashMapAdapter<Key> >(keys, missing);
+	benchmark<HashMapAdapter<Key> >(keys, missing);
+	benchmark<LinearHashTableAdapter<Key> >(keys, missing);
+	SimpleHashTableAdapter<Key> simple(keys.size());
+	insertAndFind(simple, keys, missing);
+#if defined(HAVE_UNORDERED_MAP)
+	benchmark<UnorderedMapAdapter<Key> >(keys, missing);
+#endif
+	std::cout << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t maxSize = argc > 1 ? Poco::NumberParser::parseUnsigned(argv[1]) : 1000000;
+
+	Poco::Random rnd;
+	for (std::size_t n = 1000; n <= maxSize; n *= 10)
+	{
+		// Random keys, with the lowest bit selecting
+		// between present and missing keys.
+		std::vector<int> keys;
+		std::vector<int> missing;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			int key = static_cast<int>(rnd.next() & ~1U);
+			keys.push_back(key);
+			missing.push_back(key | 1);
+		}
+		// remove duplicates, as they would skew the results
+		{
+			Poco::FlatHashMap<int, int> seen(n);
+			std::size_t j = 0;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				if (seen.insert(std::make_pair(keys[i], 0)).second)
+				{
+					keys[j] = keys[i];
+					missing[j] = missing[i];
+					++j;
+				}
+			}
+			keys.resize(j);
+			missing.resize(j);
+		}
+		std::cout << "int keys" << std::endl;
+		benchmarkAll(keys, missing);
+
+		std::vector<std::string> strKeys;
+		std::vector<std::string> strMissing;
+		for (std::size_t i = 0; i < keys.size(); ++i)
+		{
+			strKeys.push_back("key-" + Poco::NumberFormatter::format(keys[i]));
+			strMissing.push_back("key-" + Poco::NumberFormatter::format(missing[i]));
+		}
+		std::cout << "std::string keys" << std::endl;
+		benchmarkAll(strKeys, strMissing);
+	}
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+//
+// LoggerBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures the cost of logger lookups and of
+// disabled and enabled log calls from multiple threads, and
+// the throughput of an AsyncChannel with an unbounded queue
+// and with a ring buffer, of a FileChannel flushing every
+// message or writing through its buffer, and of binary trace
+// logging with Logger::record() and a BinaryFileChannel.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Logger.h"
+#include "Poco/NullChannel.h"
+#include "Poco/AsyncChannel.h"
+#include "Poco/FileChannel.h"
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/File.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Logger;
+using Poco::Message;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+const int ITERATIONS = 200000;
+
+
+class Worker: public Poco::Runnable
+{
+public:
+	enum Mode
+	{
+		MODE_GET,
+		MODE_DISABLED,
+		MODE_DISABLED_FORMAT,
+		MODE_ENABLED,
+		MODE_ENABLED_FORMAT,
+		MODE_RECORD
+	};
+
+	Worker(Mode mode, const std::string& loggerName):
+		_mode(mode),
+		_loggerName(loggerName),
+		_text("A log message of moderate length, as typically produced by a server"),
+		_count(0)
+	{
+	}
+
+	void run()
+	{
+		Logger& logger = Logger::get(_loggerName);
+		switch (_mode)
+		{
+		case MODE_GET:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				if (Logger::get(_loggerName).is(Message::PRIO_TRACE)) ++_count;
+			}
+			break;
+		case MODE_DISABLED:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				logger.debug(_text);
+			}
+			break;
+		case MODE_DISABLED_FORMAT:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				logger.debug("request %s took %d ms", _text, i);
+			}
+			break;
+		case MODE_ENABLED:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				logger.information(_text);
+			}
+			break;
+		case MODE_ENABLED_FORMAT:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				logger.information("request %s took %d ms", _text, i);
+			}
+			break;
+		case MODE_RECORD:
+			for (int i = 0; i < ITERATIONS; ++i)
+			{
+				logger.record(Message::PRIO_INFORMATION, "request %s took %d ms", _text, i);
+			}
+			break;
+		}
+	}
+
+private:
+	Mode _mode;
+	std::string _loggerName;
+	std::string _text;
+	int _count;
+};
+
+
+void benchmark(Worker::Mode mode, int threads, const std::string& label, const std::string& loggerName = "Benchmark.Worker", Poco::Channel* pAsync = 0)
+{
+	std::vector<Worker*> workers;
+	std::vector<Thread*> pool;
+	for (int i = 0; i < threads; ++i)
+	{
+		workers.push_back(new Worker(mode, loggerName));
+		pool.push_back(new Thread);
+	}
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i) pool[i]->start(*workers[i]);
+	for (int i = 0; i < threads; ++i) pool[i]->join();
+	sw.stop();
+	if (pAsync) pAsync->close(); // measure the cost for the logging threads only
+
+	double ops = 1.0*ITERATIONS*threads;
+	std::cout << std::setw(16) << label << std::setw(4) << threads << " threads: "
+	          << std::setw(10) << sw.elapsed()/1000 << " [ms] "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*sw.elapsed()/ops << " [ns/call]" << std::endl;
+
+	for (int i = 0; i < threads; ++i)
+	{
+		delete pool[i];
+		delete workers[i];
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 32;
+
+	// Messages go to a NullChannel, so that the results
+	// show the cost of the Logger, not of the Channel.
+	Poco::AutoPtr<Poco::NullChannel> pChannel = new Poco::NullChannel;
+	Logger& logger = Logger::get("Benchmark.Worker");
+	logger.setChannel(pChannel);
+	logger.setLevel(Message::PRIO_INFORMATION);
+
+	Poco::AutoPtr<Poco::AsyncChannel> pAsyncQueue = new Poco::AsyncChannel(pChannel);
+	Logger::get("Benchmark.AsyncQueue").setChannel(pAsyncQueue);
+
+	Poco::AutoPtr<Poco::AsyncChannel> pAsyncRing = new Poco::AsyncChannel(pChannel);
+	pAsyncRing->setProperty("queueSize", "65536");
+	Logger::get("Benchmark.AsyncRing").setChannel(pAsyncRing);
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		benchmark(Worker::MODE_GET, threads, "get");
+		benchmark(Worker::MODE_DISABLED, threads, "disabled");
+		benchmark(Worker::MODE_DISABLED_FORMAT, threads, "disabled format");
+		benchmark(Worker::MODE_ENABLED, threads, "enabled");
+		benchmark(Worker::MODE_ENABLED_FORMAT, threads, "enabled format");
+		benchmark(Worker::MODE_ENABLED, threads, "async queue", "Benchmark.AsyncQueue", pAsyncQueue);
+		benchmark(Worker::MODE_ENABLED, threads, "async ring", "Benchmark.AsyncRing", pAsyncRing);
+		std::cout << std::endl;
+	}
+
+	Poco::AutoPtr<Poco::FileChannel> pFileFlush = new Poco::FileChannel("LoggerBenchmark.flush.log");
+	Logger::get("Benchmark.FileFlush").setChannel(pFileFlush);
+
+	Poco::AutoPtr<Poco::FileChannel> pFileBuffered = new Poco::FileChannel("LoggerBenchmark.buffered.log");
+	pFileBuffered->setProperty("flush", "false");
+	pFileBuffered->setProperty("bufferSize", "65536");
+	pFileBuffered->setProperty("flushInterval", "100");
+	Logger::get("Benchmark.FileBuffered").setChannel(pFileBuffered);
+
+	Poco::AutoPtr<Poco::BinaryFileChannel> pBinary = new Poco::BinaryFileChannel("LoggerBenchmark.plog");
+	pBinary->setProperty("flush", "false");
+	pBinary->setProperty("bufferSize", "65536");
+	pBinary->setProperty("flushInterval", "100");
+	Logger::get("Benchmark.Binary").setChannel(pBinary);
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		benchmark(Worker::MODE_ENABLED, threads, "file flush", "Benchmark.FileFlush");
+		benchmark(Worker::MODE_ENABLED, threads, "file buffered", "Benchmark.FileBuffered");
+		benchmark(Worker::MODE_ENABLED_FORMAT, threads, "file format", "Benchmark.FileBuffered");
+		benchmark(Worker::MODE_RECORD, threads, "binary record", "Benchmark.Binary");
+		std::cout << std::endl;
+	}
+
+	pFileFlush->close();
+	pFileBuffered->close();
+	pBinary->close();
+	Poco::File("LoggerBenchmark.flush.log").remove();
+	Poco::File("LoggerBenchmark.buffered.log").remove();
+	Poco::File("LoggerBenchmark.plog").remove();
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+//
+// NumberBenchmark.cpp
+//
+// $Id$
+//
+// This sample measures formatting with NumberFormatter and
+// parsing with NumberParser for number distributions typically
+// found in JSON documents, CSV exports and log files.
+//
+// Usage: NumberBenchmark [<count>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Random.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+using Poco::Stopwatch;
+using Poco::Int64;
+using Poco::UInt64;
+
+
+void print(const char* name, const char* op, Poco::Timestamp::TimeDiff elapsed, std::size_t ops, std::size_t chars)
+{
+	std::cout << std::setw(20) << name << std::setw(8) << op << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*elapsed/ops << " [ns/op]"
+	          << std::setw(8) << std::setprecision(1) << double(chars)/ops << " [chars/op]" << std::endl;
+}
+
+
+template <typename T>
+void formatNumbers(const std::vector<T>& numbers, std::vector<std::string>& strings)
+{
+	strings.clear();
+	for (std::size_t i = 0; i < numbers.size(); ++i)
+	{
+		strings.push_back(NumberFormatter::format(numbers[i]));
+	}
+}
+
+
+template <typename T>
+std::size_t appendNumbers(const std::vector<T>& numbers)
+{
+	// Appending to the same string, as done by
+	// JSON stringifiers and CSV writers.
+	std::size_t chars = 0;
+	std::string str;
+	for (std::size_t i = 0; i < numbers.size(); ++i)
+	{
+		str.clear();
+		NumberFormatter::append(str, numbers[i]);
+		chars += str.size();
+	}
+	return chars;
+}
+
+
+void parse(const std::string& s, int& value)
+{
+	value = NumberParser::parse(s);
+}
+
+
+void parse(const std::string& s, Int64& value)
+{
+	value = NumberParser::parse64(s);
+}
+
+
+void parse(const std::string& s, UInt64& value)
+{
+	value = NumberParser::parseUnsigned64(s);
+}
+
+
+void parse(const std::string& s, double& value)
+{
+	value = NumberParser::parseFloat(s);
+}
+
+
+template <typename T>
+void benchmark(const char* name, const std::vector<T>& numbers)
+{
+	Stopwatch sw;
+	sw.start();
+	std::size_t chars = appendNumbers(numbers);
+	sw.stop();
+	print(name, "format", sw.elapsed(), numbers.size(), chars);
+
+	std::vector<std::string> strings;
+	formatNumbers(numbers, strings);
+	std::size_t errors = 0;
+	T value;
+	sw.restart();
+	for (std::size_t i = 0; i < strings.size(); ++i)
+	{
+		parse(strings[i], value);
+		if (value != numbers[i]) ++errors;
+	}
+	sw.stop();
+	print(name, "parse", sw.elapsed(), numbers.size(), chars);
+	if (errors) std::cout << errors << " values did not round-trip" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	std::size_t count = argc > 1 ? NumberParser::parseUnsigned(argv[1]) : 1000000;
+
+	Poco::Random rnd;
+	std::vector<int> smallInts;
+	std::vector<int> ints;
+	std::vector<Int64> timestamps;
+	std::vector<UInt64> ids;
+	std::vector<double> prices;
+	std::vector<double> counts;
+	std::vector<double> fractions;
+	std::vector<double> measurements;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		// array indices, HTTP status codes, ages, ...
+		smallInts.push_back(static_cast<int>(rnd.next(1000)));
+		// signed values spread over all magnitudes
+		int digits = static_cast<int>(rnd.next(10));
+		int value = static_cast<int>(rnd.next(static_cast<Poco::UInt32>(std::pow(10.0, digits)) + 1));
+		ints.push_back(rnd.nextBool() ? value : -value);
+		// microsecond timestamps
+		timestamps.push_back(Int64(1500000000000000LL) + rnd.next());
+		// 64-bit database keys
+		ids.push_back((UInt64(rnd.next()) << 32) | rnd.next());
+		// amounts with two decimals, as in 19.99
+		prices.push_back(rnd.next(1000000)/100.0);
+		// integral values stored as double, as in JSON
+		counts.push_back(static_cast<double>(rnd.next(100000)));
+		// doubles using all significant digits
+		fractions.push_back(rnd.nextDouble());
+		// sensor readings and scientific values
+		measurements.push_back((rnd.nextDouble() - 0.5)*std::pow(10.0, static_cast<int>(rnd.next(40)) - 20));
+	}
+
+	benchmark("small int", smallInts);
+	benchmark("int", ints);
+	benchmark("Int64 timestamp", timestamps);
+	benchmark("UInt64 id", ids);
+	benchmark("double price", prices);
+	benchmark("double count", counts);
+	benchmark("double fraction", fractions);
+	benchmark("double measurement", measurements);
+
+	return 0;
+}
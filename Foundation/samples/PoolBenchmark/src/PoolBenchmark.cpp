@@ -0,0 +1,190 @@
+//
+// PoolBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares the throughput of MemoryPool, SizeClassPool
+// and operator new/delete under contention from multiple threads.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MemoryPool.h"
+#include "Poco/SizeClassPool.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::MemoryPool;
+using Poco::SizeClassPool;
+using Poco::Thread;
+using Poco::Stopwatch;
+
+
+const int ITERATIONS = 1000000;
+const int BATCH = 16;
+
+
+class NewDeleteAllocator
+{
+public:
+	NewDeleteAllocator(std::size_t size):
+		_size(size)
+	{
+	}
+
+	void* get()
+	{
+		return new char[_size];
+	}
+
+	void release(void* ptr)
+	{
+		delete [] static_cast<char*>(ptr);
+	}
+
+private:
+	std::size_t _size;
+};
+
+
+class MemoryPoolAllocator
+{
+public:
+	MemoryPoolAllocator(MemoryPool& pool):
+		_pool(pool)
+	{
+	}
+
+	void* get()
+	{
+		return _pool.get();
+	}
+
+	void release(void* ptr)
+	{
+		_pool.release(ptr);
+	}
+
+private:
+	MemoryPool& _pool;
+};
+
+
+class SizeClassPoolAllocator
+{
+public:
+	SizeClassPoolAllocator(SizeClassPool& pool, std::size_t size):
+		_pool(pool),
+		_size(size)
+	{
+	}
+
+	void* get()
+	{
+		return _pool.allocate(_size);
+	}
+
+	void release(void* ptr)
+	{
+		_pool.deallocate(ptr, _size);
+	}
+
+private:
+	SizeClassPool& _pool;
+	std::size_t _size;
+};
+
+
+template <class A>
+class Worker: public Poco::Runnable
+	/// Allocates and releases blocks in small batches,
+	/// similar to a server handling short requests.
+{
+public:
+	Worker(A& allocator):
+		_allocator(allocator)
+	{
+	}
+
+	void run()
+	{
+		void* blocks[BATCH];
+		for (int i = 0; i < ITERATIONS/BATCH; ++i)
+		{
+			for (int k = 0; k < BATCH; ++k) blocks[k] = _allocator.get();
+			for (int k = 0; k < BATCH; ++k) _allocator.release(blocks[k]);
+		}
+	}
+
+private:
+	A& _allocator;
+};
+
+
+template <class A>
+void benchmark(A& allocator, int threads, const std::string& label)
+{
+	std::vector<Worker<A>*> workers;
+	std::vector<Thread*> pool;
+	for (int i = 0; i < threads; ++i)
+	{
+		workers.push_back(new Worker<A>(allocator));
+		pool.push_back(new Thread);
+	}
+
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < threads; ++i) pool[i]->start(*workers[i]);
+	for (int i = 0; i < threads; ++i) pool[i]->join();
+	sw.stop();
+
+	double ops = 2.0*ITERATIONS*threads;
+	std::cout << std::setw(16) << label << std::setw(4) << threads << " threads: "
+	          << std::setw(10) << sw.elapsed()/1000 << " [ms] "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*sw.elapsed()/ops << " [ns/op]" << std::endl;
+
+	for (int i = 0; i < threads; ++i)
+	{
+		delete pool[i];
+		delete workers[i];
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 32;
+
+	std::size_t sizes[] = { 64, 4096 };
+	for (int s = 0; s < 2; ++s)
+	{
+		std::size_t size = sizes[s];
+		std::cout << "Block size " << size << std::endl;
+		for (int threads = 1; threads <= maxThreads; threads *= 2)
+		{
+			NewDeleteAllocator newDelete(size);
+			benchmark(newDelete, threads, "new/delete");
+
+			MemoryPool memoryPool(size, 16);
+			MemoryPoolAllocator memoryPoolAllocator(memoryPool);
+			benchmark(memoryPoolAllocator, threads, "MemoryPool");
+
+			SizeClassPool sizeClassPool;
+			SizeClassPoolAllocator sizeClassPoolAllocator(sizeClassPool, size);
+			benchmark(sizeClassPoolAllocator, threads, "SizeClassPool");
+		}
+		std::cout << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+//
+// URIBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares parsing request URIs and their query
+// parameters with URI and with URIView.
+//
+// Usage: URIBenchmark [<iterations>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/URI.h"
+#include "Poco/URIView.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::URI;
+using Poco::URIView;
+using Poco::Stopwatch;
+
+
+void print(const char* name, Poco::Timestamp::TimeDiff elapsed, int iterations, std::size_t count)
+{
+	std::cout << std::setw(36) << std::left << name << std::right << ": "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << double(elapsed)*1000/iterations << " ns/URI"
+	          << " (" << count << ")" << std::endl;
+}
+
+
+void benchmark(const std::vector<std::string>& uris, int iterations)
+{
+	Stopwatch sw;
+	std::size_t count = 0;
+
+	sw.start();
+	for (int i = 0; i < iterations; ++i)
+	{
+		URI uri(uris[i % uris.size()]);
+		count += uri.getPath().size();
+	}
+	sw.stop();
+	print("URI: path", sw.elapsed(), iterations, count);
+
+	count = 0;
+	sw.restart();
+	std::string path;
+	for (int i = 0; i < iterations; ++i)
+	{
+		URIView uri(uris[i % uris.size()]);
+		path.clear();
+		URIView::decode(uri.getRawPath(), path);
+		count += path.size();
+	}
+	sw.stop();
+	print("URIView: path", sw.elapsed(), iterations, count);
+
+	count = 0;
+	sw.restart();
+	for (int i = 0; i < iterations; ++i)
+	{
+		URI uri(uris[i % uris.size()]);
+		URI::QueryParameters params = uri.getQueryParameters();
+		for (URI::QueryParameters::const_iterator it = params.begin(); it != params.end(); ++it)
+		{
+			count += it->first.size() + it->second.size();
+		}
+	}
+	sw.stop();
+	print("URI: query parameters", sw.elapsed(), iterations, count);
+
+	count = 0;
+	sw.restart();
+	std::string name;
+	std::string value;
+	for (int i = 0; i < iterations; ++i)
+	{
+		URIView uri(uris[i % uris.size()]);
+		URIView::QueryParameterIterator it(uri.getRawQuery());
+		while (it.next(name, value))
+		{
+			count += name.size() + value.size();
+		}
+	}
+	sw.stop();
+	print("URIView: query parameters", sw.elapsed(), iterations, count);
+
+	count = 0;
+	sw.restart();
+	for (int i = 0; i < iterations; ++i)
+	{
+		URI uri;
+		uri.setScheme("http");
+		uri.setHost("www.example.com");
+		uri.setPath("/search");
+		uri.addQueryParameter("q", "poco c++ libraries");
+		uri.addQueryParameter("page", "2");
+		count += uri.toString().size();
+	}
+	sw.stop();
+	print("URI: build", sw.elapsed(), iterations, count);
+
+	count = 0;
+	sw.restart();
+	std::string query;
+	std::string str;
+	for (int i = 0; i < iterations; ++i)
+	{
+		query.clear();
+		URIView::appendQueryParameter(query, "q", "poco c++ libraries");
+		URIView::appendQueryParameter(query, "page", "2");
+		str.assign("http://www.example.com/search?");
+		str += query;
+		count += str.size();
+	}
+	sw.stop();
+	print("URIView: build", sw.elapsed(), iterations, count);
+}
+
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 1000000;
+
+	std::vector<std::string> uris;
+	uris.push_back("/");
+	uris.push_back("/index.html");
+	uris.push_back("/api/v1/users/12345/orders?status=open&limit=50&offset=100");
+	uris.push_back("/search?q=poco+c%2B%2B+libraries&lang=en&page=2#results");
+	uris.push_back("/static/images/logo%20large.png");
+	uris.push_back("http://www.example.com:8080/path/to/resource?a=1&b=2&c=3&d=4");
+
+	benchmark(uris, iterations);
+
+	return 0;
+}
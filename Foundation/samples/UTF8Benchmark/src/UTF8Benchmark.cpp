@@ -0,0 +1,141 @@
+//
+// UTF8Benchmark.cpp
+//
+// $Id$
+//
+// This sample measures the throughput of UTF-8 validation and of
+// converting text between UTF-8, UTF-16 and Latin-1 with TextConverter,
+// both with the bulk conversion functions in UTF8 and character
+// by character.
+//
+// Usage: UTF8Benchmark [<megabytes>]
+//
+// Meaningful results require a release build of the Foundation library.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/TextConverter.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/Latin1Encoding.h"
+#include "Poco/UTF8String.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+
+
+using Poco::TextConverter;
+using Poco::TextEncoding;
+using Poco::UTF8Encoding;
+using Poco::UTF16Encoding;
+using Poco::Latin1Encoding;
+using Poco::UTF8;
+using Poco::Stopwatch;
+
+
+int identity(int ch)
+	/// Passing a transform function to TextConverter
+	/// disables the bulk conversion functions.
+{
+	return ch;
+}
+
+
+void print(const std::string& name, Poco::Timestamp::TimeDiff elapsed, std::size_t bytes)
+{
+	double mbps = elapsed > 0 ? double(bytes)/elapsed : 0;
+	std::cout << std::setw(40) << std::left << name << std::right << ": "
+	          << std::setw(9) << std::fixed << std::setprecision(1) << mbps << " MB/s" << std::endl;
+}
+
+
+void convert(const std::string& name, const TextEncoding& inEncoding, const TextEncoding& outEncoding, const std::string& text, int iterations)
+{
+	TextConverter converter(inEncoding, outEncoding);
+	std::string result;
+	Stopwatch sw;
+
+	sw.start();
+	for (int i = 0; i < iterations; ++i)
+	{
+		result.clear();
+		converter.convert(text, result);
+	}
+	sw.stop();
+	print(name + " (bulk)", sw.elapsed(), text.size()*iterations);
+
+	sw.restart();
+	for (int i = 0; i < iterations; ++i)
+	{
+		result.clear();
+		converter.convert(text, result, identity);
+	}
+	sw.stop();
+	print(name + " (per character)", sw.elapsed(), text.size()*iterations);
+}
+
+
+void benchmark(const std::string& name, const std::string& utf8, int iterations)
+{
+	UTF8Encoding utf8Encoding;
+	UTF16Encoding utf16Encoding;
+	Latin1Encoding latin1Encoding;
+
+	std::cout << name << ":" << std::endl;
+
+	Stopwatch sw;
+	std::size_t valid = 0;
+	sw.start();
+	for (int i = 0; i < iterations; ++i)
+	{
+		valid += UTF8::validate(utf8.data(), utf8.size());
+	}
+	sw.stop();
+	print("validate", sw.elapsed(), utf8.size()*iterations);
+
+	convert("UTF-8 to UTF-16", utf8Encoding, utf16Encoding, utf8, iterations);
+
+	std::string utf16;
+	TextConverter(utf8Encoding, utf16Encoding).convert(utf8, utf16);
+	convert("UTF-16 to UTF-8", utf16Encoding, utf8Encoding, utf16, iterations);
+
+	std::string latin1(utf8.size(), '\0');
+	std::size_t latin1Length = 0;
+	if (UTF8::toLatin1(utf8.data(), utf8.size(), &latin1[0], latin1Length) == utf8.size())
+	{
+		latin1.resize(latin1Length);
+		convert("UTF-8 to Latin-1", utf8Encoding, latin1Encoding, utf8, iterations);
+		convert("Latin-1 to UTF-8", latin1Encoding, utf8Encoding, latin1, iterations);
+	}
+	std::cout << std::endl;
+}
+
+
+std::string repeat(const std::string& str, std::size_t size)
+{
+	std::string result;
+	result.reserve(size + str.size());
+	while (result.size() < size) result += str;
+	return result;
+}
+
+
+int main(int argc, char** argv)
+{
+	int megabytes = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 100;
+	const std::size_t size = 64*1024;
+	int iterations = megabytes*1024*1024/size;
+
+	benchmark("ASCII", repeat("The quick brown fox jumps over the lazy dog. ", size), iterations);
+	benchmark("German", repeat("Falsches \xC3\x9C" "ben von Xylophonmusik qu\xC3\xA4lt jeden gr\xC3\xB6\xC3\x9F" "eren Zwerg. ", size), iterations);
+	benchmark("Greek", repeat("\xCE\x9E\xCE\xB5\xCF\x83\xCE\xBA\xCE\xB5\xCF\x80\xCE\xAC\xCE\xB6\xCF\x89 \xCF\x84\xCE\xB7\xCE\xBD \xCF\x88\xCF\x85\xCF\x87\xCE\xBF\xCF\x86\xCE\xB8\xCF\x8C\xCF\x81\xCE\xB1 \xCE\xB2\xCE\xB4\xCE\xB5\xCE\xBB\xCF\x85\xCE\xB3\xCE\xBC\xCE\xAF\xCE\xB1. ", size), iterations);
+
+	return 0;
+}
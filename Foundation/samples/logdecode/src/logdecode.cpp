@@ -0,0 +1,79 @@
+//
+// logdecode.cpp
+//
+// $Id$
+//
+// This sample demonstrates the BinaryLogDecoder class.
+// It converts log files written by a BinaryFileChannel
+// to text.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogDecoder.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+
+using Poco::BinaryLogDecoder;
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::AutoPtr;
+
+
+int main(int argc, char** argv)
+{
+	std::string pattern("%Y-%m-%d %H:%M:%S.%i [%p] %s<%I>: %t");
+	int first = 1;
+	if (argc > 2 && std::strcmp(argv[1], "-p") == 0)
+	{
+		pattern = argv[2];
+		first = 3;
+	}
+	if (first >= argc)
+	{
+		std::cout << "usage: " << argv[0] << ": [-p <pattern>] <log_file> ..." << std::endl
+		          << "       decode the given binary log files and write the messages to standard output," << std::endl
+		          << "       formatted with the given PatternFormatter pattern" << std::endl;
+		return 1;
+	}
+
+	AutoPtr<PatternFormatter> pFormatter = new PatternFormatter(pattern);
+	for (int i = first; i < argc; ++i)
+	{
+		std::ifstream istr(argv[i], std::ios::binary);
+		if (!istr)
+		{
+			std::cerr << "cannot open input file: " << argv[i] << std::endl;
+			return 2;
+		}
+		try
+		{
+			BinaryLogDecoder decoder(istr);
+			Message msg;
+			std::string text;
+			while (decoder.read(msg))
+			{
+				text.clear();
+				pFormatter->format(msg, text);
+				std::cout << text << '\n';
+			}
+		}
+		catch (Poco::Exception& exc)
+		{
+			std::cerr << argv[i] << ": " << exc.displayText() << std::endl;
+			return 3;
+		}
+	}
+	std::cout.flush();
+	return 0;
+}
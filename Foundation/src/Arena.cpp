@@ -0,0 +1,425 @@
+//
+// Arena.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Arena.h"
+#include "Poco/Bugcheck.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/AtomicPointer.h"
+#include "Poco/Mutex.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const std::size_t CHUNK_ALIGNMENT = 4096;
+		/// Chunks are aligned to and registered in
+		/// units of CHUNK_ALIGNMENT bytes ("pages").
+
+	class ChunkRegistry
+		/// Keeps track of the pages of all Arena chunks, so that
+		/// ArenaObject::operator delete can tell whether an
+		/// object has been placed in an Arena.
+		///
+		/// The address space is divided into regions of 4096 pages,
+		/// each with a bitmap of the pages belonging to a chunk.
+		/// Regions are kept in a hash table that grows by replacing
+		/// it with a larger copy. Neither regions nor replaced tables
+		/// are deleted before the registry, so they can be read
+		/// without locking; only adding and removing chunks takes
+		/// the mutex. The memory used is bounded by the address
+		/// space that has ever been used for chunks.
+	{
+	public:
+		ChunkRegistry()
+		{
+		}
+
+		~ChunkRegistry()
+		{
+			Table* pTable = _pTable.load();
+			if (pTable)
+			{
+				for (std::size_t i = 0; i < pTable->size; ++i)
+				{
+					delete pTable->pSlots[i].load();
+				}
+				delete pTable;
+			}
+			for (std::vector<Table*>::iterator it = _retired.begin(); it != _retired.end(); ++it)
+			{
+				delete *it;
+			}
+		}
+
+		void add(const char* pBegin, std::size_t size)
+			/// Registers the pages of the given chunk,
+			/// which must be aligned to CHUNK_ALIGNMENT.
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			const char* pEnd = pBegin + size;
+			const char* p = pBegin;
+			try
+			{
+				for (; p < pEnd; p += CHUNK_ALIGNMENT)
+				{
+					Region* pRegion = findRegion(p);
+					if (!pRegion) pRegion = addRegion(p);
+					setPage(*pRegion, p, true);
+				}
+			}
+			catch (...)
+			{
+				clearPages(pBegin, p);
+				throw;
+			}
+			++_count;
+		}
+
+		void remove(const char* pBegin, std::size_t size)
+			/// Unregisters the pages of the given chunk.
+		{
+			FastMutex::ScopedLock lock(_mutex);
+			clearPages(pBegin, pBegin + size);
+			--_count;
+		}
+
+		bool contains(const void* ptr) const
+			/// Returns true if the given address is within
+			/// a registered chunk. Does not lock.
+		{
+			// deleting heap objects must stay cheap
+			// as long as no Arena is in use
+			if (_count.value() == 0) return false;
+
+			const char* p = static_cast<const char*>(ptr);
+			const Region* pRegion = findRegion(p);
+			if (!pRegion) return false;
+			std::size_t page = pageIndex(*pRegion, p);
+			return (pRegion->pages[page/PAGES_PER_WORD].value() & (1 << page % PAGES_PER_WORD)) != 0;
+		}
+
+	private:
+		enum
+		{
+			PAGES_PER_REGION = 4096,
+			PAGES_PER_WORD   = 16,
+			MIN_TABLE_SIZE   = 64
+		};
+
+		struct Region
+		{
+			explicit Region(const char* base):
+				pBase(base)
+			{
+			}
+
+			const char*   pBase;
+			AtomicCounter pages[PAGES_PER_REGION/PAGES_PER_WORD];
+		};
+
+		struct Table
+		{
+			explicit Table(std::size_t n):
+				size(n),
+				pSlots(new AtomicPointer<Region>[n])
+			{
+			}
+
+			~Table()
+			{
+				delete [] pSlots;
+			}
+
+			std::size_t            size;
+			AtomicPointer<Region>* pSlots;
+		};
+
+		static const char* regionBase(const char* p)
+		{
+			const UIntPtr regionSize = static_cast<UIntPtr>(CHUNK_ALIGNMENT)*PAGES_PER_REGION;
+			return reinterpret_cast<const char*>(reinterpret_cast<UIntPtr>(p) & ~(regionSize - 1));
+		}
+
+		static std::size_t pageIndex(const Region& region, const char* p)
+		{
+			return static_cast<std::size_t>(p - region.pBase)/CHUNK_ALIGNMENT;
+		}
+
+		static std::size_t hash(const char* base, std::size_t size)
+		{
+			UIntPtr region = reinterpret_cast<UIntPtr>(base)/(static_cast<UIntPtr>(CHUNK_ALIGNMENT)*PAGES_PER_REGION);
+			return static_cast<std::size_t>(region*2654435761u) & (size - 1);
+		}
+
+		Region* findRegion(const char* p) const
+		{
+			const char* base = regionBase(p);
+			Table* pTable = _pTable.load();
+			if (!pTable) return 0;
+			for (std::size_t i = hash(base, pTable->size);; i = (i + 1) & (pTable->size - 1))
+			{
+				Region* pRegion = pTable->pSlots[i].load();
+				if (!pRegion) return 0;
+				if (pRegion->pBase == base) return pRegion;
+			}
+		}
+
+		Region* addRegion(const char* p)
+			/// Must be called with the mutex locked.
+		{
+			Table* pTable = _pTable.load();
+			if (!pTable || 2*(_regions.size() + 1) > pTable->size)
+			{
+				Table* pNewTable = new Table(pTable ? 2*pTable->size : static_cast<std::size_t>(MIN_TABLE_SIZE));
+				for (std::vector<Region*>::iterator it = _regions.begin(); it != _regions.end(); ++it)
+				{
+					insert(*pNewTable, *it);
+				}
+				try
+				{
+					_retired.reserve(_retired.size() + 1);
+				}
+				catch (...)
+				{
+					delete pNewTable;
+					throw;
+				}
+				_pTable.exchange(pNewTable);
+				if (pTable) _retired.push_back(pTable);
+				pTable = pNewTable;
+			}
+			_regions.reserve(_regions.size() + 1);
+			Region* pRegion = new Region(regionBase(p));
+			_regions.push_back(pRegion);
+			insert(*pTable, pRegion);
+			return pRegion;
+		}
+
+		static void insert(Table& table, Region* pRegion)
+		{
+			std::size_t i = hash(pRegion->pBase, table.size);
+			while (table.pSlots[i].load()) i = (i + 1) & (table.size - 1);
+			table.pSlots[i].exchange(pRegion);
+		}
+
+		static void setPage(Region& region, const char* p, bool used)
+		{
+			std::size_t page = pageIndex(region, p);
+			AtomicCounter& word = region.pages[page/PAGES_PER_WORD];
+			int mask = 1 << page % PAGES_PER_WORD;
+			word = used ? (word.value() | mask) : (word.value() & ~mask);
+		}
+
+		void clearPages(const char* pBegin, const char* pEnd)
+			/// Must be called with the mutex locked.
+		{
+			for (const char* p = pBegin; p < pEnd; p += CHUNK_ALIGNMENT)
+			{
+				Region* pRegion = findRegion(p);
+				if (pRegion) setPage(*pRegion, p, false);
+			}
+		}
+
+		AtomicPointer<Table> _pTable;
+		std::vector<Region*> _regions;
+		std::vector<Table*>  _retired;
+		AtomicCounter        _count;
+		FastMutex            _mutex;
+	};
+
+	ChunkRegistry chunkRegistry;
+}
+
+
+//
+// Arena::ScopedReset
+//
+
+
+Arena::ScopedReset::ScopedReset(Arena& arena):
+	_arena(arena),
+	_chunk(arena._current),
+	_offset(arena._offset),
+	_used(arena._used)
+{
+}
+
+
+Arena::ScopedReset::~ScopedReset()
+{
+	_arena.rewind(_chunk, _offset, _used);
+}
+
+
+//
+// Arena
+//
+
+
+Arena::Arena(std::size_t chunkSize):
+	_chunkSize(chunkSize),
+	_current(0),
+	_offset(0),
+	_used(0)
+{
+	poco_assert (chunkSize > 0);
+}
+
+
+Arena::~Arena()
+{
+	for (ChunkVec::iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		releaseChunk(*it);
+	}
+}
+
+
+char* Arena::strdup(const char* str, std::size_t length)
+{
+	char* p = static_cast<char*>(allocate(length + 1, 1));
+	std::memcpy(p, str, length);
+	p[length] = 0;
+	return p;
+}
+
+
+void Arena::reset()
+{
+	if (!_chunks.empty())
+	{
+		for (ChunkVec::iterator it = _chunks.begin() + 1; it != _chunks.end(); ++it)
+		{
+			releaseChunk(*it);
+		}
+		_chunks.resize(1);
+	}
+	_current = 0;
+	_offset  = 0;
+	_used    = 0;
+}
+
+
+std::size_t Arena::capacity() const
+{
+	std::size_t result = 0;
+	for (ChunkVec::const_iterator it = _chunks.begin(); it != _chunks.end(); ++it)
+	{
+		result += it->size;
+	}
+	return result;
+}
+
+
+void* Arena::allocateSlow(std::size_t size, std::size_t alignment)
+{
+	poco_assert_dbg (alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	// continue with a chunk retained by reset() or ScopedReset, if possible
+	while (_current + 1 < _chunks.size())
+	{
+		++_current;
+		_offset = 0;
+		char* p = _chunks[_current].pBegin;
+		std::size_t padding = (alignment - (reinterpret_cast<UIntPtr>(p) & (alignment - 1))) & (alignment - 1);
+		if (padding + size <= _chunks[_current].size)
+		{
+			_offset = padding + size;
+			_used  += padding + size;
+			return p + padding;
+		}
+	}
+
+	Chunk chunk;
+	chunk.size = size + alignment > _chunkSize ? size + alignment : _chunkSize;
+	_chunks.reserve(_chunks.size() + 1);
+
+	// align the chunk and round its registered size up to whole
+	// pages, so that no page of the chunk contains heap objects
+	std::size_t pages = (chunk.size + CHUNK_ALIGNMENT - 1)/CHUNK_ALIGNMENT;
+	chunk.pMemory = new char[pages*CHUNK_ALIGNMENT + CHUNK_ALIGNMENT - 1];
+	chunk.pBegin  = chunk.pMemory + (CHUNK_ALIGNMENT - reinterpret_cast<UIntPtr>(chunk.pMemory) % CHUNK_ALIGNMENT) % CHUNK_ALIGNMENT;
+	try
+	{
+		chunkRegistry.add(chunk.pBegin, pages*CHUNK_ALIGNMENT);
+	}
+	catch (...)
+	{
+		delete [] chunk.pMemory;
+		throw;
+	}
+	_chunks.push_back(chunk);
+	_current = _chunks.size() - 1;
+	_offset  = 0;
+	return allocate(size, alignment);
+}
+
+
+void Arena::releaseChunk(Chunk& chunk)
+{
+	std::size_t pages = (chunk.size + CHUNK_ALIGNMENT - 1)/CHUNK_ALIGNMENT;
+	chunkRegistry.remove(chunk.pBegin, pages*CHUNK_ALIGNMENT);
+	delete [] chunk.pMemory;
+}
+
+
+void Arena::rewind(std::size_t chunk, std::size_t offset, std::size_t used)
+{
+	if (chunk < _current || (chunk == _current && offset < _offset))
+	{
+		_current = chunk;
+		_offset  = offset;
+		_used    = used;
+	}
+}
+
+
+//
+// ArenaObject
+//
+
+
+void* ArenaObject::operator new(std::size_t size)
+{
+	return ::operator new(size);
+}
+
+
+void* ArenaObject::operator new(std::size_t size, Arena* pArena)
+{
+	if (pArena)
+		return pArena->allocate(size);
+	else
+		return ::operator new(size);
+}
+
+
+void ArenaObject::operator delete(void* ptr)
+{
+	if (ptr && !chunkRegistry.contains(ptr)) ::operator delete(ptr);
+}
+
+
+void ArenaObject::operator delete(void* ptr, Arena* /*pArena*/)
+{
+	ArenaObject::operator delete(ptr);
+}
+
+
+} // namespace Poco
@@ -21,11 +21,22 @@
 #include "Poco/AutoPtr.h"
 #include "Poco/LoggingRegistry.h"
 #include "Poco/Exception.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/String.h"
 
 
 namespace Poco {
 
 
+namespace
+{
+	const std::size_t NIL = static_cast<std::size_t>(-1);
+		/// Marks the end of a list of ring buffer slots.
+}
+
+
 class MessageNotification: public Notification
 {
 public:
@@ -50,10 +61,21 @@ private:
 
 AsyncChannel::AsyncChannel(Channel* pChannel, Thread::Priority prio): 
 	_pChannel(pChannel), 
-	_thread("AsyncChannel")
+	_thread("AsyncChannel"),
+	_head(NIL),
+	_tail(NIL),
+	_free(NIL),
+	_count(0),
+	_batchSize(DEFAULT_BATCH_SIZE),
+	_overflow(OVERFLOW_BLOCK),
+	_stop(false),
+	_workerWaiting(false),
+	_blocked(0),
+	_dropped(0)
 {
 	if (_pChannel) _pChannel->duplicate();
 	_thread.setPriority(prio);
+	initRing(0);
 }
 
 
@@ -98,7 +120,26 @@ void AsyncChannel::open()
 
 void AsyncChannel::close()
 {
-	if (_thread.isRunning())
+	bool ring;
+	{
+		FastMutex::ScopedLock lock(_ringMutex);
+
+		ring = !_ring.empty();
+	}
+	if (_thread.isRunning() && ring)
+	{
+		{
+			FastMutex::ScopedLock lock(_ringMutex);
+
+			_stop = true;
+			_notEmpty.signal();
+		}
+		_thread.join();
+
+		FastMutex::ScopedLock lock(_ringMutex);
+		_stop = false;
+	}
+	else if (_thread.isRunning())
 	{
 		while (!_queue.empty()) Thread::sleep(100);
 		
@@ -115,22 +156,190 @@ void AsyncChannel::log(const Message& msg)
 {
 	open();
 
+	{
+		FastMutex::ScopedLock lock(_ringMutex);
+
+		if (!_ring.empty())
+		{
+			while (_count == _ring.size())
+			{
+				if (_overflow == OVERFLOW_BLOCK && Thread::current() != &_thread)
+				{
+					++_blocked;
+					_notFull.wait(_ringMutex);
+					--_blocked;
+				}
+				else if (_overflow == OVERFLOW_DROP_LOWEST && makeRoom(msg))
+				{
+					++_dropped;
+				}
+				else
+				{
+					++_dropped;
+					return;
+				}
+			}
+			push(msg);
+			if (_workerWaiting)
+			{
+				_workerWaiting = false;
+				_notEmpty.signal();
+			}
+			return;
+		}
+	}
 	_queue.enqueueNotification(new MessageNotification(msg));
 }
 
 
+bool AsyncChannel::makeRoom(const Message& msg)
+{
+	for (int prio = Message::PRIO_TRACE; prio > msg.getPriority() && prio >= Message::PRIO_FATAL; --prio)
+	{
+		if (_prioHead[prio] != NIL)
+		{
+			remove(_prioHead[prio]);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void AsyncChannel::initRing(std::size_t size)
+{
+	MessageVec ring(size);
+	LinkVec links(size);
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		links[i].next = i + 1 < size ? i + 1 : NIL;
+	}
+	_ring.swap(ring);
+	_links.swap(links);
+	_head  = NIL;
+	_tail  = NIL;
+	_free  = size > 0 ? 0 : NIL;
+	_count = 0;
+	for (int prio = 0; prio <= Message::PRIO_TRACE; ++prio)
+	{
+		_prioHead[prio] = NIL;
+		_prioTail[prio] = NIL;
+	}
+}
+
+
+void AsyncChannel::push(const Message& msg)
+{
+	std::size_t slot = _free;
+	_ring[slot].assign(msg);
+	_free = _links[slot].next;
+
+	int prio = msg.getPriority();
+	if (prio < Message::PRIO_FATAL) prio = Message::PRIO_FATAL;
+	else if (prio > Message::PRIO_TRACE) prio = Message::PRIO_TRACE;
+
+	Link& link = _links[slot];
+	link.prev     = _tail;
+	link.next     = NIL;
+	link.nextSame = NIL;
+	link.prio     = prio;
+	if (_tail != NIL)
+		_links[_tail].next = slot;
+	else
+		_head = slot;
+	_tail = slot;
+	if (_prioTail[prio] != NIL)
+		_links[_prioTail[prio]].nextSame = slot;
+	else
+		_prioHead[prio] = slot;
+	_prioTail[prio] = slot;
+	++_count;
+}
+
+
+void AsyncChannel::remove(std::size_t slot)
+{
+	// slot must be the oldest message with its priority,
+	// which is always the case for the oldest message overall
+	Link& link = _links[slot];
+	if (link.prev != NIL)
+		_links[link.prev].next = link.next;
+	else
+		_head = link.next;
+	if (link.next != NIL)
+		_links[link.next].prev = link.prev;
+	else
+		_tail = link.prev;
+	_prioHead[link.prio] = link.nextSame;
+	if (link.nextSame == NIL) _prioTail[link.prio] = NIL;
+	link.next = _free;
+	_free = slot;
+	--_count;
+}
+
+
+Poco::UInt64 AsyncChannel::dropped() const
+{
+	FastMutex::ScopedLock lock(_ringMutex);
+
+	return _dropped;
+}
+
+
 void AsyncChannel::setProperty(const std::string& name, const std::string& value)
 {
 	if (name == "channel")
 		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
 	else if (name == "priority")
 		setPriority(value);
+	else if (name == "queueSize")
+		setQueueSize(value);
+	else if (name == "batchSize")
+		setBatchSize(value);
+	else if (name == "overflow")
+		setOverflow(value);
 	else
 		Channel::setProperty(name, value);
 }
 
 
+std::string AsyncChannel::getProperty(const std::string& name) const
+{
+	if (name == "queueSize")
+	{
+		FastMutex::ScopedLock lock(_ringMutex);
+
+		return NumberFormatter::format(_ring.size());
+	}
+	else if (name == "batchSize")
+		return NumberFormatter::format(_batchSize);
+	else if (name == "overflow")
+	{
+		switch (_overflow)
+		{
+		case OVERFLOW_DROP:
+			return "drop";
+		case OVERFLOW_DROP_LOWEST:
+			return "dropLowest";
+		default:
+			return "block";
+		}
+	}
+	else
+		return Channel::getProperty(name);
+}
+
+
 void AsyncChannel::run()
+{
+	if (_ring.empty())
+		runQueue();
+	else
+		runRing();
+}
+
+
+void AsyncChannel::runQueue()
 {
 	AutoPtr<Notification> nf = _queue.waitDequeueNotification();
 	while (nf)
@@ -144,6 +353,54 @@ void AsyncChannel::run()
 		nf = _queue.waitDequeueNotification();
 	}
 }
+
+
+void AsyncChannel::runRing()
+{
+	for (;;)
+	{
+		std::size_t n = 0;
+		{
+			FastMutex::ScopedLock lock(_ringMutex);
+
+			while (_count == 0 && !_stop)
+			{
+				_workerWaiting = true;
+				_notEmpty.wait(_ringMutex);
+			}
+			_workerWaiting = false;
+			if (_count == 0) break;
+
+			n = _count < _batchSize ? _count : _batchSize;
+			if (_batch.size() < n) _batch.resize(_batchSize);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				std::size_t slot = _head;
+				_batch[i].swap(_ring[slot]);
+				remove(slot);
+			}
+			if (_blocked) _notFull.broadcast();
+		}
+		try
+		{
+			FastMutex::ScopedLock lock(_channelMutex);
+
+			if (_pChannel) _pChannel->logBatch(&_batch[0], n);
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
 		
 		
 void AsyncChannel::setPriority(const std::string& value)
@@ -167,4 +424,47 @@ void AsyncChannel::setPriority(const std::string& value)
 }
 
 
+
+void AsyncChannel::setQueueSize(const std::string& value)
+{
+	int size = NumberParser::parse(value);
+	if (size < 0) throw InvalidArgumentException("queueSize", value);
+
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (_thread.isRunning()) throw IllegalStateException("Cannot change the queue size of an open AsyncChannel");
+
+	FastMutex::ScopedLock ringLock(_ringMutex);
+	initRing(size);
+}
+
+
+void AsyncChannel::setBatchSize(const std::string& value)
+{
+	int size = NumberParser::parse(value);
+	if (size < 1) throw InvalidArgumentException("batchSize", value);
+
+	FastMutex::ScopedLock lock(_ringMutex);
+	_batchSize = size;
+}
+
+
+void AsyncChannel::setOverflow(const std::string& value)
+{
+	OverflowPolicy overflow;
+	if (icompare(value, "block") == 0)
+		overflow = OVERFLOW_BLOCK;
+	else if (icompare(value, "drop") == 0)
+		overflow = OVERFLOW_DROP;
+	else if (icompare(value, "dropLowest") == 0)
+		overflow = OVERFLOW_DROP_LOWEST;
+	else
+		throw InvalidArgumentException("overflow", value);
+
+	FastMutex::ScopedLock lock(_ringMutex);
+	_overflow = overflow;
+	if (_blocked) _notFull.broadcast();
+}
+
+
 } // namespace Poco
@@ -17,42 +17,39 @@
 #include "Poco/Base32Decoder.h"
 #include "Poco/Base32Encoder.h"
 #include "Poco/Exception.h"
-#include "Poco/Mutex.h"
 #include <cstring>
 
 
 namespace Poco {
 
 
-unsigned char Base32DecoderBuf::IN_ENCODING[256];
-bool Base32DecoderBuf::IN_ENCODING_INIT = false;
-
-
-namespace
+const unsigned char Base32DecoderBuf::IN_ENCODING[256] =
 {
-	static FastMutex mutex;
-}
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
 
 
 Base32DecoderBuf::Base32DecoderBuf(std::istream& istr): 
 	_groupLength(0),
 	_groupIndex(0),
-	_buf(*istr.rdbuf())
+	_buf(*istr.rdbuf()),
+	_eof(false)
 {
-	FastMutex::ScopedLock lock(mutex);
-	if (!IN_ENCODING_INIT)
-	{
-		for (unsigned i = 0; i < sizeof(IN_ENCODING); i++)
-		{
-			IN_ENCODING[i] = 0xFF;
-		}
-		for (unsigned i = 0; i < sizeof(Base32EncoderBuf::OUT_ENCODING); i++)
-		{
-			IN_ENCODING[Base32EncoderBuf::OUT_ENCODING[i]] = i;
-		}
-		IN_ENCODING[static_cast<unsigned char>('=')] = '\0';
-		IN_ENCODING_INIT = true;
-	}
 }
 
 
@@ -103,22 +100,7 @@ int Base32DecoderBuf::readFromDevice()
 			if (IN_ENCODING[buffer[7]] == 0xFF) throw DataFormatException();
 		} while (false);
 
-		_group[0] = (IN_ENCODING[buffer[0]] << 3) | (IN_ENCODING[buffer[1]] >> 2);
-		_group[1] = ((IN_ENCODING[buffer[1]] & 0x03) << 6) | (IN_ENCODING[buffer[2]] << 1) | (IN_ENCODING[buffer[3]] >> 4);
-		_group[2] = ((IN_ENCODING[buffer[3]] & 0x0F) << 4) | (IN_ENCODING[buffer[4]] >> 1);
-		_group[3] = ((IN_ENCODING[buffer[4]] & 0x01) << 7) | (IN_ENCODING[buffer[5]] << 2) | (IN_ENCODING[buffer[6]] >> 3);
-		_group[4] = ((IN_ENCODING[buffer[6]] & 0x07) << 5) | IN_ENCODING[buffer[7]];
-
-		if (buffer[2] == '=')
-			_groupLength = 1;
-		else if (buffer[4] == '=') 
-			_groupLength = 2;
-		else if (buffer[5] == '=') 
-			_groupLength = 3;
-		else if (buffer[7] == '=') 
-			_groupLength = 4;
-		else
-			_groupLength = 5;
+		_groupLength = decodeGroup(buffer, _group);
 		_groupIndex = 1;
 		return _group[0];
 	}
@@ -127,11 +109,132 @@ int Base32DecoderBuf::readFromDevice()
 
 int Base32DecoderBuf::readOne()
 {
+	if (_eof) return std::char_traits<char>::eof();
 	int ch = _buf.sbumpc();
+	if (ch == std::char_traits<char>::eof()) _eof = true;
 	return ch;
 }
 
 
+std::streamsize Base32DecoderBuf::xsgetn(char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+
+	// uflow() also returns a character put back with sungetc().
+	int c = uflow();
+	if (c == eof) return 0;
+	std::streamsize copied = 0;
+	s[copied++] = static_cast<char>(c);
+	while (copied < count && _groupIndex < _groupLength)
+	{
+		s[copied++] = static_cast<char>(_group[_groupIndex++]);
+	}
+
+	// Never request more characters from the connected stream
+	// than needed for the remaining bytes.
+	char buffer[4096];
+	while (!_eof && count - copied >= 5)
+	{
+		std::streamsize request = (count - copied)/5*8;
+		if (request > static_cast<std::streamsize>(sizeof(buffer))) request = sizeof(buffer);
+		std::streamsize n = _buf.sgetn(buffer, request);
+		if (n < request) _eof = true;
+		if (n <= 0) break;
+		std::size_t groups = static_cast<std::size_t>(n)/8;
+		copied += decodeGroups(reinterpret_cast<unsigned char*>(buffer), groups, reinterpret_cast<unsigned char*>(s + copied));
+		int length = static_cast<int>(n - 8*groups);
+		if (length > 0)
+		{
+			unsigned char group[8];
+			std::memcpy(group, buffer + 8*groups, length);
+			while (length < 8 && (c = readOne()) != eof)
+			{
+				group[length++] = static_cast<unsigned char>(c);
+			}
+			_groupLength = decodeLastGroup(group, length, _group);
+			_groupIndex = 0;
+			while (copied < count && _groupIndex < _groupLength)
+			{
+				s[copied++] = static_cast<char>(_group[_groupIndex++]);
+			}
+			break;
+		}
+	}
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == eof) break;
+		s[copied++] = static_cast<char>(c);
+	}
+	return copied;
+}
+
+
+int Base32DecoderBuf::decodeGroup(const unsigned char* group, unsigned char* buffer)
+{
+	unsigned char v[8];
+	for (int i = 0; i < 8; ++i) v[i] = IN_ENCODING[group[i]] & 0x1F;
+	buffer[0] = (v[0] << 3) | (v[1] >> 2);
+	if (group[2] == '=') return 1;
+	buffer[1] = ((v[1] & 0x03) << 6) | (v[2] << 1) | (v[3] >> 4);
+	if (group[4] == '=') return 2;
+	buffer[2] = ((v[3] & 0x0F) << 4) | (v[4] >> 1);
+	if (group[5] == '=') return 3;
+	buffer[3] = ((v[4] & 0x01) << 7) | (v[5] << 2) | (v[6] >> 3);
+	if (group[7] == '=') return 4;
+	buffer[4] = ((v[6] & 0x07) << 5) | v[7];
+	return 5;
+}
+
+
+int Base32DecoderBuf::decodeLastGroup(unsigned char* group, int length, unsigned char* buffer)
+{
+	// per RFC-4648, Section 6, permissible block lengths are:
+	// 2, 4, 5, 7, and 8 bytes. Any other length is malformed.
+	if (length == 1 || length == 3 || length == 6) throw DataFormatException();
+	for (int i = 0; i < length; ++i)
+	{
+		if (IN_ENCODING[group[i]] == 0xFF) throw DataFormatException();
+	}
+	std::memset(group + length, '=', 8 - length);
+	return decodeGroup(group, buffer);
+}
+
+
+std::size_t Base32DecoderBuf::decodeGroups(const unsigned char* data, std::size_t groups, unsigned char* buffer)
+{
+	unsigned char* out = buffer;
+	while (groups-- > 0)
+	{
+		unsigned v[8];
+		unsigned all = 0;
+		for (int i = 0; i < 8; ++i)
+		{
+			v[i] = IN_ENCODING[data[i]];
+			all |= v[i];
+		}
+		if (all < 0x20)
+		{
+			out[0] = static_cast<unsigned char>((v[0] << 3) | (v[1] >> 2));
+			out[1] = static_cast<unsigned char>((v[1] << 6) | (v[2] << 1) | (v[3] >> 4));
+			out[2] = static_cast<unsigned char>((v[3] << 4) | (v[4] >> 1));
+			out[3] = static_cast<unsigned char>((v[4] << 7) | (v[5] << 2) | (v[6] >> 3));
+			out[4] = static_cast<unsigned char>((v[6] << 5) | v[7]);
+			out += 5;
+		}
+		else
+		{
+			if (all == 0xFF) throw DataFormatException();
+			out += decodeGroup(data, out);
+		}
+		data += 8;
+	}
+	return static_cast<std::size_t>(out - buffer);
+}
+
+
 Base32DecoderIOS::Base32DecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -159,4 +262,27 @@ Base32Decoder::~Base32Decoder()
 }
 
 
+std::size_t Base32Decoder::decodedLength(std::size_t length)
+{
+	return (length + 7)/8*5;
+}
+
+
+std::size_t Base32Decoder::decode(const char* data, std::size_t length, char* buffer)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+	unsigned char* out = reinterpret_cast<unsigned char*>(buffer);
+	std::size_t groups = length/8;
+	std::size_t n = Base32DecoderBuf::decodeGroups(in, groups, out);
+	int rest = static_cast<int>(length - 8*groups);
+	if (rest > 0)
+	{
+		unsigned char group[8];
+		std::memcpy(group, in + 8*groups, rest);
+		n += Base32DecoderBuf::decodeLastGroup(group, rest, out + n);
+	}
+	return n;
+}
+
+
 } // namespace Poco
@@ -50,6 +50,54 @@ Base32EncoderBuf::~Base32EncoderBuf()
 
 
 
+void Base32EncoderBuf::encodeGroups(const unsigned char* data, std::size_t groups, char* buffer)
+{
+	while (groups-- > 0)
+	{
+		buffer[0] = OUT_ENCODING[data[0] >> 3];
+		buffer[1] = OUT_ENCODING[((data[0] & 0x07) << 2) | (data[1] >> 6)];
+		buffer[2] = OUT_ENCODING[(data[1] & 0x3E) >> 1];
+		buffer[3] = OUT_ENCODING[((data[1] & 0x01) << 4) | (data[2] >> 4)];
+		buffer[4] = OUT_ENCODING[((data[2] & 0x0F) << 1) | (data[3] >> 7)];
+		buffer[5] = OUT_ENCODING[(data[3] & 0x7C) >> 2];
+		buffer[6] = OUT_ENCODING[((data[3] & 0x03) << 3) | (data[4] >> 5)];
+		buffer[7] = OUT_ENCODING[data[4] & 0x1F];
+		data   += 5;
+		buffer += 8;
+	}
+}
+
+
+std::streamsize Base32EncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	std::streamsize written = 0;
+	while (_groupLength > 0 && written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+
+	char buffer[4096];
+	while (count - written >= 5)
+	{
+		std::size_t groups = static_cast<std::size_t>(count - written)/5;
+		if (groups > sizeof(buffer)/8) groups = sizeof(buffer)/8;
+		encodeGroups(reinterpret_cast<const unsigned char*>(s + written), groups, buffer);
+		if (_buf.sputn(buffer, 8*groups) != static_cast<std::streamsize>(8*groups)) return written;
+		written += 5*groups;
+	}
+
+	while (written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+	return written;
+}
+
+
 int Base32EncoderBuf::writeToDevice(char c)
 {
 	static const int eof = std::char_traits<char>::eof();
@@ -201,4 +249,40 @@ Base32Encoder::~Base32Encoder()
 }
 
 
+std::size_t Base32Encoder::encodedLength(std::size_t length, bool padding)
+{
+	if (padding)
+		return (length + 4)/5*8;
+	else
+		return (8*length + 4)/5;
+}
+
+
+std::size_t Base32Encoder::encode(const char* data, std::size_t length, char* buffer, bool padding)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+	std::size_t groups = length/5;
+	Base32EncoderBuf::encodeGroups(in, groups, buffer);
+	in     += 5*groups;
+	buffer += 8*groups;
+	std::size_t rest = length - 5*groups;
+	if (rest > 0)
+	{
+		unsigned char group[5] = {0, 0, 0, 0, 0};
+		for (std::size_t i = 0; i < rest; ++i) group[i] = in[i];
+		char chars[8];
+		Base32EncoderBuf::encodeGroups(group, 1, chars);
+		std::size_t n = (8*rest + 4)/5;
+		for (std::size_t i = 0; i < 8; ++i)
+		{
+			if (i < n)
+				buffer[i] = chars[i];
+			else if (padding)
+				buffer[i] = '=';
+		}
+	}
+	return encodedLength(length, padding);
+}
+
+
 } // namespace Poco
@@ -17,41 +17,88 @@
 #include "Poco/Base64Decoder.h"
 #include "Poco/Base64Encoder.h"
 #include "Poco/Exception.h"
-#include "Poco/Mutex.h"
+#include "Poco/CPUFeatures.h"
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <tmmintrin.h>
+#endif
 
 
 namespace Poco {
 
 
-unsigned char Base64DecoderBuf::IN_ENCODING[256];
-bool Base64DecoderBuf::IN_ENCODING_INIT = false;
+const unsigned char Base64DecoderBuf::IN_ENCODING[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0xFF, 0xFF, 0x80, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0x40, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
 
 
 namespace
 {
-	static FastMutex mutex;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	POCO_TARGET_ISA("ssse3")
+	void decodeSSSE3(const unsigned char*& data, const unsigned char* end, unsigned char*& buffer)
+		/// Decodes 16 characters at a time, until fewer than 16
+		/// characters are left or a block contains a character
+		/// other than A-Z, a-z, 0-9, + and /, using the
+		/// validation and translation technique from the base64
+		/// library by Alfred Klomp.
+	{
+		const __m128i lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+			0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i mask2F = _mm_set1_epi8(0x2F);
+		const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		while (end - data >= 16)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			__m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+			__m128i loNibbles = _mm_and_si128(in, mask2F);
+			__m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+			__m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) break;
+
+			__m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(in, mask2F), hiNibbles));
+			in = _mm_add_epi8(in, roll);
+			in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+			in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+			in = _mm_shuffle_epi8(in, shuffle);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(buffer), in);
+			int last = _mm_cvtsi128_si32(_mm_srli_si128(in, 8));
+			std::memcpy(buffer + 8, &last, 4);
+
+			data   += 16;
+			buffer += 12;
+		}
+	}
+#endif
 }
 
 
 Base64DecoderBuf::Base64DecoderBuf(std::istream& istr): 
 	_groupLength(0),
 	_groupIndex(0),
-	_buf(*istr.rdbuf())
+	_buf(*istr.rdbuf()),
+	_eof(false)
 {
-	FastMutex::ScopedLock lock(mutex);
-	if (!IN_ENCODING_INIT)
-	{
-		for (unsigned i = 0; i < sizeof(IN_ENCODING); i++)
-		{
-			IN_ENCODING[i] = 0xFF;
-		}
-		for (unsigned i = 0; i < sizeof(Base64EncoderBuf::OUT_ENCODING); i++)
-		{
-			IN_ENCODING[Base64EncoderBuf::OUT_ENCODING[i]] = i;
-		}
-		IN_ENCODING[static_cast<unsigned char>('=')] = '\0';
-		IN_ENCODING_INIT = true;
-	}
 }
 
 
@@ -83,16 +130,7 @@ int Base64DecoderBuf::readFromDevice()
 		buffer[3] = c;
 		if (IN_ENCODING[buffer[3]] == 0xFF) throw DataFormatException();
 		
-		_group[0] = (IN_ENCODING[buffer[0]] << 2) | (IN_ENCODING[buffer[1]] >> 4);
-		_group[1] = ((IN_ENCODING[buffer[1]] & 0x0F) << 4) | (IN_ENCODING[buffer[2]] >> 2);
-		_group[2] = (IN_ENCODING[buffer[2]] << 6) | IN_ENCODING[buffer[3]];
-
-		if (buffer[2] == '=')
-			_groupLength = 1;
-		else if (buffer[3] == '=') 
-			_groupLength = 2;
-		else
-			_groupLength = 3;
+		_groupLength = decodeGroup(buffer, _group);
 		_groupIndex = 1;
 		return _group[0];
 	}
@@ -101,13 +139,133 @@ int Base64DecoderBuf::readFromDevice()
 
 int Base64DecoderBuf::readOne()
 {
+	if (_eof) return std::char_traits<char>::eof();
 	int ch = _buf.sbumpc();
 	while (ch == ' ' || ch == '\r' || ch == '\t' || ch == '\n')
 		ch = _buf.sbumpc();
+	if (ch == std::char_traits<char>::eof()) _eof = true;
 	return ch;
 }
 
 
+std::streamsize Base64DecoderBuf::xsgetn(char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+
+	// uflow() also returns a character put back with sungetc().
+	int c = uflow();
+	if (c == eof) return 0;
+	std::streamsize copied = 0;
+	s[copied++] = static_cast<char>(c);
+	while (copied < count && _groupIndex < _groupLength)
+	{
+		s[copied++] = static_cast<char>(_group[_groupIndex++]);
+	}
+
+	// Never request more characters from the connected stream
+	// than needed for the remaining bytes, even if the input
+	// contains no whitespace.
+	char buffer[4096];
+	unsigned char carry[4];
+	int carryLength = 0;
+	while (!_eof && count - copied >= 3)
+	{
+		std::streamsize request = (count - copied)/3*4 - carryLength;
+		if (request > static_cast<std::streamsize>(sizeof(buffer))) request = sizeof(buffer);
+		std::streamsize n = _buf.sgetn(buffer, request);
+		if (n < request) _eof = true;
+		if (n <= 0) break;
+		copied += decodeBlock(reinterpret_cast<unsigned char*>(buffer), static_cast<std::size_t>(n), reinterpret_cast<unsigned char*>(s + copied), carry, carryLength);
+	}
+	if (carryLength > 0)
+	{
+		while (carryLength < 4)
+		{
+			c = readOne();
+			if (c == eof || IN_ENCODING[static_cast<unsigned char>(c)] == 0xFF) throw DataFormatException();
+			carry[carryLength++] = static_cast<unsigned char>(c);
+		}
+		_groupLength = decodeGroup(carry, _group);
+		_groupIndex = 0;
+		while (copied < count && _groupIndex < _groupLength)
+		{
+			s[copied++] = static_cast<char>(_group[_groupIndex++]);
+		}
+	}
+	while (copied < count)
+	{
+		c = uflow();
+		if (c == eof) break;
+		s[copied++] = static_cast<char>(c);
+	}
+	return copied;
+}
+
+
+int Base64DecoderBuf::decodeGroup(const unsigned char* group, unsigned char* buffer)
+{
+	unsigned char a = IN_ENCODING[group[0]] & 0x3F;
+	unsigned char b = IN_ENCODING[group[1]] & 0x3F;
+	unsigned char c = IN_ENCODING[group[2]] & 0x3F;
+	unsigned char d = IN_ENCODING[group[3]] & 0x3F;
+	buffer[0] = (a << 2) | (b >> 4);
+	if (group[2] == '=') return 1;
+	buffer[1] = ((b & 0x0F) << 4) | (c >> 2);
+	if (group[3] == '=') return 2;
+	buffer[2] = (c << 6) | d;
+	return 3;
+}
+
+
+std::size_t Base64DecoderBuf::decodeBlock(const unsigned char* data, std::size_t length, unsigned char* buffer, unsigned char* carry, int& carryLength)
+{
+	const unsigned char* end = data + length;
+	unsigned char* out = buffer;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	bool ssse3 = length >= 16 && CPUFeatures::hasSSSE3();
+#endif
+	while (data < end)
+	{
+		if (carryLength == 0)
+		{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+			if (ssse3) decodeSSSE3(data, end, out);
+#endif
+			while (end - data >= 4)
+			{
+				unsigned a = IN_ENCODING[data[0]];
+				unsigned b = IN_ENCODING[data[1]];
+				unsigned c = IN_ENCODING[data[2]];
+				unsigned d = IN_ENCODING[data[3]];
+				if ((a | b | c | d) >= 0x40) break;
+				out[0] = static_cast<unsigned char>((a << 2) | (b >> 4));
+				out[1] = static_cast<unsigned char>((b << 4) | (c >> 2));
+				out[2] = static_cast<unsigned char>((c << 6) | d);
+				data += 4;
+				out  += 3;
+			}
+			if (data == end) break;
+		}
+		// whitespace, padding or an incomplete group
+		unsigned char ch = *data++;
+		unsigned char value = IN_ENCODING[ch];
+		if (value == 0xFF) throw DataFormatException();
+		if (value != 0x80)
+		{
+			carry[carryLength++] = ch;
+			if (carryLength == 4)
+			{
+				out += decodeGroup(carry, out);
+				carryLength = 0;
+			}
+		}
+	}
+	return static_cast<std::size_t>(out - buffer);
+}
+
+
 Base64DecoderIOS::Base64DecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -135,4 +293,20 @@ Base64Decoder::~Base64Decoder()
 }
 
 
+std::size_t Base64Decoder::decodedLength(std::size_t length)
+{
+	return length/4*3;
+}
+
+
+std::size_t Base64Decoder::decode(const char* data, std::size_t length, char* buffer)
+{
+	unsigned char carry[4];
+	int carryLength = 0;
+	std::size_t n = Base64DecoderBuf::decodeBlock(reinterpret_cast<const unsigned char*>(data), length, reinterpret_cast<unsigned char*>(buffer), carry, carryLength);
+	if (carryLength > 0) throw DataFormatException();
+	return n;
+}
+
+
 } // namespace Poco
@@ -15,11 +15,54 @@
 
 
 #include "Poco/Base64Encoder.h"
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <tmmintrin.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	POCO_TARGET_ISA("ssse3")
+	void encodeSSSE3(const unsigned char*& data, std::size_t& groups, char*& buffer)
+		/// Encodes 4 groups (12 bytes) at a time, as long as at least
+		/// 16 bytes of input are available, using the multiply-shift
+		/// technique described by Wojciech Mula and the
+		/// range-based translation from the base64 library by
+		/// Alfred Klomp.
+	{
+		const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m128i shiftLUT = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		while (groups >= 6)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			in = _mm_shuffle_epi8(in, shuffle);
+			__m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+			__m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+			__m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+			__m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+			__m128i indices = _mm_or_si128(t1, t3);
+
+			__m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+			__m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+			result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+			result = _mm_add_epi8(_mm_shuffle_epi8(shiftLUT, result), indices);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), result);
+
+			data   += 12;
+			buffer += 16;
+			groups -= 4;
+		}
+	}
+#endif
+}
+
+
 const unsigned char Base64EncoderBuf::OUT_ENCODING[64] =
 {
 	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
@@ -66,6 +109,80 @@ int Base64EncoderBuf::getLineLength() const
 }
 
 
+void Base64EncoderBuf::encodeGroups(const unsigned char* data, std::size_t groups, char* buffer)
+{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (groups >= 6 && CPUFeatures::hasSSSE3())
+	{
+		encodeSSSE3(data, groups, buffer);
+	}
+#endif
+	while (groups-- > 0)
+	{
+		buffer[0] = OUT_ENCODING[data[0] >> 2];
+		buffer[1] = OUT_ENCODING[((data[0] & 0x03) << 4) | (data[1] >> 4)];
+		buffer[2] = OUT_ENCODING[((data[1] & 0x0F) << 2) | (data[2] >> 6)];
+		buffer[3] = OUT_ENCODING[data[2] & 0x3F];
+		data   += 3;
+		buffer += 4;
+	}
+}
+
+
+std::streamsize Base64EncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	std::streamsize written = 0;
+	while (_groupLength > 0 && written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+
+	char buffer[4096];
+	std::size_t length = 0;
+	std::streamsize flushed = written;
+	while (count - written >= 3)
+	{
+		std::size_t groups = static_cast<std::size_t>(count - written)/3;
+		if (_lineLength > 0)
+		{
+			std::size_t lineGroups = _pos < _lineLength ? (_lineLength - _pos + 3)/4 : 1;
+			if (groups > lineGroups) groups = lineGroups;
+		}
+		if (length + 4 + 2 > sizeof(buffer))
+		{
+			if (_buf.sputn(buffer, length) != static_cast<std::streamsize>(length)) return flushed;
+			flushed = written;
+			length = 0;
+		}
+		if (groups > (sizeof(buffer) - length - 2)/4)
+		{
+			groups = (sizeof(buffer) - length - 2)/4;
+		}
+		encodeGroups(reinterpret_cast<const unsigned char*>(s + written), groups, buffer + length);
+		length  += 4*groups;
+		written += 3*groups;
+		_pos    += 4*static_cast<int>(groups);
+		if (_lineLength > 0 && _pos >= _lineLength)
+		{
+			buffer[length++] = '\r';
+			buffer[length++] = '\n';
+			_pos = 0;
+		}
+	}
+	if (length > 0 && _buf.sputn(buffer, length) != static_cast<std::streamsize>(length)) return flushed;
+
+	while (written < count)
+	{
+		if (writeToDevice(s[written]) == eof) return written;
+		++written;
+	}
+	return written;
+}
+
+
 int Base64EncoderBuf::writeToDevice(char c)
 {
 	static const int eof = std::char_traits<char>::eof();
@@ -161,4 +278,31 @@ Base64Encoder::~Base64Encoder()
 }
 
 
+std::size_t Base64Encoder::encodedLength(std::size_t length)
+{
+	return (length + 2)/3*4;
+}
+
+
+std::size_t Base64Encoder::encode(const char* data, std::size_t length, char* buffer)
+{
+	const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+	std::size_t groups = length/3;
+	Base64EncoderBuf::encodeGroups(in, groups, buffer);
+	in     += 3*groups;
+	buffer += 4*groups;
+	std::size_t rest = length - 3*groups;
+	if (rest > 0)
+	{
+		unsigned char group[3] = {0, 0, 0};
+		group[0] = in[0];
+		if (rest > 1) group[1] = in[1];
+		Base64EncoderBuf::encodeGroups(group, 1, buffer);
+		buffer[3] = '=';
+		if (rest == 1) buffer[2] = '=';
+	}
+	return encodedLength(length);
+}
+
+
 } // namespace Poco
@@ -0,0 +1,274 @@
+//
+// BinaryFileChannel.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryFileChannel
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/LogRecord.h"
+#include "Poco/LogFile.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char* const TEXT_FORMAT = "%s";
+	const char MAGIC[] = "PLOG";
+}
+
+
+template <typename T>
+inline void BinaryFileChannel::appendValue(T value)
+{
+	_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+BinaryFileChannel::BinaryFileChannel()
+{
+}
+
+
+BinaryFileChannel::BinaryFileChannel(const std::string& rPath):
+	FileChannel(rPath)
+{
+}
+
+
+BinaryFileChannel::~BinaryFileChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+	for (int i = 0; i < CACHE_SIZE; ++i)
+	{
+		delete _cache[i].load();
+	}
+}
+
+
+void BinaryFileChannel::log(const Message& msg)
+{
+	const std::string& text = msg.getText();
+	char prefix[1 + sizeof(UInt32)];
+	prefix[0] = static_cast<char>(LogRecord::ARG_STRING);
+	UInt32 length = static_cast<UInt32>(text.size());
+	std::memcpy(prefix + 1, &length, sizeof(length));
+	// the address of a Message's source changes with every
+	// message, so the source is looked up by its value
+	write(TEXT_FORMAT, TEXT_FORMAT, 2, 0, msg.getSource(), msg.getPriority(), msg.getTime(), msg.getTid(), prefix, sizeof(prefix), text.data(), text.size());
+}
+
+
+void BinaryFileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		log(pMessages[i]);
+	}
+}
+
+
+void BinaryFileChannel::logRecord(const LogRecord& record)
+{
+	write(record.getFormat(), record.getFormat(), std::strlen(record.getFormat()), &record.getSource(), record.getSource(), record.getPriority(), record.getTime(), record.getTid(), 0, 0, record.data(), record.size());
+}
+
+
+void BinaryFileChannel::fileOpened(LogFile& file)
+{
+	FastMutex::ScopedLock lock(_stringsMutex);
+
+	_definitions.clear();
+	_definitions += static_cast<char>(ENTRY_HEADER);
+	_definitions.append(MAGIC, 4);
+	_definitions += static_cast<char>(VERSION);
+	UInt16 bom = BYTE_ORDER_MARK;
+	_definitions.append(reinterpret_cast<const char*>(&bom), sizeof(bom));
+	for (UInt32 id = 0; id < _strings.size(); ++id)
+	{
+		const std::string& str = _strings[id];
+		_definitions += static_cast<char>(ENTRY_DEFINITION);
+		_definitions.append(reinterpret_cast<const char*>(&id), sizeof(id));
+		UInt32 length = static_cast<UInt32>(str.size());
+		_definitions.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		_definitions.append(str);
+	}
+	file.writeData(_definitions.data(), _definitions.size(), false);
+}
+
+
+void BinaryFileChannel::write(const void* formatKey, const char* format, std::size_t formatLength, const void* sourceKey, const std::string& source, Message::Priority prio, const Timestamp& time, long tid, const char* prefix, std::size_t prefixLength, const char* args, std::size_t argsLength)
+{
+	std::size_t argsSize = prefixLength + argsLength;
+	UInt32 formatId;
+	UInt32 sourceId;
+	if (findCached(formatKey, format, formatLength, formatId) && findCached(sourceKey, source.data(), source.size(), sourceId))
+	{
+		// Both strings have already been written to the log file,
+		// so the record can be written without the channel's lock.
+		char stackBuffer[STACK_BUFFER_SIZE];
+		std::string heapBuffer;
+		std::size_t size = RECORD_HEADER_SIZE + argsSize;
+		char* pBuffer = stackBuffer;
+		if (size > sizeof(stackBuffer))
+		{
+			heapBuffer.resize(size);
+			pBuffer = &heapBuffer[0];
+		}
+		writeRecordHeader(pBuffer, formatId, sourceId, prio, time, tid, argsSize);
+		if (prefixLength) std::memcpy(pBuffer + RECORD_HEADER_SIZE, prefix, prefixLength);
+		if (argsLength) std::memcpy(pBuffer + RECORD_HEADER_SIZE + prefixLength, args, argsLength);
+		logData(pBuffer, size);
+		return;
+	}
+
+	// The lock is held until the definitions of new strings
+	// have been written, so that no other thread can write a
+	// record referring to a string before its definition.
+	FastMutex::ScopedLock lock(_mutex);
+
+	_buffer.clear();
+	formatId = lookup(format, formatLength);
+	sourceId = lookup(source.data(), source.size());
+	char header[RECORD_HEADER_SIZE];
+	writeRecordHeader(header, formatId, sourceId, prio, time, tid, argsSize);
+	_buffer.append(header, RECORD_HEADER_SIZE);
+	_buffer.append(prefix, prefixLength);
+	_buffer.append(args, argsLength);
+	logData(_buffer.data(), _buffer.size());
+	cache(formatKey, format, formatLength, formatId);
+	cache(sourceKey, source.data(), source.size(), sourceId);
+}
+
+
+UInt32 BinaryFileChannel::lookup(const char* str, std::size_t length)
+{
+	std::string value(str, length);
+	StringMap::const_iterator it = _idsByString.find(value);
+	if (it != _idsByString.end()) return it->second;
+
+	UInt32 id;
+	{
+		// fileOpened() reads the strings with only
+		// the FileChannel's lock held
+		FastMutex::ScopedLock lock(_stringsMutex);
+
+		id = static_cast<UInt32>(_strings.size());
+		_strings.push_back(value);
+		try
+		{
+			_idsByString[value] = id;
+		}
+		catch (...)
+		{
+			_strings.pop_back();
+			throw;
+		}
+	}
+	appendDefinition(id, value);
+	return id;
+}
+
+
+bool BinaryFileChannel::findCached(const void* key, const char* str, std::size_t length, UInt32& id) const
+{
+	// The address of a string may later be used for a different
+	// string (e.g., a new Logger's name), so the string is compared
+	// as well.
+	const CacheEntry* pEntry = _cache[slot(key, str, length)].load();
+	if (pEntry && pEntry->key == key && pEntry->str.size() == length && std::memcmp(pEntry->str.data(), str, length) == 0)
+	{
+		id = pEntry->id;
+		return true;
+	}
+	return false;
+}
+
+
+void BinaryFileChannel::cache(const void* key, const char* str, std::size_t length, UInt32 id)
+{
+	// Entries are never replaced, as a reader may still use them.
+	// Strings whose slot is taken are looked up with the lock held.
+	AtomicPointer<CacheEntry>& entry = _cache[slot(key, str, length)];
+	if (entry.load()) return;
+	try
+	{
+		CacheEntry* pEntry = new CacheEntry;
+		pEntry->key = key;
+		pEntry->str.assign(str, length);
+		pEntry->id  = id;
+		entry.exchange(pEntry);
+	}
+	catch (...)
+	{
+		// the record has been written; the cache is only an optimization
+	}
+}
+
+
+std::size_t BinaryFileChannel::slot(const void* key, const char* str, std::size_t length)
+{
+	// format strings and logger names are identified by their address,
+	// sources of Messages by their value
+	std::size_t h;
+	if (key)
+	{
+		h = static_cast<std::size_t>(reinterpret_cast<UIntPtr>(key) >> 3);
+	}
+	else
+	{
+		h = 2166136261u;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			h = (h ^ static_cast<unsigned char>(str[i]))*16777619u;
+		}
+	}
+	return static_cast<std::size_t>(static_cast<UInt32>(h)*2654435761u >> 24) & (CACHE_SIZE - 1);
+}
+
+
+void BinaryFileChannel::appendDefinition(UInt32 id, const std::string& str)
+{
+	_buffer += static_cast<char>(ENTRY_DEFINITION);
+	appendValue(id);
+	appendValue(static_cast<UInt32>(str.size()));
+	_buffer.append(str);
+}
+
+
+void BinaryFileChannel::writeRecordHeader(char* pBuffer, UInt32 formatId, UInt32 sourceId, Message::Priority prio, const Timestamp& time, long tid, std::size_t argsSize)
+{
+	Int64  epochTime = time.epochMicroseconds();
+	Int32  threadId  = static_cast<Int32>(tid);
+	UInt32 length    = static_cast<UInt32>(argsSize);
+	char* p = pBuffer;
+	*p++ = static_cast<char>(ENTRY_RECORD);
+	std::memcpy(p, &formatId, sizeof(formatId)); p += sizeof(formatId);
+	std::memcpy(p, &sourceId, sizeof(sourceId)); p += sizeof(sourceId);
+	*p++ = static_cast<char>(prio);
+	std::memcpy(p, &epochTime, sizeof(epochTime)); p += sizeof(epochTime);
+	std::memcpy(p, &threadId, sizeof(threadId)); p += sizeof(threadId);
+	std::memcpy(p, &length, sizeof(length));
+}
+
+
+} // namespace Poco
@@ -0,0 +1,148 @@
+//
+// BinaryLogDecoder.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogDecoder
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogDecoder.h"
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/LogRecord.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+#include "Poco/Any.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+template <typename T>
+inline bool BinaryLogDecoder::readValue(T& value)
+{
+	return readBytes(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+
+BinaryLogDecoder::BinaryLogDecoder(std::istream& istr):
+	_istr(istr)
+{
+}
+
+
+BinaryLogDecoder::~BinaryLogDecoder()
+{
+}
+
+
+bool BinaryLogDecoder::read(Message& msg)
+{
+	for (;;)
+	{
+		int type = _istr.get();
+		if (type == std::char_traits<char>::eof()) return false;
+		switch (type)
+		{
+		case BinaryFileChannel::ENTRY_COMMENT:
+			{
+				std::string comment;
+				std::getline(_istr, comment);
+			}
+			break;
+		case BinaryFileChannel::ENTRY_HEADER:
+			if (!readHeader()) return false;
+			break;
+		case BinaryFileChannel::ENTRY_DEFINITION:
+			if (!readDefinition()) return false;
+			break;
+		case BinaryFileChannel::ENTRY_RECORD:
+			{
+				UInt32 formatId;
+				UInt32 sourceId;
+				char prio;
+				Int64 time;
+				Int32 tid;
+				UInt32 length;
+				if (!readValue(formatId) || !readValue(sourceId) || !readBytes(&prio, 1) ||
+				    !readValue(time) || !readValue(tid) || !readValue(length) || !readString(_args, length))
+					return false;
+
+				std::vector<Any> args;
+				LogRecord::decode(_args.data(), _args.size(), args);
+				std::string text;
+				if (formatId < _strings.size())
+					Poco::format(text, _strings[formatId], args);
+				else
+					text = Poco::format("[undefined format %u]", formatId);
+				msg.setSource(sourceId < _strings.size() ? _strings[sourceId] : std::string());
+				msg.setText(text);
+				if (prio < Message::PRIO_FATAL || prio > Message::PRIO_TRACE) throw DataFormatException("invalid priority in binary log");
+				msg.setPriority(static_cast<Message::Priority>(prio));
+				msg.setTime(Timestamp(time));
+				msg.setTid(tid);
+				return true;
+			}
+		default:
+			throw DataFormatException("invalid entry in binary log");
+		}
+	}
+}
+
+
+bool BinaryLogDecoder::readHeader()
+{
+	char magic[4];
+	char version;
+	UInt16 bom;
+	if (!readBytes(magic, sizeof(magic)) || !readBytes(&version, 1) || !readValue(bom)) return false;
+	if (std::memcmp(magic, "PLOG", sizeof(magic)) != 0) throw DataFormatException("not a binary log");
+	if (version != BinaryFileChannel::VERSION) throw DataFormatException("unsupported binary log version");
+	if (bom != BinaryFileChannel::BYTE_ORDER_MARK) throw DataFormatException("binary log has been written with a different byte order");
+	_strings.clear();
+	return true;
+}
+
+
+bool BinaryLogDecoder::readDefinition()
+{
+	UInt32 id;
+	UInt32 length;
+	if (!readValue(id) || !readValue(length)) return false;
+	if (id > _strings.size() + 0x10000) throw DataFormatException("invalid definition in binary log");
+	if (id >= _strings.size()) _strings.resize(id + 1);
+	return readString(_strings[id], length);
+}
+
+
+bool BinaryLogDecoder::readBytes(char* buffer, std::size_t length)
+{
+	_istr.read(buffer, static_cast<std::streamsize>(length));
+	return static_cast<std::size_t>(_istr.gcount()) == length;
+}
+
+
+bool BinaryLogDecoder::readString(std::string& str, std::size_t length)
+{
+	str.clear();
+	char buffer[1024];
+	while (length > 0)
+	{
+		std::size_t n = length < sizeof(buffer) ? length : sizeof(buffer);
+		if (!readBytes(buffer, n)) return false;
+		str.append(buffer, n);
+		length -= n;
+	}
+	return true;
+}
+
+
+} // namespace Poco
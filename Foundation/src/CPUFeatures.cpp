@@ -0,0 +1,118 @@
+//
+// CPUFeatures.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	struct CPUInfo
+	{
+		CPUInfo():
+			ecx1(0),
+			edx1(0),
+			ebx7(0)
+		{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			int maxLeaf = info[0];
+			__cpuid(info, 1);
+			ecx1 = static_cast<unsigned>(info[2]);
+			edx1 = static_cast<unsigned>(info[3]);
+			if (maxLeaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				ebx7 = static_cast<unsigned>(info[1]);
+			}
+#else
+			unsigned eax, ebx, ecx, edx;
+			if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			{
+				ecx1 = ecx;
+				edx1 = edx;
+			}
+			if (__get_cpuid_max(0, 0) >= 7)
+			{
+				__cpuid_count(7, 0, eax, ebx, ecx, edx);
+				ebx7 = ebx;
+			}
+#endif
+#endif
+		}
+
+		unsigned ecx1; /// ECX of CPUID leaf 1
+		unsigned edx1; /// EDX of CPUID leaf 1
+		unsigned ebx7; /// EBX of CPUID leaf 7, sub-leaf 0
+	};
+
+
+	const CPUInfo& cpuInfo()
+	{
+		static const CPUInfo info;
+		return info;
+	}
+}
+
+
+bool CPUFeatures::hasSSE2()
+{
+	return (cpuInfo().edx1 & (1u << 26)) != 0;
+}
+
+
+bool CPUFeatures::hasSSSE3()
+{
+	return (cpuInfo().ecx1 & (1u << 9)) != 0;
+}
+
+
+bool CPUFeatures::hasSSE41()
+{
+	return (cpuInfo().ecx1 & (1u << 19)) != 0;
+}
+
+
+bool CPUFeatures::hasSSE42()
+{
+	return (cpuInfo().ecx1 & (1u << 20)) != 0;
+}
+
+
+bool CPUFeatures::hasPCLMUL()
+{
+	return (cpuInfo().ecx1 & (1u << 1)) != 0;
+}
+
+
+bool CPUFeatures::hasSHA()
+{
+	return (cpuInfo().ebx7 & (1u << 29)) != 0;
+}
+
+
+} // namespace Poco
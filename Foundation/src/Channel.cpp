@@ -15,6 +15,8 @@
 
 
 #include "Poco/Channel.h"
+#include "Poco/Message.h"
+#include "Poco/LogRecord.h"
 
 
 namespace Poco {
@@ -46,6 +48,23 @@ void Channel::setProperty(const std::string& name, const std::string& value)
 }
 
 
+void Channel::logBatch(const Message* pMessages, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		log(pMessages[i]);
+	}
+}
+
+
+void Channel::logRecord(const LogRecord& record)
+{
+	Message msg;
+	record.toMessage(msg);
+	log(msg);
+}
+
+
 std::string Channel::getProperty(const std::string& name) const
 {
 	throw PropertyNotSupportedException(name);
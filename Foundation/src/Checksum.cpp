@@ -15,16 +15,228 @@
 
 
 #include "Poco/Checksum.h"
+#include "Poco/CPUFeatures.h"
 #if defined(POCO_UNBUNDLED)
 #include <zlib.h>
 #else
 #include "Poco/zlib.h"
 #endif
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	struct CRC32CTables
+		/// The lookup tables for calculating CRC-32C eight
+		/// bytes at a time ("slicing-by-8").
+	{
+		CRC32CTables()
+		{
+			for (UInt32 i = 0; i < 256; i++)
+			{
+				UInt32 crc = i;
+				for (int k = 0; k < 8; k++)
+				{
+					crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+				}
+				table[0][i] = crc;
+			}
+			for (int i = 0; i < 256; i++)
+			{
+				for (int t = 1; t < 8; t++)
+				{
+					table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xFF];
+				}
+			}
+		}
+
+		UInt32 table[8][256];
+	};
+
+
+	const CRC32CTables& crc32cTables()
+	{
+		static const CRC32CTables tables;
+		return tables;
+	}
+
+
+	inline UInt32 load32(const unsigned char* data)
+	{
+		return UInt32(data[0]) | (UInt32(data[1]) << 8) | (UInt32(data[2]) << 16) | (UInt32(data[3]) << 24);
+	}
+
+
+	UInt32 crc32cSlicingBy8(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		const CRC32CTables& t = crc32cTables();
+		crc = ~crc;
+		while (length >= 8)
+		{
+			UInt32 lo = crc ^ load32(data);
+			UInt32 hi = load32(data + 4);
+			crc = t.table[7][lo & 0xFF] ^ t.table[6][(lo >> 8) & 0xFF] ^ t.table[5][(lo >> 16) & 0xFF] ^ t.table[4][lo >> 24]
+			    ^ t.table[3][hi & 0xFF] ^ t.table[2][(hi >> 8) & 0xFF] ^ t.table[1][(hi >> 16) & 0xFF] ^ t.table[0][hi >> 24];
+			data   += 8;
+			length -= 8;
+		}
+		while (length-- > 0)
+		{
+			crc = t.table[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	POCO_TARGET_ISA("sse4.2")
+	UInt32 crc32cSSE42(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		crc = ~crc;
+#if defined(__x86_64__) || defined(_M_X64)
+		UInt64 crc64 = crc;
+		while (length >= 8)
+		{
+			UInt64 value;
+			std::memcpy(&value, data, 8);
+			crc64  = _mm_crc32_u64(crc64, value);
+			data   += 8;
+			length -= 8;
+		}
+		crc = static_cast<UInt32>(crc64);
+#endif
+		while (length >= 4)
+		{
+			UInt32 value;
+			std::memcpy(&value, data, 4);
+			crc    = _mm_crc32_u32(crc, value);
+			data   += 4;
+			length -= 4;
+		}
+		while (length-- > 0)
+		{
+			crc = _mm_crc32_u8(crc, *data++);
+		}
+		return ~crc;
+	}
+
+
+	POCO_TARGET_ISA("pclmul,sse4.1")
+	UInt32 crc32PCLMUL(UInt32 crc, const unsigned char* data, std::size_t length)
+		/// Calculates the CRC-32 of length bytes, which must be
+		/// a multiple of 16 and at least 64, by folding with
+		/// carry-less multiplications, as described in Intel's
+		/// "Fast CRC Computation for Generic Polynomials Using
+		/// PCLMULQDQ Instruction". Takes and returns the CRC
+		/// register, i.e., the inverted CRC.
+	{
+		const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+		const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+		const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163CD6124LL);
+		const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+		const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+		data   += 64;
+		length -= 64;
+
+		// fold four 128-bit lanes in parallel
+		while (length >= 64)
+		{
+			__m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+			__m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+			__m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+			__m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+			x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+			x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+			x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+			x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+			x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)));
+			x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)));
+			data   += 64;
+			length -= 64;
+		}
+
+		// fold into a single 128-bit lane
+		__m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+		while (length >= 16)
+		{
+			x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+			data   += 16;
+			length -= 16;
+		}
+
+		// fold 128 to 64 bits
+		x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_and_si128(x1, mask);
+		x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		// Barrett reduction to 32 bits
+		x2 = _mm_and_si128(x1, mask);
+		x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+		x2 = _mm_and_si128(x2, mask);
+		x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+		return static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+	}
+#endif
+
+
+	UInt32 updateCRC32C(UInt32 crc, const char* data, unsigned length)
+	{
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSSE42())
+			return crc32cSSE42(crc, bytes, length);
+#endif
+		return crc32cSlicingBy8(crc, bytes, length);
+	}
+
+
+	UInt32 updateCRC32(UInt32 crc, const char* data, unsigned length)
+	{
+		const Bytef* bytes = reinterpret_cast<const Bytef*>(data);
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (length >= 64 && CPUFeatures::hasPCLMUL() && CPUFeatures::hasSSE41())
+		{
+			unsigned blockLength = length & ~15u;
+			crc = ~crc32PCLMUL(~crc, bytes, blockLength);
+			bytes  += blockLength;
+			length -= blockLength;
+			if (length == 0) return crc;
+		}
+#endif
+		return static_cast<UInt32>(crc32(crc, bytes, length));
+	}
+}
+
+
 Checksum::Checksum():
 	_type(TYPE_CRC32),
 	_value(crc32(0L, Z_NULL, 0))
@@ -38,7 +250,7 @@ Checksum::Checksum(Type t):
 {
 	if (t == TYPE_CRC32)
 		_value = crc32(0L, Z_NULL, 0);
-	else
+	else if (t == TYPE_ADLER32)
 		_value = adler32(0L, Z_NULL, 0);
 }
 
@@ -52,8 +264,10 @@ void Checksum::update(const char* data, unsigned length)
 {
 	if (_type == TYPE_ADLER32)
 		_value = adler32(_value, reinterpret_cast<const Bytef*>(data), length);
+	else if (_type == TYPE_CRC32C)
+		_value = updateCRC32C(_value, data, length);
 	else
-		_value = crc32(_value, reinterpret_cast<const Bytef*>(data), length);
+		_value = updateCRC32(_value, data, length);
 }
 
 
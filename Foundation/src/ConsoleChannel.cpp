@@ -50,6 +50,18 @@ void ConsoleChannel::log(const Message& msg)
 }
 
 
+void ConsoleChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		_str << pMessages[i].getText() << '\n';
+	}
+	_str.flush();
+}
+
+
 FastMutex ColorConsoleChannel::_mutex;
 const std::string ColorConsoleChannel::CSI("\033[");
 
@@ -23,14 +23,249 @@
 namespace Poco {
 
 
+namespace
+{
+	enum StandardFormat
+	{
+		FMT_OTHER,
+		FMT_ISO8601,
+		FMT_ISO8601_FRAC,
+		FMT_RFC1123,
+		FMT_HTTP
+	};
+
+
+	StandardFormat standardFormat(const std::string& fmt)
+	{
+		if (fmt.size() < 19 || fmt[0] != '%') return FMT_OTHER;
+		if (fmt == DateTimeFormat::ISO8601_FORMAT) return FMT_ISO8601;
+		if (fmt == DateTimeFormat::ISO8601_FRAC_FORMAT) return FMT_ISO8601_FRAC;
+		if (fmt == DateTimeFormat::HTTP_FORMAT) return FMT_HTTP;
+		if (fmt == DateTimeFormat::RFC1123_FORMAT) return FMT_RFC1123;
+		return FMT_OTHER;
+	}
+
+
+	struct Fields
+		/// The broken-down date and time needed by the
+		/// standard formats.
+	{
+		int year;
+		int month;
+		int day;
+		int dayOfWeek;
+		int hour;
+		int minute;
+		int second;
+		int micros;
+	};
+
+
+	Int64 daysFromCivil(int year, int month, int day)
+		/// Returns the number of days since 1970-01-01
+		/// in the proleptic Gregorian calendar.
+	{
+		Int64 y = month <= 2 ? year - 1 : year;
+		Int64 era = (y >= 0 ? y : y - 399)/400;
+		Int64 yoe = y - era*400;
+		Int64 doy = (153*(month > 2 ? month - 3 : month + 9) + 2)/5 + day - 1;
+		Int64 doe = yoe*365 + yoe/4 - yoe/100 + doy;
+		return era*146097 + doe - 719468;
+	}
+
+
+	int weekday(Int64 days)
+	{
+		int dow = int((days + 4) % 7);
+		return dow < 0 ? dow + 7 : dow;
+	}
+
+
+	void split(const DateTime& dateTime, Fields& fields)
+	{
+		fields.year      = dateTime.year();
+		fields.month     = dateTime.month();
+		fields.day       = dateTime.day();
+		fields.dayOfWeek = weekday(daysFromCivil(fields.year, fields.month, fields.day));
+		fields.hour      = dateTime.hour();
+		fields.minute    = dateTime.minute();
+		fields.second    = dateTime.second();
+		fields.micros    = dateTime.millisecond()*1000 + dateTime.microsecond();
+	}
+
+
+	bool split(const Timestamp& timestamp, Fields& fields)
+		/// Computes the fields from the given timestamp using integer
+		/// arithmetic only, which is a lot faster than constructing
+		/// a DateTime. Returns false for timestamps before the start
+		/// of the Gregorian calendar, where DateTime must be used for
+		/// consistent results.
+	{
+		if (timestamp.utcTime() < 0) return false;
+
+		Timestamp::TimeVal us = timestamp.epochMicroseconds();
+		Timestamp::TimeVal secs = us/Timestamp::resolution();
+		Timestamp::TimeVal frac = us%Timestamp::resolution();
+		if (frac < 0)
+		{
+			frac += Timestamp::resolution();
+			--secs;
+		}
+		Int64 days = secs/86400;
+		int secOfDay = int(secs%86400);
+		if (secOfDay < 0)
+		{
+			secOfDay += 86400;
+			--days;
+		}
+		fields.hour      = secOfDay/3600;
+		fields.minute    = (secOfDay/60)%60;
+		fields.second    = secOfDay%60;
+		fields.micros    = int(frac);
+		fields.dayOfWeek = weekday(days);
+
+		Int64 z = days + 719468;
+		Int64 era = (z >= 0 ? z : z - 146096)/146097;
+		Int64 doe = z - era*146097;
+		Int64 yoe = (doe - doe/1460 + doe/36524 - doe/146096)/365;
+		Int64 doy = doe - (365*yoe + yoe/4 - yoe/100);
+		Int64 mp = (5*doy + 2)/153;
+		fields.day   = int(doy - (153*mp + 2)/5 + 1);
+		fields.month = int(mp < 10 ? mp + 3 : mp - 9);
+		fields.year  = int(yoe + era*400 + (fields.month <= 2 ? 1 : 0));
+		return true;
+	}
+
+
+	const char WEEKDAY_ABBREVIATIONS[] = "SunMonTueWedThuFriSat";
+	const char MONTH_ABBREVIATIONS[]   = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+
+	inline char* put2(char* p, int value)
+	{
+		p[0] = char('0' + value/10);
+		p[1] = char('0' + value%10);
+		return p + 2;
+	}
+
+
+	inline char* put3(char* p, const char* abbreviations, int index)
+	{
+		p[0] = abbreviations[3*index];
+		p[1] = abbreviations[3*index + 1];
+		p[2] = abbreviations[3*index + 2];
+		return p + 3;
+	}
+
+
+	inline void append2(std::string& str, int value)
+		/// Appends a zero-padded two-digit value (0 .. 99).
+	{
+		char buffer[2];
+		put2(buffer, value);
+		str.append(buffer, 2);
+	}
+
+
+	inline char* putTime(char* p, const Fields& fields)
+	{
+		p = put2(p, fields.hour);
+		*p++ = ':';
+		p = put2(p, fields.minute);
+		*p++ = ':';
+		return put2(p, fields.second);
+	}
+
+
+	bool appendStandard(std::string& str, StandardFormat format, const Fields& fields, int timeZoneDifferential)
+		/// Appends the date and time in one of the standard formats.
+		/// Returns false if the year is outside the range
+		/// of four-digit years.
+	{
+		if (fields.year < 0 || fields.year > 9999) return false;
+
+		char buffer[32];
+		char* p = buffer;
+		switch (format)
+		{
+		case FMT_ISO8601:
+		case FMT_ISO8601_FRAC:
+			p = put2(p, fields.year/100);
+			p = put2(p, fields.year%100);
+			*p++ = '-';
+			p = put2(p, fields.month);
+			*p++ = '-';
+			p = put2(p, fields.day);
+			*p++ = 'T';
+			p = putTime(p, fields);
+			if (format == FMT_ISO8601_FRAC)
+			{
+				*p++ = '.';
+				p = put2(p, fields.micros/10000);
+				p = put2(p, (fields.micros/100)%100);
+				p = put2(p, fields.micros%100);
+			}
+			str.append(buffer, p - buffer);
+			DateTimeFormatter::tzdISO(str, timeZoneDifferential);
+			return true;
+		case FMT_RFC1123:
+		case FMT_HTTP:
+			p = put3(p, WEEKDAY_ABBREVIATIONS, fields.dayOfWeek);
+			*p++ = ',';
+			*p++ = ' ';
+			if (format == FMT_RFC1123 && fields.day < 10)
+				*p++ = char('0' + fields.day);
+			else
+				p = put2(p, fields.day);
+			*p++ = ' ';
+			p = put3(p, MONTH_ABBREVIATIONS, fields.month - 1);
+			*p++ = ' ';
+			p = put2(p, fields.year/100);
+			p = put2(p, fields.year%100);
+			*p++ = ' ';
+			p = putTime(p, fields);
+			*p++ = ' ';
+			str.append(buffer, p - buffer);
+			DateTimeFormatter::tzdRFC(str, timeZoneDifferential);
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+
 void DateTimeFormatter::append(std::string& str, const LocalDateTime& dateTime, const std::string& fmt)
 {
 	DateTimeFormatter::append(str, dateTime._dateTime, fmt, dateTime.tzd());
 }
 
 
+void DateTimeFormatter::append(std::string& str, const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
+{
+	StandardFormat format = standardFormat(fmt);
+	if (format != FMT_OTHER)
+	{
+		Fields fields;
+		if (split(timestamp, fields) && appendStandard(str, format, fields, timeZoneDifferential))
+			return;
+	}
+	DateTime dateTime(timestamp);
+	append(str, dateTime, fmt, timeZoneDifferential);
+}
+
+
 void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, const std::string& fmt, int timeZoneDifferential)
 {
+	StandardFormat format = standardFormat(fmt);
+	if (format != FMT_OTHER)
+	{
+		Fields fields;
+		split(dateTime, fields);
+		if (appendStandard(str, format, fields, timeZoneDifferential))
+			return;
+	}
+
 	std::string::const_iterator it  = fmt.begin();
 	std::string::const_iterator end = fmt.end();
 	while (it != end)
@@ -39,37 +274,7 @@ void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, const
 		{
 			if (++it != end)
 			{
-				switch (*it)
-				{
-				case 'w': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-				case 'W': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-				case 'b': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-				case 'B': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-				case 'd': NumberFormatter::append0(str, dateTime.day(), 2); break;
-				case 'e': NumberFormatter::append(str, dateTime.day()); break;
-				case 'f': NumberFormatter::append(str, dateTime.day(), 2); break;
-				case 'm': NumberFormatter::append0(str, dateTime.month(), 2); break;
-				case 'n': NumberFormatter::append(str, dateTime.month()); break;
-				case 'o': NumberFormatter::append(str, dateTime.month(), 2); break;
-				case 'y': NumberFormatter::append0(str, dateTime.year() % 100, 2); break;
-				case 'Y': NumberFormatter::append0(str, dateTime.year(), 4); break;
-				case 'H': NumberFormatter::append0(str, dateTime.hour(), 2); break;
-				case 'h': NumberFormatter::append0(str, dateTime.hourAMPM(), 2); break;
-				case 'a': str.append(dateTime.isAM() ? "am" : "pm"); break;
-				case 'A': str.append(dateTime.isAM() ? "AM" : "PM"); break;
-				case 'M': NumberFormatter::append0(str, dateTime.minute(), 2); break;
-				case 'S': NumberFormatter::append0(str, dateTime.second(), 2); break;
-				case 's': NumberFormatter::append0(str, dateTime.second(), 2); 
-				          str += '.'; 
-				          NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); 
-				          break;
-				case 'i': NumberFormatter::append0(str, dateTime.millisecond(), 3); break;
-				case 'c': NumberFormatter::append(str, dateTime.millisecond()/100); break;
-				case 'F': NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-				case 'z': tzdISO(str, timeZoneDifferential); break;
-				case 'Z': tzdRFC(str, timeZoneDifferential); break;
-				default:  str += *it;
-				}
+				append(str, dateTime, *it, timeZoneDifferential);
 				++it;
 			}
 		}
@@ -78,6 +283,49 @@ void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, const
 }
 
 
+void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, char spec, int timeZoneDifferential)
+{
+	switch (spec)
+	{
+	case 'w': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+	case 'W': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+	case 'b': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+	case 'B': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+	case 'd': append2(str, dateTime.day()); break;
+	case 'e': NumberFormatter::append(str, dateTime.day()); break;
+	case 'f': NumberFormatter::append(str, dateTime.day(), 2); break;
+	case 'm': append2(str, dateTime.month()); break;
+	case 'n': NumberFormatter::append(str, dateTime.month()); break;
+	case 'o': NumberFormatter::append(str, dateTime.month(), 2); break;
+	case 'y': append2(str, dateTime.year() % 100); break;
+	case 'Y':
+		if (dateTime.year() <= 9999)
+		{
+			append2(str, dateTime.year() / 100);
+			append2(str, dateTime.year() % 100);
+		}
+		else NumberFormatter::append0(str, dateTime.year(), 4);
+		break;
+	case 'H': append2(str, dateTime.hour()); break;
+	case 'h': append2(str, dateTime.hourAMPM()); break;
+	case 'a': str.append(dateTime.isAM() ? "am" : "pm"); break;
+	case 'A': str.append(dateTime.isAM() ? "AM" : "PM"); break;
+	case 'M': append2(str, dateTime.minute()); break;
+	case 'S': append2(str, dateTime.second()); break;
+	case 's': append2(str, dateTime.second()); 
+	          str += '.'; 
+	          NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); 
+	          break;
+	case 'i': NumberFormatter::append0(str, dateTime.millisecond(), 3); break;
+	case 'c': NumberFormatter::append(str, dateTime.millisecond()/100); break;
+	case 'F': NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
+	case 'z': tzdISO(str, timeZoneDifferential); break;
+	case 'Z': tzdRFC(str, timeZoneDifferential); break;
+	default:  str += spec;
+	}
+}
+
+
 void DateTimeFormatter::append(std::string& str, const Timespan& timespan, const std::string& fmt)
 {
 	std::string::const_iterator it  = fmt.begin();
@@ -44,21 +44,129 @@ namespace Poco {
 	{ int i = 0; while (i < n && it != end && Ascii::isDigit(*it)) { var = var*10 + ((*it++) - '0'); i++; } while (i++ < n) var *= 10; }
 
 
+namespace
+{
+	enum StandardFormat
+	{
+		FMT_OTHER,
+		FMT_ISO8601,
+		FMT_ISO8601_FRAC,
+		FMT_RFC1123,
+		FMT_HTTP
+	};
+
+
+	StandardFormat standardFormat(const std::string& fmt)
+	{
+		if (fmt.size() < 19 || fmt[0] != '%') return FMT_OTHER;
+		if (fmt == DateTimeFormat::ISO8601_FORMAT) return FMT_ISO8601;
+		if (fmt == DateTimeFormat::ISO8601_FRAC_FORMAT) return FMT_ISO8601_FRAC;
+		if (fmt == DateTimeFormat::HTTP_FORMAT) return FMT_HTTP;
+		if (fmt == DateTimeFormat::RFC1123_FORMAT) return FMT_RFC1123;
+		return FMT_OTHER;
+	}
+
+
+	const char MONTH_ABBREVIATIONS[] = "janfebmaraprmayjunjulaugsepoctnovdec";
+
+
+	inline bool parseDigits(const char*& p, const char* end, int n, int& value)
+		/// Parses exactly n digits.
+	{
+		if (end - p < n) return false;
+		int v = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			if (!Ascii::isDigit(p[i])) return false;
+			v = v*10 + (p[i] - '0');
+		}
+		value = v;
+		p += n;
+		return true;
+	}
+
+
+	inline bool parseChar(const char*& p, const char* end, char c)
+	{
+		if (p != end && *p == c)
+		{
+			++p;
+			return true;
+		}
+		return false;
+	}
+
+
+	bool parseTime(const char*& p, const char* end, int& hour, int& minute, int& second)
+	{
+		return parseDigits(p, end, 2, hour) && parseChar(p, end, ':')
+			&& parseDigits(p, end, 2, minute) && parseChar(p, end, ':')
+			&& parseDigits(p, end, 2, second);
+	}
+
+
+	bool parseMonthAbbreviation(const char*& p, const char* end, int& month)
+	{
+		if (end - p < 3) return false;
+		char name[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			if (!Ascii::isAlpha(p[i])) return false;
+			name[i] = Ascii::toLower(p[i]);
+		}
+		for (int i = 0; i < 12; ++i)
+		{
+			const char* abbreviation = MONTH_ABBREVIATIONS + 3*i;
+			if (name[0] == abbreviation[0] && name[1] == abbreviation[1] && name[2] == abbreviation[2])
+			{
+				month = i + 1;
+				p += 3;
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	bool parseTimeZone(const char*& p, const char* end, int& tzd)
+		/// Parses "Z", "GMT", +HH:MM or +HHMM at the end of the string.
+	{
+		if (p == end) return false;
+		if (*p == 'Z')
+		{
+			++p;
+			tzd = 0;
+		}
+		else if (end - p == 3 && p[0] == 'G' && p[1] == 'M' && p[2] == 'T')
+		{
+			p += 3;
+			tzd = 0;
+		}
+		else if (*p == '+' || *p == '-')
+		{
+			int sign = *p++ == '+' ? 1 : -1;
+			int hours;
+			int minutes;
+			if (!parseDigits(p, end, 2, hours)) return false;
+			parseChar(p, end, ':');
+			if (!parseDigits(p, end, 2, minutes)) return false;
+			tzd = sign*(hours*3600 + minutes*60);
+		}
+		else return false;
+		return p == end;
+	}
+}
+
+
 void DateTimeParser::parse(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential)
 {
 	if (fmt.empty() || str.empty())
 		throw SyntaxException("Empty string.");
 
-	int year   = 0;
-	int month  = 0;
-	int day    = 0;
-	int hour   = 0;
-	int minute = 0;
-	int second = 0;
-	int millis = 0;
-	int micros = 0;
-	int tzd    = 0;
+	if (parseStandard(fmt, str, dateTime, timeZoneDifferential))
+		return;
 
+	Fields fields;
 	std::string::const_iterator it   = str.begin();
 	std::string::const_iterator end  = str.end();
 	std::string::const_iterator itf  = fmt.begin();
@@ -70,112 +178,176 @@ void DateTimeParser::parse(const std::string& fmt, const std::string& str, DateT
 		{
 			if (++itf != endf)
 			{
-				switch (*itf)
-				{
-				case 'w':
-				case 'W':
-					while (it != end && Ascii::isSpace(*it)) ++it;
-					while (it != end && Ascii::isAlpha(*it)) ++it;
-					break;
-				case 'b':
-				case 'B':
-					month = parseMonth(it, end);
-					break;
-				case 'd':
-				case 'e':
-				case 'f':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(day, 2);
-					break;
-				case 'm':
-				case 'n':
-				case 'o':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(month, 2);
-					break;					 
-				case 'y':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(year, 2);
-					if (year >= 69) 
-						year += 1900;
-					else
-						year += 2000;
-					break;
-				case 'Y':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(year, 4);
-					break;
-				case 'r':
-					SKIP_JUNK();
-					PARSE_NUMBER(year);
-					if (year < 1000)
-					{
-						if (year >= 69) 
-							year += 1900;
-						else
-							year += 2000;
-					}
-					break;
-				case 'H':
-				case 'h':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(hour, 2);
-					break;
-				case 'a':
-				case 'A':
-					hour = parseAMPM(it, end, hour);
-					break;
-				case 'M':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(minute, 2);
-					break;
-				case 'S':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(second, 2);
-					break;
-				case 's':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(second, 2);
-					if (it != end && (*it == '.' || *it == ','))
-					{
-						++it;
-						PARSE_FRACTIONAL_N(millis, 3);
-						PARSE_FRACTIONAL_N(micros, 3);
-						SKIP_DIGITS();
-					}
-					break;
-				case 'i':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(millis, 3);
-					break;
-				case 'c':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(millis, 1);
-					millis *= 100;
-					break;
-				case 'F':
-					SKIP_JUNK();
-					PARSE_FRACTIONAL_N(millis, 3);
-					PARSE_FRACTIONAL_N(micros, 3);
-					SKIP_DIGITS();
-					break;
-				case 'z':
-				case 'Z':
-					tzd = parseTZD(it, end);
-					break;
-				}
+				parse(*itf, it, end, fields);
 				++itf;
 			}
 		}
 		else ++itf;
 	}
-	if (month == 0) month = 1;
-	if (day == 0) day = 1;
-	if (DateTime::isValid(year, month, day, hour, minute, second, millis, micros))
-		dateTime.assign(year, month, day, hour, minute, second, millis, micros);
+	assign(fields, dateTime, timeZoneDifferential);
+}
+
+
+void DateTimeParser::parse(char spec, std::string::const_iterator& it, const std::string::const_iterator& end, Fields& fields)
+{
+	switch (spec)
+	{
+	case 'w':
+	case 'W':
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		while (it != end && Ascii::isAlpha(*it)) ++it;
+		break;
+	case 'b':
+	case 'B':
+		fields.month = parseMonth(it, end);
+		break;
+	case 'd':
+	case 'e':
+	case 'f':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.day, 2);
+		break;
+	case 'm':
+	case 'n':
+	case 'o':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.month, 2);
+		break;					 
+	case 'y':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.year, 2);
+		if (fields.year >= 69) 
+			fields.year += 1900;
+		else
+			fields.year += 2000;
+		break;
+	case 'Y':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.year, 4);
+		break;
+	case 'r':
+		SKIP_JUNK();
+		PARSE_NUMBER(fields.year);
+		if (fields.year < 1000)
+		{
+			if (fields.year >= 69) 
+				fields.year += 1900;
+			else
+				fields.year += 2000;
+		}
+		break;
+	case 'H':
+	case 'h':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.hour, 2);
+		break;
+	case 'a':
+	case 'A':
+		fields.hour = parseAMPM(it, end, fields.hour);
+		break;
+	case 'M':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.minute, 2);
+		break;
+	case 'S':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.second, 2);
+		break;
+	case 's':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.second, 2);
+		if (it != end && (*it == '.' || *it == ','))
+		{
+			++it;
+			PARSE_FRACTIONAL_N(fields.millis, 3);
+			PARSE_FRACTIONAL_N(fields.micros, 3);
+			SKIP_DIGITS();
+		}
+		break;
+	case 'i':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.millis, 3);
+		break;
+	case 'c':
+		SKIP_JUNK();
+		PARSE_NUMBER_N(fields.millis, 1);
+		fields.millis *= 100;
+		break;
+	case 'F':
+		SKIP_JUNK();
+		PARSE_FRACTIONAL_N(fields.millis, 3);
+		PARSE_FRACTIONAL_N(fields.micros, 3);
+		SKIP_DIGITS();
+		break;
+	case 'z':
+	case 'Z':
+		fields.tzd = parseTZD(it, end);
+		break;
+	}
+}
+
+
+void DateTimeParser::assign(Fields& fields, DateTime& dateTime, int& timeZoneDifferential)
+{
+	if (fields.month == 0) fields.month = 1;
+	if (fields.day == 0) fields.day = 1;
+	if (DateTime::isValid(fields.year, fields.month, fields.day, fields.hour, fields.minute, fields.second, fields.millis, fields.micros))
+		dateTime.assign(fields.year, fields.month, fields.day, fields.hour, fields.minute, fields.second, fields.millis, fields.micros);
 	else 
 		throw SyntaxException("date/time component out of range");
-	timeZoneDifferential = tzd;
+	timeZoneDifferential = fields.tzd;
+}
+
+
+bool DateTimeParser::parseStandard(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential)
+{
+	StandardFormat format = standardFormat(fmt);
+	if (format == FMT_OTHER) return false;
+
+	Fields fields;
+	const char* p   = str.data();
+	const char* end = p + str.size();
+	switch (format)
+	{
+	case FMT_ISO8601:
+	case FMT_ISO8601_FRAC:
+		if (!(parseDigits(p, end, 4, fields.year) && parseChar(p, end, '-')
+			&& parseDigits(p, end, 2, fields.month) && parseChar(p, end, '-')
+			&& parseDigits(p, end, 2, fields.day) && parseChar(p, end, 'T')
+			&& parseTime(p, end, fields.hour, fields.minute, fields.second)))
+			return false;
+		if (format == FMT_ISO8601_FRAC && p != end && (*p == '.' || *p == ','))
+		{
+			++p;
+			int digits = 0;
+			int fraction = 0;
+			for (; p != end && Ascii::isDigit(*p); ++p, ++digits)
+			{
+				if (digits < 6) fraction = fraction*10 + (*p - '0');
+			}
+			for (; digits < 6; ++digits) fraction *= 10;
+			fields.millis = fraction/1000;
+			fields.micros = fraction%1000;
+		}
+		break;
+	default:
+		if (end - p < 5 || !Ascii::isAlpha(p[0]) || !Ascii::isAlpha(p[1]) || !Ascii::isAlpha(p[2]) || p[3] != ',' || p[4] != ' ')
+			return false;
+		p += 5;
+		if (!parseDigits(p, end, 2, fields.day) && !parseDigits(p, end, 1, fields.day))
+			return false;
+		if (!(parseChar(p, end, ' ') && parseMonthAbbreviation(p, end, fields.month)
+			&& parseChar(p, end, ' ') && parseDigits(p, end, 4, fields.year)
+			&& parseChar(p, end, ' ') && parseTime(p, end, fields.hour, fields.minute, fields.second)
+			&& parseChar(p, end, ' ')))
+			return false;
+		break;
+	}
+	if (!parseTimeZone(p, end, fields.tzd))
+		return false;
+
+	assign(fields, dateTime, timeZoneDifferential);
+	return true;
 }
 
 
@@ -0,0 +1,257 @@
+//
+// DateTimePattern.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  DateTimePattern
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DateTimePattern.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeParser.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	const Timestamp::UtcTimeVal UTC_TICKS_PER_SECOND = 10000000;
+
+
+	inline Timestamp::UtcTimeVal secondOf(Timestamp::UtcTimeVal utcTime)
+	{
+		Timestamp::UtcTimeVal second = utcTime/UTC_TICKS_PER_SECOND;
+		if (utcTime%UTC_TICKS_PER_SECOND < 0) --second;
+		return second;
+	}
+}
+
+
+DateTimePattern::DateTimePattern(const std::string& fmt):
+	_fmt(fmt),
+	_standard(false),
+	_cacheable(true)
+{
+	_standard = fmt == DateTimeFormat::ISO8601_FORMAT
+	         || fmt == DateTimeFormat::ISO8601_FRAC_FORMAT
+	         || fmt == DateTimeFormat::HTTP_FORMAT
+	         || fmt == DateTimeFormat::RFC1123_FORMAT;
+
+	Action action;
+	action.spec = 0;
+	std::string::const_iterator it  = fmt.begin();
+	std::string::const_iterator end = fmt.end();
+	while (it != end)
+	{
+		if (*it == '%')
+		{
+			if (++it != end)
+			{
+				action.spec = *it++;
+				switch (action.spec)
+				{
+				case 's':
+				case 'i':
+				case 'c':
+				case 'F':
+					_cacheable = false;
+					break;
+				}
+				_actions.push_back(action);
+				action.text.clear();
+				action.spec = 0;
+			}
+		}
+		else action.text += *it++;
+	}
+	if (!action.text.empty()) _actions.push_back(action);
+}
+
+
+DateTimePattern::~DateTimePattern()
+{
+	for (CacheVec::iterator it = _cacheEntries.begin(); it != _cacheEntries.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+
+std::string DateTimePattern::format(const Timestamp& timestamp, int timeZoneDifferential) const
+{
+	std::string result;
+	result.reserve(64);
+	append(result, timestamp, timeZoneDifferential);
+	return result;
+}
+
+
+std::string DateTimePattern::format(const DateTime& dateTime, int timeZoneDifferential) const
+{
+	std::string result;
+	result.reserve(64);
+	append(result, dateTime, timeZoneDifferential);
+	return result;
+}
+
+
+std::string DateTimePattern::format(const LocalDateTime& dateTime) const
+{
+	std::string result;
+	result.reserve(64);
+	append(result, dateTime._dateTime, dateTime._tzd);
+	return result;
+}
+
+
+void DateTimePattern::append(std::string& str, const Timestamp& timestamp, int timeZoneDifferential) const
+{
+	if (_standard)
+	{
+		DateTimeFormatter::append(str, timestamp, _fmt, timeZoneDifferential);
+	}
+	else if (!_cacheable)
+	{
+		appendUncached(str, DateTime(timestamp), timeZoneDifferential);
+	}
+	else if (!appendCached(str, timestamp.utcTime(), timeZoneDifferential))
+	{
+		std::string::size_type pos = str.size();
+		appendUncached(str, DateTime(timestamp), timeZoneDifferential);
+		updateCache(str, pos, timestamp.utcTime(), timeZoneDifferential);
+	}
+}
+
+
+void DateTimePattern::append(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	if (_standard)
+	{
+		DateTimeFormatter::append(str, dateTime, _fmt, timeZoneDifferential);
+	}
+	else if (!_cacheable)
+	{
+		appendUncached(str, dateTime, timeZoneDifferential);
+	}
+	else if (!appendCached(str, dateTime.utcTime(), timeZoneDifferential))
+	{
+		std::string::size_type pos = str.size();
+		appendUncached(str, dateTime, timeZoneDifferential);
+		updateCache(str, pos, dateTime.utcTime(), timeZoneDifferential);
+	}
+}
+
+
+void DateTimePattern::append(std::string& str, const LocalDateTime& dateTime) const
+{
+	append(str, dateTime._dateTime, dateTime._tzd);
+}
+
+
+void DateTimePattern::parse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	if (_fmt.empty() || str.empty())
+		throw SyntaxException("Empty string.");
+
+	if (_standard && DateTimeParser::parseStandard(_fmt, str, dateTime, timeZoneDifferential))
+		return;
+
+	DateTimeParser::Fields fields;
+	std::string::const_iterator it  = str.begin();
+	std::string::const_iterator end = str.end();
+	for (ActionVec::const_iterator itAction = _actions.begin(); itAction != _actions.end() && it != end; ++itAction)
+	{
+		if (itAction->spec) DateTimeParser::parse(itAction->spec, it, end, fields);
+	}
+	DateTimeParser::assign(fields, dateTime, timeZoneDifferential);
+}
+
+
+DateTime DateTimePattern::parse(const std::string& str, int& timeZoneDifferential) const
+{
+	DateTime result;
+	parse(str, result, timeZoneDifferential);
+	return result;
+}
+
+
+bool DateTimePattern::tryParse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	try
+	{
+		parse(str, dateTime, timeZoneDifferential);
+	}
+	catch (Exception&)
+	{
+		return false;
+	}
+	return true;
+}
+
+
+void DateTimePattern::appendUncached(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	for (ActionVec::const_iterator it = _actions.begin(); it != _actions.end(); ++it)
+	{
+		str.append(it->text);
+		if (it->spec) DateTimeFormatter::append(str, dateTime, it->spec, timeZoneDifferential);
+	}
+}
+
+
+bool DateTimePattern::appendCached(std::string& str, Timestamp::UtcTimeVal utcTime, int timeZoneDifferential) const
+{
+	Timestamp::UtcTimeVal second = secondOf(utcTime);
+
+	CacheEntry* pEntry = _pCache.load();
+	if (!pEntry) return false;
+
+	// The reference keeps updateCache() from reusing the entry.
+	// If the entry is still current afterwards, it cannot have
+	// been changed in the meantime.
+	++pEntry->refs;
+	bool found = _pCache.load() == pEntry && pEntry->second == second && pEntry->tzd == timeZoneDifferential;
+	if (found) str.append(pEntry->text);
+	--pEntry->refs;
+	return found;
+}
+
+
+void DateTimePattern::updateCache(const std::string& str, std::string::size_type pos, Timestamp::UtcTimeVal utcTime, int timeZoneDifferential) const
+{
+	Timestamp::UtcTimeVal second = secondOf(utcTime);
+
+	FastMutex::ScopedLock lock(_cacheMutex);
+	CacheEntry* pCurrent = _pCache.load();
+	if (pCurrent && pCurrent->second == second && pCurrent->tzd == timeZoneDifferential) return;
+
+	CacheEntry* pEntry = 0;
+	for (CacheVec::iterator it = _cacheEntries.begin(); it != _cacheEntries.end() && !pEntry; ++it)
+	{
+		if (*it != pCurrent && (*it)->refs.value() == 0) pEntry = *it;
+	}
+	if (!pEntry)
+	{
+		_cacheEntries.reserve(_cacheEntries.size() + 1);
+		pEntry = new CacheEntry;
+		_cacheEntries.push_back(pEntry);
+	}
+	pEntry->text.assign(str, pos, std::string::npos);
+	pEntry->second = second;
+	pEntry->tzd    = timeZoneDifferential;
+	_pCache.exchange(pEntry);
+}
+
+
+} // namespace Poco
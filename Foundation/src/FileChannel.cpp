@@ -20,12 +20,14 @@
 #include "Poco/PurgeStrategy.h"
 #include "Poco/Message.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
 #include "Poco/LocalDateTime.h"
 #include "Poco/String.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include "Poco/Timer.h"
 
 
 namespace Poco {
@@ -40,13 +42,18 @@ const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_BUFFERSIZE   = "bufferSize";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
 
 FileChannel::FileChannel(): 
 	_times("utc"),
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
 	_pFile(0),
+	_pFlushTimer(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
 	_pPurgeStrategy(0)
@@ -60,7 +67,10 @@ FileChannel::FileChannel(const std::string& rPath):
 	_compress(false),
 	_flush(true),
 	_rotateOnOpen(false),
+	_bufferSize(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
 	_pFile(0),
+	_pFlushTimer(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
 	_pPurgeStrategy(0)
@@ -103,12 +113,23 @@ void FileChannel::open()
 				_pFile = new LogFile(_path);
 			}
 		}
+		_pFile->setBufferSize(_bufferSize);
+		fileOpened(*_pFile);
+		if (_flushInterval > 0 && !_pFlushTimer)
+		{
+			_pFlushTimer = new Timer(_flushInterval, _flushInterval);
+			_pFlushTimer->start(TimerCallback<FileChannel>(*this, &FileChannel::onFlush));
+		}
 	}
 }
 
 
 void FileChannel::close()
 {
+	// The timer must be stopped without holding the lock,
+	// as the timer callback acquires it.
+	stopFlushTimer();
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	delete _pFile;
@@ -122,6 +143,28 @@ void FileChannel::log(const Message& msg)
 
 	FastMutex::ScopedLock lock(_mutex);
 
+	rotateIfRequired();
+	_pFile->write(msg.getText(), _flush);
+}
+
+
+void FileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		rotateIfRequired();
+		_pFile->write(pMessages[i].getText(), false);
+	}
+	if (_flush) _pFile->flush();
+}
+
+
+void FileChannel::rotateIfRequired()
+{
 	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
 	{
 		try
@@ -133,17 +176,65 @@ void FileChannel::log(const Message& msg)
 		{
 			_pFile = new LogFile(_path);
 		}
+		_pFile->setBufferSize(_bufferSize);
 		// we must call mustRotate() again to give the
 		// RotateByIntervalStrategy a chance to write its timestamp
 		// to the new file.
 		_pRotateStrategy->mustRotate(_pFile);
+		fileOpened(*_pFile);
+	}
+}
+
+
+void FileChannel::fileOpened(LogFile& /*file*/)
+{
+}
+
+
+void FileChannel::logData(const char* data, std::size_t length)
+{
+	open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	rotateIfRequired();
+	_pFile->writeData(data, length, _flush);
+}
+
+
+void FileChannel::onFlush(Timer& /*timer*/)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_pFile) _pFile->flush();
+}
+
+
+void FileChannel::stopFlushTimer()
+{
+	Timer* pTimer;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		pTimer = _pFlushTimer;
+		_pFlushTimer = 0;
+	}
+	if (pTimer)
+	{
+		pTimer->stop();
+		delete pTimer;
 	}
-	_pFile->write(msg.getText(), _flush);
 }
 
 	
 void FileChannel::setProperty(const std::string& name, const std::string& value)
 {
+	// setBufferSize() takes the lock itself
+	if (name == PROP_BUFFERSIZE)
+	{
+		setBufferSize(value);
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (name == PROP_TIMES)
@@ -172,6 +263,8 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_FLUSHINTERVAL)
+		setFlushInterval(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -197,6 +290,10 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return NumberFormatter::format(_bufferSize);
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
 	else
 		return Channel::getProperty(name);
 }
@@ -345,6 +442,26 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+void FileChannel::setBufferSize(const std::string& size)
+{
+	int n = NumberParser::parse(size);
+	if (n < 0) throw InvalidArgumentException("bufferSize", size);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_bufferSize = n;
+	if (_pFile) _pFile->setBufferSize(_bufferSize);
+}
+
+
+void FileChannel::setFlushInterval(const std::string& interval)
+{
+	long n = NumberParser::parse(interval);
+	if (n < 0) throw InvalidArgumentException("flushInterval", interval);
+	_flushInterval = n;
+}
+
+
 void FileChannel::purge()
 {
 	if (_pPurgeStrategy)
@@ -21,8 +21,75 @@
 namespace Poco {
 
 
+namespace
+{
+	// Maps hex digits to their value, whitespace
+	// to 0x80 and invalid characters to 0xFF.
+	const unsigned char IN_ENCODING[256] =
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0xFF, 0xFF, 0x80, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+	};
+
+
+	std::size_t decode(const unsigned char* data, std::size_t length, unsigned char* buffer, int& carry)
+		/// Decodes the given characters, skipping whitespace.
+		/// The value of an unpaired digit is kept in carry,
+		/// which is -1 if there is none.
+	{
+		const unsigned char* end = data + length;
+		unsigned char* out = buffer;
+		while (data < end)
+		{
+			if (carry < 0)
+			{
+				while (end - data >= 2)
+				{
+					unsigned hi = IN_ENCODING[data[0]];
+					unsigned lo = IN_ENCODING[data[1]];
+					if ((hi | lo) >= 0x10) break;
+					*out++ = static_cast<unsigned char>((hi << 4) | lo);
+					data += 2;
+				}
+				if (data == end) break;
+			}
+			unsigned char value = IN_ENCODING[*data++];
+			if (value == 0xFF) throw DataFormatException();
+			if (value != 0x80)
+			{
+				if (carry < 0)
+				{
+					carry = value;
+				}
+				else
+				{
+					*out++ = static_cast<unsigned char>((carry << 4) | value);
+					carry = -1;
+				}
+			}
+		}
+		return static_cast<std::size_t>(out - buffer);
+	}
+}
+
+
 HexBinaryDecoderBuf::HexBinaryDecoderBuf(std::istream& istr): 
-	_buf(*istr.rdbuf())
+	_buf(*istr.rdbuf()),
+	_eof(false)
 {
 }
 
@@ -59,13 +126,45 @@ int HexBinaryDecoderBuf::readFromDevice()
 
 int HexBinaryDecoderBuf::readOne()
 {
+	if (_eof) return std::char_traits<char>::eof();
 	int ch = _buf.sbumpc();
 	while (ch == ' ' || ch == '\r' || ch == '\t' || ch == '\n')
 		ch = _buf.sbumpc();
+	if (ch == std::char_traits<char>::eof()) _eof = true;
 	return ch;
 }
 
 
+std::streamsize HexBinaryDecoderBuf::xsgetn(char* s, std::streamsize count)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (count <= 0) return 0;
+
+	// uflow() also returns a character put back with sungetc().
+	int c = uflow();
+	if (c == eof) return 0;
+	std::streamsize copied = 0;
+	s[copied++] = static_cast<char>(c);
+
+	// Never request more characters from the connected stream
+	// than needed for the remaining bytes.
+	char buffer[4096];
+	int carry = -1;
+	while (!_eof && copied < count)
+	{
+		std::streamsize request = 2*(count - copied) - (carry < 0 ? 0 : 1);
+		if (request > static_cast<std::streamsize>(sizeof(buffer))) request = sizeof(buffer);
+		std::streamsize n = _buf.sgetn(buffer, request);
+		if (n < request) _eof = true;
+		if (n <= 0) break;
+		copied += decode(reinterpret_cast<unsigned char*>(buffer), static_cast<std::size_t>(n), reinterpret_cast<unsigned char*>(s + copied), carry);
+	}
+	if (carry >= 0) throw DataFormatException();
+	return copied;
+}
+
+
 HexBinaryDecoderIOS::HexBinaryDecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -93,4 +192,19 @@ HexBinaryDecoder::~HexBinaryDecoder()
 }
 
 
+std::size_t HexBinaryDecoder::decodedLength(std::size_t length)
+{
+	return length/2;
+}
+
+
+std::size_t HexBinaryDecoder::decode(const char* data, std::size_t length, char* buffer)
+{
+	int carry = -1;
+	std::size_t n = Poco::decode(reinterpret_cast<const unsigned char*>(data), length, reinterpret_cast<unsigned char*>(buffer), carry);
+	if (carry >= 0) throw DataFormatException();
+	return n;
+}
+
+
 } // namespace Poco
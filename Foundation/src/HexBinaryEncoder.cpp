@@ -15,11 +15,61 @@
 
 
 #include "Poco/HexBinaryEncoder.h"
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <tmmintrin.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	const char DIGITS[] = "0123456789abcdef0123456789ABCDEF";
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	POCO_TARGET_ISA("ssse3")
+	void encodeSSSE3(const unsigned char*& data, std::size_t& length, char*& buffer, int uppercase)
+		/// Encodes 16 bytes at a time, looking up the digits
+		/// for all nibbles with a single shuffle.
+	{
+		const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(DIGITS + uppercase));
+		const __m128i mask = _mm_set1_epi8(0x0F);
+		while (length >= 16)
+		{
+			__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			__m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+			__m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 16), _mm_unpackhi_epi8(hi, lo));
+			data   += 16;
+			buffer += 32;
+			length -= 16;
+		}
+	}
+#endif
+
+
+	void encode(const unsigned char* data, std::size_t length, char* buffer, int uppercase)
+	{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (length >= 16 && CPUFeatures::hasSSSE3())
+		{
+			encodeSSSE3(data, length, buffer, uppercase);
+		}
+#endif
+		while (length-- > 0)
+		{
+			*buffer++ = DIGITS[uppercase + (*data >> 4)];
+			*buffer++ = DIGITS[uppercase + (*data & 0xF)];
+			++data;
+		}
+	}
+}
+
+
 HexBinaryEncoderBuf::HexBinaryEncoderBuf(std::ostream& ostr): 
 	_pos(0),
 	_lineLength(72),
@@ -62,11 +112,10 @@ void HexBinaryEncoderBuf::setUppercase(bool flag)
 int HexBinaryEncoderBuf::writeToDevice(char c)
 {
 	static const int eof = std::char_traits<char>::eof();
-	static const char digits[] = "0123456789abcdef0123456789ABCDEF";
 	
-	if (_buf.sputc(digits[_uppercase + ((c >> 4) & 0xF)]) == eof) return eof;
+	if (_buf.sputc(DIGITS[_uppercase + ((c >> 4) & 0xF)]) == eof) return eof;
 	++_pos;
-	if (_buf.sputc(digits[_uppercase + (c & 0xF)]) == eof) return eof;
+	if (_buf.sputc(DIGITS[_uppercase + (c & 0xF)]) == eof) return eof;
 	if (++_pos >= _lineLength && _lineLength > 0) 
 	{
 		if (_buf.sputc('\n') == eof) return eof;
@@ -76,6 +125,45 @@ int HexBinaryEncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize HexBinaryEncoderBuf::xsputn(const char* s, std::streamsize count)
+{
+	char buffer[4096];
+	std::size_t length = 0;
+	std::streamsize written = 0;
+	std::streamsize flushed = 0;
+	while (written < count)
+	{
+		std::size_t bytes = static_cast<std::size_t>(count - written);
+		if (_lineLength > 0)
+		{
+			std::size_t lineBytes = _pos < _lineLength ? (_lineLength - _pos + 1)/2 : 1;
+			if (bytes > lineBytes) bytes = lineBytes;
+		}
+		if (length + 2 + 1 > sizeof(buffer))
+		{
+			if (_buf.sputn(buffer, length) != static_cast<std::streamsize>(length)) return flushed;
+			flushed = written;
+			length = 0;
+		}
+		if (bytes > (sizeof(buffer) - length - 1)/2)
+		{
+			bytes = (sizeof(buffer) - length - 1)/2;
+		}
+		encode(reinterpret_cast<const unsigned char*>(s + written), bytes, buffer + length, _uppercase);
+		length  += 2*bytes;
+		written += bytes;
+		_pos    += 2*static_cast<int>(bytes);
+		if (_lineLength > 0 && _pos >= _lineLength)
+		{
+			buffer[length++] = '\n';
+			_pos = 0;
+		}
+	}
+	if (length > 0 && _buf.sputn(buffer, length) != static_cast<std::streamsize>(length)) return flushed;
+	return written;
+}
+
+
 int HexBinaryEncoderBuf::close()
 {
 	sync();
@@ -116,4 +204,17 @@ HexBinaryEncoder::~HexBinaryEncoder()
 }
 
 
+std::size_t HexBinaryEncoder::encodedLength(std::size_t length)
+{
+	return 2*length;
+}
+
+
+std::size_t HexBinaryEncoder::encode(const char* data, std::size_t length, char* buffer, bool uppercase)
+{
+	Poco::encode(reinterpret_cast<const unsigned char*>(data), length, buffer, uppercase ? 16 : 0);
+	return encodedLength(length);
+}
+
+
 } // namespace Poco
@@ -22,10 +22,14 @@
 namespace Poco {
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type): 
+const std::size_t InflatingStreamBuf::MAX_CHUNK_SIZE = 1024*1024*1024;
+
+
+InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type, std::size_t bufferSize): 
 	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
+	_bufferSize(bufferSize),
 	_eof(false),
 	_check(type != STREAM_ZIP)
 {
@@ -44,7 +48,7 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type):
 	_zstr.adler     = 0;
 	_zstr.reserved  = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, 15 + (type == STREAM_GZIP ? 16 : 0));
 	if (rc != Z_OK) 
@@ -55,10 +59,11 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, StreamType type):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits): 
+InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits, std::size_t bufferSize): 
 	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::in),
 	_pIstr(&istr),
 	_pOstr(0),
+	_bufferSize(bufferSize),
 	_eof(false),
 	_check(false)
 {
@@ -70,7 +75,7 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, windowBits);
 	if (rc != Z_OK) 
@@ -81,10 +86,11 @@ InflatingStreamBuf::InflatingStreamBuf(std::istream& istr, int windowBits):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type): 
+InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type, std::size_t bufferSize): 
 	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
+	_bufferSize(bufferSize),
 	_eof(false),
 	_check(type != STREAM_ZIP)
 {
@@ -96,7 +102,7 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, 15 + (type == STREAM_GZIP ? 16 : 0));
 	if (rc != Z_OK) 
@@ -107,10 +113,11 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, StreamType type):
 }
 
 
-InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits): 
+InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits, std::size_t bufferSize): 
 	BufferedStreamBuf(STREAM_BUFFER_SIZE, std::ios::out),
 	_pIstr(0),
 	_pOstr(&ostr),
+	_bufferSize(bufferSize),
 	_eof(false),
 	_check(false)
 {
@@ -122,7 +129,7 @@ InflatingStreamBuf::InflatingStreamBuf(std::ostream& ostr, int windowBits):
 	_zstr.next_out  = 0;
 	_zstr.avail_out = 0;
 
-	_buffer = new char[INFLATE_BUFFER_SIZE];
+	_buffer = new char[_bufferSize];
 
 	int rc = inflateInit2(&_zstr, windowBits);
 	if (rc != Z_OK) 
@@ -175,7 +182,7 @@ int InflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 		int n = 0;
 		if (_pIstr->good())
 		{
-			_pIstr->read(_buffer, INFLATE_BUFFER_SIZE);
+			_pIstr->read(_buffer, _bufferSize);
 			n = static_cast<int>(_pIstr->gcount());
 		}
 		_zstr.next_in   = (unsigned char*) _buffer;
@@ -185,7 +192,7 @@ int InflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 	_zstr.avail_out = static_cast<unsigned>(length);
 	for (;;)
 	{
-		int rc = inflate(&_zstr, Z_NO_FLUSH);
+		int rc = ::inflate(&_zstr, Z_NO_FLUSH);
 		if (rc == Z_DATA_ERROR && !_check)
 		{
 			if (_zstr.avail_in == 0)
@@ -209,7 +216,7 @@ int InflatingStreamBuf::readFromDevice(char* buffer, std::streamsize length)
 			int n = 0;
 			if (_pIstr->good())
 			{
-				_pIstr->read(_buffer, INFLATE_BUFFER_SIZE);
+				_pIstr->read(_buffer, _bufferSize);
 				n = static_cast<int>(_pIstr->gcount());
 			}
 			if (n > 0)
@@ -230,30 +237,30 @@ int InflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length
 	_zstr.next_in   = (unsigned char*) buffer;
 	_zstr.avail_in  = static_cast<unsigned>(length);
 	_zstr.next_out  = (unsigned char*) _buffer;
-	_zstr.avail_out = INFLATE_BUFFER_SIZE;
+	_zstr.avail_out = _bufferSize;
 	for (;;)
 	{
-		int rc = inflate(&_zstr, Z_NO_FLUSH);
+		int rc = ::inflate(&_zstr, Z_NO_FLUSH);
 		if (rc == Z_STREAM_END)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc));
 			break;
 		}
 		if (rc != Z_OK) throw IOException(zError(rc)); 
 		if (_zstr.avail_out == 0)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE);
+			_pOstr->write(_buffer, _bufferSize);
 			if (!_pOstr->good()) throw IOException(zError(rc));
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = INFLATE_BUFFER_SIZE;
+			_zstr.avail_out = _bufferSize;
 		}
 		if (_zstr.avail_in == 0)
 		{
-			_pOstr->write(_buffer, INFLATE_BUFFER_SIZE - _zstr.avail_out);
+			_pOstr->write(_buffer, _bufferSize - _zstr.avail_out);
 			if (!_pOstr->good()) throw IOException(zError(rc)); 
 			_zstr.next_out  = (unsigned char*) _buffer;
-			_zstr.avail_out = INFLATE_BUFFER_SIZE;
+			_zstr.avail_out = _bufferSize;
 			break;
 		}
 	}
@@ -269,29 +276,144 @@ int InflatingStreamBuf::sync()
 }
 
 
-InflatingIOS::InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type):
-	_buf(ostr, type)
+std::streamsize InflatingStreamBuf::xsgetn(char* buffer, std::streamsize length)
+{
+	// take what is in the stream buffer first, then inflate
+	// large reads directly into the caller's buffer
+	std::streamsize n = static_cast<std::streamsize>(egptr() - gptr());
+	if (n > 0)
+	{
+		if (n > length) n = length;
+		std::memcpy(buffer, gptr(), static_cast<std::size_t>(n));
+		gbump(static_cast<int>(n));
+	}
+	const std::streamsize maxChunk = static_cast<std::streamsize>(MAX_CHUNK_SIZE);
+	while (length - n >= STREAM_BUFFER_SIZE)
+	{
+		std::streamsize chunk = length - n < maxChunk ? length - n : maxChunk;
+		int read = readFromDevice(buffer + n, chunk);
+		if (read <= 0) return n;
+		n += read;
+		// the data in the putback area does not precede the current position anymore
+		setg(egptr(), egptr(), egptr());
+	}
+	if (n < length)
+	{
+		n += BufferedStreamBuf::xsgetn(buffer + n, length - n);
+	}
+	return n;
+}
+
+
+std::streamsize InflatingStreamBuf::xsputn(const char* buffer, std::streamsize length)
+{
+	// large writes are inflated directly from the caller's buffer
+	if (length < STREAM_BUFFER_SIZE || !_pOstr)
+		return BufferedStreamBuf::xsputn(buffer, length);
+
+	if (BufferedStreamBuf::sync()) return 0;
+	const std::streamsize maxChunk = static_cast<std::streamsize>(MAX_CHUNK_SIZE);
+	std::streamsize n = 0;
+	while (n < length)
+	{
+		std::streamsize chunk = length - n < maxChunk ? length - n : maxChunk;
+		n += writeToDevice(buffer + n, chunk);
+	}
+	return n;
+}
+
+
+std::size_t InflatingStreamBuf::inflate(const char* data, std::size_t length, Buffer<char>& buffer, StreamType type)
+{
+	return inflateBuffer(data, length, buffer, 15 + (type == STREAM_GZIP ? 16 : 0), type != STREAM_ZIP);
+}
+
+
+std::size_t InflatingStreamBuf::inflate(const char* data, std::size_t length, Buffer<char>& buffer, int windowBits)
+{
+	return inflateBuffer(data, length, buffer, windowBits, false);
+}
+
+
+std::size_t InflatingStreamBuf::inflateBuffer(const char* data, std::size_t length, Buffer<char>& buffer, int windowBits, bool check)
+{
+	z_stream zstr;
+	std::memset(&zstr, 0, sizeof(zstr));
+	int rc = inflateInit2(&zstr, windowBits);
+	if (rc != Z_OK) throw IOException(zError(rc));
+
+	std::size_t start = buffer.size();
+	std::size_t used = start;
+	std::size_t inputUsed = 0;
+	try
+	{
+		// start with room for the compressed size, and double
+		// the buffer whenever it is full
+		std::size_t capacity = start + (length < 4096 ? 4096 : length);
+		if (buffer.capacity() < capacity) buffer.setCapacity(capacity);
+		buffer.resize(buffer.capacity());
+		for (;;)
+		{
+			if (zstr.avail_in == 0 && inputUsed < length)
+			{
+				std::size_t chunk = length - inputUsed < MAX_CHUNK_SIZE ? length - inputUsed : MAX_CHUNK_SIZE;
+				zstr.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data)) + inputUsed;
+				zstr.avail_in = static_cast<uInt>(chunk);
+				inputUsed += chunk;
+			}
+			if (used == buffer.size())
+			{
+				buffer.resize(2*buffer.size());
+			}
+			std::size_t available = buffer.size() - used;
+			zstr.next_out  = reinterpret_cast<Bytef*>(buffer.begin()) + used;
+			zstr.avail_out = static_cast<uInt>(available < MAX_CHUNK_SIZE ? available : MAX_CHUNK_SIZE);
+			uInt availableOut = zstr.avail_out;
+			rc = ::inflate(&zstr, Z_NO_FLUSH);
+			used += availableOut - zstr.avail_out;
+			if (rc == Z_STREAM_END) break;
+			if (rc == Z_DATA_ERROR && !check && zstr.avail_in == 0 && inputUsed == length) break;
+			if (rc == Z_BUF_ERROR && zstr.avail_in == 0 && inputUsed == length)
+				throw IOException("unexpected end of compressed data");
+			if (rc != Z_OK && rc != Z_BUF_ERROR)
+				throw IOException(zError(rc));
+		}
+	}
+	catch (...)
+	{
+		inflateEnd(&zstr);
+		buffer.resize(start);
+		throw;
+	}
+	inflateEnd(&zstr);
+	buffer.resize(used);
+	return used - start;
+}
+
+
+InflatingIOS::InflatingIOS(std::ostream& ostr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	_buf(ostr, type, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::ostream& ostr, int windowBits):
-	_buf(ostr, windowBits)
+InflatingIOS::InflatingIOS(std::ostream& ostr, int windowBits, std::size_t bufferSize):
+	_buf(ostr, windowBits, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type):
-	_buf(istr, type)
+InflatingIOS::InflatingIOS(std::istream& istr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
+	_buf(istr, type, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
 
 
-InflatingIOS::InflatingIOS(std::istream& istr, int windowBits):
-	_buf(istr, windowBits)
+InflatingIOS::InflatingIOS(std::istream& istr, int windowBits, std::size_t bufferSize):
+	_buf(istr, windowBits, bufferSize)
 {
 	poco_ios_init(&_buf);
 }
@@ -308,16 +430,16 @@ InflatingStreamBuf* InflatingIOS::rdbuf()
 }
 
 
-InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type):
+InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
 	std::ostream(&_buf),
-	InflatingIOS(ostr, type)
+	InflatingIOS(ostr, type, bufferSize)
 {
 }
 
 
-InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, int windowBits):
+InflatingOutputStream::InflatingOutputStream(std::ostream& ostr, int windowBits, std::size_t bufferSize):
 	std::ostream(&_buf),
-	InflatingIOS(ostr, windowBits)
+	InflatingIOS(ostr, windowBits, bufferSize)
 {
 }
 
@@ -333,16 +455,16 @@ int InflatingOutputStream::close()
 }
 
 
-InflatingInputStream::InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type):
+InflatingInputStream::InflatingInputStream(std::istream& istr, InflatingStreamBuf::StreamType type, std::size_t bufferSize):
 	std::istream(&_buf),
-	InflatingIOS(istr, type)
+	InflatingIOS(istr, type, bufferSize)
 {
 }
 
 
-InflatingInputStream::InflatingInputStream(std::istream& istr, int windowBits):
+InflatingInputStream::InflatingInputStream(std::istream& istr, int windowBits, std::size_t bufferSize):
 	std::istream(&_buf),
-	InflatingIOS(istr, windowBits)
+	InflatingIOS(istr, windowBits, bufferSize)
 {
 }
 
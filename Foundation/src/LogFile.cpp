@@ -31,13 +31,81 @@
 namespace Poco {
 
 
-LogFile::LogFile(const std::string& rPath): LogFileImpl(rPath)
+namespace
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const char LINE_ENDING[] = "\r\n";
+#else
+	const char LINE_ENDING[] = "\n";
+#endif
+}
+
+
+LogFile::LogFile(const std::string& rPath): 
+	LogFileImpl(rPath),
+	_bufferSize(DEFAULT_BUFFER_SIZE)
 {
 }
 
 
 LogFile::~LogFile()
 {
+	try
+	{
+		flush();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void LogFile::write(const std::string& text, bool flush)
+{
+	_buffer.append(text);
+	_buffer.append(LINE_ENDING, sizeof(LINE_ENDING) - 1);
+	if (flush || _buffer.size() >= _bufferSize)
+		writeBuffer(flush);
+}
+
+
+void LogFile::writeData(const char* data, std::size_t length, bool flush)
+{
+	_buffer.append(data, length);
+	if (flush || _buffer.size() >= _bufferSize)
+		writeBuffer(flush);
+}
+
+
+void LogFile::flush()
+{
+	if (!_buffer.empty())
+		writeBuffer(true);
+}
+
+
+void LogFile::setBufferSize(std::size_t size)
+{
+	if (size < _buffer.size()) flush();
+	_bufferSize = size;
+}
+
+
+void LogFile::writeBuffer(bool flush)
+{
+	// The buffer is cleared even if writing fails, so that
+	// a persistent error cannot make it grow without bounds.
+	try
+	{
+		writeImpl(_buffer.data(), _buffer.size(), flush);
+	}
+	catch (...)
+	{
+		_buffer.clear();
+		throw;
+	}
+	_buffer.clear();
 }
 
 
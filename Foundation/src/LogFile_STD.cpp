@@ -17,6 +17,11 @@
 #include "Poco/LogFile_STD.h"
 #include "Poco/File.h"
 #include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
 
 
 namespace Poco {
@@ -24,9 +29,15 @@ namespace Poco {
 
 LogFileImpl::LogFileImpl(const std::string& path): 
 	_path(path),
-	_str(_path, std::ios::app)
+	_fd(-1),
+	_size(0)
 {
-	if (sizeImpl() == 0)
+	_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+	if (_fd == -1) File::handleLastError(path);
+	struct stat st;
+	if (::fstat(_fd, &st) == 0)
+		_size = st.st_size;
+	if (_size == 0)
 		_creationDate = File(path).getLastModified();
 	else
 		_creationDate = File(path).created();
@@ -35,23 +46,33 @@ LogFileImpl::LogFileImpl(const std::string& path):
 
 LogFileImpl::~LogFileImpl()
 {
+	::close(_fd);
 }
 
 
-void LogFileImpl::writeImpl(const std::string& text, bool flush)
+void LogFileImpl::writeImpl(const char* data, std::size_t length, bool /*flush*/)
 {
-	_str << text;
-	if (flush)
-		_str << std::endl;
-	else
-		_str << "\n";
-	if (!_str.good()) throw WriteFileException(_path);
+	// With O_APPEND, every write() atomically appends to the
+	// current end of the file, even if other processes write
+	// to the same file.
+	while (length > 0)
+	{
+		ssize_t n = ::write(_fd, data, length);
+		if (n < 0)
+		{
+			if (errno == EINTR) continue;
+			throw WriteFileException(_path);
+		}
+		data   += n;
+		length -= n;
+		_size  += n;
+	}
 }
 
 
 UInt64 LogFileImpl::sizeImpl() const
 {
-	return (UInt64) _str.tellp();
+	return _size;
 }
 
 
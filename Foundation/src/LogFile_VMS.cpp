@@ -39,15 +39,12 @@ LogFileImpl::~LogFileImpl()
 }
 
 
-void LogFileImpl::writeImpl(const std::string& text, bool flush)
+void LogFileImpl::writeImpl(const char* data, std::size_t length, bool flush)
 {
-	int rc = fputs(text.c_str(), _file);
-	if (rc == EOF) throw WriteFileException(_path);
-	rc = fputc('\n', _file);
-	if (rc == EOF) throw WriteFileException(_path);
+	if (fwrite(data, 1, length, _file) != length) throw WriteFileException(_path);
 	if (flush)
 	{
-		rc = fflush(_file);
+		int rc = fflush(_file);
 		if (rc == EOF) throw WriteFileException(_path);
 	}
 }
@@ -42,14 +42,12 @@ LogFileImpl::~LogFileImpl()
 }
 
 
-void LogFileImpl::writeImpl(const std::string& text, bool flush)
+void LogFileImpl::writeImpl(const char* data, std::size_t length, bool flush)
 {
 	if (INVALID_HANDLE_VALUE == _hFile)	createFile();
 
 	DWORD bytesWritten;
-	BOOL res = WriteFile(_hFile, text.data(), (DWORD) text.size(), &bytesWritten, NULL);
-	if (!res) throw WriteFileException(_path);
-	res = WriteFile(_hFile, "\r\n", 2, &bytesWritten, NULL);
+	BOOL res = WriteFile(_hFile, data, (DWORD) length, &bytesWritten, NULL);
 	if (!res) throw WriteFileException(_path);
 	if (flush)
 	{
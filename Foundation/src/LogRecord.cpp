@@ -0,0 +1,121 @@
+//
+// LogRecord.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Logging
+// Module:  LogRecord
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/LogRecord.h"
+#include "Poco/Thread.h"
+#include "Poco/Format.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+LogRecord::LogRecord(const std::string& source, const char* format, Message::Priority prio):
+	_source(source),
+	_format(format),
+	_prio(prio),
+	_tid(0),
+	_pData(_buffer),
+	_size(0),
+	_capacity(INLINE_SIZE)
+{
+	Thread* pThread = Thread::current();
+	if (pThread) _tid = pThread->id();
+}
+
+
+LogRecord::~LogRecord()
+{
+	if (_pData != _buffer) delete [] _pData;
+}
+
+
+void LogRecord::grow(std::size_t size)
+{
+	std::size_t capacity = 2*_capacity;
+	if (capacity < size) capacity = size;
+	char* pData = new char[capacity];
+	std::memcpy(pData, _pData, _size);
+	if (_pData != _buffer) delete [] _pData;
+	_pData    = pData;
+	_capacity = capacity;
+}
+
+
+void LogRecord::toMessage(Message& msg) const
+{
+	std::vector<Any> args;
+	decode(_pData, _size, args);
+	std::string text;
+	Poco::format(text, _format, args);
+	msg.setSource(_source);
+	msg.setText(text);
+	msg.setPriority(_prio);
+	msg.setTime(_time);
+	msg.setTid(_tid);
+}
+
+
+namespace
+{
+	template <typename T>
+	T extract(const char*& it, const char* end)
+	{
+		if (static_cast<std::size_t>(end - it) < sizeof(T)) throw DataFormatException("truncated log record argument");
+		T value;
+		std::memcpy(&value, it, sizeof(T));
+		it += sizeof(T);
+		return value;
+	}
+}
+
+
+void LogRecord::decode(const char* data, std::size_t size, std::vector<Any>& args)
+{
+	const char* it  = data;
+	const char* end = data + size;
+	while (it != end)
+	{
+		char type = *it++;
+		switch (type)
+		{
+		case ARG_BOOL:   args.push_back(extract<bool>(it, end)); break;
+		case ARG_CHAR:   args.push_back(extract<char>(it, end)); break;
+		case ARG_SHORT:  args.push_back(extract<short>(it, end)); break;
+		case ARG_USHORT: args.push_back(extract<unsigned short>(it, end)); break;
+		case ARG_INT:    args.push_back(extract<int>(it, end)); break;
+		case ARG_UINT:   args.push_back(extract<unsigned>(it, end)); break;
+		case ARG_LONG:   args.push_back(static_cast<long>(extract<Int64>(it, end))); break;
+		case ARG_ULONG:  args.push_back(static_cast<unsigned long>(extract<UInt64>(it, end))); break;
+		case ARG_INT64:  args.push_back(extract<Int64>(it, end)); break;
+		case ARG_UINT64: args.push_back(extract<UInt64>(it, end)); break;
+		case ARG_DOUBLE: args.push_back(extract<double>(it, end)); break;
+		case ARG_STRING:
+			{
+				UInt32 length = extract<UInt32>(it, end);
+				if (static_cast<std::size_t>(end - it) < length) throw DataFormatException("truncated log record argument");
+				args.push_back(std::string(it, length));
+				it += length;
+			}
+			break;
+		default:
+			throw DataFormatException("invalid log record argument type");
+		}
+	}
+}
+
+
+} // namespace Poco
@@ -21,11 +21,171 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/NumberParser.h"
 #include "Poco/String.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Hash.h"
+#include "Poco/AtomicPointer.h"
+#include "Poco/AtomicCounter.h"
 
 
 namespace Poco {
 
 
+namespace
+{
+	//
+	// The logger index mirrors the logger map and allows
+	// Logger::get() and Logger::has() to find existing loggers
+	// without taking the map mutex. The index is a fixed-size
+	// hash table with singly linked buckets. Nodes are added to
+	// the front of a bucket while the map mutex is held; a node,
+	// once published, is never changed except for its logger
+	// pointer, and is never deleted, as a reader may still be
+	// traversing it. A logger created again with the same name
+	// reuses the node, so there is at most one node for every
+	// distinct logger name.
+	//
+	// Lookups are counted while they are in progress. Destroying
+	// a logger, or Logger::shutdown(), clears the logger pointer
+	// in its node and retires the logger. Retired loggers are only
+	// released while no lookup is in progress, so a lookup never
+	// returns a logger that has already been released.
+	//
+
+	struct IndexNode
+	{
+		std::size_t            hash;
+		std::string            name;
+		AtomicPointer<Logger>  pLogger;
+		IndexNode*             pNext;
+	};
+
+	enum
+	{
+		INDEX_SIZE = 1024
+	};
+
+	struct LoggerIndex
+	{
+		AtomicPointer<IndexNode> buckets[INDEX_SIZE];
+		AtomicCounter            lookups;
+		std::vector<Logger*>     retired;
+	};
+
+	LoggerIndex& loggerIndex()
+	{
+		// never destroyed, as loggers may be released
+		// during the destruction of static objects
+		static LoggerIndex* pIndex = new LoggerIndex;
+		return *pIndex;
+	}
+
+	Logger* findIndexed(const std::string& name)
+	{
+		LoggerIndex& index = loggerIndex();
+		std::size_t h = hash(name);
+		++index.lookups;
+		Logger* pLogger = 0;
+		for (IndexNode* pNode = index.buckets[h & (INDEX_SIZE - 1)].load(); pNode; pNode = pNode->pNext)
+		{
+			if (pNode->hash == h && pNode->name == name)
+			{
+				pLogger = pNode->pLogger.load();
+				break;
+			}
+		}
+		--index.lookups;
+		return pLogger;
+	}
+
+	void setIndexed(const std::string& name, Logger* pLogger)
+		/// Must be called with the logger map mutex held.
+	{
+		LoggerIndex& index = loggerIndex();
+		std::size_t h = hash(name);
+		AtomicPointer<IndexNode>& head = index.buckets[h & (INDEX_SIZE - 1)];
+		for (IndexNode* pNode = head.load(); pNode; pNode = pNode->pNext)
+		{
+			if (pNode->hash == h && pNode->name == name)
+			{
+				pNode->pLogger.exchange(pLogger);
+				return;
+			}
+		}
+		if (pLogger)
+		{
+			IndexNode* pNode = new IndexNode;
+			pNode->hash  = h;
+			pNode->name  = name;
+			pNode->pLogger.exchange(pLogger);
+			pNode->pNext = head.load();
+			head.exchange(pNode);
+		}
+	}
+
+	void reserveRetired(std::size_t n)
+		/// Must be called with the logger map mutex held.
+	{
+		LoggerIndex& index = loggerIndex();
+		index.retired.reserve(index.retired.size() + n);
+	}
+
+	void retire(Logger* pLogger)
+		/// Must be called with the logger map mutex held, after
+		/// the logger has been removed from the index and space
+		/// has been reserved with reserveRetired().
+	{
+		loggerIndex().retired.push_back(pLogger);
+	}
+
+	void reclaim()
+		/// Releases all retired loggers, unless a lookup is in
+		/// progress. Must be called with the logger map mutex held.
+	{
+		LoggerIndex& index = loggerIndex();
+		if (index.lookups.value() == 0)
+		{
+			std::vector<Logger*> retired;
+			retired.swap(index.retired);
+			for (std::vector<Logger*>::iterator it = retired.begin(); it != retired.end(); ++it)
+			{
+				(*it)->release();
+			}
+		}
+	}
+
+	//
+	// Per-thread buffers for the message text and the Message
+	// object sent to the channel. Each buffer has its own busy flag,
+	// so that a channel that itself logs a message (on the same
+	// thread) falls back to temporary objects instead of overwriting
+	// the message currently being delivered.
+	//
+
+	struct LogBuffer
+	{
+		LogBuffer():
+			textBusy(false),
+			messageBusy(false)
+		{
+		}
+
+		std::string text;
+		Message     message;
+		bool        textBusy;
+		bool        messageBusy;
+	};
+
+	enum
+	{
+		MAX_BUFFER_CAPACITY = 65536 /// larger buffers are released after use
+	};
+
+	ThreadLocal<LogBuffer> logBuffer;
+}
+
+
 Logger::LoggerMap* Logger::_pLoggerMap = 0;
 Mutex Logger::_mapMtx;
 const std::string Logger::ROOT;
@@ -89,6 +249,51 @@ void Logger::log(const Message& msg)
 }
 
 
+void Logger::logRecord(const LogRecord& record)
+{
+	if (_level >= record.getPriority() && _pChannel)
+	{
+		_pChannel->logRecord(record);
+	}
+}
+
+
+void Logger::sendMessage(const std::string& text, Message::Priority prio, const char* file, int line)
+{
+	Thread* pThread = Thread::current();
+	if (pThread)
+	{
+		LogBuffer& buffer = logBuffer.get();
+		if (!buffer.messageBusy)
+		{
+			buffer.messageBusy = true;
+			try
+			{
+				Message& msg = buffer.message;
+				msg.setSource(_name);
+				msg.setText(text);
+				msg.setPriority(prio);
+				msg.setTime(Timestamp());
+				msg.setThread(pThread->name());
+				msg.setSourceFile(file);
+				msg.setSourceLine(line);
+				_pChannel->log(msg);
+			}
+			catch (...)
+			{
+				buffer.messageBusy = false;
+				throw;
+			}
+			if (text.size() > MAX_BUFFER_CAPACITY)
+				buffer.message = Message();
+			buffer.messageBusy = false;
+			return;
+		}
+	}
+	_pChannel->log(Message(_name, text, prio, file, line));
+}
+
+
 void Logger::log(const Exception& exc)
 {
 	error(exc.displayText());
@@ -284,6 +489,9 @@ void Logger::formatDump(std::string& message, const void* buffer, std::size_t le
 
 Logger& Logger::get(const std::string& name)
 {
+	Logger* pLogger = findIndexed(name);
+	if (pLogger) return *pLogger;
+
 	Mutex::ScopedLock lock(_mapMtx);
 
 	return unsafeGet(name);
@@ -323,17 +531,13 @@ Logger& Logger::create(const std::string& name, Channel* pChannel, int level)
 
 Logger& Logger::root()
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
-	return unsafeGet(ROOT);
+	return get(ROOT);
 }
 
 
 Logger* Logger::has(const std::string& name)
 {
-	Mutex::ScopedLock lock(_mapMtx);
-
-	return find(name);
+	return findIndexed(name);
 }
 
 
@@ -343,13 +547,16 @@ void Logger::shutdown()
 
 	if (_pLoggerMap)
 	{
+		reserveRetired(_pLoggerMap->size());
 		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
-			it->second->release();
+			setIndexed(it->first, 0);
+			retire(it->second);
 		}
 		delete _pLoggerMap;
 		_pLoggerMap = 0;
 	}
+	reclaim();
 }
 
 
@@ -374,10 +581,13 @@ void Logger::destroy(const std::string& name)
 		LoggerMap::iterator it = _pLoggerMap->find(name);
 		if (it != _pLoggerMap->end())
 		{
-			it->second->release();
+			reserveRetired(1);
+			setIndexed(name, 0);
+			retire(it->second);
 			_pLoggerMap->erase(it);
 		}
 	}
+	reclaim();
 }
 
 
@@ -479,6 +689,37 @@ void Logger::add(Logger* pLogger)
 	if (!_pLoggerMap)
 		_pLoggerMap = new LoggerMap;
 	_pLoggerMap->insert(LoggerMap::value_type(pLogger->name(), pLogger));
+	setIndexed(pLogger->name(), pLogger);
+	reclaim();
+}
+
+
+Logger::FormatBuffer::FormatBuffer():
+	_pText(&_text),
+	_pBusy(0)
+{
+	if (Thread::current())
+	{
+		LogBuffer& buffer = logBuffer.get();
+		if (!buffer.textBusy)
+		{
+			buffer.textBusy = true;
+			buffer.text.clear();
+			_pText = &buffer.text;
+			_pBusy = &buffer.textBusy;
+		}
+	}
+}
+
+
+Logger::FormatBuffer::~FormatBuffer()
+{
+	if (_pBusy)
+	{
+		if (_pText->capacity() > MAX_BUFFER_CAPACITY)
+			std::string().swap(*_pText);
+		*_pBusy = false;
+	}
 }
 
 
@@ -0,0 +1,81 @@
+//
+// MappedFile.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFile.h"
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "MappedFile_WIN32.cpp"
+#else
+#include "MappedFile_POSIX.cpp"
+#endif
+
+
+namespace Poco {
+
+
+MappedFile::MappedFile():
+	_mapped(false)
+{
+}
+
+
+MappedFile::MappedFile(const std::string& path, AccessMode mode, int options):
+	_mapped(false)
+{
+	map(path, mode, options);
+}
+
+
+MappedFile::~MappedFile()
+{
+}
+
+
+void MappedFile::map(const std::string& path, AccessMode mode, int options)
+{
+	unmap();
+	mapImpl(path, mode == AM_WRITE, (options & MF_PREFETCH) != 0, (options & MF_HUGE_PAGES) != 0);
+	_path   = path;
+	_mapped = true;
+}
+
+
+void MappedFile::unmap()
+{
+	unmapImpl();
+	_path.clear();
+	_mapped = false;
+}
+
+
+void MappedFile::advise(Advice advice)
+{
+	adviseImpl(advice, 0, _size);
+}
+
+
+void MappedFile::advise(Advice advice, std::size_t offset, std::size_t length)
+{
+	adviseImpl(advice, offset, length);
+}
+
+
+void MappedFile::flush()
+{
+	flushImpl();
+}
+
+
+} // namespace Poco
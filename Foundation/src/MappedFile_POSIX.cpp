@@ -0,0 +1,138 @@
+//
+// MappedFile_POSIX.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFile_POSIX.h"
+#include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits>
+
+
+namespace Poco {
+
+
+MappedFileImpl::MappedFileImpl():
+	_address(0),
+	_size(0)
+{
+}
+
+
+MappedFileImpl::~MappedFileImpl()
+{
+	unmapImpl();
+}
+
+
+void MappedFileImpl::mapImpl(const std::string& path, bool write, bool prefetch, bool hugePages)
+{
+	int fd = ::open(path.c_str(), write ? O_RDWR : O_RDONLY);
+	if (fd == -1)
+	{
+		switch (errno)
+		{
+		case ENOENT:
+		case ENOTDIR:
+			throw FileNotFoundException(path, errno);
+		case EACCES:
+		case EPERM:
+		case EROFS:
+			throw FileAccessDeniedException(path, errno);
+		default:
+			throw OpenFileException(path, errno);
+		}
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || static_cast<UInt64>(st.st_size) > std::numeric_limits<std::size_t>::max())
+	{
+		::close(fd);
+		throw OpenFileException("Cannot map file", path);
+	}
+
+	// mmap() fails for an empty file, which is mapped as an empty range
+	std::size_t size = static_cast<std::size_t>(st.st_size);
+	if (size > 0)
+	{
+		int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+		if (prefetch) flags |= MAP_POPULATE;
+#endif
+		void* addr = ::mmap(0, size, write ? PROT_READ | PROT_WRITE : PROT_READ, flags, fd, 0);
+		if (addr == MAP_FAILED)
+		{
+			::close(fd);
+			throw SystemException("Cannot map file", path);
+		}
+		_address = static_cast<char*>(addr);
+		_size    = size;
+
+#if !defined(MAP_POPULATE)
+		if (prefetch) adviseImpl(MappedFile::ADVICE_WILLNEED, 0, size);
+#endif
+#if defined(MADV_HUGEPAGE)
+		if (hugePages) ::madvise(addr, size, MADV_HUGEPAGE);
+#endif
+	}
+	::close(fd);
+}
+
+
+void MappedFileImpl::unmapImpl()
+{
+	if (_address)
+	{
+		::munmap(_address, _size);
+		_address = 0;
+	}
+	_size = 0;
+}
+
+
+void MappedFileImpl::adviseImpl(int advice, std::size_t offset, std::size_t length)
+{
+#if defined(MADV_NORMAL)
+	static const int ADVICE[] =
+	{
+		MADV_NORMAL,
+		MADV_SEQUENTIAL,
+		MADV_RANDOM,
+		MADV_WILLNEED,
+		MADV_DONTNEED
+	};
+
+	if (offset >= _size) return;
+
+	std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	std::size_t begin = offset - offset % pageSize;
+	std::size_t end = length < _size - offset ? offset + length : _size;
+	::madvise(_address + begin, end - begin, ADVICE[advice]);
+#endif
+}
+
+
+void MappedFileImpl::flushImpl()
+{
+	if (_address && ::msync(_address, _size, MS_SYNC) != 0)
+		throw SystemException("Cannot flush mapped file");
+}
+
+
+} // namespace Poco
@@ -0,0 +1,117 @@
+//
+// MappedFile_WIN32.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFile_WIN32.h"
+#include "Poco/Exception.h"
+#if defined (POCO_WIN32_UTF8)
+#include "Poco/UnicodeConverter.h"
+#endif
+#include "Poco/UnWindows.h"
+#include <limits>
+
+
+namespace Poco {
+
+
+MappedFileImpl::MappedFileImpl():
+	_address(0),
+	_size(0)
+{
+}
+
+
+MappedFileImpl::~MappedFileImpl()
+{
+	unmapImpl();
+}
+
+
+void MappedFileImpl::mapImpl(const std::string& path, bool write, bool, bool)
+{
+	DWORD access = write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+#if defined (POCO_WIN32_UTF8)
+	std::wstring upath;
+	UnicodeConverter::toUTF16(path, upath);
+	HANDLE hFile = CreateFileW(upath.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+	HANDLE hFile = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		DWORD err = GetLastError();
+		switch (err)
+		{
+		case ERROR_FILE_NOT_FOUND:
+		case ERROR_PATH_NOT_FOUND:
+			throw FileNotFoundException(path, err);
+		case ERROR_ACCESS_DENIED:
+		case ERROR_SHARING_VIOLATION:
+			throw FileAccessDeniedException(path, err);
+		default:
+			throw OpenFileException(path, err);
+		}
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || static_cast<UInt64>(size.QuadPart) > std::numeric_limits<std::size_t>::max())
+	{
+		CloseHandle(hFile);
+		throw OpenFileException("Cannot map file", path);
+	}
+
+	// an empty file cannot be mapped, and is mapped as an empty range
+	if (size.QuadPart > 0)
+	{
+		HANDLE hMapping = CreateFileMapping(hFile, NULL, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+		void* addr = hMapping ? MapViewOfFile(hMapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : 0;
+		if (hMapping) CloseHandle(hMapping);
+		if (!addr)
+		{
+			CloseHandle(hFile);
+			throw SystemException("Cannot map file", path);
+		}
+		_address = static_cast<char*>(addr);
+		_size    = static_cast<std::size_t>(size.QuadPart);
+	}
+	CloseHandle(hFile);
+}
+
+
+void MappedFileImpl::unmapImpl()
+{
+	if (_address)
+	{
+		UnmapViewOfFile(_address);
+		_address = 0;
+	}
+	_size = 0;
+}
+
+
+void MappedFileImpl::adviseImpl(int, std::size_t, std::size_t)
+{
+	// access pattern hints are not supported
+}
+
+
+void MappedFileImpl::flushImpl()
+{
+	if (_address && !FlushViewOfFile(_address, 0))
+		throw SystemException("Cannot flush mapped file");
+}
+
+
+} // namespace Poco
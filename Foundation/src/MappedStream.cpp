@@ -0,0 +1,97 @@
+//
+// MappedStream.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedStream
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedStream.h"
+
+
+namespace Poco {
+
+
+MappedStreamBuf::MappedStreamBuf(const std::string& path, int options):
+	_file(path, MappedFile::AM_READ, options)
+{
+	setg(_file.begin(), _file.begin(), _file.end());
+}
+
+
+MappedStreamBuf::~MappedStreamBuf()
+{
+}
+
+
+void MappedStreamBuf::close()
+{
+	setg(0, 0, 0);
+	_file.unmap();
+}
+
+
+MappedStreamBuf::pos_type MappedStreamBuf::seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which)
+{
+	if (!(which & std::ios::in)) return pos_type(off_type(-1));
+
+	off_type pos;
+	if (dir == std::ios::beg)
+		pos = off;
+	else if (dir == std::ios::cur)
+		pos = static_cast<off_type>(gptr() - eback()) + off;
+	else
+		pos = static_cast<off_type>(_file.size()) + off;
+
+	if (pos < 0 || pos > static_cast<off_type>(_file.size())) return pos_type(off_type(-1));
+
+	setg(eback(), eback() + pos, egptr());
+	return pos_type(pos);
+}
+
+
+MappedStreamBuf::pos_type MappedStreamBuf::seekpos(pos_type pos, std::ios::openmode which)
+{
+	return seekoff(off_type(pos), std::ios::beg, which);
+}
+
+
+MappedIOS::MappedIOS(const std::string& path, int options):
+	_buf(path, options)
+{
+	poco_ios_init(&_buf);
+}
+
+
+MappedIOS::~MappedIOS()
+{
+}
+
+
+void MappedIOS::close()
+{
+	_buf.close();
+}
+
+
+MappedInputStream::MappedInputStream(const std::string& path, int options):
+	MappedIOS(path, options),
+	std::istream(&_buf)
+{
+}
+
+
+MappedInputStream::~MappedInputStream()
+{
+}
+
+
+} // namespace Poco
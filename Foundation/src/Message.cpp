@@ -139,6 +139,36 @@ Message& Message::operator = (const Message& msg)
 }
 
 
+void Message::assign(const Message& msg)
+{
+	if (&msg != this)
+	{
+		if (msg._pMap)
+		{
+			if (_pMap)
+				*_pMap = *msg._pMap;
+			else
+				_pMap = new StringMap(*msg._pMap);
+		}
+		else if (_pMap)
+		{
+			delete _pMap;
+			_pMap = 0;
+		}
+		_source = msg._source;
+		_text   = msg._text;
+		_prio   = msg._prio;
+		_time   = msg._time;
+		_tid    = msg._tid;
+		_ostid  = msg._ostid;
+		_thread = msg._thread;
+		_pid    = msg._pid;
+		_file   = msg._file;
+		_line   = msg._line;
+	}
+}
+
+
 void Message::swap(Message& msg)
 {
 	using std::swap;
@@ -147,6 +177,7 @@ void Message::swap(Message& msg)
 	swap(_prio, msg._prio);
 	swap(_time, msg._time);
 	swap(_tid, msg._tid);
+	swap(_ostid, msg._ostid);
 	swap(_thread, msg._thread);
 	swap(_pid, msg._pid);
 	swap(_file, msg._file);
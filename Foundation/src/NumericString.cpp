@@ -35,6 +35,10 @@ poco_static_assert(POCO_MAX_FLT_STRING_LEN == double_conversion::kMaxSignificant
 #include "Poco/String.h"
 #include <memory>
 #include <cctype>
+#include <cstring>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 
 namespace {
@@ -162,12 +166,504 @@ void insertThousandSep(std::string& str, char thSep, char decSep = '.')
 }
 
 
+//
+// Integer to string conversion
+//
+
+
+const char DIGIT_PAIRS[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+
+template <typename T>
+inline char* formatDigits(T value, char* pEnd)
+	/// Writes the decimal digits of value backwards, ending at pEnd,
+	/// and returns a pointer to the first digit. Two digits are
+	/// produced per division.
+{
+	while (value >= 100)
+	{
+		const char* pPair = DIGIT_PAIRS + 2*(value % 100);
+		value /= 100;
+		*--pEnd = pPair[1];
+		*--pEnd = pPair[0];
+	}
+	if (value >= 10)
+	{
+		const char* pPair = DIGIT_PAIRS + 2*value;
+		*--pEnd = pPair[1];
+		*--pEnd = pPair[0];
+	}
+	else *--pEnd = static_cast<char>('0' + value);
+	return pEnd;
+}
+
+
+inline char* formatDigits64(Poco::UInt64 value, char* pEnd)
+	/// Like formatDigits(), but uses 32-bit arithmetic if the value
+	/// allows, as 64-bit divisions are expensive on 32-bit platforms.
+{
+	if (value <= 0xFFFFFFFFU)
+		return formatDigits(static_cast<Poco::UInt32>(value), pEnd);
+	else
+		return formatDigits(value, pEnd);
+}
+
+
+//
+// Shortest double to string conversion
+//
+// This is an implementation of Ulf Adams' Ryu algorithm, described in
+// "Ryu: Fast Float-to-String Conversion" (PLDI 2018). Like the Grisu3
+// and bignum algorithms of double-conversion, it finds the shortest
+// digit string that correctly rounds back to the original value, but
+// it needs no fallback and only a few 64x128-bit multiplications.
+//
+
+
+#include "d2s-tables.h"
+
+
+const int DOUBLE_MANTISSA_BITS = 52;
+const int DOUBLE_EXPONENT_BITS = 11;
+const int DOUBLE_BIAS = 1023;
+
+
+inline Poco::Int32 pow5Bits(Poco::Int32 e)
+	/// Returns ceil(log2(5^e)) for 0 < e <= 3528, and 1 for e == 0.
+{
+	return static_cast<Poco::Int32>(((static_cast<Poco::UInt32>(e) * 1217359) >> 19) + 1);
+}
+
+
+inline Poco::UInt32 log10Pow2(Poco::Int32 e)
+	/// Returns floor(log10(2^e)) for 0 <= e <= 1650.
+{
+	return (static_cast<Poco::UInt32>(e) * 78913) >> 18;
+}
+
+
+inline Poco::UInt32 log10Pow5(Poco::Int32 e)
+	/// Returns floor(log10(5^e)) for 0 <= e <= 2620.
+{
+	return (static_cast<Poco::UInt32>(e) * 732923) >> 20;
+}
+
+
+inline bool multipleOfPowerOf5(Poco::UInt64 value, Poco::UInt32 p)
+{
+	Poco::UInt32 count = 0;
+	while (value % 5 == 0)
+	{
+		value /= 5;
+		++count;
+	}
+	return count >= p;
+}
+
+
+inline bool multipleOfPowerOf2(Poco::UInt64 value, Poco::UInt32 p)
+{
+	return (value & ((Poco::UInt64(1) << p) - 1)) == 0;
+}
+
+
+inline Poco::UInt64 umul128(Poco::UInt64 a, Poco::UInt64 b, Poco::UInt64& high)
+	/// Returns the lower 64 bits of the 128-bit product of a and b,
+	/// and stores the upper 64 bits in high.
+{
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 UInt128;
+	UInt128 product = static_cast<UInt128>(a) * b;
+	high = static_cast<Poco::UInt64>(product >> 64);
+	return static_cast<Poco::UInt64>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(a, b, &high);
+#else
+	Poco::UInt64 aLow = a & 0xFFFFFFFFU;
+	Poco::UInt64 aHigh = a >> 32;
+	Poco::UInt64 bLow = b & 0xFFFFFFFFU;
+	Poco::UInt64 bHigh = b >> 32;
+	Poco::UInt64 lowLow = aLow * bLow;
+	Poco::UInt64 lowHigh = aLow * bHigh;
+	Poco::UInt64 highLow = aHigh * bLow;
+	Poco::UInt64 highHigh = aHigh * bHigh;
+	Poco::UInt64 mid1 = highLow + (lowLow >> 32);
+	Poco::UInt64 mid2 = lowHigh + (mid1 & 0xFFFFFFFFU);
+	high = highHigh + (mid1 >> 32) + (mid2 >> 32);
+	return (mid2 << 32) | (lowLow & 0xFFFFFFFFU);
+#endif
+}
+
+
+inline Poco::UInt64 mulShift64(Poco::UInt64 m, const Poco::UInt64* mul, Poco::Int32 j)
+	/// Returns (m * mul) >> j, where mul is a 128-bit number
+	/// and 64 < j < 128.
+{
+	Poco::UInt64 high1;
+	Poco::UInt64 low1 = umul128(m, mul[1], high1);
+	Poco::UInt64 high0;
+	umul128(m, mul[0], high0);
+	Poco::UInt64 sum = high0 + low1;
+	if (sum < high0) ++high1;
+	Poco::Int32 shift = j - 64;
+	poco_assert_dbg (shift > 0 && shift < 64);
+	return (high1 << (64 - shift)) | (sum >> shift);
+}
+
+
+void shortestDecimal(Poco::UInt64 ieeeMantissa, Poco::Int32 ieeeExponent, Poco::UInt64& digits, Poco::Int32& exponent)
+	/// Computes the shortest decimal representation digits * 10^exponent
+	/// of a finite, non-zero double given by its IEEE mantissa and exponent.
+{
+	if (ieeeExponent != 0)
+	{
+		// Integers below 2^53 are their own shortest representation,
+		// apart from trailing zeros, which are removed by the caller.
+		const Poco::Int32 e2 = ieeeExponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS;
+		const Poco::UInt64 m2 = (Poco::UInt64(1) << DOUBLE_MANTISSA_BITS) | ieeeMantissa;
+		if (e2 <= 0 && e2 >= -DOUBLE_MANTISSA_BITS && (m2 & ((Poco::UInt64(1) << -e2) - 1)) == 0)
+		{
+			digits = m2 >> -e2;
+			exponent = 0;
+			return;
+		}
+	}
+
+	Poco::Int32 e2;
+	Poco::UInt64 m2;
+	if (ieeeExponent == 0)
+	{
+		// subnormal number; subtract 2 so that the bounds computation has 2 additional bits
+		e2 = 1 - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = ieeeMantissa;
+	}
+	else
+	{
+		e2 = ieeeExponent - DOUBLE_BIAS - DOUBLE_MANTISSA_BITS - 2;
+		m2 = (Poco::UInt64(1) << DOUBLE_MANTISSA_BITS) | ieeeMantissa;
+	}
+	const bool even = (m2 & 1) == 0;
+	const bool acceptBounds = even;
+
+	// Step 2: determine the interval of valid decimal representations,
+	// [mm, mp], around the value mv, all scaled by four.
+	const Poco::UInt64 mv = 4 * m2;
+	// The lower boundary is closer if the mantissa is zero (except for the smallest normal).
+	const Poco::UInt32 mmShift = (ieeeMantissa != 0 || ieeeExponent <= 1) ? 1 : 0;
+
+	// Step 3: convert to a decimal power base using 128-bit arithmetic.
+	Poco::UInt64 vr, vp, vm;
+	Poco::Int32 e10;
+	bool vmIsTrailingZeros = false;
+	bool vrIsTrailingZeros = false;
+	if (e2 >= 0)
+	{
+		const Poco::UInt32 q = log10Pow2(e2) - (e2 > 3 ? 1 : 0);
+		e10 = static_cast<Poco::Int32>(q);
+		const Poco::Int32 k = POW5_INV_BITCOUNT + pow5Bits(static_cast<Poco::Int32>(q)) - 1;
+		const Poco::Int32 i = -e2 + static_cast<Poco::Int32>(q) + k;
+		poco_assert_dbg (q < static_cast<Poco::UInt32>(POW5_INV_TABLE_SIZE));
+		vr = mulShift64(4 * m2, POW5_INV_SPLIT[q], i);
+		vp = mulShift64(4 * m2 + 2, POW5_INV_SPLIT[q], i);
+		vm = mulShift64(4 * m2 - 1 - mmShift, POW5_INV_SPLIT[q], i);
+		if (q <= 21)
+		{
+			// Only one of mp, mv and mm can be a multiple of 5, if any.
+			if (mv % 5 == 0)
+				vrIsTrailingZeros = multipleOfPowerOf5(mv, q);
+			else if (acceptBounds)
+				vmIsTrailingZeros = multipleOfPowerOf5(mv - 1 - mmShift, q);
+			else
+				vp -= multipleOfPowerOf5(mv + 2, q) ? 1 : 0;
+		}
+	}
+	else
+	{
+		const Poco::UInt32 q = log10Pow5(-e2) - (-e2 > 1 ? 1 : 0);
+		e10 = static_cast<Poco::Int32>(q) + e2;
+		const Poco::Int32 i = -e2 - static_cast<Poco::Int32>(q);
+		const Poco::Int32 k = pow5Bits(i) - POW5_BITCOUNT;
+		const Poco::Int32 j = static_cast<Poco::Int32>(q) - k;
+		poco_assert_dbg (i < POW5_TABLE_SIZE);
+		vr = mulShift64(4 * m2, POW5_SPLIT[i], j);
+		vp = mulShift64(4 * m2 + 2, POW5_SPLIT[i], j);
+		vm = mulShift64(4 * m2 - 1 - mmShift, POW5_SPLIT[i], j);
+		if (q <= 1)
+		{
+			// mv, mp and mm have at least q trailing zero bits, as they are multiples of four.
+			vrIsTrailingZeros = true;
+			if (acceptBounds)
+				vmIsTrailingZeros = mmShift == 1;
+			else
+				--vp;
+		}
+		else if (q < 63)
+		{
+			vrIsTrailingZeros = multipleOfPowerOf2(mv, q);
+		}
+	}
+
+	// Step 4: find the shortest decimal representation in the interval.
+	Poco::Int32 removed = 0;
+	Poco::UInt64 output;
+	if (vmIsTrailingZeros || vrIsTrailingZeros)
+	{
+		// general case, which happens rarely
+		Poco::UInt32 lastRemovedDigit = 0;
+		while (vp / 10 > vm / 10)
+		{
+			vmIsTrailingZeros &= vm % 10 == 0;
+			vrIsTrailingZeros &= lastRemovedDigit == 0;
+			lastRemovedDigit = static_cast<Poco::UInt32>(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		if (vmIsTrailingZeros)
+		{
+			while (vm % 10 == 0)
+			{
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = static_cast<Poco::UInt32>(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				++removed;
+			}
+		}
+		if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+		{
+			// round even if the exact value is .....50..0
+			lastRemovedDigit = 4;
+		}
+		output = vr + (((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5) ? 1 : 0);
+	}
+	else
+	{
+		// common case, where no trailing zeros have to be tracked
+		bool roundUp = false;
+		if (vp / 100 > vm / 100)
+		{
+			// remove two digits at a time, as there are usually at least 16 to remove
+			roundUp = vr % 100 >= 50;
+			vr /= 100;
+			vp /= 100;
+			vm /= 100;
+			removed += 2;
+		}
+		while (vp / 10 > vm / 10)
+		{
+			roundUp = vr % 10 >= 5;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++removed;
+		}
+		output = vr + ((vr == vm || roundUp) ? 1 : 0);
+	}
+	exponent = e10 + removed;
+	digits = output;
+}
+
+
+void appendDecimal(double_conversion::StringBuilder& builder, const char* digits, int length, int decimalPoint)
+	/// Appends digits in decimal notation, the same way as
+	/// DoubleToStringConverter::ToShortest() does.
+{
+	if (decimalPoint <= 0)
+	{
+		builder.AddCharacter('0');
+		builder.AddCharacter('.');
+		builder.AddPadding('0', -decimalPoint);
+		builder.AddSubstring(digits, length);
+	}
+	else if (decimalPoint >= length)
+	{
+		builder.AddSubstring(digits, length);
+		builder.AddPadding('0', decimalPoint - length);
+	}
+	else
+	{
+		builder.AddSubstring(digits, decimalPoint);
+		builder.AddCharacter('.');
+		builder.AddSubstring(digits + decimalPoint, length - decimalPoint);
+	}
+}
+
+
+void appendExponential(double_conversion::StringBuilder& builder, const char* digits, int length, int exponent)
+	/// Appends digits in exponential notation, the same way as
+	/// DoubleToStringConverter::ToShortest() does.
+{
+	builder.AddCharacter(digits[0]);
+	if (length != 1)
+	{
+		builder.AddCharacter('.');
+		builder.AddSubstring(digits + 1, length - 1);
+	}
+	builder.AddCharacter(POCO_FLT_EXP);
+	if (exponent < 0)
+	{
+		builder.AddCharacter('-');
+		exponent = -exponent;
+	}
+	else builder.AddCharacter('+');
+	char buffer[8];
+	char* pEnd = buffer + sizeof(buffer);
+	char* pBeg = formatDigits(static_cast<Poco::UInt32>(exponent), pEnd);
+	builder.AddSubstring(pBeg, static_cast<int>(pEnd - pBeg));
+}
+
+
+//
+// String to double conversion
+//
+
+
+const double EXACT_POWERS_OF_TEN[] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+	1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+	1e20, 1e21, 1e22
+};
+const int MAX_EXACT_POWER_OF_TEN = 22;
+const int MAX_EXACT_DIGITS = 15;
+
+
+inline bool isDigit(char c)
+{
+	return static_cast<unsigned>(c - '0') < 10;
+}
+
+
+bool strToDoubleFast(const char* pStr, std::size_t length, char decSep, double& result, bool& plain)
+	/// Converts plain decimal numbers ([+-]digits[.digits][(e|E)[+-]digits])
+	/// with up to 15 significant digits and a decimal exponent within
+	/// [-22, 22], which covers most numbers found in JSON documents,
+	/// CSV files and configuration files, without any copying.
+	/// As both the significand and the power of ten are exactly
+	/// representable, a single multiplication or division gives the
+	/// correctly rounded result (Clinger's fast path).
+	///
+	/// Returns false if the number could not be converted. In this case,
+	/// plain is set to true if the number is a plain decimal number
+	/// that can be passed to double-conversion without preprocessing.
+{
+	plain = false;
+	const char* pEnd = pStr + length;
+	bool negative = false;
+	if (pStr != pEnd && (*pStr == '-' || *pStr == '+'))
+	{
+		negative = *pStr == '-';
+		++pStr;
+	}
+	Poco::UInt64 significand = 0;
+	int significantDigits = 0;
+	int exponent = 0;
+	bool haveDigits = false;
+	for (; pStr != pEnd && isDigit(*pStr); ++pStr)
+	{
+		haveDigits = true;
+		if (significand || *pStr != '0')
+		{
+			if (++significantDigits <= MAX_EXACT_DIGITS) significand = significand*10 + (*pStr - '0');
+		}
+	}
+	if (pStr != pEnd && *pStr == decSep)
+	{
+		for (++pStr; pStr != pEnd && isDigit(*pStr); ++pStr)
+		{
+			haveDigits = true;
+			if (significand || *pStr != '0')
+			{
+				if (++significantDigits <= MAX_EXACT_DIGITS) significand = significand*10 + (*pStr - '0');
+			}
+			--exponent;
+		}
+	}
+	if (!haveDigits) return false;
+	if (pStr != pEnd && (*pStr == 'e' || *pStr == 'E'))
+	{
+		++pStr;
+		bool negativeExponent = false;
+		if (pStr != pEnd && (*pStr == '-' || *pStr == '+'))
+		{
+			negativeExponent = *pStr == '-';
+			++pStr;
+		}
+		if (pStr == pEnd || !isDigit(*pStr)) return false;
+		int explicitExponent = 0;
+		for (; pStr != pEnd && isDigit(*pStr); ++pStr)
+		{
+			if (explicitExponent < 100000) explicitExponent = explicitExponent*10 + (*pStr - '0');
+		}
+		exponent += negativeExponent ? -explicitExponent : explicitExponent;
+	}
+	if (pStr != pEnd) return false;
+	plain = true;
+
+#if defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+	if (significantDigits > MAX_EXACT_DIGITS) return false;
+	if (significand == 0)
+	{
+		result = negative ? -0.0 : 0.0;
+		return true;
+	}
+	if (exponent < -MAX_EXACT_POWER_OF_TEN || exponent > MAX_EXACT_POWER_OF_TEN) return false;
+	double value = static_cast<double>(static_cast<Poco::Int64>(significand));
+	if (exponent < 0)
+		value /= EXACT_POWERS_OF_TEN[-exponent];
+	else
+		value *= EXACT_POWERS_OF_TEN[exponent];
+	result = negative ? -value : value;
+	return true;
+#else
+	// On platforms with extended precision floating point
+	// registers, the result could be rounded twice.
+	return false;
+#endif
+}
+
+
 } // namespace
 
 
 namespace Poco {
 
 
+void Impl::decimalToStr(UInt64 magnitude, bool negative, char* result, std::size_t& size, int width, char fill)
+{
+	char buffer[24];
+	char* pEnd = buffer + sizeof(buffer);
+	char* pBeg = formatDigits64(magnitude, pEnd);
+	std::size_t digits = pEnd - pBeg;
+	std::size_t length = digits + (negative ? 1 : 0);
+	std::size_t padding = (width > 0 && static_cast<std::size_t>(width) > length) ? width - length : 0;
+	if (length + padding >= size) throw RangeException();
+
+	char* pResult = result;
+	if (negative && fill == '0') *pResult++ = '-';
+	std::memset(pResult, fill, padding);
+	pResult += padding;
+	if (negative && fill != '0') *pResult++ = '-';
+	std::memcpy(pResult, pBeg, digits);
+	pResult += digits;
+	*pResult = '\0';
+	size = pResult - result;
+}
+
+
 void floatToStr(char* buffer, int bufferSize, float value, int lowDec, int highDec)
 {
 	using namespace double_conversion;
@@ -235,10 +731,57 @@ void doubleToStr(char* buffer, int bufferSize, double value, int lowDec, int hig
 	using namespace double_conversion;
 
 	StringBuilder builder(buffer, bufferSize);
-	int flags = DoubleToStringConverter::UNIQUE_ZERO |
-		DoubleToStringConverter::EMIT_POSITIVE_EXPONENT_SIGN;
-	DoubleToStringConverter dc(flags, POCO_FLT_INF, POCO_FLT_NAN, POCO_FLT_EXP, lowDec, highDec, 0, 0);
-	dc.ToShortest(value, &builder);
+	UInt64 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const bool negative = (bits >> (DOUBLE_MANTISSA_BITS + DOUBLE_EXPONENT_BITS)) != 0;
+	const Int32 ieeeExponent = static_cast<Int32>((bits >> DOUBLE_MANTISSA_BITS) & ((1 << DOUBLE_EXPONENT_BITS) - 1));
+	const UInt64 ieeeMantissa = bits & ((UInt64(1) << DOUBLE_MANTISSA_BITS) - 1);
+	if (ieeeExponent == (1 << DOUBLE_EXPONENT_BITS) - 1)
+	{
+		if (ieeeMantissa)
+		{
+			builder.AddString(POCO_FLT_NAN);
+		}
+		else
+		{
+			if (negative) builder.AddCharacter('-');
+			builder.AddString(POCO_FLT_INF);
+		}
+	}
+	else
+	{
+		char digits[24];
+		char* pEnd = digits + sizeof(digits);
+		char* pBeg;
+		int decimalPoint;
+		if (ieeeExponent == 0 && ieeeMantissa == 0)
+		{
+			// negative zero is formatted as "0"
+			pBeg = pEnd - 1;
+			*pBeg = '0';
+			decimalPoint = 1;
+		}
+		else
+		{
+			if (negative) builder.AddCharacter('-');
+			UInt64 output;
+			Int32 exponent;
+			shortestDecimal(ieeeMantissa, ieeeExponent, output, exponent);
+			while (output % 10 == 0)
+			{
+				output /= 10;
+				++exponent;
+			}
+			pBeg = formatDigits64(output, pEnd);
+			decimalPoint = exponent + static_cast<int>(pEnd - pBeg);
+		}
+		int length = static_cast<int>(pEnd - pBeg);
+		int exponent = decimalPoint - 1;
+		if (lowDec <= exponent && exponent < highDec)
+			appendDecimal(builder, pBeg, length, decimalPoint);
+		else
+			appendExponential(builder, pBeg, length, exponent);
+	}
 	builder.Finalize();
 }
 
@@ -310,11 +853,17 @@ float strToFloat(const char* str)
 double strToDouble(const char* str)
 {
 	using namespace double_conversion;
+
+	double result;
+	bool plain;
+	std::size_t length = std::strlen(str);
+	if (strToDoubleFast(str, length, '.', result, plain)) return result;
+
 	int processed;
 	int flags = StringToDoubleConverter::ALLOW_LEADING_SPACES |
 		StringToDoubleConverter::ALLOW_TRAILING_SPACES;
 	StringToDoubleConverter converter(flags, 0.0, Double::NaN(), POCO_FLT_INF, POCO_FLT_NAN);
-	double result = converter.StringToDouble(str, static_cast<int>(strlen(str)), &processed);
+	result = converter.StringToDouble(str, static_cast<int>(length), &processed);
 	return result;
 }
 
@@ -340,12 +889,26 @@ bool strToDouble(const std::string& str, double& result, char decSep, char thSep
 
 	using namespace double_conversion;
 
-	std::string tmp(str);
-	trimInPlace(tmp);
-	removeInPlace(tmp, thSep);
-	replaceInPlace(tmp, decSep, '.');
-	removeInPlace(tmp, 'f');
-	result = strToDouble(tmp.c_str());
+	bool plain;
+	if (strToDoubleFast(str.data(), str.size(), decSep, result, plain)) return true;
+
+	if (plain && decSep == '.')
+	{
+		// no separators, suffixes or whitespace to remove
+		int processed;
+		int flags = StringToDoubleConverter::NO_FLAGS;
+		StringToDoubleConverter converter(flags, 0.0, Double::NaN(), POCO_FLT_INF, POCO_FLT_NAN);
+		result = converter.StringToDouble(str.data(), static_cast<int>(str.size()), &processed);
+	}
+	else
+	{
+		std::string tmp(str);
+		trimInPlace(tmp);
+		removeInPlace(tmp, thSep);
+		replaceInPlace(tmp, decSep, '.');
+		removeInPlace(tmp, 'f');
+		result = strToDouble(tmp.c_str());
+	}
 	return !FPEnvironment::isInfinite(result) &&
 		!FPEnvironment::isNaN(result);
 }
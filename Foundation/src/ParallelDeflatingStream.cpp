@@ -0,0 +1,426 @@
+//
+// ParallelDeflatingStream.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Streams
+// Module:  ZLibStream
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/ParallelDeflatingStream.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Buffer.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const std::size_t MAX_DICTIONARY_SIZE = 32768;
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const char OS_CODE = 0x0a;
+#else
+	const char OS_CODE = 0x03;
+#endif
+}
+
+
+class ParallelDeflatingStreamBuf::Block: public Runnable
+	/// A block of data that is compressed by a thread of the ThreadPool,
+	/// as a part of a raw deflate stream, using the data preceding it as
+	/// the dictionary. All blocks but the last one end with a sync flush,
+	/// so that the compressed blocks can simply be concatenated.
+{
+public:
+	Block(const std::string& dictionary, const char* data, std::size_t length, int level, bool gzip, bool last):
+		_input(dictionary.size() + length),
+		_dictionaryLength(dictionary.size()),
+		_output(0),
+		_outputLength(0),
+		_checksum(0),
+		_level(level),
+		_gzip(gzip),
+		_last(last),
+		_rc(Z_OK),
+		_done(Event::EVENT_MANUALRESET)
+	{
+		std::memcpy(_input.begin(), dictionary.data(), dictionary.size());
+		std::memcpy(_input.begin() + dictionary.size(), data, length);
+	}
+
+	void run()
+	{
+		try
+		{
+			_rc = compress();
+		}
+		catch (...)
+		{
+			_rc = Z_MEM_ERROR;
+		}
+		_done.set();
+	}
+
+	bool done()
+	{
+		return _done.tryWait(0);
+	}
+
+	void wait()
+	{
+		_done.wait();
+	}
+
+	int result() const
+	{
+		return _rc;
+	}
+
+	const char* output() const
+	{
+		return _output.begin();
+	}
+
+	std::size_t outputLength() const
+	{
+		return _outputLength;
+	}
+
+	UInt32 checksum() const
+	{
+		return _checksum;
+	}
+
+	std::size_t length() const
+	{
+		return _input.size() - _dictionaryLength;
+	}
+
+private:
+	int compress()
+	{
+		z_stream zstr;
+		std::memset(&zstr, 0, sizeof(zstr));
+		int rc = deflateInit2(&zstr, _level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+		if (rc != Z_OK) return rc;
+
+		const Bytef* data = reinterpret_cast<const Bytef*>(_input.begin()) + _dictionaryLength;
+		uInt length = static_cast<uInt>(this->length());
+		if (_dictionaryLength > 0)
+		{
+			rc = deflateSetDictionary(&zstr, reinterpret_cast<const Bytef*>(_input.begin()), static_cast<uInt>(_dictionaryLength));
+		}
+		_checksum = static_cast<UInt32>(_gzip ? crc32(0, data, length) : adler32(1, data, length));
+
+		_output.resize(deflateBound(&zstr, length) + 16, false);
+		zstr.next_in  = const_cast<Bytef*>(data);
+		zstr.avail_in = length;
+		while (rc == Z_OK)
+		{
+			zstr.next_out  = reinterpret_cast<Bytef*>(_output.begin()) + zstr.total_out;
+			zstr.avail_out = static_cast<uInt>(_output.size() - zstr.total_out);
+			rc = deflate(&zstr, _last ? Z_FINISH : Z_SYNC_FLUSH);
+			if (rc == Z_STREAM_END || (!_last && rc == Z_OK && zstr.avail_out > 0))
+			{
+				rc = Z_OK;
+				break;
+			}
+			else if (!_last && rc == Z_BUF_ERROR && zstr.avail_in == 0)
+			{
+				// the flush was complete when the output buffer became full
+				rc = Z_OK;
+				break;
+			}
+			else if (rc == Z_OK)
+			{
+				_output.resize(2*_output.size());
+			}
+		}
+		_outputLength = zstr.total_out;
+		deflateEnd(&zstr);
+		return rc;
+	}
+
+	Buffer<char> _input;
+	std::size_t  _dictionaryLength;
+	Buffer<char> _output;
+	std::size_t  _outputLength;
+	UInt32       _checksum;
+	int          _level;
+	bool         _gzip;
+	bool         _last;
+	int          _rc;
+	Event        _done;
+};
+
+
+ParallelDeflatingStreamBuf::ParallelDeflatingStreamBuf(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, int threads, std::size_t blockSize, ThreadPool& pool):
+	BufferedStreamBuf(static_cast<std::streamsize>(blockSize), std::ios::out),
+	_pOstr(&ostr),
+	_type(type),
+	_level(level),
+	_threads(threads > 0 ? threads : Environment::processorCount()),
+	_pool(pool),
+	_checksum(type == DeflatingStreamBuf::STREAM_GZIP ? 0 : 1),
+	_length(0)
+{
+	if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) throw InvalidArgumentException("invalid compression level");
+	if (blockSize == 0) throw InvalidArgumentException("block size must not be 0");
+
+	writeHeader();
+}
+
+
+ParallelDeflatingStreamBuf::~ParallelDeflatingStreamBuf()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+	}
+	wait();
+}
+
+
+int ParallelDeflatingStreamBuf::close()
+{
+	if (_pOstr)
+	{
+		try
+		{
+			std::streamsize n = static_cast<std::streamsize>(pptr() - pbase());
+			compress(pbase(), static_cast<std::size_t>(n), true);
+			pbump(static_cast<int>(-n));
+			writeBlocks(0);
+			writeTrailer();
+			_pOstr->flush();
+		}
+		catch (...)
+		{
+			wait();
+			_pOstr = 0;
+			throw;
+		}
+		_pOstr = 0;
+	}
+	return 0;
+}
+
+
+int ParallelDeflatingStreamBuf::sync()
+{
+	if (BufferedStreamBuf::sync())
+		return -1;
+
+	if (_pOstr)
+	{
+		writeBlocks(0);
+		_pOstr->flush();
+	}
+	return 0;
+}
+
+
+int ParallelDeflatingStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
+{
+	if (length == 0 || !_pOstr) return 0;
+
+	compress(buffer, static_cast<std::size_t>(length), false);
+	return static_cast<int>(length);
+}
+
+
+void ParallelDeflatingStreamBuf::writeHeader()
+{
+	if (_type == DeflatingStreamBuf::STREAM_GZIP)
+	{
+		// no file name and modification time, like zlib
+		char xfl = _level == Z_BEST_COMPRESSION ? 2 : (_level == Z_BEST_SPEED ? 4 : 0);
+		const char header[10] = { '\x1f', '\x8b', Z_DEFLATED, 0, 0, 0, 0, 0, xfl, OS_CODE };
+		_pOstr->write(header, sizeof(header));
+	}
+	else
+	{
+		// 32K window, and the compression level flags used by zlib
+		unsigned levelFlags = 2;
+		if (_level >= 0 && _level < 2)
+			levelFlags = 0;
+		else if (_level >= 2 && _level < 6)
+			levelFlags = 1;
+		else if (_level > 6)
+			levelFlags = 3;
+		unsigned header = (0x78 << 8) | (levelFlags << 6);
+		header += 31 - header % 31;
+		const char bytes[2] = { static_cast<char>(header >> 8), static_cast<char>(header & 0xFF) };
+		_pOstr->write(bytes, sizeof(bytes));
+	}
+	if (!_pOstr->good()) throw IOException("cannot write compressed data");
+}
+
+
+void ParallelDeflatingStreamBuf::writeTrailer()
+{
+	char trailer[8];
+	std::size_t n = 0;
+	if (_type == DeflatingStreamBuf::STREAM_GZIP)
+	{
+		// CRC-32 and length modulo 2^32, in little endian byte order
+		UInt32 length = static_cast<UInt32>(_length);
+		for (int i = 0; i < 4; ++i) trailer[n++] = static_cast<char>(_checksum >> 8*i);
+		for (int i = 0; i < 4; ++i) trailer[n++] = static_cast<char>(length >> 8*i);
+	}
+	else
+	{
+		// Adler-32 in big endian byte order
+		for (int i = 3; i >= 0; --i) trailer[n++] = static_cast<char>(_checksum >> 8*i);
+	}
+	_pOstr->write(trailer, n);
+	if (!_pOstr->good()) throw IOException("cannot write compressed data");
+}
+
+
+void ParallelDeflatingStreamBuf::compress(const char* buffer, std::size_t length, bool last)
+{
+	// keep at most _threads blocks in flight
+	writeBlocks(_threads - 1);
+
+	Block* pBlock = new Block(_dictionary, buffer, length, _level, _type == DeflatingStreamBuf::STREAM_GZIP, last);
+	try
+	{
+		_blocks.push_back(pBlock);
+	}
+	catch (...)
+	{
+		delete pBlock;
+		throw;
+	}
+
+	// the last 32 Kbytes of data are the dictionary for the next block
+	if (length >= MAX_DICTIONARY_SIZE)
+	{
+		_dictionary.assign(buffer + length - MAX_DICTIONARY_SIZE, MAX_DICTIONARY_SIZE);
+	}
+	else
+	{
+		_dictionary.append(buffer, length);
+		if (_dictionary.size() > MAX_DICTIONARY_SIZE)
+			_dictionary.erase(0, _dictionary.size() - MAX_DICTIONARY_SIZE);
+	}
+
+	// if the block cannot be started in the pool for whatever reason,
+	// compress it here, so that waiting for it never blocks forever
+	try
+	{
+		_pool.start(*pBlock);
+	}
+	catch (...)
+	{
+		pBlock->run();
+	}
+}
+
+
+void ParallelDeflatingStreamBuf::writeBlock()
+{
+	Block* pBlock = _blocks.front();
+	pBlock->wait();
+	_blocks.pop_front();
+
+	int rc = pBlock->result();
+	if (rc == Z_OK)
+	{
+		if (_type == DeflatingStreamBuf::STREAM_GZIP)
+			_checksum = static_cast<UInt32>(crc32_combine(_checksum, pBlock->checksum(), static_cast<z_off_t>(pBlock->length())));
+		else
+			_checksum = static_cast<UInt32>(adler32_combine(_checksum, pBlock->checksum(), static_cast<z_off_t>(pBlock->length())));
+		_length += pBlock->length();
+		_pOstr->write(pBlock->output(), static_cast<std::streamsize>(pBlock->outputLength()));
+	}
+	delete pBlock;
+
+	if (rc != Z_OK) throw IOException(zError(rc));
+	if (!_pOstr->good()) throw IOException("cannot write compressed data");
+}
+
+
+void ParallelDeflatingStreamBuf::writeBlocks(std::size_t maxPending)
+{
+	// write the blocks that are done, and wait for the
+	// first block until at most maxPending are left
+	while (!_blocks.empty() && (_blocks.size() > maxPending || _blocks.front()->done()))
+	{
+		writeBlock();
+	}
+}
+
+
+void ParallelDeflatingStreamBuf::wait()
+{
+	while (!_blocks.empty())
+	{
+		Block* pBlock = _blocks.front();
+		pBlock->wait();
+		_blocks.pop_front();
+		delete pBlock;
+	}
+}
+
+
+ParallelDeflatingIOS::ParallelDeflatingIOS(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, int threads, std::size_t blockSize, ThreadPool& pool):
+	_buf(ostr, type, level, threads, blockSize, pool)
+{
+	poco_ios_init(&_buf);
+}
+
+
+ParallelDeflatingIOS::~ParallelDeflatingIOS()
+{
+}
+
+
+ParallelDeflatingStreamBuf* ParallelDeflatingIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+ParallelDeflatingOutputStream::ParallelDeflatingOutputStream(std::ostream& ostr, DeflatingStreamBuf::StreamType type, int level, int threads, std::size_t blockSize, ThreadPool& pool):
+	std::ostream(&_buf),
+	ParallelDeflatingIOS(ostr, type, level, threads, blockSize, pool)
+{
+}
+
+
+ParallelDeflatingOutputStream::~ParallelDeflatingOutputStream()
+{
+}
+
+
+int ParallelDeflatingOutputStream::close()
+{
+	return _buf.close();
+}
+
+
+int ParallelDeflatingOutputStream::sync()
+{
+	return _buf.pubsync();
+}
+
+
+} // namespace Poco
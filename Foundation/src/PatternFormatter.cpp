@@ -25,6 +25,9 @@
 #include "Poco/Environment.h"
 #include "Poco/NumberParser.h"
 #include "Poco/StringTokenizer.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/Thread.h"
+#include "Poco/AtomicCounter.h"
 
 
 namespace Poco {
@@ -35,7 +38,110 @@ const std::string PatternFormatter::PROP_TIMES   = "times";
 const std::string PatternFormatter::PROP_PRIORITY_NAMES = "priorityNames";
 
 
+namespace
+{
+	const Timestamp::TimeVal INVALID_TIME = Timestamp::TIMEVAL_MIN;
+
+	struct FormatCache
+		/// The cached segments of one PatternFormatter.
+	{
+		FormatCache(): 
+			id(0),
+			offsetMinute(INVALID_TIME),
+			offset(0)
+		{
+		}
+
+		int id;
+		Timestamp::TimeVal offsetMinute;
+		Timestamp::TimeDiff offset;
+		std::vector<Timestamp::TimeVal> seconds;
+		std::vector<std::string> texts;
+	};
+
+	class ThreadCache
+		/// The FormatCaches of the PatternFormatters used by a thread.
+		/// Only the most recently used formatters are kept.
+	{
+	public:
+		FormatCache& find(int id, std::size_t segments)
+		{
+			for (std::vector<FormatCache>::iterator it = _caches.begin(); it != _caches.end(); ++it)
+			{
+				if (it->id == id) return *it;
+			}
+			if (_caches.size() >= MAX_CACHES) _caches.erase(_caches.begin());
+			_caches.push_back(FormatCache());
+			FormatCache& cache = _caches.back();
+			cache.id = id;
+			cache.seconds.resize(segments, INVALID_TIME);
+			cache.texts.resize(segments);
+			return cache;
+		}
+
+	private:
+		enum
+		{
+			MAX_CACHES = 8
+		};
+
+		std::vector<FormatCache> _caches;
+	};
+
+	ThreadLocal<ThreadCache> threadCache;
+	AtomicCounter formatterId;
+
+	inline Timestamp::TimeVal floorDiv(Timestamp::TimeVal value, Timestamp::TimeVal divisor)
+	{
+		return value >= 0 ? value/divisor : (value - divisor + 1)/divisor;
+	}
+
+	Timestamp::TimeDiff localOffset(FormatCache* pCache, const Timestamp& timestamp)
+	{
+		if (pCache)
+		{
+			Timestamp::TimeVal minute = floorDiv(timestamp.epochMicroseconds(), 60*Timestamp::resolution());
+			if (pCache->offsetMinute != minute)
+			{
+				pCache->offset = (Timezone::utcOffset() + Timezone::dst())*Timestamp::resolution();
+				pCache->offsetMinute = minute;
+			}
+			return pCache->offset;
+		}
+		else return (Timezone::utcOffset() + Timezone::dst())*Timestamp::resolution();
+	}
+
+	bool isTimeKey(char key)
+	{
+		switch (key)
+		{
+		case 'w': case 'W': case 'b': case 'B': case 'd': case 'e': case 'f': 
+		case 'm': case 'n': case 'o': case 'y': case 'Y': case 'H': case 'h': 
+		case 'a': case 'A': case 'M': case 'S': case 'z': case 'Z':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool isMessageKey(char key)
+	{
+		switch (key)
+		{
+		case 's': case 't': case 'l': case 'p': case 'q': case 'P': case 'T': 
+		case 'I': case 'O': case 'U': case 'u': case 'i': case 'c': case 'F': 
+		case 'E': case 'v': case 'x': case 'L':
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+
 PatternFormatter::PatternFormatter():
+	_reserve(0),
+	_id(++formatterId),
 	_localTime(false)
 {
 	parsePriorityNames();
@@ -43,6 +149,8 @@ PatternFormatter::PatternFormatter():
 
 
 PatternFormatter::PatternFormatter(const std::string& rFormat):
+	_reserve(0),
+	_id(++formatterId),
 	_localTime(false),
 	_pattern(rFormat)
 {
@@ -58,86 +166,141 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
+	// reserve() must not be called with a smaller capacity, as some
+	// implementations shrink the string in that case.
+	std::size_t capacity = text.size() + _reserve + msg.getText().size();
+	if (text.capacity() < capacity) text.reserve(capacity);
+
+	FormatCache* pCache = 0;
+	if (!_segments.empty() && Thread::current())
+		pCache = &threadCache->find(_id, _segments.size());
 	Timestamp timestamp = msg.getTime();
 	bool localTime = _localTime;
-	if (localTime)
-	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
-	}
-	DateTime dateTime = timestamp;
-	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+	if (localTime) timestamp += localOffset(pCache, msg.getTime());
+	std::size_t i = 0;
+	while (i < _patternActions.size())
 	{
-		text.append(ip->prepend);
-		switch (ip->key)
+		const PatternAction& action = _patternActions[i];
+		if (action.segment >= 0)
 		{
-		case 's': text.append(msg.getSource()); break;
-		case 't': text.append(msg.getText()); break;
-		case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
-		case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
-		case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
-		case 'P': NumberFormatter::append(text, msg.getPid()); break;
-		case 'T': text.append(msg.getThread()); break;
-		case 'I': NumberFormatter::append(text, msg.getTid()); break;
-		case 'O': NumberFormatter::append(text, msg.getOsTid()); break;
-		case 'N': text.append(Environment::nodeName()); break;
-		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
-		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-		case 'e': NumberFormatter::append(text, dateTime.day()); break;
-		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-		case 'n': NumberFormatter::append(text, dateTime.month()); break;
-		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
-		case 'v':
-			if (ip->length > msg.getSource().length())	//append spaces
-				text.append(msg.getSource()).append(ip->length - msg.getSource().length(), ' ');
-			else if (ip->length && ip->length < msg.getSource().length()) // crop
-				text.append(msg.getSource(), msg.getSource().length()-ip->length, ip->length);
-			else
-				text.append(msg.getSource());
-			break;
-		case 'x':
-			try
-			{
-				text.append(msg[ip->property]);
-			}
-			catch (...)
+			const Segment& segment = _segments[action.segment];
+			if (pCache)
 			{
+				Timestamp::TimeVal second = floorDiv(timestamp.epochMicroseconds(), Timestamp::resolution());
+				std::string& cached = pCache->texts[action.segment];
+				if (pCache->seconds[action.segment] != second)
+				{
+					cached.clear();
+					formatSegment(segment, timestamp, localTime, cached);
+					pCache->seconds[action.segment] = second;
+				}
+				text.append(cached);
 			}
-			break;
-		case 'L':
-			if (!localTime)
+			else formatSegment(segment, timestamp, localTime, text);
+			i = segment.end;
+		}
+		else
+		{
+			text.append(action.prepend);
+			if (action.key == 'L')
 			{
-				localTime = true;
-				timestamp += Timezone::utcOffset()*Timestamp::resolution();
-				timestamp += Timezone::dst()*Timestamp::resolution();
-				dateTime = timestamp;
+				if (!localTime)
+				{
+					localTime = true;
+					timestamp += localOffset(pCache, msg.getTime());
+				}
 			}
-			break;
+			else formatField(action, msg, timestamp, text);
+			++i;
 		}
 	}
 }
 
 
+void PatternFormatter::formatSegment(const Segment& segment, const Timestamp& timestamp, bool localTime, std::string& text)
+{
+	DateTime dateTime = timestamp;
+	for (std::size_t i = segment.begin; i < segment.end; ++i)
+	{
+		const PatternAction& action = _patternActions[i];
+		text.append(action.prepend);
+		formatTime(action, dateTime, localTime, text);
+	}
+}
+
+
+void PatternFormatter::formatTime(const PatternAction& action, const DateTime& dateTime, bool localTime, std::string& text)
+{
+	switch (action.key)
+	{
+	case 'N': text.append(Environment::nodeName()); break;
+	case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+	case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+	case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+	case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+	case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+	case 'e': NumberFormatter::append(text, dateTime.day()); break;
+	case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
+	case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+	case 'n': NumberFormatter::append(text, dateTime.month()); break;
+	case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
+	case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+	case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
+	case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
+	case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+	case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
+	case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
+	case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
+	case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
+	case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
+	case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
+	}
+}
+
+
+void PatternFormatter::formatField(const PatternAction& action, const Message& msg, const Timestamp& timestamp, std::string& text)
+{
+	Timestamp::TimeVal time = timestamp.epochMicroseconds();
+	int micros = static_cast<int>(time - floorDiv(time, Timestamp::resolution())*Timestamp::resolution());
+	switch (action.key)
+	{
+	case 's': text.append(msg.getSource()); break;
+	case 't': text.append(msg.getText()); break;
+	case 'l': NumberFormatter::append(text, (int) msg.getPriority()); break;
+	case 'p': text.append(getPriorityName((int) msg.getPriority())); break;
+	case 'q': text += getPriorityName((int) msg.getPriority()).at(0); break;
+	case 'P': NumberFormatter::append(text, msg.getPid()); break;
+	case 'T': text.append(msg.getThread()); break;
+	case 'I': NumberFormatter::append(text, msg.getTid()); break;
+	case 'O': NumberFormatter::append(text, msg.getOsTid()); break;
+	case 'N': text.append(Environment::nodeName()); break;
+	case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
+	case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
+	case 'i': NumberFormatter::append0(text, micros/1000, 3); break;
+	case 'c': NumberFormatter::append(text, micros/100000); break;
+	case 'F': NumberFormatter::append0(text, micros, 6); break;
+	case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
+	case 'v':
+		if (action.length > msg.getSource().length())	//append spaces
+			text.append(msg.getSource()).append(action.length - msg.getSource().length(), ' ');
+		else if (action.length && action.length < msg.getSource().length()) // crop
+			text.append(msg.getSource(), msg.getSource().length()-action.length, action.length);
+		else
+			text.append(msg.getSource());
+		break;
+	case 'x':
+		try
+		{
+			text.append(msg[action.property]);
+		}
+		catch (...)
+		{
+		}
+		break;
+	}
+}
+
+
 void PatternFormatter::parsePattern()
 {
 	_patternActions.clear();
@@ -194,6 +357,48 @@ void PatternFormatter::parsePattern()
 	{
 		_patternActions.push_back(endAct);
 	}
+	compilePattern();
+}
+
+
+void PatternFormatter::compilePattern()
+{
+	_segments.clear();
+	_reserve = 0;
+	for (std::vector<PatternAction>::const_iterator it = _patternActions.begin(); it != _patternActions.end(); ++it)
+	{
+		_reserve += it->prepend.size() + 8;
+	}
+	std::size_t i = 0;
+	while (i < _patternActions.size())
+	{
+		_patternActions[i].segment = -1;
+		if (isMessageKey(_patternActions[i].key))
+		{
+			++i;
+			continue;
+		}
+		std::size_t end = i;
+		bool hasTime = false;
+		while (end < _patternActions.size() && !isMessageKey(_patternActions[end].key))
+		{
+			hasTime = hasTime || isTimeKey(_patternActions[end].key);
+			++end;
+		}
+		if (hasTime)
+		{
+			Segment segment;
+			segment.begin = i;
+			segment.end   = end;
+			_segments.push_back(segment);
+		}
+		for (std::size_t k = i; k < end; ++k)
+		{
+			_patternActions[k].segment = hasTime ? static_cast<int>(_segments.size() - 1) : -1;
+		}
+		i = end;
+	}
+	_id = ++formatterId;
 }
 
 	
@@ -207,6 +412,7 @@ void PatternFormatter::setProperty(const std::string& name, const std::string& v
 	else if (name == PROP_TIMES)
 	{
 		_localTime = (value == "local");
+		_id = ++formatterId;
 	}
 	else if (name == PROP_PRIORITY_NAMES) 
 	{
@@ -0,0 +1,254 @@
+//
+// PipeMultiplexer.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Processes
+// Module:  PipeMultiplexer
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/PipeMultiplexer.h"
+#include "Poco/Exception.h"
+#include "Poco/Timestamp.h"
+#include "Poco/NumberFormatter.h"
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnWindows.h"
+#else
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#include <limits>
+
+
+namespace Poco {
+
+
+namespace
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	const Pipe::Handle INVALID_PIPE_HANDLE = INVALID_HANDLE_VALUE;
+
+	int readPipe(Pipe::Handle handle, char* buffer, std::size_t size)
+		/// Returns the number of bytes read, 0 at the end of
+		/// the data, or -1 if no data is available.
+	{
+		DWORD available = 0;
+		if (!PeekNamedPipe(handle, NULL, 0, NULL, &available, NULL))
+		{
+			if (GetLastError() == ERROR_BROKEN_PIPE) return 0;
+			throw ReadFileException("anonymous pipe");
+		}
+		if (available == 0) return -1;
+
+		DWORD bytesRead = 0;
+		DWORD length = available < size ? available : static_cast<DWORD>(size);
+		if (!ReadFile(handle, buffer, length, &bytesRead, NULL))
+		{
+			if (GetLastError() == ERROR_BROKEN_PIPE) return 0;
+			throw ReadFileException("anonymous pipe");
+		}
+		return static_cast<int>(bytesRead);
+	}
+#else
+	const Pipe::Handle INVALID_PIPE_HANDLE = -1;
+
+	int readPipe(Pipe::Handle fd, char* buffer, std::size_t size)
+		/// Returns the number of bytes read, 0 at the end of
+		/// the data, or -1 if no data is available.
+	{
+		ssize_t n;
+		do
+		{
+			n = ::read(fd, buffer, size);
+		}
+		while (n < 0 && errno == EINTR);
+		if (n < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK) return -1;
+			throw ReadFileException("anonymous pipe");
+		}
+		return static_cast<int>(n);
+	}
+#endif
+}
+
+
+PipeMultiplexer::PipeMultiplexer(std::size_t bufferSize):
+	_buffer(bufferSize)
+{
+	if (bufferSize == 0) throw InvalidArgumentException("buffer size must not be 0");
+}
+
+
+PipeMultiplexer::~PipeMultiplexer()
+{
+	for (EntryVec::const_iterator it = _pipes.begin(); it != _pipes.end(); ++it)
+	{
+		restore(*it);
+	}
+}
+
+
+void PipeMultiplexer::add(const Pipe& pipe, int id)
+{
+	if (pipe.readHandle() == INVALID_PIPE_HANDLE) throw InvalidArgumentException("pipe has been closed for reading");
+	if (find(id) != _pipes.end()) throw ExistsException("pipe ID", NumberFormatter::format(id));
+
+	int flags = 0;
+#if !defined(POCO_OS_FAMILY_WINDOWS)
+	flags = fcntl(pipe.readHandle(), F_GETFL);
+	if (flags == -1 || fcntl(pipe.readHandle(), F_SETFL, flags | O_NONBLOCK) == -1)
+		throw SystemException("cannot make pipe non-blocking");
+#endif
+
+	Entry entry(pipe, id, flags);
+	try
+	{
+		_pipes.push_back(entry);
+	}
+	catch (...)
+	{
+		restore(entry);
+		throw;
+	}
+}
+
+
+void PipeMultiplexer::remove(int id)
+{
+	EntryVec::iterator it = find(id);
+	if (it != _pipes.end())
+	{
+		restore(*it);
+		_pipes.erase(it);
+	}
+}
+
+
+std::size_t PipeMultiplexer::poll(const Timespan& timeout)
+{
+	Timespan::TimeDiff ms = timeout.totalMilliseconds();
+	if (ms < 0) ms = 0;
+	if (ms > std::numeric_limits<int>::max()) ms = std::numeric_limits<int>::max();
+	return pollImpl(static_cast<long>(ms));
+}
+
+
+void PipeMultiplexer::run()
+{
+	while (!_pipes.empty())
+	{
+		pollImpl(-1);
+	}
+}
+
+
+std::size_t PipeMultiplexer::pollImpl(long timeout)
+{
+	if (_pipes.empty()) return 0;
+
+	// the event handlers may add and remove pipes,
+	// so the pipes are looked up by their IDs
+	std::vector<int> ids;
+	ids.reserve(_pipes.size());
+	for (EntryVec::const_iterator it = _pipes.begin(); it != _pipes.end(); ++it)
+	{
+		ids.push_back(it->id);
+	}
+
+	std::size_t serviced = 0;
+#if defined(POCO_OS_FAMILY_WINDOWS)
+	Timestamp start;
+	for (;;)
+	{
+		for (std::vector<int>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+		{
+			if (read(*it)) ++serviced;
+		}
+		if (serviced > 0 || (timeout >= 0 && start.isElapsed(Timestamp::TimeDiff(timeout)*1000))) break;
+		Sleep(10);
+		ids.clear();
+		for (EntryVec::const_iterator it = _pipes.begin(); it != _pipes.end(); ++it)
+		{
+			ids.push_back(it->id);
+		}
+	}
+#else
+	std::vector<pollfd> fds(_pipes.size());
+	for (std::size_t i = 0; i < _pipes.size(); ++i)
+	{
+		fds[i].fd      = _pipes[i].pipe.readHandle();
+		fds[i].events  = POLLIN;
+		fds[i].revents = 0;
+	}
+	int rc = ::poll(&fds[0], static_cast<nfds_t>(fds.size()), static_cast<int>(timeout));
+	if (rc < 0)
+	{
+		if (errno == EINTR) return 0;
+		throw SystemException("cannot poll pipes");
+	}
+	for (std::size_t i = 0; rc > 0 && i < fds.size(); ++i)
+	{
+		if (fds[i].revents)
+		{
+			--rc;
+			if (read(ids[i])) ++serviced;
+		}
+	}
+#endif
+	return serviced;
+}
+
+
+bool PipeMultiplexer::read(int id)
+{
+	EntryVec::iterator it = find(id);
+	if (it == _pipes.end()) return false;
+
+	int n = readPipe(it->pipe.readHandle(), _buffer.begin(), _buffer.size());
+	if (n < 0) return false;
+	if (n > 0)
+	{
+		PipeEvent ev(id, _buffer.begin(), static_cast<std::size_t>(n));
+		dataRead.notify(this, ev);
+	}
+	else
+	{
+		Pipe pipe(it->pipe);
+		_pipes.erase(it);
+		pipe.close(Pipe::CLOSE_READ);
+		int closedId = id;
+		pipeClosed.notify(this, closedId);
+	}
+	return true;
+}
+
+
+void PipeMultiplexer::restore(const Entry& entry)
+{
+#if !defined(POCO_OS_FAMILY_WINDOWS)
+	// restoring the mode is done on a best-effort basis;
+	// the pipe is still usable in non-blocking mode
+	fcntl(entry.pipe.readHandle(), F_SETFL, entry.flags);
+#endif
+}
+
+
+PipeMultiplexer::EntryVec::iterator PipeMultiplexer::find(int id)
+{
+	EntryVec::iterator it = _pipes.begin();
+	while (it != _pipes.end() && it->id != id) ++it;
+	return it;
+}
+
+
+} // namespace Poco
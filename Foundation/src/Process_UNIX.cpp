@@ -36,6 +36,17 @@
 #endif
 
 
+// posix_spawn_file_actions_addclosefrom_np() is needed to close the file
+// descriptors inherited from the parent process, like the fork() path does,
+// and posix_spawn_file_actions_addchdir_np() to set the initial directory.
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34)) && !defined(POCO_NO_POSIX_SPAWN)
+#define POCO_HAVE_POSIX_SPAWN
+#include <spawn.h>
+#include <cstring>
+extern char** environ;
+#endif
+
+
 namespace Poco {
 
 
@@ -189,11 +200,86 @@ ProcessHandleImpl* ProcessImpl::launchImpl(const std::string& command, const Arg
 		return launchByForkExecImpl(command, args, initialDirectory, inPipe, outPipe, errPipe, env);
 	}
 #else
+	ProcessHandleImpl* pHandle = launchBySpawnImpl(command, args, initialDirectory, inPipe, outPipe, errPipe, env);
+	if (pHandle) return pHandle;
 	return launchByForkExecImpl(command, args, initialDirectory, inPipe, outPipe, errPipe, env);
 #endif
 }
 
 
+ProcessHandleImpl* ProcessImpl::launchBySpawnImpl(const std::string& command, const ArgsImpl& args, const std::string& initialDirectory, Pipe* inPipe, Pipe* outPipe, Pipe* errPipe, const EnvImpl& env)
+{
+#if defined(POCO_HAVE_POSIX_SPAWN)
+	std::vector<char*> argv(args.size() + 2);
+	int i = 0;
+	argv[i++] = const_cast<char*>(command.c_str());
+	for (ArgsImpl::const_iterator it = args.begin(); it != args.end(); ++it) 
+	{
+		argv[i++] = const_cast<char*>(it->c_str());
+	}
+	argv[i] = NULL;
+
+	// the new process gets the environment of this process,
+	// with the given variables added or replaced
+	char** envPtr = environ;
+	std::vector<char> envChars;
+	std::vector<char*> envPtrs;
+	if (!env.empty())
+	{
+		for (char** pVar = environ; *pVar; ++pVar)
+		{
+			const char* pEq = std::strchr(*pVar, '=');
+			std::string name(*pVar, pEq ? pEq - *pVar : std::strlen(*pVar));
+			if (env.find(name) == env.end())
+				envPtrs.push_back(*pVar);
+		}
+		envChars = getEnvironmentVariablesBuffer(env);
+		char* p = &envChars[0];
+		while (*p)
+		{
+			envPtrs.push_back(p);
+			while (*p) ++p;
+			++p;
+		}
+		envPtrs.push_back(0);
+		envPtr = &envPtrs[0];
+	}
+
+	posix_spawn_file_actions_t fileActions;
+	int rc = posix_spawn_file_actions_init(&fileActions);
+	if (rc != 0)
+		throw SystemException("Cannot launch process", command, rc);
+
+	// outPipe and errPipe may be the same, which is fine, as the
+	// pipe's descriptors are closed after they have been duplicated
+	if (inPipe)
+		rc = posix_spawn_file_actions_adddup2(&fileActions, inPipe->readHandle(), STDIN_FILENO);
+	if (rc == 0 && outPipe)
+		rc = posix_spawn_file_actions_adddup2(&fileActions, outPipe->writeHandle(), STDOUT_FILENO);
+	if (rc == 0 && errPipe)
+		rc = posix_spawn_file_actions_adddup2(&fileActions, errPipe->writeHandle(), STDERR_FILENO);
+	if (rc == 0 && !initialDirectory.empty())
+		rc = posix_spawn_file_actions_addchdir_np(&fileActions, initialDirectory.c_str());
+	if (rc == 0)
+		rc = posix_spawn_file_actions_addclosefrom_np(&fileActions, 3);
+
+	pid_t pid = 0;
+	if (rc == 0)
+		rc = posix_spawnp(&pid, argv[0], &fileActions, 0, &argv[0], envPtr);
+	posix_spawn_file_actions_destroy(&fileActions);
+	if (rc != 0)
+		throw SystemException("Cannot launch process", command, rc);
+
+	if (inPipe)  inPipe->close(Pipe::CLOSE_READ);
+	if (outPipe) outPipe->close(Pipe::CLOSE_WRITE);
+	if (errPipe) errPipe->close(Pipe::CLOSE_WRITE);
+	return new ProcessHandleImpl(pid);
+#else
+	return 0;
+#endif
+}
+
+
 ProcessHandleImpl* ProcessImpl::launchByForkExecImpl(const std::string& command, const ArgsImpl& args, const std::string& initialDirectory, Pipe* inPipe, Pipe* outPipe, Pipe* errPipe, const EnvImpl& env)
 {
 #if !defined(POCO_NO_FORK_EXEC)
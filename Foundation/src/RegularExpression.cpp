@@ -16,6 +16,10 @@
 
 #include "Poco/RegularExpression.h"
 #include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadLocal.h"
+#include "Poco/ShardedLRUCache.h"
+#include "Poco/SingletonHolder.h"
 #include <sstream>
 #if defined(POCO_UNBUNDLED)
 #include <pcre.h>
@@ -24,9 +28,94 @@
 #include "pcre.h"
 #endif
 
+
+#if defined(PCRE_STUDY_JIT_COMPILE)
+#define POCO_PCRE_HAVE_JIT
+#endif
+
+
 namespace Poco {
 
 
+namespace
+{
+	enum
+	{
+		CACHE_SIZE          = 256,
+		JIT_STACK_START     = 32*1024,
+		JIT_STACK_MAX       = 1024*1024
+	};
+
+	class PatternCache: public ShardedLRUCache<std::string, RegularExpression>
+	{
+	public:
+		PatternCache():
+			ShardedLRUCache<std::string, RegularExpression>(CACHE_SIZE)
+		{
+		}
+	};
+
+	PatternCache& patternCache()
+	{
+		static SingletonHolder<PatternCache> sh;
+		return *sh.get();
+	}
+
+#if defined(POCO_PCRE_HAVE_JIT)
+
+	class JITStack
+		/// The JIT stack of a thread, allocated on first use.
+	{
+	public:
+		JITStack():
+			_pStack(0)
+		{
+		}
+
+		~JITStack()
+		{
+			if (_pStack) pcre_jit_stack_free(_pStack);
+		}
+
+		pcre_jit_stack* get()
+		{
+			if (!_pStack) _pStack = pcre_jit_stack_alloc(JIT_STACK_START, JIT_STACK_MAX);
+			return _pStack;
+		}
+
+	private:
+		pcre_jit_stack* _pStack;
+	};
+
+	ThreadLocal<JITStack> jitStack;
+
+	extern "C" pcre_jit_stack* jitStackCallback(void*)
+	{
+		// Threads not created by Poco::Thread share their ThreadLocal
+		// storage, so they use the small default JIT stack on the
+		// machine stack instead.
+		if (Thread::current())
+			return jitStack.get().get();
+		else
+			return 0;
+	}
+
+	bool isJITAvailable()
+	{
+		static int jit = -1;
+		if (jit < 0)
+		{
+			int rc = 0;
+			pcre_config(PCRE_CONFIG_JIT, &rc);
+			jit = rc;
+		}
+		return jit != 0;
+	}
+
+#endif // POCO_PCRE_HAVE_JIT
+}
+
+
 const int RegularExpression::OVEC_SIZE = 64;
 
 
@@ -46,7 +135,17 @@ RegularExpression::RegularExpression(const std::string& pattern, int options, bo
 		throw RegularExpressionException(msg.str());
 	}
 	if (study)
+	{
+#if defined(POCO_PCRE_HAVE_JIT)
+		if (isJITAvailable())
+		{
+			_extra = pcre_study(_pcre, PCRE_STUDY_JIT_COMPILE, &error);
+			if (_extra) pcre_assign_jit_stack(_extra, jitStackCallback, 0);
+		}
+		else
+#endif
 		_extra = pcre_study(_pcre, 0, &error);
+	}
 
 	pcre_fullinfo(_pcre, _extra, PCRE_INFO_NAMECOUNT, &nmcount);
 	pcre_fullinfo(_pcre, _extra, PCRE_INFO_NAMEENTRYSIZE, &nmentrysz);
@@ -65,7 +164,11 @@ RegularExpression::RegularExpression(const std::string& pattern, int options, bo
 RegularExpression::~RegularExpression()
 {
 	if (_pcre)  pcre_free(_pcre);
+#if defined(POCO_PCRE_HAVE_JIT)
+	if (_extra) pcre_free_study(_extra);
+#else
 	if (_extra) pcre_free(_extra);
+#endif
 }
 
 
@@ -148,6 +251,57 @@ int RegularExpression::match(const std::string& subject, std::string::size_type
 }
 
 
+int RegularExpression::matchAll(const std::string& subject, std::string::size_type offset, MatchVec& matches, int options) const
+{
+	poco_assert (offset <= subject.length());
+
+	matches.clear();
+
+	unsigned long ctorOptions = 0;
+	pcre_fullinfo(_pcre, _extra, PCRE_INFO_OPTIONS, &ctorOptions);
+	bool utf8 = (ctorOptions & PCRE_UTF8) != 0;
+
+	const char* data = subject.data();
+	int length = int(subject.size());
+	int pos = int(offset);
+	int emptyOptions = 0;
+	int ovec[OVEC_SIZE];
+	while (pos <= length)
+	{
+		int rc = pcre_exec(_pcre, _extra, data, length, pos, (options & 0xFFFF) | emptyOptions, ovec, OVEC_SIZE);
+		if (rc == PCRE_ERROR_NOMATCH)
+		{
+			if (!emptyOptions) break;
+			// no non-empty match after an empty match, so advance by one character
+			++pos;
+			if (utf8)
+			{
+				while (pos < length && (static_cast<unsigned char>(data[pos]) & 0xC0) == 0x80) ++pos;
+			}
+			emptyOptions = 0;
+			continue;
+		}
+		else if (rc == PCRE_ERROR_BADOPTION)
+		{
+			throw RegularExpressionException("bad option");
+		}
+		else if (rc < 0)
+		{
+			std::ostringstream msg;
+			msg << "PCRE error " << rc;
+			throw RegularExpressionException(msg.str());
+		}
+		matches.push_back(Match());
+		Match& m = matches.back();
+		m.offset = ovec[0];
+		m.length = ovec[1] - ovec[0];
+		pos = ovec[1];
+		emptyOptions = ovec[0] == ovec[1] ? PCRE_NOTEMPTY_ATSTART | PCRE_ANCHORED : 0;
+	}
+	return int(matches.size());
+}
+
+
 bool RegularExpression::match(const std::string& subject, std::string::size_type offset) const
 {
 	Match mtch;
@@ -302,8 +456,28 @@ bool RegularExpression::match(const std::string& subject, const std::string& pat
 {
 	int ctorOptions = options & (RE_CASELESS | RE_MULTILINE | RE_DOTALL | RE_EXTENDED | RE_ANCHORED | RE_DOLLAR_ENDONLY | RE_EXTRA | RE_UNGREEDY | RE_UTF8 | RE_NO_AUTO_CAPTURE);
 	int mtchOptions = options & (RE_ANCHORED | RE_NOTBOL | RE_NOTEOL | RE_NOTEMPTY | RE_NO_AUTO_CAPTURE | RE_NO_UTF8_CHECK);
-	RegularExpression re(pattern, ctorOptions, false);
-	return re.match(subject, 0, mtchOptions);
+	return cached(pattern, ctorOptions)->match(subject, 0, mtchOptions);
+}
+
+
+RegularExpression::Ptr RegularExpression::cached(const std::string& pattern, int options)
+{
+	std::string key(reinterpret_cast<const char*>(&options), sizeof(options));
+	key += pattern;
+	PatternCache& cache = patternCache();
+	Ptr pRE = cache.get(key);
+	if (!pRE)
+	{
+		pRE = new RegularExpression(pattern, options, true);
+		cache.add(key, pRE);
+	}
+	return pRE;
+}
+
+
+void RegularExpression::clearCache()
+{
+	patternCache().clear();
 }
 
 
@@ -18,7 +18,11 @@
 
 
 #include "Poco/SHA1Engine.h"
+#include "Poco/CPUFeatures.h"
 #include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
 
 
 #ifdef POCO_ARCH_LITTLE_ENDIAN
@@ -31,6 +35,86 @@
 namespace Poco {
 
 
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+namespace
+{
+	template <int I>
+	POCO_TARGET_ISA("sha,sse4.1,ssse3")
+	inline void sha1RoundsNI(__m128i& abcd, __m128i* e, __m128i* msg)
+		/// Performs rounds 4*I to 4*I + 3, and computes the
+		/// message schedule for the following rounds, using
+		/// the SHA extensions.
+	{
+		if (I == 0)
+			e[I % 2] = _mm_add_epi32(e[I % 2], msg[I % 4]);
+		else
+			e[I % 2] = _mm_sha1nexte_epu32(e[I % 2], msg[I % 4]);
+		e[(I + 1) % 2] = abcd;
+		if (I >= 3 && I <= 18)
+			msg[(I + 1) % 4] = _mm_sha1msg2_epu32(msg[(I + 1) % 4], msg[I % 4]);
+		abcd = _mm_sha1rnds4_epu32(abcd, e[I % 2], I / 5);
+		if (I >= 1 && I <= 16)
+			msg[(I + 3) % 4] = _mm_sha1msg1_epu32(msg[(I + 3) % 4], msg[I % 4]);
+		if (I >= 2 && I <= 17)
+			msg[(I + 2) % 4] = _mm_xor_si128(msg[(I + 2) % 4], msg[I % 4]);
+	}
+
+
+	POCO_TARGET_ISA("sha,sse4.1,ssse3")
+	void sha1TransformNI(UInt32* state, const unsigned char* data, std::size_t blocks)
+		/// Processes the given number of 64 byte blocks with
+		/// the SHA extensions.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090A0B0C0D0E0FLL);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+		__m128i e[2];
+		e[0] = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+		e[1] = _mm_setzero_si128();
+		__m128i msg[4];
+		while (blocks-- > 0)
+		{
+			__m128i abcdSave = abcd;
+			__m128i eSave    = e[0];
+			for (int i = 0; i < 4; i++)
+			{
+				msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), mask);
+			}
+			sha1RoundsNI<0>(abcd, e, msg);
+			sha1RoundsNI<1>(abcd, e, msg);
+			sha1RoundsNI<2>(abcd, e, msg);
+			sha1RoundsNI<3>(abcd, e, msg);
+			sha1RoundsNI<4>(abcd, e, msg);
+			sha1RoundsNI<5>(abcd, e, msg);
+			sha1RoundsNI<6>(abcd, e, msg);
+			sha1RoundsNI<7>(abcd, e, msg);
+			sha1RoundsNI<8>(abcd, e, msg);
+			sha1RoundsNI<9>(abcd, e, msg);
+			sha1RoundsNI<10>(abcd, e, msg);
+			sha1RoundsNI<11>(abcd, e, msg);
+			sha1RoundsNI<12>(abcd, e, msg);
+			sha1RoundsNI<13>(abcd, e, msg);
+			sha1RoundsNI<14>(abcd, e, msg);
+			sha1RoundsNI<15>(abcd, e, msg);
+			sha1RoundsNI<16>(abcd, e, msg);
+			sha1RoundsNI<17>(abcd, e, msg);
+			sha1RoundsNI<18>(abcd, e, msg);
+			sha1RoundsNI<19>(abcd, e, msg);
+			e[0] = _mm_sha1nexte_epu32(e[0], eSave);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+			data += SHA1Engine::BLOCK_SIZE;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+		state[4] = static_cast<UInt32>(_mm_extract_epi32(e[0], 3));
+	}
+}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+
+
 SHA1Engine::SHA1Engine()
 {
 	_digest.reserve(16);
@@ -68,18 +152,43 @@ void SHA1Engine::updateImpl(const void* buffer_, std::size_t count)
 	_context.countLo += ((UInt32) count << 3);
 	_context.countHi += ((UInt32 ) count >> 29);
 
-	/* Process data in BLOCK_SIZE chunks */
-	while (count-- > 0)
+	/* Complete a partially filled block */
+	if (_context.slop > 0)
 	{
-		db[_context.slop++] = *(buffer++);
-		if (_context.slop == BLOCK_SIZE)
-		{ 
-			/* transform this one block */
-			SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
-			transform();
-			_context.slop = 0 ;	/* no slop left */
-		}
+		std::size_t n = BLOCK_SIZE - _context.slop;
+		if (n > count) n = count;
+		std::memcpy(db + _context.slop, buffer, n);
+		_context.slop += static_cast<UInt32>(n);
+		buffer += n;
+		count  -= n;
+		if (_context.slop < BLOCK_SIZE) return;
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		_context.slop = 0;
+	}
+
+	/* Process whole blocks directly from the buffer */
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (count >= BLOCK_SIZE && CPUFeatures::hasSHA() && CPUFeatures::hasSSE41())
+	{
+		std::size_t blocks = count/BLOCK_SIZE;
+		sha1TransformNI(_context.digest, buffer, blocks);
+		buffer += blocks*BLOCK_SIZE;
+		count  -= blocks*BLOCK_SIZE;
 	}
+#endif
+	while (count >= BLOCK_SIZE)
+	{
+		std::memcpy(db, buffer, BLOCK_SIZE);
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		buffer += BLOCK_SIZE;
+		count  -= BLOCK_SIZE;
+	}
+
+	/* Save the rest for later */
+	std::memcpy(db, buffer, count);
+	_context.slop = static_cast<UInt32>(count);
 }
 
 
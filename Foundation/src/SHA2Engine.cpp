@@ -0,0 +1,451 @@
+//
+// SHA2Engine.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Crypt
+// Module:  SHA2Engine
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SHA2Engine.h"
+#include "Poco/CPUFeatures.h"
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const UInt32 K256[64] =
+	{
+		0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+		0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+		0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+		0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+		0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+		0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+		0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+		0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+	};
+
+	const UInt64 K512[80] =
+	{
+		0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+		0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+		0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+		0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+		0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+		0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+		0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+		0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+		0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+		0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+		0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+		0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+		0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+		0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+		0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+		0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+		0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+		0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+		0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+		0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+	};
+
+	const UInt32 INITIAL_224[8] =
+	{
+		0xC1059ED8, 0x367CD507, 0x3070DD17, 0xF70E5939, 0xFFC00B31, 0x68581511, 0x64F98FA7, 0xBEFA4FA4
+	};
+
+	const UInt32 INITIAL_256[8] =
+	{
+		0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+	};
+
+	const UInt64 INITIAL_384[8] =
+	{
+		0xCBBB9D5DC1059ED8ULL, 0x629A292A367CD507ULL, 0x9159015A3070DD17ULL, 0x152FECD8F70E5939ULL,
+		0x67332667FFC00B31ULL, 0x8EB44A8768581511ULL, 0xDB0C2E0D64F98FA7ULL, 0x47B5481DBEFA4FA4ULL
+	};
+
+	const UInt64 INITIAL_512[8] =
+	{
+		0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+		0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+	};
+
+
+	inline UInt32 rotr32(UInt32 x, int n)
+	{
+		return (x >> n) | (x << (32 - n));
+	}
+
+
+	inline UInt64 rotr64(UInt64 x, int n)
+	{
+		return (x >> n) | (x << (64 - n));
+	}
+
+
+	inline UInt32 load32BE(const UInt8* p)
+	{
+		return (UInt32(p[0]) << 24) | (UInt32(p[1]) << 16) | (UInt32(p[2]) << 8) | UInt32(p[3]);
+	}
+
+
+	inline UInt64 load64BE(const UInt8* p)
+	{
+		return (UInt64(load32BE(p)) << 32) | load32BE(p + 4);
+	}
+
+
+	inline void store32BE(UInt8* p, UInt32 value)
+	{
+		p[0] = static_cast<UInt8>(value >> 24);
+		p[1] = static_cast<UInt8>(value >> 16);
+		p[2] = static_cast<UInt8>(value >> 8);
+		p[3] = static_cast<UInt8>(value);
+	}
+
+
+	inline void store64BE(UInt8* p, UInt64 value)
+	{
+		store32BE(p, static_cast<UInt32>(value >> 32));
+		store32BE(p + 4, static_cast<UInt32>(value));
+	}
+
+
+	void sha256Transform(UInt32* state, const UInt8* data, std::size_t blocks)
+	{
+		UInt32 w[64];
+		while (blocks-- > 0)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				w[i] = load32BE(data + 4*i);
+			}
+			for (int i = 16; i < 64; i++)
+			{
+				UInt32 s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+				UInt32 s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+			UInt32 a = state[0], b = state[1], c = state[2], d = state[3];
+			UInt32 e = state[4], f = state[5], g = state[6], h = state[7];
+			for (int i = 0; i < 64; i++)
+			{
+				UInt32 t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) + K256[i] + w[i];
+				UInt32 t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+				h = g;
+				g = f;
+				f = e;
+				e = d + t1;
+				d = c;
+				c = b;
+				b = a;
+				a = t1 + t2;
+			}
+			state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+			state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+			data += 64;
+		}
+	}
+
+
+	void sha512Transform(UInt64* state, const UInt8* data, std::size_t blocks)
+	{
+		UInt64 w[80];
+		while (blocks-- > 0)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				w[i] = load64BE(data + 8*i);
+			}
+			for (int i = 16; i < 80; i++)
+			{
+				UInt64 s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+				UInt64 s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+			UInt64 a = state[0], b = state[1], c = state[2], d = state[3];
+			UInt64 e = state[4], f = state[5], g = state[6], h = state[7];
+			for (int i = 0; i < 80; i++)
+			{
+				UInt64 t1 = h + (rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41)) + ((e & f) ^ (~e & g)) + K512[i] + w[i];
+				UInt64 t2 = (rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+				h = g;
+				g = f;
+				f = e;
+				e = d + t1;
+				d = c;
+				c = b;
+				b = a;
+				a = t1 + t2;
+			}
+			state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+			state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+			data += 128;
+		}
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	template <int I>
+	POCO_TARGET_ISA("sha,sse4.1,ssse3")
+	inline void sha256RoundsNI(__m128i& state0, __m128i& state1, __m128i* msg)
+		/// Performs rounds 4*I to 4*I + 3, and computes the
+		/// message schedule for the following rounds, using
+		/// the SHA extensions.
+	{
+		__m128i m = _mm_add_epi32(msg[I % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(K256 + 4*I)));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+		if (I >= 3 && I <= 14)
+		{
+			__m128i t = _mm_alignr_epi8(msg[I % 4], msg[(I + 3) % 4], 4);
+			msg[(I + 1) % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(msg[(I + 1) % 4], t), msg[I % 4]);
+		}
+		m = _mm_shuffle_epi32(m, 0x0E);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, m);
+		if (I >= 1 && I <= 12)
+			msg[(I + 3) % 4] = _mm_sha256msg1_epu32(msg[(I + 3) % 4], msg[I % 4]);
+	}
+
+
+	POCO_TARGET_ISA("sha,sse4.1,ssse3")
+	void sha256TransformNI(UInt32* state, const UInt8* data, std::size_t blocks)
+		/// Processes the given number of 64 byte blocks with
+		/// the SHA extensions, which keep the state in the
+		/// order ABEF, CDGH.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+
+		__m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+		__m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+		__m128i state0 = _mm_alignr_epi8(dcba, efgh, 8);
+		__m128i state1 = _mm_blend_epi16(efgh, dcba, 0xF0);
+		__m128i msg[4];
+		while (blocks-- > 0)
+		{
+			__m128i state0Save = state0;
+			__m128i state1Save = state1;
+			for (int i = 0; i < 4; i++)
+			{
+				msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), mask);
+			}
+			sha256RoundsNI<0>(state0, state1, msg);
+			sha256RoundsNI<1>(state0, state1, msg);
+			sha256RoundsNI<2>(state0, state1, msg);
+			sha256RoundsNI<3>(state0, state1, msg);
+			sha256RoundsNI<4>(state0, state1, msg);
+			sha256RoundsNI<5>(state0, state1, msg);
+			sha256RoundsNI<6>(state0, state1, msg);
+			sha256RoundsNI<7>(state0, state1, msg);
+			sha256RoundsNI<8>(state0, state1, msg);
+			sha256RoundsNI<9>(state0, state1, msg);
+			sha256RoundsNI<10>(state0, state1, msg);
+			sha256RoundsNI<11>(state0, state1, msg);
+			sha256RoundsNI<12>(state0, state1, msg);
+			sha256RoundsNI<13>(state0, state1, msg);
+			sha256RoundsNI<14>(state0, state1, msg);
+			sha256RoundsNI<15>(state0, state1, msg);
+			state0 = _mm_add_epi32(state0, state0Save);
+			state1 = _mm_add_epi32(state1, state1Save);
+			data += 64;
+		}
+		__m128i feba = _mm_shuffle_epi32(state0, 0x1B);
+		__m128i dchg = _mm_shuffle_epi32(state1, 0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+	}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+}
+
+
+SHA2Engine::SHA2Engine(ALGORITHM algorithm):
+	_algorithm(algorithm)
+{
+	_digest.reserve(64);
+	reset();
+}
+
+
+SHA2Engine::~SHA2Engine()
+{
+	reset();
+}
+
+
+void SHA2Engine::transform(const UInt8* data, std::size_t blocks)
+{
+	if (_algorithm > SHA_256)
+	{
+		sha512Transform(_state64, data, blocks);
+	}
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	else if (CPUFeatures::hasSHA() && CPUFeatures::hasSSE41())
+	{
+		sha256TransformNI(_state32, data, blocks);
+	}
+#endif
+	else
+	{
+		sha256Transform(_state32, data, blocks);
+	}
+}
+
+
+void SHA2Engine::updateImpl(const void* buffer_, std::size_t count)
+{
+	const UInt8* buffer = static_cast<const UInt8*>(buffer_);
+	const std::size_t blockLen = blockLength();
+
+	_count += count;
+
+	if (_bufferLength > 0)
+	{
+		std::size_t n = blockLen - _bufferLength;
+		if (n > count) n = count;
+		std::memcpy(_buffer + _bufferLength, buffer, n);
+		_bufferLength += n;
+		buffer += n;
+		count  -= n;
+		if (_bufferLength < blockLen) return;
+		transform(_buffer, 1);
+		_bufferLength = 0;
+	}
+	if (count >= blockLen)
+	{
+		std::size_t blocks = count/blockLen;
+		transform(buffer, blocks);
+		buffer += blocks*blockLen;
+		count  -= blocks*blockLen;
+	}
+	std::memcpy(_buffer, buffer, count);
+	_bufferLength = count;
+}
+
+
+std::size_t SHA2Engine::digestLength() const
+{
+	return static_cast<std::size_t>(_algorithm)/8;
+}
+
+
+void SHA2Engine::reset()
+{
+	switch (_algorithm)
+	{
+	case SHA_224:
+		std::memcpy(_state32, INITIAL_224, sizeof(_state32));
+		break;
+	case SHA_384:
+		std::memcpy(_state64, INITIAL_384, sizeof(_state64));
+		break;
+	case SHA_512:
+		std::memcpy(_state64, INITIAL_512, sizeof(_state64));
+		break;
+	default:
+		std::memcpy(_state32, INITIAL_256, sizeof(_state32));
+		break;
+	}
+	_count = 0;
+	_bufferLength = 0;
+	std::memset(_buffer, 0, sizeof(_buffer));
+}
+
+
+const DigestEngine::Digest& SHA2Engine::digest()
+{
+	const std::size_t blockLen = blockLength();
+	const std::size_t lengthLen = blockLen/8;
+
+	// Append the 1 bit, pad with zeros and append the message
+	// length in bits, as a 64 or 128 bit big-endian number.
+	_buffer[_bufferLength++] = 0x80;
+	if (_bufferLength > blockLen - lengthLen)
+	{
+		std::memset(_buffer + _bufferLength, 0, blockLen - _bufferLength);
+		transform(_buffer, 1);
+		_bufferLength = 0;
+	}
+	std::memset(_buffer + _bufferLength, 0, blockLen - _bufferLength);
+	if (lengthLen == 16) store64BE(_buffer + blockLen - 16, _count >> 61);
+	store64BE(_buffer + blockLen - 8, _count << 3);
+	transform(_buffer, 1);
+
+	UInt8 hash[64];
+	if (_algorithm > SHA_256)
+	{
+		for (int i = 0; i < 8; i++) store64BE(hash + 8*i, _state64[i]);
+	}
+	else
+	{
+		for (int i = 0; i < 8; i++) store32BE(hash + 4*i, _state32[i]);
+	}
+	_digest.clear();
+	_digest.insert(_digest.begin(), hash, hash + digestLength());
+	reset();
+	return _digest;
+}
+
+
+SHA224Engine::SHA224Engine():
+	SHA2Engine(SHA_224)
+{
+}
+
+
+SHA224Engine::~SHA224Engine()
+{
+}
+
+
+SHA256Engine::SHA256Engine():
+	SHA2Engine(SHA_256)
+{
+}
+
+
+SHA256Engine::~SHA256Engine()
+{
+}
+
+
+SHA384Engine::SHA384Engine():
+	SHA2Engine(SHA_384)
+{
+}
+
+
+SHA384Engine::~SHA384Engine()
+{
+}
+
+
+SHA512Engine::SHA512Engine():
+	SHA2Engine(SHA_512)
+{
+}
+
+
+SHA512Engine::~SHA512Engine()
+{
+}
+
+
+} // namespace Poco
@@ -21,6 +21,9 @@
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
 #include "Poco/String.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Timer.h"
 
 
 namespace Poco {
@@ -30,12 +33,17 @@ const std::string SimpleFileChannel::PROP_PATH          = "path";
 const std::string SimpleFileChannel::PROP_SECONDARYPATH = "secondaryPath";
 const std::string SimpleFileChannel::PROP_ROTATION      = "rotation";
 const std::string SimpleFileChannel::PROP_FLUSH         = "flush";
+const std::string SimpleFileChannel::PROP_BUFFERSIZE    = "bufferSize";
+const std::string SimpleFileChannel::PROP_FLUSHINTERVAL = "flushInterval";
 
 
 SimpleFileChannel::SimpleFileChannel(): 
 	_limit(0),
 	_flush(true),
-	_pFile(0)
+	_bufferSize(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
+	_pFile(0),
+	_pFlushTimer(0)
 {
 }
 
@@ -45,7 +53,10 @@ SimpleFileChannel::SimpleFileChannel(const std::string& rPath):
 	_secondaryPath(rPath + ".0"),
 	_limit(0),
 	_flush(true),
-	_pFile(0)
+	_bufferSize(LogFile::DEFAULT_BUFFER_SIZE),
+	_flushInterval(0),
+	_pFile(0),
+	_pFlushTimer(0)
 {
 }
 
@@ -79,12 +90,20 @@ void SimpleFileChannel::open()
 		else
 			pathString = _secondaryPath;
 		_pFile = new LogFile(pathString);
+		_pFile->setBufferSize(_bufferSize);
+		if (_flushInterval > 0 && !_pFlushTimer)
+		{
+			_pFlushTimer = new Timer(_flushInterval, _flushInterval);
+			_pFlushTimer->start(TimerCallback<SimpleFileChannel>(*this, &SimpleFileChannel::onFlush));
+		}
 	}
 }
 
 
 void SimpleFileChannel::close()
 {
+	stopFlushTimer();
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	delete _pFile;
@@ -105,9 +124,34 @@ void SimpleFileChannel::log(const Message& msg)
 	_pFile->write(msg.getText(), _flush);
 }
 
+
+void SimpleFileChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	open();
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (_limit > 0 && _pFile->size() >= _limit)
+		{
+			rotate();
+		}
+		_pFile->write(pMessages[i].getText(), false);
+	}
+	if (_flush) _pFile->flush();
+}
+
 	
 void SimpleFileChannel::setProperty(const std::string& name, const std::string& value)
 {
+	// setBufferSize() takes the lock itself
+	if (name == PROP_BUFFERSIZE)
+	{
+		setBufferSize(value);
+		return;
+	}
+
 	FastMutex::ScopedLock lock(_mutex);
 
 	if (name == PROP_PATH)
@@ -122,6 +166,8 @@ void SimpleFileChannel::setProperty(const std::string& name, const std::string&
 		setRotation(value);
 	else if (name == PROP_FLUSH)
 		setFlush(value);
+	else if (name == PROP_FLUSHINTERVAL)
+		setFlushInterval(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -137,6 +183,10 @@ std::string SimpleFileChannel::getProperty(const std::string& name) const
 		return _rotation;
 	else if (name == PROP_FLUSH)
 		return std::string(_flush ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return NumberFormatter::format(_bufferSize);
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
 	else
 		return Channel::getProperty(name);
 }
@@ -203,6 +253,26 @@ void SimpleFileChannel::setFlush(const std::string& flush)
 }
 
 
+void SimpleFileChannel::setBufferSize(const std::string& size)
+{
+	int n = NumberParser::parse(size);
+	if (n < 0) throw InvalidArgumentException("bufferSize", size);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	_bufferSize = n;
+	if (_pFile) _pFile->setBufferSize(_bufferSize);
+}
+
+
+void SimpleFileChannel::setFlushInterval(const std::string& interval)
+{
+	long n = NumberParser::parse(interval);
+	if (n < 0) throw InvalidArgumentException("flushInterval", interval);
+	_flushInterval = n;
+}
+
+
 void SimpleFileChannel::rotate()
 {
 	std::string newPath;
@@ -223,6 +293,31 @@ void SimpleFileChannel::rotate()
 	}
 	delete _pFile;
 	_pFile = new LogFile(newPath);
+	_pFile->setBufferSize(_bufferSize);
+}
+
+
+void SimpleFileChannel::onFlush(Timer& /*timer*/)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_pFile) _pFile->flush();
+}
+
+
+void SimpleFileChannel::stopFlushTimer()
+{
+	Timer* pTimer;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		pTimer = _pFlushTimer;
+		_pFlushTimer = 0;
+	}
+	if (pTimer)
+	{
+		pTimer->stop();
+		delete pTimer;
+	}
 }
 
 
@@ -0,0 +1,392 @@
+//
+// SizeClassPool.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  SizeClassPool
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SizeClassPool.h"
+#include "Poco/Exception.h"
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnWindows.h"
+#else
+#include <pthread.h>
+#endif
+#include <algorithm>
+#include <new>
+
+
+namespace Poco {
+
+
+SizeClassPool::ThreadCache::ThreadCache():
+	pPool(0)
+{
+	for (int i = 0; i < SIZE_CLASSES; ++i)
+	{
+		loaded[i]   = 0;
+		previous[i] = 0;
+	}
+}
+
+
+SizeClassPool::ThreadCache::~ThreadCache()
+{
+	if (pPool) pPool->flush(*this);
+}
+
+
+SizeClassPool::SizeClassPool()
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#if _WIN32_WINNT >= 0x0600
+	DWORD key = FlsAlloc(&destroyThreadCache);
+	if (key == FLS_OUT_OF_INDEXES) throw SystemException("cannot allocate thread-specific storage");
+#else
+	DWORD key = TlsAlloc();
+	if (key == TLS_OUT_OF_INDEXES) throw SystemException("cannot allocate thread-specific storage");
+#endif
+#else
+	pthread_key_t key;
+	if (pthread_key_create(&key, &destroyThreadCache)) throw SystemException("cannot allocate thread-specific storage");
+#endif
+	_cacheKey = static_cast<UIntPtr>(key);
+}
+
+
+SizeClassPool::~SizeClassPool()
+{
+	// the caches of all other threads have been
+	// returned to the depots when the threads exited
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#if _WIN32_WINNT >= 0x0600
+	delete static_cast<ThreadCache*>(FlsGetValue(static_cast<DWORD>(_cacheKey)));
+	FlsSetValue(static_cast<DWORD>(_cacheKey), 0);
+	FlsFree(static_cast<DWORD>(_cacheKey));
+#else
+	delete static_cast<ThreadCache*>(TlsGetValue(static_cast<DWORD>(_cacheKey)));
+	TlsFree(static_cast<DWORD>(_cacheKey));
+#endif
+#else
+	delete static_cast<ThreadCache*>(pthread_getspecific(static_cast<pthread_key_t>(_cacheKey)));
+	pthread_setspecific(static_cast<pthread_key_t>(_cacheKey), 0);
+	pthread_key_delete(static_cast<pthread_key_t>(_cacheKey));
+#endif
+
+	for (int cls = 0; cls < SIZE_CLASSES; ++cls)
+	{
+		Depot& depot = _depots[cls];
+		for (std::vector<Magazine*>::iterator it = depot.full.begin(); it != depot.full.end(); ++it)
+		{
+			delete *it;
+		}
+		for (std::vector<Magazine*>::iterator it = depot.empty.begin(); it != depot.empty.end(); ++it)
+		{
+			delete *it;
+		}
+		for (std::vector<char*>::iterator it = depot.chunks.begin(); it != depot.chunks.end(); ++it)
+		{
+			delete [] *it;
+		}
+	}
+}
+
+
+void* SizeClassPool::allocate(std::size_t size)
+{
+	if (size > MAX_BLOCK_SIZE) return ::operator new(size);
+
+	return allocate(threadCache(), sizeClass(size));
+}
+
+
+void SizeClassPool::deallocate(void* ptr, std::size_t size)
+{
+	if (!ptr) return;
+	if (size > MAX_BLOCK_SIZE)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	deallocate(threadCache(), sizeClass(size), ptr);
+}
+
+
+void SizeClassPool::flush()
+{
+	flush(threadCache());
+}
+
+
+void SizeClassPool::trim()
+{
+	for (int cls = 0; cls < SIZE_CLASSES; ++cls)
+	{
+		trim(cls);
+	}
+}
+
+
+std::size_t SizeClassPool::blockSize(std::size_t size)
+{
+	if (size > MAX_BLOCK_SIZE) return size;
+	else return static_cast<std::size_t>(MIN_BLOCK_SIZE) << sizeClass(size);
+}
+
+
+SizeClassPool& SizeClassPool::defaultPool()
+{
+	// Blocks from the default pool may still be released during
+	// static destruction (e.g., by global stream objects), so the
+	// default pool is intentionally never destroyed.
+	static SizeClassPool* pPool = new SizeClassPool;
+	return *pPool;
+}
+
+
+void* SizeClassPool::allocate(ThreadCache& cache, int cls)
+{
+	Magazine*& pLoaded   = cache.loaded[cls];
+	Magazine*& pPrevious = cache.previous[cls];
+	if (pLoaded && pLoaded->count > 0)
+	{
+		return pLoaded->rounds[--pLoaded->count];
+	}
+	if (pPrevious && pPrevious->count > 0)
+	{
+		std::swap(pLoaded, pPrevious);
+		return pLoaded->rounds[--pLoaded->count];
+	}
+	Magazine* pEmpty = pPrevious;
+	pPrevious = pLoaded;
+	pLoaded = exchangeEmpty(cls, pEmpty);
+	return pLoaded->rounds[--pLoaded->count];
+}
+
+
+void SizeClassPool::deallocate(ThreadCache& cache, int cls, void* ptr)
+{
+	Magazine*& pLoaded   = cache.loaded[cls];
+	Magazine*& pPrevious = cache.previous[cls];
+	int cap = capacity(cls);
+	if (pLoaded && pLoaded->count < cap)
+	{
+		pLoaded->rounds[pLoaded->count++] = ptr;
+		return;
+	}
+	if (pPrevious && pPrevious->count == 0)
+	{
+		std::swap(pLoaded, pPrevious);
+		pLoaded->rounds[pLoaded->count++] = ptr;
+		return;
+	}
+	Magazine* pFull = pPrevious;
+	pPrevious = pLoaded;
+	pLoaded = exchangeFull(cls, pFull);
+	pLoaded->rounds[pLoaded->count++] = ptr;
+}
+
+
+SizeClassPool::ThreadCache& SizeClassPool::threadCache()
+{
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#if _WIN32_WINNT >= 0x0600
+	ThreadCache* pCache = static_cast<ThreadCache*>(FlsGetValue(static_cast<DWORD>(_cacheKey)));
+#else
+	ThreadCache* pCache = static_cast<ThreadCache*>(TlsGetValue(static_cast<DWORD>(_cacheKey)));
+#endif
+#else
+	ThreadCache* pCache = static_cast<ThreadCache*>(pthread_getspecific(static_cast<pthread_key_t>(_cacheKey)));
+#endif
+	if (!pCache)
+	{
+		pCache = new ThreadCache;
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#if _WIN32_WINNT >= 0x0600
+		bool ok = FlsSetValue(static_cast<DWORD>(_cacheKey), pCache) != 0;
+#else
+		bool ok = TlsSetValue(static_cast<DWORD>(_cacheKey), pCache) != 0;
+#endif
+#else
+		bool ok = pthread_setspecific(static_cast<pthread_key_t>(_cacheKey), pCache) == 0;
+#endif
+		if (!ok)
+		{
+			delete pCache;
+			throw SystemException("cannot set thread-specific storage");
+		}
+		pCache->pPool = this;
+	}
+	return *pCache;
+}
+
+
+void SizeClassPool::destroyThreadCache(void* pCache)
+{
+	delete static_cast<ThreadCache*>(pCache);
+}
+
+
+SizeClassPool::Magazine* SizeClassPool::exchangeEmpty(int cls, Magazine* pEmpty)
+{
+	Depot& depot = _depots[cls];
+	FastMutex::ScopedLock lock(depot.mutex);
+
+	if (pEmpty) depot.empty.push_back(pEmpty);
+	if (!depot.full.empty())
+	{
+		Magazine* pFull = depot.full.back();
+		depot.full.pop_back();
+		return pFull;
+	}
+
+	Magazine* pMagazine;
+	if (!depot.empty.empty())
+	{
+		pMagazine = depot.empty.back();
+		depot.empty.pop_back();
+	}
+	else pMagazine = new Magazine;
+
+	std::size_t size = static_cast<std::size_t>(MIN_BLOCK_SIZE) << cls;
+	int n = capacity(cls);
+	char* pChunk;
+	try
+	{
+		depot.chunks.reserve(depot.chunks.size() + 1);
+		pChunk = new char[size*n];
+	}
+	catch (...)
+	{
+		depot.empty.push_back(pMagazine);
+		throw;
+	}
+	depot.chunks.push_back(pChunk);
+	for (int i = 0; i < n; ++i)
+	{
+		pMagazine->rounds[i] = pChunk + i*size;
+		++_allocated;
+	}
+	pMagazine->count = n;
+	return pMagazine;
+}
+
+
+SizeClassPool::Magazine* SizeClassPool::exchangeFull(int cls, Magazine* pFull)
+{
+	Depot& depot = _depots[cls];
+	FastMutex::ScopedLock lock(depot.mutex);
+
+	if (pFull) depot.full.push_back(pFull);
+	if (!depot.empty.empty())
+	{
+		Magazine* pEmpty = depot.empty.back();
+		depot.empty.pop_back();
+		return pEmpty;
+	}
+	Magazine* pMagazine = new Magazine;
+	pMagazine->count = 0;
+	return pMagazine;
+}
+
+
+void SizeClassPool::flush(ThreadCache& cache)
+{
+	for (int cls = 0; cls < SIZE_CLASSES; ++cls)
+	{
+		Magazine* magazines[2] = { cache.loaded[cls], cache.previous[cls] };
+		cache.loaded[cls]   = 0;
+		cache.previous[cls] = 0;
+
+		Depot& depot = _depots[cls];
+		FastMutex::ScopedLock lock(depot.mutex);
+		for (int i = 0; i < 2; ++i)
+		{
+			if (magazines[i])
+			{
+				if (magazines[i]->count > 0)
+					depot.full.push_back(magazines[i]);
+				else
+					depot.empty.push_back(magazines[i]);
+			}
+		}
+	}
+}
+
+
+
+void SizeClassPool::trim(int cls)
+{
+	Depot& depot = _depots[cls];
+	FastMutex::ScopedLock lock(depot.mutex);
+
+	std::size_t size = static_cast<std::size_t>(MIN_BLOCK_SIZE) << cls;
+	int n = capacity(cls);
+
+	std::vector<char*> blocks;
+	for (std::vector<Magazine*>::iterator it = depot.full.begin(); it != depot.full.end(); ++it)
+	{
+		for (int i = 0; i < (*it)->count; ++i)
+		{
+			blocks.push_back(static_cast<char*>((*it)->rounds[i]));
+		}
+	}
+	std::sort(blocks.begin(), blocks.end());
+
+	// A chunk is unused if all of its blocks are in the depot.
+	// Since every block is in the depot at most once, this is
+	// the case if the depot holds n blocks within the chunk.
+	std::vector<char*> chunks;
+	std::vector<char*> freeBlocks;
+	freeBlocks.reserve(blocks.size());
+	for (std::vector<char*>::iterator it = depot.chunks.begin(); it != depot.chunks.end(); ++it)
+	{
+		std::vector<char*>::iterator first = std::lower_bound(blocks.begin(), blocks.end(), *it);
+		std::vector<char*>::iterator last  = std::lower_bound(first, blocks.end(), *it + n*size);
+		if (last - first == n)
+		{
+			delete [] *it;
+			for (int i = 0; i < n; ++i) --_allocated;
+		}
+		else
+		{
+			chunks.push_back(*it);
+			freeBlocks.insert(freeBlocks.end(), first, last);
+		}
+	}
+	if (chunks.size() == depot.chunks.size()) return;
+	depot.chunks.swap(chunks);
+
+	// refill the magazines with the remaining blocks
+	std::vector<Magazine*> magazines;
+	magazines.swap(depot.full);
+	magazines.insert(magazines.end(), depot.empty.begin(), depot.empty.end());
+	depot.empty.clear();
+	std::vector<char*>::iterator itBlock = freeBlocks.begin();
+	for (std::vector<Magazine*>::iterator it = magazines.begin(); it != magazines.end(); ++it)
+	{
+		Magazine* pMagazine = *it;
+		pMagazine->count = 0;
+		while (pMagazine->count < n && itBlock != freeBlocks.end())
+		{
+			pMagazine->rounds[pMagazine->count++] = *itBlock++;
+		}
+		if (pMagazine->count > 0)
+			depot.full.push_back(pMagazine);
+		else
+			delete pMagazine;
+	}
+}
+
+
+} // namespace Poco
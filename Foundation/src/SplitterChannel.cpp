@@ -92,6 +92,28 @@ void SplitterChannel::log(const Message& msg)
 }
 
 
+void SplitterChannel::logBatch(const Message* pMessages, std::size_t count)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ChannelVec::iterator it = _channels.begin(); it != _channels.end(); ++it)
+	{
+		(*it)->logBatch(pMessages, count);
+	}
+}
+
+
+void SplitterChannel::logRecord(const LogRecord& record)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	for (ChannelVec::iterator it = _channels.begin(); it != _channels.end(); ++it)
+	{
+		(*it)->logRecord(record);
+	}
+}
+
+
 void SplitterChannel::close()
 {
 	FastMutex::ScopedLock lock(_mutex);
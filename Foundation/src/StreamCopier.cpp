@@ -15,18 +15,145 @@
 
 
 #include "Poco/StreamCopier.h"
-#include "Poco/Buffer.h"
+#include "Poco/SizeClassPool.h"
+#include "Poco/FileStream.h"
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	class CopyBuffer
+		/// A buffer for copying data, allocated from the
+		/// default SizeClassPool, so that copying many small
+		/// streams does not allocate memory each time.
+	{
+	public:
+		CopyBuffer(std::size_t size):
+			_ptr(static_cast<char*>(SizeClassPool::defaultPool().allocate(size))),
+			_size(size)
+		{
+		}
+
+		~CopyBuffer()
+		{
+			SizeClassPool::defaultPool().deallocate(_ptr, _size);
+		}
+
+		char* begin()
+		{
+			return _ptr;
+		}
+
+	private:
+		CopyBuffer(const CopyBuffer&);
+		CopyBuffer& operator = (const CopyBuffer&);
+
+		char* _ptr;
+		std::size_t _size;
+	};
+
+
+#if POCO_OS == POCO_OS_LINUX
+	const std::size_t MAX_KERNEL_COPY = 0x40000000;
+
+	bool copyFile(std::istream& istr, std::ostream& ostr, Poco::UInt64& len)
+		/// If istr reads from a regular file and ostr writes to a file
+		/// descriptor, both through a FileStreamBuf, copies the remaining
+		/// data of istr with copy_file_range() or sendfile(), so that
+		/// the data is never copied to user space.
+		///
+		/// Returns true if all data has been copied, or false if the
+		/// data must be copied (or the copy completed) the normal way.
+	{
+		if (!istr.good() || !ostr.good()) return false;
+		FileStreamBuf* pIn = dynamic_cast<FileStreamBuf*>(istr.rdbuf());
+		FileStreamBuf* pOut = dynamic_cast<FileStreamBuf*>(ostr.rdbuf());
+		if (!pIn || !pOut || pIn == pOut) return false;
+		int in = pIn->nativeHandle();
+		int out = pOut->nativeHandle();
+		if (in == -1 || out == -1) return false;
+
+		// files in /proc and similar file systems report a size of 0
+		// and cannot be copied by the kernel
+		struct stat st;
+		if (fstat(in, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) return false;
+
+		// write buffered output, and move the file offset of istr back
+		// to the data not yet taken from its buffer
+		ostr.flush();
+		if (!ostr.good()) return false;
+		if (pIn->pubseekoff(0, std::ios::cur, std::ios::in) == std::streampos(-1)) return false;
+
+		Poco::UInt64 copied = 0;
+		bool ok = true;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+		bool useCopyFileRange = true;
+#endif
+		for (;;)
+		{
+			ssize_t n;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+			if (useCopyFileRange)
+			{
+				n = copy_file_range(in, 0, out, 0, MAX_KERNEL_COPY, 0);
+				if (n < 0 && errno != EINTR)
+				{
+					// not supported by the kernel or for these files
+					useCopyFileRange = false;
+					continue;
+				}
+			}
+			else
+#endif
+			n = sendfile(out, in, 0, MAX_KERNEL_COPY);
+			if (n > 0)
+				copied += n;
+			else if (n == 0)
+				break;
+			else if (errno != EINTR)
+			{
+				ok = false;
+				break;
+			}
+		}
+
+		// update the positions kept by the stream buffers
+		if (copied > 0)
+		{
+			pIn->pubseekoff(0, std::ios::cur, std::ios::in);
+			pOut->pubseekoff(0, std::ios::cur, std::ios::out);
+		}
+		len += copied;
+		if (ok) istr.setstate(std::ios::eofbit | std::ios::failbit);
+		return ok;
+	}
+#endif
+}
+
+
 std::streamsize StreamCopier::copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
 {
 	poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
+#if POCO_OS == POCO_OS_LINUX
+	Poco::UInt64 copied = 0;
+	bool done = copyFile(istr, ostr, copied);
+	std::streamsize len = static_cast<std::streamsize>(copied);
+	if (done) return len;
+#else
 	std::streamsize len = 0;
+#endif
+
+	CopyBuffer buffer(bufferSize);
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
 	while (n > 0)
@@ -49,8 +176,12 @@ Poco::UInt64 StreamCopier::copyStream64(std::istream& istr, std::ostream& ostr,
 {
 	poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
 	Poco::UInt64 len = 0;
+#if POCO_OS == POCO_OS_LINUX
+	if (copyFile(istr, ostr, len)) return len;
+#endif
+
+	CopyBuffer buffer(bufferSize);
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
 	while (n > 0)
@@ -73,7 +204,7 @@ std::streamsize StreamCopier::copyToString(std::istream& istr, std::string& str,
 {
 	poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
+	CopyBuffer buffer(bufferSize);
 	std::streamsize len = 0;
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
@@ -97,7 +228,7 @@ Poco::UInt64 StreamCopier::copyToString64(std::istream& istr, std::string& str,
 {
 	poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
+	CopyBuffer buffer(bufferSize);
 	Poco::UInt64 len = 0;
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
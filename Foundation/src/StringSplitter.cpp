@@ -0,0 +1,217 @@
+//
+// StringSplitter.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringSplitter
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StringSplitter.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+StringSplitter::StringSplitter(const StringView& str, char separator, int options):
+	_it(str.begin()),
+	_end(str.end()),
+	_separator(separator),
+	_mode(MODE_CHAR),
+	_options(options & ~TOK_STRING),
+	_done(str.empty())
+{
+	std::memset(_set, 0, sizeof(_set));
+	addSeparator(separator);
+	initStops();
+}
+
+
+StringSplitter::StringSplitter(const StringView& str, const StringView& separators, int options):
+	_it(str.begin()),
+	_end(str.end()),
+	_separators(separators),
+	_separator(0),
+	_mode(MODE_SET),
+	_options(options),
+	_done(str.empty())
+{
+	std::memset(_set, 0, sizeof(_set));
+	if (options & TOK_STRING)
+	{
+		_mode = MODE_STRING;
+	}
+	else
+	{
+		for (StringView::ConstIterator it = separators.begin(); it != separators.end(); ++it)
+		{
+			addSeparator(*it);
+		}
+		if (separators.size() == 1)
+		{
+			_mode = MODE_CHAR;
+			_separator = separators[0];
+		}
+	}
+	initStops();
+}
+
+
+StringSplitter::~StringSplitter()
+{
+}
+
+
+void StringSplitter::initStops()
+{
+	std::memcpy(_stops, _set, sizeof(_stops));
+	if (_mode == MODE_STRING && !_separators.empty())
+	{
+		unsigned char uc = static_cast<unsigned char>(_separators[0]);
+		_stops[uc >> 5] |= 1u << (uc & 31);
+	}
+	_stops['"' >> 5]  |= 1u << ('"' & 31);
+	_stops['\\' >> 5] |= 1u << ('\\' & 31);
+}
+
+
+bool StringSplitter::next(StringView& token)
+{
+	while (!_done)
+	{
+		const char* begin = _it;
+		const char* end = findSeparator(begin, _it);
+		if (end == _end) _done = true;
+
+		StringView result(begin, end - begin);
+		if (_options & TOK_TRIM) result = result.trimmed();
+		if (result.empty() && (_options & TOK_IGNORE_EMPTY)) continue;
+		token = result;
+		return true;
+	}
+	return false;
+}
+
+
+const char* StringSplitter::findSeparator(const char* it, const char*& next) const
+	/// Returns the position of the next separator at or after it,
+	/// and stores the position following the separator in next.
+	/// Returns _end if there is no more separator.
+{
+	if (_options & TOK_QUOTES) return findQuoted(it, next);
+
+	next = _end;
+	switch (_mode)
+	{
+	case MODE_CHAR:
+		{
+			const void* p = std::memchr(it, _separator, _end - it);
+			if (p)
+			{
+				next = static_cast<const char*>(p) + 1;
+				return static_cast<const char*>(p);
+			}
+		}
+		break;
+	case MODE_SET:
+		for (; it != _end; ++it)
+		{
+			if (isSeparator(*it))
+			{
+				next = it + 1;
+				return it;
+			}
+		}
+		break;
+	case MODE_STRING:
+		{
+			std::size_t n = _separators.size();
+			while (n > 0 && static_cast<std::size_t>(_end - it) >= n)
+			{
+				const void* p = std::memchr(it, _separators[0], _end - it - n + 1);
+				if (!p) break;
+				it = static_cast<const char*>(p);
+				if (std::memcmp(it + 1, _separators.data() + 1, n - 1) == 0)
+				{
+					next = it + n;
+					return it;
+				}
+				++it;
+			}
+		}
+		break;
+	}
+	return _end;
+}
+
+
+const char* StringSplitter::findQuoted(const char* it, const char*& next) const
+{
+	while (it != _end)
+	{
+		// skip ordinary characters, which are neither
+		// separators nor quotes or backslashes
+		while (!isStop(*it))
+		{
+			if (++it == _end)
+			{
+				next = _end;
+				return _end;
+			}
+		}
+		if (*it == '"')
+		{
+			++it;
+			while (it != _end && *it != '"')
+			{
+				if (*it == '\\' && ++it == _end) break;
+				++it;
+			}
+			if (it != _end) ++it;
+		}
+		else if (*it == '\\')
+		{
+			++it;
+			if (it != _end) ++it;
+		}
+		else if (isSeparatorAt(it, next))
+		{
+			return it;
+		}
+		else ++it;
+	}
+	next = _end;
+	return _end;
+}
+
+
+bool StringSplitter::isSeparatorAt(const char* it, const char*& next) const
+{
+	if (_mode == MODE_STRING)
+	{
+		std::size_t n = _separators.size();
+		if (n > 0 && static_cast<std::size_t>(_end - it) >= n && std::memcmp(it, _separators.data(), n) == 0)
+		{
+			next = it + n;
+			return true;
+		}
+		return false;
+	}
+	else if (isSeparator(*it))
+	{
+		next = it + 1;
+		return true;
+	}
+	return false;
+}
+
+
+} // namespace Poco
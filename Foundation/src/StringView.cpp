@@ -0,0 +1,67 @@
+//
+// StringView.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringView
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StringView.h"
+
+
+namespace Poco {
+
+
+const StringView::SizeType StringView::NPOS;
+
+
+StringView::SizeType StringView::find(const StringView& str, SizeType pos) const
+{
+	if (str.empty()) return pos <= _size ? pos : NPOS;
+	while (pos < _size && _size - pos >= str._size)
+	{
+		const void* p = std::memchr(_data + pos, str._data[0], _size - pos - str._size + 1);
+		if (!p) break;
+		pos = static_cast<const char*>(p) - _data;
+		if (std::memcmp(_data + pos + 1, str._data + 1, str._size - 1) == 0) return pos;
+		++pos;
+	}
+	return NPOS;
+}
+
+
+int StringView::compare(const StringView& str) const
+{
+	SizeType n = _size < str._size ? _size : str._size;
+	int rc = n > 0 ? std::memcmp(_data, str._data, n) : 0;
+	if (rc != 0) return rc;
+	if (_size < str._size) return -1;
+	if (_size > str._size) return 1;
+	return 0;
+}
+
+
+int StringView::icompare(const StringView& str) const
+{
+	SizeType n = _size < str._size ? _size : str._size;
+	for (SizeType i = 0; i < n; ++i)
+	{
+		int c1 = Ascii::toLower(static_cast<unsigned char>(_data[i]));
+		int c2 = Ascii::toLower(static_cast<unsigned char>(str._data[i]));
+		if (c1 != c2) return c1 < c2 ? -1 : 1;
+	}
+	if (_size < str._size) return -1;
+	if (_size > str._size) return 1;
+	return 0;
+}
+
+
+} // namespace Poco
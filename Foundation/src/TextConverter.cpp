@@ -15,8 +15,13 @@
 
 
 #include "Poco/TextConverter.h"
-#include "Poco/TextIterator.h"
+#include "Poco/TextBufferIterator.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/Latin1Encoding.h"
+#include "Poco/UTF8String.h"
+#include "Poco/ByteOrder.h"
 
 
 namespace {
@@ -30,6 +35,126 @@ namespace {
 namespace Poco {
 
 
+namespace
+{
+	enum Kernel
+		/// The bulk conversion functions in UTF8 that can be used
+		/// for a pair of encodings.
+	{
+		KERNEL_NONE,
+		KERNEL_UTF8_TO_UTF8,
+		KERNEL_UTF8_TO_UTF16,
+		KERNEL_UTF8_TO_LATIN1,
+		KERNEL_UTF16_TO_UTF8,
+		KERNEL_LATIN1_TO_UTF8
+	};
+
+	enum
+	{
+		BLOCK_SIZE = 4096,
+		MAX_INCOMPLETE = 4,
+		SKIP_CHARS = 16
+	};
+
+	bool isNativeByteOrder(const UTF16Encoding& encoding)
+	{
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		return encoding.getByteOrder() == UTF16Encoding::BIG_ENDIAN_BYTE_ORDER;
+#else
+		return encoding.getByteOrder() == UTF16Encoding::LITTLE_ENDIAN_BYTE_ORDER;
+#endif
+	}
+
+	Kernel selectKernel(const TextEncoding& inEncoding, const TextEncoding& outEncoding, bool& flipBytes)
+		/// Returns the kernel for converting from inEncoding to outEncoding.
+		/// UTF-16 input is only supported in native byte order.
+	{
+		const UTF16Encoding* pUTF16Out = dynamic_cast<const UTF16Encoding*>(&outEncoding);
+		flipBytes = pUTF16Out && !isNativeByteOrder(*pUTF16Out);
+
+		if (dynamic_cast<const UTF8Encoding*>(&inEncoding))
+		{
+			if (dynamic_cast<const UTF8Encoding*>(&outEncoding))
+				return KERNEL_UTF8_TO_UTF8;
+			else if (pUTF16Out)
+				return KERNEL_UTF8_TO_UTF16;
+			else if (dynamic_cast<const Latin1Encoding*>(&outEncoding))
+				return KERNEL_UTF8_TO_LATIN1;
+		}
+		else if (dynamic_cast<const UTF8Encoding*>(&outEncoding))
+		{
+			const UTF16Encoding* pUTF16In = dynamic_cast<const UTF16Encoding*>(&inEncoding);
+			if (pUTF16In && isNativeByteOrder(*pUTF16In))
+				return KERNEL_UTF16_TO_UTF8;
+			else if (dynamic_cast<const Latin1Encoding*>(&inEncoding))
+				return KERNEL_LATIN1_TO_UTF8;
+		}
+		return KERNEL_NONE;
+	}
+
+	std::size_t convertBlock(Kernel kernel, bool flipBytes, const unsigned char* it, const unsigned char* end, std::string& destination)
+		/// Converts the characters starting at it that the kernel can convert,
+		/// in blocks of up to BLOCK_SIZE bytes, and appends them to destination.
+		/// Returns the number of bytes converted. The kernel stops at the first
+		/// character it cannot convert, which must then be converted one by one.
+	{
+		UInt16 buffer[BLOCK_SIZE + 16];
+		char* pBuffer = reinterpret_cast<char*>(buffer);
+		const unsigned char* begin = it;
+		while (it != end)
+		{
+			std::size_t length = end - it;
+			if (length > BLOCK_SIZE) length = BLOCK_SIZE;
+			std::size_t read = 0;
+			std::size_t written = 0;
+			switch (kernel)
+			{
+			case KERNEL_UTF8_TO_UTF8:
+				read = UTF8::validate(reinterpret_cast<const char*>(it), length);
+				destination.append(reinterpret_cast<const char*>(it), read);
+				break;
+			case KERNEL_UTF8_TO_UTF16:
+				read = UTF8::toUTF16(reinterpret_cast<const char*>(it), length, buffer, written);
+				if (flipBytes)
+				{
+					for (std::size_t i = 0; i < written; ++i) buffer[i] = ByteOrder::flipBytes(buffer[i]);
+				}
+				destination.append(pBuffer, written*sizeof(UInt16));
+				break;
+			case KERNEL_UTF8_TO_LATIN1:
+				read = UTF8::toLatin1(reinterpret_cast<const char*>(it), length, pBuffer, written);
+				destination.append(pBuffer, written);
+				break;
+			case KERNEL_UTF16_TO_UTF8:
+				// source must be aligned for reading UTF-16 code units
+				if (reinterpret_cast<std::size_t>(it) % sizeof(UInt16) == 0)
+				{
+					length = length < 2*BLOCK_SIZE/3 ? length/sizeof(UInt16) : BLOCK_SIZE/3;
+					read = sizeof(UInt16)*UTF8::fromUTF16(reinterpret_cast<const UInt16*>(it), length, pBuffer, written);
+					destination.append(pBuffer, written);
+				}
+				break;
+			case KERNEL_LATIN1_TO_UTF8:
+				if (length > BLOCK_SIZE/2) length = BLOCK_SIZE/2;
+				read = length;
+				written = UTF8::fromLatin1(reinterpret_cast<const char*>(it), length, pBuffer);
+				destination.append(pBuffer, written);
+				break;
+			default:
+				break;
+			}
+			it += read;
+			// continue with the next block unless the kernel stopped at a
+			// character it cannot convert, rather than at the end of the block
+			std::size_t rest = end - it;
+			std::size_t blockRest = length*(kernel == KERNEL_UTF16_TO_UTF8 ? sizeof(UInt16) : 1) - read;
+			if (read == 0 || (blockRest > 0 && (blockRest >= MAX_INCOMPLETE || blockRest == rest))) break;
+		}
+		return it - begin;
+	}
+}
+
+
 TextConverter::TextConverter(const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar):
 	_inEncoding(inEncoding),
 	_outEncoding(outEncoding),
@@ -46,20 +171,34 @@ TextConverter::~TextConverter()
 int TextConverter::convert(const std::string& source, std::string& destination, Transform trans)
 {
 	int errors = 0;
-	TextIterator it(source, _inEncoding);
-	TextIterator end(source);
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(source.data());
+	const unsigned char* end = it + source.size();
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
+	bool flipBytes = false;
+	Kernel kernel = trans == nullTransform ? selectKernel(_inEncoding, _outEncoding, flipBytes) : KERNEL_NONE;
+	int skip = 0;
 
 	while (it != end)
 	{
-		int c = *it;
+		if (kernel != KERNEL_NONE && skip-- == 0)
+		{
+			std::size_t n = convertBlock(kernel, flipBytes, it, end, destination);
+			it += n;
+			if (it == end) break;
+			// if the text mostly consists of characters the kernel cannot
+			// convert, convert some characters one by one before trying again
+			skip = n == 0 ? SKIP_CHARS : 0;
+		}
+		TextBufferIterator textIt(reinterpret_cast<const char*>(it), reinterpret_cast<const char*>(end), _inEncoding);
+		int c = *textIt;
+		++textIt;
+		it = reinterpret_cast<const unsigned char*>(textIt.position());
 		if (c == -1) { ++errors; c = _defaultChar; }
 		c = trans(c);
 		int n = _outEncoding.convert(c, buffer, sizeof(buffer));
 		if (n == 0) n = _outEncoding.convert(_defaultChar, buffer, sizeof(buffer));
 		poco_assert (n <= sizeof(buffer));
 		destination.append((const char*) buffer, n);
-		++it;
 	}
 	return errors;
 }
@@ -73,9 +212,22 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 	const unsigned char* it  = (const unsigned char*) source;
 	const unsigned char* end = (const unsigned char*) source + length;
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
+	bool flipBytes = false;
+	Kernel kernel = trans == nullTransform ? selectKernel(_inEncoding, _outEncoding, flipBytes) : KERNEL_NONE;
+	int skip = 0;
 	
 	while (it < end)
 	{
+		if (kernel != KERNEL_NONE && skip-- == 0)
+		{
+			std::size_t n = convertBlock(kernel, flipBytes, it, end, destination);
+			it += n;
+			if (it == end) break;
+			// if the text mostly consists of characters the kernel cannot
+			// convert, convert some characters one by one before trying again
+			skip = n == 0 ? SKIP_CHARS : 0;
+		}
+
 		int n = _inEncoding.queryConvert(it, 1);
 		int uc;
 		int read = 1;
@@ -15,6 +15,7 @@
 
 
 #include "Poco/URI.h"
+#include "Poco/URIView.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Exception.h"
 #include "Poco/String.h"
@@ -353,38 +354,12 @@ std::string URI::getQuery() const
 URI::QueryParameters URI::getQueryParameters() const
 {
 	QueryParameters result;
-	std::string::const_iterator it(_query.begin());
-	std::string::const_iterator end(_query.end());
-	while (it != end)
+	URIView::QueryParameterIterator it(_query);
+	std::string name;
+	std::string value;
+	while (it.next(name, value))
 	{
-		std::string name;
-		std::string value;
-		while (it != end && *it != '=' && *it != '&')
-		{
-			if (*it == '+') 
-				name += ' ';
-			else
-				name += *it;
-			++it;
-		}
-		if (it != end && *it == '=')
-		{
-			++it;
-			while (it != end && *it != '&')
-			{
-				if (*it == '+') 
-					value += ' ';
-				else
-					value += *it;
-				++it;
-			}
-		}
-		std::string decodedName;
-		std::string decodedValue;
-		URI::decode(name, decodedName);
-		URI::decode(value, decodedValue);
-		result.push_back(std::make_pair(decodedName, decodedValue));
-		if (it != end && *it == '&') ++it;	
+		result.push_back(std::make_pair(name, value));
 	}
 	return result;
 }
@@ -626,61 +601,22 @@ void URI::getPathSegments(const std::string& path, std::vector<std::string>& seg
 
 void URI::encode(const std::string& str, const std::string& reserved, std::string& encodedStr)
 {
-	for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
-	{
-		char c = *it;
-		if ((c >= 'a' && c <= 'z') || 
-		    (c >= 'A' && c <= 'Z') || 
-		    (c >= '0' && c <= '9') ||
-		    c == '-' || c == '_' || 
-		    c == '.' || c == '~')
-		{
-			encodedStr += c;
-		}
-		else if (c <= 0x20 || c >= 0x7F || ILLEGAL.find(c) != std::string::npos || reserved.find(c) != std::string::npos)
-		{
-			encodedStr += '%';
-			encodedStr += NumberFormatter::formatHex((unsigned) (unsigned char) c, 2);
-		}
-		else encodedStr += c;
-	}
+	URIView::encode(str, reserved, encodedStr);
 }
 
 	
 void URI::decode(const std::string& str, std::string& decodedStr, bool plusAsSpace)
 {
-	bool inQuery = false;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
+	// spaces may be encoded as plus signs in the query
+	std::string::size_type query = plusAsSpace ? str.find('?') : std::string::npos;
+	if (query == std::string::npos)
 	{
-		char c = *it++;
-		if (c == '?') inQuery = true;
-		// spaces may be encoded as plus signs in the query
-		if (inQuery && plusAsSpace && c == '+') c = ' ';
-		else if (c == '%')
-		{
-			if (it == end) throw URISyntaxException("URI encoding: no hex digit following percent sign", str);
-			char hi = *it++;
-			if (it == end) throw URISyntaxException("URI encoding: two hex digits must follow percent sign", str);
-			char lo = *it++;
-			if (hi >= '0' && hi <= '9')
-				c = hi - '0';
-			else if (hi >= 'A' && hi <= 'F')
-				c = hi - 'A' + 10;
-			else if (hi >= 'a' && hi <= 'f')
-				c = hi - 'a' + 10;
-			else throw URISyntaxException("URI encoding: not a hex digit");
-			c *= 16;
-			if (lo >= '0' && lo <= '9')
-				c += lo - '0';
-			else if (lo >= 'A' && lo <= 'F')
-				c += lo - 'A' + 10;
-			else if (lo >= 'a' && lo <= 'f')
-				c += lo - 'a' + 10;
-			else throw URISyntaxException("URI encoding: not a hex digit");
-		}
-		decodedStr += c;
+		URIView::decode(str, decodedStr);
+	}
+	else
+	{
+		URIView::decode(StringView(str.data(), query), decodedStr);
+		URIView::decode(StringView(str.data() + query, str.size() - query), decodedStr, true);
 	}
 }
 
@@ -693,30 +629,7 @@ bool URI::isWellKnownPort() const
 
 unsigned short URI::getWellKnownPort() const
 {
-	if (_scheme == "ftp")
-		return 21;
-	else if (_scheme == "ssh")
-		return 22;
-	else if (_scheme == "telnet")
-		return 23;
-	else if (_scheme == "http" || _scheme == "ws")
-		return 80;
-	else if (_scheme == "nntp")
-		return 119;
-	else if (_scheme == "ldap")
-		return 389;
-	else if (_scheme == "https" || _scheme == "wss")
-		return 443;
-	else if (_scheme == "rtsp")
-		return 554;
-	else if (_scheme == "sip")
-		return 5060;
-	else if (_scheme == "sips")
-		return 5061;
-	else if (_scheme == "xmpp")
-		return 5222;
-	else
-		return 0;
+	return URIView::getWellKnownPort(_scheme);
 }
 
 
@@ -0,0 +1,386 @@
+//
+// URIView.cpp
+//
+// $Id$
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIView
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/URIView.h"
+#include "Poco/Exception.h"
+#include "Poco/Ascii.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char ILLEGAL[] = "%<>{}|\\\"^`";
+	const char RESERVED_QUERY_PARAM[] = "?#/=&";
+	const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+	struct WellKnownPort
+	{
+		const char*    scheme;
+		unsigned short port;
+	};
+
+	const WellKnownPort WELL_KNOWN_PORTS[] =
+	{
+		{ "ftp",    21 },
+		{ "ssh",    22 },
+		{ "telnet", 23 },
+		{ "http",   80 },
+		{ "ws",     80 },
+		{ "nntp",   119 },
+		{ "ldap",   389 },
+		{ "https",  443 },
+		{ "wss",    443 },
+		{ "rtsp",   554 },
+		{ "sip",    5060 },
+		{ "sips",   5061 },
+		{ "xmpp",   5222 }
+	};
+
+	inline int hexValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		else if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		else if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		else
+			return -1;
+	}
+
+	inline bool mustEncode(char c, const StringView& reserved)
+	{
+		if (Ascii::isAlphaNumeric(c) || c == '-' || c == '_' || c == '.' || c == '~')
+			return false;
+		unsigned char uc = static_cast<unsigned char>(c);
+		return uc <= 0x20 || uc >= 0x7F || std::strchr(ILLEGAL, c) || reserved.find(c) != StringView::NPOS;
+	}
+}
+
+
+//
+// URIView::QueryParameterIterator
+//
+
+
+URIView::QueryParameterIterator::QueryParameterIterator(const StringView& query):
+	_it(query.begin()),
+	_end(query.end())
+{
+}
+
+
+bool URIView::QueryParameterIterator::next(StringView& name, StringView& value)
+{
+	if (_it == _end) return false;
+
+	const char* begin = _it;
+	while (_it != _end && *_it != '=' && *_it != '&') ++_it;
+	name = StringView(begin, _it - begin);
+	if (_it != _end && *_it == '=')
+	{
+		begin = ++_it;
+		while (_it != _end && *_it != '&') ++_it;
+		value = StringView(begin, _it - begin);
+	}
+	else value = StringView();
+	if (_it != _end) ++_it;
+	return true;
+}
+
+
+bool URIView::QueryParameterIterator::next(std::string& name, std::string& value)
+{
+	StringView rawName;
+	StringView rawValue;
+	if (!next(rawName, rawValue)) return false;
+
+	name.clear();
+	value.clear();
+	decode(rawName, name, true);
+	decode(rawValue, value, true);
+	return true;
+}
+
+
+//
+// URIView
+//
+
+
+URIView::URIView()
+{
+	clear();
+}
+
+
+URIView::URIView(const StringView& uri)
+{
+	parse(uri);
+}
+
+
+URIView::~URIView()
+{
+}
+
+
+void URIView::clear()
+{
+	_uri      = StringView();
+	_scheme   = StringView();
+	_userInfo = StringView();
+	_host     = StringView();
+	_path     = StringView();
+	_query    = StringView();
+	_fragment = StringView();
+	_authorityBegin = _uri.begin();
+	_authorityEnd   = _uri.begin();
+	_port     = 0;
+	_hasPort  = false;
+}
+
+
+void URIView::parse(const StringView& uri)
+{
+	clear();
+	_uri = uri;
+	const char* it  = uri.begin();
+	const char* end = uri.end();
+	_authorityBegin = it;
+	_authorityEnd   = it;
+	if (it != end && *it != '/' && *it != '.' && *it != '?' && *it != '#')
+	{
+		const char* p = it;
+		while (p != end && *p != ':' && *p != '?' && *p != '#' && *p != '/') ++p;
+		if (p != end && *p == ':')
+		{
+			if (p + 1 == end) throw URISyntaxException("URI scheme must be followed by authority or path", uri.toString());
+			_scheme = StringView(it, p - it);
+			it = p + 1;
+			if (end - it >= 2 && it[0] == '/' && it[1] == '/')
+			{
+				it += 2;
+				const char* authority = it;
+				while (it != end && *it != '/' && *it != '?' && *it != '#') ++it;
+				parseAuthority(authority, it);
+			}
+		}
+	}
+	parsePathEtc(it, end);
+}
+
+
+void URIView::parseAuthority(const char* it, const char* end)
+{
+	_authorityBegin = it;
+	_authorityEnd   = end;
+
+	// like URI, use the part between the last two '@' as user info
+	const char* hostBegin = it;
+	for (const char* p = it; p != end; ++p)
+	{
+		if (*p == '@')
+		{
+			_userInfo = StringView(hostBegin, p - hostBegin);
+			hostBegin = p + 1;
+		}
+	}
+
+	it = hostBegin;
+	if (it == end) return;
+	if (*it == '[')
+	{
+		// IPv6 address
+		const char* host = ++it;
+		while (it != end && *it != ']') ++it;
+		if (it == end) throw URISyntaxException("unterminated IPv6 address");
+		_host = StringView(host, it - host);
+		++it;
+	}
+	else
+	{
+		const char* host = it;
+		while (it != end && *it != ':') ++it;
+		_host = StringView(host, it - host);
+	}
+	if (it != end && *it == ':')
+	{
+		++it;
+		if (it != end)
+		{
+			unsigned port = 0;
+			const char* p = it;
+			while (p != end && Ascii::isDigit(*p) && port <= 65535)
+			{
+				port = port*10 + (*p++ - '0');
+			}
+			if (p != end || port == 0 || port > 65535)
+				throw URISyntaxException("bad or invalid port number", std::string(it, end));
+			_port = static_cast<unsigned short>(port);
+			_hasPort = true;
+		}
+	}
+}
+
+
+void URIView::parsePathEtc(const char* it, const char* end)
+{
+	const char* begin = it;
+	while (it != end && *it != '?' && *it != '#') ++it;
+	_path = StringView(begin, it - begin);
+	_query = StringView(it, 0);
+	if (it != end && *it == '?')
+	{
+		begin = ++it;
+		while (it != end && *it != '#') ++it;
+		_query = StringView(begin, it - begin);
+	}
+	_fragment = StringView(it, 0);
+	if (it != end && *it == '#')
+	{
+		++it;
+		_fragment = StringView(it, end - it);
+	}
+}
+
+
+StringView URIView::getPathEtc() const
+{
+	return StringView(_path.begin(), _uri.end() - _path.begin());
+}
+
+
+StringView URIView::getPathAndQuery() const
+{
+	const char* end = _query.empty() ? _path.end() : _query.end();
+	return StringView(_path.begin(), end - _path.begin());
+}
+
+
+std::string URIView::getPath() const
+{
+	std::string path;
+	decode(_path, path);
+	return path;
+}
+
+
+std::string URIView::getQuery() const
+{
+	std::string query;
+	decode(_query, query);
+	return query;
+}
+
+
+std::string URIView::getFragment() const
+{
+	std::string fragment;
+	decode(_fragment, fragment);
+	return fragment;
+}
+
+
+unsigned short URIView::getWellKnownPort(const StringView& scheme)
+{
+	for (std::size_t i = 0; i < sizeof(WELL_KNOWN_PORTS)/sizeof(WELL_KNOWN_PORTS[0]); ++i)
+	{
+		if (scheme.icompare(WELL_KNOWN_PORTS[i].scheme) == 0)
+			return WELL_KNOWN_PORTS[i].port;
+	}
+	return 0;
+}
+
+
+std::size_t URIView::decode(const StringView& str, char* buffer, bool plusAsSpace)
+{
+	const char* it  = str.begin();
+	const char* end = str.end();
+	char* out = buffer;
+	while (it != end)
+	{
+		char c = *it++;
+		if (c == '+' && plusAsSpace) c = ' ';
+		else if (c == '%')
+		{
+			if (it == end) throw URISyntaxException("URI encoding: no hex digit following percent sign", str.toString());
+			int hi = hexValue(*it++);
+			if (it == end) throw URISyntaxException("URI encoding: two hex digits must follow percent sign", str.toString());
+			int lo = hexValue(*it++);
+			if (hi < 0 || lo < 0) throw URISyntaxException("URI encoding: not a hex digit");
+			c = static_cast<char>(hi*16 + lo);
+		}
+		*out++ = c;
+	}
+	return out - buffer;
+}
+
+
+void URIView::decode(const StringView& str, std::string& decodedStr, bool plusAsSpace)
+{
+	if (str.find('%') == StringView::NPOS && (!plusAsSpace || str.find('+') == StringView::NPOS))
+	{
+		str.appendTo(decodedStr);
+		return;
+	}
+
+	std::string::size_type n = decodedStr.size();
+	decodedStr.resize(n + str.size());
+	try
+	{
+		decodedStr.resize(n + decode(str, &decodedStr[n], plusAsSpace));
+	}
+	catch (...)
+	{
+		decodedStr.resize(n);
+		throw;
+	}
+}
+
+
+void URIView::encode(const StringView& str, const StringView& reserved, std::string& encodedStr)
+{
+	const char* it  = str.begin();
+	const char* end = str.end();
+	while (it != end)
+	{
+		// append runs of characters that need no encoding at once
+		const char* run = it;
+		while (it != end && !mustEncode(*it, reserved)) ++it;
+		encodedStr.append(run, it - run);
+		if (it == end) break;
+
+		unsigned char c = static_cast<unsigned char>(*it++);
+		char escaped[3] = { '%', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F] };
+		encodedStr.append(escaped, 3);
+	}
+}
+
+
+void URIView::appendQueryParameter(std::string& query, const StringView& name, const StringView& value)
+{
+	if (!query.empty()) query += '&';
+	encode(name, RESERVED_QUERY_PARAM, query);
+	query += '=';
+	encode(value, RESERVED_QUERY_PARAM, query);
+}
+
+
+} // namespace Poco
@@ -21,7 +21,13 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Ascii.h"
+#include "Poco/String.h"
+#include "Poco/CPUFeatures.h"
 #include <algorithm>
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <emmintrin.h>
+#endif
 
 
 namespace Poco {
@@ -30,6 +36,145 @@ namespace Poco {
 namespace
 {
 	static UTF8Encoding utf8;
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+	POCO_TARGET_ISA("sse2")
+	std::size_t asciiBlocksSSE2(const unsigned char* bytes, std::size_t length)
+	{
+		std::size_t i = 0;
+		while (i + 16 <= length)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+			if (_mm_movemask_epi8(v) != 0) break;
+			i += 16;
+		}
+		return i;
+	}
+
+	POCO_TARGET_ISA("sse2")
+	std::size_t asciiToUTF16SSE2(const unsigned char* bytes, std::size_t length, UInt16* utf16)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		std::size_t i = 0;
+		while (i + 16 <= length)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+			if (_mm_movemask_epi8(v) != 0) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(utf16 + i), _mm_unpacklo_epi8(v, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(utf16 + i + 8), _mm_unpackhi_epi8(v, zero));
+			i += 16;
+		}
+		return i;
+	}
+
+	POCO_TARGET_ISA("sse2")
+	std::size_t asciiFromUTF16SSE2(const UInt16* utf16, std::size_t length, unsigned char* bytes)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+		std::size_t i = 0;
+		while (i + 16 <= length)
+		{
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16 + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16 + i + 8));
+			__m128i high = _mm_and_si128(_mm_or_si128(a, b), mask);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i), _mm_packus_epi16(a, b));
+			i += 16;
+		}
+		return i;
+	}
+
+#endif // POCO_HAVE_X86_INTRINSICS
+
+	std::size_t asciiLength(const unsigned char* bytes, std::size_t length)
+		/// Returns the number of ASCII characters at the beginning of bytes.
+	{
+		std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSSE2()) i = asciiBlocksSSE2(bytes, length);
+#endif
+		while (i + 8 <= length)
+		{
+			UInt64 word;
+			std::memcpy(&word, bytes + i, sizeof(word));
+			if (word & 0x8080808080808080ULL) break;
+			i += 8;
+		}
+		while (i < length && bytes[i] < 0x80) ++i;
+		return i;
+	}
+
+	std::size_t asciiToUTF16(const unsigned char* bytes, std::size_t length, UInt16* utf16)
+		/// Converts the ASCII characters at the beginning of bytes
+		/// and returns their number.
+	{
+		std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSSE2()) i = asciiToUTF16SSE2(bytes, length, utf16);
+#endif
+		while (i < length && bytes[i] < 0x80)
+		{
+			utf16[i] = bytes[i];
+			++i;
+		}
+		return i;
+	}
+
+	std::size_t asciiFromUTF16(const UInt16* utf16, std::size_t length, unsigned char* bytes)
+		/// Converts the ASCII characters at the beginning of utf16
+		/// and returns their number.
+	{
+		std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSSE2()) i = asciiFromUTF16SSE2(utf16, length, bytes);
+#endif
+		while (i < length && utf16[i] < 0x80)
+		{
+			bytes[i] = static_cast<unsigned char>(utf16[i]);
+			++i;
+		}
+		return i;
+	}
+
+	inline int decodeSequence(const unsigned char* bytes, const unsigned char* end, UInt32& ch)
+		/// Decodes the non-ASCII UTF-8 sequence at bytes and returns its
+		/// length, or 0 if the sequence is incomplete or not well-formed,
+		/// with the same rules as UTF8Encoding::isLegal().
+	{
+		unsigned c = bytes[0];
+		std::size_t avail = end - bytes;
+		if (c < 0xC2)
+		{
+			return 0;
+		}
+		else if (c < 0xE0)
+		{
+			if (avail < 2 || (bytes[1] & 0xC0) != 0x80) return 0;
+			ch = ((c & 0x1F) << 6) | (bytes[1] & 0x3F);
+			return 2;
+		}
+		else if (c < 0xF0)
+		{
+			if (avail < 3) return 0;
+			unsigned c1 = bytes[1];
+			if ((c1 & 0xC0) != 0x80 || (bytes[2] & 0xC0) != 0x80) return 0;
+			if ((c == 0xE0 && c1 < 0xA0) || (c == 0xED && c1 > 0x9F)) return 0;
+			ch = ((c & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (bytes[2] & 0x3F);
+			return 3;
+		}
+		else if (c < 0xF5)
+		{
+			if (avail < 4) return 0;
+			unsigned c1 = bytes[1];
+			if ((c1 & 0xC0) != 0x80 || (bytes[2] & 0xC0) != 0x80 || (bytes[3] & 0xC0) != 0x80) return 0;
+			if ((c == 0xF0 && c1 < 0x90) || (c == 0xF4 && c1 > 0x8F)) return 0;
+			ch = ((c & 0x07) << 18) | ((c1 & 0x3F) << 12) | ((bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+			return 4;
+		}
+		else return 0;
+	}
 }
 
 
@@ -126,6 +271,9 @@ int UTF8::icompare(const std::string& str, const std::string::value_type* ptr)
 
 std::string UTF8::toUpper(const std::string& str)
 {
+	if (asciiLength(reinterpret_cast<const unsigned char*>(str.data()), str.size()) == str.size())
+		return Poco::toUpper(str);
+
 	std::string result;
 	TextConverter converter(utf8, utf8);
 	converter.convert(str, result, Unicode::toUpper);
@@ -135,6 +283,9 @@ std::string UTF8::toUpper(const std::string& str)
 
 std::string& UTF8::toUpperInPlace(std::string& str)
 {
+	if (asciiLength(reinterpret_cast<const unsigned char*>(str.data()), str.size()) == str.size())
+		return Poco::toUpperInPlace(str);
+
 	std::string result;
 	TextConverter converter(utf8, utf8);
 	converter.convert(str, result, Unicode::toUpper);
@@ -145,6 +296,9 @@ std::string& UTF8::toUpperInPlace(std::string& str)
 
 std::string UTF8::toLower(const std::string& str)
 {
+	if (asciiLength(reinterpret_cast<const unsigned char*>(str.data()), str.size()) == str.size())
+		return Poco::toLower(str);
+
 	std::string result;
 	TextConverter converter(utf8, utf8);
 	converter.convert(str, result, Unicode::toLower);
@@ -154,6 +308,9 @@ std::string UTF8::toLower(const std::string& str)
 
 std::string& UTF8::toLowerInPlace(std::string& str)
 {
+	if (asciiLength(reinterpret_cast<const unsigned char*>(str.data()), str.size()) == str.size())
+		return Poco::toLowerInPlace(str);
+
 	std::string result;
 	TextConverter converter(utf8, utf8);
 	converter.convert(str, result, Unicode::toLower);
@@ -371,4 +528,163 @@ std::string UTF8::unescape(const std::string::const_iterator& begin, const std::
 	return result;
 }
 
+
+std::size_t UTF8::validate(const char* bytes, std::size_t length)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(bytes);
+	const unsigned char* end = it + length;
+	while (it != end)
+	{
+		if (*it < 0x80)
+		{
+			it += asciiLength(it, end - it);
+		}
+		else
+		{
+			UInt32 ch;
+			int n = decodeSequence(it, end, ch);
+			if (n == 0) break;
+			it += n;
+		}
+	}
+	return it - reinterpret_cast<const unsigned char*>(bytes);
+}
+
+
+bool UTF8::isValid(const std::string& str)
+{
+	return validate(str.data(), str.size()) == str.size();
+}
+
+
+std::size_t UTF8::toUTF16(const char* bytes, std::size_t length, UInt16* utf16, std::size_t& utf16Length)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(bytes);
+	const unsigned char* end = it + length;
+	UInt16* out = utf16;
+	while (it != end)
+	{
+		if (*it < 0x80)
+		{
+			std::size_t n = asciiToUTF16(it, end - it, out);
+			it  += n;
+			out += n;
+		}
+		else
+		{
+			UInt32 ch;
+			int n = decodeSequence(it, end, ch);
+			if (n == 0) break;
+			it += n;
+			if (ch < 0x10000)
+			{
+				*out++ = static_cast<UInt16>(ch);
+			}
+			else
+			{
+				ch -= 0x10000;
+				*out++ = static_cast<UInt16>(0xD800 | (ch >> 10));
+				*out++ = static_cast<UInt16>(0xDC00 | (ch & 0x3FF));
+			}
+		}
+	}
+	utf16Length = out - utf16;
+	return it - reinterpret_cast<const unsigned char*>(bytes);
+}
+
+
+std::size_t UTF8::fromUTF16(const UInt16* utf16, std::size_t length, char* bytes, std::size_t& bytesLength)
+{
+	const UInt16* it  = utf16;
+	const UInt16* end = utf16 + length;
+	unsigned char* out = reinterpret_cast<unsigned char*>(bytes);
+	while (it != end)
+	{
+		UInt32 ch = *it;
+		if (ch < 0x80)
+		{
+			std::size_t n = asciiFromUTF16(it, end - it, out);
+			it  += n;
+			out += n;
+		}
+		else if (ch < 0x800)
+		{
+			*out++ = static_cast<unsigned char>(0xC0 | (ch >> 6));
+			*out++ = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+			++it;
+		}
+		else if (ch < 0xD800 || ch > 0xDFFF)
+		{
+			*out++ = static_cast<unsigned char>(0xE0 | (ch >> 12));
+			*out++ = static_cast<unsigned char>(0x80 | ((ch >> 6) & 0x3F));
+			*out++ = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+			++it;
+		}
+		else
+		{
+			if (ch > 0xDBFF || end - it < 2 || it[1] < 0xDC00 || it[1] > 0xDFFF) break;
+			ch = 0x10000 + ((ch & 0x3FF) << 10) + (it[1] & 0x3FF);
+			*out++ = static_cast<unsigned char>(0xF0 | (ch >> 18));
+			*out++ = static_cast<unsigned char>(0x80 | ((ch >> 12) & 0x3F));
+			*out++ = static_cast<unsigned char>(0x80 | ((ch >> 6) & 0x3F));
+			*out++ = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+			it += 2;
+		}
+	}
+	bytesLength = out - reinterpret_cast<unsigned char*>(bytes);
+	return it - utf16;
+}
+
+
+std::size_t UTF8::toLatin1(const char* bytes, std::size_t length, char* latin1, std::size_t& latin1Length)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(bytes);
+	const unsigned char* end = it + length;
+	unsigned char* out = reinterpret_cast<unsigned char*>(latin1);
+	while (it != end)
+	{
+		if (*it < 0x80)
+		{
+			std::size_t n = asciiLength(it, end - it);
+			std::memcpy(out, it, n);
+			it  += n;
+			out += n;
+		}
+		else
+		{
+			if ((*it != 0xC2 && *it != 0xC3) || end - it < 2 || (it[1] & 0xC0) != 0x80) break;
+			*out++ = static_cast<unsigned char>(((it[0] & 0x03) << 6) | (it[1] & 0x3F));
+			it += 2;
+		}
+	}
+	latin1Length = out - reinterpret_cast<unsigned char*>(latin1);
+	return it - reinterpret_cast<const unsigned char*>(bytes);
+}
+
+
+std::size_t UTF8::fromLatin1(const char* latin1, std::size_t length, char* bytes)
+{
+	const unsigned char* it  = reinterpret_cast<const unsigned char*>(latin1);
+	const unsigned char* end = it + length;
+	unsigned char* out = reinterpret_cast<unsigned char*>(bytes);
+	while (it != end)
+	{
+		if (*it < 0x80)
+		{
+			std::size_t n = asciiLength(it, end - it);
+			std::memcpy(out, it, n);
+			it  += n;
+			out += n;
+		}
+		else
+		{
+			*out++ = static_cast<unsigned char>(0xC0 | (*it >> 6));
+			*out++ = static_cast<unsigned char>(0x80 | (*it & 0x3F));
+			++it;
+		}
+	}
+	return out - reinterpret_cast<unsigned char*>(bytes);
+}
+
+
 } // namespace Poco
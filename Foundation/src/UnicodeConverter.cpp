@@ -20,6 +20,7 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/UTF16Encoding.h"
 #include "Poco/UTF32Encoding.h"
+#include "Poco/UTF8String.h"
 #include <cstring>
 
 
@@ -68,8 +69,26 @@ void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
 void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
 {
 	utf16String.clear();
+	utf16String.reserve(utf8String.size());
+
+	// convert valid UTF-8 in blocks, and anything following
+	// the first invalid character one character at a time
+	UInt16 buffer[1024];
+	const char* begin = utf8String.data();
+	std::size_t size = utf8String.size();
+	std::size_t pos = 0;
+	while (pos < size)
+	{
+		std::size_t length = size - pos < 1024 ? size - pos : 1024;
+		std::size_t written = 0;
+		std::size_t read = UTF8::toUTF16(begin + pos, length, buffer, written);
+		utf16String.append(buffer, buffer + written);
+		pos += read;
+		if (read == 0 || (read < length && (length - read >= 4 || pos + length - read == size))) break;
+	}
+
 	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
+	TextIterator it(utf8String.begin() + pos, utf8String.end(), utf8Encoding);
 	TextIterator end(utf8String);
 	while (it != end) 
 	{
@@ -28,35 +28,31 @@ namespace Dynamic {
 
 
 Var::Var()
-#ifdef POCO_NO_SOO
-	: _pHolder(0)
-#endif
 {
 }
 
 
 Var::Var(const char* pVal)
-#ifdef POCO_NO_SOO 
-	: _pHolder(new VarHolderImpl<std::string>(pVal))
-{
-}
-#else
 {
 	construct(std::string(pVal));
 }
-#endif
 
 
 Var::Var(const Var& other)
-#ifdef POCO_NO_SOO
-	: _pHolder(other._pHolder ? other._pHolder->clone() : 0)
 {
+	construct(other);
 }
-#else
+
+
+#ifdef POCO_ENABLE_CPP11
+
+
+Var::Var(Var&& other)
 {
-	if ((this != &other) && !other.isEmpty())
-			construct(other);
+	moveFrom(other);
 }
+
+
 #endif
 
 
@@ -68,19 +64,29 @@ Var::~Var()
 
 Var& Var::operator = (const Var& rhs)
 {
-#ifdef POCO_NO_SOO
 	Var tmp(rhs);
 	swap(tmp);
-#else
-	if ((this != &rhs) && !rhs.isEmpty())
-		construct(rhs);
-	else if ((this != &rhs) && rhs.isEmpty())
-		_placeholder.erase();
-#endif
 	return *this;
 }
 
 
+#ifdef POCO_ENABLE_CPP11
+
+
+Var& Var::operator = (Var&& rhs)
+{
+	if (this != &rhs)
+	{
+		destruct();
+		moveFrom(rhs);
+	}
+	return *this;
+}
+
+
+#endif
+
+
 const Var Var::operator + (const Var& other) const
 {
 	if (isInteger())
@@ -328,14 +334,7 @@ bool Var::operator && (const Var& other) const
 
 void Var::empty()
 {
-#ifdef POCO_NO_SOO
-	delete _pHolder;
-	_pHolder = 0;
-#else
-	if (_placeholder.isLocal()) this->~Var();
-	else delete content();
-	_placeholder.erase();
-#endif
+	destruct();
 }
 
 
@@ -33,6 +33,12 @@ VarHolder::~VarHolder()
 }
 
 
+VarHolder* VarHolder::move(Placeholder<VarHolder>* pVarHolder)
+{
+	return clone(pVarHolder);
+}
+
+
 namespace Impl {
 
 
@@ -0,0 +1,663 @@
+//
+// d2s-tables.h
+//
+// $Id$
+//
+// Library: Foundation
+// Package: Core
+// Module:  NumericString
+//
+// Powers of five used by the shortest double to string conversion
+// in NumericString.cpp. The tables have been generated and contain:
+//
+//   POW5_INV_SPLIT[q] = floor(2^(bitlength(5^q) - 1 + 125) / 5^q) + 1
+//   POW5_SPLIT[i]     = 5^i, scaled to exactly 125 bits
+//
+// as 128-bit numbers, with the low 64 bits first.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_d2s_tables_INCLUDED
+#define Foundation_d2s_tables_INCLUDED
+
+
+const int POW5_INV_BITCOUNT = 125;
+const int POW5_BITCOUNT = 125;
+const int POW5_INV_TABLE_SIZE = 292;
+const int POW5_TABLE_SIZE = 326;
+
+
+const Poco::UInt64 POW5_INV_SPLIT[POW5_INV_TABLE_SIZE][2] =
+{
+	{ UINT64_2PART_C(0x00000000, 00000001), UINT64_2PART_C(0x20000000, 00000000) },
+	{ UINT64_2PART_C(0x99999999, 9999999a), UINT64_2PART_C(0x19999999, 99999999) },
+	{ UINT64_2PART_C(0x47ae147a, e147ae15), UINT64_2PART_C(0x147ae147, ae147ae1) },
+	{ UINT64_2PART_C(0x6c8b4395, 810624de), UINT64_2PART_C(0x10624dd2, f1a9fbe7) },
+	{ UINT64_2PART_C(0x7a786c22, 6809d496), UINT64_2PART_C(0x1a36e2eb, 1c432ca5) },
+	{ UINT64_2PART_C(0x61f9f01b, 866e43ab), UINT64_2PART_C(0x14f8b588, e368f084) },
+	{ UINT64_2PART_C(0xb4c7f349, 38583622), UINT64_2PART_C(0x10c6f7a0, b5ed8d36) },
+	{ UINT64_2PART_C(0x87a6520e, c08d236a), UINT64_2PART_C(0x1ad7f29a, bcaf4857) },
+	{ UINT64_2PART_C(0x9fb841a5, 66d74f88), UINT64_2PART_C(0x15798ee2, 308c39df) },
+	{ UINT64_2PART_C(0xe62d0151, 1f12a607), UINT64_2PART_C(0x112e0be8, 26d694b2) },
+	{ UINT64_2PART_C(0xd6ae6881, cb5109a4), UINT64_2PART_C(0x1b7cdfd9, d7bdbab7) },
+	{ UINT64_2PART_C(0xdef1ed34, a2a73aea), UINT64_2PART_C(0x15fd7fe1, 7964955f) },
+	{ UINT64_2PART_C(0x7f27f0f6, e885c8bb), UINT64_2PART_C(0x11979981, 2dea1119) },
+	{ UINT64_2PART_C(0x650cb4be, 40d60df8), UINT64_2PART_C(0x1c25c268, 497681c2) },
+	{ UINT64_2PART_C(0xea709098, 33de7193), UINT64_2PART_C(0x16849b86, a12b9b01) },
+	{ UINT64_2PART_C(0x21f3a6e0, 297ec143), UINT64_2PART_C(0x1203af9e, e756159b) },
+	{ UINT64_2PART_C(0x6985d7cd, 0f313537), UINT64_2PART_C(0x1cd2b297, d889bc2b) },
+	{ UINT64_2PART_C(0x2137dfd7, 3f5a90f9), UINT64_2PART_C(0x170ef546, 46d49689) },
+	{ UINT64_2PART_C(0xe75fe645, cc4873fa), UINT64_2PART_C(0x12725dd1, d243aba0) },
+	{ UINT64_2PART_C(0xa5663d3c, 7a0d865d), UINT64_2PART_C(0x1d83c94f, b6d2ac34) },
+	{ UINT64_2PART_C(0x511e9763, 94d79eb1), UINT64_2PART_C(0x179ca10c, 9242235d) },
+	{ UINT64_2PART_C(0xda7edf82, dd794bc1), UINT64_2PART_C(0x12e3b40a, 0e9b4f7d) },
+	{ UINT64_2PART_C(0x2a6498d1, 625bac68), UINT64_2PART_C(0x1e392010, 175ee596) },
+	{ UINT64_2PART_C(0xeeb6e0a7, 81e2f053), UINT64_2PART_C(0x182db340, 12b25144) },
+	{ UINT64_2PART_C(0x58924d52, ce4f26a9), UINT64_2PART_C(0x1357c299, a88ea76a) },
+	{ UINT64_2PART_C(0x27507bb7, b07ea441), UINT64_2PART_C(0x1ef2d0f5, da7dd8aa) },
+	{ UINT64_2PART_C(0x52a6c95f, c0655034), UINT64_2PART_C(0x18c240c4, aecb13bb) },
+	{ UINT64_2PART_C(0x0eebd44c, 99eaa690), UINT64_2PART_C(0x13ce9a36, f23c0fc9) },
+	{ UINT64_2PART_C(0xb17953ad, c3110a80), UINT64_2PART_C(0x1fb0f6be, 50601941) },
+	{ UINT64_2PART_C(0xc12ddc8b, 02740867), UINT64_2PART_C(0x195a5efe, a6b34767) },
+	{ UINT64_2PART_C(0x3424b06f, 3529a052), UINT64_2PART_C(0x14484bfe, ebc29f86) },
+	{ UINT64_2PART_C(0x901d59f2, 90ee19db), UINT64_2PART_C(0x1039d665, 89687f9e) },
+	{ UINT64_2PART_C(0x4cfbc31d, b4b0295f), UINT64_2PART_C(0x19f623d5, a8a73297) },
+	{ UINT64_2PART_C(0x3d9635b1, 5d59bab2), UINT64_2PART_C(0x14c4e977, ba1f5bac) },
+	{ UINT64_2PART_C(0x97ab5e27, 7de16228), UINT64_2PART_C(0x109d8792, fb4c4956) },
+	{ UINT64_2PART_C(0xf2abc9d8, c9689d0d), UINT64_2PART_C(0x1a95a5b7, f87a0ef0) },
+	{ UINT64_2PART_C(0x5bbca17a, 3aba173e), UINT64_2PART_C(0x15448493, 2d2e725a) },
+	{ UINT64_2PART_C(0xafca1ac8, 2efb45cb), UINT64_2PART_C(0x11039d42, 8a8b8eae) },
+	{ UINT64_2PART_C(0xb2dcf7a6, b1920945), UINT64_2PART_C(0x1b38fb9d, aa78e44a) },
+	{ UINT64_2PART_C(0xf57d92eb, c141a104), UINT64_2PART_C(0x15c72fb1, 552d836e) },
+	{ UINT64_2PART_C(0xc4647589, 6767b403), UINT64_2PART_C(0x116c2627, 77579c58) },
+	{ UINT64_2PART_C(0x6d6d88db, d8a5ecd2), UINT64_2PART_C(0x1be03d0b, f225c6f4) },
+	{ UINT64_2PART_C(0x8abe0716, 46eb23db), UINT64_2PART_C(0x164cfda3, 281e38c3) },
+	{ UINT64_2PART_C(0x6efe6c11, d255b649), UINT64_2PART_C(0x11d7314f, 534b609c) },
+	{ UINT64_2PART_C(0xb197134f, b6ef8a0e), UINT64_2PART_C(0x1c8b8218, 85456760) },
+	{ UINT64_2PART_C(0x27ac0f72, f8bfa1a5), UINT64_2PART_C(0x16d601ad, 376ab91a) },
+	{ UINT64_2PART_C(0xb95672c2, 60994e1e), UINT64_2PART_C(0x1244ce24, 2c5560e1) },
+	{ UINT64_2PART_C(0xf5571e03, cdc21695), UINT64_2PART_C(0x1d3ae36d, 13bbce35) },
+	{ UINT64_2PART_C(0x2aac1803, 0b01abab), UINT64_2PART_C(0x17624f8a, 762fd82b) },
+	{ UINT64_2PART_C(0xbbbce002, 6f348956), UINT64_2PART_C(0x12b50c6e, c4f31355) },
+	{ UINT64_2PART_C(0x92c7ccd0, b1eda889), UINT64_2PART_C(0x1dee7a4a, d4b81eef) },
+	{ UINT64_2PART_C(0xdbd30a40, 8e57ba07), UINT64_2PART_C(0x17f1fb6f, 10934bf2) },
+	{ UINT64_2PART_C(0x7ca8d500, 71dfc806), UINT64_2PART_C(0x1327fc58, da0f6ff5) },
+	{ UINT64_2PART_C(0xfaa7bb33, e9660cd6), UINT64_2PART_C(0x1ea6608e, 29b24cbb) },
+	{ UINT64_2PART_C(0x9552fc29, 8784d711), UINT64_2PART_C(0x18851a0b, 548ea3c9) },
+	{ UINT64_2PART_C(0xaaa8c9ba, d2d0ac0e), UINT64_2PART_C(0x139dae6f, 76d88307) },
+	{ UINT64_2PART_C(0xdddadc5e, 1e1aace3), UINT64_2PART_C(0x1f62b0b2, 57c0d1a5) },
+	{ UINT64_2PART_C(0x7e48b04b, 4b488a4f), UINT64_2PART_C(0x191bc08e, ac9a4151) },
+	{ UINT64_2PART_C(0xcb6d59d5, d5d3a1d9), UINT64_2PART_C(0x141633a5, 56e1cdda) },
+	{ UINT64_2PART_C(0x3c577b11, 77dc817b), UINT64_2PART_C(0x1011c2ea, abe7d7e2) },
+	{ UINT64_2PART_C(0xc6f25e82, 5960cf2a), UINT64_2PART_C(0x19b604aa, aca62636) },
+	{ UINT64_2PART_C(0x6bf51868, 4780a5bb), UINT64_2PART_C(0x14919d55, 56eb51c5) },
+	{ UINT64_2PART_C(0x232a79ed, 06008496), UINT64_2PART_C(0x10747ddd, df22a7d1) },
+	{ UINT64_2PART_C(0xd1dd8fe1, a3340756), UINT64_2PART_C(0x1a53fc96, 31d10c81) },
+	{ UINT64_2PART_C(0xa7e4731a, e8f66c45), UINT64_2PART_C(0x150ffd44, f4a73d34) },
+	{ UINT64_2PART_C(0x531d28e2, 53f8569e), UINT64_2PART_C(0x10d9976a, 5d52975d) },
+	{ UINT64_2PART_C(0xeb61db03, b98d5762), UINT64_2PART_C(0x1af5bf10, 9550f22e) },
+	{ UINT64_2PART_C(0xbc4e48cf, c7a445e8), UINT64_2PART_C(0x159165a6, ddda5b58) },
+	{ UINT64_2PART_C(0x6371d3d9, 6c836b20), UINT64_2PART_C(0x11411e1f, 17e1e2ad) },
+	{ UINT64_2PART_C(0x9f1c8628, ad9f11cd), UINT64_2PART_C(0x1b9b6364, f3030448) },
+	{ UINT64_2PART_C(0xe5b06b53, be18db0b), UINT64_2PART_C(0x1615e91d, 8f359d06) },
+	{ UINT64_2PART_C(0xeaf3890f, cb4715a2), UINT64_2PART_C(0x11ab20e4, 72914a6b) },
+	{ UINT64_2PART_C(0x44b8db4c, 7871bc37), UINT64_2PART_C(0x1c45016d, 841baa46) },
+	{ UINT64_2PART_C(0x03c715d6, c6c1635f), UINT64_2PART_C(0x169d9abe, 03495505) },
+	{ UINT64_2PART_C(0x3638de45, 6bcde919), UINT64_2PART_C(0x1217aefe, 69077737) },
+	{ UINT64_2PART_C(0x56c163a2, 461641c1), UINT64_2PART_C(0x1cf2b197, 0e725858) },
+	{ UINT64_2PART_C(0xdf011c81, d1ab67ce), UINT64_2PART_C(0x17288e12, 71f51379) },
+	{ UINT64_2PART_C(0x7f3416ce, 4155eca5), UINT64_2PART_C(0x1286d80e, c190dc61) },
+	{ UINT64_2PART_C(0x6520247d, 3556476e), UINT64_2PART_C(0x1da48ce4, 68e7c702) },
+	{ UINT64_2PART_C(0xea801d30, f7783925), UINT64_2PART_C(0x17b6d71d, 20b96c01) },
+	{ UINT64_2PART_C(0xbb99b0f3, f92cfa84), UINT64_2PART_C(0x12f8ac17, 4d612334) },
+	{ UINT64_2PART_C(0x5f5c4e53, 2847f739), UINT64_2PART_C(0x1e5aacf2, 15683854) },
+	{ UINT64_2PART_C(0x7f7d0b75, b9d32c2e), UINT64_2PART_C(0x18488a5b, 44536043) },
+	{ UINT64_2PART_C(0x9930d5f7, c7dc2358), UINT64_2PART_C(0x136d3b7c, 36a919cf) },
+	{ UINT64_2PART_C(0x8eb4898c, 72f9d226), UINT64_2PART_C(0x1f152bf9, f10e8fb2) },
+	{ UINT64_2PART_C(0x722a07a3, 8f2e41b8), UINT64_2PART_C(0x18ddbcc7, f40ba628) },
+	{ UINT64_2PART_C(0xc1bb394f, a5be9afa), UINT64_2PART_C(0x13e49706, 5cd61e86) },
+	{ UINT64_2PART_C(0x9c5ec219, 0930f7f6), UINT64_2PART_C(0x1fd424d6, faf030d7) },
+	{ UINT64_2PART_C(0x49e56814, 075a5ff8), UINT64_2PART_C(0x197683df, 2f268d79) },
+	{ UINT64_2PART_C(0x6e512010, 05e1e660), UINT64_2PART_C(0x145ecfe5, bf520ac7) },
+	{ UINT64_2PART_C(0xf1da800c, d181851a), UINT64_2PART_C(0x104bd984, 990e6f05) },
+	{ UINT64_2PART_C(0x4fc40014, 8268d4f5), UINT64_2PART_C(0x1a12f5a0, f4e3e4d6) },
+	{ UINT64_2PART_C(0xd96999aa, 01ed772b), UINT64_2PART_C(0x14dbf7b3, f71cb711) },
+	{ UINT64_2PART_C(0xadee1488, 018ac5bc), UINT64_2PART_C(0x10aff95c, c5b09274) },
+	{ UINT64_2PART_C(0x497ceda6, 68de092c), UINT64_2PART_C(0x1ab32894, 6f80ea54) },
+	{ UINT64_2PART_C(0x3aca57b8, 53e4d424), UINT64_2PART_C(0x155c2076, bf9a5510) },
+	{ UINT64_2PART_C(0x623b7960, 431d7683), UINT64_2PART_C(0x1116805e, ffaeaa73) },
+	{ UINT64_2PART_C(0x9d2bf566, d1c8bd9e), UINT64_2PART_C(0x1b5733cb, 32b110b8) },
+	{ UINT64_2PART_C(0x7dbcc452, 416d647f), UINT64_2PART_C(0x15df5ca2, 8ef40d60) },
+	{ UINT64_2PART_C(0xcafd69db, 678ab6cc), UINT64_2PART_C(0x117f7d4e, d8c33de6) },
+	{ UINT64_2PART_C(0xab2f0fc5, 72778adf), UINT64_2PART_C(0x1bff2ee4, 8e052fd7) },
+	{ UINT64_2PART_C(0x88f27304, 5b92d580), UINT64_2PART_C(0x1665bf1d, 3e6a8cac) },
+	{ UINT64_2PART_C(0xd3f528d0, 49424466), UINT64_2PART_C(0x11eaff4a, 98553d56) },
+	{ UINT64_2PART_C(0xb988414d, 4203a0a3), UINT64_2PART_C(0x1cab3210, f3bb9557) },
+	{ UINT64_2PART_C(0x6139cdd7, 6802e6e9), UINT64_2PART_C(0x16ef5b40, c2fc7779) },
+	{ UINT64_2PART_C(0xe7617179, 20025254), UINT64_2PART_C(0x125915cd, 68c9f92d) },
+	{ UINT64_2PART_C(0xa568b58e, 999d5086), UINT64_2PART_C(0x1d5b5615, 74765b7c) },
+	{ UINT64_2PART_C(0x5120913e, e14aa6d2), UINT64_2PART_C(0x177c44dd, f6c515fd) },
+	{ UINT64_2PART_C(0xa74d40ff, 1aa21f0e), UINT64_2PART_C(0x12c9d0b1, 923744ca) },
+	{ UINT64_2PART_C(0x0baece64, f769cb4a), UINT64_2PART_C(0x1e0fb44f, 50586e11) },
+	{ UINT64_2PART_C(0x3c8bd850, c5ee3c3b), UINT64_2PART_C(0x180c903f, 7379f1a7) },
+	{ UINT64_2PART_C(0xca0979da, 37f1c9c9), UINT64_2PART_C(0x133d4032, c2c7f485) },
+	{ UINT64_2PART_C(0xa9a8c2f6, bfe942db), UINT64_2PART_C(0x1ec866b7, 9e0cba6f) },
+	{ UINT64_2PART_C(0x2153cf2b, ccba9be3), UINT64_2PART_C(0x18a0522c, 7e709526) },
+	{ UINT64_2PART_C(0x1aa97289, 70954982), UINT64_2PART_C(0x13b374f0, 6526ddb8) },
+	{ UINT64_2PART_C(0xf775840f, 1a88759d), UINT64_2PART_C(0x1f8587e7, 083e2f8c) },
+	{ UINT64_2PART_C(0x5f913672, 7ba05e17), UINT64_2PART_C(0x19379fec, 0698260a) },
+	{ UINT64_2PART_C(0x1940f85b, 9619e4df), UINT64_2PART_C(0x142c7ff0, 054684d5) },
+	{ UINT64_2PART_C(0xe100c6af, ab47ea4c), UINT64_2PART_C(0x1023998c, d1053710) },
+	{ UINT64_2PART_C(0xce67a44c, 453fdd47), UINT64_2PART_C(0x19d28f47, b4d524e7) },
+	{ UINT64_2PART_C(0xd852e9d6, 9dccb106), UINT64_2PART_C(0x14a8729f, c3ddb71f) },
+	{ UINT64_2PART_C(0x79dbee45, 4b0a2738), UINT64_2PART_C(0x1086c219, 697e2c19) },
+	{ UINT64_2PART_C(0x295fe3a2, 11a9d859), UINT64_2PART_C(0x1a71368f, 0f30468f) },
+	{ UINT64_2PART_C(0xbab31c81, a7bb137a), UINT64_2PART_C(0x15275ed8, d8f36ba5) },
+	{ UINT64_2PART_C(0x6228e39a, ec95a92f), UINT64_2PART_C(0x10ec4be0, ad8f8951) },
+	{ UINT64_2PART_C(0x9d0e38f7, e0ef7517), UINT64_2PART_C(0x1b13ac9a, af4c0ee8) },
+	{ UINT64_2PART_C(0xb0d82d93, 1a592a79), UINT64_2PART_C(0x15a956e2, 25d67253) },
+	{ UINT64_2PART_C(0x8d79be0f, 4847552e), UINT64_2PART_C(0x11544581, b7dec1dc) },
+	{ UINT64_2PART_C(0x158f967e, da0bbb7c), UINT64_2PART_C(0x1bba08cf, 8c979c94) },
+	{ UINT64_2PART_C(0x77a611ff, 14d62f97), UINT64_2PART_C(0x162e6d72, d6dfb076) },
+	{ UINT64_2PART_C(0xf951a7ff, 43de8c79), UINT64_2PART_C(0x11bebdf5, 78b2f391) },
+	{ UINT64_2PART_C(0xc21c3ffe, d2fdad8e), UINT64_2PART_C(0x1c646322, 5ab7ec1c) },
+	{ UINT64_2PART_C(0x01b03332, 42648ad8), UINT64_2PART_C(0x16b6b5b5, 155ff017) },
+	{ UINT64_2PART_C(0x0159c28e, 9b83a246), UINT64_2PART_C(0x122bc490, dde659ac) },
+	{ UINT64_2PART_C(0xcef60417, 5f3903a3), UINT64_2PART_C(0x1d12d41a, fca3c2ac) },
+	{ UINT64_2PART_C(0x725e69ac, 4c2d9c83), UINT64_2PART_C(0x17424348, ca1c9bbd) },
+	{ UINT64_2PART_C(0xf5185489, d68ae39c), UINT64_2PART_C(0x129b6907, 0816e2fd) },
+	{ UINT64_2PART_C(0xee8d540f, bdab05c6), UINT64_2PART_C(0x1dc574d8, 0cf16b2f) },
+	{ UINT64_2PART_C(0xbed77672, fe226b05), UINT64_2PART_C(0x17d12a46, 70c1228c) },
+	{ UINT64_2PART_C(0xff12c528, cb4ebc04), UINT64_2PART_C(0x130dbb6b, 8d674ed6) },
+	{ UINT64_2PART_C(0xcb513b74, 787df9a0), UINT64_2PART_C(0x1e7c5f12, 7bd87e24) },
+	{ UINT64_2PART_C(0x090dc929, f9fe614d), UINT64_2PART_C(0x18637f41, fcad31b7) },
+	{ UINT64_2PART_C(0xa0d7d421, 94cb810a), UINT64_2PART_C(0x1382cc34, ca2427c5) },
+	{ UINT64_2PART_C(0x67bfb9cf, 5478ce77), UINT64_2PART_C(0x1f37ad21, 436d0c6f) },
+	{ UINT64_2PART_C(0x1fcc94a5, dd2d71f9), UINT64_2PART_C(0x18f9574d, cf8a7059) },
+	{ UINT64_2PART_C(0x7fd6dd51, 7dbdf4c7), UINT64_2PART_C(0x13faac3e, 3fa1f37a) },
+	{ UINT64_2PART_C(0xffbe2ee8, c92fee0b), UINT64_2PART_C(0x1ff779fd, 329cb8c3) },
+	{ UINT64_2PART_C(0x6631bf20, a0f324d6), UINT64_2PART_C(0x1992c7fd, c216fa36) },
+	{ UINT64_2PART_C(0xb827cc1a, 1a5c1d78), UINT64_2PART_C(0x14756ccb, 01abfb5e) },
+	{ UINT64_2PART_C(0x935309ae, 7b7ce460), UINT64_2PART_C(0x105df0a2, 67bcc918) },
+	{ UINT64_2PART_C(0x1eeb42b0, c594a099), UINT64_2PART_C(0x1a2fe76a, 3f9474f4) },
+	{ UINT64_2PART_C(0xe5890227, 0476e6e1), UINT64_2PART_C(0x14f31f88, 32dd2a5c) },
+	{ UINT64_2PART_C(0xb7a0ce85, 9d2bebe7), UINT64_2PART_C(0x10c27fa0, 28b0eeb0) },
+	{ UINT64_2PART_C(0x59014a6f, 61dfdfd8), UINT64_2PART_C(0x1ad0cc33, 744e4ab4) },
+	{ UINT64_2PART_C(0xe0cdd525, e7e64cad), UINT64_2PART_C(0x1573d68f, 903ea229) },
+	{ UINT64_2PART_C(0x4d717751, 8651d6f1), UINT64_2PART_C(0x11297872, d9cbb4ee) },
+	{ UINT64_2PART_C(0x7be8bee8, d6e957e8), UINT64_2PART_C(0x1b758d84, 8fac54b0) },
+	{ UINT64_2PART_C(0xfcba3253, df211320), UINT64_2PART_C(0x15f7a46a, 0c89dd59) },
+	{ UINT64_2PART_C(0x63c82843, 18e74280), UINT64_2PART_C(0x1192e9ee, 706e4aae) },
+	{ UINT64_2PART_C(0x060d0d38, 27d86a66), UINT64_2PART_C(0x1c1e4317, 1a4a1117) },
+	{ UINT64_2PART_C(0x6b3da42c, ecad21eb), UINT64_2PART_C(0x167e9c12, 7b6e7412) },
+	{ UINT64_2PART_C(0x88fe1cf0, bd574e56), UINT64_2PART_C(0x11fee341, fc585cdb) },
+	{ UINT64_2PART_C(0x419694b4, 62254a23), UINT64_2PART_C(0x1ccb0536, 608d615f) },
+	{ UINT64_2PART_C(0x67abaa29, e81dd4e9), UINT64_2PART_C(0x1708d0f8, 4d3de77f) },
+	{ UINT64_2PART_C(0xb95621bb, 2017dd87), UINT64_2PART_C(0x126d73f9, d764b932) },
+	{ UINT64_2PART_C(0xc223692b, 668c95a5), UINT64_2PART_C(0x1d7becc2, f23ac1ea) },
+	{ UINT64_2PART_C(0xce82ba89, 1ed6de1d), UINT64_2PART_C(0x17965702, 5b6234bb) },
+	{ UINT64_2PART_C(0xa5356207, 4bdf1818), UINT64_2PART_C(0x12deac01, e2b4f6fc) },
+	{ UINT64_2PART_C(0x3b889cd8, 7964f359), UINT64_2PART_C(0x1e311336, 3787f194) },
+	{ UINT64_2PART_C(0xfc6d4a46, c783f5e1), UINT64_2PART_C(0x18274291, c6065adc) },
+	{ UINT64_2PART_C(0x30576e9f, 06032b1a), UINT64_2PART_C(0x13529ba7, d19eaf17) },
+	{ UINT64_2PART_C(0x1a257dcb, 3cd1de90), UINT64_2PART_C(0x1eea92a6, 1c311825) },
+	{ UINT64_2PART_C(0x481dfe3c, 30a7e540), UINT64_2PART_C(0x18bba884, e35a79b7) },
+	{ UINT64_2PART_C(0xd34b31c9, c0865100), UINT64_2PART_C(0x13c9539d, 82aec7c5) },
+	{ UINT64_2PART_C(0x5211e942, cda3b4cd), UINT64_2PART_C(0x1fa885c8, d117a609) },
+	{ UINT64_2PART_C(0x74db2102, 3e1c90a4), UINT64_2PART_C(0x19539e3a, 40dfb807) },
+	{ UINT64_2PART_C(0xf715b401, cb4a0d50), UINT64_2PART_C(0x1442e4fb, 67196005) },
+	{ UINT64_2PART_C(0xf8de299b, 09080aa7), UINT64_2PART_C(0x103583fc, 527ab337) },
+	{ UINT64_2PART_C(0x8e304291, a80cddd7), UINT64_2PART_C(0x19ef3993, b72ab859) },
+	{ UINT64_2PART_C(0x3e8d020e, 200a4b13), UINT64_2PART_C(0x14bf6142, f8eef9e1) },
+	{ UINT64_2PART_C(0x653d9b3e, 80083c0f), UINT64_2PART_C(0x10991a9b, fa58c7e7) },
+	{ UINT64_2PART_C(0x6ec8f864, 000d2ce4), UINT64_2PART_C(0x1a8e90f9, 908e0ca5) },
+	{ UINT64_2PART_C(0x8bd3f9e9, 99a423ea), UINT64_2PART_C(0x153eda61, 4071a3b7) },
+	{ UINT64_2PART_C(0x3ca994ba, e1501cbb), UINT64_2PART_C(0x10ff151a, 99f482f9) },
+	{ UINT64_2PART_C(0xc775bac4, 9bb3612b), UINT64_2PART_C(0x1b31bb5d, c320d18e) },
+	{ UINT64_2PART_C(0xd2c4956a, 16291a89), UINT64_2PART_C(0x15c162b1, 68e70e0b) },
+	{ UINT64_2PART_C(0xdbd07788, 11ba7ba1), UINT64_2PART_C(0x11678227, 871f3e6f) },
+	{ UINT64_2PART_C(0x2c80bf40, 1c5d929b), UINT64_2PART_C(0x1bd8d03f, 3e9863e6) },
+	{ UINT64_2PART_C(0xbd33cc33, 49e47549), UINT64_2PART_C(0x16470cff, 6546b651) },
+	{ UINT64_2PART_C(0xca8fd68f, 6e505dd4), UINT64_2PART_C(0x11d270cc, 51055ea7) },
+	{ UINT64_2PART_C(0x4419574b, e3b3c953), UINT64_2PART_C(0x1c83e7ad, 4e6efdd9) },
+	{ UINT64_2PART_C(0x03477909, 82f63aa9), UINT64_2PART_C(0x16cfec8a, a52597e1) },
+	{ UINT64_2PART_C(0xcf6c60d4, 68c4fbba), UINT64_2PART_C(0x123ff06e, ea847980) },
+	{ UINT64_2PART_C(0xe57a3487, 0e07f92a), UINT64_2PART_C(0x1d331a4b, 10d3f59a) },
+	{ UINT64_2PART_C(0x512e906c, 0b399422), UINT64_2PART_C(0x175c1508, da432ae2) },
+	{ UINT64_2PART_C(0xda8ba6bc, d5c7a9b5), UINT64_2PART_C(0x12b010d3, e1cf5581) },
+	{ UINT64_2PART_C(0x90df712e, 22d90f87), UINT64_2PART_C(0x1de68153, 02e5559c) },
+	{ UINT64_2PART_C(0xda4c5a8b, 4f140c6c), UINT64_2PART_C(0x17eb9aa8, cf1dde16) },
+	{ UINT64_2PART_C(0xaea37ba2, a5a9a38a), UINT64_2PART_C(0x1322e220, a5b17e78) },
+	{ UINT64_2PART_C(0x7dd25f6a, a2a905a9), UINT64_2PART_C(0x1e9e369a, a2b59727) },
+	{ UINT64_2PART_C(0x97db7f88, 8220d154), UINT64_2PART_C(0x187e9215, 4ef7ac1f) },
+	{ UINT64_2PART_C(0x797c6606, ce80a777), UINT64_2PART_C(0x139874dd, d8c6234c) },
+	{ UINT64_2PART_C(0x8f2d700a, e4010bf1), UINT64_2PART_C(0x1f5a5496, 27a36bad) },
+	{ UINT64_2PART_C(0x0c2459a2, 5000d65a), UINT64_2PART_C(0x19151078, 1fb5efbe) },
+	{ UINT64_2PART_C(0x701d1481, d99a4515), UINT64_2PART_C(0x1410d9f9, b2f7f2fe) },
+	{ UINT64_2PART_C(0xc017439b, 147b6a77), UINT64_2PART_C(0x100d7b2e, 28c65bfe) },
+	{ UINT64_2PART_C(0xccf205c4, ed9243f2), UINT64_2PART_C(0x19af2b7d, 0e0a2cca) },
+	{ UINT64_2PART_C(0x0a5b37d0, be0e9cc2), UINT64_2PART_C(0x148c22ca, 71a1bd6f) },
+	{ UINT64_2PART_C(0x0848f973, cb3ee3ce), UINT64_2PART_C(0x10701bd5, 27b4978c) },
+	{ UINT64_2PART_C(0xda0e5bec, 78649fb0), UINT64_2PART_C(0x1a4cf955, 0c5425ac) },
+	{ UINT64_2PART_C(0x7b3eaff0, 60507fc0), UINT64_2PART_C(0x150a6110, d6a9b7bd) },
+	{ UINT64_2PART_C(0x95cbbff3, 80406633), UINT64_2PART_C(0x10d51a73, deee2c97) },
+	{ UINT64_2PART_C(0xefac6652, 66cd7052), UINT64_2PART_C(0x1aee90b9, 64b04758) },
+	{ UINT64_2PART_C(0x2623850e, b8a459db), UINT64_2PART_C(0x158ba6fa, b6f36c47) },
+	{ UINT64_2PART_C(0x1e82d0d8, 93b6ae49), UINT64_2PART_C(0x113c8595, 5f29236c) },
+	{ UINT64_2PART_C(0xfd9e1af4, 1f8ab075), UINT64_2PART_C(0x1b9408ee, fea838ac) },
+	{ UINT64_2PART_C(0x97b1af29, b2d559f7), UINT64_2PART_C(0x16100725, 988693bd) },
+	{ UINT64_2PART_C(0xac8e25ba, f5777b2c), UINT64_2PART_C(0x11a66c1e, 139edc97) },
+	{ UINT64_2PART_C(0x7a7d092b, 2258c513), UINT64_2PART_C(0x1c3d79c9, b8fe2dbf) },
+	{ UINT64_2PART_C(0x61fda0ef, 4ead6a76), UINT64_2PART_C(0x169794a1, 60cb57cc) },
+	{ UINT64_2PART_C(0xe7fe1a59, 0bbdeec5), UINT64_2PART_C(0x1212dd4d, e7091309) },
+	{ UINT64_2PART_C(0xa6635d5b, 45fcb13a), UINT64_2PART_C(0x1ceafbaf, d80e84dc) },
+	{ UINT64_2PART_C(0x851c4aaf, 6b308dc8), UINT64_2PART_C(0x172262f3, 133ed0b0) },
+	{ UINT64_2PART_C(0xd0e36ef2, bc26d7d4), UINT64_2PART_C(0x1281e8c2, 75cbda26) },
+	{ UINT64_2PART_C(0xb49f17ea, c6a48c86), UINT64_2PART_C(0x1d9ca79d, 894629d7) },
+	{ UINT64_2PART_C(0x2a18dfef, 0550706b), UINT64_2PART_C(0x17b08617, a104ee46) },
+	{ UINT64_2PART_C(0x54e0b325, 9dd9f389), UINT64_2PART_C(0x12f39e79, 4d9d8b6b) },
+	{ UINT64_2PART_C(0x87cdeb6f, 62f65274), UINT64_2PART_C(0x1e529728, 7c2f4578) },
+	{ UINT64_2PART_C(0xd30b22bf, 825ea85d), UINT64_2PART_C(0x18421286, c9bf6ac6) },
+	{ UINT64_2PART_C(0x0f3c1bcc, 684bb9e4), UINT64_2PART_C(0x13680ed2, 3aff889f) },
+	{ UINT64_2PART_C(0x18602c7a, 4079296d), UINT64_2PART_C(0x1f0ce483, 9198da98) },
+	{ UINT64_2PART_C(0x46b356c8, 33942124), UINT64_2PART_C(0x18d71d36, 0e13e213) },
+	{ UINT64_2PART_C(0x388f78a0, 29434db6), UINT64_2PART_C(0x13df4a91, a4dcb4dc) },
+	{ UINT64_2PART_C(0x5a7f2766, a86baf8a), UINT64_2PART_C(0x1fcbaa82, a1612160) },
+	{ UINT64_2PART_C(0x153285eb, b9efbfa2), UINT64_2PART_C(0x196fbb9b, b44db44d) },
+	{ UINT64_2PART_C(0xaa8ed189, 618c994e), UINT64_2PART_C(0x145962e2, f6a4903d) },
+	{ UINT64_2PART_C(0xeed8a7a1, 1ad6e10c), UINT64_2PART_C(0x1047824f, 2bb6d9ca) },
+	{ UINT64_2PART_C(0x7e27729b, 5e249b45), UINT64_2PART_C(0x1a0c03b1, df8af611) },
+	{ UINT64_2PART_C(0xfe85f549, 181d4904), UINT64_2PART_C(0x14d6695b, 193bf80d) },
+	{ UINT64_2PART_C(0xcb9e5dd4, 134aa0d0), UINT64_2PART_C(0x10ab877c, 142ff9a4) },
+	{ UINT64_2PART_C(0xdf63c953, 5211014d), UINT64_2PART_C(0x1aac0bf9, b9e65c3a) },
+	{ UINT64_2PART_C(0x191ca10f, 74da6771), UINT64_2PART_C(0x15566ffa, fb1eb02f) },
+	{ UINT64_2PART_C(0xadb080d9, 2a4852c1), UINT64_2PART_C(0x1111f32f, 2f4bc025) },
+	{ UINT64_2PART_C(0x15e7348e, aa0d5134), UINT64_2PART_C(0x1b4feb7e, b212cd09) },
+	{ UINT64_2PART_C(0xab1f5d3e, ee710dc4), UINT64_2PART_C(0x15d98932, 280f0a6d) },
+	{ UINT64_2PART_C(0xbc191765, 8b8da49d), UINT64_2PART_C(0x117ad428, 200c0857) },
+	{ UINT64_2PART_C(0x2cf4f23c, 127c3a94), UINT64_2PART_C(0x1bf7b9d9, cce00d59) },
+	{ UINT64_2PART_C(0xf0c3f4fc, db969543), UINT64_2PART_C(0x165fc7e1, 70b33de0) },
+	{ UINT64_2PART_C(0x5a365d97, 16121103), UINT64_2PART_C(0x11e63981, 26f5cb1a) },
+	{ UINT64_2PART_C(0x9056fc24, f01ce804), UINT64_2PART_C(0x1ca38f35, 0b22de90) },
+	{ UINT64_2PART_C(0xd9df301d, 8ce3ecd0), UINT64_2PART_C(0x16e93f5d, a2824ba6) },
+	{ UINT64_2PART_C(0xe17f59b1, 3d8323da), UINT64_2PART_C(0x125432b1, 4ecea2eb) },
+	{ UINT64_2PART_C(0x68cbc2b5, 2f38395c), UINT64_2PART_C(0x1d53844e, e47dd179) },
+	{ UINT64_2PART_C(0x53d6355d, bf602de3), UINT64_2PART_C(0x17760372, 5064a794) },
+	{ UINT64_2PART_C(0xa9782ab1, 65e68b1c), UINT64_2PART_C(0x12c4cf8e, a6b6ec76) },
+	{ UINT64_2PART_C(0x0f26aab5, 6fd744fa), UINT64_2PART_C(0x1e07b27d, d78b13f1) },
+	{ UINT64_2PART_C(0x3f52222a, bfdf6a62), UINT64_2PART_C(0x18062864, ac6f4327) },
+	{ UINT64_2PART_C(0x65db4e88, 997f884e), UINT64_2PART_C(0x13382050, 89f29c1f) },
+	{ UINT64_2PART_C(0x6fc54a74, 28cc0d4a), UINT64_2PART_C(0x1ec033b4, 0fea9365) },
+	{ UINT64_2PART_C(0x596aa1f6, 8709a43b), UINT64_2PART_C(0x1899c2f6, 73220f84) },
+	{ UINT64_2PART_C(0xadeee7f8, 6c07b696), UINT64_2PART_C(0x13ae3591, f5b4d936) },
+	{ UINT64_2PART_C(0x497e3ff3, e00c5756), UINT64_2PART_C(0x1f7d2283, 22baf524) },
+	{ UINT64_2PART_C(0xd464fff6, 4cd6ac45), UINT64_2PART_C(0x1930e868, e89590e9) },
+	{ UINT64_2PART_C(0x4383fff8, 3d7889d1), UINT64_2PART_C(0x14272053, ed4473ee) },
+	{ UINT64_2PART_C(0xcf9cccc6, 9793a174), UINT64_2PART_C(0x101f4d0f, f1038ff1) },
+	{ UINT64_2PART_C(0x7f6147a4, 25b90252), UINT64_2PART_C(0x19cbae7f, e805b31c) },
+	{ UINT64_2PART_C(0xcc4dd2e9, b7c7350f), UINT64_2PART_C(0x14a2f1ff, ecd15c16) },
+	{ UINT64_2PART_C(0x3d0b0f21, 5fd290d9), UINT64_2PART_C(0x10825b33, 23dab012) },
+	{ UINT64_2PART_C(0x61ab4b68, 9950e7c1), UINT64_2PART_C(0x1a6a2b85, 062ab350) },
+	{ UINT64_2PART_C(0x4e22a2ba, 1440b967), UINT64_2PART_C(0x1521bc6a, 6b555c40) },
+	{ UINT64_2PART_C(0x0b4ee894, dd009453), UINT64_2PART_C(0x10e7c9ee, bc4449cd) },
+	{ UINT64_2PART_C(0x1217da87, c800ed51), UINT64_2PART_C(0x1b0c764a, c6d3a948) },
+	{ UINT64_2PART_C(0xdb46486c, a000bdda), UINT64_2PART_C(0x15a391d5, 6bdc876c) },
+	{ UINT64_2PART_C(0x490506bd, 4ccd64af), UINT64_2PART_C(0x114fa7dd, efe39f8a) },
+	{ UINT64_2PART_C(0xa8080ac8, 7ae23ab1), UINT64_2PART_C(0x1bb2a62f, e638ff43) },
+	{ UINT64_2PART_C(0x5339a239, fbe82ef4), UINT64_2PART_C(0x162884f3, 1e93ff69) },
+	{ UINT64_2PART_C(0x75c7b4fb, 2fecf25d), UINT64_2PART_C(0x11ba03f5, b20fff87) },
+	{ UINT64_2PART_C(0x22d92191, e647ea2e), UINT64_2PART_C(0x1c5cd322, b67fff3f) },
+	{ UINT64_2PART_C(0xb57a8141, 850654f2), UINT64_2PART_C(0x16b0a8e8, 91ffff65) },
+	{ UINT64_2PART_C(0xc4620101, 373843f5), UINT64_2PART_C(0x1226ed86, db3332b7) },
+	{ UINT64_2PART_C(0x3a366801, f1f39fee), UINT64_2PART_C(0x1d0b15a4, 91eb8459) },
+	{ UINT64_2PART_C(0xfb5eb99b, 27f6198b), UINT64_2PART_C(0x173c1150, 74bc69e0) },
+	{ UINT64_2PART_C(0x2f7efae2, 865e7ad6), UINT64_2PART_C(0x12967440, 5d6387e7) },
+	{ UINT64_2PART_C(0xe597f7d0, d6fd9156), UINT64_2PART_C(0x1dbd86cd, 6238d971) },
+	{ UINT64_2PART_C(0x8479930d, 78cadaab), UINT64_2PART_C(0x17cad23d, e82d7ac1) },
+	{ UINT64_2PART_C(0xd0614271, 2d6f1556), UINT64_2PART_C(0x1308a831, 868ac89a) },
+	{ UINT64_2PART_C(0x4d686a4e, af182222), UINT64_2PART_C(0x1e74404f, 3daada91) },
+	{ UINT64_2PART_C(0xa453883e, f279b4e8), UINT64_2PART_C(0x185d003f, 6488aeda) },
+	{ UINT64_2PART_C(0xe9dc6cff, 28615d87), UINT64_2PART_C(0x137d99cc, 506d58ae) },
+	{ UINT64_2PART_C(0xa960ae65, 0d6895a4), UINT64_2PART_C(0x1f2f5c7a, 1a488de4) },
+	{ UINT64_2PART_C(0xbab3beb7, 3ded4483), UINT64_2PART_C(0x18f2b061, aea07183) },
+	{ UINT64_2PART_C(0x2ef6322c, 318a9d36), UINT64_2PART_C(0x13f559e7, bee6c136) }
+};
+
+
+const Poco::UInt64 POW5_SPLIT[POW5_TABLE_SIZE][2] =
+{
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x10000000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x14000000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x19000000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1f400000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x13880000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x186a0000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1e848000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1312d000, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x17d78400, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1dcd6500, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x12a05f20, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x174876e8, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1d1a94a2, 00000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x12309ce5, 40000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x16bcc41e, 90000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1c6bf526, 34000000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x11c37937, e0800000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x16345785, d8a00000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1bc16d67, 4ec80000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1158e460, 913d0000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x15af1d78, b58c4000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1b1ae4d6, e2ef5000) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x10f0cf06, 4dd59200) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x152d02c7, e14af680) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x1a784379, d99db420) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x108b2a2c, 28029094) },
+	{ UINT64_2PART_C(0x00000000, 00000000), UINT64_2PART_C(0x14adf4b7, 320334b9) },
+	{ UINT64_2PART_C(0x40000000, 00000000), UINT64_2PART_C(0x19d971e4, fe8401e7) },
+	{ UINT64_2PART_C(0x88000000, 00000000), UINT64_2PART_C(0x1027e72f, 1f128130) },
+	{ UINT64_2PART_C(0xaa000000, 00000000), UINT64_2PART_C(0x1431e0fa, e6d7217c) },
+	{ UINT64_2PART_C(0xd4800000, 00000000), UINT64_2PART_C(0x193e5939, a08ce9db) },
+	{ UINT64_2PART_C(0xc9a00000, 00000000), UINT64_2PART_C(0x1f8def88, 08b02452) },
+	{ UINT64_2PART_C(0xbe040000, 00000000), UINT64_2PART_C(0x13b8b5b5, 056e16b3) },
+	{ UINT64_2PART_C(0xad850000, 00000000), UINT64_2PART_C(0x18a6e322, 46c99c60) },
+	{ UINT64_2PART_C(0xd8e64000, 00000000), UINT64_2PART_C(0x1ed09bea, d87c0378) },
+	{ UINT64_2PART_C(0x878fe800, 00000000), UINT64_2PART_C(0x13426172, c74d822b) },
+	{ UINT64_2PART_C(0x6973e200, 00000000), UINT64_2PART_C(0x1812f9cf, 7920e2b6) },
+	{ UINT64_2PART_C(0x03d0da80, 00000000), UINT64_2PART_C(0x1e17b843, 57691b64) },
+	{ UINT64_2PART_C(0x82628890, 00000000), UINT64_2PART_C(0x12ced32a, 16a1b11e) },
+	{ UINT64_2PART_C(0x22fb2ab4, 00000000), UINT64_2PART_C(0x178287f4, 9c4a1d66) },
+	{ UINT64_2PART_C(0xabb9f561, 00000000), UINT64_2PART_C(0x1d6329f1, c35ca4bf) },
+	{ UINT64_2PART_C(0xcb54395c, a0000000), UINT64_2PART_C(0x125dfa37, 1a19e6f7) },
+	{ UINT64_2PART_C(0xbe2947b3, c8000000), UINT64_2PART_C(0x16f578c4, e0a060b5) },
+	{ UINT64_2PART_C(0x2db399a0, ba000000), UINT64_2PART_C(0x1cb2d6f6, 18c878e3) },
+	{ UINT64_2PART_C(0xfc904004, 74400000), UINT64_2PART_C(0x11efc659, cf7d4b8d) },
+	{ UINT64_2PART_C(0x7bb45005, 91500000), UINT64_2PART_C(0x166bb7f0, 435c9e71) },
+	{ UINT64_2PART_C(0xdaa16406, f5a40000), UINT64_2PART_C(0x1c06a5ec, 5433c60d) },
+	{ UINT64_2PART_C(0xa8a4de84, 59868000), UINT64_2PART_C(0x118427b3, b4a05bc8) },
+	{ UINT64_2PART_C(0xd2ce1625, 6fe82000), UINT64_2PART_C(0x15e531a0, a1c872ba) },
+	{ UINT64_2PART_C(0x87819bae, cbe22800), UINT64_2PART_C(0x1b5e7e08, ca3a8f69) },
+	{ UINT64_2PART_C(0xf4b1014d, 3f6d5900), UINT64_2PART_C(0x111b0ec5, 7e6499a1) },
+	{ UINT64_2PART_C(0x71dd41a0, 8f48af40), UINT64_2PART_C(0x1561d276, ddfdc00a) },
+	{ UINT64_2PART_C(0x0e549208, b31adb10), UINT64_2PART_C(0x1aba4714, 957d300d) },
+	{ UINT64_2PART_C(0x28f4db45, 6ff0c8ea), UINT64_2PART_C(0x10b46c6c, dd6e3e08) },
+	{ UINT64_2PART_C(0x33321216, cbecfb24), UINT64_2PART_C(0x14e18788, 14c9cd8a) },
+	{ UINT64_2PART_C(0xbffe969c, 7ee839ed), UINT64_2PART_C(0x1a19e96a, 19fc40ec) },
+	{ UINT64_2PART_C(0xf7ff1e21, cf512434), UINT64_2PART_C(0x105031e2, 503da893) },
+	{ UINT64_2PART_C(0xf5fee5aa, 43256d41), UINT64_2PART_C(0x14643e5a, e44d12b8) },
+	{ UINT64_2PART_C(0x337e9f14, d3eec892), UINT64_2PART_C(0x197d4df1, 9d605767) },
+	{ UINT64_2PART_C(0x005e46da, 08ea7ab6), UINT64_2PART_C(0x1fdca16e, 04b86d41) },
+	{ UINT64_2PART_C(0xa03aec48, 45928cb2), UINT64_2PART_C(0x13e9e4e4, c2f34448) },
+	{ UINT64_2PART_C(0xc849a75a, 56f72fde), UINT64_2PART_C(0x18e45e1d, f3b0155a) },
+	{ UINT64_2PART_C(0x7a5c1130, ecb4fbd6), UINT64_2PART_C(0x1f1d75a5, 709c1ab1) },
+	{ UINT64_2PART_C(0xec798abe, 93f11d65), UINT64_2PART_C(0x13726987, 666190ae) },
+	{ UINT64_2PART_C(0xa797ed6e, 38ed64bf), UINT64_2PART_C(0x184f03e9, 3ff9f4da) },
+	{ UINT64_2PART_C(0x517de8c9, c728bdef), UINT64_2PART_C(0x1e62c4e3, 8ff87211) },
+	{ UINT64_2PART_C(0xd2eeb17e, 1c7976b5), UINT64_2PART_C(0x12fdbb0e, 39fb474a) },
+	{ UINT64_2PART_C(0x87aa5ddd, a397d462), UINT64_2PART_C(0x17bd29d1, c87a191d) },
+	{ UINT64_2PART_C(0xe994f555, 0c7dc97b), UINT64_2PART_C(0x1dac7446, 3a989f64) },
+	{ UINT64_2PART_C(0x11fd1955, 27ce9ded), UINT64_2PART_C(0x128bc8ab, e49f639f) },
+	{ UINT64_2PART_C(0xd67c5faa, 71c24568), UINT64_2PART_C(0x172ebad6, ddc73c86) },
+	{ UINT64_2PART_C(0x8c1b7795, 0e32d6c2), UINT64_2PART_C(0x1cfa698c, 95390ba8) },
+	{ UINT64_2PART_C(0x57912abd, 28dfc639), UINT64_2PART_C(0x121c81f7, dd43a749) },
+	{ UINT64_2PART_C(0xad75756c, 7317b7c8), UINT64_2PART_C(0x16a3a275, d494911b) },
+	{ UINT64_2PART_C(0x98d2d2c7, 8fdda5ba), UINT64_2PART_C(0x1c4c8b13, 49b9b562) },
+	{ UINT64_2PART_C(0x9f83c3bc, b9ea8794), UINT64_2PART_C(0x11afd6ec, 0e14115d) },
+	{ UINT64_2PART_C(0x0764b4ab, e8652979), UINT64_2PART_C(0x161bcca7, 119915b5) },
+	{ UINT64_2PART_C(0x493de1d6, e27e73d7), UINT64_2PART_C(0x1ba2bfd0, d5ff5b22) },
+	{ UINT64_2PART_C(0x6dc6ad26, 4d8f0866), UINT64_2PART_C(0x1145b7e2, 85bf98f5) },
+	{ UINT64_2PART_C(0xc938586f, e0f2ca80), UINT64_2PART_C(0x159725db, 272f7f32) },
+	{ UINT64_2PART_C(0x7b866e8b, d92f7d20), UINT64_2PART_C(0x1afcef51, f0fb5eff) },
+	{ UINT64_2PART_C(0xad340517, 67bdae34), UINT64_2PART_C(0x10de1593, 369d1b5f) },
+	{ UINT64_2PART_C(0x9881065d, 41ad19c1), UINT64_2PART_C(0x15159af8, 04446237) },
+	{ UINT64_2PART_C(0x7ea147f4, 92186032), UINT64_2PART_C(0x1a5b01b6, 05557ac5) },
+	{ UINT64_2PART_C(0x6f24ccf8, db4f3c1f), UINT64_2PART_C(0x1078e111, c3556cbb) },
+	{ UINT64_2PART_C(0x4aee0037, 12230b27), UINT64_2PART_C(0x14971956, 342ac7ea) },
+	{ UINT64_2PART_C(0xdda98044, d6abcdf0), UINT64_2PART_C(0x19bcdfab, c13579e4) },
+	{ UINT64_2PART_C(0x0a89f02b, 062b60b6), UINT64_2PART_C(0x10160bcb, 58c16c2f) },
+	{ UINT64_2PART_C(0xcd2c6c35, c7b638e4), UINT64_2PART_C(0x141b8ebe, 2ef1c73a) },
+	{ UINT64_2PART_C(0x80778743, 39a3c71d), UINT64_2PART_C(0x1922726d, baae3909) },
+	{ UINT64_2PART_C(0xe0956914, 080cb8e4), UINT64_2PART_C(0x1f6b0f09, 2959c74b) },
+	{ UINT64_2PART_C(0x6c5d61ac, 8507f38e), UINT64_2PART_C(0x13a2e965, b9d81c8f) },
+	{ UINT64_2PART_C(0x4774ba17, a649f072), UINT64_2PART_C(0x188ba3bf, 284e23b3) },
+	{ UINT64_2PART_C(0x1951e89d, 8fdc6c8f), UINT64_2PART_C(0x1eae8cae, f261aca0) },
+	{ UINT64_2PART_C(0x0fd33162, 79e9c3d9), UINT64_2PART_C(0x132d17ed, 577d0be4) },
+	{ UINT64_2PART_C(0x13c7fdbb, 186434cf), UINT64_2PART_C(0x17f85de8, ad5c4edd) },
+	{ UINT64_2PART_C(0x58b9fd29, de7d4203), UINT64_2PART_C(0x1df67562, d8b36294) },
+	{ UINT64_2PART_C(0xb7743e3a, 2b0e4942), UINT64_2PART_C(0x12ba095d, c7701d9c) },
+	{ UINT64_2PART_C(0xe5514dc8, b5d1db92), UINT64_2PART_C(0x17688bb5, 394c2503) },
+	{ UINT64_2PART_C(0xdea5a13a, e3465277), UINT64_2PART_C(0x1d42aea2, 879f2e44) },
+	{ UINT64_2PART_C(0x0b2784c4, ce0bf38a), UINT64_2PART_C(0x1249ad25, 94c37ceb) },
+	{ UINT64_2PART_C(0xcdf165f6, 018ef06d), UINT64_2PART_C(0x16dc186e, f9f45c25) },
+	{ UINT64_2PART_C(0x416dbf73, 81f2ac88), UINT64_2PART_C(0x1c931e8a, b871732f) },
+	{ UINT64_2PART_C(0x88e497a8, 3137abd5), UINT64_2PART_C(0x11dbf316, b346e7fd) },
+	{ UINT64_2PART_C(0xeb1dbd92, 3d8596ca), UINT64_2PART_C(0x1652efdc, 6018a1fc) },
+	{ UINT64_2PART_C(0x25e52cf6, cce6fc7d), UINT64_2PART_C(0x1be7abd3, 781eca7c) },
+	{ UINT64_2PART_C(0x97af3c1a, 40105dce), UINT64_2PART_C(0x1170cb64, 2b133e8d) },
+	{ UINT64_2PART_C(0xfd9b0b20, d0147542), UINT64_2PART_C(0x15ccfe3d, 35d80e30) },
+	{ UINT64_2PART_C(0x3d01cde9, 04199292), UINT64_2PART_C(0x1b403dcc, 834e11bd) },
+	{ UINT64_2PART_C(0x462120b1, a28ffb9b), UINT64_2PART_C(0x1108269f, d210cb16) },
+	{ UINT64_2PART_C(0xd7a968de, 0b33fa82), UINT64_2PART_C(0x154a3047, c694fddb) },
+	{ UINT64_2PART_C(0xcd93c315, 8e00f923), UINT64_2PART_C(0x1a9cbc59, b83a3d52) },
+	{ UINT64_2PART_C(0xc07c59ed, 78c09bb6), UINT64_2PART_C(0x10a1f5b8, 13246653) },
+	{ UINT64_2PART_C(0xb09b7068, d6f0c2a3), UINT64_2PART_C(0x14ca7326, 17ed7fe8) },
+	{ UINT64_2PART_C(0xdcc24c83, 0cacf34c), UINT64_2PART_C(0x19fd0fef, 9de8dfe2) },
+	{ UINT64_2PART_C(0xc9f96fd1, e7ec180f), UINT64_2PART_C(0x103e29f5, c2b18bed) },
+	{ UINT64_2PART_C(0x3c77cbc6, 61e71e13), UINT64_2PART_C(0x144db473, 335deee9) },
+	{ UINT64_2PART_C(0x8b95beb7, fa60e598), UINT64_2PART_C(0x19612190, 00356aa3) },
+	{ UINT64_2PART_C(0x6e7b2e65, f8f91efe), UINT64_2PART_C(0x1fb969f4, 0042c54c) },
+	{ UINT64_2PART_C(0xc50cfcff, bb9bb35f), UINT64_2PART_C(0x13d3e238, 8029bb4f) },
+	{ UINT64_2PART_C(0xb6503c3f, aa82a037), UINT64_2PART_C(0x18c8dac6, a0342a23) },
+	{ UINT64_2PART_C(0xa3e44b4f, 95234844), UINT64_2PART_C(0x1efb1178, 484134ac) },
+	{ UINT64_2PART_C(0xe66eaf11, bd360d2b), UINT64_2PART_C(0x135ceaeb, 2d28c0eb) },
+	{ UINT64_2PART_C(0xe00a5ad6, 2c839075), UINT64_2PART_C(0x183425a5, f872f126) },
+	{ UINT64_2PART_C(0x980cf18b, b7a47493), UINT64_2PART_C(0x1e412f0f, 768fad70) },
+	{ UINT64_2PART_C(0x5f0816f7, 52c6c8dc), UINT64_2PART_C(0x12e8bd69, aa19cc66) },
+	{ UINT64_2PART_C(0xf6ca1cb5, 27787b13), UINT64_2PART_C(0x17a2ecc4, 14a03f7f) },
+	{ UINT64_2PART_C(0xf47ca3e2, 715699d7), UINT64_2PART_C(0x1d8ba7f5, 19c84f5f) },
+	{ UINT64_2PART_C(0xf8cde66d, 86d62026), UINT64_2PART_C(0x127748f9, 301d319b) },
+	{ UINT64_2PART_C(0xf7016008, e88ba830), UINT64_2PART_C(0x17151b37, 7c247e02) },
+	{ UINT64_2PART_C(0xb4c1b80b, 22ae923c), UINT64_2PART_C(0x1cda6205, 5b2d9d83) },
+	{ UINT64_2PART_C(0x50f91306, f5ad1b65), UINT64_2PART_C(0x12087d43, 58fc8272) },
+	{ UINT64_2PART_C(0xe53757c8, b318623f), UINT64_2PART_C(0x168a9c94, 2f3ba30e) },
+	{ UINT64_2PART_C(0x9e852dba, dfde7acf), UINT64_2PART_C(0x1c2d43b9, 3b0a8bd2) },
+	{ UINT64_2PART_C(0xa3133c94, cbeb0cc1), UINT64_2PART_C(0x119c4a53, c4e69763) },
+	{ UINT64_2PART_C(0x8bd80bb9, fee5cff1), UINT64_2PART_C(0x16035ce8, b6203d3c) },
+	{ UINT64_2PART_C(0xaece0ea8, 7e9f43ee), UINT64_2PART_C(0x1b843422, e3a84c8b) },
+	{ UINT64_2PART_C(0x4d40c929, 4f238a75), UINT64_2PART_C(0x1132a095, ce492fd7) },
+	{ UINT64_2PART_C(0x2090fb73, a2ec6d12), UINT64_2PART_C(0x157f48bb, 41db7bcd) },
+	{ UINT64_2PART_C(0x68b53a50, 8ba78856), UINT64_2PART_C(0x1adf1aea, 12525ac0) },
+	{ UINT64_2PART_C(0x41714472, 5748b536), UINT64_2PART_C(0x10cb70d2, 4b7378b8) },
+	{ UINT64_2PART_C(0x51cd958e, ed1ae283), UINT64_2PART_C(0x14fe4d06, de5056e6) },
+	{ UINT64_2PART_C(0xe640faf2, a8619b24), UINT64_2PART_C(0x1a3de048, 95e46c9f) },
+	{ UINT64_2PART_C(0xefe89cd7, a93d00f7), UINT64_2PART_C(0x1066ac2d, 5daec3e3) },
+	{ UINT64_2PART_C(0xebe2c40d, 938c4134), UINT64_2PART_C(0x14805738, b51a74dc) },
+	{ UINT64_2PART_C(0x26db7510, f86f5181), UINT64_2PART_C(0x19a06d06, e2611214) },
+	{ UINT64_2PART_C(0x9849292a, 9b4592f1), UINT64_2PART_C(0x10044424, 4d7cab4c) },
+	{ UINT64_2PART_C(0xbe5b7375, 4216f7ad), UINT64_2PART_C(0x1405552d, 60dbd61f) },
+	{ UINT64_2PART_C(0xadf25052, 929cb598), UINT64_2PART_C(0x1906aa78, b912cba7) },
+	{ UINT64_2PART_C(0x996ee467, 3743e2ff), UINT64_2PART_C(0x1f485516, e7577e91) },
+	{ UINT64_2PART_C(0xffe54ec0, 828a6ddf), UINT64_2PART_C(0x138d352e, 5096af1a) },
+	{ UINT64_2PART_C(0xbfdea270, a32d0957), UINT64_2PART_C(0x18708279, e4bc5ae1) },
+	{ UINT64_2PART_C(0x2fd64b0c, cbf84bad), UINT64_2PART_C(0x1e8ca318, 5deb719a) },
+	{ UINT64_2PART_C(0x5de5eee7, ff7b2f4c), UINT64_2PART_C(0x1317e5ef, 3ab32700) },
+	{ UINT64_2PART_C(0x755f6aa1, ff59fb1f), UINT64_2PART_C(0x17dddf6b, 095ff0c0) },
+	{ UINT64_2PART_C(0x92b7454a, 7f3079e7), UINT64_2PART_C(0x1dd55745, cbb7ecf0) },
+	{ UINT64_2PART_C(0x5bb28b4e, 8f7e4c30), UINT64_2PART_C(0x12a5568b, 9f52f416) },
+	{ UINT64_2PART_C(0xf29f2e22, 335ddf3c), UINT64_2PART_C(0x174eac2e, 8727b11b) },
+	{ UINT64_2PART_C(0xef46f9aa, c035570b), UINT64_2PART_C(0x1d22573a, 28f19d62) },
+	{ UINT64_2PART_C(0xd58c5c0a, b8215667), UINT64_2PART_C(0x12357684, 5997025d) },
+	{ UINT64_2PART_C(0x4aef730d, 6629ac01), UINT64_2PART_C(0x16c2d425, 6ffcc2f5) },
+	{ UINT64_2PART_C(0x9dab4fd0, bfb41701), UINT64_2PART_C(0x1c73892e, cbfbf3b2) },
+	{ UINT64_2PART_C(0xa28b11e2, 77d08e60), UINT64_2PART_C(0x11c835bd, 3f7d784f) },
+	{ UINT64_2PART_C(0x8b2dd65b, 15c4b1f9), UINT64_2PART_C(0x163a432c, 8f5cd663) },
+	{ UINT64_2PART_C(0x6df94bf1, db35de77), UINT64_2PART_C(0x1bc8d3f7, b3340bfc) },
+	{ UINT64_2PART_C(0xc4bbcf77, 2901ab0a), UINT64_2PART_C(0x115d847a, d000877d) },
+	{ UINT64_2PART_C(0x35eac354, f34215cd), UINT64_2PART_C(0x15b4e599, 8400a95d) },
+	{ UINT64_2PART_C(0x8365742a, 30129b40), UINT64_2PART_C(0x1b221eff, e500d3b4) },
+	{ UINT64_2PART_C(0xd21f689a, 5e0ba108), UINT64_2PART_C(0x10f5535f, ef208450) },
+	{ UINT64_2PART_C(0x06a742c0, f58e894a), UINT64_2PART_C(0x1532a837, eae8a565) },
+	{ UINT64_2PART_C(0x48511371, 32f22b9d), UINT64_2PART_C(0x1a7f5245, e5a2cebe) },
+	{ UINT64_2PART_C(0xed32ac26, bfd75b42), UINT64_2PART_C(0x108f936b, af85c136) },
+	{ UINT64_2PART_C(0xa87f5730, 6fcd3212), UINT64_2PART_C(0x14b37846, 9b673184) },
+	{ UINT64_2PART_C(0xd29f2cfc, 8bc07e97), UINT64_2PART_C(0x19e05658, 4240fde5) },
+	{ UINT64_2PART_C(0xa3a37c1d, d7584f1e), UINT64_2PART_C(0x102c35f7, 29689eaf) },
+	{ UINT64_2PART_C(0x8c8c5b25, 4d2e62e6), UINT64_2PART_C(0x14374374, f3c2c65b) },
+	{ UINT64_2PART_C(0x6faf71ee, a079fb9f), UINT64_2PART_C(0x19451452, 30b377f2) },
+	{ UINT64_2PART_C(0x0b9b4e6a, 48987a87), UINT64_2PART_C(0x1f965966, bce055ef) },
+	{ UINT64_2PART_C(0x67411102, 6d5f4c94), UINT64_2PART_C(0x13bdf7e0, 360c35b5) },
+	{ UINT64_2PART_C(0xc1115543, 08b71fba), UINT64_2PART_C(0x18ad75d8, 438f4322) },
+	{ UINT64_2PART_C(0x7155aa93, cae4e7a8), UINT64_2PART_C(0x1ed8d34e, 547313eb) },
+	{ UINT64_2PART_C(0x26d58a9c, 5ecf10c9), UINT64_2PART_C(0x13478410, f4c7ec73) },
+	{ UINT64_2PART_C(0xf08aed43, 7682d4fb), UINT64_2PART_C(0x18196515, 31f9e78f) },
+	{ UINT64_2PART_C(0xecada894, 54238a3a), UINT64_2PART_C(0x1e1fbe5a, 7e786173) },
+	{ UINT64_2PART_C(0x73ec895c, b4963664), UINT64_2PART_C(0x12d3d6f8, 8f0b3ce8) },
+	{ UINT64_2PART_C(0x90e7abb3, e1bbc3fd), UINT64_2PART_C(0x1788ccb6, b2ce0c22) },
+	{ UINT64_2PART_C(0x352196a0, da2ab4fd), UINT64_2PART_C(0x1d6affe4, 5f818f2b) },
+	{ UINT64_2PART_C(0x0134fe24, 885ab11e), UINT64_2PART_C(0x1262dfee, bbb0f97b) },
+	{ UINT64_2PART_C(0xc1823dad, aa715d65), UINT64_2PART_C(0x16fb97ea, 6a9d37d9) },
+	{ UINT64_2PART_C(0x31e2cd19, 150db4bf), UINT64_2PART_C(0x1cba7de5, 054485d0) },
+	{ UINT64_2PART_C(0x1f2dc02f, ad2890f7), UINT64_2PART_C(0x11f48eaf, 234ad3a2) },
+	{ UINT64_2PART_C(0xa6f9303b, 9872b535), UINT64_2PART_C(0x1671b25a, ec1d888a) },
+	{ UINT64_2PART_C(0x50b77c4a, 7e8f6282), UINT64_2PART_C(0x1c0e1ef1, a724eaad) },
+	{ UINT64_2PART_C(0x5272adae, 8f199d91), UINT64_2PART_C(0x1188d357, 087712ac) },
+	{ UINT64_2PART_C(0x670f591a, 32e004f6), UINT64_2PART_C(0x15eb082c, ca94d757) },
+	{ UINT64_2PART_C(0x40d32f60, bf980633), UINT64_2PART_C(0x1b65ca37, fd3a0d2d) },
+	{ UINT64_2PART_C(0x4883fd9c, 77bf03e0), UINT64_2PART_C(0x111f9e62, fe44483c) },
+	{ UINT64_2PART_C(0x5aa4fd03, 95aec4d8), UINT64_2PART_C(0x156785fb, bdd55a4b) },
+	{ UINT64_2PART_C(0x314e3c44, 7b1a760e), UINT64_2PART_C(0x1ac1677a, ad4ab0de) },
+	{ UINT64_2PART_C(0xded0e5aa, ccf089c9), UINT64_2PART_C(0x10b8e0ac, ac4eae8a) },
+	{ UINT64_2PART_C(0x96851f15, 802cac3b), UINT64_2PART_C(0x14e718d7, d7625a2d) },
+	{ UINT64_2PART_C(0xfc2666da, e037d74a), UINT64_2PART_C(0x1a20df0d, cd3af0b8) },
+	{ UINT64_2PART_C(0x9d980048, cc22e68e), UINT64_2PART_C(0x10548b68, a044d673) },
+	{ UINT64_2PART_C(0x84fe005a, ff2ba032), UINT64_2PART_C(0x1469ae42, c8560c10) },
+	{ UINT64_2PART_C(0xa63d8071, bef6883e), UINT64_2PART_C(0x198419d3, 7a6b8f14) },
+	{ UINT64_2PART_C(0xcfcce08e, 2eb42a4e), UINT64_2PART_C(0x1fe52048, 590672d9) },
+	{ UINT64_2PART_C(0x21e00c58, dd309a70), UINT64_2PART_C(0x13ef342d, 37a407c8) },
+	{ UINT64_2PART_C(0x2a580f6f, 147cc10d), UINT64_2PART_C(0x18eb0138, 858d09ba) },
+	{ UINT64_2PART_C(0xb4ee134a, d99bf150), UINT64_2PART_C(0x1f25c186, a6f04c28) },
+	{ UINT64_2PART_C(0x7114cc0e, c80176d2), UINT64_2PART_C(0x137798f4, 28562f99) },
+	{ UINT64_2PART_C(0xcd59ff12, 7a01d486), UINT64_2PART_C(0x18557f31, 326bbb7f) },
+	{ UINT64_2PART_C(0xc0b07ed7, 188249a8), UINT64_2PART_C(0x1e6adefd, 7f06aa5f) },
+	{ UINT64_2PART_C(0xd86e4f46, 6f516e09), UINT64_2PART_C(0x1302cb5e, 6f642a7b) },
+	{ UINT64_2PART_C(0xce89e318, 0b25c98b), UINT64_2PART_C(0x17c37e36, 0b3d351a) },
+	{ UINT64_2PART_C(0x822c5bde, 0def3bee), UINT64_2PART_C(0x1db45dc3, 8e0c8261) },
+	{ UINT64_2PART_C(0xf15bb96a, c8b58575), UINT64_2PART_C(0x1290ba9a, 38c7d17c) },
+	{ UINT64_2PART_C(0x2db2a7c5, 7ae2e6d2), UINT64_2PART_C(0x1734e940, c6f9c5dc) },
+	{ UINT64_2PART_C(0x391f51b6, d99ba086), UINT64_2PART_C(0x1d022390, f8b83753) },
+	{ UINT64_2PART_C(0x03b39312, 48014454), UINT64_2PART_C(0x1221563a, 9b732294) },
+	{ UINT64_2PART_C(0x04a077d6, da019569), UINT64_2PART_C(0x16a9abc9, 424feb39) },
+	{ UINT64_2PART_C(0x45c895cc, 9081fac3), UINT64_2PART_C(0x1c5416bb, 92e3e607) },
+	{ UINT64_2PART_C(0x8b9d5d9f, da513cba), UINT64_2PART_C(0x11b48e35, 3bce6fc4) },
+	{ UINT64_2PART_C(0xae84b507, d0e58be8), UINT64_2PART_C(0x1621b1c2, 8ac20bb5) },
+	{ UINT64_2PART_C(0x1a25e249, c51eeee3), UINT64_2PART_C(0x1baa1e33, 2d728ea3) },
+	{ UINT64_2PART_C(0xf057ad6e, 1b33554d), UINT64_2PART_C(0x114a52df, fc679925) },
+	{ UINT64_2PART_C(0x6c6d98c9, a2002aa1), UINT64_2PART_C(0x159ce797, fb817f6f) },
+	{ UINT64_2PART_C(0x4788fefc, 0a803549), UINT64_2PART_C(0x1b04217d, fa61df4b) },
+	{ UINT64_2PART_C(0x0cb59f5d, 8690214e), UINT64_2PART_C(0x10e294ee, bc7d2b8f) },
+	{ UINT64_2PART_C(0xcfe30734, e83429a1), UINT64_2PART_C(0x151b3a2a, 6b9c7672) },
+	{ UINT64_2PART_C(0x83dbc902, 2241340a), UINT64_2PART_C(0x1a6208b5, 0683940f) },
+	{ UINT64_2PART_C(0xb2695da1, 5568c086), UINT64_2PART_C(0x107d4571, 24123c89) },
+	{ UINT64_2PART_C(0x1f03b509, aac2f0a7), UINT64_2PART_C(0x149c96cd, 6d16cbac) },
+	{ UINT64_2PART_C(0x26c4a24c, 1573acd1), UINT64_2PART_C(0x19c3bc80, c85c7e97) },
+	{ UINT64_2PART_C(0x783ae56f, 8d684c03), UINT64_2PART_C(0x101a55d0, 7d39cf1e) },
+	{ UINT64_2PART_C(0x16499ecb, 70c25f03), UINT64_2PART_C(0x1420eb44, 9c8842e6) },
+	{ UINT64_2PART_C(0x9bdc067e, 4cf2f6c4), UINT64_2PART_C(0x19292615, c3aa539f) },
+	{ UINT64_2PART_C(0x82d3081d, e02fb476), UINT64_2PART_C(0x1f736f9b, 3494e887) },
+	{ UINT64_2PART_C(0xb1c3e512, ac1dd0c9), UINT64_2PART_C(0x13a825c1, 00dd1154) },
+	{ UINT64_2PART_C(0xde34de57, 572544fc), UINT64_2PART_C(0x18922f31, 411455a9) },
+	{ UINT64_2PART_C(0x55c215ed, 2cee963b), UINT64_2PART_C(0x1eb6bafd, 91596b14) },
+	{ UINT64_2PART_C(0xb5994db4, 3c151de5), UINT64_2PART_C(0x133234de, 7ad7e2ec) },
+	{ UINT64_2PART_C(0xe2ffa121, 4b1a655e), UINT64_2PART_C(0x17fec216, 198ddba7) },
+	{ UINT64_2PART_C(0xdbbf8969, 9de0feb6), UINT64_2PART_C(0x1dfe729b, 9ff15291) },
+	{ UINT64_2PART_C(0x2957b5e2, 02ac9f31), UINT64_2PART_C(0x12bf07a1, 43f6d39b) },
+	{ UINT64_2PART_C(0xf3ada35a, 8357c6fe), UINT64_2PART_C(0x176ec989, 94f48881) },
+	{ UINT64_2PART_C(0x70990c31, 242db8bd), UINT64_2PART_C(0x1d4a7beb, fa31aaa2) },
+	{ UINT64_2PART_C(0x865fa79e, b69c9376), UINT64_2PART_C(0x124e8d73, 7c5f0aa5) },
+	{ UINT64_2PART_C(0xe7f79186, 6443b854), UINT64_2PART_C(0x16e230d0, 5b76cd4e) },
+	{ UINT64_2PART_C(0xa1f575e7, fd54a669), UINT64_2PART_C(0x1c9abd04, 725480a2) },
+	{ UINT64_2PART_C(0xa53969b0, fe54e801), UINT64_2PART_C(0x11e0b622, c774d065) },
+	{ UINT64_2PART_C(0x0e87c41d, 3dea2202), UINT64_2PART_C(0x1658e3ab, 7952047f) },
+	{ UINT64_2PART_C(0xd229b524, 8d64aa82), UINT64_2PART_C(0x1bef1c96, 57a6859e) },
+	{ UINT64_2PART_C(0x435a1136, d85eea91), UINT64_2PART_C(0x117571dd, f6c81383) },
+	{ UINT64_2PART_C(0x14309584, 8e76a536), UINT64_2PART_C(0x15d2ce55, 747a1864) },
+	{ UINT64_2PART_C(0x193cbae5, b2144e83), UINT64_2PART_C(0x1b4781ea, d1989e7d) },
+	{ UINT64_2PART_C(0x2fc5f4cf, 8f4cb112), UINT64_2PART_C(0x110cb132, c2ff630e) },
+	{ UINT64_2PART_C(0xbbb77203, 731fdd56), UINT64_2PART_C(0x154fdd7f, 73bf3bd1) },
+	{ UINT64_2PART_C(0x2aa54e84, 4fe7d4ac), UINT64_2PART_C(0x1aa3d4df, 50af0ac6) },
+	{ UINT64_2PART_C(0xdaa75112, b1f0e4eb), UINT64_2PART_C(0x10a6650b, 926d66bb) },
+	{ UINT64_2PART_C(0xd1512557, 5e6d1e26), UINT64_2PART_C(0x14cffe4e, 7708c06a) },
+	{ UINT64_2PART_C(0x85a56ead, 360865b0), UINT64_2PART_C(0x1a03fde2, 14caf085) },
+	{ UINT64_2PART_C(0x7387652c, 41c53f8e), UINT64_2PART_C(0x10427ead, 4cfed653) },
+	{ UINT64_2PART_C(0x50693e77, 52368f71), UINT64_2PART_C(0x14531e58, a03e8be8) },
+	{ UINT64_2PART_C(0x64838e15, 26c4334e), UINT64_2PART_C(0x1967e5ee, c84e2ee2) },
+	{ UINT64_2PART_C(0xfda4719a, 70754022), UINT64_2PART_C(0x1fc1df6a, 7a61ba9a) },
+	{ UINT64_2PART_C(0xde86c700, 86494815), UINT64_2PART_C(0x13d92ba2, 8c7d14a0) },
+	{ UINT64_2PART_C(0x162878c0, a7db9a1a), UINT64_2PART_C(0x18cf768b, 2f9c59c9) },
+	{ UINT64_2PART_C(0x5bb296f0, d1d280a1), UINT64_2PART_C(0x1f03542d, fb83703b) },
+	{ UINT64_2PART_C(0x194f9e56, 83239064), UINT64_2PART_C(0x1362149c, bd322625) },
+	{ UINT64_2PART_C(0x5fa385ec, 23ec747e), UINT64_2PART_C(0x183a99c3, ec7eafae) },
+	{ UINT64_2PART_C(0xf78c6767, 2ce7919d), UINT64_2PART_C(0x1e494034, e79e5b99) },
+	{ UINT64_2PART_C(0x3ab7c0a0, 7c10bb02), UINT64_2PART_C(0x12edc821, 10c2f940) },
+	{ UINT64_2PART_C(0x4965b0c8, 9b14e9c3), UINT64_2PART_C(0x17a93a29, 54f3b790) },
+	{ UINT64_2PART_C(0x5bbf1cfa, c1da2433), UINT64_2PART_C(0x1d9388b3, aa30a574) },
+	{ UINT64_2PART_C(0xb957721c, b92856a0), UINT64_2PART_C(0x127c3570, 4a5e6768) },
+	{ UINT64_2PART_C(0xe7ad4ea3, e7726c48), UINT64_2PART_C(0x171b42cc, 5cf60142) },
+	{ UINT64_2PART_C(0xa198a24c, e14f075a), UINT64_2PART_C(0x1ce2137f, 74338193) },
+	{ UINT64_2PART_C(0x44ff6570, 0cd16498), UINT64_2PART_C(0x120d4c2f, a8a030fc) },
+	{ UINT64_2PART_C(0x563f3ecc, 1005bdbe), UINT64_2PART_C(0x16909f3b, 92c83d3b) },
+	{ UINT64_2PART_C(0x2bcf0e7f, 14072d2e), UINT64_2PART_C(0x1c34c70a, 777a4c8a) },
+	{ UINT64_2PART_C(0x5b61690f, 6c847c3d), UINT64_2PART_C(0x11a0fc66, 8aac6fd6) },
+	{ UINT64_2PART_C(0xf239c353, 47a59b4c), UINT64_2PART_C(0x16093b80, 2d578bcb) },
+	{ UINT64_2PART_C(0xeec83428, 198f021f), UINT64_2PART_C(0x1b8b8a60, 38ad6ebe) },
+	{ UINT64_2PART_C(0x553d2099, 0ff96153), UINT64_2PART_C(0x1137367c, 236c6537) },
+	{ UINT64_2PART_C(0x2a8c68bf, 53f7b9a8), UINT64_2PART_C(0x1585041b, 2c477e85) },
+	{ UINT64_2PART_C(0x752f82ef, 28f5a812), UINT64_2PART_C(0x1ae64521, f7595e26) },
+	{ UINT64_2PART_C(0x093db1d5, 7999890b), UINT64_2PART_C(0x10cfeb35, 3a97dad8) },
+	{ UINT64_2PART_C(0x0b8d1e4a, d7ffeb4e), UINT64_2PART_C(0x1503e602, 893dd18e) },
+	{ UINT64_2PART_C(0x8e7065dd, 8dffe622), UINT64_2PART_C(0x1a44df83, 2b8d45f1) },
+	{ UINT64_2PART_C(0xf9063faa, 78bfefd5), UINT64_2PART_C(0x106b0bb1, fb384bb6) },
+	{ UINT64_2PART_C(0xb747cf95, 16efebca), UINT64_2PART_C(0x1485ce9e, 7a065ea4) },
+	{ UINT64_2PART_C(0xe519c37a, 5cabe6bd), UINT64_2PART_C(0x19a74246, 1887f64d) },
+	{ UINT64_2PART_C(0xaf301a2c, 79eb7036), UINT64_2PART_C(0x1008896b, cf54f9f0) },
+	{ UINT64_2PART_C(0xdafc20b7, 98664c43), UINT64_2PART_C(0x140aabc6, c32a386c) },
+	{ UINT64_2PART_C(0x11bb28e5, 7e7fdf54), UINT64_2PART_C(0x190d56b8, 73f4c688) },
+	{ UINT64_2PART_C(0x1629f31e, de1fd72a), UINT64_2PART_C(0x1f50ac66, 90f1f82a) },
+	{ UINT64_2PART_C(0x4dda37f3, 4ad3e67a), UINT64_2PART_C(0x13926bc0, 1a973b1a) },
+	{ UINT64_2PART_C(0xe150c5f0, 1d88e019), UINT64_2PART_C(0x187706b0, 213d09e0) },
+	{ UINT64_2PART_C(0x19a4f76c, 24eb181f), UINT64_2PART_C(0x1e94c85c, 298c4c59) },
+	{ UINT64_2PART_C(0xb0071aa3, 9712ef13), UINT64_2PART_C(0x131cfd39, 99f7afb7) },
+	{ UINT64_2PART_C(0x9c08e14c, 7cd7aad8), UINT64_2PART_C(0x17e43c88, 00759ba5) },
+	{ UINT64_2PART_C(0x030b199f, 9c0d958e), UINT64_2PART_C(0x1ddd4baa, 0093028f) },
+	{ UINT64_2PART_C(0x61e6f003, c1887d79), UINT64_2PART_C(0x12aa4f4a, 405be199) },
+	{ UINT64_2PART_C(0xba60ac04, b1ea9cd7), UINT64_2PART_C(0x1754e31c, d072d9ff) },
+	{ UINT64_2PART_C(0xa8f8d705, de65440d), UINT64_2PART_C(0x1d2a1be4, 048f907f) },
+	{ UINT64_2PART_C(0xc99b8663, aaff4a88), UINT64_2PART_C(0x123a516e, 82d9ba4f) },
+	{ UINT64_2PART_C(0xbc0267fc, 95bf1d2a), UINT64_2PART_C(0x16c8e5ca, 239028e3) },
+	{ UINT64_2PART_C(0xab0301fb, bb2ee474), UINT64_2PART_C(0x1c7b1f3c, ac74331c) },
+	{ UINT64_2PART_C(0xeae1e13d, 54fd4ec9), UINT64_2PART_C(0x11ccf385, ebc89ff1) },
+	{ UINT64_2PART_C(0x659a598c, aa3ca27b), UINT64_2PART_C(0x16403067, 66bac7ee) },
+	{ UINT64_2PART_C(0xff00efef, d4cbcb1a), UINT64_2PART_C(0x1bd03c81, 406979e9) },
+	{ UINT64_2PART_C(0x3f6095f5, e4ff5ef0), UINT64_2PART_C(0x116225d0, c841ec32) },
+	{ UINT64_2PART_C(0xcf38bb73, 5e3f36ac), UINT64_2PART_C(0x15baaf44, fa52673e) },
+	{ UINT64_2PART_C(0x8306ea50, 35cf0457), UINT64_2PART_C(0x1b295b16, 38e7010e) },
+	{ UINT64_2PART_C(0x11e45272, 21a162b6), UINT64_2PART_C(0x10f9d8ed, e39060a9) },
+	{ UINT64_2PART_C(0x565d670e, aa09bb64), UINT64_2PART_C(0x15384f29, 5c7478d3) },
+	{ UINT64_2PART_C(0x2bf4c0d2, 548c2a3d), UINT64_2PART_C(0x1a8662f3, b3919708) },
+	{ UINT64_2PART_C(0x1b78f883, 74d79a66), UINT64_2PART_C(0x1093fdd8, 503afe65) },
+	{ UINT64_2PART_C(0x625736a4, 520d8100), UINT64_2PART_C(0x14b8fd4e, 6449bdfe) },
+	{ UINT64_2PART_C(0xfaed044d, 6690e140), UINT64_2PART_C(0x19e73ca1, fd5c2d7d) },
+	{ UINT64_2PART_C(0xbcd422b0, 601a8cc8), UINT64_2PART_C(0x103085e5, 3e599c6e) },
+	{ UINT64_2PART_C(0x6c092b5c, 78212ffa), UINT64_2PART_C(0x143ca75e, 8df0038a) },
+	{ UINT64_2PART_C(0x070b7633, 96297bf8), UINT64_2PART_C(0x194bd136, 316c046d) },
+	{ UINT64_2PART_C(0x48ce53c0, 7bb3daf6), UINT64_2PART_C(0x1f9ec583, bdc70588) },
+	{ UINT64_2PART_C(0x2d80f458, 4d5068da), UINT64_2PART_C(0x13c33b72, 569c6375) },
+	{ UINT64_2PART_C(0x78e1316e, 60a48310), UINT64_2PART_C(0x18b40a4e, ec437c52) }
+};
+
+
+#endif // Foundation_d2s_tables_INCLUDED
@@ -17,10 +17,13 @@
 #include "Poco/Thread.h"
 #include "Poco/Event.h"
 #include "Poco/Exception.h"
+#include <vector>
 
 
 using Poco::ActiveMethod;
 using Poco::ActiveResult;
+using Poco::ActiveResultHolder;
+using Poco::ThreadPool;
 using Poco::Thread;
 using Poco::Event;
 using Poco::Exception;
@@ -89,6 +92,73 @@ namespace
 	private:
 		Event _continue;
 	};
+
+	int twice(const ActiveResult<int>& result)
+	{
+		if (result.failed()) throw Exception("source failed: " + result.error());
+		return 2*result.data();
+	}
+
+	class Aggregator
+	{
+	public:
+		Aggregator(): calls(0)
+		{
+		}
+
+		int sum(const ActiveResult<std::vector<ActiveResult<int> > >& result)
+		{
+			++calls;
+			int total = 0;
+			const std::vector<ActiveResult<int> >& results = result.data();
+			for (std::vector<ActiveResult<int> >::const_iterator it = results.begin(); it != results.end(); ++it)
+			{
+				total += it->data();
+			}
+			return total;
+		}
+
+		void done(const ActiveResult<void>&)
+		{
+			++calls;
+		}
+
+		int calls;
+	};
+
+	class Counted
+	{
+	public:
+		Counted()
+		{
+			++count;
+		}
+
+		Counted(const Counted&)
+		{
+			++count;
+		}
+
+		~Counted()
+		{
+			--count;
+		}
+
+		static int count;
+	};
+
+	int Counted::count = 0;
+
+	int countedValue(const ActiveResult<Counted>&)
+	{
+		return 1;
+	}
+
+	void complete(ActiveResult<int>& result, int value)
+	{
+		result.data(new int(value));
+		result.notify();
+	}
 }
 
 
@@ -236,6 +306,139 @@ void ActiveMethodTest::testVoidIn()
 }
 
 
+void ActiveMethodTest::testThen()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.testMethod(21);
+	ActiveResult<int> cont = result.then(twice);
+	assert (!cont.available());
+	activeObj.cont();
+	cont.wait();
+	assert (result.available());
+	assert (!cont.failed());
+	assert (cont.data() == 42);
+}
+
+
+void ActiveMethodTest::testThenVoid()
+{
+	ActiveObject activeObj;
+	Aggregator aggregator;
+	ActiveResult<void> result = activeObj.testVoidInOut();
+	ActiveResult<void> cont = result.then(&aggregator, &Aggregator::done);
+	activeObj.cont();
+	cont.wait();
+	assert (!cont.failed());
+	assert (aggregator.calls == 1);
+}
+
+
+void ActiveMethodTest::testThenFailure()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.testMethod(100);
+	ActiveResult<int> cont = result.then(twice);
+	cont.wait();
+	assert (result.failed());
+	assert (cont.failed());
+	assert (cont.error() == "source failed: n == 100");
+}
+
+
+void ActiveMethodTest::testThenMethod()
+{
+	ActiveObject activeObj;
+	Aggregator aggregator;
+	std::vector<ActiveResult<int> > results;
+	results.push_back(activeObj.testMethod(1));
+	ActiveResult<int> sum = Poco::whenAll(results).then(&aggregator, &Aggregator::sum);
+	activeObj.cont();
+	sum.wait();
+	assert (sum.data() == 1);
+	assert (aggregator.calls == 1);
+}
+
+
+void ActiveMethodTest::testThenAvailable()
+{
+	ActiveObject activeObj;
+	ActiveResult<int> result = activeObj.testMethod(5);
+	activeObj.cont();
+	result.wait();
+	ThreadPool pool(1, 1);
+	ActiveResult<int> cont = result.then(twice, pool).then(twice, pool);
+	cont.wait();
+	assert (cont.data() == 20);
+	pool.joinAll();
+}
+
+
+void ActiveMethodTest::testWhenAll()
+{
+	Aggregator aggregator;
+	std::vector<ActiveResult<int> > results;
+	results.push_back(ActiveResult<int>(new ActiveResultHolder<int>()));
+	results.push_back(ActiveResult<int>(new ActiveResultHolder<int>()));
+	results.push_back(ActiveResult<int>(new ActiveResultHolder<int>()));
+	ActiveResult<std::vector<ActiveResult<int> > > all = Poco::whenAll(results);
+	ActiveResult<int> sum = all.then(&aggregator, &Aggregator::sum);
+	assert (!all.available());
+	complete(results[1], 2);
+	complete(results[0], 1);
+	assert (!all.available());
+	complete(results[2], 3);
+	assert (all.available());
+	assert (all.data().size() == 3);
+	assert (all.data()[2].data() == 3);
+	sum.wait();
+	assert (sum.data() == 6);
+
+	std::vector<ActiveResult<int> > none;
+	assert (Poco::whenAll(none).available());
+}
+
+
+void ActiveMethodTest::testWhenAny()
+{
+	ActiveObject activeObj;
+	std::vector<ActiveResult<int> > results;
+	results.push_back(activeObj.testMethod(1));
+	results.push_back(activeObj.testMethod(100));
+	ActiveResult<ActiveResult<int> > any = Poco::whenAny(results);
+	any.wait();
+	assert (any.data().failed());
+	assert (any.data().error() == "n == 100");
+	activeObj.cont();
+	results[0].wait();
+
+	std::vector<ActiveResult<int> > none;
+	try
+	{
+		Poco::whenAny(none);
+		fail("empty vector - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ActiveMethodTest::testAbandoned()
+{
+	// continuations must not keep the results they wait for alive
+	{
+		ActiveResult<Counted> result(new ActiveResultHolder<Counted>());
+		result.data(new Counted);
+		std::vector<ActiveResult<Counted> > results(1, result);
+		ActiveResult<int> cont = result.then(countedValue);
+		ActiveResult<std::vector<ActiveResult<Counted> > > all = Poco::whenAll(results);
+		ActiveResult<ActiveResult<Counted> > any = Poco::whenAny(results);
+		assert (Counted::count == 1);
+	}
+	assert (Counted::count == 0);
+}
+
+
 void ActiveMethodTest::setUp()
 {
 }
@@ -258,6 +461,14 @@ CppUnit::Test* ActiveMethodTest::suite()
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidOut);
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidIn);
 	CppUnit_addTest(pSuite, ActiveMethodTest, testVoidInOut);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThen);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenVoid);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenFailure);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenMethod);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testThenAvailable);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testWhenAll);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testWhenAny);
+	CppUnit_addTest(pSuite, ActiveMethodTest, testAbandoned);
 
 	return pSuite;
 }
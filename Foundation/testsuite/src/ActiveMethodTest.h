@@ -34,6 +34,14 @@ public:
 	void testVoidOut();
 	void testVoidInOut();
 	void testVoidIn();
+	void testThen();
+	void testThenVoid();
+	void testThenFailure();
+	void testThenMethod();
+	void testThenAvailable();
+	void testWhenAll();
+	void testWhenAny();
+	void testAbandoned();
 
 	void setUp();
 	void tearDown();
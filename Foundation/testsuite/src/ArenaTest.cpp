@@ -0,0 +1,254 @@
+//
+// ArenaTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ArenaTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Arena.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstring>
+
+
+using Poco::Arena;
+using Poco::ArenaAllocator;
+using Poco::ArenaObject;
+using Poco::UIntPtr;
+
+
+namespace
+{
+	class Tracked: public ArenaObject
+	{
+	public:
+		Tracked(int& count):
+			_count(count)
+		{
+			++_count;
+		}
+
+		virtual ~Tracked()
+		{
+			--_count;
+		}
+
+	private:
+		int& _count;
+	};
+
+	class Small: public ArenaObject
+	{
+	public:
+		int value;
+	};
+}
+
+
+ArenaTest::ArenaTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ArenaTest::~ArenaTest()
+{
+}
+
+
+void ArenaTest::testAllocate()
+{
+	Arena arena(1024);
+	assert (arena.chunkSize() == 1024);
+	assert (arena.used() == 0);
+	assert (arena.capacity() == 0);
+
+	std::vector<char*> blocks;
+	for (int i = 0; i < 100; ++i)
+	{
+		char* p = static_cast<char*>(arena.allocate(40));
+		std::memset(p, i, 40);
+		blocks.push_back(p);
+	}
+	assert (arena.used() >= 4000);
+	assert (arena.capacity() >= arena.used());
+	for (int i = 0; i < 100; ++i)
+	{
+		for (int k = 0; k < 40; ++k)
+		{
+			assert (blocks[i][k] == i);
+		}
+	}
+
+	char* s = arena.strdup("Hello, world!", 5);
+	assert (std::strcmp(s, "Hello") == 0);
+}
+
+
+void ArenaTest::testAlignment()
+{
+	Arena arena(1024);
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(1, 1);
+		void* p = arena.allocate(8);
+		assert (reinterpret_cast<UIntPtr>(p) % Arena::DEFAULT_ALIGNMENT == 0);
+		p = arena.allocate(3, 64);
+		assert (reinterpret_cast<UIntPtr>(p) % 64 == 0);
+	}
+}
+
+
+void ArenaTest::testLarge()
+{
+	Arena arena(1024);
+	arena.allocate(100);
+	char* p = static_cast<char*>(arena.allocate(10000));
+	std::memset(p, 0xAA, 10000);
+	assert (arena.capacity() >= 11024);
+
+	char* q = static_cast<char*>(arena.allocate(100));
+	std::memset(q, 0x55, 100);
+	assert (static_cast<unsigned char>(p[9999]) == 0xAA);
+}
+
+
+void ArenaTest::testReset()
+{
+	Arena arena(1024);
+	void* pFirst = arena.allocate(16);
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100);
+	}
+	assert (arena.capacity() > 1024);
+
+	arena.reset();
+	assert (arena.used() == 0);
+	assert (arena.capacity() == 1024);
+	void* p = arena.allocate(16);
+	assert (p == pFirst);
+}
+
+
+void ArenaTest::testScopedReset()
+{
+	Arena arena(1024);
+	arena.allocate(100);
+	std::size_t used = arena.used();
+	void* pNext = 0;
+	{
+		Arena::ScopedReset reset(arena);
+		pNext = arena.allocate(16);
+		for (int i = 0; i < 100; ++i)
+		{
+			arena.allocate(100);
+		}
+		assert (arena.used() > used);
+	}
+	assert (arena.used() == used);
+	std::size_t capacity = arena.capacity();
+	void* p = arena.allocate(16);
+	assert (p == pNext);
+
+	// chunks retained by the ScopedReset are reused
+	for (int i = 0; i < 100; ++i)
+	{
+		arena.allocate(100);
+	}
+	assert (arena.capacity() == capacity);
+}
+
+
+void ArenaTest::testAllocator()
+{
+	Arena arena;
+	{
+		typedef std::map<int, std::string, std::less<int>, ArenaAllocator<std::pair<const int, std::string> > > Map;
+		ArenaAllocator<std::pair<const int, std::string> > alloc(arena);
+		Map m(std::less<int>(), alloc);
+		for (int i = 0; i < 1000; ++i)
+		{
+			m[i] = "value";
+		}
+		assert (m.size() == 1000);
+		assert (m[500] == "value");
+		assert (arena.used() > 0);
+	}
+	{
+		std::vector<int, ArenaAllocator<int> > vec;
+		for (int i = 0; i < 1000; ++i)
+		{
+			vec.push_back(i);
+		}
+		assert (vec[999] == 999);
+	}
+	ArenaAllocator<int> a1(arena);
+	ArenaAllocator<char> a2(a1);
+	ArenaAllocator<int> a3;
+	assert (a1 == a2);
+	assert (a1 != a3);
+}
+
+
+void ArenaTest::testArenaObject()
+{
+	int count = 0;
+	Arena arena;
+
+	Tracked* pHeap = new Tracked(count);
+	assert (count == 1);
+	assert (arena.used() == 0);
+
+	Tracked* pArena = new (&arena) Tracked(count);
+	assert (count == 2);
+	assert (arena.used() >= sizeof(Tracked));
+	assert (reinterpret_cast<UIntPtr>(pArena) % Arena::DEFAULT_ALIGNMENT == 0);
+
+	Tracked* pNull = new (static_cast<Arena*>(0)) Tracked(count);
+	assert (count == 3);
+
+	delete pArena;
+	delete pHeap;
+	delete pNull;
+	assert (count == 0);
+
+	// ArenaObject must not add a header to heap instances
+	assert (sizeof(Small) == sizeof(int));
+	Small* pSmall = new Small;
+	delete pSmall;
+}
+
+
+void ArenaTest::setUp()
+{
+}
+
+
+void ArenaTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ArenaTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ArenaTest");
+
+	CppUnit_addTest(pSuite, ArenaTest, testAllocate);
+	CppUnit_addTest(pSuite, ArenaTest, testAlignment);
+	CppUnit_addTest(pSuite, ArenaTest, testLarge);
+	CppUnit_addTest(pSuite, ArenaTest, testReset);
+	CppUnit_addTest(pSuite, ArenaTest, testScopedReset);
+	CppUnit_addTest(pSuite, ArenaTest, testAllocator);
+	CppUnit_addTest(pSuite, ArenaTest, testArenaObject);
+
+	return pSuite;
+}
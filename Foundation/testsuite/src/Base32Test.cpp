@@ -17,6 +17,7 @@
 #include "Poco/Base32Decoder.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::Base32Encoder;
@@ -162,6 +163,89 @@ void Base32Test::testEncodeDecode()
 }
 
 
+void Base32Test::testBuffer()
+{
+	char buffer[64];
+	assert (Base32Encoder::encodedLength(4) == 8);
+	assert (Base32Encoder::encodedLength(4, false) == 7);
+	assert (Base32Encoder::encodedLength(6, false) == 10);
+	assert (Base32Encoder::encode("", 0, buffer) == 0);
+	assert (std::string(buffer, Base32Encoder::encode("\00\01\02\03\04\05", 6, buffer)) == "AAAQEAYEAU======");
+	assert (std::string(buffer, Base32Encoder::encode("\00\01\02\03", 4, buffer)) == "AAAQEAY=");
+	assert (std::string(buffer, Base32Encoder::encode("ABCDEF", 6, buffer, false)) == "IFBEGRCFIY");
+	assert (std::string(buffer, Base32Encoder::encode("ABCDE", 5, buffer)) == "IFBEGRCF");
+
+	assert (Base32Decoder::decodedLength(16) == 10);
+	assert (Base32Decoder::decode("", 0, buffer) == 0);
+	assert (std::string(buffer, Base32Decoder::decode("AAAQEAYEAU======", 16, buffer)) == std::string("\00\01\02\03\04\05", 6));
+	assert (std::string(buffer, Base32Decoder::decode("IFBEGRCFIY", 10, buffer)) == "ABCDEF");
+	assert (std::string(buffer, Base32Decoder::decode("IFBEGRCF", 8, buffer)) == "ABCDE");
+
+	try
+	{
+		Base32Decoder::decode("IFBEGRCFI", 9, buffer);
+		fail("invalid final group length - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		Base32Decoder::decode("IFBEGRC1", 8, buffer);
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base32Test::testBlocks()
+{
+	std::string src;
+	for (int i = 0; i < 10000; ++i) src += char(i*7 + i/256);
+
+	for (std::size_t size = src.size() - 4; size <= src.size(); ++size)
+	{
+		for (int padding = 0; padding < 2; ++padding)
+		{
+			std::ostringstream charStr;
+			Base32Encoder charEncoder(charStr, padding != 0);
+			for (std::size_t i = 0; i < size; ++i) charEncoder.put(src[i]);
+			charEncoder.close();
+
+			std::ostringstream blockStr;
+			Base32Encoder blockEncoder(blockStr, padding != 0);
+			blockEncoder.put(src[0]);
+			blockEncoder.write(src.data() + 1, 1000);
+			blockEncoder.write(src.data() + 1001, static_cast<std::streamsize>(size - 1001));
+			blockEncoder.close();
+			assert (blockStr.str() == charStr.str());
+
+			std::vector<char> buffer(Base32Encoder::encodedLength(size, padding != 0));
+			assert (Base32Encoder::encode(src.data(), size, &buffer[0], padding != 0) == buffer.size());
+			assert (std::string(buffer.begin(), buffer.end()) == charStr.str());
+
+			std::vector<char> decoded(Base32Decoder::decodedLength(charStr.str().size()));
+			std::size_t n = Base32Decoder::decode(charStr.str().data(), charStr.str().size(), &decoded[0]);
+			assert (std::string(&decoded[0], n) == src.substr(0, size));
+
+			std::istringstream istr(charStr.str());
+			Base32Decoder decoder(istr);
+			std::string s(1, char(decoder.get()));
+			assert (decoder.peek() == (unsigned char) src[1]);
+			std::vector<char> readBuffer(2*size);
+			decoder.read(&readBuffer[0], 1000);
+			assert (decoder.gcount() == 1000);
+			decoder.read(&readBuffer[1000], static_cast<std::streamsize>(size));
+			assert (decoder.gcount() == static_cast<std::streamsize>(size - 1001));
+			s.append(&readBuffer[0], size - 1);
+			assert (s == src.substr(0, size));
+		}
+	}
+}
+
+
 void Base32Test::setUp()
 {
 }
@@ -179,6 +263,8 @@ CppUnit::Test* Base32Test::suite()
 	CppUnit_addTest(pSuite, Base32Test, testEncoder);
 	CppUnit_addTest(pSuite, Base32Test, testDecoder);
 	CppUnit_addTest(pSuite, Base32Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base32Test, testBuffer);
+	CppUnit_addTest(pSuite, Base32Test, testBlocks);
 
 	return pSuite;
 }
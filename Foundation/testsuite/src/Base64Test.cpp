@@ -17,6 +17,7 @@
 #include "Poco/Base64Decoder.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::Base64Encoder;
@@ -157,6 +158,98 @@ void Base64Test::testEncodeDecode()
 }
 
 
+void Base64Test::testBuffer()
+{
+	char buffer[64];
+	assert (Base64Encoder::encodedLength(0) == 0);
+	assert (Base64Encoder::encodedLength(1) == 4);
+	assert (Base64Encoder::encodedLength(3) == 4);
+	assert (Base64Encoder::encodedLength(4) == 8);
+	assert (Base64Encoder::encode("", 0, buffer) == 0);
+	assert (std::string(buffer, Base64Encoder::encode("\0", 1, buffer)) == "AA==");
+	assert (std::string(buffer, Base64Encoder::encode("ab", 2, buffer)) == "YWI=");
+	assert (std::string(buffer, Base64Encoder::encode("abc", 3, buffer)) == "YWJj");
+	assert (std::string(buffer, Base64Encoder::encode("The quick brown fox jumped", 26, buffer)) == "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wZWQ=");
+
+	assert (Base64Decoder::decodedLength(8) == 6);
+	assert (Base64Decoder::decode("", 0, buffer) == 0);
+	assert (std::string(buffer, Base64Decoder::decode("AA==", 4, buffer)) == std::string(1, '\0'));
+	assert (std::string(buffer, Base64Decoder::decode("YWI=", 4, buffer)) == "ab");
+	assert (std::string(buffer, Base64Decoder::decode("YW Jj\r\n", 7, buffer)) == "abc");
+	assert (std::string(buffer, Base64Decoder::decode("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wZWQ=", 36, buffer)) == "The quick brown fox jumped");
+
+	try
+	{
+		Base64Decoder::decode("YWJ", 3, buffer);
+		fail("incomplete group - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		Base64Decoder::decode("VGhlIHF1aWNrIGJyb3d!IGZveCBqdW1wZWQ=", 36, buffer);
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base64Test::testBlocks()
+{
+	// Large enough for the SIMD code paths, with all
+	// byte values and lengths not divisible by 3.
+	std::string src;
+	for (int i = 0; i < 10000; ++i) src += char(i*7 + i/256);
+
+	for (int lineLength = 0; lineLength < 100; lineLength += 18)
+	{
+		for (std::size_t size = src.size() - 2; size <= src.size(); ++size)
+		{
+			std::ostringstream charStr;
+			Base64Encoder charEncoder(charStr);
+			charEncoder.rdbuf()->setLineLength(lineLength);
+			for (std::size_t i = 0; i < size; ++i) charEncoder.put(src[i]);
+			charEncoder.close();
+
+			std::ostringstream blockStr;
+			Base64Encoder blockEncoder(blockStr);
+			blockEncoder.rdbuf()->setLineLength(lineLength);
+			blockEncoder.put(src[0]);
+			blockEncoder.write(src.data() + 1, 1000);
+			blockEncoder.write(src.data() + 1001, static_cast<std::streamsize>(size - 1001));
+			blockEncoder.close();
+			assert (blockStr.str() == charStr.str());
+
+			if (lineLength == 0)
+			{
+				std::vector<char> buffer(Base64Encoder::encodedLength(size));
+				assert (Base64Encoder::encode(src.data(), size, &buffer[0]) == buffer.size());
+				assert (std::string(buffer.begin(), buffer.end()) == charStr.str());
+			}
+
+			std::vector<char> decoded(Base64Decoder::decodedLength(charStr.str().size()));
+			std::size_t n = Base64Decoder::decode(charStr.str().data(), charStr.str().size(), &decoded[0]);
+			assert (std::string(&decoded[0], n) == src.substr(0, size));
+
+			std::istringstream istr(charStr.str());
+			Base64Decoder decoder(istr);
+			std::string s(1, char(decoder.get()));
+			assert (decoder.peek() == (unsigned char) src[1]);
+			std::vector<char> buffer(2*size);
+			decoder.read(&buffer[0], 1000);
+			assert (decoder.gcount() == 1000);
+			decoder.read(&buffer[1000], static_cast<std::streamsize>(buffer.size()));
+			assert (decoder.gcount() == static_cast<std::streamsize>(size - 1001));
+			s.append(&buffer[0], static_cast<std::size_t>(size - 1));
+			assert (s == src.substr(0, size));
+		}
+	}
+}
+
+
 void Base64Test::setUp()
 {
 }
@@ -174,6 +267,8 @@ CppUnit::Test* Base64Test::suite()
 	CppUnit_addTest(pSuite, Base64Test, testEncoder);
 	CppUnit_addTest(pSuite, Base64Test, testDecoder);
 	CppUnit_addTest(pSuite, Base64Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base64Test, testBuffer);
+	CppUnit_addTest(pSuite, Base64Test, testBlocks);
 
 	return pSuite;
 }
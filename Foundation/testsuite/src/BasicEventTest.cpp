@@ -18,6 +18,8 @@
 #include "Poco/Delegate.h"
 #include "Poco/FunctionDelegate.h"
 #include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/AtomicCounter.h"
 #include "Poco/Exception.h"
 
 
@@ -27,6 +29,46 @@ using namespace Poco;
 #define LARGEINC 100
 
 
+namespace
+{
+	AtomicCounter permanentCount;
+	AtomicCounter transientCount;
+
+	void onPermanent(const void*, int&)
+	{
+		++permanentCount;
+	}
+
+	void onTransient(const void*, int&)
+	{
+		++transientCount;
+	}
+
+	class Notifier: public Runnable
+	{
+	public:
+		Notifier(BasicEvent<int>& ev, int iterations):
+			_ev(ev),
+			_iterations(iterations)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _iterations; ++i)
+			{
+				int arg = i;
+				_ev.notify(this, arg);
+			}
+		}
+
+	private:
+		BasicEvent<int>& _ev;
+		int _iterations;
+	};
+}
+
+
 BasicEventTest::BasicEventTest(const std::string& rName): CppUnit::TestCase(rName)
 {
 }
@@ -189,6 +231,43 @@ void BasicEventTest::testNullMutex()
 }
 
 
+void BasicEventTest::testModifyDuringNotify()
+{
+	int tmp = 0;
+	Simple += delegate(this, &BasicEventTest::onReplace);
+	Simple.notify(this, tmp);
+	assert (_count == 1);
+	Simple.notify(this, tmp);
+	assert (_count == 2);
+	Simple.notify(this, tmp);
+	assert (_count == 3);
+}
+
+
+void BasicEventTest::testConcurrentNotify()
+{
+	const int THREADS = 4;
+	const int ITERATIONS = 20000;
+	BasicEvent<int> ev;
+	ev += delegate(&onPermanent);
+	permanentCount = 0;
+	transientCount = 0;
+
+	Notifier notifier(ev, ITERATIONS);
+	Thread threads[THREADS];
+	for (int i = 0; i < THREADS; ++i) threads[i].start(notifier);
+	for (int i = 0; i < 1000; ++i)
+	{
+		ev += delegate(&onTransient);
+		ev -= delegate(&onTransient);
+	}
+	for (int i = 0; i < THREADS; ++i) threads[i].join();
+
+	assert (permanentCount.value() == THREADS*ITERATIONS);
+	assert (transientCount.value() <= THREADS*ITERATIONS);
+}
+
+
 void BasicEventTest::testDuplicateUnregister()
 {
 	// duplicate unregister shouldn't give an error,
@@ -317,6 +396,13 @@ void BasicEventTest::testAsyncNotify()
 	assert (_count == LARGEINC);
 }
 
+void BasicEventTest::onReplace(const void*, int&)
+{
+	Simple -= delegate(this, &BasicEventTest::onReplace);
+	Simple += delegate(this, &BasicEventTest::onSimple);
+	_count++;
+}
+
 void BasicEventTest::onStaticVoid(const void* pSender)
 {
 	BasicEventTest* p = const_cast<BasicEventTest*>(reinterpret_cast<const BasicEventTest*>(pSender));
@@ -436,5 +522,7 @@ CppUnit::Test* BasicEventTest::suite()
 	CppUnit_addTest(pSuite, BasicEventTest, testOverwriteDelegate);
 	CppUnit_addTest(pSuite, BasicEventTest, testAsyncNotify);
 	CppUnit_addTest(pSuite, BasicEventTest, testNullMutex);
+	CppUnit_addTest(pSuite, BasicEventTest, testModifyDuringNotify);
+	CppUnit_addTest(pSuite, BasicEventTest, testConcurrentNotify);
 	return pSuite;
 }
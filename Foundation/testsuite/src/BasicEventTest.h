@@ -46,6 +46,8 @@ public:
 	void testOverwriteDelegate();
 	void testAsyncNotify();
 	void testNullMutex();
+	void testModifyDuringNotify();
+	void testConcurrentNotify();
 	
 	void setUp();
 	void tearDown();
@@ -70,6 +72,7 @@ protected:
 	void onConstComplex(const void* pSender, const Poco::EventArgs*& i);
 	void onConst2Complex(const void* pSender, const Poco::EventArgs * const & i);
 	void onAsync(const void* pSender, int& i);
+	void onReplace(const void* pSender, int& i);
 
 	int getCount() const;
 private:
@@ -0,0 +1,436 @@
+//
+// BinaryFileChannelTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BinaryFileChannelTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/BinaryFileChannel.h"
+#include "Poco/BinaryLogDecoder.h"
+#include "Poco/Logger.h"
+#include "Poco/Message.h"
+#include "Poco/Path.h"
+#include "Poco/File.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/Timestamp.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/NumberFormatter.h"
+#include "TestChannel.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+
+using Poco::BinaryFileChannel;
+using Poco::BinaryLogDecoder;
+using Poco::Logger;
+using Poco::Message;
+using Poco::Path;
+using Poco::File;
+using Poco::DirectoryIterator;
+using Poco::Timestamp;
+using Poco::DateTimeFormatter;
+using Poco::AutoPtr;
+using Poco::Thread;
+
+
+namespace
+{
+	std::vector<Message> decode(const std::string& path)
+	{
+		std::vector<Message> messages;
+		std::ifstream istr(path.c_str(), std::ios::binary);
+		BinaryLogDecoder decoder(istr);
+		Message msg;
+		while (decoder.read(msg))
+		{
+			messages.push_back(msg);
+		}
+		return messages;
+	}
+
+	class RecordWriter: public Poco::Runnable
+	{
+	public:
+		enum
+		{
+			RECORDS = 1000
+		};
+
+		RecordWriter(Logger& logger, int id):
+			_logger(logger),
+			_id(id)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < RECORDS; ++i)
+			{
+				if (i % 2)
+					_logger.record(Message::PRIO_INFORMATION, "odd %d %d", _id, i);
+				else
+					_logger.record(Message::PRIO_INFORMATION, "even %d %d", _id, i);
+			}
+		}
+
+	private:
+		Logger& _logger;
+		int     _id;
+	};
+}
+
+
+BinaryFileChannelTest::BinaryFileChannelTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+BinaryFileChannelTest::~BinaryFileChannelTest()
+{
+}
+
+
+void BinaryFileChannelTest::testRecord()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		Logger& logger = Logger::get("BinaryFileChannelTest");
+		logger.setChannel(pChannel);
+		logger.setLevel(Message::PRIO_INFORMATION);
+		Timestamp start;
+		logger.record(Message::PRIO_INFORMATION, "no arguments");
+		logger.record(Message::PRIO_WARNING, "%d %u %ld %lu %hd %hu", -1, 2u, -3L, 4UL, static_cast<short>(-5), static_cast<unsigned short>(6));
+		logger.record(Message::PRIO_ERROR, "%s %s %c %b %.2f", "abc", std::string("def"), 'x', true, 1.5);
+		logger.record(Message::PRIO_INFORMATION, "%?d %?d", Poco::Int64(-7), Poco::UInt64(8));
+		logger.record(Message::PRIO_INFORMATION, "%?d %?d", static_cast<long long>(-9), static_cast<unsigned long long>(10));
+		logger.record(Message::PRIO_DEBUG, "filtered %d", 1);
+		logger.setChannel(0);
+		pChannel->close();
+
+		std::vector<Message> messages = decode(name);
+		assert (messages.size() == 5);
+		assert (messages[0].getText() == "no arguments");
+		assert (messages[0].getSource() == "BinaryFileChannelTest");
+		assert (messages[0].getPriority() == Message::PRIO_INFORMATION);
+		assert (messages[0].getTime() >= start);
+		assert (messages[1].getText() == "-1 2 -3 4 -5 6");
+		assert (messages[1].getPriority() == Message::PRIO_WARNING);
+		assert (messages[2].getText() == "abc def x 1 1.50");
+		assert (messages[2].getPriority() == Message::PRIO_ERROR);
+		assert (messages[3].getText() == "-7 8");
+		assert (messages[4].getText() == "-9 10");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testMessage()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_NOTICE, "file.cpp", 42);
+		msg.setTid(17);
+		pChannel->log(msg);
+		Message msgs[2] = { Message("source1", "text1", Message::PRIO_FATAL), Message("source2", "%d", Message::PRIO_TRACE) };
+		pChannel->logBatch(msgs, 2);
+		pChannel->close();
+
+		std::vector<Message> messages = decode(name);
+		assert (messages.size() == 3);
+		assert (messages[0].getSource() == "source");
+		assert (messages[0].getText() == "This is a log file entry");
+		assert (messages[0].getPriority() == Message::PRIO_NOTICE);
+		assert (messages[0].getTid() == 17);
+		assert (messages[0].getTime() == msg.getTime());
+		assert (messages[1].getSource() == "source1");
+		assert (messages[1].getText() == "text1");
+		assert (messages[1].getPriority() == Message::PRIO_FATAL);
+		assert (messages[2].getSource() == "source2");
+		assert (messages[2].getText() == "%d");
+		assert (messages[2].getPriority() == Message::PRIO_TRACE);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testLargeRecord()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		Logger& logger = Logger::get("BinaryFileChannelTest");
+		logger.setChannel(pChannel);
+		logger.setLevel(Message::PRIO_INFORMATION);
+		std::string large(1000, 'x');
+		logger.record(Message::PRIO_INFORMATION, "%s-%s-%d", large, large, 3);
+		logger.record(Message::PRIO_INFORMATION, "%s-%s-%d", large, large, 4);
+		logger.setChannel(0);
+		pChannel->close();
+
+		std::vector<Message> messages = decode(name);
+		assert (messages.size() == 2);
+		assert (messages[0].getText() == large + "-" + large + "-3");
+		assert (messages[1].getText() == large + "-" + large + "-4");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testRotate()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		pChannel->setProperty(BinaryFileChannel::PROP_ROTATION, "2 K");
+		Logger& logger = Logger::get("BinaryFileChannelTest");
+		logger.setChannel(pChannel);
+		logger.setLevel(Message::PRIO_INFORMATION);
+		for (int i = 0; i < 200; ++i)
+		{
+			logger.record(Message::PRIO_INFORMATION, "This is log file entry #%d", i);
+		}
+		logger.setChannel(0);
+		pChannel->close();
+
+		std::vector<Message> current = decode(name);
+		std::vector<Message> rotated = decode(name + ".0");
+		assert (!current.empty());
+		assert (!rotated.empty());
+		int last = 199;
+		for (std::vector<Message>::const_reverse_iterator it = current.rbegin(); it != current.rend(); ++it)
+		{
+			assert (it->getText() == Poco::format("This is log file entry #%d", last--));
+			assert (it->getSource() == "BinaryFileChannelTest");
+		}
+		for (std::vector<Message>::const_reverse_iterator it = rotated.rbegin(); it != rotated.rend(); ++it)
+		{
+			assert (it->getText() == Poco::format("This is log file entry #%d", last--));
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testAppend()
+{
+	std::string name = filename();
+	try
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+			Logger& logger = Logger::get("BinaryFileChannelTest");
+			logger.setChannel(pChannel);
+			logger.setLevel(Message::PRIO_INFORMATION);
+			logger.record(Message::PRIO_INFORMATION, i == 0 ? "first %d" : "second %d", i);
+			logger.setChannel(0);
+			pChannel->close();
+		}
+		std::vector<Message> messages = decode(name);
+		assert (messages.size() == 2);
+		assert (messages[0].getText() == "first 0");
+		assert (messages[1].getText() == "second 1");
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::testTextChannel()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& logger = Logger::get("BinaryFileChannelTest");
+	logger.setChannel(pChannel);
+	logger.setLevel(Message::PRIO_INFORMATION);
+	logger.record(Message::PRIO_WARNING, "%s: %d", "value", 42);
+	logger.record(Message::PRIO_DEBUG, "%s: %d", "value", 43);
+	logger.setChannel(0);
+
+	assert (pChannel->list().size() == 1);
+	assert (pChannel->list().front().getText() == "value: 42");
+	assert (pChannel->list().front().getSource() == "BinaryFileChannelTest");
+	assert (pChannel->list().front().getPriority() == Message::PRIO_WARNING);
+}
+
+
+void BinaryFileChannelTest::testInvalidFile()
+{
+	std::istringstream istr("this is not a binary log");
+	BinaryLogDecoder decoder(istr);
+	Message msg;
+	try
+	{
+		decoder.read(msg);
+		fail("not a binary log - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	std::istringstream empty;
+	BinaryLogDecoder emptyDecoder(empty);
+	assert (!emptyDecoder.read(msg));
+}
+
+
+void BinaryFileChannelTest::testConcurrent()
+{
+	const int THREADS = 4;
+	std::string name = filename();
+	try
+	{
+		AutoPtr<BinaryFileChannel> pChannel = new BinaryFileChannel(name);
+		std::vector<Logger*> loggers;
+		std::vector<RecordWriter*> writers;
+		std::vector<Thread*> threads;
+		for (int i = 0; i < THREADS; ++i)
+		{
+			Logger& logger = Logger::get("BinaryFileChannelTest." + Poco::NumberFormatter::format(i));
+			logger.setChannel(pChannel);
+			logger.setLevel(Message::PRIO_INFORMATION);
+			loggers.push_back(&logger);
+			writers.push_back(new RecordWriter(logger, i));
+			threads.push_back(new Thread);
+		}
+		for (int i = 0; i < THREADS; ++i)
+		{
+			threads[i]->start(*writers[i]);
+		}
+		for (int i = 0; i < THREADS; ++i)
+		{
+			threads[i]->join();
+			delete threads[i];
+			delete writers[i];
+			loggers[i]->setChannel(0);
+		}
+		pChannel->close();
+
+		std::vector<Message> messages = decode(name);
+		assert (messages.size() == THREADS*RecordWriter::RECORDS);
+		std::vector<int> next(THREADS, 0);
+		for (std::vector<Message>::const_iterator it = messages.begin(); it != messages.end(); ++it)
+		{
+			int id = it->getSource()[it->getSource().size() - 1] - '0';
+			assert (id >= 0 && id < THREADS);
+			int i = next[id]++;
+			std::string text(i % 2 ? "odd " : "even ");
+			text += Poco::NumberFormatter::format(id);
+			text += ' ';
+			text += Poco::NumberFormatter::format(i);
+			assert (it->getText() == text);
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void BinaryFileChannelTest::setUp()
+{
+}
+
+
+void BinaryFileChannelTest::tearDown()
+{
+}
+
+
+void BinaryFileChannelTest::remove(const std::string& baseName)
+{
+	DirectoryIterator it(Path::current());
+	DirectoryIterator end;
+	std::vector<std::string> files;
+	while (it != end)
+	{
+		if (it.name().find(baseName) == 0)
+		{
+			files.push_back(it.name());
+		}
+		++it;
+	}
+	for (std::vector<std::string>::iterator itf = files.begin(); itf != files.end(); ++itf)
+	{
+		try
+		{
+			File f(*itf);
+			f.remove();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+std::string BinaryFileChannelTest::filename() const
+{
+	std::string name = "log_";
+	name.append(DateTimeFormatter::format(Timestamp(), "%Y%m%d%H%M%S"));
+	name.append(".plog");
+	return name;
+}
+
+
+CppUnit::Test* BinaryFileChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BinaryFileChannelTest");
+
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testRecord);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testMessage);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testLargeRecord);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testRotate);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testAppend);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testTextChannel);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testInvalidFile);
+	CppUnit_addTest(pSuite, BinaryFileChannelTest, testConcurrent);
+
+	return pSuite;
+}
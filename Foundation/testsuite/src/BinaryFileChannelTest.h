@@ -0,0 +1,49 @@
+//
+// BinaryFileChannelTest.h
+//
+// $Id$
+//
+// Definition of the BinaryFileChannelTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BinaryFileChannelTest_INCLUDED
+#define BinaryFileChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class BinaryFileChannelTest: public CppUnit::TestCase
+{
+public:
+	BinaryFileChannelTest(const std::string& name);
+	~BinaryFileChannelTest();
+
+	void testRecord();
+	void testMessage();
+	void testLargeRecord();
+	void testRotate();
+	void testAppend();
+	void testTextChannel();
+	void testInvalidFile();
+	void testConcurrent();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void remove(const std::string& baseName);
+	std::string filename() const;
+};
+
+
+#endif // BinaryFileChannelTest_INCLUDED
@@ -21,8 +21,12 @@
 #include "Poco/FormattingChannel.h"
 #include "Poco/ConsoleChannel.h"
 #include "Poco/StreamChannel.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Event.h"
+#include "Poco/Mutex.h"
 #include "TestChannel.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::SplitterChannel;
@@ -33,6 +37,8 @@ using Poco::StreamChannel;
 using Poco::Formatter;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::NumberFormatter;
+using Poco::FastMutex;
 
 
 class SimpleFormatter: public Formatter
@@ -47,6 +53,75 @@ public:
 };
 
 
+class BatchChannel: public Poco::Channel
+	/// Records the messages and batch sizes it receives.
+	/// Optionally blocks the logging thread in the first batch
+	/// until release() is called.
+{
+public:
+	BatchChannel(bool block = false):
+		_block(block)
+	{
+	}
+
+	void log(const Message& msg)
+	{
+		logBatch(&msg, 1);
+	}
+
+	void logBatch(const Message* pMessages, std::size_t count)
+	{
+		if (_block)
+		{
+			_block = false;
+			_entered.set();
+			_released.wait();
+		}
+		FastMutex::ScopedLock lock(_mutex);
+		_batches.push_back(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			_texts.push_back(pMessages[i].getText());
+		}
+	}
+
+	void waitEntered()
+	{
+		_entered.wait();
+	}
+
+	void release()
+	{
+		_released.set();
+	}
+
+	std::vector<std::string> texts() const
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		return _texts;
+	}
+
+	std::vector<std::size_t> batches() const
+	{
+		FastMutex::ScopedLock lock(_mutex);
+		return _batches;
+	}
+
+protected:
+	~BatchChannel()
+	{
+	}
+
+private:
+	bool _block;
+	Poco::Event _entered;
+	Poco::Event _released;
+	mutable FastMutex _mutex;
+	std::vector<std::string> _texts;
+	std::vector<std::size_t> _batches;
+};
+
+
 ChannelTest::ChannelTest(const std::string& rName): CppUnit::TestCase(rName)
 {
 }
@@ -82,6 +157,129 @@ void ChannelTest::testAsync()
 }
 
 
+void ChannelTest::testAsyncRing()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel;
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel.get());
+	pAsync->setProperty("queueSize", "16");
+	pAsync->setProperty("batchSize", "4");
+	assert (pAsync->getProperty("queueSize") == "16");
+	assert (pAsync->getProperty("batchSize") == "4");
+	assert (pAsync->getProperty("overflow") == "block");
+	for (int i = 0; i < 100; ++i)
+	{
+		pAsync->log(Message("Source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+	}
+	try
+	{
+		pAsync->setProperty("queueSize", "32");
+		fail("channel is open - must throw");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	pAsync->close();
+
+	std::vector<std::string> texts = pChannel->texts();
+	assert (texts.size() == 100);
+	for (int i = 0; i < 100; ++i)
+	{
+		assert (texts[i] == NumberFormatter::format(i));
+	}
+	std::vector<std::size_t> batches = pChannel->batches();
+	for (std::size_t i = 0; i < batches.size(); ++i)
+	{
+		assert (batches[i] >= 1 && batches[i] <= 4);
+	}
+	assert (pAsync->dropped() == 0);
+
+	pAsync->setProperty("queueSize", "32");
+	pAsync->log(Message("Source", "again", Message::PRIO_INFORMATION));
+	pAsync->close();
+	assert (pChannel->texts().size() == 101);
+	assert (pChannel->texts().back() == "again");
+}
+
+
+void ChannelTest::testAsyncRingDrop()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel(true);
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel.get());
+	pAsync->setProperty("queueSize", "4");
+	pAsync->setProperty("overflow", "drop");
+	assert (pAsync->getProperty("overflow") == "drop");
+
+	pAsync->log(Message("Source", "first", Message::PRIO_INFORMATION));
+	pChannel->waitEntered();
+	for (int i = 0; i < 7; ++i)
+	{
+		pAsync->log(Message("Source", NumberFormatter::format(i), Message::PRIO_INFORMATION));
+	}
+	assert (pAsync->dropped() == 3);
+	pChannel->release();
+	pAsync->close();
+
+	std::vector<std::string> texts = pChannel->texts();
+	assert (texts.size() == 5);
+	assert (texts[0] == "first");
+	assert (texts[1] == "0");
+	assert (texts[4] == "3");
+}
+
+
+void ChannelTest::testAsyncRingDropLowest()
+{
+	AutoPtr<BatchChannel> pChannel = new BatchChannel(true);
+	AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pChannel.get());
+	pAsync->setProperty("queueSize", "4");
+	pAsync->setProperty("overflow", "dropLowest");
+	assert (pAsync->getProperty("overflow") == "dropLowest");
+
+	pAsync->log(Message("Source", "first", Message::PRIO_INFORMATION));
+	pChannel->waitEntered();
+	pAsync->log(Message("Source", "information", Message::PRIO_INFORMATION));
+	pAsync->log(Message("Source", "debug1", Message::PRIO_DEBUG));
+	pAsync->log(Message("Source", "error", Message::PRIO_ERROR));
+	pAsync->log(Message("Source", "debug2", Message::PRIO_DEBUG));
+	assert (pAsync->dropped() == 0);
+	pAsync->log(Message("Source", "warning", Message::PRIO_WARNING)); // replaces debug1
+	pAsync->log(Message("Source", "trace", Message::PRIO_TRACE));     // dropped
+	pAsync->log(Message("Source", "debug3", Message::PRIO_DEBUG));    // dropped
+	pAsync->log(Message("Source", "fatal", Message::PRIO_FATAL));     // replaces debug2
+	assert (pAsync->dropped() == 4);
+	pChannel->release();
+	pAsync->close();
+
+	std::vector<std::string> texts = pChannel->texts();
+	assert (texts.size() == 5);
+	assert (texts[0] == "first");
+	assert (texts[1] == "information");
+	assert (texts[2] == "error");
+	assert (texts[3] == "warning");
+	assert (texts[4] == "fatal");
+}
+
+
+void ChannelTest::testBatch()
+{
+	std::ostringstream str;
+	AutoPtr<ConsoleChannel> pConsole = new ConsoleChannel(str);
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<SplitterChannel> pSplitter = new SplitterChannel;
+	pSplitter->addChannel(pConsole.get());
+	pSplitter->addChannel(pChannel.get());
+
+	Message msgs[3];
+	msgs[0].setText("one");
+	msgs[1].setText("two");
+	msgs[2].setText("three");
+	pSplitter->logBatch(msgs, 3);
+	assert (str.str() == "one\ntwo\nthree\n");
+	assert (pChannel->list().size() == 3);
+	assert (pChannel->list().back().getText() == "three");
+}
+
+
 void ChannelTest::testFormatting()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -132,6 +330,10 @@ CppUnit::Test* ChannelTest::suite()
 
 	CppUnit_addTest(pSuite, ChannelTest, testSplitter);
 	CppUnit_addTest(pSuite, ChannelTest, testAsync);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRing);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingDrop);
+	CppUnit_addTest(pSuite, ChannelTest, testAsyncRingDropLowest);
+	CppUnit_addTest(pSuite, ChannelTest, testBatch);
 	CppUnit_addTest(pSuite, ChannelTest, testFormatting);
 	CppUnit_addTest(pSuite, ChannelTest, testConsole);
 	CppUnit_addTest(pSuite, ChannelTest, testStream);
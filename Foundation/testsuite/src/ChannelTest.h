@@ -28,6 +28,10 @@ public:
 
 	void testSplitter();
 	void testAsync();
+	void testAsyncRing();
+	void testAsyncRingDrop();
+	void testAsyncRingDropLowest();
+	void testBatch();
 	void testFormatting();
 	void testConsole();
 	void testStream();
@@ -0,0 +1,152 @@
+//
+// ChecksumTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ChecksumTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Checksum.h"
+
+
+using Poco::Checksum;
+using Poco::UInt32;
+
+
+namespace
+{
+	std::string pattern(std::size_t length)
+	{
+		std::string data;
+		data.reserve(length);
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			data += static_cast<char>(i*7);
+		}
+		return data;
+	}
+
+
+	UInt32 checksum(Checksum::Type type, const std::string& data)
+	{
+		Checksum cs(type);
+		cs.update(data);
+		return cs.checksum();
+	}
+}
+
+
+ChecksumTest::ChecksumTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ChecksumTest::~ChecksumTest()
+{
+}
+
+
+void ChecksumTest::testCRC32()
+{
+	Checksum cs;
+	assert (cs.type() == Checksum::TYPE_CRC32);
+	assert (cs.checksum() == 0);
+	cs.update("123456789");
+	assert (cs.checksum() == 0xCBF43926);
+
+	assert (checksum(Checksum::TYPE_CRC32, pattern(100000)) == 0x0EAF0153);
+}
+
+
+void ChecksumTest::testCRC32C()
+{
+	Checksum cs(Checksum::TYPE_CRC32C);
+	assert (cs.type() == Checksum::TYPE_CRC32C);
+	assert (cs.checksum() == 0);
+	cs.update("123456789");
+	assert (cs.checksum() == 0xE3069283);
+
+	// test vectors from RFC 3720, B.4
+	assert (checksum(Checksum::TYPE_CRC32C, std::string(32, '\0')) == 0x8A9136AA);
+	assert (checksum(Checksum::TYPE_CRC32C, std::string(32, '\xFF')) == 0x62A8AB43);
+	std::string ascending;
+	for (int i = 0; i < 32; ++i) ascending += static_cast<char>(i);
+	assert (checksum(Checksum::TYPE_CRC32C, ascending) == 0x46DD794E);
+
+	assert (checksum(Checksum::TYPE_CRC32C, pattern(100000)) == 0x31CE2478);
+}
+
+
+void ChecksumTest::testAdler32()
+{
+	Checksum cs(Checksum::TYPE_ADLER32);
+	assert (cs.checksum() == 1);
+	cs.update("Wikipedia");
+	assert (cs.checksum() == 0x11E60398);
+
+	assert (checksum(Checksum::TYPE_ADLER32, pattern(100000)) == 0x6A10942F);
+}
+
+
+void ChecksumTest::testBlocks()
+{
+	// Large blocks may be processed differently from small
+	// ones (e.g., with the PCLMULQDQ or CRC32 instructions),
+	// so the result must not depend on how the data is split up.
+	std::string data = pattern(1000);
+	Checksum::Type types[] = { Checksum::TYPE_CRC32, Checksum::TYPE_CRC32C, Checksum::TYPE_ADLER32 };
+	for (int t = 0; t < 3; ++t)
+	{
+		for (std::size_t length = 0; length < 300; ++length)
+		{
+			for (std::size_t offset = 0; offset < 4; ++offset)
+			{
+				Checksum whole(types[t]);
+				whole.update(data.data() + offset, static_cast<unsigned>(length));
+				Checksum bytes(types[t]);
+				for (std::size_t i = 0; i < length; ++i)
+				{
+					bytes.update(data[offset + i]);
+				}
+				assert (whole.checksum() == bytes.checksum());
+			}
+		}
+		Checksum whole(types[t]);
+		whole.update(data);
+		Checksum parts(types[t]);
+		parts.update(data.data(), 100);
+		parts.update(data.data() + 100, 333);
+		parts.update(data.data() + 433, 567);
+		assert (whole.checksum() == parts.checksum());
+	}
+}
+
+
+void ChecksumTest::setUp()
+{
+}
+
+
+void ChecksumTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ChecksumTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ChecksumTest");
+
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32);
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32C);
+	CppUnit_addTest(pSuite, ChecksumTest, testAdler32);
+	CppUnit_addTest(pSuite, ChecksumTest, testBlocks);
+
+	return pSuite;
+}
@@ -19,6 +19,7 @@
 #include "ByteOrderTest.h"
 #include "StringTest.h"
 #include "StringTokenizerTest.h"
+#include "StringSplitterTest.h"
 #ifndef POCO_VXWORKS
 #include "FPETest.h"
 #endif
@@ -28,6 +29,8 @@
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
 #include "MemoryPoolTest.h"
+#include "SizeClassPoolTest.h"
+#include "ArenaTest.h"
 #include "AnyTest.h"
 #include "VarTest.h"
 #include "FormatTest.h"
@@ -52,6 +55,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(ByteOrderTest::suite());
 	pSuite->addTest(StringTest::suite());
 	pSuite->addTest(StringTokenizerTest::suite());
+	pSuite->addTest(StringSplitterTest::suite());
 #ifndef POCO_VXWORKS
 	pSuite->addTest(FPETest::suite());
 #endif
@@ -61,6 +65,8 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
+	pSuite->addTest(SizeClassPoolTest::suite());
+	pSuite->addTest(ArenaTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(VarTest::suite());
 	pSuite->addTest(FormatTest::suite());
@@ -14,9 +14,11 @@
 #include "MD4EngineTest.h"
 #include "MD5EngineTest.h"
 #include "SHA1EngineTest.h"
+#include "SHA2EngineTest.h"
 #include "HMACEngineTest.h"
 #include "PBKDF2EngineTest.h"
 #include "DigestStreamTest.h"
+#include "ChecksumTest.h"
 #include "RandomTest.h"
 #include "RandomStreamTest.h"
 
@@ -28,9 +30,11 @@ CppUnit::Test* CryptTestSuite::suite()
 	pSuite->addTest(MD4EngineTest::suite());
 	pSuite->addTest(MD5EngineTest::suite());
 	pSuite->addTest(SHA1EngineTest::suite());
+	pSuite->addTest(SHA2EngineTest::suite());
 	pSuite->addTest(HMACEngineTest::suite());
 	pSuite->addTest(PBKDF2EngineTest::suite());
 	pSuite->addTest(DigestStreamTest::suite());
+	pSuite->addTest(ChecksumTest::suite());
 	pSuite->addTest(RandomTest::suite());
 	pSuite->addTest(RandomStreamTest::suite());
 
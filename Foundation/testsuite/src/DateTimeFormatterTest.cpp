@@ -17,10 +17,14 @@
 #include "Poco/DateTimeFormat.h"
 #include "Poco/DateTime.h"
 #include "Poco/Timespan.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Random.h"
+#include <vector>
 
 
 using Poco::DateTime;
 using Poco::Timespan;
+using Poco::Timestamp;
 using Poco::DateTimeFormat;
 using Poco::DateTimeFormatter;
 
@@ -169,6 +173,14 @@ void DateTimeFormatterTest::testCustom()
 
 	std::string str = DateTimeFormatter::format(dt, "%w/%W/%b/%B/%d/%e/%f/%m/%n/%o/%y/%Y/%H/%h/%a/%A/%M/%S/%i/%c/%z/%Z/%%");
 	assert (str == "Sat/Saturday/Jan/January/08/8/ 8/01/1/ 1/05/2005/12/12/pm/PM/30/00/250/2/Z/GMT/%");
+
+	DateTime dt1(5373484.5); // 10000-01-01
+	str = DateTimeFormatter::format(dt1, "%Y-%m-%d");
+	assert (str == "10000-01-01");
+
+	DateTime dt2(98, 2, 3);
+	str = DateTimeFormatter::format(dt2, "%Y");
+	assert (str == "0098");
 }
 
 
@@ -200,6 +212,59 @@ void DateTimeFormatterTest::testTimespan()
 }
 
 
+void DateTimeFormatterTest::testStandardFormats()
+{
+	// The standard formats are formatted by specialized code;
+	// appending a literal to the format string disables it.
+	// Timestamps less than 40 microseconds before midnight are
+	// avoided, as DateTime::dayOfWeek() may be off by one due to
+	// rounding there, so random timestamps have at most 9 microseconds.
+	static const std::string* formats[] =
+	{
+		&DateTimeFormat::ISO8601_FORMAT,
+		&DateTimeFormat::ISO8601_FRAC_FORMAT,
+		&DateTimeFormat::HTTP_FORMAT,
+		&DateTimeFormat::RFC1123_FORMAT
+	};
+	static const int tzds[] = {DateTimeFormatter::UTC, 0, 3600, -3600, 5*3600 + 1800, -9*3600 - 1800};
+
+	std::vector<Timestamp> timestamps;
+	timestamps.push_back(Timestamp(0));
+	timestamps.push_back(Timestamp(-1000));
+	timestamps.push_back(DateTime(1582, 10, 15).timestamp());
+	timestamps.push_back(DateTime(1600, 2, 29, 23, 59, 59, 999).timestamp());
+	timestamps.push_back(DateTime(1900, 3, 1).timestamp());
+	timestamps.push_back(DateTime(2000, 2, 29, 12, 0, 0, 1).timestamp());
+	timestamps.push_back(DateTime(9999, 12, 31, 23, 59, 59, 999).timestamp());
+	Poco::Random rnd;
+	for (int i = 0; i < 10000; ++i)
+	{
+		Timestamp::TimeVal us = (Timestamp::TimeVal(rnd.next()) << 32 | rnd.next()) % 253402300800000000LL;
+		us -= us % 1000 - rnd.next(10);
+		timestamps.push_back(Timestamp(us - 12219292800000000LL));
+	}
+
+	for (std::size_t i = 0; i < timestamps.size(); ++i)
+	{
+		DateTime dt(timestamps[i]);
+		for (std::size_t f = 0; f < sizeof(formats)/sizeof(formats[0]); ++f)
+		{
+			int tzd = tzds[i % (sizeof(tzds)/sizeof(tzds[0]))];
+			std::string expected = DateTimeFormatter::format(dt, *formats[f] + "|", tzd);
+			expected.resize(expected.size() - 1);
+			assert (DateTimeFormatter::format(timestamps[i], *formats[f], tzd) == expected);
+			assert (DateTimeFormatter::format(dt, *formats[f], tzd) == expected);
+		}
+	}
+
+	DateTime dt(2005, 1, 8, 12, 30, 00, 12, 34);
+	assert (DateTimeFormatter::format(dt.timestamp(), DateTimeFormat::ISO8601_FORMAT) == "2005-01-08T12:30:00Z");
+	assert (DateTimeFormatter::format(dt.timestamp(), DateTimeFormat::ISO8601_FRAC_FORMAT, 3600) == "2005-01-08T12:30:00.012034+01:00");
+	assert (DateTimeFormatter::format(dt.timestamp(), DateTimeFormat::HTTP_FORMAT) == "Sat, 08 Jan 2005 12:30:00 GMT");
+	assert (DateTimeFormatter::format(dt.timestamp(), DateTimeFormat::RFC1123_FORMAT, -3600) == "Sat, 8 Jan 2005 12:30:00 -0100");
+}
+
+
 void DateTimeFormatterTest::setUp()
 {
 }
@@ -225,6 +290,7 @@ CppUnit::Test* DateTimeFormatterTest::suite()
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testSORTABLE);
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testCustom);
 	CppUnit_addTest(pSuite, DateTimeFormatterTest, testTimespan);
+	CppUnit_addTest(pSuite, DateTimeFormatterTest, testStandardFormats);
 
 	return pSuite;
 }
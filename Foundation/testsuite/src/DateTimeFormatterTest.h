@@ -37,6 +37,7 @@ public:
 	void testSORTABLE();
 	void testCustom();
 	void testTimespan();
+	void testStandardFormats();
 	
 	void setUp();
 	void tearDown();
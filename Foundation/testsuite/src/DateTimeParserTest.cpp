@@ -760,6 +760,74 @@ void DateTimeParserTest::testParseDayOfWeek()
 }
 
 
+void DateTimeParserTest::testStandardFormats()
+{
+	// Strings strictly following the layout of a standard format are
+	// parsed by specialized code; appending a literal to the format
+	// string disables it. Both must give the same results.
+	struct Sample
+	{
+		const std::string* format;
+		const char* str;
+	};
+	static const Sample samples[] =
+	{
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00+01:00"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00-0130"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00.123Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T12:30:00ZZ"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-00-00T00:00:00Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-13-08T12:30:00Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-02-29T12:30:00Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "2005-01-08T24:30:00Z"},
+		{&DateTimeFormat::ISO8601_FORMAT, "9999-12-31T23:59:59Z"},
+		{&DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00.012034Z"},
+		{&DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00,5+01:00"},
+		{&DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00.1234567890Z"},
+		{&DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00.Z"},
+		{&DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00Z"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 Jan 2005 12:30:00 GMT"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 jAN 2005 12:30:00 GMT"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 Jan 2005 12:30:00 +0100"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 Jan 2005 12:30:00 EST"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 8 Jan 2005 12:30:00 GMT"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 January 2005 12:30:00 GMT"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 08 Foo 2005 12:30:00 GMT"},
+		{&DateTimeFormat::HTTP_FORMAT, "Sat, 32 Jan 2005 12:30:00 GMT"},
+		{&DateTimeFormat::RFC1123_FORMAT, "Sat, 8 Jan 2005 12:30:00 GMT"},
+		{&DateTimeFormat::RFC1123_FORMAT, "Mon, 31 Dec 2012 23:59:59 -0930"},
+		{&DateTimeFormat::RFC1123_FORMAT, "Mon, 31 Dec 2012 23:59:59 GMT+01"},
+		{&DateTimeFormat::RFC1123_FORMAT, "Mon,  1 Dec 2012 23:59:59 GMT"}
+	};
+
+	for (std::size_t i = 0; i < sizeof(samples)/sizeof(samples[0]); ++i)
+	{
+		const std::string& fmt = *samples[i].format;
+		DateTime expected(1970, 1, 1);
+		int expectedTzd = 42;
+		bool expectedOk = DateTimeParser::tryParse(fmt + "|", samples[i].str, expected, expectedTzd);
+		DateTime dt(1970, 1, 1);
+		int tzd = 42;
+		bool ok = DateTimeParser::tryParse(fmt, samples[i].str, dt, tzd);
+		assert (ok == expectedOk);
+		assert (dt == expected);
+		assert (tzd == expectedTzd);
+		assert (dt.millisecond() == expected.millisecond());
+		assert (dt.microsecond() == expected.microsecond());
+	}
+
+	int tzd;
+	DateTime dt = DateTimeParser::parse(DateTimeFormat::HTTP_FORMAT, "Sat, 08 Jan 2005 12:30:00 GMT", tzd);
+	assert (dt == DateTime(2005, 1, 8, 12, 30, 0));
+	assert (tzd == 0);
+	dt = DateTimeParser::parse(DateTimeFormat::ISO8601_FRAC_FORMAT, "2005-01-08T12:30:00.012034-01:30", tzd);
+	assert (dt == DateTime(2005, 1, 8, 12, 30, 0, 12, 34));
+	assert (tzd == -5400);
+}
+
+
 void DateTimeParserTest::setUp()
 {
 }
@@ -787,6 +855,7 @@ CppUnit::Test* DateTimeParserTest::suite()
 	CppUnit_addTest(pSuite, DateTimeParserTest, testGuess);
 	CppUnit_addTest(pSuite, DateTimeParserTest, testParseMonth);
 	CppUnit_addTest(pSuite, DateTimeParserTest, testParseDayOfWeek);
+	CppUnit_addTest(pSuite, DateTimeParserTest, testStandardFormats);
 
 	return pSuite;
 }
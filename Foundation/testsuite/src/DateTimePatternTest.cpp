@@ -0,0 +1,208 @@
+//
+// DateTimePatternTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "DateTimePatternTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/DateTimePattern.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/DateTimeParser.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/DateTime.h"
+#include "Poco/LocalDateTime.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Timespan.h"
+#include "Poco/Exception.h"
+
+
+using Poco::DateTimePattern;
+using Poco::DateTimeFormatter;
+using Poco::DateTimeParser;
+using Poco::DateTimeFormat;
+using Poco::DateTime;
+using Poco::LocalDateTime;
+using Poco::Timestamp;
+using Poco::Timespan;
+using Poco::SyntaxException;
+
+
+namespace
+{
+	const char* FORMATS[] =
+	{
+		"",
+		"no specifiers",
+		"%w/%W/%b/%B/%d/%e/%f/%m/%n/%o/%y/%Y/%H/%h/%a/%A/%M/%S/%i/%c/%z/%Z/%%",
+		"%Y-%m-%d %H:%M:%s %q%",
+		"[%d/%b/%Y:%H:%M:%S %Z]",
+		"%W, %e %B %Y %h:%M %A",
+		"%H:%M:%S.%i"
+	};
+}
+
+
+DateTimePatternTest::DateTimePatternTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+DateTimePatternTest::~DateTimePatternTest()
+{
+}
+
+
+void DateTimePatternTest::testFormat()
+{
+	DateTime dt(2005, 1, 8, 12, 30, 00, 250, 125);
+	LocalDateTime ldt(3600, dt);
+	for (std::size_t i = 0; i < sizeof(FORMATS)/sizeof(FORMATS[0]); ++i)
+	{
+		DateTimePattern pattern(FORMATS[i]);
+		assert (pattern.toString() == FORMATS[i]);
+		assert (pattern.format(dt) == DateTimeFormatter::format(dt, FORMATS[i]));
+		assert (pattern.format(dt, -7200) == DateTimeFormatter::format(dt, FORMATS[i], -7200));
+		assert (pattern.format(dt.timestamp()) == DateTimeFormatter::format(dt.timestamp(), FORMATS[i]));
+		assert (pattern.format(ldt) == DateTimeFormatter::format(ldt, FORMATS[i]));
+
+		std::string str("prefix ");
+		pattern.append(str, dt);
+		assert (str == "prefix " + DateTimeFormatter::format(dt, FORMATS[i]));
+	}
+
+	DateTimePattern pattern("%W, %e %B %Y %h:%M %A");
+	assert (pattern.format(dt) == "Saturday, 8 January 2005 12:30 PM");
+}
+
+
+void DateTimePatternTest::testFormatCached()
+{
+	DateTimePattern pattern("[%d/%b/%Y:%H:%M:%S %Z]");
+	DateTime dt(2005, 1, 8, 12, 30, 00, 250);
+	assert (pattern.format(dt) == "[08/Jan/2005:12:30:00 GMT]");
+	assert (pattern.format(dt) == "[08/Jan/2005:12:30:00 GMT]");
+	dt += Timespan(0, 0, 0, 0, 700000);
+	assert (pattern.format(dt) == "[08/Jan/2005:12:30:00 GMT]");
+	assert (pattern.format(dt, 3600) == "[08/Jan/2005:12:30:00 +0100]");
+	assert (pattern.format(dt) == "[08/Jan/2005:12:30:00 GMT]");
+	dt += Timespan(0, 0, 0, 0, 50000);
+	assert (pattern.format(dt) == "[08/Jan/2005:12:30:01 GMT]");
+	assert (pattern.format(dt.timestamp()) == "[08/Jan/2005:12:30:01 GMT]");
+	dt += Timespan(1, 0, 0, 0, 0);
+	assert (pattern.format(dt.timestamp()) == "[09/Jan/2005:12:30:01 GMT]");
+
+	std::string str("log ");
+	pattern.append(str, dt);
+	assert (str == "log [09/Jan/2005:12:30:01 GMT]");
+
+	Timestamp now;
+	assert (pattern.format(now) == DateTimeFormatter::format(now, pattern.toString()));
+	assert (pattern.format(now) == DateTimeFormatter::format(now, pattern.toString()));
+
+	DateTimePattern fracPattern("%H:%M:%S.%i");
+	dt.assign(2005, 1, 8, 12, 30, 0, 250);
+	assert (fracPattern.format(dt) == "12:30:00.250");
+	dt.assign(2005, 1, 8, 12, 30, 0, 750);
+	assert (fracPattern.format(dt) == "12:30:00.750");
+}
+
+
+void DateTimePatternTest::testStandardFormats()
+{
+	DateTimePattern iso(DateTimeFormat::ISO8601_FORMAT);
+	DateTimePattern http(DateTimeFormat::HTTP_FORMAT);
+	DateTimePattern rfc1123(DateTimeFormat::RFC1123_FORMAT);
+	DateTimePattern isoFrac(DateTimeFormat::ISO8601_FRAC_FORMAT);
+
+	DateTime dt(2005, 1, 8, 12, 30, 00, 12, 34);
+	assert (iso.format(dt) == "2005-01-08T12:30:00Z");
+	assert (iso.format(dt.timestamp(), 3600) == "2005-01-08T12:30:00+01:00");
+	assert (http.format(dt) == "Sat, 08 Jan 2005 12:30:00 GMT");
+	assert (rfc1123.format(dt.timestamp()) == "Sat, 8 Jan 2005 12:30:00 GMT");
+	assert (isoFrac.format(dt) == "2005-01-08T12:30:00.012034Z");
+
+	int tzd;
+	assert (http.parse("Sat, 08 Jan 2005 12:30:00 GMT", tzd) == DateTime(2005, 1, 8, 12, 30, 0));
+	assert (tzd == 0);
+	assert (iso.parse("2005-01-08T12:30:00-01:00", tzd) == DateTime(2005, 1, 8, 12, 30, 0));
+	assert (tzd == -3600);
+	assert (iso.parse("2005-01-08", tzd) == DateTime(2005, 1, 8));
+	assert (tzd == 0);
+}
+
+
+void DateTimePatternTest::testParse()
+{
+	static const char* strings[] =
+	{
+		"2005-01-08 12:30:00.250125 x",
+		"Sat/Saturday/Jan/January/08/8/ 8/01/1/ 1/05/2005/12/12/pm/PM/30/00/250/2/Z/GMT/%",
+		"[08/Jan/2005:12:30:00 +0100]",
+		"Saturday, 8 January 2005 12:30 PM",
+		"12:30:00.250",
+		"2005",
+		"foo"
+	};
+
+	for (std::size_t i = 0; i < sizeof(FORMATS)/sizeof(FORMATS[0]); ++i)
+	{
+		DateTimePattern pattern(FORMATS[i]);
+		for (std::size_t j = 0; j < sizeof(strings)/sizeof(strings[0]); ++j)
+		{
+			DateTime expected(1970, 1, 1);
+			int expectedTzd = 42;
+			bool expectedOk = DateTimeParser::tryParse(FORMATS[i], strings[j], expected, expectedTzd);
+			DateTime dt(1970, 1, 1);
+			int tzd = 42;
+			assert (pattern.tryParse(strings[j], dt, tzd) == expectedOk);
+			assert (dt == expected);
+			assert (tzd == expectedTzd);
+		}
+	}
+
+	DateTimePattern pattern("[%d/%b/%Y:%H:%M:%S %Z]");
+	int tzd;
+	DateTime dt = pattern.parse("[08/Jan/2005:12:30:00 +0100]", tzd);
+	assert (dt == DateTime(2005, 1, 8, 12, 30, 0));
+	assert (tzd == 3600);
+
+	try
+	{
+		pattern.parse("", tzd);
+		fail("empty string - must throw");
+	}
+	catch (SyntaxException&)
+	{
+	}
+}
+
+
+void DateTimePatternTest::setUp()
+{
+}
+
+
+void DateTimePatternTest::tearDown()
+{
+}
+
+
+CppUnit::Test* DateTimePatternTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("DateTimePatternTest");
+
+	CppUnit_addTest(pSuite, DateTimePatternTest, testFormat);
+	CppUnit_addTest(pSuite, DateTimePatternTest, testFormatCached);
+	CppUnit_addTest(pSuite, DateTimePatternTest, testStandardFormats);
+	CppUnit_addTest(pSuite, DateTimePatternTest, testParse);
+
+	return pSuite;
+}
@@ -0,0 +1,43 @@
+//
+// DateTimePatternTest.h
+//
+// $Id$
+//
+// Definition of the DateTimePatternTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef DateTimePatternTest_INCLUDED
+#define DateTimePatternTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class DateTimePatternTest: public CppUnit::TestCase
+{
+public:
+	DateTimePatternTest(const std::string& name);
+	~DateTimePatternTest();
+
+	void testFormat();
+	void testFormatCached();
+	void testStandardFormats();
+	void testParse();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // DateTimePatternTest_INCLUDED
@@ -19,6 +19,7 @@
 #include "LocalDateTimeTest.h"
 #include "DateTimeFormatterTest.h"
 #include "DateTimeParserTest.h"
+#include "DateTimePatternTest.h"
 
 
 CppUnit::Test* DateTimeTestSuite::suite()
@@ -33,6 +34,7 @@ CppUnit::Test* DateTimeTestSuite::suite()
 	pSuite->addTest(LocalDateTimeTest::suite());
 	pSuite->addTest(DateTimeFormatterTest::suite());
 	pSuite->addTest(DateTimeParserTest::suite());
+	pSuite->addTest(DateTimePatternTest::suite());
 
 	return pSuite;
 }
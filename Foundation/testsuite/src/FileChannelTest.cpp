@@ -546,6 +546,117 @@ void FileChannelTest::testWrongPurgeOption()
 }
 
 
+void FileChannelTest::testBuffered()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "1024");
+		assert (pChannel->getProperty(FileChannel::PROP_BUFFERSIZE) == "1024");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f(name);
+		assert (f.getSize() == 0);
+		assert (pChannel->size() == 250);
+		for (int i = 0; i < 40; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assert (f.getSize() == 1025);
+		assert (pChannel->size() == 1250);
+		pChannel->close();
+		assert (f.getSize() == 1250);
+
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "0");
+		pChannel->open();
+		pChannel->log(msg);
+		assert (f.getSize() == 1275);
+		assert (pChannel->size() == 1275);
+		pChannel->close();
+
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "-1");
+			fail("must fail");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testFlushInterval()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "50");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHINTERVAL) == "50");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		pChannel->log(msg);
+		File f(name);
+		int n = 0;
+		while (f.getSize() == 0 && n++ < 100) Thread::sleep(10);
+		assert (f.getSize() == 25);
+		pChannel->close();
+		assert (f.getSize() == 25);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testLogBatch()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+		pChannel->open();
+		std::vector<Message> msgs(10, Message("source", "This is a log file entry", Message::PRIO_INFORMATION));
+		pChannel->logBatch(&msgs[0], msgs.size());
+		File f(name);
+		assert (f.getSize() == 250);
+		for (int i = 0; i < 5; ++i)
+		{
+			pChannel->logBatch(&msgs[0], msgs.size());
+		}
+		f = name + ".0";
+		assert (f.exists());
+		assert (f.getSize() == 1025);
+		f = name;
+		assert (f.getSize() == 1500 - 1025);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::setUp()
 {
 }
@@ -649,6 +760,9 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
 	CppUnit_addTest(pSuite, FileChannelTest, testWrongPurgeOption);
+	CppUnit_addTest(pSuite, FileChannelTest, testBuffered);
+	CppUnit_addTest(pSuite, FileChannelTest, testFlushInterval);
+	CppUnit_addTest(pSuite, FileChannelTest, testLogBatch);
 
 	return pSuite;
 }
@@ -46,6 +46,9 @@ public:
 	void testPurgeAge();
 	void testPurgeCount();
 	void testWrongPurgeOption();
+	void testBuffered();
+	void testFlushInterval();
+	void testLogBatch();
 
 	void setUp();
 	void tearDown();
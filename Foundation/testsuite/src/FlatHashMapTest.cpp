@@ -0,0 +1,407 @@
+//
+// FlatHashMapTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FlatHashMapTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/FlatHashSet.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+#include <map>
+#include <set>
+
+
+using Poco::FlatHashMap;
+using Poco::FlatHashSet;
+using Poco::NumberFormatter;
+
+
+FlatHashMapTest::FlatHashMapTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+FlatHashMapTest::~FlatHashMapTest()
+{
+}
+
+
+void FlatHashMapTest::testInsert()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	assert (hm.empty());
+	assert (hm.find(0) == hm.end());
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, i*2));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (res.second);
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+		assert (hm.count(i) == 1);
+		assert (hm.size() == static_cast<std::size_t>(i + 1));
+	}
+
+	assert (!hm.empty());
+
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+	}
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, 0));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (!res.second);
+	}
+	assert (hm.size() == N);
+	assert (hm.find(N) == hm.end());
+	assert (hm.count(-1) == 0);
+}
+
+
+void FlatHashMapTest::testErase()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	assert (hm.size() == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		assert (hm.erase(i) == 1);
+		assert (hm.erase(i) == 0);
+		IntMap::Iterator it = hm.find(i);
+		assert (it == hm.end());
+	}
+	assert (hm.size() == N/2);
+
+	for (int i = 1; i < N; i += 2)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->second == i*2);
+		hm.erase(it);
+		assert (hm.find(i) == hm.end());
+	}
+	assert (hm.empty());
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*3));
+	}
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->second == i*3);
+	}
+
+	hm.clear();
+	assert (hm.empty());
+	assert (hm.find(1) == hm.end());
+	assert (hm.begin() == hm.end());
+}
+
+
+void FlatHashMapTest::testIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	assert (hm.begin() == hm.end());
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+
+	std::map<int, int> values;
+	IntMap::Iterator it; // do not initialize here to test proper behavior of uninitialized iterators
+	it = hm.begin();
+	while (it != hm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		it->second = 0;
+		++it;
+	}
+
+	assert (values.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (hm[i] == 0);
+	}
+}
+
+
+void FlatHashMapTest::testConstIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+
+	std::map<int, int> values;
+	const IntMap& chm = hm;
+	IntMap::ConstIterator it = chm.begin();
+	while (it != chm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		it++;
+	}
+
+	assert (values.size() == N);
+}
+
+
+void FlatHashMapTest::testIndex()
+{
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	hm[1] = 2;
+	hm[2] = 4;
+	hm[3] = 6;
+
+	assert (hm.size() == 3);
+	assert (hm[1] == 2);
+	assert (hm[2] == 4);
+	assert (hm[3] == 6);
+
+	try
+	{
+		const IntMap& im = hm;
+		(void) im[4];
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+}
+
+
+void FlatHashMapTest::testStringKeys()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<std::string, int> StringMap;
+	StringMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm[NumberFormatter::format(i)] = i;
+	}
+	assert (hm.size() == N);
+
+	assert (hm.find("0") != hm.end());
+	assert (hm.find("0")->second == 0);
+	assert (hm.find("999")->second == 999);
+	assert (hm.find("1000") == hm.end());
+	assert (hm.count("42") == 1);
+
+	const char* key = "123";
+	StringMap::Iterator it = hm.find(key);
+	assert (it != hm.end());
+	assert (it->first == "123");
+	assert (it->second == 123);
+
+	assert (hm.erase("123") == 1);
+	assert (hm.find(key) == hm.end());
+	assert (hm.find(std::string("123")) == hm.end());
+
+	assert (Poco::hash("abc") == Poco::hash(std::string("abc")));
+	assert (Poco::Hash<std::string>()("") == Poco::Hash<std::string>()(std::string()));
+}
+
+
+void FlatHashMapTest::testEraseInsert()
+{
+	// Keeps the number of values constant while constantly
+	// replacing them, so that the table fills up with deleted
+	// slots, which must be reclaimed without growing the table.
+	const int N = 90;
+	const int M = 100000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm[i] = i;
+	}
+	for (int i = N; i < M; ++i)
+	{
+		assert (hm.erase(i - N) == 1);
+		hm[i] = i;
+		assert (hm.size() == N);
+	}
+	for (int i = M - N; i < M; ++i)
+	{
+		assert (hm.find(i) != hm.end());
+		assert (hm[i] == i);
+	}
+	assert (hm.find(M - N - 1) == hm.end());
+
+	IntMap::HashTable table;
+	for (int i = 0; i < N; ++i)
+	{
+		table.insert(IntMap::ValueType(i, i));
+	}
+	std::size_t capacity = table.capacity();
+	for (int i = N; i < M; ++i)
+	{
+		table.erase(i - N);
+		table.insert(IntMap::ValueType(i, i));
+	}
+	assert (table.size() == N);
+	assert (table.capacity() == capacity);
+}
+
+
+void FlatHashMapTest::testCopy()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<std::string, std::string> StringMap;
+	StringMap hm1;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm1[NumberFormatter::format(i)] = NumberFormatter::format(i*2);
+	}
+
+	StringMap hm2(hm1);
+	StringMap hm3;
+	hm3 = hm1;
+	hm1.clear();
+
+	assert (hm2.size() == N);
+	assert (hm3.size() == N);
+	for (int i = 0; i < N; ++i)
+	{
+		std::string key = NumberFormatter::format(i);
+		assert (hm2[key] == NumberFormatter::format(i*2));
+		assert (hm3[key] == NumberFormatter::format(i*2));
+	}
+
+	hm1.swap(hm2);
+	assert (hm1.size() == N);
+	assert (hm2.empty());
+
+	hm2.reserve(N);
+	StringMap::HashTable::ConstIterator it;
+	for (int i = 0; i < N; ++i)
+	{
+		hm2.insert(StringMap::PairType(NumberFormatter::format(i), ""));
+		if (i == 0) it = hm2.begin();
+	}
+	// no rehash, so the iterator is still valid
+	assert (it->first == "0");
+}
+
+
+void FlatHashMapTest::testSet()
+{
+	const int N = 1000;
+
+	typedef FlatHashSet<int> IntSet;
+	IntSet hs;
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntSet::Iterator, bool> res = hs.insert(i);
+		assert (*res.first == i);
+		assert (res.second);
+		assert (!hs.insert(i).second);
+	}
+	assert (hs.size() == N);
+
+	std::set<int> values;
+	for (IntSet::ConstIterator it = hs.begin(); it != hs.end(); ++it)
+	{
+		values.insert(*it);
+	}
+	assert (values.size() == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		hs.erase(hs.find(i));
+		assert (hs.count(i) == 0);
+		assert (hs.count(i + 1) == 1);
+	}
+	assert (hs.size() == N/2);
+
+	FlatHashSet<std::string> ss;
+	ss.insert("foo");
+	ss.insert("bar");
+	assert (ss.count("foo") == 1);
+	assert (ss.count("baz") == 0);
+	assert (ss.erase("bar") == 1);
+	assert (ss.size() == 1);
+}
+
+
+void FlatHashMapTest::setUp()
+{
+}
+
+
+void FlatHashMapTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FlatHashMapTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FlatHashMapTest");
+
+	CppUnit_addTest(pSuite, FlatHashMapTest, testInsert);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testErase);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testConstIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIndex);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testStringKeys);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testEraseInsert);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testCopy);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testSet);
+
+	return pSuite;
+}
@@ -17,6 +17,7 @@
 #include "Poco/HexBinaryDecoder.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <vector>
 
 
 using Poco::HexBinaryEncoder;
@@ -185,6 +186,90 @@ void HexBinaryTest::testEncodeDecode()
 }
 
 
+void HexBinaryTest::testBuffer()
+{
+	char buffer[64];
+	assert (HexBinaryEncoder::encodedLength(3) == 6);
+	assert (HexBinaryEncoder::encode("", 0, buffer) == 0);
+	assert (std::string(buffer, HexBinaryEncoder::encode("\0\x7f\xab", 3, buffer)) == "007fab");
+	assert (std::string(buffer, HexBinaryEncoder::encode("\0\x7f\xab", 3, buffer, true)) == "007FAB");
+	assert (std::string(buffer, HexBinaryEncoder::encode("0123456789abcdef", 16, buffer)) == "30313233343536373839616263646566");
+
+	assert (HexBinaryDecoder::decodedLength(6) == 3);
+	assert (HexBinaryDecoder::decode("", 0, buffer) == 0);
+	assert (std::string(buffer, HexBinaryDecoder::decode("007fAb", 6, buffer)) == std::string("\0\x7f\xab", 3));
+	assert (std::string(buffer, HexBinaryDecoder::decode("0 07\nf ab\r\n", 11, buffer)) == std::string("\0\x7f\xab", 3));
+
+	try
+	{
+		HexBinaryDecoder::decode("007", 3, buffer);
+		fail("odd number of digits - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+	try
+	{
+		HexBinaryDecoder::decode("00x7", 4, buffer);
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void HexBinaryTest::testBlocks()
+{
+	// Large enough for the SIMD code paths, with all byte values.
+	std::string src;
+	for (int i = 0; i < 10000; ++i) src += char(i*7 + i/256);
+
+	for (int lineLength = 0; lineLength < 100; lineLength += 18)
+	{
+		std::ostringstream charStr;
+		HexBinaryEncoder charEncoder(charStr);
+		charEncoder.rdbuf()->setLineLength(lineLength);
+		charEncoder.rdbuf()->setUppercase(lineLength > 50);
+		for (std::size_t i = 0; i < src.size(); ++i) charEncoder.put(src[i]);
+		charEncoder.close();
+
+		std::ostringstream blockStr;
+		HexBinaryEncoder blockEncoder(blockStr);
+		blockEncoder.rdbuf()->setLineLength(lineLength);
+		blockEncoder.rdbuf()->setUppercase(lineLength > 50);
+		blockEncoder.put(src[0]);
+		blockEncoder.write(src.data() + 1, 1000);
+		blockEncoder.write(src.data() + 1001, static_cast<std::streamsize>(src.size() - 1001));
+		blockEncoder.close();
+		assert (blockStr.str() == charStr.str());
+
+		if (lineLength == 0)
+		{
+			std::vector<char> buffer(HexBinaryEncoder::encodedLength(src.size()));
+			assert (HexBinaryEncoder::encode(src.data(), src.size(), &buffer[0]) == buffer.size());
+			assert (std::string(buffer.begin(), buffer.end()) == charStr.str());
+		}
+
+		std::vector<char> decoded(HexBinaryDecoder::decodedLength(charStr.str().size()));
+		std::size_t n = HexBinaryDecoder::decode(charStr.str().data(), charStr.str().size(), &decoded[0]);
+		assert (std::string(&decoded[0], n) == src);
+
+		std::istringstream istr(charStr.str());
+		HexBinaryDecoder decoder(istr);
+		std::string s(1, char(decoder.get()));
+		assert (decoder.peek() == (unsigned char) src[1]);
+		std::vector<char> buffer(2*src.size());
+		decoder.read(&buffer[0], 1000);
+		assert (decoder.gcount() == 1000);
+		decoder.read(&buffer[1000], static_cast<std::streamsize>(src.size()));
+		assert (decoder.gcount() == static_cast<std::streamsize>(src.size() - 1001));
+		s.append(&buffer[0], src.size() - 1);
+		assert (s == src);
+	}
+}
+
+
 void HexBinaryTest::setUp()
 {
 }
@@ -202,6 +287,8 @@ CppUnit::Test* HexBinaryTest::suite()
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testDecoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncodeDecode);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBuffer);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBlocks);
 
 	return pSuite;
 }
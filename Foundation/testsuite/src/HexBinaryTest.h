@@ -29,6 +29,8 @@ public:
 	void testEncoder();
 	void testDecoder();
 	void testEncodeDecode();
+	void testBuffer();
+	void testBlocks();
 
 	void setUp();
 	void tearDown();
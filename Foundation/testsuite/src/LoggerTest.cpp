@@ -15,13 +15,202 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
 #include "Poco/AutoPtr.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberFormatter.h"
 #include "TestChannel.h"
+#include <vector>
+#include <set>
 
 
 using Poco::Logger;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::FastMutex;
+
+
+namespace
+{
+	class BufferLogger: public Runnable
+	{
+	public:
+		BufferLogger(Logger& logger):
+			_logger(logger),
+			_tid(0),
+			_caught(false)
+		{
+		}
+
+		void run()
+		{
+			_tid = Thread::current()->id();
+			_logger.information("short");
+			_logger.information("%s-%d", std::string("formatted"), 42);
+			_logger.information(std::string(100000, 'x'));
+			_logger.information("%s", std::string(100000, 'y'));
+			try
+			{
+				_logger.information("%[5]d", 1);
+			}
+			catch (Poco::InvalidArgumentException&)
+			{
+				_caught = true;
+			}
+			_logger.information("%d", 1);
+			_logger.warning("last", "file.cpp", 42);
+		}
+
+		int tid() const
+		{
+			return _tid;
+		}
+
+		bool caught() const
+		{
+			return _caught;
+		}
+
+	private:
+		Logger& _logger;
+		int     _tid;
+		bool    _caught;
+	};
+
+	class ForwardingChannel: public Channel
+		/// Logs every message it receives to the given
+		/// logger, then records it.
+	{
+	public:
+		ForwardingChannel(Logger& logger):
+			_logger(logger)
+		{
+		}
+
+		void log(const Message& msg)
+		{
+			_logger.information("forwarded %s", msg.getText());
+			_texts.push_back(msg.getText());
+		}
+
+		const std::vector<std::string>& texts() const
+		{
+			return _texts;
+		}
+
+	private:
+		Logger& _logger;
+		std::vector<std::string> _texts;
+	};
+
+	class NestedLogger: public Runnable
+	{
+	public:
+		NestedLogger(Logger& logger):
+			_logger(logger)
+		{
+		}
+
+		void run()
+		{
+			_logger.information("first %d", 1);
+			_logger.information("second");
+		}
+
+	private:
+		Logger& _logger;
+	};
+
+	class LoggerGetter: public Runnable
+	{
+	public:
+		enum
+		{
+			NAMES = 100,
+			ROUNDS = 50
+		};
+
+		LoggerGetter():
+			_loggers(NAMES, static_cast<Logger*>(0)),
+			_consistent(true)
+		{
+		}
+
+		void run()
+		{
+			for (int r = 0; r < ROUNDS; ++r)
+			{
+				for (int i = 0; i < NAMES; ++i)
+				{
+					std::string name("Concurrent.");
+					name += Poco::NumberFormatter::format(i);
+					Logger* pLogger = &Logger::get(name);
+					if (pLogger->name() != name) _consistent = false;
+					if (_loggers[i] && _loggers[i] != pLogger) _consistent = false;
+					if (Logger::has(name) != pLogger) _consistent = false;
+					_loggers[i] = pLogger;
+				}
+			}
+		}
+
+		const std::vector<Logger*>& loggers() const
+		{
+			return _loggers;
+		}
+
+		bool consistent() const
+		{
+			return _consistent;
+		}
+
+	private:
+		std::vector<Logger*> _loggers;
+		bool _consistent;
+	};
+
+	class LoggerLookup: public Runnable
+		/// Looks up loggers until stopped, while
+		/// the loggers are being shut down.
+	{
+	public:
+		LoggerLookup():
+			_found(0)
+		{
+		}
+
+		void run()
+		{
+			while (!_stop.tryWait(0))
+			{
+				for (int i = 0; i < LoggerGetter::NAMES; ++i)
+				{
+					std::string name("Lookup.");
+					name += Poco::NumberFormatter::format(i);
+					if (Logger::has(name)) ++_found;
+				}
+			}
+		}
+
+		void stop()
+		{
+			_stop.set();
+		}
+
+		int found() const
+		{
+			return _found;
+		}
+
+	private:
+		Poco::Event _stop;
+		int _found;
+	};
+}
 
 
 LoggerTest::LoggerTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -291,6 +480,170 @@ void LoggerTest::testDump()
 }
 
 
+void LoggerTest::testFilteredFormat()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& root = Logger::root();
+	root.setChannel(pChannel.get());
+	root.setLevel(Message::PRIO_INFORMATION);
+
+	// a filtered message is never formatted, so the invalid
+	// argument index does not cause an exception
+	root.debug("%[5]d", 1);
+	root.trace("%[5]d %d", 1, 2);
+	assert (pChannel->list().empty());
+
+	try
+	{
+		root.information("%[5]d", 1);
+		fail("bad argument index - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assert (pChannel->list().empty());
+
+	root.setChannel(0);
+	root.error("%d", 1);
+}
+
+
+void LoggerTest::testThreadBuffer()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& logger = Logger::create("ThreadBuffer", pChannel.get(), Message::PRIO_INFORMATION);
+
+	BufferLogger bufferLogger(logger);
+	Thread thread;
+	thread.setName("BufferLogger");
+	thread.start(bufferLogger);
+	thread.join();
+
+	assert (bufferLogger.caught());
+	assert (pChannel->list().size() == 6);
+	TestChannel::MsgList::const_iterator it = pChannel->list().begin();
+	assert (it->getText() == "short");
+	assert (it->getSource() == "ThreadBuffer");
+	assert (it->getPriority() == Message::PRIO_INFORMATION);
+	assert (it->getThread() == "BufferLogger");
+	assert (it->getTid() == bufferLogger.tid());
+	assert (it->getSourceFile() == 0);
+	++it;
+	assert (it->getText() == "formatted-42");
+	++it;
+	assert (it->getText() == std::string(100000, 'x'));
+	++it;
+	assert (it->getText() == std::string(100000, 'y'));
+	++it;
+	assert (it->getText() == "1");
+	++it;
+	assert (it->getText() == "last");
+	assert (it->getPriority() == Message::PRIO_WARNING);
+	assert (std::string(it->getSourceFile()) == "file.cpp");
+	assert (it->getSourceLine() == 42);
+	assert (it->getThread() == "BufferLogger");
+}
+
+
+void LoggerTest::testNestedLogging()
+{
+	AutoPtr<TestChannel> pInner = new TestChannel;
+	Logger& inner = Logger::create("Inner", pInner.get(), Message::PRIO_INFORMATION);
+	AutoPtr<ForwardingChannel> pOuter = new ForwardingChannel(inner);
+	Logger& outer = Logger::create("Outer", pOuter.get(), Message::PRIO_INFORMATION);
+
+	NestedLogger nestedLogger(outer);
+	Thread thread;
+	thread.start(nestedLogger);
+	thread.join();
+
+	assert (pOuter->texts().size() == 2);
+	assert (pOuter->texts()[0] == "first 1");
+	assert (pOuter->texts()[1] == "second");
+	assert (pInner->list().size() == 2);
+	assert (pInner->list().front().getText() == "forwarded first 1");
+	assert (pInner->list().front().getSource() == "Inner");
+	assert (pInner->list().back().getText() == "forwarded second");
+}
+
+
+void LoggerTest::testDestroy()
+{
+	Logger& logger1 = Logger::get("Destroy");
+	assert (Logger::has("Destroy") == &logger1);
+	logger1.setLevel(Message::PRIO_DEBUG);
+
+	Logger::destroy("Destroy");
+	assert (Logger::has("Destroy") == 0);
+
+	Logger& logger2 = Logger::get("Destroy");
+	assert (Logger::has("Destroy") == &logger2);
+	assert (logger2.getLevel() == Message::PRIO_INFORMATION);
+
+	Logger::shutdown();
+	assert (Logger::has("Destroy") == 0);
+	assert (Logger::has("") == 0);
+	Logger& logger3 = Logger::get("Destroy");
+	assert (Logger::has("Destroy") == &logger3);
+}
+
+
+void LoggerTest::testConcurrentGet()
+{
+	const int THREADS = 8;
+	std::vector<LoggerGetter> getters(THREADS);
+	std::vector<Thread*> threads;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads.push_back(new Thread);
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i]->start(getters[i]);
+	}
+	for (int i = 0; i < THREADS; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+	}
+
+	std::set<Logger*> loggers;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		assert (getters[i].consistent());
+		assert (getters[i].loggers() == getters[0].loggers());
+		loggers.insert(getters[i].loggers().begin(), getters[i].loggers().end());
+	}
+	assert (loggers.size() == LoggerGetter::NAMES);
+
+	std::vector<std::string> names;
+	Logger::names(names);
+	assert (names.size() == LoggerGetter::NAMES + 1); // plus the root logger
+}
+
+
+void LoggerTest::testLookupDuringShutdown()
+{
+	LoggerLookup lookup;
+	Thread thread;
+	thread.start(lookup);
+	for (int r = 0; r < 20; ++r)
+	{
+		for (int i = 0; i < LoggerGetter::NAMES; ++i)
+		{
+			std::string name("Lookup.");
+			name += Poco::NumberFormatter::format(i);
+			Logger::get(name);
+		}
+		Thread::yield();
+		Logger::shutdown();
+	}
+	lookup.stop();
+	thread.join();
+	assert (Logger::has("Lookup.0") == 0);
+}
+
+
 void LoggerTest::setUp()
 {
 	Logger::shutdown();
@@ -310,6 +663,12 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
+	CppUnit_addTest(pSuite, LoggerTest, testFilteredFormat);
+	CppUnit_addTest(pSuite, LoggerTest, testThreadBuffer);
+	CppUnit_addTest(pSuite, LoggerTest, testNestedLogging);
+	CppUnit_addTest(pSuite, LoggerTest, testDestroy);
+	CppUnit_addTest(pSuite, LoggerTest, testConcurrentGet);
+	CppUnit_addTest(pSuite, LoggerTest, testLookupDuringShutdown);
 
 	return pSuite;
 }
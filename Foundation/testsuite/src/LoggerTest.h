@@ -30,6 +30,12 @@ public:
 	void testFormat();
 	void testFormatAny();
 	void testDump();
+	void testFilteredFormat();
+	void testThreadBuffer();
+	void testNestedLogging();
+	void testDestroy();
+	void testConcurrentGet();
+	void testLookupDuringShutdown();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,214 @@
+//
+// MappedFileTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MappedFileTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/MappedFile.h"
+#include "Poco/MappedStream.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Exception.h"
+
+
+using Poco::MappedFile;
+using Poco::MappedInputStream;
+using Poco::MappedStreamBuf;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
+using Poco::StreamCopier;
+
+
+namespace
+{
+	std::string testData(std::size_t size)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < size; ++i) data += char('a' + i % 26);
+		return data;
+	}
+
+	void writeFile(const std::string& path, const std::string& data)
+	{
+		FileOutputStream ostr(path);
+		ostr << data;
+	}
+}
+
+
+MappedFileTest::MappedFileTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+MappedFileTest::~MappedFileTest()
+{
+}
+
+
+void MappedFileTest::testRead()
+{
+	std::string data = testData(100000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf(file.path(), MappedFile::AM_READ, MappedFile::MF_PREFETCH | MappedFile::MF_HUGE_PAGES);
+	assert (mf.isMapped());
+	assert (mf.path() == file.path());
+	assert (mf.size() == data.size());
+	assert (std::string(mf.begin(), mf.end()) == data);
+
+	mf.advise(MappedFile::ADVICE_SEQUENTIAL);
+	mf.advise(MappedFile::ADVICE_RANDOM, 5000, 10000);
+	mf.advise(MappedFile::ADVICE_WILLNEED, 90000, 100000);
+	mf.advise(MappedFile::ADVICE_NORMAL, 200000, 10);
+	assert (std::string(mf.begin(), mf.end()) == data);
+
+	mf.unmap();
+	assert (!mf.isMapped());
+	assert (mf.size() == 0);
+}
+
+
+void MappedFileTest::testWrite()
+{
+	std::string data = testData(10000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedFile mf(file.path(), MappedFile::AM_WRITE);
+	mf.begin()[0] = 'X';
+	mf.begin()[9999] = 'Y';
+	mf.flush();
+	mf.unmap();
+
+	data[0] = 'X';
+	data[9999] = 'Y';
+	FileInputStream istr(file.path());
+	std::string result;
+	StreamCopier::copyToString(istr, result);
+	assert (result == data);
+}
+
+
+void MappedFileTest::testEmptyFile()
+{
+	TemporaryFile file;
+	file.createFile();
+
+	MappedFile mf(file.path());
+	assert (mf.isMapped());
+	assert (mf.size() == 0);
+	assert (mf.begin() == mf.end());
+	mf.advise(MappedFile::ADVICE_SEQUENTIAL);
+
+	MappedInputStream istr(file.path());
+	assert (istr.get() == std::char_traits<char>::eof());
+	assert (istr.eof());
+}
+
+
+void MappedFileTest::testNotFound()
+{
+	TemporaryFile file;
+	try
+	{
+		MappedFile mf(file.path());
+		fail("file does not exist - must throw");
+	}
+	catch (Poco::FileNotFoundException&)
+	{
+	}
+
+	try
+	{
+		MappedInputStream istr(file.path());
+		fail("file does not exist - must throw");
+	}
+	catch (Poco::FileNotFoundException&)
+	{
+	}
+}
+
+
+void MappedFileTest::testInputStream()
+{
+	std::string data = testData(50000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedInputStream istr(file.path());
+	char buffer[10];
+	istr.read(buffer, sizeof(buffer));
+	assert (std::string(buffer, sizeof(buffer)) == data.substr(0, 10));
+
+	MappedStreamBuf* pBuf = istr.rdbuf();
+	assert (pBuf->current() == pBuf->file().begin() + 10);
+	assert (pBuf->end() == pBuf->file().end());
+	assert (istr.rdbuf()->in_avail() == static_cast<std::streamsize>(data.size() - 10));
+
+	std::string rest;
+	StreamCopier::copyToString(istr, rest);
+	assert (rest == data.substr(10));
+	assert (istr.eof());
+}
+
+
+void MappedFileTest::testSeek()
+{
+	std::string data = testData(50000);
+	TemporaryFile file;
+	writeFile(file.path(), data);
+
+	MappedInputStream istr(file.path());
+	istr.seekg(26000);
+	assert (istr.tellg() == std::streampos(26000));
+	assert (istr.get() == 'a');
+
+	istr.seekg(-1, std::ios::end);
+	assert (istr.get() == data[data.size() - 1]);
+	assert (istr.get() == std::char_traits<char>::eof());
+
+	istr.clear();
+	istr.seekg(-25, std::ios::cur);
+	assert (istr.tellg() == std::streampos(data.size() - 25));
+
+	istr.seekg(100, std::ios::end);
+	assert (istr.fail());
+}
+
+
+void MappedFileTest::setUp()
+{
+}
+
+
+void MappedFileTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MappedFileTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MappedFileTest");
+
+	CppUnit_addTest(pSuite, MappedFileTest, testRead);
+	CppUnit_addTest(pSuite, MappedFileTest, testWrite);
+	CppUnit_addTest(pSuite, MappedFileTest, testEmptyFile);
+	CppUnit_addTest(pSuite, MappedFileTest, testNotFound);
+	CppUnit_addTest(pSuite, MappedFileTest, testInputStream);
+	CppUnit_addTest(pSuite, MappedFileTest, testSeek);
+
+	return pSuite;
+}
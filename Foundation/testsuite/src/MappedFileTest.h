@@ -0,0 +1,45 @@
+//
+// MappedFileTest.h
+//
+// $Id$
+//
+// Definition of the MappedFileTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MappedFileTest_INCLUDED
+#define MappedFileTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class MappedFileTest: public CppUnit::TestCase
+{
+public:
+	MappedFileTest(const std::string& name);
+	~MappedFileTest();
+
+	void testRead();
+	void testWrite();
+	void testEmptyFile();
+	void testNotFound();
+	void testInputStream();
+	void testSeek();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MappedFileTest_INCLUDED
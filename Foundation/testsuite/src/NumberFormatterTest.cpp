@@ -14,7 +14,10 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Random.h"
 #include <sstream>
+#include <cstring>
 
 
 using Poco::NumberFormatter;
@@ -229,6 +232,39 @@ void NumberFormatterTest::testFormatFloat()
 }
 
 
+void NumberFormatterTest::testFormatShortest()
+{
+	assert (NumberFormatter::format(0.0) == "0");
+	assert (NumberFormatter::format(-0.0) == "0");
+	assert (NumberFormatter::format(0.3) == "0.3");
+	assert (NumberFormatter::format(2.0/3) == "0.6666666666666666");
+	assert (NumberFormatter::format(4.35) == "4.35");
+	assert (NumberFormatter::format(100.0) == "100");
+	assert (NumberFormatter::format(123456789012345.0) == "123456789012345");
+	assert (NumberFormatter::format(1e15) == "1e+15");
+	assert (NumberFormatter::format(9007199254740992.0) == "9.007199254740992e+15");
+	assert (NumberFormatter::format(1e23) == "1e+23");
+	assert (NumberFormatter::format(1e-15) == "0.000000000000001");
+	assert (NumberFormatter::format(-1.5e-16) == "-1.5e-16");
+	assert (NumberFormatter::format(5e-324) == "5e-324");
+	assert (NumberFormatter::format(2.2250738585072014e-308) == "2.2250738585072014e-308");
+	assert (NumberFormatter::format(1.7976931348623157e308) == "1.7976931348623157e+308");
+
+	// random bit patterns must survive a round trip
+	Poco::Random rnd;
+	for (int i = 0; i < 100000; ++i)
+	{
+		UInt64 bits = (UInt64(rnd.next()) << 32) | rnd.next();
+		double value;
+		std::memcpy(&value, &bits, sizeof(value));
+		if (value != value || value - value != 0) continue; // NaN or infinite
+
+		double result = Poco::NumberParser::parseFloat(NumberFormatter::format(value));
+		assert (std::memcmp(&value, &result, sizeof(value)) == 0 || value == 0);
+	}
+}
+
+
 void NumberFormatterTest::testAppend()
 {
 	std::string s;
@@ -297,6 +333,7 @@ CppUnit::Test* NumberFormatterTest::suite()
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatBool);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatHex);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatFloat);
+	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatShortest);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testAppend);
 
 	return pSuite;
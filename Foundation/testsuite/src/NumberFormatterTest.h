@@ -31,6 +31,7 @@ public:
 	void testFormatBool();
 	void testFormatHex();
 	void testFormatFloat();
+	void testFormatShortest();
 	void testAppend();
 
 	void setUp();
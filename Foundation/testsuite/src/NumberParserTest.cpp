@@ -190,6 +190,20 @@ void NumberParserTest::testLimits()
 	assert(testLowerLimit64<Int64>());
 	assert(testUpperLimit64<UInt64>());
 #endif
+
+	int i;
+	assert (!NumberParser::tryParse("2147483648", i));
+	assert (!NumberParser::tryParse("-2147483649", i));
+	assert (!NumberParser::tryParse("99999999999", i));
+	unsigned u;
+	assert (!NumberParser::tryParseUnsigned("4294967296", u));
+#if defined(POCO_HAVE_INT64)
+	Int64 i64;
+	assert (!NumberParser::tryParse64("9223372036854775808", i64));
+	assert (!NumberParser::tryParse64("-9223372036854775809", i64));
+	UInt64 u64;
+	assert (!NumberParser::tryParseUnsigned64("18446744073709551616", u64));
+#endif
 }
 
 
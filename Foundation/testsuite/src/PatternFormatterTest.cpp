@@ -16,6 +16,9 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include <vector>
 
 
 using Poco::PatternFormatter;
@@ -23,6 +26,42 @@ using Poco::Message;
 using Poco::DateTime;
 
 
+namespace
+{
+	class FormatRunner: public Poco::Runnable
+		/// Formats messages in a Poco::Thread, which
+		/// uses the thread's time cache.
+	{
+	public:
+		void add(PatternFormatter& formatter, const Message& msg)
+		{
+			_formatters.push_back(&formatter);
+			_messages.push_back(msg);
+		}
+
+		void run()
+		{
+			for (std::size_t i = 0; i < _messages.size(); ++i)
+			{
+				std::string text;
+				_formatters[i]->format(_messages[i], text);
+				_results.push_back(text);
+			}
+		}
+
+		const std::vector<std::string>& results() const
+		{
+			return _results;
+		}
+
+	private:
+		std::vector<PatternFormatter*> _formatters;
+		std::vector<Message> _messages;
+		std::vector<std::string> _results;
+	};
+}
+
+
 PatternFormatterTest::PatternFormatterTest(const std::string& rName): CppUnit::TestCase(rName)
 {
 }
@@ -111,6 +150,53 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCachedTime()
+{
+	PatternFormatter fmt1("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	PatternFormatter fmt2("%H:%M:%S,%F %t");
+	PatternFormatter fmt3("%H:%M %L%H:%M %z %t");
+	Message msg("TestSource", "Test message text", Message::PRIO_ERROR);
+
+	FormatRunner runner;
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500).timestamp());
+	runner.add(fmt1, msg);
+	runner.add(fmt2, msg);
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 750, 25).timestamp());
+	runner.add(fmt1, msg);
+	runner.add(fmt2, msg);
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 16, 1).timestamp());
+	runner.add(fmt1, msg);
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 999).timestamp());
+	runner.add(fmt1, msg);
+	msg.setTime(DateTime(1969, 12, 31, 23, 59, 59, 250).timestamp());
+	runner.add(fmt1, msg);
+	msg.setTime(DateTime(1970, 1, 1, 0, 0, 0, 250).timestamp());
+	runner.add(fmt1, msg);
+	runner.add(fmt3, msg);
+
+	Poco::Thread thread;
+	thread.start(runner);
+	thread.join();
+
+	const std::vector<std::string>& results = runner.results();
+	assert (results.size() == 9);
+	assert (results[0] == "2005-01-01 14:30:15.500 [Error] TestSource: Test message text");
+	assert (results[1] == "14:30:15,500000 Test message text");
+	assert (results[2] == "2005-01-01 14:30:15.750 [Error] TestSource: Test message text");
+	assert (results[3] == "14:30:15,750025 Test message text");
+	assert (results[4] == "2005-01-01 14:30:16.001 [Error] TestSource: Test message text");
+	assert (results[5] == "2005-01-01 14:30:15.999 [Error] TestSource: Test message text");
+	assert (results[6] == "1969-12-31 23:59:59.250 [Error] TestSource: Test message text");
+	assert (results[7] == "1970-01-01 00:00:00.250 [Error] TestSource: Test message text");
+
+	// the main thread formats without the cache
+	std::string text;
+	fmt3.format(msg, text);
+	assert (results[8] == text);
+	assert (text.find("00:00 ") == 0);
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -126,6 +212,7 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCachedTime);
 
 	return pSuite;
 }
@@ -27,6 +27,7 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCachedTime();
 
 	void setUp();
 	void tearDown();
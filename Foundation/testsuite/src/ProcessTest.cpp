@@ -16,8 +16,14 @@
 #include "Poco/Process.h"
 #include "Poco/Pipe.h"
 #include "Poco/PipeStream.h"
+#include "Poco/PipeMultiplexer.h"
+#include "Poco/Delegate.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/Thread.h"
 #include <csignal>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <fcntl.h>
+#endif
 
 
 using Poco::Process;
@@ -25,6 +31,46 @@ using Poco::ProcessHandle;
 using Poco::Pipe;
 using Poco::PipeInputStream;
 using Poco::PipeOutputStream;
+using Poco::PipeMultiplexer;
+using Poco::delegate;
+
+
+namespace
+{
+	class PipeCollector
+	{
+	public:
+		PipeCollector(std::size_t pipes):
+			_data(pipes),
+			_closed(0)
+		{
+		}
+
+		void onDataRead(const void*, const PipeMultiplexer::PipeEvent& ev)
+		{
+			_data[ev.id].append(ev.data, ev.length);
+		}
+
+		void onPipeClosed(const void*, const int&)
+		{
+			++_closed;
+		}
+
+		const std::string& data(int id) const
+		{
+			return _data[id];
+		}
+
+		int closed() const
+		{
+			return _closed;
+		}
+
+	private:
+		std::vector<std::string> _data;
+		int _closed;
+	};
+}
 
 
 ProcessTest::ProcessTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -269,6 +315,91 @@ void ProcessTest::testSignalExitCode()
 }
 
 
+void ProcessTest::testPipeMultiplexer()
+{
+#if !defined(_WIN32_WCE)
+	std::string name("TestApp");
+	std::string cmd;
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	cmd = "./";
+	cmd += name;
+#else
+	cmd = name;
+#endif
+
+	const int processes = 4;
+	const int lines = 200;
+	std::vector<std::string> args;
+	args.push_back("-out-err");
+	args.push_back("200");
+
+	PipeMultiplexer mux(64);
+	PipeCollector collector(2*processes);
+	mux.dataRead += delegate(&collector, &PipeCollector::onDataRead);
+	mux.pipeClosed += delegate(&collector, &PipeCollector::onPipeClosed);
+
+	std::vector<ProcessHandle> handles;
+	for (int i = 0; i < processes; ++i)
+	{
+		Pipe outPipe;
+		Pipe errPipe;
+		handles.push_back(Process::launch(cmd, args, 0, &outPipe, &errPipe));
+		mux.add(outPipe, 2*i);
+		mux.add(errPipe, 2*i + 1);
+	}
+	assert (mux.count() == 2*processes);
+
+	try
+	{
+		Pipe pipe;
+		mux.add(pipe, 0);
+		fail("duplicate ID - must throw");
+	}
+	catch (Poco::ExistsException&)
+	{
+	}
+
+	mux.run();
+	assert (mux.empty());
+	assert (collector.closed() == 2*processes);
+
+	std::string out;
+	std::string err;
+	for (int i = 0; i < lines; ++i)
+	{
+		out += "out " + Poco::NumberFormatter::format(i) + "\n";
+		err += "err " + Poco::NumberFormatter::format(i) + "\n";
+	}
+	for (int i = 0; i < processes; ++i)
+	{
+		assert (collector.data(2*i) == out);
+		assert (collector.data(2*i + 1) == err);
+		int rc = handles[i].wait();
+		assert (rc == 0);
+	}
+	assert (mux.poll(Poco::Timespan(0)) == 0);
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	// removed pipes, and pipes still open when the
+	// multiplexer is destroyed, become blocking again
+	Pipe removed;
+	Pipe remaining;
+	{
+		PipeMultiplexer mux2;
+		mux2.add(removed, 1);
+		mux2.add(remaining, 2);
+		assert ((fcntl(removed.readHandle(), F_GETFL) & O_NONBLOCK) != 0);
+		mux2.remove(1);
+		assert ((fcntl(removed.readHandle(), F_GETFL) & O_NONBLOCK) == 0);
+		assert ((fcntl(remaining.readHandle(), F_GETFL) & O_NONBLOCK) != 0);
+	}
+	assert ((fcntl(remaining.readHandle(), F_GETFL) & O_NONBLOCK) == 0);
+#endif
+#endif // !defined(_WIN32_WCE)
+}
+
+
 void ProcessTest::setUp()
 {
 }
@@ -291,6 +422,7 @@ CppUnit::Test* ProcessTest::suite()
 	CppUnit_addTest(pSuite, ProcessTest, testIsRunning);
 	CppUnit_addTest(pSuite, ProcessTest, testIsRunningAllowsForTermination);
 	CppUnit_addTest(pSuite, ProcessTest, testSignalExitCode);
+	CppUnit_addTest(pSuite, ProcessTest, testPipeMultiplexer);
 
 	return pSuite;
 }
@@ -34,6 +34,7 @@ public:
 	void testIsRunning();
 	void testIsRunningAllowsForTermination();
 	void testSignalExitCode();
+	void testPipeMultiplexer();
 
 	void setUp();
 	void tearDown();
@@ -275,6 +275,67 @@ void RegularExpressionTest::testGroup()
 }
 
 
+void RegularExpressionTest::testMatchAll()
+{
+	RegularExpression re("[0-9]+");
+	RegularExpression::MatchVec matches;
+	assert (re.matchAll("ABC 123 45 6789 DEF", 0, matches) == 3);
+	assert (matches.size() == 3);
+	assert (matches[0].offset == 4 && matches[0].length == 3);
+	assert (matches[1].offset == 8 && matches[1].length == 2);
+	assert (matches[2].offset == 11 && matches[2].length == 4);
+
+	assert (re.matchAll("ABC 123 45 6789 DEF", 5, matches) == 3);
+	assert (matches[0].offset == 5 && matches[0].length == 2);
+	assert (re.matchAll("ABC", 0, matches) == 0);
+	assert (matches.empty());
+	assert (re.matchAll("", 0, matches) == 0);
+
+	RegularExpression re2("x*");
+	assert (re2.matchAll("axxb", 0, matches) == 4);
+	assert (matches[0].offset == 0 && matches[0].length == 0);
+	assert (matches[1].offset == 1 && matches[1].length == 2);
+	assert (matches[2].offset == 3 && matches[2].length == 0);
+	assert (matches[3].offset == 4 && matches[3].length == 0);
+
+	RegularExpression re3("", RegularExpression::RE_UTF8);
+	assert (re3.matchAll("\xC3\xA4\xC3\xB6", 0, matches) == 3);
+	assert (matches[1].offset == 2);
+	assert (matches[2].offset == 4);
+}
+
+
+void RegularExpressionTest::testCached()
+{
+	RegularExpression::Ptr pRE1 = RegularExpression::cached("[0-9]+");
+	RegularExpression::Ptr pRE2 = RegularExpression::cached("[0-9]+");
+	RegularExpression::Ptr pRE3 = RegularExpression::cached("[0-9]+", RegularExpression::RE_CASELESS);
+	RegularExpression::Ptr pRE4 = RegularExpression::cached("[a-z]+");
+	assert (pRE1.get() == pRE2.get());
+	assert (pRE1.get() != pRE3.get());
+	assert (pRE1.get() != pRE4.get());
+	assert (pRE1->match("123"));
+	assert (!pRE4->match("123"));
+
+	RegularExpression::clearCache();
+	RegularExpression::Ptr pRE5 = RegularExpression::cached("[0-9]+");
+	assert (pRE5.get() != pRE1.get());
+	assert (pRE1->match("456"));
+
+	assert (RegularExpression::match("abc", "[A-Z]+", RegularExpression::RE_CASELESS));
+	assert (!RegularExpression::match("abc", "[A-Z]+"));
+
+	try
+	{
+		RegularExpression::cached("(0-9]");
+		failmsg("bad regexp - must throw exception");
+	}
+	catch (RegularExpressionException&)
+	{
+	}
+}
+
+
 void RegularExpressionTest::setUp()
 {
 }
@@ -305,6 +366,8 @@ CppUnit::Test* RegularExpressionTest::suite()
 	CppUnit_addTest(pSuite, RegularExpressionTest, testSubst4);
 	CppUnit_addTest(pSuite, RegularExpressionTest, testError);
 	CppUnit_addTest(pSuite, RegularExpressionTest, testGroup);
+	CppUnit_addTest(pSuite, RegularExpressionTest, testMatchAll);
+	CppUnit_addTest(pSuite, RegularExpressionTest, testCached);
 
 	return pSuite;
 }
@@ -42,6 +42,8 @@ public:
 	void testSubst4();
 	void testError();
 	void testGroup();
+	void testMatchAll();
+	void testCached();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,187 @@
+//
+// SHA2EngineTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "SHA2EngineTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/SHA2Engine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/HMACEngine.h"
+
+
+using Poco::SHA2Engine;
+using Poco::SHA256Engine;
+using Poco::SHA1Engine;
+using Poco::HMACEngine;
+using Poco::DigestEngine;
+
+
+namespace
+{
+	const std::string MSG1("abc");
+	const std::string MSG2("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+	const std::string MSG3("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu");
+}
+
+
+SHA2EngineTest::SHA2EngineTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+SHA2EngineTest::~SHA2EngineTest()
+{
+}
+
+
+void SHA2EngineTest::testSHA224()
+{
+	SHA2Engine engine(SHA2Engine::SHA_224);
+	assert (engine.digestLength() == 28);
+
+	// test vectors from FIPS 180-4 examples
+
+	assert (DigestEngine::digestToHex(engine.digest()) == "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f");
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+
+	engine.update(MSG2);
+	assert (DigestEngine::digestToHex(engine.digest()) == "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+}
+
+
+void SHA2EngineTest::testSHA256()
+{
+	SHA2Engine engine;
+	assert (engine.algorithm() == SHA2Engine::SHA_256);
+	assert (engine.digestLength() == 32);
+
+	assert (DigestEngine::digestToHex(engine.digest()) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+	engine.update(MSG2);
+	assert (DigestEngine::digestToHex(engine.digest()) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+	engine.update(MSG3);
+	assert (DigestEngine::digestToHex(engine.digest()) == "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+	// RFC 4231, test case 2
+	HMACEngine<SHA256Engine> hmac("Jefe");
+	hmac.update("what do ya want for nothing?");
+	assert (DigestEngine::digestToHex(hmac.digest()) == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+}
+
+
+void SHA2EngineTest::testSHA384()
+{
+	SHA2Engine engine(SHA2Engine::SHA_384);
+	assert (engine.digestLength() == 48);
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+
+	engine.update(MSG3);
+	assert (DigestEngine::digestToHex(engine.digest()) == "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712fcc7c71a557e2db966c3e9fa91746039");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985");
+}
+
+
+void SHA2EngineTest::testSHA512()
+{
+	SHA2Engine engine(SHA2Engine::SHA_512);
+	assert (engine.digestLength() == 64);
+
+	assert (DigestEngine::digestToHex(engine.digest()) == "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+
+	engine.update(MSG2);
+	assert (DigestEngine::digestToHex(engine.digest()) == "204a8fc6dda82f0a0ced7beb8e08a41657c16ef468b228a8279be331a703c33596fd15c13b1b07f9aa1d3bea57789ca031ad85c7a71dd70354ec631238ca3445");
+
+	engine.update(MSG3);
+	assert (DigestEngine::digestToHex(engine.digest()) == "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+}
+
+
+void SHA2EngineTest::testBlocks()
+{
+	// Whole blocks are processed directly from the caller's
+	// buffer (with the SHA extensions, if available), so the
+	// result must not depend on how the data is split up.
+	std::string data(1000000, 'a');
+	const char* expected[] =
+	{
+		"34aa973cd4c4daa4f61eeb2bdbad27316534016f",
+		"cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+		"e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b"
+	};
+	SHA1Engine sha1;
+	SHA2Engine sha256;
+	SHA2Engine sha512(SHA2Engine::SHA_512);
+	DigestEngine* engines[] = { &sha1, &sha256, &sha512 };
+	const std::size_t chunkSizes[] = { 1000000, 65536, 1000, 129, 64, 63 };
+	for (int e = 0; e < 3; ++e)
+	{
+		for (int c = 0; c < 6; ++c)
+		{
+			std::size_t chunkSize = chunkSizes[c];
+			for (std::size_t pos = 0; pos < data.size(); pos += chunkSize)
+			{
+				engines[e]->update(data.data() + pos, data.size() - pos < chunkSize ? data.size() - pos : chunkSize);
+			}
+			assert (DigestEngine::digestToHex(engines[e]->digest()) == expected[e]);
+		}
+	}
+}
+
+
+void SHA2EngineTest::setUp()
+{
+}
+
+
+void SHA2EngineTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SHA2EngineTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SHA2EngineTest");
+
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA224);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA256);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA384);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA512);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testBlocks);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// SHA2EngineTest.h
+//
+// $Id$
+//
+// Definition of the SHA2EngineTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SHA2EngineTest_INCLUDED
+#define SHA2EngineTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class SHA2EngineTest: public CppUnit::TestCase
+{
+public:
+	SHA2EngineTest(const std::string& name);
+	~SHA2EngineTest();
+
+	void testSHA224();
+	void testSHA256();
+	void testSHA384();
+	void testSHA512();
+	void testBlocks();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // SHA2EngineTest_INCLUDED
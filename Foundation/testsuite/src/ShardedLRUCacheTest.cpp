@@ -0,0 +1,339 @@
+//
+// ShardedLRUCacheTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ShardedLRUCacheTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/ShardedLRUCache.h"
+#include "Poco/Exception.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Random.h"
+#include "Poco/NumberFormatter.h"
+
+
+using namespace Poco;
+
+
+namespace
+{
+	class CacheWorker: public Runnable
+	{
+	public:
+		CacheWorker(ShardedLRUCache<std::string, int>& cache, UInt32 seed):
+			_cache(cache),
+			_errors(0)
+		{
+			_random.seed(seed);
+		}
+
+		void run()
+		{
+			for (int i = 0; i < 20000; ++i)
+			{
+				int n = static_cast<int>(_random.next(500));
+				std::string key = NumberFormatter::format(n);
+				if (_random.next(4) == 0)
+				{
+					_cache.add(key, n);
+				}
+				else
+				{
+					SharedPtr<int> pValue = _cache.get(key);
+					if (!pValue.isNull() && *pValue != n) ++_errors;
+				}
+			}
+		}
+
+		int errors() const
+		{
+			return _errors;
+		}
+
+	private:
+		ShardedLRUCache<std::string, int>& _cache;
+		Random _random;
+		int _errors;
+	};
+}
+
+
+ShardedLRUCacheTest::ShardedLRUCacheTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+ShardedLRUCacheTest::~ShardedLRUCacheTest()
+{
+}
+
+
+void ShardedLRUCacheTest::testClear()
+{
+	ShardedLRUCache<int, int> aCache(16);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.size() == 3);
+	assert (aCache.getAllKeys().size() == 3);
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(1) == 2);
+	assert (*aCache.get(3) == 4);
+	assert (*aCache.get(5) == 6);
+	aCache.clear();
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.has(5));
+	assert (aCache.size() == 0);
+	aCache.add(1, 2);
+	assert (*aCache.get(1) == 2);
+}
+
+
+void ShardedLRUCacheTest::testCacheSize0()
+{
+	try
+	{
+		ShardedLRUCache<int, int> aCache(0);
+		failmsg ("cache size of 0 is illegal, test should fail");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ShardedLRUCacheTest::testShards()
+{
+	ShardedLRUCache<int, int> cache1(1024, 0, 10);
+	assert (cache1.shards() == 16);
+	ShardedLRUCache<int, int> cache2(4);
+	assert (cache2.shards() == 4);
+	ShardedLRUCache<int, int> cache3(5);
+	assert (cache3.shards() == 4);
+	ShardedLRUCache<int, int> cache4(1);
+	assert (cache4.shards() == 1);
+	ShardedLRUCache<int, int> cache5(1024, 0, 0);
+	assert (cache5.shards() == 1);
+}
+
+
+void ShardedLRUCacheTest::testEviction()
+{
+	// with a single shard, the CLOCK order is deterministic
+	ShardedLRUCache<int, int> aCache(3, 0, 1);
+	aCache.add(1, 2);
+	aCache.add(2, 3);
+	aCache.add(3, 4);
+	assert (*aCache.get(1) == 2);
+
+	// 1 has been referenced, so 2 is evicted
+	aCache.add(4, 5);
+	assert (aCache.has(1));
+	assert (!aCache.has(2));
+	assert (aCache.has(3));
+	assert (aCache.has(4));
+
+	// nothing referenced since the hand passed 1: 3 is next
+	aCache.add(5, 6);
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.has(4));
+	assert (aCache.has(5));
+
+	// a removed entry frees its slot
+	aCache.remove(4);
+	aCache.add(6, 7);
+	assert (aCache.has(1));
+	assert (aCache.has(5));
+	assert (aCache.has(6));
+	assert (aCache.size() == 3);
+}
+
+
+void ShardedLRUCacheTest::testCapacity()
+{
+	ShardedLRUCache<int, int> aCache(64, 0, 4);
+	for (int i = 0; i < 1000; ++i)
+	{
+		aCache.add(i, i);
+		assert (*aCache.get(i) == i);
+	}
+	assert (aCache.size() <= 64);
+	assert (aCache.size() > 0);
+	assert (aCache.statistics().evictions == 1000 - aCache.size());
+}
+
+
+void ShardedLRUCacheTest::testDuplicateAdd()
+{
+	ShardedLRUCache<int, int> aCache(3, 0, 1);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.add(1, 3);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+	aCache.update(1, 4);
+	assert (*aCache.get(1) == 4);
+	assert (aCache.size() == 1);
+}
+
+
+void ShardedLRUCacheTest::testSharedPtr()
+{
+	ShardedLRUCache<int, std::string> aCache(1, 0, 1);
+	SharedPtr<std::string> pValue(new std::string("value"));
+	aCache.add(1, pValue);
+	assert (aCache.get(1) == pValue);
+	SharedPtr<std::string> pOld = aCache.get(1);
+	aCache.add(2, "other");
+	assert (!aCache.has(1));
+	assert (aCache.get(1).isNull());
+	assert (*pOld == "value");
+	assert (pOld.referenceCount() == 2);
+
+	try
+	{
+		aCache.add(3, SharedPtr<std::string>());
+		failmsg ("adding a NULL value must fail");
+	}
+	catch (NullPointerException&)
+	{
+	}
+}
+
+
+void ShardedLRUCacheTest::testExpire()
+{
+	ShardedLRUCache<int, int> aCache(16, 100);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	Thread::sleep(200);
+	assert (!aCache.has(1));
+	assert (aCache.get(1).isNull());
+	assert (aCache.statistics().expirations == 1);
+
+	aCache.add(1, 3);
+	assert (*aCache.get(1) == 3);
+}
+
+
+void ShardedLRUCacheTest::testPurgeExpired()
+{
+	ShardedLRUCache<int, int> aCache(64, 100);
+	for (int i = 0; i < 10; ++i)
+	{
+		aCache.add(i, i);
+	}
+	assert (aCache.purgeExpired() == 0);
+	assert (aCache.size() == 10);
+	Thread::sleep(200);
+	aCache.add(10, 10);
+	assert (aCache.purgeExpired() == 10);
+	assert (aCache.size() == 1);
+	assert (aCache.getAllKeys().size() == 1);
+	assert (aCache.statistics().expirations == 10);
+
+	ShardedLRUCache<int, int> noExpire(64);
+	noExpire.add(1, 1);
+	assert (noExpire.purgeExpired() == 0);
+}
+
+
+void ShardedLRUCacheTest::testStatistics()
+{
+	ShardedLRUCache<int, int> aCache(2, 0, 1);
+	aCache.add(1, 1);
+	aCache.add(2, 2);
+	aCache.get(1);
+	aCache.get(2);
+	aCache.get(3);
+	aCache.add(3, 3);
+	ShardedLRUCache<int, int>::Statistics stats = aCache.statistics();
+	assert (stats.hits == 2);
+	assert (stats.misses == 1);
+	assert (stats.evictions == 1);
+	assert (stats.expirations == 0);
+
+	aCache.resetStatistics();
+	stats = aCache.statistics();
+	assert (stats.hits == 0);
+	assert (stats.misses == 0);
+	assert (stats.evictions == 0);
+}
+
+
+void ShardedLRUCacheTest::testConcurrent()
+{
+	const int THREADS = 8;
+	ShardedLRUCache<std::string, int> aCache(256);
+	std::vector<CacheWorker*> workers;
+	std::vector<Thread*> threads;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		workers.push_back(new CacheWorker(aCache, i + 1));
+		threads.push_back(new Thread);
+	}
+	for (int i = 0; i < THREADS; ++i) threads[i]->start(*workers[i]);
+	for (int i = 0; i < THREADS; ++i) threads[i]->join();
+
+	int errors = 0;
+	for (int i = 0; i < THREADS; ++i)
+	{
+		errors += workers[i]->errors();
+		delete threads[i];
+		delete workers[i];
+	}
+	assert (errors == 0);
+	assert (aCache.size() <= 256);
+
+	ShardedLRUCache<std::string, int>::Statistics stats = aCache.statistics();
+	assert (stats.hits > 0);
+	assert (stats.misses > 0);
+	assert (stats.hits + stats.misses > 0);
+}
+
+
+void ShardedLRUCacheTest::setUp()
+{
+}
+
+
+void ShardedLRUCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ShardedLRUCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ShardedLRUCacheTest");
+
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testClear);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testCacheSize0);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testShards);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testEviction);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testCapacity);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testDuplicateAdd);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testSharedPtr);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testPurgeExpired);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testStatistics);
+	CppUnit_addTest(pSuite, ShardedLRUCacheTest, testConcurrent);
+
+	return pSuite;
+}
@@ -0,0 +1,47 @@
+//
+// ShardedLRUCacheTest.h
+//
+// $Id$
+//
+// Tests for ShardedLRUCache
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef ShardedLRUCacheTest_INCLUDED
+#define ShardedLRUCacheTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class ShardedLRUCacheTest: public CppUnit::TestCase
+{
+public:
+	ShardedLRUCacheTest(const std::string& name);
+	~ShardedLRUCacheTest();
+
+	void testClear();
+	void testCacheSize0();
+	void testShards();
+	void testEviction();
+	void testCapacity();
+	void testDuplicateAdd();
+	void testSharedPtr();
+	void testExpire();
+	void testPurgeExpired();
+	void testStatistics();
+	void testConcurrent();
+
+	void setUp();
+	void tearDown();
+	static CppUnit::Test* suite();
+};
+
+
+#endif // ShardedLRUCacheTest_INCLUDED
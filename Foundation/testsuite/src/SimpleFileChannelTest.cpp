@@ -21,6 +21,7 @@
 #include "SimpleFileChannelTest.h"
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
+#include <vector>
 
 
 using Poco::SimpleFileChannel;
@@ -71,6 +72,41 @@ void SimpleFileChannelTest::testRotate()
 }
 
 
+void SimpleFileChannelTest::testBuffered()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<SimpleFileChannel> pChannel = new SimpleFileChannel(name);
+		pChannel->setProperty(SimpleFileChannel::PROP_FLUSH, "false");
+		pChannel->setProperty(SimpleFileChannel::PROP_BUFFERSIZE, "1024");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f(name);
+		assert (f.getSize() == 0);
+		assert (pChannel->size() == 250);
+		pChannel->close();
+		assert (f.getSize() == 250);
+
+		pChannel->setProperty(SimpleFileChannel::PROP_FLUSH, "true");
+		pChannel->open();
+		std::vector<Message> msgs(10, msg);
+		pChannel->logBatch(&msgs[0], msgs.size());
+		assert (f.getSize() == 500);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void SimpleFileChannelTest::setUp()
 {
 }
@@ -122,6 +158,7 @@ CppUnit::Test* SimpleFileChannelTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SimpleFileChannelTest");
 
 	CppUnit_addTest(pSuite, SimpleFileChannelTest, testRotate);
+	CppUnit_addTest(pSuite, SimpleFileChannelTest, testBuffered);
 
 	return pSuite;
 }
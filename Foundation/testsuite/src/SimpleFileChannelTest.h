@@ -27,6 +27,7 @@ public:
 	~SimpleFileChannelTest();
 
 	void testRotate();
+	void testBuffered();
 
 	void setUp();
 	void tearDown();
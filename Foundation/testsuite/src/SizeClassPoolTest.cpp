@@ -0,0 +1,282 @@
+//
+// SizeClassPoolTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "SizeClassPoolTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/SizeClassPool.h"
+#include "Poco/SizeClassAllocator.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include <vector>
+#include <list>
+#include <map>
+#include <cstring>
+
+
+using Poco::SizeClassPool;
+using Poco::SizeClassAllocator;
+using Poco::SizeClassBufferAllocator;
+using Poco::Thread;
+
+
+namespace
+{
+	class PoolUser: public Poco::Runnable
+	{
+	public:
+		PoolUser(SizeClassPool& pool, std::size_t size):
+			_pool(pool),
+			_size(size),
+			_ok(true)
+		{
+		}
+
+		void run()
+		{
+			std::vector<unsigned char*> blocks;
+			for (int round = 0; round < 10; ++round)
+			{
+				for (int i = 0; i < 500; ++i)
+				{
+					unsigned char* p = static_cast<unsigned char*>(_pool.allocate(_size));
+					std::memset(p, i & 0xFF, _size);
+					blocks.push_back(p);
+				}
+				for (std::size_t i = 0; i < blocks.size(); ++i)
+				{
+					if (blocks[i][0] != (i & 0xFF) || blocks[i][_size - 1] != (i & 0xFF)) _ok = false;
+					_pool.deallocate(blocks[i], _size);
+				}
+				blocks.clear();
+			}
+		}
+
+		bool ok() const
+		{
+			return _ok;
+		}
+
+	private:
+		SizeClassPool& _pool;
+		std::size_t _size;
+		bool _ok;
+	};
+}
+
+
+SizeClassPoolTest::SizeClassPoolTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+SizeClassPoolTest::~SizeClassPoolTest()
+{
+}
+
+
+void SizeClassPoolTest::testBlockSize()
+{
+	assert (SizeClassPool::blockSize(0) == 16);
+	assert (SizeClassPool::blockSize(1) == 16);
+	assert (SizeClassPool::blockSize(16) == 16);
+	assert (SizeClassPool::blockSize(17) == 32);
+	assert (SizeClassPool::blockSize(4000) == 4096);
+	assert (SizeClassPool::blockSize(4096) == 4096);
+	assert (SizeClassPool::blockSize(65536) == 65536);
+	assert (SizeClassPool::blockSize(65537) == 65537);
+}
+
+
+void SizeClassPoolTest::testAllocate()
+{
+	SizeClassPool pool;
+	assert (pool.allocated() == 0);
+
+	void* p1 = pool.allocate(100);
+	assert (p1 != 0);
+	assert (pool.allocated() == 64);
+	void* p2 = pool.allocate(100);
+	assert (p2 != 0 && p2 != p1);
+	assert (pool.allocated() == 64);
+
+	pool.deallocate(p2, 100);
+	void* p3 = pool.allocate(100);
+	assert (p3 == p2);
+
+	std::vector<void*> blocks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		blocks.push_back(pool.allocate(4096));
+	}
+	int allocated = pool.allocated();
+	for (std::vector<void*>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+	{
+		pool.deallocate(*it, 4096);
+	}
+	blocks.clear();
+	for (int i = 0; i < 1000; ++i)
+	{
+		blocks.push_back(pool.allocate(4096));
+	}
+	assert (pool.allocated() == allocated);
+	for (std::vector<void*>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+	{
+		pool.deallocate(*it, 4096);
+	}
+
+	pool.deallocate(p1, 100);
+	pool.deallocate(p3, 100);
+	pool.deallocate(0, 100);
+}
+
+
+void SizeClassPoolTest::testLarge()
+{
+	SizeClassPool pool;
+	void* p = pool.allocate(100000);
+	assert (p != 0);
+	std::memset(p, 0xFF, 100000);
+	pool.deallocate(p, 100000);
+	assert (pool.allocated() == 0);
+}
+
+
+void SizeClassPoolTest::testThreads()
+{
+	SizeClassPool pool;
+	{
+		PoolUser user1(pool, 24);
+		PoolUser user2(pool, 24);
+		PoolUser user3(pool, 2000);
+		PoolUser user4(pool, 2000);
+		Thread t1;
+		Thread t2;
+		Thread t3;
+		Thread t4;
+		t1.start(user1);
+		t2.start(user2);
+		t3.start(user3);
+		t4.start(user4);
+		t1.join();
+		t2.join();
+		t3.join();
+		t4.join();
+		assert (user1.ok());
+		assert (user2.ok());
+		assert (user3.ok());
+		assert (user4.ok());
+	}
+
+	// the caches of t1 - t4 have been returned to the depot
+	int allocated = pool.allocated();
+	PoolUser user5(pool, 24);
+	Thread t5;
+	t5.start(user5);
+	t5.join();
+	assert (user5.ok());
+	assert (pool.allocated() == allocated);
+}
+
+
+void SizeClassPoolTest::testTrim()
+{
+	SizeClassPool pool;
+	std::vector<void*> blocks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		blocks.push_back(pool.allocate(100));
+	}
+	int allocated = pool.allocated();
+	assert (allocated >= 1000);
+
+	pool.trim();
+	assert (pool.allocated() == allocated);
+
+	for (std::size_t i = 0; i < blocks.size(); i += 2)
+	{
+		pool.deallocate(blocks[i], 100);
+	}
+	pool.flush();
+	pool.trim();
+	assert (pool.allocated() == allocated);
+
+	for (std::size_t i = 1; i < blocks.size(); i += 2)
+	{
+		pool.deallocate(blocks[i], 100);
+	}
+	pool.flush();
+	pool.trim();
+	assert (pool.allocated() == 0);
+
+	void* p = pool.allocate(100);
+	assert (pool.allocated() == 64);
+	pool.deallocate(p, 100);
+}
+
+
+void SizeClassPoolTest::testAllocator()
+{
+	std::list<int, SizeClassAllocator<int> > l;
+	for (int i = 0; i < 1000; ++i) l.push_back(i);
+	int sum = 0;
+	for (std::list<int, SizeClassAllocator<int> >::const_iterator it = l.begin(); it != l.end(); ++it) sum += *it;
+	assert (sum == 499500);
+
+	typedef std::map<int, std::string, std::less<int>, SizeClassAllocator<std::pair<const int, std::string> > > Map;
+	Map m;
+	m[1] = "one";
+	m[2] = "two";
+	assert (m.size() == 2);
+	assert (m[2] == "two");
+
+	std::vector<char, SizeClassAllocator<char> > v(100000, 'x');
+	assert (v[99999] == 'x');
+
+	assert (SizeClassAllocator<int>() == SizeClassAllocator<char>());
+}
+
+
+void SizeClassPoolTest::testBufferAllocator()
+{
+	char* p = SizeClassBufferAllocator<char>::allocate(1024);
+	std::memset(p, 0, 1024);
+	SizeClassBufferAllocator<char>::deallocate(p, 1024);
+	char* q = SizeClassBufferAllocator<char>::allocate(1024);
+	SizeClassBufferAllocator<char>::deallocate(q, 1024);
+}
+
+
+void SizeClassPoolTest::setUp()
+{
+}
+
+
+void SizeClassPoolTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SizeClassPoolTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SizeClassPoolTest");
+
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testBlockSize);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testAllocate);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testLarge);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testThreads);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testTrim);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testAllocator);
+	CppUnit_addTest(pSuite, SizeClassPoolTest, testBufferAllocator);
+
+	return pSuite;
+}
@@ -0,0 +1,46 @@
+//
+// SizeClassPoolTest.h
+//
+// $Id$
+//
+// Definition of the SizeClassPoolTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef SizeClassPoolTest_INCLUDED
+#define SizeClassPoolTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class SizeClassPoolTest: public CppUnit::TestCase
+{
+public:
+	SizeClassPoolTest(const std::string& name);
+	~SizeClassPoolTest();
+
+	void testBlockSize();
+	void testAllocate();
+	void testLarge();
+	void testThreads();
+	void testTrim();
+	void testAllocator();
+	void testBufferAllocator();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // SizeClassPoolTest_INCLUDED
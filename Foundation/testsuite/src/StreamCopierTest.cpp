@@ -14,10 +14,15 @@
 #include "Poco/CppUnit/TestCaller.h"
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
 #include <sstream>
 
 
 using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
 
 
 StreamCopierTest::StreamCopierTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -162,6 +167,36 @@ void StreamCopierTest::testCopyToString64()
 #endif
 
 
+void StreamCopierTest::testFileCopy()
+{
+	std::string src;
+	for (int i = 0; i < 100000; ++i) src += char(i % 251);
+	TemporaryFile srcFile;
+	TemporaryFile destFile;
+	{
+		FileOutputStream ostr(srcFile.path());
+		ostr << src;
+	}
+
+	FileInputStream istr(srcFile.path());
+	char head[10];
+	istr.read(head, sizeof(head));
+	FileOutputStream ostr(destFile.path());
+	ostr << "head";
+	std::streamsize n = StreamCopier::copyStream(istr, ostr);
+	assert (n == static_cast<std::streamsize>(src.size() - sizeof(head)));
+	assert (istr.eof());
+	assert (ostr.tellp() == std::streampos(n + 4));
+	ostr << "tail";
+	ostr.close();
+
+	FileInputStream istr2(destFile.path());
+	std::string dest;
+	StreamCopier::copyToString(istr2, dest);
+	assert (dest == "head" + src.substr(sizeof(head)) + "tail");
+}
+
+
 void StreamCopierTest::setUp()
 {
 }
@@ -185,6 +220,7 @@ CppUnit::Test* StreamCopierTest::suite()
 	CppUnit_addTest(pSuite, StreamCopierTest, testUnbufferedCopy64);
 	CppUnit_addTest(pSuite, StreamCopierTest, testCopyToString64);
 #endif
+	CppUnit_addTest(pSuite, StreamCopierTest, testFileCopy);
 
 	return pSuite;
 }
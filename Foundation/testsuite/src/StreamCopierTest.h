@@ -34,6 +34,7 @@ public:
 	void testUnbufferedCopy64();
 	void testCopyToString64();
 #endif
+	void testFileCopy();
 
 	void setUp();
 	void tearDown();
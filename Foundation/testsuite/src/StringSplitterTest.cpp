@@ -0,0 +1,219 @@
+//
+// StringSplitterTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "StringSplitterTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/StringSplitter.h"
+#include "Poco/StringTokenizer.h"
+#include <vector>
+
+
+using Poco::StringSplitter;
+using Poco::StringTokenizer;
+using Poco::StringView;
+
+
+namespace
+{
+	std::vector<std::string> split(StringSplitter& splitter)
+	{
+		std::vector<std::string> result;
+		StringView token;
+		while (splitter.next(token))
+		{
+			result.push_back(token.toString());
+		}
+		return result;
+	}
+
+
+	std::vector<std::string> split(const std::string& str, char separator, int options = 0)
+	{
+		StringSplitter splitter(str, separator, options);
+		return split(splitter);
+	}
+
+
+	std::vector<std::string> split(const std::string& str, const std::string& separators, int options = 0)
+	{
+		StringSplitter splitter(str, separators, options);
+		return split(splitter);
+	}
+
+
+	std::string join(const std::vector<std::string>& tokens)
+	{
+		std::string result;
+		for (std::vector<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it)
+		{
+			result += '[';
+			result += *it;
+			result += ']';
+		}
+		return result;
+	}
+}
+
+
+StringSplitterTest::StringSplitterTest(const std::string& rName): CppUnit::TestCase(rName)
+{
+}
+
+
+StringSplitterTest::~StringSplitterTest()
+{
+}
+
+
+void StringSplitterTest::testStringView()
+{
+	std::string str("  Hello, world!  ");
+	StringView view(str);
+	assert (view.size() == str.size());
+	assert (view.data() == str.data());
+	assert (view.toString() == str);
+
+	StringView trimmed = view.trimmed();
+	assert (trimmed == "Hello, world!");
+	assert (trimmed.data() == str.data() + 2);
+	assert (trimmed.find(',') == 5);
+	assert (trimmed.find('x') == StringView::NPOS);
+	assert (trimmed.find("world") == 7);
+	assert (trimmed.find("worlds") == StringView::NPOS);
+	assert (trimmed.find("o", 5) == 8);
+	assert (trimmed.substr(7) == "world!");
+	assert (trimmed.substr(7, 5) == "world");
+	assert (trimmed.substr(7, 100) == "world!");
+
+	assert (StringView().empty());
+	assert (StringView("   ").trimmed().empty());
+	assert (StringView("abc") == std::string("abc"));
+	assert (StringView("abc") != "abd");
+	assert (StringView("abc") < "abd");
+	assert (StringView("ab") < "abc");
+	assert (StringView("abc").compare("abc") == 0);
+	assert (StringView("Content-Type").icompare("content-type") == 0);
+	assert (StringView("Content-Type").icompare("content-typf") < 0);
+
+	std::string s("xyz");
+	StringView("abc").assignTo(s);
+	assert (s == "abc");
+	StringView("def").appendTo(s);
+	assert (s == "abcdef");
+}
+
+
+void StringSplitterTest::testSplitChar()
+{
+	assert (join(split("", ',')) == "");
+	assert (join(split("abc", ',')) == "[abc]");
+	assert (join(split("a,b,c", ',')) == "[a][b][c]");
+	assert (join(split(",a,,b,", ',')) == "[][a][][b][]");
+	assert (join(split(",a,,b,", ',', StringSplitter::TOK_IGNORE_EMPTY)) == "[a][b]");
+	assert (join(split(" a , b ,  ", ',', StringSplitter::TOK_TRIM)) == "[a][b][]");
+	assert (join(split(" a , b ,  ", ',', StringSplitter::TOK_TRIM | StringSplitter::TOK_IGNORE_EMPTY)) == "[a][b]");
+
+	std::string str("key=value");
+	StringSplitter splitter(str, '=');
+	StringView token;
+	assert (splitter.next(token));
+	assert (token == "key");
+	assert (token.data() == str.data());
+	assert (splitter.rest() == "value");
+	assert (splitter.next(token));
+	assert (token == "value");
+	assert (splitter.rest().empty());
+	assert (!splitter.next(token));
+	assert (!splitter.next(token));
+}
+
+
+void StringSplitterTest::testSplitSet()
+{
+	assert (join(split("a,b;c", ",;")) == "[a][b][c]");
+	assert (join(split("a, b; c", ",; ")) == "[a][][b][][c]");
+	assert (join(split("a, b; c", ",; ", StringSplitter::TOK_IGNORE_EMPTY)) == "[a][b][c]");
+	assert (join(split("a,b", ",")) == "[a][b]");
+	assert (join(split("a\xE4" "b", "\xE4")) == "[a][b]");
+	assert (join(split("a,b", "")) == "[a,b]");
+}
+
+
+void StringSplitterTest::testSplitString()
+{
+	const int s = StringSplitter::TOK_STRING;
+	assert (join(split("a\r\nb\r\n\r\nc", "\r\n", s)) == "[a][b][][c]");
+	assert (join(split("a\r\nb\r\n\r\nc", "\r\n", s | StringSplitter::TOK_IGNORE_EMPTY)) == "[a][b][c]");
+	assert (join(split("a--b---c", "--", s)) == "[a][b][-c]");
+	assert (join(split("a--", "--", s)) == "[a][]");
+	assert (join(split("a-", "--", s)) == "[a-]");
+	assert (join(split("a, b", ", ", s)) == "[a][b]");
+	assert (join(split("a,b", "", s)) == "[a,b]");
+}
+
+
+void StringSplitterTest::testSplitQuoted()
+{
+	const int q = StringSplitter::TOK_QUOTES;
+	assert (join(split("a,\"b,c\",d", ',', q)) == "[a][\"b,c\"][d]");
+	assert (join(split("a\\,b,c", ',', q)) == "[a\\,b][c]");
+	assert (join(split("\"a\\\",b\",c", ',', q)) == "[\"a\\\",b\"][c]");
+	assert (join(split("\"a,b", ',', q)) == "[\"a,b]");
+	assert (join(split("a;\"b;c\";d", "; ", q)) == "[a][\"b;c\"][d]");
+	assert (join(split("a--\"b--c\"--d", "--", q | StringSplitter::TOK_STRING)) == "[a][\"b--c\"][d]");
+	assert (join(split(" a , \" b \" ", ',', q | StringSplitter::TOK_TRIM)) == "[a][\" b \"]");
+}
+
+
+void StringSplitterTest::testTokenizerCompat()
+{
+	const char* strings[] = { "", ",", ",,", "a", " a ", "a,b", ",a,", " , a ,, b , ", "a,b,", "a, b ,c ,", " ", ", ,", "ab;cd, ef;;g" };
+	const char* separators[] = { ",", ",;", ", " };
+	for (std::size_t i = 0; i < sizeof(strings)/sizeof(strings[0]); ++i)
+	{
+		for (std::size_t j = 0; j < sizeof(separators)/sizeof(separators[0]); ++j)
+		{
+			for (int options = 0; options < 4; ++options)
+			{
+				StringTokenizer tokenizer(strings[i], separators[j], options);
+				std::vector<std::string> tokens(tokenizer.begin(), tokenizer.end());
+				assert (split(strings[i], separators[j], options) == tokens);
+			}
+		}
+	}
+}
+
+
+void StringSplitterTest::setUp()
+{
+}
+
+
+void StringSplitterTest::tearDown()
+{
+}
+
+
+CppUnit::Test* StringSplitterTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("StringSplitterTest");
+
+	CppUnit_addTest(pSuite, StringSplitterTest, testStringView);
+	CppUnit_addTest(pSuite, StringSplitterTest, testSplitChar);
+	CppUnit_addTest(pSuite, StringSplitterTest, testSplitSet);
+	CppUnit_addTest(pSuite, StringSplitterTest, testSplitString);
+	CppUnit_addTest(pSuite, StringSplitterTest, testSplitQuoted);
+	CppUnit_addTest(pSuite, StringSplitterTest, testTokenizerCompat);
+
+	return pSuite;
+}
@@ -0,0 +1,45 @@
+//
+// StringSplitterTest.h
+//
+// $Id$
+//
+// Definition of the StringSplitterTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef StringSplitterTest_INCLUDED
+#define StringSplitterTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class StringSplitterTest: public CppUnit::TestCase
+{
+public:
+	StringSplitterTest(const std::string& name);
+	~StringSplitterTest();
+
+	void testStringView();
+	void testSplitChar();
+	void testSplitSet();
+	void testSplitString();
+	void testSplitQuoted();
+	void testTokenizerCompat();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // StringSplitterTest_INCLUDED
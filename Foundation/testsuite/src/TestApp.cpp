@@ -59,6 +59,16 @@ int main(int argc, char** argv)
 				std::cout << argv[i] << std::endl;
 			}
 		}
+		else if (arg == "-out-err" && argc > 2)
+		{
+			int n = std::atoi(argv[2]);
+			for (int i = 0; i < n; ++i)
+			{
+				std::cout << "out " << i << std::endl;
+				std::cerr << "err " << i << std::endl;
+			}
+			return 0;
+		}
 	}
 	return argc - 1;
 }
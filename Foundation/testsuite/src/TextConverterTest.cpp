@@ -22,6 +22,7 @@
 #include "Poco/Windows1251Encoding.h"
 #include "Poco/Windows1252Encoding.h"
 #include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
 
 
 using namespace Poco;
@@ -328,6 +329,51 @@ void TextConverterTest::testErrors()
 }
 
 
+void TextConverterTest::testUTF8toUTF16()
+{
+	UTF8Encoding utf8Encoding;
+	UTF16Encoding utf16Encoding(UTF16Encoding::BIG_ENDIAN_BYTE_ORDER);
+	TextConverter converter(utf8Encoding, utf16Encoding);
+
+	// long enough to be converted in several blocks,
+	// with multi-byte characters at the block boundaries
+	std::string utf8;
+	std::string utf16;
+	for (int i = 0; i < 3000; ++i)
+	{
+		utf8 += "a\342\202\254";
+		utf16.append("\0a\x20\xAC", 4);
+	}
+	std::string result;
+	int errors = converter.convert(utf8, result);
+	assert (errors == 0);
+	assert (result == utf16);
+
+	UTF16Encoding nativeEncoding;
+	TextConverter nativeConverter(utf8Encoding, nativeEncoding);
+	TextConverter reverseConverter(nativeEncoding, utf8Encoding);
+	std::string native;
+	nativeConverter.convert(utf8, native);
+	assert (native.size() == utf16.size());
+	result.clear();
+	errors = reverseConverter.convert(native, result);
+	assert (errors == 0);
+	assert (result == utf8);
+	result.clear();
+	errors = reverseConverter.convert(native.data(), (int) native.size(), result);
+	assert (errors == 0);
+	assert (result == utf8);
+
+	// invalid characters in the middle of the text
+	utf8[5000] = '\xFF';
+	result.clear();
+	errors = converter.convert(utf8, result);
+	assert (errors == 1);
+	assert (result.size() == utf16.size());
+	assert (result.compare(5000, 2, std::string("\0?", 2)) == 0);
+}
+
+
 void TextConverterTest::setUp()
 {
 }
@@ -352,6 +398,7 @@ CppUnit::Test* TextConverterTest::suite()
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1251toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1252toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testErrors);
+	CppUnit_addTest(pSuite, TextConverterTest, testUTF8toUTF16);
 
 	return pSuite;
 }
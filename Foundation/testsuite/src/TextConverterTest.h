@@ -36,6 +36,7 @@ public:
 	void testCP1251toUTF8();
 	void testCP1252toUTF8();
 	void testErrors();
+	void testUTF8toUTF16();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,44 @@
+//
+// URIViewTest.h
+//
+// $Id$
+//
+// Definition of the URIViewTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef URIViewTest_INCLUDED
+#define URIViewTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/CppUnit/TestCase.h"
+
+
+class URIViewTest: public CppUnit::TestCase
+{
+public:
+	URIViewTest(const std::string& name);
+	~URIViewTest();
+
+	void testParse();
+	void testDecode();
+	void testEncode();
+	void testQueryParameters();
+	void testURICompat();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // URIViewTest_INCLUDED
@@ -17,6 +17,7 @@
 
 
 using Poco::UTF8;
+using Poco::UInt16;
 
 
 UTF8StringTest::UTF8StringTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -85,6 +86,76 @@ void UTF8StringTest::testTransform()
 }
 
 
+void UTF8StringTest::testValidate()
+{
+	assert (UTF8::validate("", 0) == 0);
+	assert (UTF8::isValid("abc"));
+	assert (UTF8::isValid("\303\274\342\202\254\360\237\230\200")); // u-umlaut, euro, emoji
+	assert (!UTF8::isValid("\xC0\x80"));             // overlong
+	assert (!UTF8::isValid("\xE0\x9F\xBF"));         // overlong
+	assert (!UTF8::isValid("\xED\xA0\x80"));         // surrogate
+	assert (!UTF8::isValid("\xF4\x90\x80\x80"));     // above U+10FFFF
+	assert (!UTF8::isValid("\xE2\x82"));             // truncated
+
+	std::string str(1000, 'a');
+	str += "\303\274";
+	str += std::string(100, 'b');
+	assert (UTF8::validate(str.data(), str.size()) == str.size());
+	str[500] = '\xFF';
+	assert (UTF8::validate(str.data(), str.size()) == 500);
+	assert (UTF8::validate(str.data(), 1001) == 500);
+	str[500] = 'a';
+	assert (UTF8::validate(str.data(), 1001) == 1000);
+}
+
+
+void UTF8StringTest::testUTF16()
+{
+	std::string str("ab\303\274\342\202\254\360\237\230\200");
+	str += std::string(100, 'c');
+	UInt16 utf16[200];
+	std::size_t utf16Length = 0;
+	assert (UTF8::toUTF16(str.data(), str.size(), utf16, utf16Length) == str.size());
+	assert (utf16Length == 106);
+	assert (utf16[0] == 'a' && utf16[1] == 'b' && utf16[2] == 0xFC && utf16[3] == 0x20AC);
+	assert (utf16[4] == 0xD83D && utf16[5] == 0xDE00 && utf16[105] == 'c');
+
+	char bytes[600];
+	std::size_t bytesLength = 0;
+	assert (UTF8::fromUTF16(utf16, utf16Length, bytes, bytesLength) == utf16Length);
+	assert (std::string(bytes, bytesLength) == str);
+
+	// stops at an unpaired surrogate
+	utf16[5] = 'x';
+	assert (UTF8::fromUTF16(utf16, utf16Length, bytes, bytesLength) == 4);
+	assert (bytesLength == 7);
+
+	str.insert(4, "\xFF");
+	assert (UTF8::toUTF16(str.data(), str.size(), utf16, utf16Length) == 4);
+	assert (utf16Length == 3);
+}
+
+
+void UTF8StringTest::testLatin1()
+{
+	std::string latin1("abc\xE4\xF6\xFC\xA0");
+	latin1 += std::string(50, 'd');
+	char bytes[200];
+	std::size_t bytesLength = UTF8::fromLatin1(latin1.data(), latin1.size(), bytes);
+	assert (std::string(bytes, bytesLength) == "abc\303\244\303\266\303\274\302\240" + std::string(50, 'd'));
+
+	char result[200];
+	std::size_t resultLength = 0;
+	assert (UTF8::toLatin1(bytes, bytesLength, result, resultLength) == bytesLength);
+	assert (std::string(result, resultLength) == latin1);
+
+	// stops at characters that are not in Latin-1
+	std::string str("ab\342\202\254");
+	assert (UTF8::toLatin1(str.data(), str.size(), result, resultLength) == 2);
+	assert (resultLength == 2);
+}
+
+
 void UTF8StringTest::setUp()
 {
 }
@@ -101,6 +172,9 @@ CppUnit::Test* UTF8StringTest::suite()
 
 	CppUnit_addTest(pSuite, UTF8StringTest, testCompare);
 	CppUnit_addTest(pSuite, UTF8StringTest, testTransform);
+	CppUnit_addTest(pSuite, UTF8StringTest, testValidate);
+	CppUnit_addTest(pSuite, UTF8StringTest, testUTF16);
+	CppUnit_addTest(pSuite, UTF8StringTest, testLatin1);
 
 	return pSuite;
 }
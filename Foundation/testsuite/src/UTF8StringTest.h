@@ -28,6 +28,9 @@ public:
 
 	void testCompare();
 	void testTransform();
+	void testValidate();
+	void testUTF16();
+	void testLatin1();
 
 	void setUp();
 	void tearDown();
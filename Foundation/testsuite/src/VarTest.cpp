@@ -2588,6 +2588,103 @@ void VarTest::testIterator()
 }
 
 
+void VarTest::testSwap()
+{
+	std::string longString(100, 'x');
+	Var v1(longString);
+	Var v2(42);
+	Var v3;
+
+	// the string is moved, not copied
+	const char* pData = v1.extract<std::string>().data();
+	v1.swap(v2);
+	assert (v1 == 42);
+	assert (v2 == longString);
+	assert (v2.extract<std::string>().data() == pData);
+
+	v2.swap(v3);
+	assert (v2.isEmpty());
+	assert (v3.extract<std::string>().data() == pData);
+	v2.swap(v3);
+	assert (v3.isEmpty());
+	assert (v2 == longString);
+
+	// values too large to be stored in place are swapped by pointer
+	DynamicStruct ds;
+	ds["a"] = 1;
+	Var v4(ds);
+	Var v5("short");
+	const DynamicStruct* pStruct = &v4.extract<DynamicStruct>();
+	v4.swap(v5);
+	assert (v4 == "short");
+	assert (&v5.extract<DynamicStruct>() == pStruct);
+	assert (v5["a"] == 1);
+	v4.swap(v5);
+	assert (&v4.extract<DynamicStruct>() == pStruct);
+	assert (v5 == "short");
+
+	std::vector<Var> vec;
+	vec.push_back(1);
+	vec.push_back("two");
+	Var v6(vec);
+	Var v7(3.5);
+	v6.swap(v7);
+	assert (v6 == 3.5);
+	assert (v7.size() == 2);
+	assert (v7[0] == 1);
+	assert (v7[1] == "two");
+
+	v7.swap(v7);
+	assert (v7.size() == 2);
+
+	// strings are stored in place
+	Var v8(std::string("in place"));
+	const char* pHolder = reinterpret_cast<const char*>(&v8.extract<std::string>());
+	assert (pHolder >= reinterpret_cast<const char*>(&v8));
+	assert (pHolder < reinterpret_cast<const char*>(&v8) + sizeof(Var));
+}
+
+
+void VarTest::testAssign()
+{
+	Var v1("a string too long to be stored in place by std::string");
+	Var v2(1);
+	Var v3;
+
+	v2 = v1;
+	assert (v2 == v1);
+	assert (v2.extract<std::string>().data() != v1.extract<std::string>().data());
+	v1 = 2;
+	assert (v1 == 2);
+	assert (v2 == "a string too long to be stored in place by std::string");
+
+	DynamicStruct ds;
+	ds["a"] = 1;
+	v1 = ds;
+	assert (v1.isStruct());
+	v2 = v1;
+	assert (v2["a"] == 1);
+	v1 = 'c';
+	assert (v1 == 'c');
+	v2 = v3;
+	assert (v2.isEmpty());
+	v1 = v1;
+	assert (v1 == 'c');
+
+	std::vector<Var> vec(1000, Var("some text"));
+	std::vector<Var> copy(vec);
+	vec.clear();
+	assert (copy.size() == 1000);
+	assert (copy[999] == "some text");
+	vec.swap(copy);
+	for (std::vector<Var>::iterator it = vec.begin(); it != vec.end(); ++it)
+	{
+		*it = Var(1.5);
+	}
+	assert (vec[500] == 1.5);
+}
+
+
 void VarTest::setUp()
 {
 }
@@ -2645,6 +2742,8 @@ CppUnit::Test* VarTest::suite()
 	CppUnit_addTest(pSuite, VarTest, testDate);
 	CppUnit_addTest(pSuite, VarTest, testEmpty);
 	CppUnit_addTest(pSuite, VarTest, testIterator);
+	CppUnit_addTest(pSuite, VarTest, testSwap);
+	CppUnit_addTest(pSuite, VarTest, testAssign);
 
 	return pSuite;
 }
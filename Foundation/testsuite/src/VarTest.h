@@ -71,6 +71,8 @@ public:
 	void testDate();
 	void testEmpty();
 	void testIterator();
+	void testSwap();
+	void testAssign();
 
 
 	void setUp();
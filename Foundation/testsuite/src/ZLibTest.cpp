@@ -15,6 +15,7 @@
 #include "Poco/CppUnit/TestSuite.h"
 #include "Poco/InflatingStream.h"
 #include "Poco/DeflatingStream.h"
+#include "Poco/ParallelDeflatingStream.h"
 #include "Poco/MemoryStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/Buffer.h"
@@ -25,9 +26,11 @@ using Poco::InflatingInputStream;
 using Poco::InflatingOutputStream;
 using Poco::DeflatingOutputStream;
 using Poco::DeflatingInputStream;
+using Poco::ParallelDeflatingOutputStream;
 using Poco::InflatingStreamBuf;
 using Poco::DeflatingStreamBuf;
 using Poco::StreamCopier;
+using Poco::Buffer;
 
 
 ZLibTest::ZLibTest(const std::string& rName): CppUnit::TestCase(rName)
@@ -177,6 +180,160 @@ void ZLibTest::testGzip3()
 }
 
 
+namespace
+{
+	std::string testData(std::size_t size)
+	{
+		// compressible, but with matches that reach back across block boundaries
+		std::string data;
+		data.reserve(size);
+		unsigned n = 1;
+		while (data.size() < size)
+		{
+			n = n*1103515245 + 12345;
+			data += "line ";
+			data += static_cast<char>('a' + (n >> 16) % 26);
+			data += " of the parallel deflate test data\n";
+		}
+		data.resize(size);
+		return data;
+	}
+}
+
+
+void ZLibTest::testParallelDeflate()
+{
+	std::string data = testData(300000);
+	std::stringstream buffer;
+	ParallelDeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_ZLIB, Z_DEFAULT_COMPRESSION, 4, 10000);
+	deflater.write(data.data(), 150000);
+	deflater.flush();
+	deflater.write(data.data() + 150000, 150000);
+	deflater.close();
+	std::string compressed = buffer.str();
+
+	InflatingInputStream inflater(buffer, InflatingStreamBuf::STREAM_ZLIB);
+	std::string data2;
+	StreamCopier::copyToString(inflater, data2);
+	assert (data2 == data);
+	assert (!inflater.bad());
+
+	// with the preceding data as the dictionary, the compressed data
+	// should not be much larger than the one compressed in one piece
+	std::stringstream buffer2;
+	DeflatingOutputStream deflater2(buffer2, DeflatingStreamBuf::STREAM_ZLIB);
+	deflater2.write(data.data(), data.size());
+	deflater2.close();
+	assert (compressed.size() < buffer2.str().size()*11/10);
+
+	std::stringstream buffer3;
+	ParallelDeflatingOutputStream deflater3(buffer3);
+	deflater3.close();
+	InflatingInputStream inflater3(buffer3, InflatingStreamBuf::STREAM_ZLIB);
+	std::string data3;
+	StreamCopier::copyToString(inflater3, data3);
+	assert (data3.empty());
+}
+
+
+void ZLibTest::testParallelGzip()
+{
+	std::string data = testData(500000);
+	for (int threads = 1; threads <= 8; threads *= 2)
+	{
+		std::stringstream buffer;
+		ParallelDeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_GZIP, Z_BEST_SPEED, threads, 65536);
+		deflater << data;
+		deflater.close();
+
+		// the inflater checks the combined CRC-32 and length
+		InflatingInputStream inflater(buffer, InflatingStreamBuf::STREAM_GZIP);
+		std::string data2;
+		StreamCopier::copyToString(inflater, data2);
+		assert (data2 == data);
+		assert (!inflater.bad());
+	}
+}
+
+
+void ZLibTest::testInflateBuffer()
+{
+	std::string data = testData(200000);
+	std::stringstream buffer;
+	DeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_ZLIB);
+	deflater << data;
+	deflater.close();
+	std::string compressed = buffer.str();
+
+	Buffer<char> result(0);
+	result.append("abc", 3);
+	std::size_t n = InflatingStreamBuf::inflate(compressed.data(), compressed.size(), result);
+	assert (n == data.size());
+	assert (result.size() == data.size() + 3);
+	assert (std::string(result.begin(), 3) == "abc");
+	assert (std::string(result.begin() + 3, data.size()) == data);
+
+	try
+	{
+		InflatingStreamBuf::inflate(compressed.data(), compressed.size() - 10, result);
+		fail("truncated data - must throw");
+	}
+	catch (Poco::IOException&)
+	{
+	}
+	assert (result.size() == data.size() + 3);
+
+	std::stringstream buffer2;
+	DeflatingOutputStream deflater2(buffer2, DeflatingStreamBuf::STREAM_GZIP);
+	deflater2 << data;
+	deflater2.close();
+	compressed = buffer2.str();
+
+	Buffer<char> result2(0);
+	n = InflatingStreamBuf::inflate(compressed.data(), compressed.size(), result2, InflatingStreamBuf::STREAM_GZIP);
+	assert (n == data.size());
+	assert (std::string(result2.begin(), result2.size()) == data);
+
+	// auto-detection of the header with 15 + 32 window bits
+	Buffer<char> result3(0);
+	n = InflatingStreamBuf::inflate(compressed.data(), compressed.size(), result3, 15 + 32);
+	assert (std::string(result3.begin(), result3.size()) == data);
+}
+
+
+void ZLibTest::testLargeBuffers()
+{
+	std::string data = testData(1000000);
+	std::stringstream buffer;
+	DeflatingOutputStream deflater(buffer, DeflatingStreamBuf::STREAM_GZIP);
+	deflater << data;
+	deflater.close();
+	std::string compressed = buffer.str();
+
+	// large reads go directly into the caller's buffer
+	InflatingInputStream inflater(buffer, InflatingStreamBuf::STREAM_GZIP, 256*1024);
+	std::string data2;
+	Buffer<char> chunk(100000);
+	char c;
+	inflater.get(c);
+	data2 += c;
+	while (inflater.read(chunk.begin(), chunk.size()) || inflater.gcount() > 0)
+	{
+		data2.append(chunk.begin(), static_cast<std::size_t>(inflater.gcount()));
+	}
+	assert (data2 == data);
+	assert (!inflater.bad());
+
+	// large writes bypass the stream buffer
+	std::stringstream buffer2;
+	InflatingOutputStream inflater2(buffer2, InflatingStreamBuf::STREAM_GZIP, 256*1024);
+	inflater2.write(compressed.data(), 10);
+	inflater2.write(compressed.data() + 10, compressed.size() - 10);
+	inflater2.close();
+	assert (buffer2.str() == data);
+}
+
+
 void ZLibTest::setUp()
 {
 }
@@ -198,6 +355,10 @@ CppUnit::Test* ZLibTest::suite()
 	CppUnit_addTest(pSuite, ZLibTest, testGzip1);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip2);
 	CppUnit_addTest(pSuite, ZLibTest, testGzip3);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelDeflate);
+	CppUnit_addTest(pSuite, ZLibTest, testParallelGzip);
+	CppUnit_addTest(pSuite, ZLibTest, testInflateBuffer);
+	CppUnit_addTest(pSuite, ZLibTest, testLargeBuffers);
 
 	return pSuite;
 }
@@ -33,6 +33,10 @@ public:
 	void testGzip1();
 	void testGzip2();
 	void testGzip3();
+	void testParallelDeflate();
+	void testParallelGzip();
+	void testInflateBuffer();
+	void testLargeBuffers();
 
 	void setUp();
 	void tearDown();
@@ -22,6 +22,7 @@
 
 #include "Poco/JSON/JSON.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/Arena.h"
 #include "Poco/Dynamic/Var.h"
 #include <vector>
 #include <sstream>
@@ -34,7 +35,7 @@ namespace JSON {
 class Object;
 
 
-class JSON_API Array
+class JSON_API Array: public Poco::ArenaObject
 	/// Represents a JSON array. JSON array provides a representation
 	/// based on shared pointers and optimized for performance. It is possible to 
 	/// convert object to Poco::Dynamic::Array. Conversion requires copying and therefore
@@ -58,6 +59,7 @@ class JSON_API Array
 	///    i = da[1]["test1"][1]; // i == 2
 	///    i = da[1]["test2"];    // i == 4
 	/// 
+	/// An Array can be placed in a Poco::Arena (see ParseHandler).
 {
 public:
 	typedef std::vector<Dynamic::Var>                 ValueVec;
@@ -24,6 +24,7 @@
 #include "Poco/JSON/Array.h"
 #include "Poco/JSON/Stringifier.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/Arena.h"
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/Nullable.h"
@@ -38,7 +39,7 @@ namespace Poco {
 namespace JSON {
 
 
-class JSON_API Object
+class JSON_API Object: public Poco::ArenaObject
 	/// Represents a JSON object. JSON object provides a representation
 	/// based on shared pointers and optimized for performance. It is possible to 
 	/// convert object to DynamicStruct. Conversion requires copying and therefore
@@ -59,6 +60,7 @@ class JSON_API Object
 	///    Poco::DynamicStruct ds = *object;
 	///    val = ds["test"]["property"]; // val holds "value"
 	/// 
+	/// An Object can be placed in a Poco::Arena (see ParseHandler).
 {
 public:
 	typedef SharedPtr<Object>                   Ptr;
@@ -21,6 +21,7 @@
 
 
 #include "Poco/JSON/Handler.h"
+#include "Poco/Arena.h"
 #include <stack>
 
 
@@ -32,9 +33,24 @@ class JSON_API ParseHandler : public Handler
 	/// Provides a default handler for the JSON parser.
 	/// This handler will build up an object or array based
 	/// on the handlers called by the parser.
+	///
+	/// If an Arena is given, all Object and Array instances
+	/// are allocated from the Arena, which avoids a general
+	/// purpose heap allocation for every container in the
+	/// document. The Arena must outlive the parse result
+	/// and all copies of the contained Object::Ptr and
+	/// Array::Ptr instances.
+	///
+	/// Note that only the Object and Array instances themselves
+	/// are placed in the Arena. Their member maps and vectors,
+	/// keys, string values and Var holders are still allocated
+	/// from the heap, and every Object and Array is still
+	/// destroyed through its SharedPtr, which frees this memory.
+	/// Resetting the Arena therefore does not release a whole
+	/// document at once; it only saves the container allocations.
 {
 public:
-	ParseHandler(bool preserveObjectOrder = false);
+	ParseHandler(bool preserveObjectOrder = false, Poco::Arena* pArena = 0);
 		/// Creates the ParseHandler.
 
 	virtual ~ParseHandler();
@@ -61,6 +77,14 @@ public:
 	Dynamic::Var asVar() const;
 		/// Returns the result of the parser (an object or an array).
 
+	void setArena(Poco::Arena* pArena);
+		/// Sets the Arena used for allocating Object and Array
+		/// instances. Specify a null pointer to use the heap.
+
+	Poco::Arena* getArena() const;
+		/// Returns the Arena used for allocating Object and
+		/// Array instances, or null if none has been set.
+
 	virtual void value(int v);
 		/// An integer value is read
 
@@ -97,6 +121,7 @@ private:
 	std::string  _key;
 	Dynamic::Var _result;
 	bool         _preserveObjectOrder;
+	Poco::Arena* _pArena;
 };
 
 
@@ -106,6 +131,18 @@ inline Dynamic::Var ParseHandler::asVar() const
 }
 
 
+inline void ParseHandler::setArena(Poco::Arena* pArena)
+{
+	_pArena = pArena;
+}
+
+
+inline Poco::Arena* ParseHandler::getArena() const
+{
+	return _pArena;
+}
+
+
 inline void ParseHandler::value(int v)
 {
 	setValue(v);
@@ -234,6 +234,9 @@ public:
 
 	Dynamic::Var parse(std::istream& in);
 		/// Parses a JSON from the input stream.
+		///
+		/// If the stream is a Poco::MappedInputStream, the JSON is
+		/// parsed directly from the memory the file is mapped to.
 
 	void setHandler(const Handler::Ptr& pHandler);
 		/// Set the handler.
@@ -4,6 +4,8 @@
 // $Id$
 //
 // This sample shows a benchmark of the JSON parser.
+// Besides the time, it reports the number of memory
+// allocations needed to parse and handle the document.
 //
 // Copyright (c) 2012, Applied Informatics Software Engineering GmbH.
 // and Contributors.
@@ -23,6 +25,40 @@
 #include "Poco/Stopwatch.h"
 #include <iostream>
 #include <iomanip>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+	std::size_t allocations = 0;
+}
+
+
+// Replacements for the global operator new and delete,
+// to count allocations.
+#if __cplusplus >= 201103L || defined(_MSC_VER)
+	#define THROW_BAD_ALLOC
+	#define THROW_NOTHING noexcept
+#else
+	#define THROW_BAD_ALLOC throw(std::bad_alloc)
+	#define THROW_NOTHING throw()
+#endif
+
+
+void* operator new(std::size_t size) THROW_BAD_ALLOC
+{
+	++allocations;
+	void* p = std::malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+
+void operator delete(void* p) THROW_NOTHING
+{
+	std::free(p);
+}
 
 
 int main(int argc, char** argv)
@@ -79,12 +115,14 @@ int main(int argc, char** argv)
 	try
 	{
 		Poco::JSON::Parser sparser;
+		std::size_t allocationsBefore = allocations;
 		sw.restart();
 		sparser.parse(jsonStr);
 		Poco::DynamicAny result = sparser.result();
 		sw.stop();
 		std::cout << "-----------------------------------------" << std::endl;
 		std::cout << "[std::string] parsed/handled in " << sw.elapsed() << " [us]" << std::endl;
+		std::cout << "with " << allocations - allocationsBefore << " allocations" << std::endl;
 		std::cout << "-----------------------------------------" << std::endl;
 
 		Poco::JSON::Parser isparser;
@@ -25,8 +25,9 @@ namespace Poco {
 namespace JSON {
 
 
-ParseHandler::ParseHandler(bool preserveObjectOrder) : Handler(),
-	_preserveObjectOrder(preserveObjectOrder)
+ParseHandler::ParseHandler(bool preserveObjectOrder, Poco::Arena* pArena) : Handler(),
+	_preserveObjectOrder(preserveObjectOrder),
+	_pArena(pArena)
 {
 }
 
@@ -46,7 +47,7 @@ void ParseHandler::reset()
 
 void ParseHandler::startObject()
 {
-	Object::Ptr newObj = new Object(_preserveObjectOrder);
+	Object::Ptr newObj = new (_pArena) Object(_preserveObjectOrder);
 
 	if ( _stack.empty() ) // The first object
 	{
@@ -82,7 +83,7 @@ void ParseHandler::endObject()
 
 void ParseHandler::startArray()
 {
-	Array::Ptr newArr = new Array();
+	Array::Ptr newArr = new (_pArena) Array();
 
 	if ( _stack.empty() ) // The first array
 	{
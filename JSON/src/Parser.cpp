@@ -20,6 +20,7 @@
 #include "Poco/Token.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/String.h"
+#include "Poco/MappedStream.h"
 #undef min
 #undef max
 #include <limits>
@@ -164,6 +165,25 @@ Dynamic::Var Parser::parse(const std::string& json)
 
 Dynamic::Var Parser::parse(std::istream& in)
 {
+	// a mapped file is parsed directly from memory
+	Poco::MappedStreamBuf* pMappedBuf = dynamic_cast<Poco::MappedStreamBuf*>(in.rdbuf());
+	if (pMappedBuf)
+	{
+		Source<const char*> source(pMappedBuf->current(), pMappedBuf->end());
+
+		int c = 0;
+		while(source.nextChar(c))
+		{
+			if (0 == parseChar(c, source)) throw JSONException("JSON syntax error");
+		}
+		in.seekg(0, std::ios::end);
+
+		if (!done())
+			throw JSONException("JSON syntax error");
+
+		return asVar();
+	}
+
 	std::istreambuf_iterator<char> it(in.rdbuf());
 	std::istreambuf_iterator<char> end;
 	Source<std::istreambuf_iterator<char> > source(it, end);
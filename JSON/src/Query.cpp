@@ -112,8 +112,8 @@ Var Query::find(const std::string& path) const
 			RegularExpression::MatchVec matches;
 			int firstOffset = -1;
 			int offset = 0;
-			RegularExpression regex("\\[([0-9]+)\\]");
-			while(regex.match(*token, offset, matches) > 0)
+			RegularExpression::Ptr pRegex = RegularExpression::cached("\\[([0-9]+)\\]");
+			while(pRegex->match(*token, offset, matches) > 0)
 			{
 				if (firstOffset == -1)
 				{
@@ -25,6 +25,9 @@
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/DateTime.h"
 #include "Poco/DateTimeFormatter.h"
+#include "Poco/Arena.h"
+#include "Poco/MappedStream.h"
+#include "Poco/TemporaryFile.h"
 #include <set>
 #include <iostream>
 
@@ -1845,6 +1848,74 @@ void JSONTest::testEscapeUnicode()
 }
 
 
+void JSONTest::testArena()
+{
+	std::string json = "{ \"a\" : [ 1, 2, { \"b\" : [ 3 ] } ], \"c\" : { \"d\" : \"e\" } }";
+	Poco::Arena arena;
+	{
+		ParseHandler* pHandler = new ParseHandler(false, &arena);
+		assert (pHandler->getArena() == &arena);
+		Parser parser(pHandler);
+		Var result = parser.parse(json);
+		assert (arena.used() > 0);
+
+		Object::Ptr object = result.extract<Object::Ptr>();
+		Poco::JSON::Array::Ptr pArray = object->getArray("a");
+		assert (pArray->size() == 3);
+		assert (pArray->getElement<int>(1) == 2);
+		assert (pArray->getObject(2)->getArray("b")->getElement<int>(0) == 3);
+		assert (object->getObject("c")->getValue<std::string>("d") == "e");
+
+		std::ostringstream ostr;
+		object->stringify(ostr);
+		assert (ostr.str() == "{\"a\":[1,2,{\"b\":[3]}],\"c\":{\"d\":\"e\"}}");
+
+		std::size_t used = arena.used();
+		pHandler->setArena(0);
+		parser.reset();
+		parser.parse(json);
+		assert (arena.used() == used);
+	}
+	arena.reset();
+}
+
+
+void JSONTest::testParseMappedFile()
+{
+	Poco::TemporaryFile file;
+	{
+		Poco::FileOutputStream ostr(file.path());
+		ostr << "{ \"name\" : \"Franz\", \"numbers\" : [ 1, 2, 3 ], \"city\" : \"M\xC3\xBCnchen\" }";
+	}
+
+	Poco::MappedInputStream istr(file.path());
+	Parser parser;
+	Var result = parser.parse(istr);
+	assert (istr.tellg() == std::streampos(Poco::File(file.path()).getSize()));
+
+	Object::Ptr object = result.extract<Object::Ptr>();
+	assert (object->getValue<std::string>("name") == "Franz");
+	assert (object->getArray("numbers")->getElement<int>(2) == 3);
+	assert (object->getValue<std::string>("city") == "M\xC3\xBCnchen");
+
+	Poco::TemporaryFile badFile;
+	{
+		Poco::FileOutputStream ostr(badFile.path());
+		ostr << "{ \"name\" : ";
+	}
+	Poco::MappedInputStream badIstr(badFile.path());
+	parser.reset();
+	try
+	{
+		parser.parse(badIstr);
+		fail("incomplete JSON - must throw");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
 std::string JSONTest::getTestFilesPath(const std::string& type)
 {
 	std::ostringstream ostr;
@@ -1920,6 +1991,8 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testSmallBuffer);
 	CppUnit_addTest(pSuite, JSONTest, testEscape0);
 	CppUnit_addTest(pSuite, JSONTest, testEscapeUnicode);
+	CppUnit_addTest(pSuite, JSONTest, testArena);
+	CppUnit_addTest(pSuite, JSONTest, testParseMappedFile);
 
 	return pSuite;
 }
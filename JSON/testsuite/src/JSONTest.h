@@ -79,6 +79,8 @@ public:
 	void testSmallBuffer();
 	void testEscape0();
 	void testEscapeUnicode();
+	void testArena();
+	void testParseMappedFile();
 	void setUp();
 	void tearDown();
 
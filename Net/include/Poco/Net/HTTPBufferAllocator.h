@@ -21,7 +21,7 @@
 
 
 #include "Poco/Net/Net.h"
-#include "Poco/MemoryPool.h"
+#include "Poco/SizeClassPool.h"
 #include <ios>
 
 
@@ -31,6 +31,10 @@ namespace Net {
 
 class Net_API HTTPBufferAllocator
 	/// A BufferAllocator for HTTP streams.
+	///
+	/// Buffers are obtained from the default SizeClassPool,
+	/// so that allocating and releasing a buffer normally
+	/// does not require any locking.
 {
 public:
 	static char* allocate(std::streamsize size);
@@ -40,9 +44,6 @@ public:
 	{
 		BUFFER_SIZE = 4096
 	};
-
-private:
-	static Poco::MemoryPool _pool;
 };
 
 
@@ -26,6 +26,7 @@
 #include "Poco/CountingStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/URI.h"
+#include "Poco/URIView.h"
 #include "Poco/String.h"
 #include "Poco/CountingStream.h"
 #include "Poco/UTF8String.h"
@@ -36,6 +37,7 @@ using Poco::NullInputStream;
 using Poco::StreamCopier;
 using Poco::SyntaxException;
 using Poco::URI;
+using Poco::URIView;
 using Poco::icompare;
 
 
@@ -136,11 +138,10 @@ void HTMLForm::load(const HTTPRequest& request, std::istream& requestBody, PartH
 {
 	clear();
 
-	URI uri(request.getURI());
-	const std::string& query = uri.getRawQuery();
-	if (!query.empty())
+	URIView uri(request.getURI());
+	if (!uri.getRawQuery().empty())
 	{
-		std::istringstream istr(query);
+		std::istringstream istr(uri.getRawQuery().toString());
 		readUrl(istr);
 	}
 
@@ -17,21 +17,18 @@
 #include "Poco/Net/HTTPBufferAllocator.h"
 
 
-using Poco::MemoryPool;
+using Poco::SizeClassPool;
 
 
 namespace Poco {
 namespace Net {
 
 
-MemoryPool HTTPBufferAllocator::_pool(HTTPBufferAllocator::BUFFER_SIZE, 16);
-
-
 char* HTTPBufferAllocator::allocate(std::streamsize size)
 {
 	poco_assert_dbg (size == BUFFER_SIZE);
 
-	return reinterpret_cast<char*>(_pool.get());
+	return reinterpret_cast<char*>(SizeClassPool::defaultPool().allocate(BUFFER_SIZE));
 }
 
 
@@ -39,7 +36,7 @@ void HTTPBufferAllocator::deallocate(char* ptr, std::streamsize size)
 {
 	poco_assert_dbg (size == BUFFER_SIZE);
 
-	_pool.release(ptr);
+	SizeClassPool::defaultPool().deallocate(ptr, BUFFER_SIZE);
 }
 
 
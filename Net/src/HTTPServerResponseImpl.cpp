@@ -30,6 +30,11 @@
 #include "Poco/FileStream.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTimeFormat.h"
+#if POCO_OS == POCO_OS_LINUX
+#include "Poco/Net/NetException.h"
+#include <sys/sendfile.h>
+#include <errno.h>
+#endif
 
 
 using Poco::File;
@@ -45,6 +50,58 @@ namespace Poco {
 namespace Net {
 
 
+#if POCO_OS == POCO_OS_LINUX
+namespace
+{
+	const Poco::UInt64 MAX_SENDFILE_SIZE = 0x40000000;
+
+	bool sendFileData(StreamSocket& socket, Poco::FileInputStream& istr, Poco::UInt64 length)
+		/// Sends the given number of bytes from the file with sendfile(),
+		/// without copying the data to user space.
+		///
+		/// Returns false if nothing has been sent because sendfile()
+		/// is not supported for the file.
+	{
+		int in = istr.rdbuf()->nativeHandle();
+		Poco::UInt64 sent = 0;
+		while (sent < length)
+		{
+			Poco::UInt64 count = length - sent < MAX_SENDFILE_SIZE ? length - sent : MAX_SENDFILE_SIZE;
+			ssize_t n = ::sendfile(socket.impl()->sockfd(), in, 0, static_cast<std::size_t>(count));
+			if (n > 0)
+			{
+				sent += n;
+			}
+			else if (n == 0)
+			{
+				// the file has been truncated
+				break;
+			}
+			else if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				if (!socket.poll(socket.getSendTimeout(), Socket::SELECT_WRITE))
+					throw Poco::TimeoutException();
+			}
+			else if (errno == EINVAL || errno == ENOSYS)
+			{
+				if (sent == 0) return false;
+				throw NetException("sendfile() failed", errno);
+			}
+			else if (errno == EPIPE || errno == ECONNRESET)
+			{
+				throw ConnectionResetException();
+			}
+			else if (errno != EINTR)
+			{
+				throw NetException("sendfile() failed", errno);
+			}
+		}
+		return true;
+	}
+}
+#endif
+
+
 HTTPServerResponseImpl::HTTPServerResponseImpl(HTTPServerSession& session):
 	_session(session),
 	_pRequest(0),
@@ -130,6 +187,16 @@ void HTTPServerResponseImpl::sendFile(const std::string& path, const std::string
 		write(*_pStream);
 		if (_pRequest && _pRequest->getMethod() != HTTPRequest::HTTP_HEAD)
 		{
+#if POCO_OS == POCO_OS_LINUX
+			// send the file directly from the page cache, unless
+			// the data must be encrypted
+			if (!_session.socket().secure())
+			{
+				_pStream->flush();
+				if (_pStream->good() && sendFileData(_session.socket(), istr, length))
+					return;
+			}
+#endif
 			StreamCopier::copyStream(istr, *_pStream);
 		}
 	}
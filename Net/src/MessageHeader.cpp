@@ -20,6 +20,7 @@
 #include "Poco/Ascii.h"
 #include "Poco/TextConverter.h"
 #include "Poco/StringTokenizer.h"
+#include "Poco/StringSplitter.h"
 #include "Poco/Base64Decoder.h"
 #include "Poco/UTF8Encoding.h"
 
@@ -141,46 +142,36 @@ bool MessageHeader::hasToken(const std::string& fieldName, const std::string& to
 void MessageHeader::splitElements(const std::string& s, std::vector<std::string>& elements, bool ignoreEmpty)
 {
 	elements.clear();
-	std::string::const_iterator it  = s.begin();
-	std::string::const_iterator end = s.end();
-	std::string elem;
-	elem.reserve(64);
-	while (it != end)
+	const char* end = s.data() + s.size();
+	Poco::StringSplitter splitter(s, ',', Poco::StringSplitter::TOK_QUOTES);
+	Poco::StringView elem;
+	while (splitter.next(elem))
 	{
-		if (*it == '"')
+		if (elem.find('\\') == Poco::StringView::NPOS)
 		{
-			elem += *it++;
-			while (it != end && *it != '"')
+			// an empty element following a trailing comma is never added
+			if (elem.empty() && elem.end() == end) break;
+			Poco::StringView trimmed = elem.trimmed();
+			if (!ignoreEmpty || !trimmed.empty())
 			{
-				if (*it == '\\')
-				{
-					++it;
-					if (it != end) elem += *it++;
-				}
-				else elem += *it++;
+				elements.push_back(std::string());
+				trimmed.assignTo(elements.back());
 			}
-			if (it != end) elem += *it++;
-		}
-		else if (*it == '\\')
-		{
-			++it;
-			if (it != end) elem += *it++;
 		}
-		else if (*it == ',')
+		else
 		{
-			Poco::trimInPlace(elem);
-			if (!ignoreEmpty || !elem.empty())
-				elements.push_back(elem);
-			elem.clear();
-			++it;
+			std::string unescaped;
+			unescaped.reserve(elem.size());
+			for (Poco::StringView::ConstIterator it = elem.begin(); it != elem.end(); ++it)
+			{
+				if (*it == '\\' && ++it == elem.end()) break;
+				unescaped += *it;
+			}
+			if (unescaped.empty() && elem.end() == end) break;
+			Poco::trimInPlace(unescaped);
+			if (!ignoreEmpty || !unescaped.empty())
+				elements.push_back(unescaped);
 		}
-		else elem += *it++;
-	}
-	if (!elem.empty())
-	{
-		Poco::trimInPlace(elem);
-		if (!ignoreEmpty || !elem.empty())
-			elements.push_back(elem);
 	}
 }
 
@@ -189,58 +180,71 @@ void MessageHeader::splitParameters(const std::string& s, std::string& value, Na
 {
 	value.clear();
 	parameters.clear();
-	std::string::const_iterator it  = s.begin();
-	std::string::const_iterator end = s.end();
-	while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-	while (it != end && *it != ';') value += *it++;
-	Poco::trimRightInPlace(value);
-	if (it != end) ++it;
-	splitParameters(it, end, parameters);
+	Poco::StringView str(s);
+	Poco::StringView::SizeType pos = str.find(';');
+	str.substr(0, pos).trimmed().assignTo(value);
+	if (pos != Poco::StringView::NPOS)
+		splitParameters(s.begin() + pos + 1, s.end(), parameters);
 }
 
 
 void MessageHeader::splitParameters(const std::string::const_iterator& begin, const std::string::const_iterator& end, NameValueCollection& parameters)
 {
+	if (begin == end) return;
+
 	std::string pname;
 	std::string pvalue;
 	pname.reserve(32);
 	pvalue.reserve(64);
-	std::string::const_iterator it = begin;
-	while (it != end)
+	const char* it   = &*begin;
+	const char* pEnd = it + (end - begin);
+	while (it != pEnd)
 	{
-		pname.clear();
-		pvalue.clear();
-		while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-		while (it != end && *it != '=' && *it != ';') pname += *it++;
-		Poco::trimRightInPlace(pname);
-		if (it != end && *it != ';') ++it;
-		while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-		while (it != end && *it != ';')
+		while (it != pEnd && Poco::Ascii::isSpace(*it)) ++it;
+		const char* nameBegin = it;
+		while (it != pEnd && *it != '=' && *it != ';') ++it;
+		Poco::StringView(nameBegin, it - nameBegin).trimmed().assignTo(pname);
+		if (it != pEnd && *it != ';') ++it;
+		while (it != pEnd && Poco::Ascii::isSpace(*it)) ++it;
+
+		// Values without quotes and escapes are assigned in one go;
+		// the others are unquoted and unescaped character by character.
+		const char* valueBegin = it;
+		while (it != pEnd && *it != ';' && *it != '"' && *it != '\\') ++it;
+		if (it == pEnd || *it == ';')
+		{
+			Poco::StringView(valueBegin, it - valueBegin).trimmed().assignTo(pvalue);
+		}
+		else
 		{
-			if (*it == '"')
+			pvalue.assign(valueBegin, it);
+			while (it != pEnd && *it != ';')
 			{
-				++it;
-				while (it != end && *it != '"')
+				if (*it == '"')
 				{
-					if (*it == '\\')
+					++it;
+					while (it != pEnd && *it != '"')
 					{
-						++it;
-						if (it != end) pvalue += *it++;
+						if (*it == '\\')
+						{
+							++it;
+							if (it != pEnd) pvalue += *it++;
+						}
+						else pvalue += *it++;
 					}
-					else pvalue += *it++;
+					if (it != pEnd) ++it;
 				}
-				if (it != end) ++it;
-			}
-			else if (*it == '\\')
-			{
-				++it;
-				if (it != end) pvalue += *it++;
+				else if (*it == '\\')
+				{
+					++it;
+					if (it != pEnd) pvalue += *it++;
+				}
+				else pvalue += *it++;
 			}
-			else pvalue += *it++;
+			Poco::trimRightInPlace(pvalue);
 		}
-		Poco::trimRightInPlace(pvalue);
 		if (!pname.empty()) parameters.add(pname, pvalue);
-		if (it != end) ++it;
+		if (it != pEnd) ++it;
 	}
 }
 
@@ -16,12 +16,20 @@
 #include "Poco/Net/MultipartReader.h"
 #include "Poco/Net/MessageHeader.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/Base64Decoder.h"
+#include "Poco/Base32Decoder.h"
+#include "Poco/HexBinaryDecoder.h"
+#include "Poco/StreamCopier.h"
 #include <sstream>
 
 
 using Poco::Net::MultipartReader;
 using Poco::Net::MessageHeader;
 using Poco::Net::MultipartException;
+using Poco::Base64Decoder;
+using Poco::Base32Decoder;
+using Poco::HexBinaryDecoder;
+using Poco::StreamCopier;
 
 
 MultipartReaderTest::MultipartReaderTest(const std::string& name): CppUnit::TestCase(name)
@@ -352,6 +360,42 @@ void MultipartReaderTest::testUnixLineEnds()
 }
 
 
+void MultipartReaderTest::testDecodeParts()
+{
+	// the decoders must not read past the end of a part
+	std::string s("\r\n--MIME_boundary_01234567\r\nname1: value1\r\n\r\ndGhpcyBpcyBwYXJ0IDE=\r\n--MIME_boundary_01234567\r\nname2: value2\r\n\r\nORSXG5A=\r\n--MIME_boundary_01234567\r\nname3: value3\r\n\r\n74657374\r\n--MIME_boundary_01234567--\r\n");
+	std::istringstream istr(s);
+	MultipartReader r(istr, "MIME_boundary_01234567");
+	MessageHeader h;
+	std::string part;
+
+	assert (r.hasNextPart());
+	r.nextPart(h);
+	assert (h["name1"] == "value1");
+	Base64Decoder decoder64(r.stream());
+	StreamCopier::copyToString(decoder64, part);
+	assert (part == "this is part 1");
+
+	assert (r.hasNextPart());
+	r.nextPart(h);
+	assert (h["name2"] == "value2");
+	part.clear();
+	Base32Decoder decoder32(r.stream());
+	StreamCopier::copyToString(decoder32, part);
+	assert (part == "test");
+
+	assert (r.hasNextPart());
+	r.nextPart(h);
+	assert (h["name3"] == "value3");
+	part.clear();
+	HexBinaryDecoder decoderHex(r.stream());
+	StreamCopier::copyToString(decoderHex, part);
+	assert (part == "test");
+
+	assert (!r.hasNextPart());
+}
+
+
 void MultipartReaderTest::setUp()
 {
 }
@@ -375,6 +419,7 @@ CppUnit::Test* MultipartReaderTest::suite()
 	CppUnit_addTest(pSuite, MultipartReaderTest, testBadBoundary);
 	CppUnit_addTest(pSuite, MultipartReaderTest, testRobustness);
 	CppUnit_addTest(pSuite, MultipartReaderTest, testUnixLineEnds);
+	CppUnit_addTest(pSuite, MultipartReaderTest, testDecodeParts);
 
 	return pSuite;
 }
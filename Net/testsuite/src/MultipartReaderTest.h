@@ -35,6 +35,7 @@ public:
 	void testBadBoundary();
 	void testRobustness();
 	void testUnixLineEnds();
+	void testDecodeParts();
 
 	void setUp();
 	void tearDown();
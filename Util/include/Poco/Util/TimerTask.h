@@ -74,8 +74,11 @@ private:
 	
 	Poco::Timestamp _lastExecution;
 	bool _isCancelled;
+	void* _pWheelEntry;
+	void* _pWheelTimer;
 	
 	friend class TaskNotification;
+	friend class WheelTimer;
 };
 
 
@@ -0,0 +1,251 @@
+//
+// WheelTimer.h
+//
+// $Id$
+//
+// Library: Util
+// Package: Timer
+// Module:  WheelTimer
+//
+// Definition of the WheelTimer class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Util_WheelTimer_INCLUDED
+#define Util_WheelTimer_INCLUDED
+
+
+#include "Poco/Util/Util.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/Thread.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Mutex.h"
+#include "Poco/Condition.h"
+#include "Poco/Clock.h"
+#include "Poco/Timestamp.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+namespace Util {
+
+
+class Util_API WheelTimer: protected Poco::Runnable
+	/// A WheelTimer allows to schedule tasks (TimerTask objects) for future
+	/// execution, just like a Timer, and has the same interface.
+	///
+	/// Instead of a TimedNotificationQueue, which keeps all pending tasks
+	/// ordered by time, a WheelTimer uses a hierarchical timing wheel, as
+	/// described by Varghese and Lauck. Time is divided into ticks of a
+	/// fixed length (the resolution). Tasks due within the next 256 ticks
+	/// are kept in one of 256 slots of the root wheel; tasks due later are
+	/// kept in one of four coarser wheels with 64 slots each, and are moved
+	/// down ("cascaded") to a finer wheel as their time approaches.
+	/// Scheduling and unscheduling a task are therefore constant-time
+	/// operations, independent of the number of pending tasks, which makes
+	/// the WheelTimer suitable for very large numbers of timers, e.g. for
+	/// session expiration. With a resolution of one millisecond, tasks
+	/// can be scheduled up to 49 days in advance; tasks due even later
+	/// are re-evaluated when the farthest slot comes due.
+	///
+	/// Tasks are never executed before they are due, but may be executed
+	/// up to one resolution interval late.
+	///
+	/// All tasks due at the same tick are removed from the wheel as
+	/// one batch and are then executed sequentially by the timer thread,
+	/// or, if a ThreadPool has been given, started in the ThreadPool.
+	/// If the ThreadPool has no thread available, the task is executed
+	/// by the timer thread.
+	///
+	/// A task must not be scheduled with more than one WheelTimer, and
+	/// can only be scheduled again after it has completed or has
+	/// been removed with unschedule().
+	///
+	/// WheelTimer is safe for multithreaded use - multiple threads can
+	/// schedule new tasks simultaneously.
+{
+public:
+	enum
+	{
+		DEFAULT_RESOLUTION = 1 /// milliseconds
+	};
+
+	explicit WheelTimer(long resolution = DEFAULT_RESOLUTION);
+		/// Creates the WheelTimer, using the given resolution
+		/// (tick length) in milliseconds.
+
+	WheelTimer(Poco::ThreadPool& pool, long resolution = DEFAULT_RESOLUTION);
+		/// Creates the WheelTimer, using the given resolution
+		/// in milliseconds. Tasks are executed by threads from
+		/// the given ThreadPool, which must outlive the WheelTimer.
+
+	~WheelTimer();
+		/// Destroys the WheelTimer, cancelling all pending tasks
+		/// and waiting for all running tasks to complete.
+
+	void cancel(bool wait = false);
+		/// Cancels all pending tasks.
+		///
+		/// If a task is currently running, it is allowed to finish,
+		/// but is not rescheduled. If wait is true, waits until all
+		/// running tasks have finished. Must not be called with
+		/// wait set to true from within a task.
+
+	bool unschedule(TimerTask::Ptr pTask);
+		/// Cancels the given task and immediately removes
+		/// it from the WheelTimer.
+		///
+		/// Returns true if the task was pending and has been removed,
+		/// or false if the task was not scheduled with this WheelTimer
+		/// or is currently running. A running task is allowed to finish,
+		/// but is not rescheduled.
+		///
+		/// Note that calling TimerTask::cancel() also prevents further
+		/// executions of the task, but the WheelTimer only releases
+		/// the task when it comes due.
+
+	void schedule(TimerTask::Ptr pTask, Poco::Timestamp time);
+		/// Schedules a task for execution at the specified time.
+		///
+		/// If the time lies in the past, the task is executed
+		/// immediately.
+
+	void schedule(TimerTask::Ptr pTask, Poco::Clock clock);
+		/// Schedules a task for execution at the specified time.
+		///
+		/// If the time lies in the past, the task is executed
+		/// immediately.
+
+	void schedule(TimerTask::Ptr pTask, long delay, long interval);
+		/// Schedules a task for periodic execution.
+		///
+		/// The task is first executed after the given delay.
+		/// Subsequently, the task is executed periodically with
+		/// the given interval in milliseconds between invocations.
+
+	void schedule(TimerTask::Ptr pTask, Poco::Timestamp time, long interval);
+		/// Schedules a task for periodic execution.
+		///
+		/// The task is first executed at the given time.
+		/// Subsequently, the task is executed periodically with
+		/// the given interval in milliseconds between invocations.
+
+	void schedule(TimerTask::Ptr pTask, Poco::Clock clock, long interval);
+		/// Schedules a task for periodic execution.
+		///
+		/// The task is first executed at the given time.
+		/// Subsequently, the task is executed periodically with
+		/// the given interval in milliseconds between invocations.
+
+	void scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval);
+		/// Schedules a task for periodic execution at a fixed rate.
+		///
+		/// The task is first executed after the given delay.
+		/// Subsequently, the task is executed periodically
+		/// every number of milliseconds specified by interval.
+		///
+		/// If task execution takes longer than the given interval,
+		/// further executions are delayed.
+
+	void scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Timestamp time, long interval);
+		/// Schedules a task for periodic execution at a fixed rate.
+		///
+		/// The task is first executed at the given time.
+		/// Subsequently, the task is executed periodically
+		/// every number of milliseconds specified by interval.
+		///
+		/// If task execution takes longer than the given interval,
+		/// further executions are delayed.
+
+	void scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Clock clock, long interval);
+		/// Schedules a task for periodic execution at a fixed rate.
+		///
+		/// The task is first executed at the given time.
+		/// Subsequently, the task is executed periodically
+		/// every number of milliseconds specified by interval.
+		///
+		/// If task execution takes longer than the given interval,
+		/// further executions are delayed.
+
+	std::size_t size() const;
+		/// Returns the number of pending (scheduled, but
+		/// not currently running) tasks.
+
+	long resolution() const;
+		/// Returns the resolution in milliseconds.
+
+protected:
+	void run();
+	static void validateTask(const TimerTask::Ptr& pTask);
+
+private:
+	WheelTimer(const WheelTimer&);
+	WheelTimer& operator = (const WheelTimer&);
+
+	enum
+	{
+		ROOT_BITS  = 8,
+		ROOT_SIZE  = 1 << ROOT_BITS,
+		LEVEL_BITS = 6,
+		LEVEL_SIZE = 1 << LEVEL_BITS,
+		LEVELS     = 4
+	};
+
+	class Entry;
+	typedef Poco::UInt64 Tick;
+
+	void init();
+	void add(TimerTask::Ptr pTask, const Poco::Clock& clock, long interval, bool periodic, bool fixedRate);
+	void insert(Entry* pEntry);
+	void unlink(Entry* pEntry);
+	int cascade(int level, int index);
+	void advance(Tick now, std::vector<Entry*>& expired);
+	Tick nextTick() const;
+	Tick tickAt(const Poco::Clock& clock) const;
+	Tick currentTick() const;
+	void dispatch(std::vector<Entry*>& expired);
+	void execute(Entry* pEntry);
+	void runTask(Entry* pEntry);
+	bool finish(Entry* pEntry);
+	void purge();
+
+	Poco::Clock                  _start;
+	Poco::Clock::ClockDiff       _tickLength;
+	Tick                         _tick;
+	Tick                         _wakeTick;
+	Entry*                       _root[ROOT_SIZE];
+	Entry*                       _levels[LEVELS][LEVEL_SIZE];
+	std::size_t                  _size;
+	int                          _running;
+	int                          _generation;
+	bool                         _stopped;
+	Poco::ThreadPool*            _pPool;
+	mutable Poco::FastMutex      _mutex;
+	Poco::Condition              _wakeUp;
+	Poco::Condition              _idle;
+	Poco::Thread                 _thread;
+
+	friend class Entry;
+};
+
+
+//
+// inlines
+//
+inline long WheelTimer::resolution() const
+{
+	return static_cast<long>(_tickLength/1000);
+}
+
+
+} } // namespace Poco::Util
+
+
+#endif // Util_WheelTimer_INCLUDED
@@ -0,0 +1,150 @@
+//
+// TimerBenchmark.cpp
+//
+// $Id$
+//
+// This sample compares Timer and WheelTimer with a large number
+// of pending tasks, e.g. for session expiration.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Util/Timer.h"
+#include "Poco/Util/WheelTimer.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Random.h"
+#include "Poco/Thread.h"
+#include "Poco/NumberParser.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+using Poco::Util::Timer;
+using Poco::Util::WheelTimer;
+using Poco::Util::TimerTask;
+using Poco::AtomicCounter;
+using Poco::Stopwatch;
+using Poco::Clock;
+
+
+class ExpireTask: public TimerTask
+{
+public:
+	ExpireTask(AtomicCounter& counter):
+		_counter(counter)
+	{
+	}
+
+	void run()
+	{
+		++_counter;
+	}
+
+private:
+	AtomicCounter& _counter;
+};
+
+
+void unschedule(Timer&, TimerTask::Ptr pTask)
+{
+	// a Timer only drops cancelled tasks when they come due
+	pTask->cancel();
+}
+
+
+void unschedule(WheelTimer& timer, TimerTask::Ptr pTask)
+{
+	timer.unschedule(pTask);
+}
+
+
+void report(const std::string& label, const std::string& what, const Stopwatch& sw, int n)
+{
+	std::cout << std::setw(12) << label << std::setw(22) << what << ": "
+	          << std::setw(8) << sw.elapsed()/1000 << " [ms] "
+	          << std::setw(8) << std::fixed << std::setprecision(1) << 1000.0*sw.elapsed()/n << " [ns/op]" << std::endl;
+}
+
+
+template <class T>
+void benchmark(T& timer, int n, const std::string& label)
+{
+	AtomicCounter counter;
+	Poco::Random rnd;
+	std::vector<TimerTask::Ptr> tasks(n);
+
+	// schedule n session expiration tasks, due in 1 to 60 minutes
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < n; ++i)
+	{
+		Clock due;
+		due += static_cast<Clock::ClockDiff>(60 + rnd.next(3540))*1000000;
+		tasks[i] = new ExpireTask(counter);
+		timer.schedule(tasks[i], due);
+	}
+	sw.stop();
+	report(label, "schedule", sw, n);
+	Clock::ClockDiff scheduleTime = sw.elapsed();
+
+	// sessions are touched: cancel the pending task and schedule a new one
+	sw.restart();
+	for (int i = 0; i < n; ++i)
+	{
+		unschedule(timer, tasks[i]);
+		Clock due;
+		due += static_cast<Clock::ClockDiff>(60 + rnd.next(3540))*1000000;
+		tasks[i] = new ExpireTask(counter);
+		timer.schedule(tasks[i], due);
+	}
+	sw.stop();
+	report(label, "cancel+reschedule", sw, n);
+
+	// cancel all pending tasks
+	sw.restart();
+	timer.cancel(true);
+	sw.stop();
+	report(label, "cancel all", sw, n);
+	tasks.clear();
+
+	// n tasks expiring within 100 milliseconds, measured from the
+	// first due time until all tasks have been executed
+	Clock start;
+	start += 2*scheduleTime + 100000;
+	for (int i = 0; i < n; ++i)
+	{
+		Clock due(start);
+		due += static_cast<Clock::ClockDiff>(rnd.next(100))*1000;
+		timer.schedule(new ExpireTask(counter), due);
+	}
+	while (start.elapsed() < 0) Poco::Thread::sleep(1);
+	sw.restart();
+	while (counter.value() < n) Poco::Thread::sleep(1);
+	sw.stop();
+	report(label, "expire", sw, n);
+}
+
+
+int main(int argc, char** argv)
+{
+	int n = argc > 1 ? Poco::NumberParser::parse(argv[1]) : 1000000;
+
+	std::cout << n << " pending timers" << std::endl;
+	{
+		Timer timer;
+		benchmark(timer, n, "Timer");
+	}
+	{
+		WheelTimer timer;
+		benchmark(timer, n, "WheelTimer");
+	}
+
+	return 0;
+}
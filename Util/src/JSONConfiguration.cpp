@@ -107,8 +107,8 @@ void JSONConfiguration::getIndexes(std::string& name, std::vector<int>& indexes)
 	RegularExpression::MatchVec matches;
 	int firstOffset = -1;
 	int offset = 0;
-	RegularExpression regex("\\[([0-9]+)\\]");
-	while(regex.match(name, offset, matches) > 0 )
+	RegularExpression::Ptr pRegex = RegularExpression::cached("\\[([0-9]+)\\]");
+	while(pRegex->match(name, offset, matches) > 0 )
 	{
 		if ( firstOffset == -1 )
 		{
@@ -23,7 +23,9 @@ namespace Util {
 
 TimerTask::TimerTask():
 	_lastExecution(0),
-	_isCancelled(false)
+	_isCancelled(false),
+	_pWheelEntry(0),
+	_pWheelTimer(0)
 {
 }
 
@@ -0,0 +1,574 @@
+//
+// WheelTimer.cpp
+//
+// $Id$
+//
+// Library: Util
+// Package: Timer
+// Module:  WheelTimer
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Util/WheelTimer.h"
+#include "Poco/ScopedUnlock.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+
+
+using Poco::ErrorHandler;
+
+
+namespace Poco {
+namespace Util {
+
+
+namespace
+{
+	Poco::Clock toClock(const Poco::Timestamp& time)
+	{
+		Poco::Timestamp tsNow;
+		Poco::Clock clock;
+		clock += time - tsNow;
+		return clock;
+	}
+}
+
+
+class WheelTimer::Entry: public Poco::Runnable
+{
+public:
+	Entry(WheelTimer& rTimer, const TimerTask::Ptr& rpTask, const Poco::Clock& rNext, long rInterval, bool rPeriodic, bool rFixedRate, int rGeneration):
+		timer(rTimer),
+		pTask(rpTask),
+		pPrev(0),
+		pNext(0),
+		pSlot(0),
+		due(0),
+		next(rNext),
+		interval(rInterval),
+		periodic(rPeriodic),
+		fixedRate(rFixedRate),
+		generation(rGeneration)
+	{
+	}
+
+	~Entry()
+	{
+	}
+
+	void run()
+	{
+		timer.execute(this);
+	}
+
+	WheelTimer&    timer;
+	TimerTask::Ptr pTask;
+	Entry*         pPrev;
+	Entry*         pNext;
+	Entry**        pSlot;
+	Tick           due;
+	Poco::Clock    next;
+	long           interval;
+	bool           periodic;
+	bool           fixedRate;
+	int            generation;
+};
+
+
+WheelTimer::WheelTimer(long resolution):
+	_tickLength(static_cast<Poco::Clock::ClockDiff>(resolution)*1000),
+	_pPool(0)
+{
+	init();
+}
+
+
+WheelTimer::WheelTimer(Poco::ThreadPool& pool, long resolution):
+	_tickLength(static_cast<Poco::Clock::ClockDiff>(resolution)*1000),
+	_pPool(&pool)
+{
+	init();
+}
+
+
+WheelTimer::~WheelTimer()
+{
+	try
+	{
+		{
+			Poco::FastMutex::ScopedLock lock(_mutex);
+			_stopped = true;
+			_wakeUp.broadcast();
+		}
+		_thread.join();
+
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		while (_running > 0) _idle.wait(_mutex);
+		purge();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void WheelTimer::init()
+{
+	if (_tickLength <= 0) throw Poco::InvalidArgumentException("WheelTimer resolution must be positive");
+
+	_tick       = 0;
+	_wakeTick   = 0;
+	_size       = 0;
+	_running    = 0;
+	_generation = 0;
+	_stopped    = false;
+	for (int i = 0; i < ROOT_SIZE; ++i)
+	{
+		_root[i] = 0;
+	}
+	for (int level = 0; level < LEVELS; ++level)
+	{
+		for (int i = 0; i < LEVEL_SIZE; ++i)
+		{
+			_levels[level][i] = 0;
+		}
+	}
+	_thread.start(*this);
+}
+
+
+void WheelTimer::cancel(bool wait)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	++_generation;
+	purge();
+	if (wait)
+	{
+		while (_running > 0) _idle.wait(_mutex);
+	}
+}
+
+
+bool WheelTimer::unschedule(TimerTask::Ptr pTask)
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	// the entry of a task scheduled with another timer
+	// must not be touched without that timer's lock
+	if (pTask->_pWheelTimer != this) return false;
+
+	pTask->cancel();
+	Entry* pEntry = static_cast<Entry*>(pTask->_pWheelEntry);
+	if (pEntry->pSlot)
+	{
+		unlink(pEntry);
+		--_size;
+		pTask->_pWheelEntry = 0;
+		pTask->_pWheelTimer = 0;
+		delete pEntry;
+		return true;
+	}
+	return false;
+}
+
+
+void WheelTimer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time)
+{
+	add(pTask, toClock(time), 0, false, false);
+}
+
+
+void WheelTimer::schedule(TimerTask::Ptr pTask, Poco::Clock clock)
+{
+	add(pTask, clock, 0, false, false);
+}
+
+
+void WheelTimer::schedule(TimerTask::Ptr pTask, long delay, long interval)
+{
+	Poco::Clock clock;
+	clock += static_cast<Poco::Clock::ClockDiff>(delay)*1000;
+	add(pTask, clock, interval, true, false);
+}
+
+
+void WheelTimer::schedule(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
+{
+	add(pTask, toClock(time), interval, true, false);
+}
+
+
+void WheelTimer::schedule(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
+{
+	add(pTask, clock, interval, true, false);
+}
+
+
+void WheelTimer::scheduleAtFixedRate(TimerTask::Ptr pTask, long delay, long interval)
+{
+	Poco::Clock clock;
+	clock += static_cast<Poco::Clock::ClockDiff>(delay)*1000;
+	add(pTask, clock, interval, true, true);
+}
+
+
+void WheelTimer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Timestamp time, long interval)
+{
+	add(pTask, toClock(time), interval, true, true);
+}
+
+
+void WheelTimer::scheduleAtFixedRate(TimerTask::Ptr pTask, Poco::Clock clock, long interval)
+{
+	add(pTask, clock, interval, true, true);
+}
+
+
+std::size_t WheelTimer::size() const
+{
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	return _size;
+}
+
+
+void WheelTimer::run()
+{
+	std::vector<Entry*> expired;
+	std::vector<Entry*> finished;
+	Poco::FastMutex::ScopedLock lock(_mutex);
+	while (!_stopped)
+	{
+		advance(currentTick(), expired);
+		if (!expired.empty())
+		{
+			_running += static_cast<int>(expired.size());
+			_wakeTick = 0;
+			{
+				Poco::ScopedUnlock<Poco::FastMutex> unlock(_mutex);
+				dispatch(expired);
+			}
+			for (std::vector<Entry*>::iterator it = expired.begin(); it != expired.end(); ++it)
+			{
+				if (!finish(*it)) finished.push_back(*it);
+			}
+			expired.clear();
+			if (!finished.empty())
+			{
+				Poco::ScopedUnlock<Poco::FastMutex> unlock(_mutex);
+				for (std::vector<Entry*>::iterator it = finished.begin(); it != finished.end(); ++it)
+				{
+					delete *it;
+				}
+				finished.clear();
+			}
+		}
+		else if (_size == 0)
+		{
+			_wakeTick = Tick(-1);
+			_wakeUp.wait(_mutex);
+		}
+		else
+		{
+			_wakeTick = nextTick();
+			Poco::Clock wakeUpTime(_start);
+			wakeUpTime += static_cast<Poco::Clock::ClockDiff>(_wakeTick)*_tickLength;
+			Poco::Clock::ClockDiff remaining = wakeUpTime - Poco::Clock();
+			if (remaining > 0)
+			{
+				_wakeUp.tryWait(_mutex, static_cast<long>((remaining + 999)/1000));
+			}
+		}
+	}
+}
+
+
+void WheelTimer::validateTask(const TimerTask::Ptr& pTask)
+{
+	if (pTask->isCancelled())
+	{
+		throw Poco::IllegalStateException("A cancelled task must not be rescheduled");
+	}
+}
+
+
+void WheelTimer::add(TimerTask::Ptr pTask, const Poco::Clock& clock, long interval, bool periodic, bool fixedRate)
+{
+	validateTask(pTask);
+
+	Poco::FastMutex::ScopedLock lock(_mutex);
+
+	if (pTask->_pWheelEntry)
+	{
+		throw Poco::IllegalStateException("The task is already scheduled");
+	}
+	if (_size == 0)
+	{
+		// the wheel has been idle; skip the ticks that have passed
+		Tick now = currentTick();
+		if (now > _tick) _tick = now;
+	}
+	Entry* pEntry = new Entry(*this, pTask, clock, interval, periodic, fixedRate, _generation);
+	pEntry->due = tickAt(clock);
+	insert(pEntry);
+	pTask->_pWheelEntry = pEntry;
+	pTask->_pWheelTimer = this;
+	++_size;
+	if (pEntry->due < _wakeTick) _wakeUp.signal();
+}
+
+
+void WheelTimer::insert(Entry* pEntry)
+{
+	Tick due = pEntry->due < _tick ? _tick : pEntry->due;
+	Tick delta = due - _tick;
+	Entry** pSlot;
+	if (delta < ROOT_SIZE)
+	{
+		pSlot = &_root[due & (ROOT_SIZE - 1)];
+	}
+	else
+	{
+		int level = 0;
+		while (level < LEVELS - 1 && delta >= (Tick(1) << (ROOT_BITS + (level + 1)*LEVEL_BITS))) ++level;
+		if (level == LEVELS - 1)
+		{
+			// tasks beyond the range of the wheel are re-inserted
+			// when the farthest slot is cascaded
+			const Tick maxDelta = (Tick(1) << (ROOT_BITS + LEVELS*LEVEL_BITS)) - 1;
+			if (delta > maxDelta) due = _tick + maxDelta;
+		}
+		pSlot = &_levels[level][(due >> (ROOT_BITS + level*LEVEL_BITS)) & (LEVEL_SIZE - 1)];
+	}
+	pEntry->pSlot = pSlot;
+	pEntry->pPrev = 0;
+	pEntry->pNext = *pSlot;
+	if (*pSlot) (*pSlot)->pPrev = pEntry;
+	*pSlot = pEntry;
+}
+
+
+void WheelTimer::unlink(Entry* pEntry)
+{
+	if (pEntry->pPrev)
+		pEntry->pPrev->pNext = pEntry->pNext;
+	else
+		*pEntry->pSlot = pEntry->pNext;
+	if (pEntry->pNext)
+		pEntry->pNext->pPrev = pEntry->pPrev;
+	pEntry->pPrev = 0;
+	pEntry->pNext = 0;
+	pEntry->pSlot = 0;
+}
+
+
+int WheelTimer::cascade(int level, int index)
+{
+	Entry* pEntry = _levels[level][index];
+	_levels[level][index] = 0;
+	while (pEntry)
+	{
+		Entry* pNext = pEntry->pNext;
+		insert(pEntry);
+		pEntry = pNext;
+	}
+	return index;
+}
+
+
+void WheelTimer::advance(Tick now, std::vector<Entry*>& expired)
+{
+	while (_size > 0 && _tick <= now)
+	{
+		int index = static_cast<int>(_tick & (ROOT_SIZE - 1));
+		if (index == 0)
+		{
+			int level = 0;
+			while (level < LEVELS && cascade(level, static_cast<int>((_tick >> (ROOT_BITS + level*LEVEL_BITS)) & (LEVEL_SIZE - 1))) == 0) ++level;
+		}
+		Entry* pEntry = _root[index];
+		_root[index] = 0;
+		while (pEntry)
+		{
+			Entry* pNext = pEntry->pNext;
+			pEntry->pPrev = 0;
+			pEntry->pNext = 0;
+			pEntry->pSlot = 0;
+			--_size;
+			expired.push_back(pEntry);
+			pEntry = pNext;
+		}
+		++_tick;
+	}
+	if (_size == 0 && _tick <= now) _tick = now + 1;
+}
+
+
+WheelTimer::Tick WheelTimer::nextTick() const
+{
+	Tick end = (_tick | (ROOT_SIZE - 1)) + 1;
+	for (Tick t = _tick; t < end; ++t)
+	{
+		if (_root[t & (ROOT_SIZE - 1)]) return t;
+	}
+	return end;
+}
+
+
+WheelTimer::Tick WheelTimer::tickAt(const Poco::Clock& clock) const
+{
+	Poco::Clock::ClockDiff diff = clock - _start;
+	if (diff <= 0) return 0;
+	return static_cast<Tick>((diff + _tickLength - 1)/_tickLength);
+}
+
+
+WheelTimer::Tick WheelTimer::currentTick() const
+{
+	Poco::Clock::ClockDiff diff = _start.elapsed();
+	return diff > 0 ? static_cast<Tick>(diff/_tickLength) : 0;
+}
+
+
+void WheelTimer::dispatch(std::vector<Entry*>& expired)
+{
+	// Tasks started in the ThreadPool are finished by the pool thread;
+	// only the tasks executed here are left in expired. A task that
+	// cannot be started in the pool is executed here, after the error,
+	// if any, has been reported.
+	std::vector<Entry*>::iterator last = expired.begin();
+	for (std::vector<Entry*>::iterator it = expired.begin(); it != expired.end(); ++it)
+	{
+		if (_pPool && !(*it)->pTask->isCancelled())
+		{
+			try
+			{
+				_pPool->start(**it);
+				continue;
+			}
+			catch (Poco::NoThreadAvailableException&)
+			{
+			}
+			catch (Poco::Exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (std::exception& exc)
+			{
+				Poco::ErrorHandler::handle(exc);
+			}
+			catch (...)
+			{
+				Poco::ErrorHandler::handle();
+			}
+		}
+		runTask(*it);
+		*last++ = *it;
+	}
+	expired.erase(last, expired.end());
+}
+
+
+void WheelTimer::execute(Entry* pEntry)
+{
+	runTask(pEntry);
+	bool rescheduled;
+	{
+		Poco::FastMutex::ScopedLock lock(_mutex);
+		rescheduled = finish(pEntry);
+	}
+	if (!rescheduled) delete pEntry;
+}
+
+
+void WheelTimer::runTask(Entry* pEntry)
+{
+	TimerTask* pTask = pEntry->pTask;
+	if (!pTask->isCancelled())
+	{
+		try
+		{
+			pTask->_lastExecution.update();
+			pTask->run();
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+}
+
+
+bool WheelTimer::finish(Entry* pEntry)
+{
+	TimerTask* pTask = pEntry->pTask;
+	bool reschedule = pEntry->periodic && !pTask->isCancelled() && pEntry->generation == _generation && !_stopped;
+	if (reschedule)
+	{
+		Poco::Clock now;
+		if (!pEntry->fixedRate) pEntry->next = now;
+		pEntry->next += static_cast<Poco::Clock::ClockDiff>(pEntry->interval)*1000;
+		if (pEntry->next < now) pEntry->next = now;
+		pEntry->due = tickAt(pEntry->next);
+		insert(pEntry);
+		++_size;
+		if (pEntry->due < _wakeTick) _wakeUp.signal();
+	}
+	else
+	{
+		pTask->_pWheelEntry = 0;
+		pTask->_pWheelTimer = 0;
+	}
+
+	if (--_running == 0) _idle.broadcast();
+	return reschedule;
+}
+
+
+void WheelTimer::purge()
+{
+	for (int i = 0; i < ROOT_SIZE; ++i)
+	{
+		while (_root[i])
+		{
+			Entry* pEntry = _root[i];
+			_root[i] = pEntry->pNext;
+			pEntry->pTask->_pWheelEntry = 0;
+			pEntry->pTask->_pWheelTimer = 0;
+			delete pEntry;
+		}
+	}
+	for (int level = 0; level < LEVELS; ++level)
+	{
+		for (int i = 0; i < LEVEL_SIZE; ++i)
+		{
+			while (_levels[level][i])
+			{
+				Entry* pEntry = _levels[level][i];
+				_levels[level][i] = pEntry->pNext;
+				pEntry->pTask->_pWheelEntry = 0;
+				pEntry->pTask->_pWheelTimer = 0;
+				delete pEntry;
+			}
+		}
+	}
+	_size = 0;
+}
+
+
+} } // namespace Poco::Util
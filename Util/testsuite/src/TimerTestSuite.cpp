@@ -12,6 +12,7 @@
 
 #include "TimerTestSuite.h"
 #include "TimerTest.h"
+#include "WheelTimerTest.h"
 
 
 CppUnit::Test* TimerTestSuite::suite()
@@ -19,6 +20,7 @@ CppUnit::Test* TimerTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TimerTestSuite");
 
 	pSuite->addTest(TimerTest::suite());
+	pSuite->addTest(WheelTimerTest::suite());
 
 	return pSuite;
 }
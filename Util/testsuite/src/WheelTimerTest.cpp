@@ -0,0 +1,364 @@
+//
+// WheelTimerTest.cpp
+//
+// $Id$
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "WheelTimerTest.h"
+#include "Poco/CppUnit/TestCaller.h"
+#include "Poco/CppUnit/TestSuite.h"
+#include "Poco/Util/WheelTimer.h"
+#include "Poco/Util/TimerTaskAdapter.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/AtomicCounter.h"
+#include <vector>
+
+
+using Poco::Util::WheelTimer;
+using Poco::Util::TimerTask;
+using Poco::Util::TimerTaskAdapter;
+using Poco::Timestamp;
+using Poco::Clock;
+using Poco::AtomicCounter;
+
+
+namespace
+{
+	class CountingTask: public TimerTask
+	{
+	public:
+		CountingTask(AtomicCounter& counter, const Clock& due):
+			_counter(counter),
+			_due(due),
+			_early(false)
+		{
+		}
+
+		void run()
+		{
+			if (Clock() < _due) _early = true;
+			++_counter;
+		}
+
+		bool early() const
+		{
+			return _early;
+		}
+
+	private:
+		AtomicCounter& _counter;
+		Clock _due;
+		bool _early;
+	};
+}
+
+
+WheelTimerTest::WheelTimerTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+WheelTimerTest::~WheelTimerTest()
+{
+}
+
+
+void WheelTimerTest::testScheduleTimestamp()
+{
+	WheelTimer timer;
+
+	Timestamp time;
+	time += 500000;
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+
+	assert (pTask->lastExecution() == 0);
+
+	timer.schedule(pTask, time);
+	assert (timer.size() == 1);
+
+	_event.wait();
+	assert (pTask->lastExecution() >= time);
+}
+
+
+void WheelTimerTest::testScheduleClock()
+{
+	WheelTimer timer;
+
+	Timestamp time;
+	time += 500000;
+
+	Clock clock;
+	clock += 500000;
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+
+	timer.schedule(pTask, clock);
+
+	_event.wait();
+	assert (pTask->lastExecution() >= time);
+	assert (timer.size() == 0);
+
+	// the task may be scheduled again once it has run
+	Poco::Thread::sleep(100);
+	timer.schedule(pTask, Clock());
+	_event.wait();
+}
+
+
+void WheelTimerTest::testScheduleInterval()
+{
+	WheelTimer timer;
+
+	Timestamp time;
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+
+	timer.schedule(pTask, 500, 500);
+
+	_event.wait();
+	assert (time.elapsed() >= 590000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	_event.wait();
+	assert (time.elapsed() >= 1190000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	pTask->cancel();
+	assert (pTask->isCancelled());
+}
+
+
+void WheelTimerTest::testScheduleAtFixedRate()
+{
+	WheelTimer timer;
+
+	Timestamp time;
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+
+	timer.scheduleAtFixedRate(pTask, 500, 500);
+
+	_event.wait();
+	assert (time.elapsed() >= 500000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	_event.wait();
+	assert (time.elapsed() >= 1000000);
+	assert (pTask->lastExecution().elapsed() < 130000);
+
+	assert (timer.unschedule(pTask) || pTask->isCancelled());
+}
+
+
+void WheelTimerTest::testCascade()
+{
+	// with a resolution of 1 ms, tasks more than 256 ms in the
+	// future are kept in a coarser wheel and must be cascaded
+	WheelTimer timer(1);
+	assert (timer.resolution() == 1);
+
+	AtomicCounter counter;
+	std::vector<Poco::AutoPtr<CountingTask> > tasks;
+	long delays[] = {300, 511, 512, 513, 700, 1000};
+	for (int i = 0; i < 6; ++i)
+	{
+		Clock due;
+		due += static_cast<Clock::ClockDiff>(delays[i])*1000;
+		Poco::AutoPtr<CountingTask> pTask = new CountingTask(counter, due);
+		tasks.push_back(pTask);
+		timer.schedule(pTask, due);
+	}
+
+	Poco::Thread::sleep(150);
+	assert (counter.value() == 0);
+
+	Clock start;
+	while (counter.value() < 6 && start.elapsed() < 5000000)
+	{
+		Poco::Thread::sleep(20);
+	}
+	assert (counter.value() == 6);
+	for (int i = 0; i < 6; ++i)
+	{
+		assert (!tasks[i]->early());
+	}
+}
+
+
+void WheelTimerTest::testMany()
+{
+	WheelTimer timer(1);
+
+	AtomicCounter counter;
+	std::vector<Poco::AutoPtr<CountingTask> > tasks;
+	const int n = 10000;
+	for (int i = 0; i < n; ++i)
+	{
+		Clock due;
+		due += static_cast<Clock::ClockDiff>((i*37) % 600)*1000;
+		Poco::AutoPtr<CountingTask> pTask = new CountingTask(counter, due);
+		tasks.push_back(pTask);
+		timer.schedule(pTask, due);
+	}
+
+	Clock start;
+	while (counter.value() < n && start.elapsed() < 10000000)
+	{
+		Poco::Thread::sleep(20);
+	}
+	assert (counter.value() == n);
+	assert (timer.size() == 0);
+	for (int i = 0; i < n; ++i)
+	{
+		assert (!tasks[i]->early());
+	}
+}
+
+
+void WheelTimerTest::testUnschedule()
+{
+	WheelTimer timer;
+
+	AtomicCounter counter;
+	std::vector<Poco::AutoPtr<CountingTask> > tasks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		Clock due;
+		due += static_cast<Clock::ClockDiff>(i + 1)*60*1000000;
+		Poco::AutoPtr<CountingTask> pTask = new CountingTask(counter, due);
+		tasks.push_back(pTask);
+		timer.schedule(pTask, due);
+	}
+	assert (timer.size() == 1000);
+
+	WheelTimer other;
+	assert (!other.unschedule(tasks[0]));
+	assert (!tasks[0]->isCancelled());
+	assert (timer.size() == 1000);
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert (timer.unschedule(tasks[i]));
+		assert (tasks[i]->isCancelled());
+		assert (tasks[i]->referenceCount() == 1);
+	}
+	assert (timer.size() == 0);
+	assert (!timer.unschedule(tasks[1]));
+
+	try
+	{
+		timer.schedule(tasks[1], Clock());
+		fail("must not reschedule a cancelled task");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+}
+
+
+void WheelTimerTest::testCancel()
+{
+	WheelTimer timer;
+
+	TimerTask::Ptr pTask = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+	timer.scheduleAtFixedRate(pTask, 5000, 5000);
+
+	try
+	{
+		timer.schedule(pTask, 5000, 5000);
+		fail("must not schedule a task twice");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+
+	TimerTask::Ptr pTask2 = new TimerTaskAdapter<WheelTimerTest>(*this, &WheelTimerTest::onTimer);
+	timer.schedule(pTask2, 10000, 1000);
+	assert (timer.size() == 2);
+
+	timer.cancel(true);
+	assert (timer.size() == 0);
+	assert (pTask->referenceCount() == 1);
+
+	pTask->cancel();
+	try
+	{
+		timer.scheduleAtFixedRate(pTask, 5000, 5000);
+		fail("must not reschedule a cancelled task");
+	}
+	catch (Poco::IllegalStateException&)
+	{
+	}
+	catch (Poco::Exception&)
+	{
+		fail("bad exception thrown");
+	}
+}
+
+
+void WheelTimerTest::testThreadPool()
+{
+	Poco::ThreadPool pool(2, 4);
+	AtomicCounter counter;
+	{
+		WheelTimer timer(pool, 10);
+		assert (timer.resolution() == 10);
+		for (int i = 0; i < 100; ++i)
+		{
+			Clock due;
+			due += static_cast<Clock::ClockDiff>(i % 10)*20000;
+			timer.schedule(new CountingTask(counter, due), due);
+		}
+
+		Clock start;
+		while (counter.value() < 100 && start.elapsed() < 5000000)
+		{
+			Poco::Thread::sleep(20);
+		}
+	}
+	assert (counter.value() == 100);
+	pool.joinAll();
+}
+
+
+void WheelTimerTest::setUp()
+{
+}
+
+
+void WheelTimerTest::tearDown()
+{
+}
+
+
+void WheelTimerTest::onTimer(TimerTask&)
+{
+	Poco::Thread::sleep(100);
+	_event.set();
+}
+
+
+CppUnit::Test* WheelTimerTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("WheelTimerTest");
+
+	CppUnit_addTest(pSuite, WheelTimerTest, testScheduleTimestamp);
+	CppUnit_addTest(pSuite, WheelTimerTest, testScheduleClock);
+	CppUnit_addTest(pSuite, WheelTimerTest, testScheduleInterval);
+	CppUnit_addTest(pSuite, WheelTimerTest, testScheduleAtFixedRate);
+	CppUnit_addTest(pSuite, WheelTimerTest, testCascade);
+	CppUnit_addTest(pSuite, WheelTimerTest, testMany);
+	CppUnit_addTest(pSuite, WheelTimerTest, testUnschedule);
+	CppUnit_addTest(pSuite, WheelTimerTest, testCancel);
+	CppUnit_addTest(pSuite, WheelTimerTest, testThreadPool);
+
+	return pSuite;
+}
@@ -0,0 +1,53 @@
+//
+// WheelTimerTest.h
+//
+// $Id$
+//
+// Definition of the WheelTimerTest class.
+//
+// Copyright (c) 2004-2016, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef WheelTimerTest_INCLUDED
+#define WheelTimerTest_INCLUDED
+
+
+#include "Poco/Util/Util.h"
+#include "Poco/CppUnit/TestCase.h"
+#include "Poco/Util/TimerTask.h"
+#include "Poco/Event.h"
+
+
+class WheelTimerTest: public CppUnit::TestCase
+{
+public:
+	WheelTimerTest(const std::string& name);
+	~WheelTimerTest();
+
+	void testScheduleTimestamp();
+	void testScheduleClock();
+	void testScheduleInterval();
+	void testScheduleAtFixedRate();
+	void testCascade();
+	void testMany();
+	void testUnschedule();
+	void testCancel();
+	void testThreadPool();
+
+	void setUp();
+	void tearDown();
+
+	void onTimer(Poco::Util::TimerTask& task);
+
+	static CppUnit::Test* suite();
+
+private:
+	Poco::Event _event;
+};
+
+
+#endif // WheelTimerTest_INCLUDED
@@ -25,6 +25,7 @@
 #include "Poco/SAX/LexicalHandler.h"
 #include "Poco/SAX/DTDHandler.h"
 #include "Poco/XML/XMLString.h"
+#include "Poco/Arena.h"
 
 
 namespace Poco {
@@ -55,6 +56,14 @@ public:
 	virtual ~DOMBuilder();
 		/// Destroys the DOMBuilder.
 
+	void setArena(Poco::Arena* pArena);
+		/// Sets the Arena from which the nodes of subsequently
+		/// parsed documents are allocated. See Document::setArena().
+
+	Poco::Arena* getArena() const;
+		/// Returns the Arena from which nodes are allocated,
+		/// or null if nodes are allocated on the heap.
+
 	virtual Document* parse(const XMLString& uri);
 		/// Parse an XML document from a location identified by an URI.
 
@@ -100,6 +109,7 @@ private:
 
 	XMLReader&             _xmlReader;
 	NamePool*              _pNamePool;
+	Poco::Arena*           _pArena;
 	Document*              _pDocument;
 	AbstractContainerNode* _pParent;
 	AbstractNode*          _pPrevious;
@@ -21,13 +21,14 @@
 
 
 #include "Poco/XML/XML.h"
+#include "Poco/Arena.h"
 
 
 namespace Poco {
 namespace XML {
 
 
-class XML_API DOMObject
+class XML_API DOMObject: public Poco::ArenaObject
 	/// The base class for all objects in the Document Object Model.
 	///
 	/// DOMObject defines the rules for memory management
@@ -48,6 +49,10 @@ class XML_API DOMObject
 	/// released, except ownership of it has been explicitly
 	/// taken with a call to duplicate().
 	///
+	/// Nodes may be placed in a Poco::Arena (see Document::setArena()).
+	/// Such nodes are still reference counted and destroyed as usual,
+	/// but their memory is only reclaimed together with the Arena.
+	///
 	/// While DOMObjects are safe for use in multithreaded programs,
 	/// a DOMObject or one of its subclasses must not be accessed
 	/// from multiple threads simultaneously.
@@ -22,6 +22,7 @@
 
 #include "Poco/XML/XML.h"
 #include "Poco/SAX/SAXParser.h"
+#include "Poco/Arena.h"
 
 
 namespace Poco {
@@ -101,12 +102,22 @@ public:
 	void setEntityResolver(EntityResolver* pEntityResolver);
 		/// Sets the entity resolver on the underlying SAXParser.
 
+	void setArena(Poco::Arena* pArena);
+		/// Sets the Arena from which the nodes of subsequently
+		/// parsed documents are allocated. The Arena must outlive
+		/// the parsed documents. See Document::setArena().
+
+	Poco::Arena* getArena() const;
+		/// Returns the Arena from which nodes are allocated,
+		/// or null if nodes are allocated on the heap.
+
 	static const XMLString FEATURE_FILTER_WHITESPACE;
 	
 private:
 	SAXParser _saxParser;
-	NamePool* _pNamePool;
-	bool      _filterWhitespace;
+	NamePool*    _pNamePool;
+	Poco::Arena* _pArena;
+	bool         _filterWhitespace;
 };
 
 
@@ -91,6 +91,22 @@ public:
 	void collectGarbage();
 		/// Releases all objects in the Auto Release Pool.
 
+	void setArena(Poco::Arena* pArena);
+		/// Sets the Arena from which nodes created by the
+		/// factory methods are allocated. Specify a null
+		/// pointer (the default) to allocate nodes on the heap.
+		///
+		/// The Arena must outlive the Document and all nodes
+		/// created while the Arena was set.
+		///
+		/// This method is an extension to the W3C Document Object Model.
+
+	Poco::Arena* getArena() const;
+		/// Returns the Arena from which nodes are allocated,
+		/// or null if nodes are allocated on the heap.
+		///
+		/// This method is an extension to the W3C Document Object Model.
+
 	void suspendEvents();
 		/// Suspends all events until resumeEvents() is called.
 
@@ -247,6 +263,7 @@ private:
 	NamePool*       _pNamePool;
 	AutoReleasePool _autoReleasePool;
 	int             _eventSuspendLevel;
+	Poco::Arena*    _pArena;
 
 	static const XMLString NODE_NAME;
 	
@@ -269,6 +286,18 @@ inline Document::AutoReleasePool& Document::autoReleasePool()
 }
 
 
+inline void Document::setArena(Poco::Arena* pArena)
+{
+	_pArena = pArena;
+}
+
+
+inline Poco::Arena* Document::getArena() const
+{
+	return _pArena;
+}
+
+
 inline const DocumentType* Document::doctype() const
 {
 	return _pDocumentType;
@@ -71,6 +71,9 @@ public:
 		/// Application writers should use setSystemId() to provide a base for resolving
 		/// relative URIs, may use setPublicId to include a public identifier, and may use 
 		/// setEncoding to specify the object's character encoding.
+		///
+		/// For large local files, a Poco::MappedInputStream can be used, which
+		/// the parser reads directly from the memory the file is mapped to.
 
 	~InputSource();
 		/// Destroys the InputSource.
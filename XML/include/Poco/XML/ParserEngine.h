@@ -213,6 +213,11 @@ protected:
 	void parseExternalCharInputStream(XML_Parser extParser, XMLCharInputStream& istr);
 		/// Parses an external entity from the given stream, with a separate parser.
 
+	bool parseMappedInputStream(XML_Parser parser, XMLByteInputStream& istr);
+		/// If the given stream is a Poco::MappedInputStream, parses the
+		/// remaining data directly from the memory the file is mapped to,
+		/// and returns true. Otherwise, returns false.
+
 	void pushContext(XML_Parser parser, InputSource* pInputSource);
 		/// Pushes a new entry to the context stack.
 		
@@ -128,7 +128,7 @@ XMLString Attr::innerText() const
 
 Node* Attr::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Attr(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) Attr(pOwnerDocument, *this);
 }
 
 
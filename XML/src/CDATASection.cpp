@@ -69,7 +69,7 @@ unsigned short CDATASection::nodeType() const
 
 Node* CDATASection::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new CDATASection(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) CDATASection(pOwnerDocument, *this);
 }
 
 
@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/Comment.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -55,7 +56,7 @@ unsigned short Comment::nodeType() const
 
 Node* Comment::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Comment(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) Comment(pOwnerDocument, *this);
 }
 
 
@@ -42,6 +42,7 @@ const XMLString DOMBuilder::EMPTY_STRING;
 DOMBuilder::DOMBuilder(XMLReader& xmlReader, NamePool* pNamePool):
 	_xmlReader(xmlReader),
 	_pNamePool(pNamePool),
+	_pArena(0),
 	_pDocument(0),
 	_pParent(0),
 	_pPrevious(0),
@@ -62,6 +63,18 @@ DOMBuilder::~DOMBuilder()
 }
 
 
+void DOMBuilder::setArena(Poco::Arena* pArena)
+{
+	_pArena = pArena;
+}
+
+
+Poco::Arena* DOMBuilder::getArena() const
+{
+	return _pArena;
+}
+
+
 Document* DOMBuilder::parse(const XMLString& uri)
 {
 	setupParse();
@@ -131,6 +144,7 @@ Document* DOMBuilder::parseMemoryNP(const char* xml, std::size_t size)
 void DOMBuilder::setupParse()
 {
 	_pDocument  = new Document(_pNamePool);
+	_pDocument->setArena(_pArena);
 	_pParent    = _pDocument;
 	_pPrevious  = 0;
 	_inCDATA    = false;
@@ -196,7 +210,7 @@ void DOMBuilder::startElement(const XMLString& uri, const XMLString& localName,
 	Attr* pPrevAttr = 0;
 	for (AttributesImpl::iterator it = attrs.begin(); it != attrs.end(); ++it)
 	{
-		AutoPtr<Attr> pAttr = new Attr(_pDocument, 0, it->namespaceURI, it->localName, it->qname, it->value, it->specified);
+		AutoPtr<Attr> pAttr = new (_pArena) Attr(_pDocument, 0, it->namespaceURI, it->localName, it->qname, it->value, it->specified);
 		pPrevAttr = pElem->addAttributeNodeNP(pPrevAttr, pAttr);
 	}
 	appendNode(pElem);
@@ -272,7 +286,7 @@ void DOMBuilder::skippedEntity(const XMLString& name)
 
 void DOMBuilder::startDTD(const XMLString& name, const XMLString& publicId, const XMLString& systemId)
 {
-	AutoPtr<DocumentType> pDoctype = new DocumentType(_pDocument, name, publicId, systemId);
+	AutoPtr<DocumentType> pDoctype = new (_pArena) DocumentType(_pDocument, name, publicId, systemId);
 	_pDocument->setDoctype(pDoctype);
 }
 
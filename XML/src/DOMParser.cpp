@@ -31,6 +31,7 @@ const XMLString DOMParser::FEATURE_FILTER_WHITESPACE = toXMLString("http://www.a
 
 DOMParser::DOMParser(NamePool* pNamePool):
 	_pNamePool(pNamePool),
+	_pArena(0),
 	_filterWhitespace(false)
 {
 	if (_pNamePool) _pNamePool->duplicate();
@@ -41,6 +42,7 @@ DOMParser::DOMParser(NamePool* pNamePool):
 
 DOMParser::DOMParser(unsigned long namePoolSize):
 	_pNamePool(new NamePool(namePoolSize)),
+	_pArena(0),
 	_filterWhitespace(false)
 {
 	_saxParser.setFeature(XMLReader::FEATURE_NAMESPACES, true);
@@ -96,11 +98,13 @@ Document* DOMParser::parse(const XMLString& uri)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parse(uri);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parse(uri);
 	}
 }
@@ -112,11 +116,13 @@ Document* DOMParser::parse(InputSource* pInputSource)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parse(pInputSource);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parse(pInputSource);
 	}
 }
@@ -134,11 +140,13 @@ Document* DOMParser::parseMemory(const char* xml, std::size_t size)
 	{
 		WhitespaceFilter filter(&_saxParser);
 		DOMBuilder builder(filter, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parseMemoryNP(xml, size);
 	}
 	else
 	{
 		DOMBuilder builder(_saxParser, _pNamePool);
+		builder.setArena(_pArena);
 		return builder.parseMemoryNP(xml, size);
 	}
 }
@@ -156,4 +164,16 @@ void DOMParser::setEntityResolver(EntityResolver* pEntityResolver)
 }
 
 
+void DOMParser::setArena(Poco::Arena* pArena)
+{
+	_pArena = pArena;
+}
+
+
+Poco::Arena* DOMParser::getArena() const
+{
+	return _pArena;
+}
+
+
 } } // namespace Poco::XML
@@ -43,7 +43,8 @@ const XMLString Document::NODE_NAME = toXMLString("#document");
 Document::Document(NamePool* pNamePool): 
 	AbstractContainerNode(0),
 	_pDocumentType(0),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(0)
 {
 	if (pNamePool)
 	{
@@ -61,7 +62,8 @@ Document::Document(unsigned long namePoolSize):
 	AbstractContainerNode(0),
 	_pDocumentType(0),
 	_pNamePool(new NamePool(namePoolSize)),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(0)
 {
 }
 
@@ -69,7 +71,8 @@ Document::Document(unsigned long namePoolSize):
 Document::Document(DocumentType* pDocumentType, NamePool* pNamePool): 
 	AbstractContainerNode(0),
 	_pDocumentType(pDocumentType),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(0)
 {
 	if (pNamePool)
 	{
@@ -92,7 +95,8 @@ Document::Document(DocumentType* pDocumentType, unsigned long namePoolSize):
 	AbstractContainerNode(0),
 	_pDocumentType(pDocumentType),
 	_pNamePool(new NamePool(namePoolSize)),
-	_eventSuspendLevel(0)
+	_eventSuspendLevel(0),
+	_pArena(0)
 {
 	if (_pDocumentType)
 	{
@@ -157,49 +161,49 @@ Element* Document::documentElement() const
 
 Element* Document::createElement(const XMLString& tagName) const
 {
-	return new Element(const_cast<Document*>(this), EMPTY_STRING, EMPTY_STRING, tagName); 
+	return new (_pArena) Element(const_cast<Document*>(this), EMPTY_STRING, EMPTY_STRING, tagName); 
 }
 
 
 DocumentFragment* Document::createDocumentFragment() const
 {
-	return new DocumentFragment(const_cast<Document*>(this));
+	return new (_pArena) DocumentFragment(const_cast<Document*>(this));
 }
 
 
 Text* Document::createTextNode(const XMLString& data) const
 {
-	return new Text(const_cast<Document*>(this), data);
+	return new (_pArena) Text(const_cast<Document*>(this), data);
 }
 
 
 Comment* Document::createComment(const XMLString& data) const
 {
-	return new Comment(const_cast<Document*>(this), data);
+	return new (_pArena) Comment(const_cast<Document*>(this), data);
 }
 
 
 CDATASection* Document::createCDATASection(const XMLString& data) const
 {
-	return new CDATASection(const_cast<Document*>(this), data);
+	return new (_pArena) CDATASection(const_cast<Document*>(this), data);
 }
 
 
 ProcessingInstruction* Document::createProcessingInstruction(const XMLString& target, const XMLString& data) const
 {
-	return new ProcessingInstruction(const_cast<Document*>(this), target, data);
+	return new (_pArena) ProcessingInstruction(const_cast<Document*>(this), target, data);
 }
 
 
 Attr* Document::createAttribute(const XMLString& name) const
 {
-	return new Attr(const_cast<Document*>(this), 0, EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING);
+	return new (_pArena) Attr(const_cast<Document*>(this), 0, EMPTY_STRING, EMPTY_STRING, name, EMPTY_STRING);
 }
 
 
 EntityReference* Document::createEntityReference(const XMLString& name) const
 {
-	return new EntityReference(const_cast<Document*>(this), name);
+	return new (_pArena) EntityReference(const_cast<Document*>(this), name);
 }
 
 
@@ -229,13 +233,13 @@ Node* Document::importNode(Node* importedNode, bool deep)
 
 Element* Document::createElementNS(const XMLString& rNamespaceURI, const XMLString& qualifiedName) const
 {
-	return new Element(const_cast<Document*>(this), rNamespaceURI, Name::localName(qualifiedName), qualifiedName);
+	return new (_pArena) Element(const_cast<Document*>(this), rNamespaceURI, Name::localName(qualifiedName), qualifiedName);
 }
 
 
 Attr* Document::createAttributeNS(const XMLString& rNamespaceURI, const XMLString& qualifiedName) const
 {
-	return new Attr(const_cast<Document*>(this), 0, rNamespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING);
+	return new (_pArena) Attr(const_cast<Document*>(this), 0, rNamespaceURI, Name::localName(qualifiedName), qualifiedName, EMPTY_STRING);
 }
 
 
@@ -299,13 +303,13 @@ bool Document::events() const
 
 Entity* Document::createEntity(const XMLString& name, const XMLString& publicId, const XMLString& systemId, const XMLString& notationName) const
 {
-	return new Entity(const_cast<Document*>(this), name, publicId, systemId, notationName);
+	return new (_pArena) Entity(const_cast<Document*>(this), name, publicId, systemId, notationName);
 }
 
 
 Notation* Document::createNotation(const XMLString& name, const XMLString& publicId, const XMLString& systemId) const
 {
-	return new Notation(const_cast<Document*>(this), name, publicId, systemId);
+	return new (_pArena) Notation(const_cast<Document*>(this), name, publicId, systemId);
 }
 
 
@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/DocumentFragment.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -55,7 +56,7 @@ unsigned short DocumentFragment::nodeType() const
 
 Node* DocumentFragment::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	DocumentFragment* pClone = new DocumentFragment(pOwnerDocument, *this);
+	DocumentFragment* pClone = new (pOwnerDocument->getArena()) DocumentFragment(pOwnerDocument, *this);
 	if (deep)
 	{
 		Node* pCur = firstChild();
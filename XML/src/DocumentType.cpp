@@ -79,7 +79,7 @@ const XMLString& DocumentType::internalSubset() const
 
 Node* DocumentType::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new DocumentType(pOwnerDocument, *this);
+	return new (pOwnerDocument ? pOwnerDocument->getArena() : 0) DocumentType(pOwnerDocument, *this);
 }
 
 
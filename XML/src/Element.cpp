@@ -391,7 +391,7 @@ void Element::dispatchNodeInsertedIntoDocument()
 
 Node* Element::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	Element* pClone = new Element(pOwnerDocument, *this);
+	Element* pClone = new (pOwnerDocument->getArena()) Element(pOwnerDocument, *this);
 	if (deep)
 	{
 		Node* pNode = firstChild();
@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/Entity.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -63,7 +64,7 @@ unsigned short Entity::nodeType() const
 
 Node* Entity::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Entity(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) Entity(pOwnerDocument, *this);
 }
 
 
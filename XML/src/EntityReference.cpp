@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/EntityReference.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -54,7 +55,7 @@ unsigned short EntityReference::nodeType() const
 
 Node* EntityReference::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new EntityReference(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) EntityReference(pOwnerDocument, *this);
 }
 
 
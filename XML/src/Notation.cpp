@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/Notation.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -58,7 +59,7 @@ unsigned short Notation::nodeType() const
 
 Node* Notation::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Notation(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) Notation(pOwnerDocument, *this);
 }
 
 
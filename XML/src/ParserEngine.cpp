@@ -29,6 +29,7 @@
 #include "Poco/SAX/LocatorImpl.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/URI.h"
+#include "Poco/MappedStream.h"
 #include <cstring>
 
 
@@ -262,6 +263,8 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 
 void ParserEngine::parseByteInputStream(XMLByteInputStream& istr)
 {
+	if (parseMappedInputStream(_parser, istr)) return;
+
 	std::streamsize n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
 	while (n > 0)
 	{
@@ -308,6 +311,8 @@ void ParserEngine::parseExternal(XML_Parser extParser, InputSource* pInputSource
 
 void ParserEngine::parseExternalByteInputStream(XML_Parser extParser, XMLByteInputStream& istr)
 {
+	if (parseMappedInputStream(extParser, istr)) return;
+
 	char *pBuffer = new char[PARSE_BUFFER_SIZE];
 	try
 	{
@@ -360,6 +365,30 @@ void ParserEngine::parseExternalCharInputStream(XML_Parser extParser, XMLCharInp
 }
 
 
+bool ParserEngine::parseMappedInputStream(XML_Parser parser, XMLByteInputStream& istr)
+{
+	Poco::MappedStreamBuf* pMappedBuf = dynamic_cast<Poco::MappedStreamBuf*>(istr.rdbuf());
+	if (!pMappedBuf) return false;
+
+	// Expat parses the data in place, and only copies an incomplete
+	// token at the end of a block, so large blocks are passed
+	const std::size_t MAPPED_BLOCK_SIZE = 1024*1024;
+	const char* it  = pMappedBuf->current();
+	const char* end = pMappedBuf->end();
+	while (it != end)
+	{
+		std::size_t n = static_cast<std::size_t>(end - it) < MAPPED_BLOCK_SIZE ? static_cast<std::size_t>(end - it) : MAPPED_BLOCK_SIZE;
+		if (!XML_Parse(parser, it, static_cast<int>(n), 0))
+			handleError(XML_GetErrorCode(parser));
+		it += n;
+	}
+	istr.seekg(0, std::ios::end);
+	if (!XML_Parse(parser, it, 0, 1))
+		handleError(XML_GetErrorCode(parser));
+	return true;
+}
+
+
 std::streamsize ParserEngine::readBytes(XMLByteInputStream& istr, char* pBuffer, std::streamsize bufferSize)
 {
 	if (_enablePartialReads)
@@ -15,6 +15,7 @@
 
 
 #include "Poco/DOM/ProcessingInstruction.h"
+#include "Poco/DOM/Document.h"
 
 
 namespace Poco {
@@ -74,7 +75,7 @@ unsigned short ProcessingInstruction::nodeType() const
 
 Node* ProcessingInstruction::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new ProcessingInstruction(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) ProcessingInstruction(pOwnerDocument, *this);
 }
 
 
@@ -75,7 +75,7 @@ XMLString Text::innerText() const
 
 Node* Text::copyNode(bool deep, Document* pOwnerDocument) const
 {
-	return new Text(pOwnerDocument, *this);
+	return new (pOwnerDocument->getArena()) Text(pOwnerDocument, *this);
 }
 
 
@@ -19,6 +19,8 @@
 #include "Poco/DOM/NodeList.h"
 #include "Poco/DOM/AutoPtr.h"
 #include "Poco/DOM/DOMException.h"
+#include "Poco/DOM/DOMParser.h"
+#include "Poco/Arena.h"
 
 
 using Poco::XML::Element;
@@ -29,6 +31,7 @@ using Poco::XML::NodeList;
 using Poco::XML::AutoPtr;
 using Poco::XML::XMLString;
 using Poco::XML::DOMException;
+using Poco::XML::DOMParser;
 
 
 DocumentTest::DocumentTest(const std::string& name): CppUnit::TestCase(name)
@@ -264,6 +267,47 @@ void DocumentTest::testElementByIdNS()
 }
 
 
+void DocumentTest::testArena()
+{
+	Poco::Arena arena;
+	{
+		DOMParser parser;
+		parser.setArena(&arena);
+		assert (parser.getArena() == &arena);
+		AutoPtr<Document> pDoc = parser.parseString("<root a=\"1\"><elem>text</elem><!--comment--></root>");
+		assert (pDoc->getArena() == &arena);
+		std::size_t used = arena.used();
+		assert (used > 0);
+
+		Element* pRoot = pDoc->documentElement();
+		assert (pRoot->getAttribute("a") == "1");
+		assert (pRoot->firstChild()->nodeName() == "elem");
+		assert (pRoot->firstChild()->firstChild()->nodeValue() == "text");
+		assert (pRoot->lastChild()->nodeValue() == "comment");
+
+		AutoPtr<Element> pElem = pDoc->createElement("elem2");
+		pRoot->appendChild(pElem);
+		assert (arena.used() > used);
+
+		pRoot->removeChild(pElem);
+
+		used = arena.used();
+		AutoPtr<Node> pClone = pRoot->cloneNode(true);
+		assert (arena.used() > used);
+
+		AutoPtr<Document> pDoc2 = new Document;
+		used = arena.used();
+		AutoPtr<Node> pImported = pDoc2->importNode(pRoot, true);
+		assert (arena.used() == used);
+
+		pDoc2->setArena(&arena);
+		AutoPtr<Node> pImported2 = pDoc2->importNode(pRoot, true);
+		assert (arena.used() > used);
+	}
+	arena.reset();
+}
+
+
 void DocumentTest::setUp()
 {
 }
@@ -285,6 +329,7 @@ CppUnit::Test* DocumentTest::suite()
 	CppUnit_addTest(pSuite, DocumentTest, testElementsByTagNameNS);
 	CppUnit_addTest(pSuite, DocumentTest, testElementById);
 	CppUnit_addTest(pSuite, DocumentTest, testElementByIdNS);
+	CppUnit_addTest(pSuite, DocumentTest, testArena);
 
 	return pSuite;
 }
@@ -21,6 +21,8 @@
 #include "Poco/XML/XMLWriter.h"
 #include "Poco/Latin9Encoding.h"
 #include "Poco/FileStream.h"
+#include "Poco/MappedStream.h"
+#include "Poco/TemporaryFile.h"
 #include <sstream>
 
 
@@ -315,6 +317,28 @@ void SAXParserTest::testParsePartialReads()
 }
 
 
+void SAXParserTest::testParseMappedFile()
+{
+	Poco::TemporaryFile file;
+	{
+		Poco::FileOutputStream ostr(file.path());
+		ostr << WSDL;
+	}
+
+	SAXParser parser;
+	Poco::MappedInputStream istr(file.path());
+	std::ostringstream ostr;
+	XMLWriter writer(ostr, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT);
+	writer.setNewLine(XMLWriter::NEWLINE_LF);
+	parser.setContentHandler(&writer);
+	parser.setDTDHandler(&writer);
+	parser.setProperty(XMLReader::PROPERTY_LEXICAL_HANDLER, static_cast<Poco::XML::LexicalHandler*>(&writer));
+	InputSource source(istr);
+	parser.parse(&source);
+	assert (ostr.str() == WSDL);
+}
+
+
 void SAXParserTest::setUp()
 {
 }
@@ -380,6 +404,7 @@ CppUnit::Test* SAXParserTest::suite()
 	CppUnit_addTest(pSuite, SAXParserTest, testCharacters);
 	CppUnit_addTest(pSuite, SAXParserTest, testParseMemory);
 	CppUnit_addTest(pSuite, SAXParserTest, testParsePartialReads);
+	CppUnit_addTest(pSuite, SAXParserTest, testParseMappedFile);
 
 	return pSuite;
 }
@@ -50,6 +50,7 @@ public:
 	void testParseMemory();
 	void testCharacters();
 	void testParsePartialReads();
+	void testParseMappedFile();
 
 	void setUp();
 	void tearDown();
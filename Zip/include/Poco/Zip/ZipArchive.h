@@ -47,6 +47,9 @@ public:
 
 	ZipArchive(std::istream& in);
 		/// Creates the ZipArchive from a file. Note that the in stream will be in state failed after the constructor is finished
+		///
+		/// For a local file, a Poco::MappedInputStream is the fastest way to
+		/// read the archive, as the directory is read by seeking in the stream.
 
 	ZipArchive(std::istream& in, ParseCallback& callback);
 		/// Creates the ZipArchive from a file or network stream. Note that the in stream will be in state failed after the constructor is finished
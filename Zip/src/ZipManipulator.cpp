@@ -26,6 +26,7 @@
 #include "Poco/Delegate.h"
 #include "Poco/File.h"
 #include "Poco/FileStream.h"
+#include "Poco/MappedStream.h"
 
 
 namespace Poco {
@@ -38,7 +39,9 @@ ZipManipulator::ZipManipulator(const std::string& zipFile, bool backupOriginalFi
 	_changes(),
 	_in(0)
 {
-	Poco::FileInputStream in(zipFile);
+	// the archive is mapped, so that seeking to the headers
+	// does not discard and re-read a stream buffer each time
+	Poco::MappedInputStream in(zipFile);
 	_in = new ZipArchive(in);
 }
 
@@ -137,7 +140,7 @@ void ZipManipulator::onEDone(const void*, const ZipLocalFileHeader& hdr)
 ZipArchive ZipManipulator::compress(const std::string& outFile)
 {
 	// write to a tmp file
-	Poco::FileInputStream in(_zipFile);
+	Poco::MappedInputStream in(_zipFile);
 	Poco::FileOutputStream out(outFile);
 	Compress c(out, true);
 	c.EDone += Poco::Delegate<ZipManipulator, const ZipLocalFileHeader>(this, &ZipManipulator::onEDone);